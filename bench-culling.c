@@ -0,0 +1,174 @@
+#include "./shim/r3d/details/r3d_frustum.c"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+// Micro-benchmark of the frustum culling, compares the SoA kernel used by
+// r3d_prepare_cull_drawcalls (AVX, SSE or NEON depending on the build) with
+// the scalar tests, at several object counts:
+//   - obb: scalar per call test used before the kernel, against the kernel plus the build of the world boxes
+//   - aabb: scalar test of the same world boxes, against the kernel alone, both must agree on every box
+
+#define BENCH_MIN_BOXES 4000000     //< Boxes tested per measure, the passes are repeated until reached
+
+static unsigned int bench_seed = 12345;
+
+static float bench_random(float min, float max)
+{
+    bench_seed = bench_seed * 1664525u + 1013904223u;
+    return min + (max - min) * (float)(bench_seed >> 8) / (float)(1 << 24);
+}
+
+static double bench_now(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static Matrix bench_transform(void)
+{
+    // Random rotation around Y with a random scale and position, like a scattered scene
+    float angle = bench_random(0.0f, 6.2831853f);
+    float scale = bench_random(0.5f, 2.0f);
+    float c = cosf(angle) * scale, s = sinf(angle) * scale;
+
+    return (Matrix) {
+        c,    0.0f,  s,    bench_random(-200.0f, 200.0f),
+        0.0f, scale, 0.0f, bench_random(-20.0f, 20.0f),
+        -s,   0.0f,  c,    bench_random(-200.0f, 200.0f),
+        0.0f, 0.0f,  0.0f, 1.0f
+    };
+}
+
+static r3d_frustum_t bench_frustum(void)
+{
+    // Perspective of 60 degrees looking down -Z from the origin, near 0.1 and far 150
+    float n = 0.1f, f = 150.0f, aspect = 16.0f / 9.0f;
+    float t = n * tanf(30.0f * DEG2RAD), r = t * aspect;
+
+    Matrix proj = { 0 };
+    proj.m0 = n / r;
+    proj.m5 = n / t;
+    proj.m10 = -(f + n) / (f - n);
+    proj.m11 = -1.0f;
+    proj.m14 = -2.0f * f * n / (f - n);
+
+    return r3d_frustum_create(proj);
+}
+
+static void bench_size(const r3d_frustum_t* frustum, int count)
+{
+    int padded = (count + 31) & ~31;
+    int words = padded / 32;
+
+    BoundingBox* locals = malloc(count * sizeof(BoundingBox));
+    BoundingBox* worlds = malloc(count * sizeof(BoundingBox));
+    Matrix* transforms = malloc(count * sizeof(Matrix));
+    float* soa = malloc(6 * padded * sizeof(float));
+    uint32_t* mask = malloc(words * sizeof(uint32_t));
+
+    r3d_aabb_soa_t boxes = {
+        soa + 0 * padded, soa + 1 * padded, soa + 2 * padded,
+        soa + 3 * padded, soa + 4 * padded, soa + 5 * padded
+    };
+
+    for (int i = 0; i < count; i++) {
+        float e = bench_random(0.25f, 2.0f);
+        locals[i] = (BoundingBox) { { -e, -e, -e }, { e, e, e } };
+        transforms[i] = bench_transform();
+        r3d_aabb_soa_set(&boxes, i, &locals[i], &transforms[i]);
+        worlds[i] = (BoundingBox) {
+            { boxes.centerX[i] - boxes.extentX[i], boxes.centerY[i] - boxes.extentY[i], boxes.centerZ[i] - boxes.extentZ[i] },
+            { boxes.centerX[i] + boxes.extentX[i], boxes.centerY[i] + boxes.extentY[i], boxes.centerZ[i] + boxes.extentZ[i] }
+        };
+    }
+
+    for (int i = count; i < padded; i++) {
+        boxes.centerX[i] = boxes.centerY[i] = boxes.centerZ[i] = 0.0f;
+        boxes.extentX[i] = boxes.extentY[i] = boxes.extentZ[i] = 0.0f;
+    }
+
+    int passes = (BENCH_MIN_BOXES + count - 1) / count;
+    // NOTE: The scalar counts are summed over all the passes, so that no pass can be optimized out
+    long visibleObb = 0, visibleAabb = 0;
+    int visibleSoa = 0, mismatches = 0;
+
+    /* --- Scalar OBB test, the per call test used before the SoA kernel --- */
+
+    double start = bench_now();
+    for (int p = 0; p < passes; p++) {
+        for (int i = 0; i < count; i++) {
+            visibleObb += r3d_frustum_is_obb_in(frustum, &locals[i], &transforms[i]);
+        }
+    }
+    double timeObb = (bench_now() - start) / passes;
+
+    /* --- Scalar AABB test on the world boxes, same result as the kernel --- */
+
+    start = bench_now();
+    for (int p = 0; p < passes; p++) {
+        for (int i = 0; i < count; i++) {
+            visibleAabb += r3d_frustum_is_aabb_in(frustum, &worlds[i]);
+        }
+    }
+    double timeAabb = (bench_now() - start) / passes;
+
+    /* --- SoA kernel, including the construction of the world boxes --- */
+
+    start = bench_now();
+    for (int p = 0; p < passes; p++) {
+        for (int i = 0; i < count; i++) {
+            r3d_aabb_soa_set(&boxes, i, &locals[i], &transforms[i]);
+        }
+        r3d_frustum_cull_aabb_soa(frustum, &boxes, 0, count, mask);
+    }
+    double timeSoa = (bench_now() - start) / passes;
+
+    /* --- SoA kernel alone, on the world boxes tested by the scalar AABB test --- */
+
+    start = bench_now();
+    for (int p = 0; p < passes; p++) {
+        r3d_frustum_cull_aabb_soa(frustum, &boxes, 0, count, mask);
+    }
+    double timeKernel = (bench_now() - start) / passes;
+
+    for (int i = 0; i < count; i++) {
+        bool visible = (mask[i / 32] >> (i % 32)) & 1u;
+        visibleSoa += visible;
+        mismatches += (visible != r3d_frustum_is_aabb_in(frustum, &worlds[i]));
+    }
+
+    printf("%6d boxes | obb %7.1f us, soa + build %7.1f us (x%.1f) | aabb %7.1f us, soa %7.1f us (x%.1f) | visible %ld/%ld/%d, %d mismatches\n",
+           count, timeObb * 1e6, timeSoa * 1e6, timeObb / timeSoa, timeAabb * 1e6, timeKernel * 1e6, timeAabb / timeKernel,
+           visibleObb / passes, visibleAabb / passes, visibleSoa, mismatches);
+
+    free(locals);
+    free(worlds);
+    free(transforms);
+    free(soa);
+    free(mask);
+}
+
+int main(void)
+{
+    r3d_frustum_t frustum = bench_frustum();
+
+#if defined(R3D_HAS_AVX)
+    printf("SoA kernel: AVX\n");
+#elif defined(R3D_HAS_SSE)
+    printf("SoA kernel: SSE\n");
+#elif defined(R3D_HAS_NEON) || defined(R3D_HAS_NEON_FMA)
+    printf("SoA kernel: NEON\n");
+#else
+    printf("SoA kernel: scalar\n");
+#endif
+
+    const int sizes[] = { 1000, 10000, 100000 };
+    for (int i = 0; i < 3; i++) {
+        bench_size(&frustum, sizes[i]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include "./shim/r3d/details/r3d_anim_blend.c"
+#include "./shim/r3d/details/r3d_anim_clip.c"
+#include "./shim/r3d/details/r3d_billboard.c"
+#include "./shim/r3d/details/r3d_bvh.c"
+#include "./shim/r3d/details/r3d_cluster.c"
+#include "./shim/r3d/details/r3d_drawcall.c"
+#include "./shim/r3d/details/r3d_frustum.c"
+#include "./shim/r3d/details/r3d_jobs.c"
+#include "./shim/r3d/details/r3d_light.c"
+#include "./shim/r3d/details/r3d_material.c"
+#include "./shim/r3d/details/r3d_primitives.c"
+#include "./shim/r3d/details/r3d_shadow_atlas.c"
+#include "./shim/r3d/details/r3d_sort.c"
+#include "./shim/r3d/details/r3d_stream.c"
+#include "./shim/r3d/details/r3d_worker.c"
+#include "./shim/r3d/r3d_core.c"
+#include "./shim/r3d/r3d_culling.c"
+#include "./shim/r3d/r3d_curves.c"
+#include "./shim/r3d/r3d_environment.c"
+#include "./shim/r3d/r3d_lighting.c"
+#include "./shim/r3d/r3d_model.c"
+#include "./shim/r3d/r3d_particles.c"
+#include "./shim/r3d/r3d_skybox.c"
+#include "./shim/r3d/r3d_sprite.c"
+#include "./shim/r3d/r3d_state.c"
+#include "./shim/r3d/r3d_static.c"
+#include "./shim/r3d/r3d_utils.c"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Times the model and animation loading of a set of sample rigs, to compare the load path between two builds.
+// Usage: bench-loading [-n repetitions] <model file> [model file...]
+// Run it on the same files with a build of each revision, the import of the scenes is included.
+
+static double bench_load_model(const char* filePath, int repetitions, int* meshCount)
+{
+    double best = 1e30;
+
+    for (int i = 0; i < repetitions; i++) {
+        double start = GetTime();
+        R3D_Model model = R3D_LoadModel(filePath);
+        double time = GetTime() - start;
+
+        *meshCount = model.meshCount;
+        if (model.meshCount > 0) R3D_UnloadModel(&model, true);
+        if (time < best) best = time;
+    }
+
+    return best;
+}
+
+static double bench_load_animations(const char* filePath, int repetitions, int* animCount, int* frameCount, int* boneCount)
+{
+    double best = 1e30;
+
+    for (int i = 0; i < repetitions; i++) {
+        double start = GetTime();
+        R3D_ModelAnimation* anims = R3D_LoadModelAnimations(filePath, animCount, 60);
+        double time = GetTime() - start;
+
+        *frameCount = 0;
+        *boneCount = 0;
+        for (int a = 0; a < *animCount; a++) {
+            *frameCount += anims[a].frameCount;
+            if (anims[a].boneCount > *boneCount) *boneCount = anims[a].boneCount;
+        }
+
+        if (anims != NULL) R3D_UnloadModelAnimations(anims, *animCount);
+        if (time < best) best = time;
+    }
+
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    int repetitions = 5;
+    int first = 1;
+
+    if (argc > 2 && strcmp(argv[1], "-n") == 0) {
+        repetitions = atoi(argv[2]);
+        if (repetitions < 1) repetitions = 1;
+        first = 3;
+    }
+
+    if (first >= argc) {
+        printf("Usage: %s [-n repetitions] <model file> [model file...]\n", argv[0]);
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    InitWindow(800, 600, "R3D Loading Benchmark");
+    R3D_Init(800, 600, 0);
+
+    printf("%-32s %10s %10s %12s %6s %7s %6s\n", "file", "model ms", "baked ms", "compressed ms", "anims", "frames", "bones");
+
+    double totals[3] = { 0 };
+
+    for (int i = first; i < argc; i++)
+    {
+        const char* filePath = argv[i];
+        int meshCount = 0, animCount = 0, frameCount = 0, boneCount = 0;
+
+        double modelTime = bench_load_model(filePath, repetitions, &meshCount);
+
+        R3D_SetModelAnimationCompression(false);
+        double bakedTime = bench_load_animations(filePath, repetitions, &animCount, &frameCount, &boneCount);
+
+        R3D_SetModelAnimationCompression(true);
+        double compressedTime = bench_load_animations(filePath, repetitions, &animCount, &frameCount, &boneCount);
+
+        printf("%-32s %10.2f %10.2f %12.2f %6d %7d %6d\n", GetFileName(filePath),
+               modelTime * 1e3, bakedTime * 1e3, compressedTime * 1e3, animCount, frameCount, boneCount);
+
+        totals[0] += modelTime;
+        totals[1] += bakedTime;
+        totals[2] += compressedTime;
+    }
+
+    printf("%-32s %10.2f %10.2f %12.2f\n", "total", totals[0] * 1e3, totals[1] * 1e3, totals[2] * 1e3);
+
+    R3D_Close();
+    CloseWindow();
+    return 0;
+}
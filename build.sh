@@ -3,5 +3,6 @@ gcc -shared -fPIC -o .artifacts/librayshim.so \
     -I./shim/include \
     -lGL \
     -ldl \
+    -lpthread \
     -lraylib \
     -lassimp
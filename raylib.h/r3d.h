@@ -71,6 +71,13 @@ typedef unsigned int R3D_Flags;
 #define R3D_FLAG_TRANSPARENT_SORTING    (1 << 8)    /**< Back-to-front sorting of transparent objects for correct blending of non-discarded fragments. Be careful, in 'force forward' mode this flag will also sort opaque objects in 'near-to-far' but in the same sorting pass. */
 #define R3D_FLAG_OPAQUE_SORTING         (1 << 9)    /**< Front-to-back sorting of opaque objects to optimize depth testing at the cost of additional sorting. Please note, in 'force forward' mode this flag has no effect, see transparent sorting. */
 #define R3D_FLAG_LOW_PRECISION_BUFFERS  (1 << 10)   /**< Use 32-bit HDR formats like R11G11B10F for intermediate color buffers instead of full 16-bit floats. Saves memory and bandwidth. */
+#define R3D_FLAG_PARALLEL_PREPARE       (1 << 11)   /**< Splits the CPU work of R3D_End (light batching, culling, sorting, skinning) across a pool of worker threads created by R3D_Init. The result is identical to the single-threaded path. Must be set during R3D initialization. */
+#define R3D_FLAG_INSTANCE_CULLING       (1 << 12)   /**< Culls each instance of the instanced draw calls against the camera and shadow frustums using the mesh bounding box, only the visible instances are uploaded. Billboard and sprite instances are not affected. */
+#define R3D_FLAG_STATE_SORTING          (1 << 13)   /**< Sorts opaque objects by shader variant, textures and mesh instead of depth, and skips the texture and vertex array binds that would be redundant between consecutive objects. Takes precedence over R3D_FLAG_OPAQUE_SORTING. See R3D_GetBindStats. */
+#define R3D_FLAG_AUTO_INSTANCING        (1 << 14)   /**< Merges the opaque, non-animated draw calls sharing the same mesh and an identical material into instanced draw calls after culling. Shadow maps are rendered before this stage and are not affected. */
+#define R3D_FLAG_PARALLEL_LOADING       (1 << 15)   /**< Bakes the frames of the loaded animations across the worker threads, shared with R3D_FLAG_PARALLEL_PREPARE when both are set. The loading functions must then be called from the thread that called R3D_Init. Must be set during R3D initialization. */
+#define R3D_FLAG_SKINNING_PREPASS      (1 << 16)   /**< Skins each animated mesh once per frame into a cached vertex buffer with transform feedback, before the shadow maps. All the passes then draw the skinned vertices instead of skinning them again in each pass, shadow map and cubemap face. Costs one buffer of 40 bytes per vertex for each distinct mesh and pose drawn in the frame. */
+#define R3D_FLAG_CLUSTERED_LIGHTING    (1 << 17)   /**< Shades the lights without shadows in a single full screen pass, and in the forward shader, from per-cluster light lists built on the CPU for a froxel grid of the view frustum, instead of one stencil volume and full screen pass per light and per-object light lists. The lights casting shadows keep their own pass. */
 
 /**
  * @brief Bitfield type used to specify rendering layers for 3D objects.
@@ -245,7 +252,16 @@ typedef enum R3D_Dof {
 typedef enum R3D_AnimMode {
     R3D_ANIM_INTERNAL,         ///< default animation solution
     R3D_ANIM_CUSTOM,           ///< user supplied matrices 
+    R3D_ANIM_LAYERS,           ///< blend of the animation layers of the model
 } R3D_AnimMode;
+
+/**
+ * @brief Blend modes of the animation layers.
+ */
+typedef enum R3D_AnimLayerMode {
+    R3D_ANIM_LAYER_OVERRIDE,   ///< The layer pose is interpolated with the pose of the previous layers
+    R3D_ANIM_LAYER_ADDITIVE,   ///< The difference between the layer pose and its first frame is added to the previous layers
+} R3D_AnimLayerMode;
 // --------------------------------------------
 //                   TYPES
 // --------------------------------------------
@@ -280,7 +296,7 @@ typedef struct R3D_Mesh {
     unsigned int ebo;                     /**< Element Buffer Object (GPU handle). */
     unsigned int vao;                     /**< Vertex Array Object (GPU handle). */
 
-    Matrix* boneMatrices;                 /**< Cached animation matrices for all passes. */
+    Matrix* boneMatrices;                 /**< Unused, always NULL. The bone matrices are computed per frame and shared by the draw calls. */
     int boneCount;                        /**< Number of bones (and matrices) that affect the mesh. */
 
     R3D_ShadowCastMode shadowCastMode;    /**< Shadow casting mode for the mesh. */
@@ -290,6 +306,8 @@ typedef struct R3D_Mesh {
     R3D_Layer layers;                     /**< Bitfield indicating the rendering layer(s) this object belongs to. 
                                                A value of 0 means the object is always rendered. */
 
+    unsigned int version;                 /**< Incremented when the mesh is uploaded or updated, the cached shadows of the mesh are then redrawn. */
+
 } R3D_Mesh;
 
 /**
@@ -346,6 +364,10 @@ typedef struct R3D_Material {
  *
  * This structure holds the animation data for a skinned model,
  * including per-frame bone transformation poses.
+ *
+ * Animations loaded while compression is enabled (see R3D_SetModelAnimationCompression())
+ * have no baked poses, `frameGlobalPoses` and `frameLocalPoses` are NULL and the poses
+ * are evaluated from `clip` when rendering.
  */
 typedef struct R3D_ModelAnimation {
 
@@ -355,12 +377,48 @@ typedef struct R3D_ModelAnimation {
     BoneInfo* bones;                /**< Array of bone metadata (name, parent index, etc.) defining the skeleton hierarchy. */
 
     Matrix** frameGlobalPoses;      /**< 2D array [frame][bone]. Global bone matrices (relative to model space). */
-    Transform** frameLocalPoses;    /**< 2D array [frame][bone]. Local bone transforms (TRS relative to parent). */
+    Transform** frameLocalPoses;    /**< 2D array [frame][bone]. Local bone transforms (TRS relative to the parent bone). */
+
+    void* clip;                     /**< Compressed keys of the animation (opaque), NULL if the poses are baked. */
 
     char name[32];                  /**< Name identifier for the animation (e.g., "Walk", "Jump"). */
 
 } R3D_ModelAnimation;
 
+/**
+ * @brief Represents one layer of a blended animation.
+ *
+ * The layers of a model are evaluated in order on the local transforms of the bones.
+ * The first layer gives the base pose, its weight, mode and mask are ignored.
+ * A crossfade is made of two override layers, the weight of the second one going from 0 to 1.
+ */
+typedef struct R3D_AnimationLayer {
+
+    const R3D_ModelAnimation* anim; /**< Animation sampled by the layer, must use the skeleton of the model. */
+    float frame;                    /**< Frame to sample, the fractional part interpolates between two frames. Wraps around the frame count. */
+    float weight;                   /**< Influence of the layer in [0, 1]. */
+    R3D_AnimLayerMode mode;         /**< How the layer is combined with the previous ones. */
+    const float* boneWeights;       /**< Optional per-bone factors of the weight (one per bone), NULL to affect all bones. */
+
+} R3D_AnimationLayer;
+
+/**
+ * @brief Represents one level of detail of the animation of a model.
+ *
+ * A level is used while the model covers less than its screen size, the projected height of the
+ * bounding sphere of the model divided by the screen height. The levels of a model are sorted by
+ * decreasing screen size, a model larger than the first level is animated at full rate.
+ */
+typedef struct R3D_AnimationLOD {
+
+    float screenSize;               /**< The level is used below this projected size, in fractions of the screen height. */
+    int updateInterval;             /**< The pose only changes every `updateInterval` frames of the animation, 1 to keep all the frames.
+                                         Not used by the blended animations, whose frames are given by the layers. */
+    int boneDepth;                  /**< Bones deeper in the hierarchy follow their ancestor rigidly, -1 to keep all the bones.
+                                         Only used by the compressed and the blended animations, the baked poses are already complete. */
+
+} R3D_AnimationLOD;
+
 /**
  * @brief Represents a complete 3D model with meshes and materials.
  *
@@ -387,6 +445,13 @@ typedef struct R3D_Model {
 
     const R3D_ModelAnimation* anim; /**< Pointer to the currently assigned animation for this model (optional). */
     int animFrame;                  /**< Current animation frame index. Used for sampling bone poses from the animation. */
+    float animFrameFraction;        /**< Position [0, 1) between `animFrame` and the next frame, only used by compressed animations. */
+
+    const R3D_AnimationLayer* animLayers;   /**< Layers blended when `animationMode` is R3D_ANIM_LAYERS. Read during R3D_End(), they must remain valid until then. */
+    int animLayerCount;                     /**< Number of animation layers. */
+
+    const R3D_AnimationLOD* animLods;       /**< Optional levels of detail of the animation, NULL to always animate at full rate. */
+    int animLodCount;                       /**< Number of animation levels of detail. */
 
 } R3D_Model;
 
@@ -397,6 +462,44 @@ typedef struct R3D_Model {
  */
 typedef unsigned int R3D_Light;
 
+/**
+ * @brief Represents a unique identifier for a mesh registered in the static scene.
+ *
+ * This ID is used to reference a specific static mesh when calling R3D static scene functions.
+ */
+typedef unsigned int R3D_StaticMesh;
+
+/**
+ * @brief Represents a unique identifier for a model being loaded asynchronously.
+ *
+ * This ID is returned by R3D_LoadModelAsync() and stays valid until the model is taken or
+ * the load is cancelled. The IDs of released loads can be given again to later loads.
+ */
+typedef unsigned int R3D_AsyncModel;
+
+/**
+ * @brief State of an asynchronous model load.
+ */
+typedef enum R3D_AsyncState {
+    R3D_ASYNC_INVALID,                  ///< The handle does not refer to a load (released, cancelled or never created).
+    R3D_ASYNC_PENDING,                  ///< The model is being imported or uploaded.
+    R3D_ASYNC_READY,                    ///< The model is fully loaded and can be taken.
+    R3D_ASYNC_FAILED                    ///< The load failed, taking the handle releases it.
+} R3D_AsyncState;
+
+/**
+ * @brief Counters of the binds issued and skipped during the last frame.
+ *
+ * These counters are only updated while the bound state cache is active,
+ * which is the case for the geometry and forward passes when `R3D_FLAG_STATE_SORTING` is set.
+ */
+typedef struct R3D_BindStats {
+    int textureBinds;           ///< Material textures bound.
+    int textureBindsSkipped;    ///< Material textures already bound by a previous object.
+    int meshBinds;              ///< Mesh vertex arrays bound.
+    int meshBindsSkipped;       ///< Mesh vertex arrays already bound by a previous object.
+} R3D_BindStats;
+
 /**
  * @brief Structure representing a skybox and its related textures for lighting.
  *
@@ -563,6 +666,9 @@ void R3D_Init(int resWidth, int resHeight, unsigned int flags);
  * 
  * This function shuts down the rendering system and frees all allocated memory, 
  * including the resources associated with the created lights.
+ *
+ * @note The imports queued by R3D_LoadModelAsync() are not interrupted, this function blocks
+ *       until the loading threads have finished them, then releases the pending loads.
  */
 void R3D_Close(void);
 
@@ -605,6 +711,17 @@ void R3D_ClearState(unsigned int flags);
  */
 void R3D_GetResolution(int* width, int* height);
 
+/**
+ * @brief Gets the bind counters of the last frame.
+ *
+ * This function returns the number of texture and vertex array binds issued and skipped
+ * by the bound state cache during the last call to R3D_End. All counters stay at zero
+ * unless `R3D_FLAG_STATE_SORTING` is set.
+ *
+ * @return The bind counters of the last frame.
+ */
+R3D_BindStats R3D_GetBindStats(void);
+
 /**
  * @brief Updates the internal resolution.
  * 
@@ -625,10 +742,32 @@ void R3D_UpdateResolution(int width, int height);
  * by directional lights. It is the user's responsibility to calculate and provide the 
  * correct bounds.
  * 
+ * Directional lights using shadow cascades only use these bounds for the depth range of
+ * their cascades, so that the casters outside of the view still cast their shadows.
+ * 
  * @param sceneBounds The bounding box defining the scene's dimensions.
  */
 void R3D_SetSceneBounds(BoundingBox sceneBounds);
 
+/**
+ * @brief Sets the size of the shadow atlas shared by the directional and spot lights.
+ * 
+ * The shadow maps of the directional and spot lights are square tiles of an atlas made of
+ * one or more pages. Each frame, the visible lights get tiles sized after the part of the
+ * screen they light, up to the resolution given to `R3D_EnableShadow`. When the tiles don't
+ * fit, the least important lights get smaller tiles, down to 128 pixels, then lose their
+ * shadows for the frame. Omni-directional lights keep their own cube maps.
+ * 
+ * The size is rounded up to a power of two. The atlas is created again with the next
+ * light casting shadows, which redraws all the shadows.
+ * 
+ * The default atlas is one page of 4096x4096.
+ * 
+ * @param size The resolution of each page.
+ * @param pages The number of pages.
+ */
+void R3D_SetShadowAtlasSize(int size, int pages);
+
 /**
  * @brief Sets the default texture filtering mode.
  * 
@@ -1002,6 +1141,82 @@ void R3D_DrawParticleSystem(const R3D_ParticleSystem* system, const R3D_Mesh* me
  */
 void R3D_DrawParticleSystemEx(const R3D_ParticleSystem* system, const R3D_Mesh* mesh, const R3D_Material* material, Matrix transform);
 
+// --------------------------------------------
+// CORE: Static Scene Functions
+// --------------------------------------------
+
+/**
+ * @brief Registers a mesh in the static scene.
+ *
+ * Static meshes are rendered every frame by `R3D_End` without having to be submitted again.
+ * They are stored in a bounding volume hierarchy that is updated incrementally, so their
+ * culling cost depends on the number of visible meshes rather than on the total count.
+ * Off-screen static meshes are still rendered in the shadow maps that can see them.
+ *
+ * @param mesh A pointer to the mesh to register. Cannot be NULL, and must remain valid until the static mesh is removed.
+ * @param material A pointer to the material applied to the mesh, copied at registration. Can be NULL, default material will be used.
+ * @param transform The world transformation of the mesh.
+ * @return The ID of the static mesh, or 0 on failure.
+ *
+ * @note The layers and shadow cast mode of the mesh are read each frame, like for `R3D_DrawMesh`.
+ * @note Billboard modes and skeletal animations are not supported for static meshes.
+ */
+R3D_StaticMesh R3D_AddStaticMesh(const R3D_Mesh* mesh, const R3D_Material* material, Matrix transform);
+
+/**
+ * @brief Registers all the meshes of a model in the static scene.
+ *
+ * Each mesh of the model is registered with its own material, as if `R3D_AddStaticMesh`
+ * was called for each of them with the same transformation.
+ *
+ * @param model A pointer to the model to register. Must remain valid until its static meshes are removed.
+ * @param transform The world transformation of the model.
+ * @param ids Optional array of at least `model->meshCount` elements receiving the ID of each static mesh (0 on failure). Can be NULL.
+ * @return The number of meshes successfully registered.
+ */
+int R3D_AddStaticModel(const R3D_Model* model, Matrix transform, R3D_StaticMesh* ids);
+
+/**
+ * @brief Removes a mesh from the static scene.
+ *
+ * @param id The ID of the static mesh to remove.
+ */
+void R3D_RemoveStaticMesh(R3D_StaticMesh id);
+
+/**
+ * @brief Checks if a static mesh exists.
+ *
+ * @param id The ID of the static mesh to check.
+ * @return True if the static mesh exists, false otherwise.
+ */
+bool R3D_IsStaticMeshExist(R3D_StaticMesh id);
+
+/**
+ * @brief Gets the world transformation of a static mesh.
+ *
+ * @param id The ID of the static mesh.
+ * @return The world transformation of the static mesh.
+ */
+Matrix R3D_GetStaticMeshTransform(R3D_StaticMesh id);
+
+/**
+ * @brief Sets the world transformation of a static mesh.
+ *
+ * The hierarchy is only updated when the mesh leaves the enlarged bounds it was inserted with,
+ * so occasional small moves are cheap. Meshes moving every frame should use `R3D_DrawMesh` instead.
+ *
+ * @param id The ID of the static mesh.
+ * @param transform The new world transformation of the static mesh.
+ */
+void R3D_SetStaticMeshTransform(R3D_StaticMesh id, Matrix transform);
+
+/**
+ * @brief Removes all the meshes from the static scene.
+ *
+ * All the static mesh IDs become invalid after this call.
+ */
+void R3D_ClearStaticMeshes(void);
+
 /** @} */ // end of Core
 
 /**
@@ -1295,6 +1510,73 @@ R3D_Model R3D_LoadModel(const char* filePath);
  */
 R3D_Model R3D_LoadModelFromMemory(const char* fileType, const void* data, unsigned int size);
 
+/**
+ * @brief Load a 3D model from a cooked file.
+ *
+ * Loads a model written by R3D_CookModel() or R3D_ExportModelCooked(). The file is mapped
+ * in memory and its buffers, materials and skeleton are used as stored, without going
+ * through Assimp, which makes it much faster than loading the source file.
+ *
+ * @param filePath Path to the cooked model file.
+ *
+ * @return Loaded model structure containing meshes and materials.
+ *
+ * @note The cooked files store the structures of the build that cooked them.
+ *       A file cooked by another version of R3D is rejected and must be cooked again.
+ */
+R3D_Model R3D_LoadModelCooked(const char* filePath);
+
+/**
+ * @brief Load a 3D model from a file without blocking the calling thread.
+ *
+ * The file is imported, its textures decoded and its meshes processed on loading threads.
+ * The textures and the meshes are then uploaded to the GPU one at a time at the end of
+ * R3D_End(), within the budget set by R3D_SetAsyncUploadBudget(). Until it is ready the
+ * model can not be used, its state can be queried with R3D_GetAsyncModelState().
+ *
+ * @param filePath Path to the 3D model file to load.
+ *
+ * @return Handle of the load, or 0 if it could not be started.
+ *
+ * @note The import settings (scale, compression, ...) are read by the loading threads,
+ *       they should not be changed while loads are pending.
+ * @note Only the model is loaded asynchronously, its animations are still loaded
+ *       with R3D_LoadModelAnimations().
+ */
+R3D_AsyncModel R3D_LoadModelAsync(const char* filePath);
+
+/**
+ * @brief Get the state of an asynchronous model load.
+ *
+ * @param handle Handle returned by R3D_LoadModelAsync().
+ *
+ * @return State of the load, R3D_ASYNC_INVALID if the handle was released.
+ */
+R3D_AsyncState R3D_GetAsyncModelState(R3D_AsyncModel handle);
+
+/**
+ * @brief Take the model of a finished asynchronous load.
+ *
+ * Once the load is ready or failed, the handle is released and the model belongs to the caller,
+ * who has to unload it with R3D_UnloadModel(). Nothing happens while the load is pending.
+ *
+ * @param handle Handle returned by R3D_LoadModelAsync().
+ * @param model Receives the loaded model when the load is ready.
+ *
+ * @return True if the model was ready and written to `model`, false otherwise.
+ */
+bool R3D_TakeAsyncModel(R3D_AsyncModel handle, R3D_Model* model);
+
+/**
+ * @brief Cancel an asynchronous model load.
+ *
+ * The handle is released immediately, the resources of the load are released as soon as
+ * its loading thread is done with it. A ready model that was not taken is unloaded.
+ *
+ * @param handle Handle returned by R3D_LoadModelAsync().
+ */
+void R3D_CancelAsyncModel(R3D_AsyncModel handle);
+
 /**
  * @brief Create a model from a single mesh.
  *
@@ -1366,6 +1648,19 @@ R3D_ModelAnimation* R3D_LoadModelAnimations(const char* fileName, int* animCount
  */
 R3D_ModelAnimation* R3D_LoadModelAnimationsFromMemory(const char* fileType, const void* data, unsigned int size, int* animCount, int targetFrameRate);
 
+/**
+ * @brief Loads the animations stored in a cooked model file.
+ *
+ * The animations are loaded as they were cooked, baked or compressed, at the frame rate
+ * given when cooking. The caller is responsible for freeing the returned data using
+ * R3D_UnloadModelAnimations().
+ *
+ * @param fileName Path to the cooked model file.
+ * @param animCount Pointer to an integer that will receive the number of animations loaded.
+ * @return Pointer to a dynamically allocated array of R3D_ModelAnimation. NULL on failure.
+ */
+R3D_ModelAnimation* R3D_LoadModelAnimationsCooked(const char* fileName, int* animCount);
+
 /**
  * @brief Frees memory allocated for model animations.
  *
@@ -1398,6 +1693,34 @@ R3D_ModelAnimation* R3D_GetModelAnimation(R3D_ModelAnimation* animations, int an
  */
 void R3D_ListModelAnimations(R3D_ModelAnimation* animations, int animCount);
 
+/**
+ * @brief Writes a model and its animations to a cooked file.
+ *
+ * The cooked file can then be loaded with R3D_LoadModelCooked() and R3D_LoadModelAnimationsCooked().
+ * The meshes must still have their vertices in memory, and the textures of the materials
+ * are read back from the GPU, so this must be called with a valid OpenGL context.
+ *
+ * @param fileName Path of the cooked file to write.
+ * @param model Model to write.
+ * @param animations Animations to write with the model, can be NULL.
+ * @param animCount Number of animations.
+ * @return True if the file was written, false otherwise.
+ */
+bool R3D_ExportModelCooked(const char* fileName, const R3D_Model* model, const R3D_ModelAnimation* animations, int animCount);
+
+/**
+ * @brief Cooks a model file supported by Assimp.
+ *
+ * Imports the model and its animations once, with the current loading settings
+ * (import scale, texture filter, animation compression), and writes them to a cooked file.
+ *
+ * @param fileName Path to the source model file.
+ * @param cookedFileName Path of the cooked file to write.
+ * @param targetFrameRate Frame rate (FPS) the animations are sampled at.
+ * @return True if the file was cooked, false otherwise.
+ */
+bool R3D_CookModel(const char* fileName, const char* cookedFileName, int targetFrameRate);
+
 /**
  * @brief Sets the scaling factor applied to models on loading.
  *
@@ -1408,6 +1731,31 @@ void R3D_ListModelAnimations(R3D_ModelAnimation* animations, int animCount);
  */
 void R3D_SetModelImportScale(float value);
 
+/**
+ * @brief Enables or disables the compression of the animations on loading.
+ *
+ * Instead of baking a matrix and a transform per bone and per frame, compressed animations
+ * store the local transforms of the animated nodes sampled at the target frame rate and
+ * quantized on 16 bits, and the channels that do not change are only stored once.
+ * The poses are then evaluated when rendering, and `animFrameFraction` of R3D_Model
+ * can be used to interpolate between two frames.
+ *
+ * This value is only applied to animations loaded after it is set, disabled by default.
+ *
+ * @param enabled Whether the animations should be compressed.
+ */
+void R3D_SetModelAnimationCompression(bool enabled);
+
+/**
+ * @brief Sets the time spent each frame uploading the asynchronously loaded models.
+ *
+ * The budget is checked after each upload of a texture or a mesh, so at least one upload
+ * is done per frame even with a null budget. Default is 2 milliseconds.
+ *
+ * @param milliseconds Upload time per frame, in milliseconds.
+ */
+void R3D_SetAsyncUploadBudget(float milliseconds);
+
 /** @} */ // end of Model
 
 /**
@@ -1749,6 +2097,9 @@ void R3D_SetLightOuterCutOff(R3D_Light id, float degrees);
  * This function enables shadow casting for a specified light and allocates a shadow map with the specified resolution.
  * Shadows can be rendered from the light based on this shadow map.
  *
+ * Directional and spot lights are drawn in the shadow atlas (see `R3D_SetShadowAtlasSize`),
+ * the resolution is then the largest size of their tiles, rounded up to a power of two.
+ *
  * @param id The ID of the light for which shadows should be enabled.
  * @param resolution The resolution of the shadow map to be used by the light.
  */
@@ -1840,6 +2191,12 @@ void R3D_SetShadowUpdateFrequency(R3D_Light id, int msec);
  * This function forces the shadow map of the specified light to be updated during the next call to `R3D_End`.
  * This is primarily used for the manual update mode, but may also work for the interval mode.
  *
+ * The depth of the static meshes is cached by the directional and spot lights, and only drawn again
+ * when the static meshes are added, removed, moved, or when their mesh is updated or changes its
+ * shadow cast mode or layers. Omni-directional lights only draw again the faces of their cube map
+ * whose casters moved or changed. This function redraws everything, for instance after writing
+ * directly into the GPU buffers of a mesh.
+ *
  * @param id The ID of the light.
  */
 void R3D_UpdateShadowMap(R3D_Light id);
@@ -1896,6 +2253,40 @@ float R3D_GetShadowSlopeBias(R3D_Light id);
  */
 void R3D_SetShadowSlopeBias(R3D_Light id, float value);
 
+/**
+ * @brief Gets the number of shadow cascades of a directional light.
+ */
+int R3D_GetShadowCascadeCount(R3D_Light id);
+
+/**
+ * @brief Sets the number of shadow cascades of a directional light.
+ *
+ * With 2 to 4 cascades, the view distance set by `R3D_SetShadowCascadeDistance` is split
+ * into slices that each get their own layer of the shadow map, so the shadows stay sharp
+ * near the camera on large scenes. With 1 cascade, a single shadow map is fitted to the
+ * scene bounds (see `R3D_SetSceneBounds`). The shadow map is reallocated if it exists.
+ *
+ * @param id The ID of the directional light.
+ * @param count The number of cascades, between 1 and 4 (default: 1).
+ */
+void R3D_SetShadowCascadeCount(R3D_Light id, int count);
+
+/**
+ * @brief Gets the view distance covered by the shadow cascades of a directional light.
+ */
+float R3D_GetShadowCascadeDistance(R3D_Light id);
+
+/**
+ * @brief Sets the view distance covered by the shadow cascades of a directional light.
+ *
+ * The geometry further than this distance from the camera is not shadowed by the light.
+ * The distance is clamped to the far plane of the camera.
+ *
+ * @param id The ID of the directional light.
+ * @param distance The distance covered by the cascades (default: 100.0).
+ */
+void R3D_SetShadowCascadeDistance(R3D_Light id, float distance);
+
 // --------------------------------------------
 // LIGHTING: Light Helper Functions
 // --------------------------------------------
@@ -27,9 +27,11 @@
 #include "./shaders/depth_cube.vert.h"
 #include "./shaders/depth_cube_instanced.vert.h"
 #include "./shaders/depth_cube.frag.h"
+#include "./shaders/skinning.vert.h"
 #include "./shaders/ssao.frag.h"
 #include "./shaders/ambient.frag.h"
 #include "./shaders/lighting.frag.h"
+#include "./shaders/lighting_clustered.frag.h"
 #include "./shaders/scene.frag.h"
 #include "./shaders/bloom.frag.h"
 #include "./shaders/ssr.frag.h"
@@ -16,484 +16,672 @@ static const char FORWARD_FRAG[] = {
     0x52, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x20, 0x20, 0x20, 0x20, 0x30, 0x0a, 0x23, 0x64, 0x65, 0x66, 
     0x69, 0x6e, 0x65, 0x20, 0x53, 0x50, 0x4f, 0x54, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x20, 0x20, 0x20, 
     0x31, 0x0a, 0x23, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x65, 0x20, 0x4f, 0x4d, 0x4e, 0x49, 0x4c, 0x49, 
-    0x47, 0x48, 0x54, 0x20, 0x20, 0x20, 0x32, 0x0a, 0x73, 0x74, 0x72, 0x75, 0x63, 0x74, 0x20, 0x4c, 
-    0x69, 0x67, 0x68, 0x74, 0x7b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 
-    0x76, 0x65, 0x63, 0x33, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x76, 0x65, 
-    0x63, 0x33, 0x20, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x66, 0x6c, 0x6f, 
-    0x61, 0x74, 0x20, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 
-    0x74, 0x20, 0x65, 0x6e, 0x65, 0x72, 0x67, 0x79, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x72, 
-    0x61, 0x6e, 0x67, 0x65, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x6e, 0x65, 0x61, 0x72, 0x3b, 
-    0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x66, 0x61, 0x72, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
-    0x61, 0x74, 0x74, 0x65, 0x6e, 0x75, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 
-    0x74, 0x20, 0x69, 0x6e, 0x6e, 0x65, 0x72, 0x43, 0x75, 0x74, 0x4f, 0x66, 0x66, 0x3b, 0x66, 0x6c, 
-    0x6f, 0x61, 0x74, 0x20, 0x6f, 0x75, 0x74, 0x65, 0x72, 0x43, 0x75, 0x74, 0x4f, 0x66, 0x66, 0x3b, 
-    0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x53, 0x6f, 0x66, 0x74, 
-    0x6e, 0x65, 0x73, 0x73, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 
-    0x77, 0x4d, 0x61, 0x70, 0x54, 0x78, 0x6c, 0x53, 0x7a, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
-    0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x44, 0x65, 0x70, 0x74, 0x68, 0x42, 0x69, 0x61, 0x73, 0x3b, 
-    0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x53, 0x6c, 0x6f, 0x70, 
-    0x65, 0x42, 0x69, 0x61, 0x73, 0x3b, 0x6c, 0x6f, 0x77, 0x70, 0x20, 0x69, 0x6e, 0x74, 0x20, 0x74, 
-    0x79, 0x70, 0x65, 0x3b, 0x62, 0x6f, 0x6f, 0x6c, 0x20, 0x65, 0x6e, 0x61, 0x62, 0x6c, 0x65, 0x64, 
-    0x3b, 0x62, 0x6f, 0x6f, 0x6c, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x3b, 0x7d, 0x3b, 0x69, 
-    0x6e, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x76, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 
-    0x3b, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x76, 0x54, 0x65, 0x78, 0x43, 0x6f, 0x6f, 
-    0x72, 0x64, 0x3b, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 0x43, 0x6f, 0x6c, 0x6f, 
-    0x72, 0x3b, 0x69, 0x6e, 0x20, 0x6d, 0x61, 0x74, 0x33, 0x20, 0x76, 0x54, 0x42, 0x4e, 0x3b, 0x69, 
-    0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 0x50, 0x6f, 0x73, 0x4c, 0x69, 0x67, 0x68, 0x74, 
-    0x53, 0x70, 0x61, 0x63, 0x65, 0x5b, 0x4e, 0x55, 0x4d, 0x5f, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x53, 
-    0x5d, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 
-    0x72, 0x32, 0x44, 0x20, 0x75, 0x54, 0x65, 0x78, 0x41, 0x6c, 0x62, 0x65, 0x64, 0x6f, 0x3b, 0x75, 
-    0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 
-    0x20, 0x75, 0x54, 0x65, 0x78, 0x45, 0x6d, 0x69, 0x73, 0x73, 0x69, 0x6f, 0x6e, 0x3b, 0x75, 0x6e, 
+    0x47, 0x48, 0x54, 0x20, 0x20, 0x20, 0x32, 0x0a, 0x23, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x65, 0x20, 
+    0x4e, 0x55, 0x4d, 0x5f, 0x43, 0x41, 0x53, 0x43, 0x41, 0x44, 0x45, 0x53, 0x20, 0x34, 0x0a, 0x23, 
+    0x64, 0x65, 0x66, 0x69, 0x6e, 0x65, 0x20, 0x43, 0x4c, 0x55, 0x53, 0x54, 0x45, 0x52, 0x5f, 0x58, 
+    0x20, 0x20, 0x20, 0x31, 0x36, 0x0a, 0x23, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x65, 0x20, 0x43, 0x4c, 
+    0x55, 0x53, 0x54, 0x45, 0x52, 0x5f, 0x59, 0x20, 0x20, 0x20, 0x39, 0x0a, 0x23, 0x64, 0x65, 0x66, 
+    0x69, 0x6e, 0x65, 0x20, 0x43, 0x4c, 0x55, 0x53, 0x54, 0x45, 0x52, 0x5f, 0x5a, 0x20, 0x20, 0x20, 
+    0x32, 0x34, 0x0a, 0x73, 0x74, 0x72, 0x75, 0x63, 0x74, 0x20, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x7b, 
+    0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 
+    0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x64, 0x69, 
+    0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x70, 
+    0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x65, 0x6e, 0x65, 
+    0x72, 0x67, 0x79, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x72, 0x61, 0x6e, 0x67, 0x65, 0x3b, 
+    0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x6e, 0x65, 0x61, 0x72, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
+    0x20, 0x66, 0x61, 0x72, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x74, 0x74, 0x65, 0x6e, 
+    0x75, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x69, 0x6e, 0x6e, 
+    0x65, 0x72, 0x43, 0x75, 0x74, 0x4f, 0x66, 0x66, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x6f, 
+    0x75, 0x74, 0x65, 0x72, 0x43, 0x75, 0x74, 0x4f, 0x66, 0x66, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
+    0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x53, 0x6f, 0x66, 0x74, 0x6e, 0x65, 0x73, 0x73, 0x3b, 
+    0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x4d, 0x61, 0x70, 0x54, 
+    0x78, 0x6c, 0x53, 0x7a, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 
+    0x77, 0x44, 0x65, 0x70, 0x74, 0x68, 0x42, 0x69, 0x61, 0x73, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
+    0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x53, 0x6c, 0x6f, 0x70, 0x65, 0x42, 0x69, 0x61, 0x73, 
+    0x3b, 0x76, 0x65, 0x63, 0x34, 0x20, 0x63, 0x61, 0x73, 0x63, 0x61, 0x64, 0x65, 0x73, 0x5b, 0x4e, 
+    0x55, 0x4d, 0x5f, 0x43, 0x41, 0x53, 0x43, 0x41, 0x44, 0x45, 0x53, 0x5d, 0x3b, 0x76, 0x65, 0x63, 
+    0x34, 0x20, 0x74, 0x69, 0x6c, 0x65, 0x73, 0x5b, 0x4e, 0x55, 0x4d, 0x5f, 0x43, 0x41, 0x53, 0x43, 
+    0x41, 0x44, 0x45, 0x53, 0x5d, 0x3b, 0x69, 0x6e, 0x74, 0x20, 0x63, 0x61, 0x73, 0x63, 0x61, 0x64, 
+    0x65, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x6c, 0x6f, 0x77, 0x70, 0x20, 0x69, 0x6e, 0x74, 0x20, 
+    0x74, 0x79, 0x70, 0x65, 0x3b, 0x62, 0x6f, 0x6f, 0x6c, 0x20, 0x65, 0x6e, 0x61, 0x62, 0x6c, 0x65, 
+    0x64, 0x3b, 0x62, 0x6f, 0x6f, 0x6c, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x3b, 0x7d, 0x3b, 
+    0x73, 0x74, 0x72, 0x75, 0x63, 0x74, 0x20, 0x43, 0x6c, 0x75, 0x73, 0x74, 0x65, 0x72, 0x4c, 0x69, 
+    0x67, 0x68, 0x74, 0x7b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 
+    0x6e, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x72, 0x61, 0x6e, 0x67, 0x65, 0x3b, 0x76, 0x65, 
+    0x63, 0x33, 0x20, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x69, 0x6e, 0x74, 
+    0x20, 0x74, 0x79, 0x70, 0x65, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 
+    0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x3b, 
+    0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x74, 0x74, 0x65, 0x6e, 0x75, 0x61, 0x74, 0x69, 0x6f, 
+    0x6e, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x69, 0x6e, 0x6e, 0x65, 0x72, 0x43, 0x75, 0x74, 
+    0x4f, 0x66, 0x66, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x6f, 0x75, 0x74, 0x65, 0x72, 0x43, 
+    0x75, 0x74, 0x4f, 0x66, 0x66, 0x3b, 0x7d, 0x3b, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 
+    0x76, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 
+    0x32, 0x20, 0x76, 0x54, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x3b, 0x69, 0x6e, 0x20, 0x76, 
+    0x65, 0x63, 0x34, 0x20, 0x76, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x69, 0x6e, 0x20, 0x6d, 0x61, 
+    0x74, 0x33, 0x20, 0x76, 0x54, 0x42, 0x4e, 0x3b, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 
+    0x76, 0x50, 0x6f, 0x73, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x53, 0x70, 0x61, 0x63, 0x65, 0x5b, 0x4e, 
+    0x55, 0x4d, 0x5f, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x53, 0x5d, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 
+    0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x75, 0x54, 0x65, 
+    0x78, 0x41, 0x6c, 0x62, 0x65, 0x64, 0x6f, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 
+    0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x75, 0x54, 0x65, 0x78, 0x45, 0x6d, 
+    0x69, 0x73, 0x73, 0x69, 0x6f, 0x6e, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 
+    0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x75, 0x54, 0x65, 0x78, 0x4e, 0x6f, 0x72, 
+    0x6d, 0x61, 0x6c, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 
+    0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x75, 0x54, 0x65, 0x78, 0x4f, 0x52, 0x4d, 0x3b, 0x75, 0x6e, 
     0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 
-    0x75, 0x54, 0x65, 0x78, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 
+    0x75, 0x54, 0x65, 0x78, 0x4e, 0x6f, 0x69, 0x73, 0x65, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 
+    0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x43, 0x75, 0x62, 0x65, 0x20, 0x75, 0x53, 
+    0x68, 0x61, 0x64, 0x6f, 0x77, 0x4d, 0x61, 0x70, 0x43, 0x75, 0x62, 0x65, 0x5b, 0x4e, 0x55, 0x4d, 
+    0x5f, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x53, 0x5d, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 
+    0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x41, 0x72, 0x72, 0x61, 0x79, 0x20, 
+    0x75, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x4d, 0x61, 0x70, 0x32, 0x44, 0x5b, 0x4e, 0x55, 0x4d, 
+    0x5f, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x53, 0x5d, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 
+    0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x75, 0x45, 0x6d, 0x69, 0x73, 0x73, 0x69, 0x6f, 0x6e, 
+    0x45, 0x6e, 0x65, 0x72, 0x67, 0x79, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x66, 
+    0x6c, 0x6f, 0x61, 0x74, 0x20, 0x75, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x53, 0x63, 0x61, 0x6c, 
+    0x65, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
+    0x75, 0x4f, 0x63, 0x63, 0x6c, 0x75, 0x73, 0x69, 0x6f, 0x6e, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 
+    0x72, 0x6d, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x75, 0x52, 0x6f, 0x75, 0x67, 0x68, 0x6e, 
+    0x65, 0x73, 0x73, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x66, 0x6c, 0x6f, 0x61, 
+    0x74, 0x20, 0x75, 0x4d, 0x65, 0x74, 0x61, 0x6c, 0x6e, 0x65, 0x73, 0x73, 0x3b, 0x75, 0x6e, 0x69, 
+    0x66, 0x6f, 0x72, 0x6d, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x75, 0x41, 0x6d, 0x62, 0x69, 0x65, 
+    0x6e, 0x74, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 
+    0x76, 0x65, 0x63, 0x33, 0x20, 0x75, 0x45, 0x6d, 0x69, 0x73, 0x73, 0x69, 0x6f, 0x6e, 0x43, 0x6f, 
+    0x6c, 0x6f, 0x72, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 
+    0x6c, 0x65, 0x72, 0x43, 0x75, 0x62, 0x65, 0x20, 0x75, 0x43, 0x75, 0x62, 0x65, 0x49, 0x72, 0x72, 
+    0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 
+    0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x43, 0x75, 0x62, 0x65, 0x20, 0x75, 0x43, 0x75, 0x62, 
+    0x65, 0x50, 0x72, 0x65, 0x66, 0x69, 0x6c, 0x74, 0x65, 0x72, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 
     0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x75, 0x54, 0x65, 
-    0x78, 0x4f, 0x52, 0x4d, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 
-    0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x75, 0x54, 0x65, 0x78, 0x4e, 0x6f, 0x69, 0x73, 0x65, 
-    0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 
-    0x43, 0x75, 0x62, 0x65, 0x20, 0x75, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x4d, 0x61, 0x70, 0x43, 
-    0x75, 0x62, 0x65, 0x5b, 0x4e, 0x55, 0x4d, 0x5f, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x53, 0x5d, 0x3b, 
-    0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 
-    0x44, 0x20, 0x75, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x4d, 0x61, 0x70, 0x32, 0x44, 0x5b, 0x4e, 
-    0x55, 0x4d, 0x5f, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x53, 0x5d, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 
-    0x72, 0x6d, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x75, 0x45, 0x6d, 0x69, 0x73, 0x73, 0x69, 
-    0x6f, 0x6e, 0x45, 0x6e, 0x65, 0x72, 0x67, 0x79, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 
-    0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x75, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x53, 0x63, 
-    0x61, 0x6c, 0x65, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x66, 0x6c, 0x6f, 0x61, 
-    0x74, 0x20, 0x75, 0x4f, 0x63, 0x63, 0x6c, 0x75, 0x73, 0x69, 0x6f, 0x6e, 0x3b, 0x75, 0x6e, 0x69, 
-    0x66, 0x6f, 0x72, 0x6d, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x75, 0x52, 0x6f, 0x75, 0x67, 
-    0x68, 0x6e, 0x65, 0x73, 0x73, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x66, 0x6c, 
-    0x6f, 0x61, 0x74, 0x20, 0x75, 0x4d, 0x65, 0x74, 0x61, 0x6c, 0x6e, 0x65, 0x73, 0x73, 0x3b, 0x75, 
-    0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x75, 0x41, 0x6d, 0x62, 
-    0x69, 0x65, 0x6e, 0x74, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 
-    0x6d, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x75, 0x45, 0x6d, 0x69, 0x73, 0x73, 0x69, 0x6f, 0x6e, 
-    0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 
-    0x6d, 0x70, 0x6c, 0x65, 0x72, 0x43, 0x75, 0x62, 0x65, 0x20, 0x75, 0x43, 0x75, 0x62, 0x65, 0x49, 
-    0x72, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 
-    0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x43, 0x75, 0x62, 0x65, 0x20, 0x75, 0x43, 
-    0x75, 0x62, 0x65, 0x50, 0x72, 0x65, 0x66, 0x69, 0x6c, 0x74, 0x65, 0x72, 0x3b, 0x75, 0x6e, 0x69, 
-    0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x75, 
-    0x54, 0x65, 0x78, 0x42, 0x72, 0x64, 0x66, 0x4c, 0x75, 0x74, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 
-    0x72, 0x6d, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x75, 0x51, 0x75, 0x61, 0x74, 0x53, 0x6b, 0x79, 
-    0x62, 0x6f, 0x78, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x62, 0x6f, 0x6f, 0x6c, 
-    0x20, 0x75, 0x48, 0x61, 0x73, 0x53, 0x6b, 0x79, 0x62, 0x6f, 0x78, 0x3b, 0x75, 0x6e, 0x69, 0x66, 
-    0x6f, 0x72, 0x6d, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x75, 0x53, 0x6b, 0x79, 0x62, 0x6f, 
-    0x78, 0x41, 0x6d, 0x62, 0x69, 0x65, 0x6e, 0x74, 0x49, 0x6e, 0x74, 0x65, 0x6e, 0x73, 0x69, 0x74, 
-    0x79, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
-    0x75, 0x53, 0x6b, 0x79, 0x62, 0x6f, 0x78, 0x52, 0x65, 0x66, 0x6c, 0x65, 0x63, 0x74, 0x49, 0x6e, 
-    0x74, 0x65, 0x6e, 0x73, 0x69, 0x74, 0x79, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 
-    0x4c, 0x69, 0x67, 0x68, 0x74, 0x20, 0x75, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x5b, 0x4e, 0x55, 
-    0x4d, 0x5f, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x53, 0x5d, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 
-    0x6d, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x75, 0x41, 0x6c, 0x70, 0x68, 0x61, 0x43, 0x75, 
-    0x74, 0x6f, 0x66, 0x66, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x76, 0x65, 0x63, 
-    0x33, 0x20, 0x75, 0x56, 0x69, 0x65, 0x77, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 
-    0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x75, 0x46, 
-    0x61, 0x72, 0x3b, 0x0a, 0x23, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x65, 0x20, 0x54, 0x45, 0x58, 0x5f, 
-    0x4e, 0x4f, 0x49, 0x53, 0x45, 0x5f, 0x53, 0x49, 0x5a, 0x45, 0x20, 0x36, 0x34, 0x0a, 0x23, 0x64, 
-    0x65, 0x66, 0x69, 0x6e, 0x65, 0x20, 0x53, 0x48, 0x41, 0x44, 0x4f, 0x57, 0x5f, 0x53, 0x41, 0x4d, 
-    0x50, 0x4c, 0x45, 0x53, 0x20, 0x31, 0x32, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 
-    0x63, 0x32, 0x20, 0x50, 0x4f, 0x49, 0x53, 0x53, 0x4f, 0x4e, 0x5f, 0x44, 0x49, 0x53, 0x4b, 0x5b, 
-    0x53, 0x48, 0x41, 0x44, 0x4f, 0x57, 0x5f, 0x53, 0x41, 0x4d, 0x50, 0x4c, 0x45, 0x53, 0x5d, 0x3d, 
-    0x76, 0x65, 0x63, 0x32, 0x5b, 0x5d, 0x28, 0x76, 0x65, 0x63, 0x32, 0x28, 0x2d, 0x30, 0x2e, 0x39, 
-    0x34, 0x32, 0x30, 0x31, 0x36, 0x32, 0x34, 0x2c, 0x2d, 0x30, 0x2e, 0x33, 0x39, 0x39, 0x30, 0x36, 
-    0x32, 0x31, 0x36, 0x29, 0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 0x30, 0x2e, 0x39, 0x34, 0x35, 0x35, 
-    0x38, 0x36, 0x30, 0x39, 0x2c, 0x2d, 0x30, 0x2e, 0x37, 0x36, 0x38, 0x39, 0x30, 0x37, 0x32, 0x35, 
-    0x29, 0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 0x2d, 0x30, 0x2e, 0x30, 0x39, 0x34, 0x31, 0x38, 0x34, 
-    0x31, 0x30, 0x31, 0x2c, 0x2d, 0x30, 0x2e, 0x39, 0x32, 0x39, 0x33, 0x38, 0x38, 0x37, 0x30, 0x29, 
-    0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 0x30, 0x2e, 0x33, 0x34, 0x34, 0x39, 0x35, 0x39, 0x33, 0x38, 
-    0x2c, 0x30, 0x2e, 0x32, 0x39, 0x33, 0x38, 0x37, 0x37, 0x36, 0x30, 0x29, 0x2c, 0x76, 0x65, 0x63, 
-    0x32, 0x28, 0x2d, 0x30, 0x2e, 0x39, 0x31, 0x35, 0x38, 0x38, 0x35, 0x38, 0x31, 0x2c, 0x30, 0x2e, 
-    0x34, 0x35, 0x37, 0x37, 0x31, 0x34, 0x33, 0x32, 0x29, 0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 0x2d, 
-    0x30, 0x2e, 0x38, 0x31, 0x35, 0x34, 0x34, 0x32, 0x33, 0x32, 0x2c, 0x2d, 0x30, 0x2e, 0x38, 0x37, 
-    0x39, 0x31, 0x32, 0x34, 0x36, 0x34, 0x29, 0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 0x2d, 0x30, 0x2e, 
-    0x33, 0x38, 0x32, 0x37, 0x37, 0x35, 0x34, 0x33, 0x2c, 0x30, 0x2e, 0x32, 0x37, 0x36, 0x37, 0x36, 
-    0x38, 0x34, 0x35, 0x29, 0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 0x30, 0x2e, 0x39, 0x37, 0x34, 0x38, 
-    0x34, 0x33, 0x39, 0x38, 0x2c, 0x30, 0x2e, 0x37, 0x35, 0x36, 0x34, 0x38, 0x33, 0x37, 0x39, 0x29, 
-    0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 0x30, 0x2e, 0x34, 0x34, 0x33, 0x32, 0x33, 0x33, 0x32, 0x35, 
-    0x2c, 0x2d, 0x30, 0x2e, 0x39, 0x37, 0x35, 0x31, 0x31, 0x35, 0x35, 0x34, 0x29, 0x2c, 0x76, 0x65, 
-    0x63, 0x32, 0x28, 0x30, 0x2e, 0x35, 0x33, 0x37, 0x34, 0x32, 0x39, 0x38, 0x31, 0x2c, 0x2d, 0x30, 
-    0x2e, 0x34, 0x37, 0x33, 0x37, 0x33, 0x34, 0x32, 0x30, 0x29, 0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 
-    0x2d, 0x30, 0x2e, 0x32, 0x36, 0x34, 0x39, 0x36, 0x39, 0x31, 0x31, 0x2c, 0x2d, 0x30, 0x2e, 0x34, 
-    0x31, 0x38, 0x39, 0x33, 0x30, 0x32, 0x33, 0x29, 0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 0x30, 0x2e, 
-    0x37, 0x39, 0x31, 0x39, 0x37, 0x35, 0x31, 0x34, 0x2c, 0x30, 0x2e, 0x31, 0x39, 0x30, 0x39, 0x30, 
-    0x31, 0x38, 0x38, 0x29, 0x29, 0x3b, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x28, 0x6c, 0x6f, 0x63, 
-    0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x30, 0x29, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 
-    0x20, 0x69, 0x3b, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 
-    0x6f, 0x6e, 0x3d, 0x31, 0x29, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x68, 0x3b, 
-    0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 
-    0x32, 0x29, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x6a, 0x3b, 0x6c, 0x61, 0x79, 
-    0x6f, 0x75, 0x74, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x33, 0x29, 0x6f, 
-    0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x6b, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
-    0x44, 0x69, 0x73, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x47, 0x47, 0x58, 0x28, 
-    0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x66, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x76, 
-    0x29, 0x7b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x3d, 0x61, 0x66, 0x2a, 0x76, 0x3b, 0x66, 
-    0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x74, 0x3d, 0x76, 0x2f, 0x28, 0x31, 0x2e, 0x30, 0x2d, 0x61, 
-    0x66, 0x2a, 0x61, 0x66, 0x2b, 0x73, 0x2a, 0x73, 0x29, 0x3b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 
-    0x20, 0x61, 0x74, 0x2a, 0x61, 0x74, 0x2a, 0x28, 0x31, 0x2e, 0x30, 0x2f, 0x50, 0x49, 0x29, 0x3b, 
-    0x7d, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x47, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x47, 
-    0x47, 0x58, 0x28, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x6f, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
-    0x20, 0x70, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x6f, 0x29, 0x7b, 0x72, 0x65, 0x74, 
-    0x75, 0x72, 0x6e, 0x20, 0x30, 0x2e, 0x35, 0x2f, 0x6d, 0x69, 0x78, 0x28, 0x32, 0x2e, 0x30, 0x2a, 
-    0x6f, 0x2a, 0x70, 0x2c, 0x6f, 0x2b, 0x70, 0x2c, 0x62, 0x6f, 0x29, 0x3b, 0x7d, 0x66, 0x6c, 0x6f, 
-    0x61, 0x74, 0x20, 0x53, 0x63, 0x68, 0x6c, 0x69, 0x63, 0x6b, 0x46, 0x72, 0x65, 0x73, 0x6e, 0x65, 
-    0x6c, 0x28, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x62, 0x29, 0x7b, 0x66, 0x6c, 0x6f, 0x61, 
-    0x74, 0x20, 0x61, 0x78, 0x3d, 0x31, 0x2e, 0x30, 0x2d, 0x63, 0x62, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 
-    0x74, 0x20, 0x61, 0x79, 0x3d, 0x61, 0x78, 0x2a, 0x61, 0x78, 0x3b, 0x72, 0x65, 0x74, 0x75, 0x72, 
-    0x6e, 0x20, 0x61, 0x79, 0x2a, 0x61, 0x79, 0x2a, 0x61, 0x78, 0x3b, 0x7d, 0x76, 0x65, 0x63, 0x33, 
-    0x20, 0x43, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x46, 0x30, 0x28, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
-    0x20, 0x61, 0x7a, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 
-    0x61, 0x72, 0x2c, 0x76, 0x65, 0x63, 0x33, 0x20, 0x75, 0x29, 0x7b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
-    0x20, 0x61, 0x68, 0x3d, 0x30, 0x2e, 0x31, 0x36, 0x2a, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 
-    0x72, 0x2a, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x3b, 0x72, 0x65, 0x74, 0x75, 0x72, 
-    0x6e, 0x20, 0x6d, 0x69, 0x78, 0x28, 0x76, 0x65, 0x63, 0x33, 0x28, 0x61, 0x68, 0x29, 0x2c, 0x75, 
-    0x2c, 0x76, 0x65, 0x63, 0x33, 0x28, 0x61, 0x7a, 0x29, 0x29, 0x3b, 0x7d, 0x76, 0x65, 0x63, 0x33, 
-    0x20, 0x49, 0x42, 0x4c, 0x5f, 0x46, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x53, 0x63, 0x68, 0x6c, 
-    0x69, 0x63, 0x6b, 0x52, 0x6f, 0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 0x73, 0x28, 0x66, 0x6c, 0x6f, 
-    0x61, 0x74, 0x20, 0x61, 0x66, 0x2c, 0x76, 0x65, 0x63, 0x33, 0x20, 0x46, 0x30, 0x2c, 0x66, 0x6c, 
-    0x6f, 0x61, 0x74, 0x20, 0x62, 0x6f, 0x29, 0x7b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x46, 
-    0x30, 0x2b, 0x28, 0x6d, 0x61, 0x78, 0x28, 0x76, 0x65, 0x63, 0x33, 0x28, 0x31, 0x2e, 0x30, 0x2d, 
-    0x62, 0x6f, 0x29, 0x2c, 0x46, 0x30, 0x29, 0x2d, 0x46, 0x30, 0x29, 0x2a, 0x70, 0x6f, 0x77, 0x28, 
-    0x63, 0x6c, 0x61, 0x6d, 0x70, 0x28, 0x31, 0x2e, 0x30, 0x2d, 0x61, 0x66, 0x2c, 0x30, 0x2e, 0x30, 
-    0x2c, 0x31, 0x2e, 0x30, 0x29, 0x2c, 0x35, 0x2e, 0x30, 0x29, 0x3b, 0x7d, 0x66, 0x6c, 0x6f, 0x61, 
-    0x74, 0x20, 0x49, 0x42, 0x4c, 0x5f, 0x47, 0x65, 0x74, 0x53, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 
-    0x72, 0x4d, 0x69, 0x70, 0x4c, 0x65, 0x76, 0x65, 0x6c, 0x28, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
-    0x62, 0x6f, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x65, 0x29, 0x7b, 0x72, 0x65, 0x74, 
-    0x75, 0x72, 0x6e, 0x20, 0x62, 0x6f, 0x2a, 0x62, 0x6f, 0x2a, 0x28, 0x62, 0x65, 0x2d, 0x31, 0x2e, 
-    0x30, 0x29, 0x3b, 0x7d, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x49, 0x42, 0x4c, 0x5f, 0x47, 0x65, 
-    0x74, 0x53, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x4f, 0x63, 0x63, 0x6c, 0x75, 0x73, 0x69, 
-    0x6f, 0x6e, 0x28, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x70, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
-    0x20, 0x79, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x6f, 0x29, 0x7b, 0x72, 0x65, 0x74, 
-    0x75, 0x72, 0x6e, 0x20, 0x63, 0x6c, 0x61, 0x6d, 0x70, 0x28, 0x70, 0x6f, 0x77, 0x28, 0x70, 0x2b, 
-    0x79, 0x2c, 0x65, 0x78, 0x70, 0x32, 0x28, 0x2d, 0x31, 0x36, 0x2e, 0x30, 0x2a, 0x62, 0x6f, 0x2d, 
-    0x31, 0x2e, 0x30, 0x29, 0x29, 0x2d, 0x31, 0x2e, 0x30, 0x2b, 0x79, 0x2c, 0x30, 0x2e, 0x30, 0x2c, 
-    0x31, 0x2e, 0x30, 0x29, 0x3b, 0x7d, 0x76, 0x65, 0x63, 0x33, 0x20, 0x49, 0x42, 0x4c, 0x5f, 0x47, 
-    0x65, 0x74, 0x4d, 0x75, 0x6c, 0x74, 0x69, 0x53, 0x63, 0x61, 0x74, 0x74, 0x65, 0x72, 0x42, 0x52, 
-    0x44, 0x46, 0x28, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x70, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
-    0x20, 0x62, 0x6f, 0x2c, 0x76, 0x65, 0x63, 0x33, 0x20, 0x46, 0x30, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 
-    0x74, 0x20, 0x62, 0x61, 0x29, 0x7b, 0x76, 0x65, 0x63, 0x32, 0x20, 0x61, 0x63, 0x3d, 0x74, 0x65, 
-    0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 0x54, 0x65, 0x78, 0x42, 0x72, 0x64, 0x66, 0x4c, 0x75, 
-    0x74, 0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 0x70, 0x2c, 0x62, 0x6f, 0x29, 0x29, 0x2e, 0x72, 0x67, 
-    0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6c, 0x3d, 0x46, 0x30, 0x2a, 0x61, 0x63, 0x2e, 0x78, 0x2b, 
-    0x61, 0x63, 0x2e, 0x79, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x3d, 0x61, 0x63, 0x2e, 
-    0x78, 0x2b, 0x61, 0x63, 0x2e, 0x79, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x3d, 0x31, 
-    0x2e, 0x30, 0x2d, 0x62, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x64, 0x3d, 0x6d, 0x69, 0x78, 0x28, 
-    0x46, 0x30, 0x2b, 0x28, 0x31, 0x2e, 0x30, 0x2d, 0x46, 0x30, 0x29, 0x2f, 0x32, 0x31, 0x2e, 0x30, 
-    0x2c, 0x46, 0x30, 0x2c, 0x62, 0x61, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x67, 0x3d, 0x6c, 
-    0x2a, 0x64, 0x2f, 0x28, 0x31, 0x2e, 0x30, 0x2d, 0x64, 0x2a, 0x61, 0x2b, 0x31, 0x65, 0x2d, 0x35, 
-    0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x63, 0x3d, 0x6d, 0x69, 0x78, 0x28, 0x31, 
-    0x2e, 0x30, 0x2c, 0x30, 0x2e, 0x38, 0x2c, 0x62, 0x61, 0x29, 0x3b, 0x72, 0x65, 0x74, 0x75, 0x72, 
-    0x6e, 0x20, 0x6c, 0x2b, 0x67, 0x2a, 0x61, 0x2a, 0x62, 0x63, 0x3b, 0x7d, 0x66, 0x6c, 0x6f, 0x61, 
-    0x74, 0x20, 0x44, 0x69, 0x66, 0x66, 0x75, 0x73, 0x65, 0x28, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
-    0x63, 0x4c, 0x64, 0x6f, 0x74, 0x48, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x4e, 0x64, 
-    0x6f, 0x74, 0x56, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 
-    0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x6f, 0x29, 0x7b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
-    0x20, 0x63, 0x3d, 0x32, 0x2e, 0x30, 0x2a, 0x63, 0x4c, 0x64, 0x6f, 0x74, 0x48, 0x2a, 0x63, 0x4c, 
-    0x64, 0x6f, 0x74, 0x48, 0x2a, 0x62, 0x6f, 0x2d, 0x30, 0x2e, 0x35, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 
-    0x74, 0x20, 0x66, 0x3d, 0x31, 0x2e, 0x30, 0x2b, 0x63, 0x2a, 0x53, 0x63, 0x68, 0x6c, 0x69, 0x63, 
-    0x6b, 0x46, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x28, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x56, 0x29, 
-    0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x65, 0x3d, 0x31, 0x2e, 0x30, 0x2b, 0x63, 0x2a, 0x53, 
-    0x63, 0x68, 0x6c, 0x69, 0x63, 0x6b, 0x46, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x28, 0x63, 0x4e, 
-    0x64, 0x6f, 0x74, 0x4c, 0x29, 0x3b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x28, 0x31, 0x2e, 0x30, 
-    0x2f, 0x50, 0x49, 0x29, 0x2a, 0x28, 0x66, 0x2a, 0x65, 0x2a, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 
-    0x29, 0x3b, 0x7d, 0x76, 0x65, 0x63, 0x33, 0x20, 0x53, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 
-    0x28, 0x76, 0x65, 0x63, 0x33, 0x20, 0x46, 0x30, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 
-    0x4c, 0x64, 0x6f, 0x74, 0x48, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x4e, 0x64, 0x6f, 
-    0x74, 0x48, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x56, 0x2c, 
-    0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 0x2c, 0x66, 0x6c, 0x6f, 
-    0x61, 0x74, 0x20, 0x62, 0x6f, 0x29, 0x7b, 0x62, 0x6f, 0x3d, 0x6d, 0x61, 0x78, 0x28, 0x62, 0x6f, 
-    0x2c, 0x31, 0x65, 0x2d, 0x33, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x77, 0x3d, 0x62, 
-    0x6f, 0x2a, 0x62, 0x6f, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x44, 0x3d, 0x44, 0x69, 0x73, 
-    0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x47, 0x47, 0x58, 0x28, 0x63, 0x4e, 0x64, 
-    0x6f, 0x74, 0x48, 0x2c, 0x77, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x47, 0x3d, 0x47, 
-    0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x47, 0x47, 0x58, 0x28, 0x63, 0x4e, 0x64, 0x6f, 0x74, 
-    0x4c, 0x2c, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x56, 0x2c, 0x77, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 
-    0x74, 0x20, 0x63, 0x4c, 0x64, 0x6f, 0x74, 0x48, 0x35, 0x3d, 0x53, 0x63, 0x68, 0x6c, 0x69, 0x63, 
-    0x6b, 0x46, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x28, 0x63, 0x4c, 0x64, 0x6f, 0x74, 0x48, 0x29, 
-    0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x46, 0x39, 0x30, 0x3d, 0x63, 0x6c, 0x61, 0x6d, 0x70, 
-    0x28, 0x35, 0x30, 0x2e, 0x30, 0x2a, 0x46, 0x30, 0x2e, 0x67, 0x2c, 0x30, 0x2e, 0x30, 0x2c, 0x31, 
-    0x2e, 0x30, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x46, 0x3d, 0x46, 0x30, 0x2b, 0x28, 0x46, 
-    0x39, 0x30, 0x2d, 0x46, 0x30, 0x29, 0x2a, 0x63, 0x4c, 0x64, 0x6f, 0x74, 0x48, 0x35, 0x3b, 0x72, 
-    0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 0x2a, 0x44, 0x2a, 0x46, 
-    0x2a, 0x47, 0x3b, 0x7d, 0x76, 0x65, 0x63, 0x32, 0x20, 0x52, 0x6f, 0x74, 0x61, 0x74, 0x65, 0x32, 
-    0x44, 0x28, 0x76, 0x65, 0x63, 0x32, 0x20, 0x63, 0x64, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
-    0x61, 0x64, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x71, 0x29, 0x7b, 0x72, 0x65, 0x74, 
-    0x75, 0x72, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 0x63, 0x64, 0x2e, 0x78, 0x2a, 0x61, 0x64, 
-    0x2d, 0x63, 0x64, 0x2e, 0x79, 0x2a, 0x62, 0x71, 0x2c, 0x63, 0x64, 0x2e, 0x78, 0x2a, 0x62, 0x71, 
-    0x2b, 0x63, 0x64, 0x2e, 0x79, 0x2a, 0x61, 0x64, 0x29, 0x3b, 0x7d, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
-    0x20, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x4f, 0x6d, 0x6e, 0x69, 0x28, 0x69, 0x6e, 0x74, 0x20, 
-    0x61, 0x70, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 0x29, 
-    0x7b, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x20, 0x61, 0x75, 0x3d, 0x75, 0x4c, 0x69, 0x67, 0x68, 0x74, 
-    0x73, 0x5b, 0x61, 0x70, 0x5d, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x61, 0x77, 0x3d, 0x76, 0x50, 
-    0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2d, 0x61, 0x75, 0x2e, 0x70, 0x6f, 0x73, 0x69, 0x74, 
-    0x69, 0x6f, 0x6e, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x67, 0x3d, 0x6c, 0x65, 0x6e, 
-    0x67, 0x74, 0x68, 0x28, 0x61, 0x77, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x64, 0x69, 0x72, 
-    0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 
-    0x28, 0x61, 0x77, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x61, 0x3d, 0x61, 0x75, 
-    0x2e, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x53, 0x6c, 0x6f, 0x70, 0x65, 0x42, 0x69, 0x61, 0x73, 
-    0x2a, 0x28, 0x31, 0x2e, 0x30, 0x2d, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 0x2a, 0x30, 0x2e, 0x35, 
-    0x29, 0x3b, 0x61, 0x61, 0x3d, 0x6d, 0x61, 0x78, 0x28, 0x61, 0x61, 0x2c, 0x61, 0x75, 0x2e, 0x73, 
-    0x68, 0x61, 0x64, 0x6f, 0x77, 0x44, 0x65, 0x70, 0x74, 0x68, 0x42, 0x69, 0x61, 0x73, 0x2a, 0x61, 
-    0x67, 0x29, 0x3b, 0x61, 0x67, 0x2d, 0x3d, 0x61, 0x61, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
-    0x74, 0x3d, 0x61, 0x75, 0x2e, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x53, 0x6f, 0x66, 0x74, 0x6e, 
-    0x65, 0x73, 0x73, 0x2a, 0x73, 0x71, 0x72, 0x74, 0x28, 0x61, 0x67, 0x2f, 0x61, 0x75, 0x2e, 0x66, 
-    0x61, 0x72, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 0x63, 0x3d, 0x61, 0x62, 0x73, 0x28, 
-    0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x79, 0x29, 0x3e, 0x20, 0x30, 0x2e, 
-    0x39, 0x39, 0x20, 0x3f, 0x20, 0x76, 0x65, 0x63, 0x33, 0x28, 0x31, 0x2e, 0x30, 0x2c, 0x30, 0x2e, 
-    0x30, 0x2c, 0x30, 0x2e, 0x30, 0x29, 0x3a, 0x20, 0x76, 0x65, 0x63, 0x33, 0x28, 0x30, 0x2e, 0x30, 
-    0x2c, 0x31, 0x2e, 0x30, 0x2c, 0x30, 0x2e, 0x30, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x62, 
-    0x7a, 0x3d, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x63, 0x72, 0x6f, 0x73, 
-    0x73, 0x28, 0x63, 0x63, 0x2c, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x29, 
-    0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x61, 0x62, 0x3d, 0x63, 0x72, 0x6f, 0x73, 0x73, 0x28, 0x64, 
-    0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x62, 0x7a, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 
-    0x61, 0x74, 0x20, 0x62, 0x6e, 0x3d, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 0x54, 
-    0x65, 0x78, 0x4e, 0x6f, 0x69, 0x73, 0x65, 0x2c, 0x67, 0x6c, 0x5f, 0x46, 0x72, 0x61, 0x67, 0x43, 
-    0x6f, 0x6f, 0x72, 0x64, 0x2e, 0x78, 0x79, 0x2a, 0x28, 0x31, 0x2e, 0x30, 0x2f, 0x66, 0x6c, 0x6f, 
-    0x61, 0x74, 0x28, 0x54, 0x45, 0x58, 0x5f, 0x4e, 0x4f, 0x49, 0x53, 0x45, 0x5f, 0x53, 0x49, 0x5a, 
-    0x45, 0x29, 0x29, 0x29, 0x2e, 0x72, 0x2a, 0x54, 0x41, 0x55, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
-    0x20, 0x62, 0x6c, 0x3d, 0x63, 0x6f, 0x73, 0x28, 0x62, 0x6e, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 
-    0x74, 0x20, 0x62, 0x70, 0x3d, 0x73, 0x69, 0x6e, 0x28, 0x62, 0x6e, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 
-    0x61, 0x74, 0x20, 0x61, 0x65, 0x3d, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 0x53, 
-    0x68, 0x61, 0x64, 0x6f, 0x77, 0x4d, 0x61, 0x70, 0x43, 0x75, 0x62, 0x65, 0x5b, 0x61, 0x70, 0x5d, 
-    0x2c, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x2e, 0x72, 0x2a, 0x61, 0x75, 
-    0x2e, 0x66, 0x61, 0x72, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 
-    0x77, 0x3d, 0x73, 0x74, 0x65, 0x70, 0x28, 0x61, 0x67, 0x2c, 0x61, 0x65, 0x29, 0x3b, 0x66, 0x6f, 
-    0x72, 0x28, 0x69, 0x6e, 0x74, 0x20, 0x61, 0x73, 0x3d, 0x30, 0x3b, 0x61, 0x73, 0x20, 0x3c, 0x20, 
-    0x53, 0x48, 0x41, 0x44, 0x4f, 0x57, 0x5f, 0x53, 0x41, 0x4d, 0x50, 0x4c, 0x45, 0x53, 0x3b, 0x2b, 
-    0x2b, 0x61, 0x73, 0x29, 0x7b, 0x76, 0x65, 0x63, 0x32, 0x20, 0x62, 0x6d, 0x3d, 0x52, 0x6f, 0x74, 
-    0x61, 0x74, 0x65, 0x32, 0x44, 0x28, 0x50, 0x4f, 0x49, 0x53, 0x53, 0x4f, 0x4e, 0x5f, 0x44, 0x49, 
-    0x53, 0x4b, 0x5b, 0x61, 0x73, 0x5d, 0x2c, 0x62, 0x6c, 0x2c, 0x62, 0x70, 0x29, 0x3b, 0x76, 0x65, 
-    0x63, 0x33, 0x20, 0x62, 0x73, 0x3d, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 
-    0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x2b, 0x28, 0x62, 0x7a, 0x2a, 0x62, 0x6d, 
-    0x2e, 0x78, 0x2b, 0x61, 0x62, 0x2a, 0x62, 0x6d, 0x2e, 0x79, 0x29, 0x2a, 0x74, 0x29, 0x3b, 0x66, 
-    0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x72, 0x3d, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 
-    0x75, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x4d, 0x61, 0x70, 0x43, 0x75, 0x62, 0x65, 0x5b, 0x61, 
-    0x70, 0x5d, 0x2c, 0x62, 0x73, 0x29, 0x2e, 0x72, 0x2a, 0x61, 0x75, 0x2e, 0x66, 0x61, 0x72, 0x3b, 
-    0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x2b, 0x3d, 0x73, 0x74, 0x65, 0x70, 0x28, 0x61, 0x67, 0x2c, 
-    0x62, 0x72, 0x29, 0x3b, 0x7d, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x73, 0x68, 0x61, 0x64, 
-    0x6f, 0x77, 0x2f, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x28, 0x53, 0x48, 0x41, 0x44, 0x4f, 0x57, 0x5f, 
-    0x53, 0x41, 0x4d, 0x50, 0x4c, 0x45, 0x53, 0x2b, 0x31, 0x29, 0x3b, 0x7d, 0x66, 0x6c, 0x6f, 0x61, 
-    0x74, 0x20, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x28, 0x69, 0x6e, 0x74, 0x20, 0x61, 0x70, 0x2c, 
-    0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 0x29, 0x7b, 0x4c, 0x69, 
-    0x67, 0x68, 0x74, 0x20, 0x61, 0x75, 0x3d, 0x75, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x5b, 0x61, 
-    0x70, 0x5d, 0x3b, 0x76, 0x65, 0x63, 0x34, 0x20, 0x62, 0x68, 0x3d, 0x76, 0x50, 0x6f, 0x73, 0x4c, 
-    0x69, 0x67, 0x68, 0x74, 0x53, 0x70, 0x61, 0x63, 0x65, 0x5b, 0x61, 0x70, 0x5d, 0x3b, 0x76, 0x65, 
-    0x63, 0x33, 0x20, 0x62, 0x6a, 0x3d, 0x62, 0x68, 0x2e, 0x78, 0x79, 0x7a, 0x2f, 0x62, 0x68, 0x2e, 
-    0x77, 0x3b, 0x62, 0x6a, 0x3d, 0x62, 0x6a, 0x2a, 0x30, 0x2e, 0x35, 0x2b, 0x30, 0x2e, 0x35, 0x3b, 
-    0x62, 0x6f, 0x6f, 0x6c, 0x20, 0x61, 0x72, 0x3d, 0x61, 0x6c, 0x6c, 0x28, 0x6c, 0x65, 0x73, 0x73, 
-    0x54, 0x68, 0x61, 0x6e, 0x45, 0x71, 0x75, 0x61, 0x6c, 0x28, 0x62, 0x6a, 0x2c, 0x76, 0x65, 0x63, 
-    0x33, 0x28, 0x31, 0x2e, 0x30, 0x29, 0x29, 0x29, 0x3b, 0x62, 0x6f, 0x6f, 0x6c, 0x20, 0x61, 0x71, 
-    0x3d, 0x61, 0x6c, 0x6c, 0x28, 0x67, 0x72, 0x65, 0x61, 0x74, 0x65, 0x72, 0x54, 0x68, 0x61, 0x6e, 
-    0x45, 0x71, 0x75, 0x61, 0x6c, 0x28, 0x62, 0x6a, 0x2c, 0x76, 0x65, 0x63, 0x33, 0x28, 0x30, 0x2e, 
-    0x30, 0x29, 0x29, 0x29, 0x3b, 0x69, 0x66, 0x28, 0x21, 0x28, 0x61, 0x72, 0x20, 0x26, 0x26, 0x20, 
-    0x61, 0x71, 0x29, 0x29, 0x7b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x31, 0x2e, 0x30, 0x3b, 
-    0x7d, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x61, 0x3d, 0x61, 0x75, 0x2e, 0x73, 0x68, 0x61, 
-    0x64, 0x6f, 0x77, 0x53, 0x6c, 0x6f, 0x70, 0x65, 0x42, 0x69, 0x61, 0x73, 0x2a, 0x28, 0x31, 0x2e, 
-    0x30, 0x2d, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 0x29, 0x3b, 0x61, 0x61, 0x3d, 0x6d, 0x61, 0x78, 
-    0x28, 0x61, 0x61, 0x2c, 0x61, 0x75, 0x2e, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x44, 0x65, 0x70, 
-    0x74, 0x68, 0x42, 0x69, 0x61, 0x73, 0x2a, 0x62, 0x6a, 0x2e, 0x7a, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 
-    0x61, 0x74, 0x20, 0x61, 0x67, 0x3d, 0x62, 0x6a, 0x2e, 0x7a, 0x2d, 0x61, 0x61, 0x3b, 0x66, 0x6c, 
-    0x6f, 0x61, 0x74, 0x20, 0x74, 0x3d, 0x61, 0x75, 0x2e, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x53, 
-    0x6f, 0x66, 0x74, 0x6e, 0x65, 0x73, 0x73, 0x2a, 0x73, 0x71, 0x72, 0x74, 0x28, 0x62, 0x6a, 0x2e, 
-    0x7a, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x6e, 0x3d, 0x74, 0x65, 0x78, 0x74, 
-    0x75, 0x72, 0x65, 0x28, 0x75, 0x54, 0x65, 0x78, 0x4e, 0x6f, 0x69, 0x73, 0x65, 0x2c, 0x67, 0x6c, 
-    0x5f, 0x46, 0x72, 0x61, 0x67, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x2e, 0x78, 0x79, 0x2a, 0x28, 0x31, 
-    0x2e, 0x30, 0x2f, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x28, 0x54, 0x45, 0x58, 0x5f, 0x4e, 0x4f, 0x49, 
-    0x53, 0x45, 0x5f, 0x53, 0x49, 0x5a, 0x45, 0x29, 0x29, 0x29, 0x2e, 0x72, 0x2a, 0x54, 0x41, 0x55, 
-    0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x6c, 0x3d, 0x63, 0x6f, 0x73, 0x28, 0x62, 0x6e, 
-    0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x70, 0x3d, 0x73, 0x69, 0x6e, 0x28, 0x62, 
-    0x6e, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x3d, 
-    0x73, 0x74, 0x65, 0x70, 0x28, 0x61, 0x67, 0x2c, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 
-    0x75, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x4d, 0x61, 0x70, 0x32, 0x44, 0x5b, 0x61, 0x70, 0x5d, 
-    0x2c, 0x62, 0x6a, 0x2e, 0x78, 0x79, 0x29, 0x2e, 0x72, 0x29, 0x3b, 0x66, 0x6f, 0x72, 0x28, 0x69, 
-    0x6e, 0x74, 0x20, 0x61, 0x73, 0x3d, 0x30, 0x3b, 0x61, 0x73, 0x20, 0x3c, 0x20, 0x53, 0x48, 0x41, 
-    0x44, 0x4f, 0x57, 0x5f, 0x53, 0x41, 0x4d, 0x50, 0x4c, 0x45, 0x53, 0x3b, 0x2b, 0x2b, 0x61, 0x73, 
-    0x29, 0x7b, 0x76, 0x65, 0x63, 0x32, 0x20, 0x6f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x3d, 0x52, 0x6f, 
-    0x74, 0x61, 0x74, 0x65, 0x32, 0x44, 0x28, 0x50, 0x4f, 0x49, 0x53, 0x53, 0x4f, 0x4e, 0x5f, 0x44, 
-    0x49, 0x53, 0x4b, 0x5b, 0x61, 0x73, 0x5d, 0x2c, 0x62, 0x6c, 0x2c, 0x62, 0x70, 0x29, 0x2a, 0x74, 
-    0x3b, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x2b, 0x3d, 0x73, 0x74, 0x65, 0x70, 0x28, 0x61, 0x67, 
-    0x2c, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 
-    0x4d, 0x61, 0x70, 0x32, 0x44, 0x5b, 0x61, 0x70, 0x5d, 0x2c, 0x62, 0x6a, 0x2e, 0x78, 0x79, 0x2b, 
-    0x6f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x29, 0x2e, 0x72, 0x29, 0x3b, 0x7d, 0x72, 0x65, 0x74, 0x75, 
+    0x78, 0x42, 0x72, 0x64, 0x66, 0x4c, 0x75, 0x74, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 
+    0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x75, 0x51, 0x75, 0x61, 0x74, 0x53, 0x6b, 0x79, 0x62, 0x6f, 
+    0x78, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x62, 0x6f, 0x6f, 0x6c, 0x20, 0x75, 
+    0x48, 0x61, 0x73, 0x53, 0x6b, 0x79, 0x62, 0x6f, 0x78, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 
+    0x6d, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x75, 0x53, 0x6b, 0x79, 0x62, 0x6f, 0x78, 0x41, 
+    0x6d, 0x62, 0x69, 0x65, 0x6e, 0x74, 0x49, 0x6e, 0x74, 0x65, 0x6e, 0x73, 0x69, 0x74, 0x79, 0x3b, 
+    0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x75, 0x53, 
+    0x6b, 0x79, 0x62, 0x6f, 0x78, 0x52, 0x65, 0x66, 0x6c, 0x65, 0x63, 0x74, 0x49, 0x6e, 0x74, 0x65, 
+    0x6e, 0x73, 0x69, 0x74, 0x79, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x4c, 0x69, 
+    0x67, 0x68, 0x74, 0x20, 0x75, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x5b, 0x4e, 0x55, 0x4d, 0x5f, 
+    0x4c, 0x49, 0x47, 0x48, 0x54, 0x53, 0x5d, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 
+    0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x75, 0x41, 0x6c, 0x70, 0x68, 0x61, 0x43, 0x75, 0x74, 0x6f, 
+    0x66, 0x66, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 
+    0x75, 0x56, 0x69, 0x65, 0x77, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x75, 0x6e, 
+    0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x75, 0x46, 0x61, 0x72, 
+    0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x62, 0x6f, 0x6f, 0x6c, 0x20, 0x75, 0x43, 
+    0x6c, 0x75, 0x73, 0x74, 0x65, 0x72, 0x65, 0x64, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 
+    0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x75, 0x54, 0x65, 0x78, 0x4c, 
+    0x69, 0x67, 0x68, 0x74, 0x73, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x75, 0x73, 
+    0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x75, 0x54, 0x65, 0x78, 0x43, 0x6c, 0x75, 
+    0x73, 0x74, 0x65, 0x72, 0x73, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x75, 0x73, 
+    0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x75, 0x54, 0x65, 0x78, 0x4c, 0x69, 0x67, 
+    0x68, 0x74, 0x49, 0x6e, 0x64, 0x69, 0x63, 0x65, 0x73, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 
+    0x6d, 0x20, 0x69, 0x6e, 0x74, 0x20, 0x75, 0x44, 0x69, 0x72, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x43, 
+    0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x69, 0x6e, 0x74, 
+    0x20, 0x75, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x4c, 0x69, 0x73, 0x74, 0x4f, 0x66, 0x66, 0x73, 0x65, 
+    0x74, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x69, 0x6e, 0x74, 0x20, 0x75, 0x4c, 
+    0x69, 0x67, 0x68, 0x74, 0x4c, 0x69, 0x73, 0x74, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x75, 0x6e, 
+    0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x75, 0x43, 0x6c, 0x75, 0x73, 
+    0x74, 0x65, 0x72, 0x53, 0x63, 0x61, 0x6c, 0x65, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 
+    0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x75, 0x43, 0x6c, 0x75, 0x73, 0x74, 0x65, 0x72, 0x53, 0x6c, 
+    0x69, 0x63, 0x65, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x6d, 0x61, 0x74, 0x34, 
+    0x20, 0x75, 0x4d, 0x61, 0x74, 0x56, 0x69, 0x65, 0x77, 0x3b, 0x0a, 0x23, 0x64, 0x65, 0x66, 0x69, 
+    0x6e, 0x65, 0x20, 0x54, 0x45, 0x58, 0x5f, 0x4e, 0x4f, 0x49, 0x53, 0x45, 0x5f, 0x53, 0x49, 0x5a, 
+    0x45, 0x20, 0x36, 0x34, 0x0a, 0x23, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x65, 0x20, 0x53, 0x48, 0x41, 
+    0x44, 0x4f, 0x57, 0x5f, 0x53, 0x41, 0x4d, 0x50, 0x4c, 0x45, 0x53, 0x20, 0x31, 0x32, 0x0a, 0x63, 
+    0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x50, 0x4f, 0x49, 0x53, 0x53, 0x4f, 
+    0x4e, 0x5f, 0x44, 0x49, 0x53, 0x4b, 0x5b, 0x53, 0x48, 0x41, 0x44, 0x4f, 0x57, 0x5f, 0x53, 0x41, 
+    0x4d, 0x50, 0x4c, 0x45, 0x53, 0x5d, 0x3d, 0x76, 0x65, 0x63, 0x32, 0x5b, 0x5d, 0x28, 0x76, 0x65, 
+    0x63, 0x32, 0x28, 0x2d, 0x30, 0x2e, 0x39, 0x34, 0x32, 0x30, 0x31, 0x36, 0x32, 0x34, 0x2c, 0x2d, 
+    0x30, 0x2e, 0x33, 0x39, 0x39, 0x30, 0x36, 0x32, 0x31, 0x36, 0x29, 0x2c, 0x76, 0x65, 0x63, 0x32, 
+    0x28, 0x30, 0x2e, 0x39, 0x34, 0x35, 0x35, 0x38, 0x36, 0x30, 0x39, 0x2c, 0x2d, 0x30, 0x2e, 0x37, 
+    0x36, 0x38, 0x39, 0x30, 0x37, 0x32, 0x35, 0x29, 0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 0x2d, 0x30, 
+    0x2e, 0x30, 0x39, 0x34, 0x31, 0x38, 0x34, 0x31, 0x30, 0x31, 0x2c, 0x2d, 0x30, 0x2e, 0x39, 0x32, 
+    0x39, 0x33, 0x38, 0x38, 0x37, 0x30, 0x29, 0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 0x30, 0x2e, 0x33, 
+    0x34, 0x34, 0x39, 0x35, 0x39, 0x33, 0x38, 0x2c, 0x30, 0x2e, 0x32, 0x39, 0x33, 0x38, 0x37, 0x37, 
+    0x36, 0x30, 0x29, 0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 0x2d, 0x30, 0x2e, 0x39, 0x31, 0x35, 0x38, 
+    0x38, 0x35, 0x38, 0x31, 0x2c, 0x30, 0x2e, 0x34, 0x35, 0x37, 0x37, 0x31, 0x34, 0x33, 0x32, 0x29, 
+    0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 0x2d, 0x30, 0x2e, 0x38, 0x31, 0x35, 0x34, 0x34, 0x32, 0x33, 
+    0x32, 0x2c, 0x2d, 0x30, 0x2e, 0x38, 0x37, 0x39, 0x31, 0x32, 0x34, 0x36, 0x34, 0x29, 0x2c, 0x76, 
+    0x65, 0x63, 0x32, 0x28, 0x2d, 0x30, 0x2e, 0x33, 0x38, 0x32, 0x37, 0x37, 0x35, 0x34, 0x33, 0x2c, 
+    0x30, 0x2e, 0x32, 0x37, 0x36, 0x37, 0x36, 0x38, 0x34, 0x35, 0x29, 0x2c, 0x76, 0x65, 0x63, 0x32, 
+    0x28, 0x30, 0x2e, 0x39, 0x37, 0x34, 0x38, 0x34, 0x33, 0x39, 0x38, 0x2c, 0x30, 0x2e, 0x37, 0x35, 
+    0x36, 0x34, 0x38, 0x33, 0x37, 0x39, 0x29, 0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 0x30, 0x2e, 0x34, 
+    0x34, 0x33, 0x32, 0x33, 0x33, 0x32, 0x35, 0x2c, 0x2d, 0x30, 0x2e, 0x39, 0x37, 0x35, 0x31, 0x31, 
+    0x35, 0x35, 0x34, 0x29, 0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 0x30, 0x2e, 0x35, 0x33, 0x37, 0x34, 
+    0x32, 0x39, 0x38, 0x31, 0x2c, 0x2d, 0x30, 0x2e, 0x34, 0x37, 0x33, 0x37, 0x33, 0x34, 0x32, 0x30, 
+    0x29, 0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 0x2d, 0x30, 0x2e, 0x32, 0x36, 0x34, 0x39, 0x36, 0x39, 
+    0x31, 0x31, 0x2c, 0x2d, 0x30, 0x2e, 0x34, 0x31, 0x38, 0x39, 0x33, 0x30, 0x32, 0x33, 0x29, 0x2c, 
+    0x76, 0x65, 0x63, 0x32, 0x28, 0x30, 0x2e, 0x37, 0x39, 0x31, 0x39, 0x37, 0x35, 0x31, 0x34, 0x2c, 
+    0x30, 0x2e, 0x31, 0x39, 0x30, 0x39, 0x30, 0x31, 0x38, 0x38, 0x29, 0x29, 0x3b, 0x6c, 0x61, 0x79, 
+    0x6f, 0x75, 0x74, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x30, 0x29, 0x6f, 
+    0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x69, 0x3b, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 
+    0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x31, 0x29, 0x6f, 0x75, 0x74, 0x20, 
+    0x76, 0x65, 0x63, 0x34, 0x20, 0x68, 0x3b, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x28, 0x6c, 0x6f, 
+    0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x32, 0x29, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 
+    0x34, 0x20, 0x6a, 0x3b, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 
+    0x69, 0x6f, 0x6e, 0x3d, 0x33, 0x29, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x6b, 
+    0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x44, 0x69, 0x73, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 
+    0x69, 0x6f, 0x6e, 0x47, 0x47, 0x58, 0x28, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x66, 0x2c, 
+    0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x76, 0x29, 0x7b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 
+    0x3d, 0x61, 0x66, 0x2a, 0x76, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x74, 0x3d, 0x76, 
+    0x2f, 0x28, 0x31, 0x2e, 0x30, 0x2d, 0x61, 0x66, 0x2a, 0x61, 0x66, 0x2b, 0x73, 0x2a, 0x73, 0x29, 
+    0x3b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x61, 0x74, 0x2a, 0x61, 0x74, 0x2a, 0x28, 0x31, 
+    0x2e, 0x30, 0x2f, 0x50, 0x49, 0x29, 0x3b, 0x7d, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x47, 0x65, 
+    0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x47, 0x47, 0x58, 0x28, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
+    0x6f, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x70, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
+    0x62, 0x6f, 0x29, 0x7b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x30, 0x2e, 0x35, 0x2f, 0x6d, 
+    0x69, 0x78, 0x28, 0x32, 0x2e, 0x30, 0x2a, 0x6f, 0x2a, 0x70, 0x2c, 0x6f, 0x2b, 0x70, 0x2c, 0x62, 
+    0x6f, 0x29, 0x3b, 0x7d, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x53, 0x63, 0x68, 0x6c, 0x69, 0x63, 
+    0x6b, 0x46, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x28, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 
+    0x62, 0x29, 0x7b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x78, 0x3d, 0x31, 0x2e, 0x30, 0x2d, 
+    0x63, 0x62, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x79, 0x3d, 0x61, 0x78, 0x2a, 0x61, 
+    0x78, 0x3b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x61, 0x79, 0x2a, 0x61, 0x79, 0x2a, 0x61, 
+    0x78, 0x3b, 0x7d, 0x76, 0x65, 0x63, 0x33, 0x20, 0x43, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x46, 
+    0x30, 0x28, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x7a, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
+    0x20, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x2c, 0x76, 0x65, 0x63, 0x33, 0x20, 0x75, 
+    0x29, 0x7b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x68, 0x3d, 0x30, 0x2e, 0x31, 0x36, 0x2a, 
+    0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x2a, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 
+    0x72, 0x3b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x6d, 0x69, 0x78, 0x28, 0x76, 0x65, 0x63, 
+    0x33, 0x28, 0x61, 0x68, 0x29, 0x2c, 0x75, 0x2c, 0x76, 0x65, 0x63, 0x33, 0x28, 0x61, 0x7a, 0x29, 
+    0x29, 0x3b, 0x7d, 0x76, 0x65, 0x63, 0x33, 0x20, 0x49, 0x42, 0x4c, 0x5f, 0x46, 0x72, 0x65, 0x73, 
+    0x6e, 0x65, 0x6c, 0x53, 0x63, 0x68, 0x6c, 0x69, 0x63, 0x6b, 0x52, 0x6f, 0x75, 0x67, 0x68, 0x6e, 
+    0x65, 0x73, 0x73, 0x28, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x66, 0x2c, 0x76, 0x65, 0x63, 
+    0x33, 0x20, 0x46, 0x30, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x6f, 0x29, 0x7b, 0x72, 
+    0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x46, 0x30, 0x2b, 0x28, 0x6d, 0x61, 0x78, 0x28, 0x76, 0x65, 
+    0x63, 0x33, 0x28, 0x31, 0x2e, 0x30, 0x2d, 0x62, 0x6f, 0x29, 0x2c, 0x46, 0x30, 0x29, 0x2d, 0x46, 
+    0x30, 0x29, 0x2a, 0x70, 0x6f, 0x77, 0x28, 0x63, 0x6c, 0x61, 0x6d, 0x70, 0x28, 0x31, 0x2e, 0x30, 
+    0x2d, 0x61, 0x66, 0x2c, 0x30, 0x2e, 0x30, 0x2c, 0x31, 0x2e, 0x30, 0x29, 0x2c, 0x35, 0x2e, 0x30, 
+    0x29, 0x3b, 0x7d, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x49, 0x42, 0x4c, 0x5f, 0x47, 0x65, 0x74, 
+    0x53, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x4d, 0x69, 0x70, 0x4c, 0x65, 0x76, 0x65, 0x6c, 
+    0x28, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x6f, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
+    0x62, 0x65, 0x29, 0x7b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x62, 0x6f, 0x2a, 0x62, 0x6f, 
+    0x2a, 0x28, 0x62, 0x65, 0x2d, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x7d, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
+    0x20, 0x49, 0x42, 0x4c, 0x5f, 0x47, 0x65, 0x74, 0x53, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 
+    0x4f, 0x63, 0x63, 0x6c, 0x75, 0x73, 0x69, 0x6f, 0x6e, 0x28, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
+    0x70, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x79, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
+    0x62, 0x6f, 0x29, 0x7b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x63, 0x6c, 0x61, 0x6d, 0x70, 
+    0x28, 0x70, 0x6f, 0x77, 0x28, 0x70, 0x2b, 0x79, 0x2c, 0x65, 0x78, 0x70, 0x32, 0x28, 0x2d, 0x31, 
+    0x36, 0x2e, 0x30, 0x2a, 0x62, 0x6f, 0x2d, 0x31, 0x2e, 0x30, 0x29, 0x29, 0x2d, 0x31, 0x2e, 0x30, 
+    0x2b, 0x79, 0x2c, 0x30, 0x2e, 0x30, 0x2c, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x7d, 0x76, 0x65, 0x63, 
+    0x33, 0x20, 0x49, 0x42, 0x4c, 0x5f, 0x47, 0x65, 0x74, 0x4d, 0x75, 0x6c, 0x74, 0x69, 0x53, 0x63, 
+    0x61, 0x74, 0x74, 0x65, 0x72, 0x42, 0x52, 0x44, 0x46, 0x28, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
+    0x70, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x6f, 0x2c, 0x76, 0x65, 0x63, 0x33, 0x20, 
+    0x46, 0x30, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x61, 0x29, 0x7b, 0x76, 0x65, 0x63, 
+    0x32, 0x20, 0x61, 0x63, 0x3d, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 0x54, 0x65, 
+    0x78, 0x42, 0x72, 0x64, 0x66, 0x4c, 0x75, 0x74, 0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 0x70, 0x2c, 
+    0x62, 0x6f, 0x29, 0x29, 0x2e, 0x72, 0x67, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6c, 0x3d, 0x46, 
+    0x30, 0x2a, 0x61, 0x63, 0x2e, 0x78, 0x2b, 0x61, 0x63, 0x2e, 0x79, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 
+    0x74, 0x20, 0x62, 0x3d, 0x61, 0x63, 0x2e, 0x78, 0x2b, 0x61, 0x63, 0x2e, 0x79, 0x3b, 0x66, 0x6c, 
+    0x6f, 0x61, 0x74, 0x20, 0x61, 0x3d, 0x31, 0x2e, 0x30, 0x2d, 0x62, 0x3b, 0x76, 0x65, 0x63, 0x33, 
+    0x20, 0x64, 0x3d, 0x6d, 0x69, 0x78, 0x28, 0x46, 0x30, 0x2b, 0x28, 0x31, 0x2e, 0x30, 0x2d, 0x46, 
+    0x30, 0x29, 0x2f, 0x32, 0x31, 0x2e, 0x30, 0x2c, 0x46, 0x30, 0x2c, 0x62, 0x61, 0x29, 0x3b, 0x76, 
+    0x65, 0x63, 0x33, 0x20, 0x67, 0x3d, 0x6c, 0x2a, 0x64, 0x2f, 0x28, 0x31, 0x2e, 0x30, 0x2d, 0x64, 
+    0x2a, 0x61, 0x2b, 0x31, 0x65, 0x2d, 0x35, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 
+    0x63, 0x3d, 0x6d, 0x69, 0x78, 0x28, 0x31, 0x2e, 0x30, 0x2c, 0x30, 0x2e, 0x38, 0x2c, 0x62, 0x61, 
+    0x29, 0x3b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x6c, 0x2b, 0x67, 0x2a, 0x61, 0x2a, 0x62, 
+    0x63, 0x3b, 0x7d, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x44, 0x69, 0x66, 0x66, 0x75, 0x73, 0x65, 
+    0x28, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x4c, 0x64, 0x6f, 0x74, 0x48, 0x2c, 0x66, 0x6c, 
+    0x6f, 0x61, 0x74, 0x20, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x56, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
+    0x20, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x6f, 
+    0x29, 0x7b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x3d, 0x32, 0x2e, 0x30, 0x2a, 0x63, 0x4c, 
+    0x64, 0x6f, 0x74, 0x48, 0x2a, 0x63, 0x4c, 0x64, 0x6f, 0x74, 0x48, 0x2a, 0x62, 0x6f, 0x2d, 0x30, 
+    0x2e, 0x35, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x66, 0x3d, 0x31, 0x2e, 0x30, 0x2b, 0x63, 
+    0x2a, 0x53, 0x63, 0x68, 0x6c, 0x69, 0x63, 0x6b, 0x46, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x28, 
+    0x63, 0x4e, 0x64, 0x6f, 0x74, 0x56, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x65, 0x3d, 
+    0x31, 0x2e, 0x30, 0x2b, 0x63, 0x2a, 0x53, 0x63, 0x68, 0x6c, 0x69, 0x63, 0x6b, 0x46, 0x72, 0x65, 
+    0x73, 0x6e, 0x65, 0x6c, 0x28, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 0x29, 0x3b, 0x72, 0x65, 0x74, 
+    0x75, 0x72, 0x6e, 0x28, 0x31, 0x2e, 0x30, 0x2f, 0x50, 0x49, 0x29, 0x2a, 0x28, 0x66, 0x2a, 0x65, 
+    0x2a, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 0x29, 0x3b, 0x7d, 0x76, 0x65, 0x63, 0x33, 0x20, 0x53, 
+    0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x28, 0x76, 0x65, 0x63, 0x33, 0x20, 0x46, 0x30, 0x2c, 
+    0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x4c, 0x64, 0x6f, 0x74, 0x48, 0x2c, 0x66, 0x6c, 0x6f, 
+    0x61, 0x74, 0x20, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x48, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
+    0x63, 0x4e, 0x64, 0x6f, 0x74, 0x56, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x4e, 0x64, 
+    0x6f, 0x74, 0x4c, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x6f, 0x29, 0x7b, 0x62, 0x6f, 
+    0x3d, 0x6d, 0x61, 0x78, 0x28, 0x62, 0x6f, 0x2c, 0x31, 0x65, 0x2d, 0x33, 0x29, 0x3b, 0x66, 0x6c, 
+    0x6f, 0x61, 0x74, 0x20, 0x77, 0x3d, 0x62, 0x6f, 0x2a, 0x62, 0x6f, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 
+    0x74, 0x20, 0x44, 0x3d, 0x44, 0x69, 0x73, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x69, 0x6f, 0x6e, 
+    0x47, 0x47, 0x58, 0x28, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x48, 0x2c, 0x77, 0x29, 0x3b, 0x66, 0x6c, 
+    0x6f, 0x61, 0x74, 0x20, 0x47, 0x3d, 0x47, 0x65, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x79, 0x47, 0x47, 
+    0x58, 0x28, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 0x2c, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x56, 0x2c, 
+    0x77, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x4c, 0x64, 0x6f, 0x74, 0x48, 0x35, 
+    0x3d, 0x53, 0x63, 0x68, 0x6c, 0x69, 0x63, 0x6b, 0x46, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x28, 
+    0x63, 0x4c, 0x64, 0x6f, 0x74, 0x48, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x46, 0x39, 
+    0x30, 0x3d, 0x63, 0x6c, 0x61, 0x6d, 0x70, 0x28, 0x35, 0x30, 0x2e, 0x30, 0x2a, 0x46, 0x30, 0x2e, 
+    0x67, 0x2c, 0x30, 0x2e, 0x30, 0x2c, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 
+    0x46, 0x3d, 0x46, 0x30, 0x2b, 0x28, 0x46, 0x39, 0x30, 0x2d, 0x46, 0x30, 0x29, 0x2a, 0x63, 0x4c, 
+    0x64, 0x6f, 0x74, 0x48, 0x35, 0x3b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x63, 0x4e, 0x64, 
+    0x6f, 0x74, 0x4c, 0x2a, 0x44, 0x2a, 0x46, 0x2a, 0x47, 0x3b, 0x7d, 0x76, 0x65, 0x63, 0x32, 0x20, 
+    0x52, 0x6f, 0x74, 0x61, 0x74, 0x65, 0x32, 0x44, 0x28, 0x76, 0x65, 0x63, 0x32, 0x20, 0x63, 0x64, 
+    0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x64, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
+    0x62, 0x71, 0x29, 0x7b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 
+    0x63, 0x64, 0x2e, 0x78, 0x2a, 0x61, 0x64, 0x2d, 0x63, 0x64, 0x2e, 0x79, 0x2a, 0x62, 0x71, 0x2c, 
+    0x63, 0x64, 0x2e, 0x78, 0x2a, 0x62, 0x71, 0x2b, 0x63, 0x64, 0x2e, 0x79, 0x2a, 0x61, 0x64, 0x29, 
+    0x3b, 0x7d, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x4f, 0x6d, 
+    0x6e, 0x69, 0x28, 0x69, 0x6e, 0x74, 0x20, 0x61, 0x70, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
+    0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 0x29, 0x7b, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x20, 0x61, 0x75, 
+    0x3d, 0x75, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x5b, 0x61, 0x70, 0x5d, 0x3b, 0x76, 0x65, 0x63, 
+    0x33, 0x20, 0x61, 0x77, 0x3d, 0x76, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2d, 0x61, 
+    0x75, 0x2e, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
+    0x20, 0x61, 0x67, 0x3d, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x28, 0x61, 0x77, 0x29, 0x3b, 0x76, 
+    0x65, 0x63, 0x33, 0x20, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x6e, 0x6f, 
+    0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x61, 0x77, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 
+    0x74, 0x20, 0x61, 0x61, 0x3d, 0x61, 0x75, 0x2e, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x53, 0x6c, 
+    0x6f, 0x70, 0x65, 0x42, 0x69, 0x61, 0x73, 0x2a, 0x28, 0x31, 0x2e, 0x30, 0x2d, 0x63, 0x4e, 0x64, 
+    0x6f, 0x74, 0x4c, 0x2a, 0x30, 0x2e, 0x35, 0x29, 0x3b, 0x61, 0x61, 0x3d, 0x6d, 0x61, 0x78, 0x28, 
+    0x61, 0x61, 0x2c, 0x61, 0x75, 0x2e, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x44, 0x65, 0x70, 0x74, 
+    0x68, 0x42, 0x69, 0x61, 0x73, 0x2a, 0x61, 0x67, 0x29, 0x3b, 0x61, 0x67, 0x2d, 0x3d, 0x61, 0x61, 
+    0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x74, 0x3d, 0x61, 0x75, 0x2e, 0x73, 0x68, 0x61, 0x64, 
+    0x6f, 0x77, 0x53, 0x6f, 0x66, 0x74, 0x6e, 0x65, 0x73, 0x73, 0x2a, 0x73, 0x71, 0x72, 0x74, 0x28, 
+    0x61, 0x67, 0x2f, 0x61, 0x75, 0x2e, 0x66, 0x61, 0x72, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 
+    0x63, 0x63, 0x3d, 0x61, 0x62, 0x73, 0x28, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 
+    0x2e, 0x79, 0x29, 0x3e, 0x20, 0x30, 0x2e, 0x39, 0x39, 0x20, 0x3f, 0x20, 0x76, 0x65, 0x63, 0x33, 
+    0x28, 0x31, 0x2e, 0x30, 0x2c, 0x30, 0x2e, 0x30, 0x2c, 0x30, 0x2e, 0x30, 0x29, 0x3a, 0x20, 0x76, 
+    0x65, 0x63, 0x33, 0x28, 0x30, 0x2e, 0x30, 0x2c, 0x31, 0x2e, 0x30, 0x2c, 0x30, 0x2e, 0x30, 0x29, 
+    0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x62, 0x7a, 0x3d, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 
+    0x7a, 0x65, 0x28, 0x63, 0x72, 0x6f, 0x73, 0x73, 0x28, 0x63, 0x63, 0x2c, 0x64, 0x69, 0x72, 0x65, 
+    0x63, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x61, 0x62, 0x3d, 
+    0x63, 0x72, 0x6f, 0x73, 0x73, 0x28, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 
+    0x62, 0x7a, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x6e, 0x3d, 0x74, 0x65, 0x78, 
+    0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 0x54, 0x65, 0x78, 0x4e, 0x6f, 0x69, 0x73, 0x65, 0x2c, 0x67, 
+    0x6c, 0x5f, 0x46, 0x72, 0x61, 0x67, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x2e, 0x78, 0x79, 0x2a, 0x28, 
+    0x31, 0x2e, 0x30, 0x2f, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x28, 0x54, 0x45, 0x58, 0x5f, 0x4e, 0x4f, 
+    0x49, 0x53, 0x45, 0x5f, 0x53, 0x49, 0x5a, 0x45, 0x29, 0x29, 0x29, 0x2e, 0x72, 0x2a, 0x54, 0x41, 
+    0x55, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x6c, 0x3d, 0x63, 0x6f, 0x73, 0x28, 0x62, 
+    0x6e, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x70, 0x3d, 0x73, 0x69, 0x6e, 0x28, 
+    0x62, 0x6e, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x65, 0x3d, 0x74, 0x65, 0x78, 
+    0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x4d, 0x61, 0x70, 0x43, 
+    0x75, 0x62, 0x65, 0x5b, 0x61, 0x70, 0x5d, 0x2c, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 
+    0x6e, 0x29, 0x2e, 0x72, 0x2a, 0x61, 0x75, 0x2e, 0x66, 0x61, 0x72, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 
+    0x74, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x3d, 0x73, 0x74, 0x65, 0x70, 0x28, 0x61, 0x67, 
+    0x2c, 0x61, 0x65, 0x29, 0x3b, 0x66, 0x6f, 0x72, 0x28, 0x69, 0x6e, 0x74, 0x20, 0x61, 0x73, 0x3d, 
+    0x30, 0x3b, 0x61, 0x73, 0x20, 0x3c, 0x20, 0x53, 0x48, 0x41, 0x44, 0x4f, 0x57, 0x5f, 0x53, 0x41, 
+    0x4d, 0x50, 0x4c, 0x45, 0x53, 0x3b, 0x2b, 0x2b, 0x61, 0x73, 0x29, 0x7b, 0x76, 0x65, 0x63, 0x32, 
+    0x20, 0x62, 0x6d, 0x3d, 0x52, 0x6f, 0x74, 0x61, 0x74, 0x65, 0x32, 0x44, 0x28, 0x50, 0x4f, 0x49, 
+    0x53, 0x53, 0x4f, 0x4e, 0x5f, 0x44, 0x49, 0x53, 0x4b, 0x5b, 0x61, 0x73, 0x5d, 0x2c, 0x62, 0x6c, 
+    0x2c, 0x62, 0x70, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x62, 0x73, 0x3d, 0x6e, 0x6f, 0x72, 
+    0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 
+    0x2b, 0x28, 0x62, 0x7a, 0x2a, 0x62, 0x6d, 0x2e, 0x78, 0x2b, 0x61, 0x62, 0x2a, 0x62, 0x6d, 0x2e, 
+    0x79, 0x29, 0x2a, 0x74, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x72, 0x3d, 0x74, 
+    0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x4d, 0x61, 
+    0x70, 0x43, 0x75, 0x62, 0x65, 0x5b, 0x61, 0x70, 0x5d, 0x2c, 0x62, 0x73, 0x29, 0x2e, 0x72, 0x2a, 
+    0x61, 0x75, 0x2e, 0x66, 0x61, 0x72, 0x3b, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x2b, 0x3d, 0x73, 
+    0x74, 0x65, 0x70, 0x28, 0x61, 0x67, 0x2c, 0x62, 0x72, 0x29, 0x3b, 0x7d, 0x72, 0x65, 0x74, 0x75, 
     0x72, 0x6e, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x2f, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x28, 
     0x53, 0x48, 0x41, 0x44, 0x4f, 0x57, 0x5f, 0x53, 0x41, 0x4d, 0x50, 0x4c, 0x45, 0x53, 0x2b, 0x31, 
-    0x29, 0x3b, 0x7d, 0x76, 0x65, 0x63, 0x32, 0x20, 0x4f, 0x63, 0x74, 0x61, 0x68, 0x65, 0x64, 0x72, 
-    0x6f, 0x6e, 0x57, 0x72, 0x61, 0x70, 0x28, 0x76, 0x65, 0x63, 0x32, 0x20, 0x63, 0x65, 0x29, 0x7b, 
-    0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x28, 0x31, 0x2e, 0x30, 0x2d, 0x61, 0x62, 0x73, 0x28, 0x63, 
-    0x65, 0x2e, 0x79, 0x78, 0x29, 0x29, 0x2a, 0x6d, 0x69, 0x78, 0x28, 0x76, 0x65, 0x63, 0x32, 0x28, 
-    0x2d, 0x31, 0x2e, 0x30, 0x29, 0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 0x31, 0x2e, 0x30, 0x29, 0x2c, 
-    0x76, 0x65, 0x63, 0x32, 0x28, 0x67, 0x72, 0x65, 0x61, 0x74, 0x65, 0x72, 0x54, 0x68, 0x61, 0x6e, 
-    0x45, 0x71, 0x75, 0x61, 0x6c, 0x28, 0x63, 0x65, 0x2e, 0x78, 0x79, 0x2c, 0x76, 0x65, 0x63, 0x32, 
-    0x28, 0x30, 0x2e, 0x30, 0x29, 0x29, 0x29, 0x29, 0x3b, 0x7d, 0x76, 0x65, 0x63, 0x32, 0x20, 0x45, 
-    0x6e, 0x63, 0x6f, 0x64, 0x65, 0x4f, 0x63, 0x74, 0x61, 0x68, 0x65, 0x64, 0x72, 0x61, 0x6c, 0x28, 
-    0x76, 0x65, 0x63, 0x33, 0x20, 0x62, 0x64, 0x29, 0x7b, 0x62, 0x64, 0x2f, 0x3d, 0x61, 0x62, 0x73, 
-    0x28, 0x62, 0x64, 0x2e, 0x78, 0x29, 0x2b, 0x61, 0x62, 0x73, 0x28, 0x62, 0x64, 0x2e, 0x79, 0x29, 
-    0x2b, 0x61, 0x62, 0x73, 0x28, 0x62, 0x64, 0x2e, 0x7a, 0x29, 0x3b, 0x62, 0x64, 0x2e, 0x78, 0x79, 
-    0x3d, 0x62, 0x64, 0x2e, 0x7a, 0x20, 0x3e, 0x3d, 0x30, 0x2e, 0x30, 0x20, 0x3f, 0x20, 0x62, 0x64, 
-    0x2e, 0x78, 0x79, 0x20, 0x3a, 0x20, 0x4f, 0x63, 0x74, 0x61, 0x68, 0x65, 0x64, 0x72, 0x6f, 0x6e, 
-    0x57, 0x72, 0x61, 0x70, 0x28, 0x62, 0x64, 0x2e, 0x78, 0x79, 0x29, 0x3b, 0x62, 0x64, 0x2e, 0x78, 
-    0x79, 0x3d, 0x62, 0x64, 0x2e, 0x78, 0x79, 0x2a, 0x30, 0x2e, 0x35, 0x2b, 0x30, 0x2e, 0x35, 0x3b, 
-    0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x62, 0x64, 0x2e, 0x78, 0x79, 0x3b, 0x7d, 0x76, 0x65, 
-    0x63, 0x33, 0x20, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x53, 0x63, 0x61, 0x6c, 0x65, 0x28, 0x76, 
-    0x65, 0x63, 0x33, 0x20, 0x62, 0x64, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x74, 0x29, 
-    0x7b, 0x62, 0x64, 0x2e, 0x78, 0x79, 0x2a, 0x3d, 0x62, 0x74, 0x3b, 0x62, 0x64, 0x2e, 0x7a, 0x3d, 
-    0x73, 0x71, 0x72, 0x74, 0x28, 0x31, 0x2e, 0x30, 0x2d, 0x63, 0x6c, 0x61, 0x6d, 0x70, 0x28, 0x64, 
-    0x6f, 0x74, 0x28, 0x62, 0x64, 0x2e, 0x78, 0x79, 0x2c, 0x62, 0x64, 0x2e, 0x78, 0x79, 0x29, 0x2c, 
-    0x30, 0x2e, 0x30, 0x2c, 0x31, 0x2e, 0x30, 0x29, 0x29, 0x3b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 
-    0x20, 0x62, 0x64, 0x3b, 0x7d, 0x76, 0x65, 0x63, 0x33, 0x20, 0x52, 0x6f, 0x74, 0x61, 0x74, 0x65, 
-    0x57, 0x69, 0x74, 0x68, 0x51, 0x75, 0x61, 0x74, 0x28, 0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 0x64, 
-    0x2c, 0x76, 0x65, 0x63, 0x34, 0x20, 0x62, 0x6b, 0x29, 0x7b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x62, 
-    0x79, 0x3d, 0x32, 0x2e, 0x30, 0x2a, 0x63, 0x72, 0x6f, 0x73, 0x73, 0x28, 0x62, 0x6b, 0x2e, 0x78, 
-    0x79, 0x7a, 0x2c, 0x63, 0x64, 0x29, 0x3b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x63, 0x64, 
-    0x2b, 0x62, 0x6b, 0x2e, 0x77, 0x2a, 0x62, 0x79, 0x2b, 0x63, 0x72, 0x6f, 0x73, 0x73, 0x28, 0x62, 
-    0x6b, 0x2e, 0x78, 0x79, 0x7a, 0x2c, 0x62, 0x79, 0x29, 0x3b, 0x7d, 0x76, 0x6f, 0x69, 0x64, 0x20, 
-    0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29, 0x7b, 0x76, 0x65, 0x63, 0x34, 0x20, 0x75, 0x3d, 0x76, 0x43, 
-    0x6f, 0x6c, 0x6f, 0x72, 0x2a, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 0x54, 0x65, 
-    0x78, 0x41, 0x6c, 0x62, 0x65, 0x64, 0x6f, 0x2c, 0x76, 0x54, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 
-    0x64, 0x29, 0x3b, 0x69, 0x66, 0x28, 0x75, 0x2e, 0x61, 0x20, 0x3c, 0x20, 0x75, 0x41, 0x6c, 0x70, 
-    0x68, 0x61, 0x43, 0x75, 0x74, 0x6f, 0x66, 0x66, 0x29, 0x64, 0x69, 0x73, 0x63, 0x61, 0x72, 0x64, 
-    0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x61, 0x6e, 0x3d, 0x75, 0x45, 0x6d, 0x69, 0x73, 0x73, 0x69, 
-    0x6f, 0x6e, 0x45, 0x6e, 0x65, 0x72, 0x67, 0x79, 0x2a, 0x28, 0x75, 0x45, 0x6d, 0x69, 0x73, 0x73, 
-    0x69, 0x6f, 0x6e, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x2a, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 
-    0x28, 0x75, 0x54, 0x65, 0x78, 0x45, 0x6d, 0x69, 0x73, 0x73, 0x69, 0x6f, 0x6e, 0x2c, 0x76, 0x54, 
-    0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x29, 0x2e, 0x72, 0x67, 0x62, 0x29, 0x3b, 0x76, 0x65, 
-    0x63, 0x33, 0x20, 0x62, 0x67, 0x3d, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 0x54, 
-    0x65, 0x78, 0x4f, 0x52, 0x4d, 0x2c, 0x76, 0x54, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x29, 
-    0x2e, 0x72, 0x67, 0x62, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x66, 0x3d, 0x75, 0x4f, 
-    0x63, 0x63, 0x6c, 0x75, 0x73, 0x69, 0x6f, 0x6e, 0x2a, 0x62, 0x67, 0x2e, 0x78, 0x3b, 0x66, 0x6c, 
-    0x6f, 0x61, 0x74, 0x20, 0x62, 0x6f, 0x3d, 0x75, 0x52, 0x6f, 0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 
-    0x73, 0x2a, 0x62, 0x67, 0x2e, 0x79, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x61, 0x3d, 
-    0x75, 0x4d, 0x65, 0x74, 0x61, 0x6c, 0x6e, 0x65, 0x73, 0x73, 0x2a, 0x62, 0x67, 0x2e, 0x7a, 0x3b, 
-    0x76, 0x65, 0x63, 0x33, 0x20, 0x46, 0x30, 0x3d, 0x43, 0x6f, 0x6d, 0x70, 0x75, 0x74, 0x65, 0x46, 
-    0x30, 0x28, 0x62, 0x61, 0x2c, 0x30, 0x2e, 0x35, 0x2c, 0x75, 0x2e, 0x72, 0x67, 0x62, 0x29, 0x3b, 
-    0x76, 0x65, 0x63, 0x33, 0x20, 0x4e, 0x3d, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 
-    0x28, 0x76, 0x54, 0x42, 0x4e, 0x2a, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x53, 0x63, 0x61, 0x6c, 
-    0x65, 0x28, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 0x54, 0x65, 0x78, 0x4e, 0x6f, 
-    0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x76, 0x54, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x29, 0x2e, 
-    0x72, 0x67, 0x62, 0x2a, 0x32, 0x2e, 0x30, 0x2d, 0x31, 0x2e, 0x30, 0x2c, 0x75, 0x4e, 0x6f, 0x72, 
-    0x6d, 0x61, 0x6c, 0x53, 0x63, 0x61, 0x6c, 0x65, 0x29, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 
-    0x56, 0x3d, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x75, 0x56, 0x69, 0x65, 
-    0x77, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2d, 0x76, 0x50, 0x6f, 0x73, 0x69, 0x74, 
-    0x69, 0x6f, 0x6e, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x70, 0x3d, 0x64, 0x6f, 0x74, 
-    0x28, 0x4e, 0x2c, 0x56, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x4e, 0x64, 0x6f, 
-    0x74, 0x56, 0x3d, 0x6d, 0x61, 0x78, 0x28, 0x70, 0x2c, 0x31, 0x65, 0x2d, 0x34, 0x29, 0x3b, 0x76, 
-    0x65, 0x63, 0x33, 0x20, 0x61, 0x6a, 0x3d, 0x76, 0x65, 0x63, 0x33, 0x28, 0x30, 0x2e, 0x30, 0x29, 
-    0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x3d, 0x76, 
-    0x65, 0x63, 0x33, 0x28, 0x30, 0x2e, 0x30, 0x29, 0x3b, 0x66, 0x6f, 0x72, 0x28, 0x69, 0x6e, 0x74, 
-    0x20, 0x61, 0x70, 0x3d, 0x30, 0x3b, 0x61, 0x70, 0x20, 0x3c, 0x20, 0x4e, 0x55, 0x4d, 0x5f, 0x4c, 
-    0x49, 0x47, 0x48, 0x54, 0x53, 0x3b, 0x61, 0x70, 0x2b, 0x2b, 0x29, 0x7b, 0x69, 0x66, 0x28, 0x21, 
-    0x75, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x5b, 0x61, 0x70, 0x5d, 0x2e, 0x65, 0x6e, 0x61, 0x62, 
-    0x6c, 0x65, 0x64, 0x29, 0x7b, 0x63, 0x6f, 0x6e, 0x74, 0x69, 0x6e, 0x75, 0x65, 0x3b, 0x7d, 0x4c, 
-    0x69, 0x67, 0x68, 0x74, 0x20, 0x61, 0x75, 0x3d, 0x75, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x5b, 
-    0x61, 0x70, 0x5d, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x4c, 0x3d, 0x76, 0x65, 0x63, 0x33, 0x28, 
-    0x30, 0x2e, 0x30, 0x29, 0x3b, 0x69, 0x66, 0x28, 0x61, 0x75, 0x2e, 0x74, 0x79, 0x70, 0x65, 0x3d, 
-    0x3d, 0x44, 0x49, 0x52, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x29, 0x4c, 0x3d, 0x2d, 0x61, 0x75, 0x2e, 
-    0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x65, 0x6c, 0x73, 0x65, 0x20, 0x4c, 
-    0x3d, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x61, 0x75, 0x2e, 0x70, 0x6f, 
-    0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2d, 0x76, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 
-    0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x6f, 0x3d, 0x6d, 0x61, 0x78, 0x28, 0x64, 0x6f, 
-    0x74, 0x28, 0x4e, 0x2c, 0x4c, 0x29, 0x2c, 0x30, 0x2e, 0x30, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 
-    0x74, 0x20, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 0x3d, 0x6d, 0x69, 0x6e, 0x28, 0x6f, 0x2c, 0x31, 
-    0x2e, 0x30, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x48, 0x3d, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 
-    0x6c, 0x69, 0x7a, 0x65, 0x28, 0x56, 0x2b, 0x4c, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
-    0x6d, 0x3d, 0x6d, 0x61, 0x78, 0x28, 0x64, 0x6f, 0x74, 0x28, 0x4c, 0x2c, 0x48, 0x29, 0x2c, 0x30, 
-    0x2e, 0x30, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x4c, 0x64, 0x6f, 0x74, 0x48, 
-    0x3d, 0x6d, 0x69, 0x6e, 0x28, 0x64, 0x6f, 0x74, 0x28, 0x4c, 0x2c, 0x48, 0x29, 0x2c, 0x31, 0x2e, 
-    0x30, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x6e, 0x3d, 0x6d, 0x61, 0x78, 0x28, 0x64, 
-    0x6f, 0x74, 0x28, 0x4e, 0x2c, 0x48, 0x29, 0x2c, 0x30, 0x2e, 0x30, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 
-    0x61, 0x74, 0x20, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x48, 0x3d, 0x6d, 0x69, 0x6e, 0x28, 0x6e, 0x2c, 
-    0x31, 0x2e, 0x30, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x61, 0x76, 0x3d, 0x61, 0x75, 0x2e, 
-    0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x2a, 0x61, 0x75, 0x2e, 0x65, 0x6e, 0x65, 0x72, 0x67, 0x79, 0x3b, 
-    0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x6b, 0x3d, 0x31, 0x2e, 0x30, 0x2d, 0x62, 0x61, 0x3b, 
-    0x76, 0x65, 0x63, 0x33, 0x20, 0x61, 0x69, 0x3d, 0x61, 0x76, 0x2a, 0x44, 0x69, 0x66, 0x66, 0x75, 
-    0x73, 0x65, 0x28, 0x63, 0x4c, 0x64, 0x6f, 0x74, 0x48, 0x2c, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x56, 
-    0x2c, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 0x2c, 0x62, 0x6f, 0x29, 0x2a, 0x61, 0x6b, 0x3b, 0x76, 
-    0x65, 0x63, 0x33, 0x20, 0x62, 0x77, 0x3d, 0x53, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x28, 
-    0x46, 0x30, 0x2c, 0x63, 0x4c, 0x64, 0x6f, 0x74, 0x48, 0x2c, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x48, 
-    0x2c, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x56, 0x2c, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 0x2c, 0x62, 
-    0x6f, 0x29, 0x3b, 0x62, 0x77, 0x2a, 0x3d, 0x61, 0x76, 0x2a, 0x61, 0x75, 0x2e, 0x73, 0x70, 0x65, 
-    0x63, 0x75, 0x6c, 0x61, 0x72, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x68, 0x61, 0x64, 
-    0x6f, 0x77, 0x3d, 0x31, 0x2e, 0x30, 0x3b, 0x69, 0x66, 0x28, 0x61, 0x75, 0x2e, 0x73, 0x68, 0x61, 
-    0x64, 0x6f, 0x77, 0x29, 0x7b, 0x69, 0x66, 0x28, 0x61, 0x75, 0x2e, 0x74, 0x79, 0x70, 0x65, 0x3d, 
-    0x3d, 0x4f, 0x4d, 0x4e, 0x49, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x29, 0x7b, 0x73, 0x68, 0x61, 0x64, 
-    0x6f, 0x77, 0x3d, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x4f, 0x6d, 0x6e, 0x69, 0x28, 0x61, 0x70, 
-    0x2c, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 0x29, 0x3b, 0x7d, 0x65, 0x6c, 0x73, 0x65, 0x7b, 0x73, 
-    0x68, 0x61, 0x64, 0x6f, 0x77, 0x3d, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x28, 0x61, 0x70, 0x2c, 
-    0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 0x29, 0x3b, 0x7d, 0x7d, 0x69, 0x66, 0x28, 0x61, 0x75, 0x2e, 
-    0x74, 0x79, 0x70, 0x65, 0x20, 0x21, 0x3d, 0x44, 0x49, 0x52, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x29, 
-    0x7b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x6c, 0x3d, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 
-    0x28, 0x61, 0x75, 0x2e, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2d, 0x76, 0x50, 0x6f, 
-    0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x7a, 0x3d, 
-    0x31, 0x2e, 0x30, 0x2d, 0x63, 0x6c, 0x61, 0x6d, 0x70, 0x28, 0x61, 0x6c, 0x2f, 0x61, 0x75, 0x2e, 
-    0x72, 0x61, 0x6e, 0x67, 0x65, 0x2c, 0x30, 0x2e, 0x30, 0x2c, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x73, 
-    0x68, 0x61, 0x64, 0x6f, 0x77, 0x2a, 0x3d, 0x7a, 0x2a, 0x61, 0x75, 0x2e, 0x61, 0x74, 0x74, 0x65, 
-    0x6e, 0x75, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x7d, 0x69, 0x66, 0x28, 0x61, 0x75, 0x2e, 0x74, 
-    0x79, 0x70, 0x65, 0x3d, 0x3d, 0x53, 0x50, 0x4f, 0x54, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x29, 0x7b, 
-    0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x61, 0x3d, 0x64, 0x6f, 0x74, 0x28, 0x4c, 0x2c, 0x2d, 
-    0x61, 0x75, 0x2e, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x3b, 0x66, 0x6c, 
-    0x6f, 0x61, 0x74, 0x20, 0x61, 0x6f, 0x3d, 0x28, 0x61, 0x75, 0x2e, 0x69, 0x6e, 0x6e, 0x65, 0x72, 
-    0x43, 0x75, 0x74, 0x4f, 0x66, 0x66, 0x2d, 0x61, 0x75, 0x2e, 0x6f, 0x75, 0x74, 0x65, 0x72, 0x43, 
-    0x75, 0x74, 0x4f, 0x66, 0x66, 0x29, 0x3b, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x2a, 0x3d, 0x73, 
-    0x6d, 0x6f, 0x6f, 0x74, 0x68, 0x73, 0x74, 0x65, 0x70, 0x28, 0x30, 0x2e, 0x30, 0x2c, 0x31, 0x2e, 
-    0x30, 0x2c, 0x28, 0x63, 0x61, 0x2d, 0x61, 0x75, 0x2e, 0x6f, 0x75, 0x74, 0x65, 0x72, 0x43, 0x75, 
-    0x74, 0x4f, 0x66, 0x66, 0x29, 0x2f, 0x61, 0x6f, 0x29, 0x3b, 0x7d, 0x61, 0x6a, 0x2b, 0x3d, 0x61, 
-    0x69, 0x2a, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x3b, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 
-    0x72, 0x2b, 0x3d, 0x62, 0x77, 0x2a, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x3b, 0x7d, 0x76, 0x65, 
-    0x63, 0x33, 0x20, 0x78, 0x3d, 0x75, 0x41, 0x6d, 0x62, 0x69, 0x65, 0x6e, 0x74, 0x43, 0x6f, 0x6c, 
-    0x6f, 0x72, 0x3b, 0x69, 0x66, 0x28, 0x75, 0x48, 0x61, 0x73, 0x53, 0x6b, 0x79, 0x62, 0x6f, 0x78, 
-    0x29, 0x7b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6b, 0x53, 0x3d, 0x49, 0x42, 0x4c, 0x5f, 0x46, 0x72, 
-    0x65, 0x73, 0x6e, 0x65, 0x6c, 0x53, 0x63, 0x68, 0x6c, 0x69, 0x63, 0x6b, 0x52, 0x6f, 0x75, 0x67, 
-    0x68, 0x6e, 0x65, 0x73, 0x73, 0x28, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x56, 0x2c, 0x46, 0x30, 0x2c, 
-    0x62, 0x6f, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6b, 0x44, 0x3d, 0x28, 0x31, 0x2e, 0x30, 
-    0x2d, 0x6b, 0x53, 0x29, 0x2a, 0x28, 0x31, 0x2e, 0x30, 0x2d, 0x62, 0x61, 0x29, 0x3b, 0x76, 0x65, 
-    0x63, 0x33, 0x20, 0x72, 0x3d, 0x52, 0x6f, 0x74, 0x61, 0x74, 0x65, 0x57, 0x69, 0x74, 0x68, 0x51, 
-    0x75, 0x61, 0x74, 0x28, 0x4e, 0x2c, 0x75, 0x51, 0x75, 0x61, 0x74, 0x53, 0x6b, 0x79, 0x62, 0x6f, 
-    0x78, 0x29, 0x3b, 0x78, 0x3d, 0x6b, 0x44, 0x2a, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 
-    0x75, 0x43, 0x75, 0x62, 0x65, 0x49, 0x72, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x2c, 
-    0x72, 0x29, 0x2e, 0x72, 0x67, 0x62, 0x2a, 0x75, 0x53, 0x6b, 0x79, 0x62, 0x6f, 0x78, 0x41, 0x6d, 
-    0x62, 0x69, 0x65, 0x6e, 0x74, 0x49, 0x6e, 0x74, 0x65, 0x6e, 0x73, 0x69, 0x74, 0x79, 0x3b, 0x7d, 
-    0x65, 0x6c, 0x73, 0x65, 0x7b, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
-    0x20, 0x71, 0x3d, 0x31, 0x2e, 0x30, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6b, 0x53, 0x3d, 0x46, 
-    0x30, 0x2b, 0x28, 0x31, 0x2e, 0x30, 0x2d, 0x46, 0x30, 0x29, 0x2a, 0x53, 0x63, 0x68, 0x6c, 0x69, 
-    0x63, 0x6b, 0x46, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x28, 0x71, 0x29, 0x3b, 0x76, 0x65, 0x63, 
-    0x33, 0x20, 0x6b, 0x44, 0x3d, 0x28, 0x31, 0x2e, 0x30, 0x2d, 0x6b, 0x53, 0x29, 0x2a, 0x28, 0x31, 
-    0x2e, 0x30, 0x2d, 0x62, 0x61, 0x29, 0x3b, 0x78, 0x2a, 0x3d, 0x28, 0x6b, 0x44, 0x2a, 0x75, 0x2e, 
-    0x72, 0x67, 0x62, 0x2b, 0x6b, 0x53, 0x29, 0x3b, 0x7d, 0x78, 0x2a, 0x3d, 0x62, 0x66, 0x3b, 0x69, 
-    0x66, 0x28, 0x75, 0x48, 0x61, 0x73, 0x53, 0x6b, 0x79, 0x62, 0x6f, 0x78, 0x29, 0x7b, 0x76, 0x65, 
-    0x63, 0x33, 0x20, 0x52, 0x3d, 0x52, 0x6f, 0x74, 0x61, 0x74, 0x65, 0x57, 0x69, 0x74, 0x68, 0x51, 
-    0x75, 0x61, 0x74, 0x28, 0x72, 0x65, 0x66, 0x6c, 0x65, 0x63, 0x74, 0x28, 0x2d, 0x56, 0x2c, 0x4e, 
-    0x29, 0x2c, 0x75, 0x51, 0x75, 0x61, 0x74, 0x53, 0x6b, 0x79, 0x62, 0x6f, 0x78, 0x29, 0x3b, 0x63, 
-    0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x4d, 0x41, 0x58, 0x5f, 0x52, 
-    0x45, 0x46, 0x4c, 0x45, 0x43, 0x54, 0x49, 0x4f, 0x4e, 0x5f, 0x4c, 0x4f, 0x44, 0x3d, 0x37, 0x2e, 
-    0x30, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x62, 0x3d, 0x49, 0x42, 0x4c, 0x5f, 0x47, 
-    0x65, 0x74, 0x53, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x4d, 0x69, 0x70, 0x4c, 0x65, 0x76, 
-    0x65, 0x6c, 0x28, 0x62, 0x6f, 0x2c, 0x4d, 0x41, 0x58, 0x5f, 0x52, 0x45, 0x46, 0x4c, 0x45, 0x43, 
-    0x54, 0x49, 0x4f, 0x4e, 0x5f, 0x4c, 0x4f, 0x44, 0x2b, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x76, 0x65, 
-    0x63, 0x33, 0x20, 0x62, 0x69, 0x3d, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x4c, 0x6f, 0x64, 
-    0x28, 0x75, 0x43, 0x75, 0x62, 0x65, 0x50, 0x72, 0x65, 0x66, 0x69, 0x6c, 0x74, 0x65, 0x72, 0x2c, 
-    0x52, 0x2c, 0x62, 0x62, 0x29, 0x2e, 0x72, 0x67, 0x62, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
-    0x62, 0x78, 0x3d, 0x49, 0x42, 0x4c, 0x5f, 0x47, 0x65, 0x74, 0x53, 0x70, 0x65, 0x63, 0x75, 0x6c, 
-    0x61, 0x72, 0x4f, 0x63, 0x63, 0x6c, 0x75, 0x73, 0x69, 0x6f, 0x6e, 0x28, 0x63, 0x4e, 0x64, 0x6f, 
-    0x74, 0x56, 0x2c, 0x62, 0x66, 0x2c, 0x62, 0x6f, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x62, 
-    0x76, 0x3d, 0x49, 0x42, 0x4c, 0x5f, 0x47, 0x65, 0x74, 0x4d, 0x75, 0x6c, 0x74, 0x69, 0x53, 0x63, 
-    0x61, 0x74, 0x74, 0x65, 0x72, 0x42, 0x52, 0x44, 0x46, 0x28, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x56, 
-    0x2c, 0x62, 0x6f, 0x2c, 0x46, 0x30, 0x2c, 0x62, 0x61, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 
-    0x62, 0x75, 0x3d, 0x62, 0x69, 0x2a, 0x62, 0x76, 0x2a, 0x62, 0x78, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 
-    0x74, 0x20, 0x61, 0x6d, 0x3d, 0x6d, 0x69, 0x78, 0x28, 0x31, 0x2e, 0x30, 0x2c, 0x70, 0x6f, 0x77, 
-    0x28, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x56, 0x2c, 0x30, 0x2e, 0x35, 0x29, 0x2c, 0x62, 0x6f, 0x29, 
-    0x3b, 0x62, 0x75, 0x2a, 0x3d, 0x61, 0x6d, 0x3b, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 
-    0x2b, 0x3d, 0x62, 0x75, 0x2a, 0x75, 0x53, 0x6b, 0x79, 0x62, 0x6f, 0x78, 0x52, 0x65, 0x66, 0x6c, 
-    0x65, 0x63, 0x74, 0x49, 0x6e, 0x74, 0x65, 0x6e, 0x73, 0x69, 0x74, 0x79, 0x3b, 0x7d, 0x61, 0x6a, 
-    0x3d, 0x75, 0x2e, 0x72, 0x67, 0x62, 0x2a, 0x28, 0x78, 0x2b, 0x61, 0x6a, 0x29, 0x3b, 0x69, 0x3d, 
-    0x76, 0x65, 0x63, 0x34, 0x28, 0x61, 0x6a, 0x2b, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 
-    0x2b, 0x61, 0x6e, 0x2c, 0x75, 0x2e, 0x61, 0x29, 0x3b, 0x68, 0x3d, 0x76, 0x65, 0x63, 0x34, 0x28, 
-    0x75, 0x2e, 0x72, 0x67, 0x62, 0x2c, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x6a, 0x3d, 0x76, 0x65, 0x63, 
-    0x34, 0x28, 0x45, 0x6e, 0x63, 0x6f, 0x64, 0x65, 0x4f, 0x63, 0x74, 0x61, 0x68, 0x65, 0x64, 0x72, 
-    0x61, 0x6c, 0x28, 0x4e, 0x29, 0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 0x31, 0x2e, 0x30, 0x29, 0x29, 
-    0x3b, 0x6b, 0x3d, 0x76, 0x65, 0x63, 0x34, 0x28, 0x62, 0x66, 0x2c, 0x62, 0x6f, 0x2c, 0x62, 0x61, 
-    0x2c, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x7d, 0x00
+    0x29, 0x3b, 0x7d, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x28, 
+    0x69, 0x6e, 0x74, 0x20, 0x61, 0x70, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x4e, 0x64, 
+    0x6f, 0x74, 0x4c, 0x29, 0x7b, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x20, 0x61, 0x75, 0x3d, 0x75, 0x4c, 
+    0x69, 0x67, 0x68, 0x74, 0x73, 0x5b, 0x61, 0x70, 0x5d, 0x3b, 0x76, 0x65, 0x63, 0x34, 0x20, 0x62, 
+    0x68, 0x3d, 0x76, 0x50, 0x6f, 0x73, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x53, 0x70, 0x61, 0x63, 0x65, 
+    0x5b, 0x61, 0x70, 0x5d, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x62, 0x6a, 0x3d, 0x62, 0x68, 0x2e, 
+    0x78, 0x79, 0x7a, 0x2f, 0x62, 0x68, 0x2e, 0x77, 0x3b, 0x69, 0x6e, 0x74, 0x20, 0x6c, 0x61, 0x79, 
+    0x65, 0x72, 0x3d, 0x30, 0x3b, 0x66, 0x6f, 0x72, 0x28, 0x69, 0x6e, 0x74, 0x20, 0x63, 0x3d, 0x30, 
+    0x3b, 0x63, 0x20, 0x3c, 0x20, 0x61, 0x75, 0x2e, 0x63, 0x61, 0x73, 0x63, 0x61, 0x64, 0x65, 0x43, 
+    0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x63, 0x2b, 0x2b, 0x29, 0x7b, 0x76, 0x65, 0x63, 0x32, 0x20, 0x75, 
+    0x76, 0x3d, 0x62, 0x6a, 0x2e, 0x78, 0x79, 0x2a, 0x61, 0x75, 0x2e, 0x63, 0x61, 0x73, 0x63, 0x61, 
+    0x64, 0x65, 0x73, 0x5b, 0x63, 0x5d, 0x2e, 0x78, 0x79, 0x2b, 0x61, 0x75, 0x2e, 0x63, 0x61, 0x73, 
+    0x63, 0x61, 0x64, 0x65, 0x73, 0x5b, 0x63, 0x5d, 0x2e, 0x7a, 0x77, 0x3b, 0x69, 0x66, 0x28, 0x61, 
+    0x6c, 0x6c, 0x28, 0x6c, 0x65, 0x73, 0x73, 0x54, 0x68, 0x61, 0x6e, 0x28, 0x61, 0x62, 0x73, 0x28, 
+    0x75, 0x76, 0x29, 0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 0x31, 0x2e, 0x30, 0x29, 0x29, 0x29, 0x29, 
+    0x7b, 0x62, 0x6a, 0x2e, 0x78, 0x79, 0x3d, 0x75, 0x76, 0x3b, 0x6c, 0x61, 0x79, 0x65, 0x72, 0x3d, 
+    0x63, 0x3b, 0x62, 0x72, 0x65, 0x61, 0x6b, 0x3b, 0x7d, 0x7d, 0x62, 0x6a, 0x3d, 0x62, 0x6a, 0x2a, 
+    0x30, 0x2e, 0x35, 0x2b, 0x30, 0x2e, 0x35, 0x3b, 0x62, 0x6f, 0x6f, 0x6c, 0x20, 0x61, 0x72, 0x3d, 
+    0x61, 0x6c, 0x6c, 0x28, 0x6c, 0x65, 0x73, 0x73, 0x54, 0x68, 0x61, 0x6e, 0x45, 0x71, 0x75, 0x61, 
+    0x6c, 0x28, 0x62, 0x6a, 0x2c, 0x76, 0x65, 0x63, 0x33, 0x28, 0x31, 0x2e, 0x30, 0x29, 0x29, 0x29, 
+    0x3b, 0x62, 0x6f, 0x6f, 0x6c, 0x20, 0x61, 0x71, 0x3d, 0x61, 0x6c, 0x6c, 0x28, 0x67, 0x72, 0x65, 
+    0x61, 0x74, 0x65, 0x72, 0x54, 0x68, 0x61, 0x6e, 0x45, 0x71, 0x75, 0x61, 0x6c, 0x28, 0x62, 0x6a, 
+    0x2c, 0x76, 0x65, 0x63, 0x33, 0x28, 0x30, 0x2e, 0x30, 0x29, 0x29, 0x29, 0x3b, 0x69, 0x66, 0x28, 
+    0x21, 0x28, 0x61, 0x72, 0x20, 0x26, 0x26, 0x20, 0x61, 0x71, 0x29, 0x29, 0x7b, 0x72, 0x65, 0x74, 
+    0x75, 0x72, 0x6e, 0x20, 0x31, 0x2e, 0x30, 0x3b, 0x7d, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 
+    0x61, 0x3d, 0x61, 0x75, 0x2e, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x53, 0x6c, 0x6f, 0x70, 0x65, 
+    0x42, 0x69, 0x61, 0x73, 0x2a, 0x28, 0x31, 0x2e, 0x30, 0x2d, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 
+    0x29, 0x3b, 0x61, 0x61, 0x3d, 0x6d, 0x61, 0x78, 0x28, 0x61, 0x61, 0x2c, 0x61, 0x75, 0x2e, 0x73, 
+    0x68, 0x61, 0x64, 0x6f, 0x77, 0x44, 0x65, 0x70, 0x74, 0x68, 0x42, 0x69, 0x61, 0x73, 0x2a, 0x62, 
+    0x6a, 0x2e, 0x7a, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x67, 0x3d, 0x62, 0x6a, 
+    0x2e, 0x7a, 0x2d, 0x61, 0x61, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x74, 0x3d, 0x61, 0x75, 
+    0x2e, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x53, 0x6f, 0x66, 0x74, 0x6e, 0x65, 0x73, 0x73, 0x2a, 
+    0x73, 0x71, 0x72, 0x74, 0x28, 0x62, 0x6a, 0x2e, 0x7a, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x34, 0x20, 
+    0x74, 0x69, 0x6c, 0x65, 0x3d, 0x61, 0x75, 0x2e, 0x74, 0x69, 0x6c, 0x65, 0x73, 0x5b, 0x6c, 0x61, 
+    0x79, 0x65, 0x72, 0x5d, 0x3b, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 0x6d, 0x69, 0x6e, 0x3d, 0x74, 
+    0x69, 0x6c, 0x65, 0x2e, 0x78, 0x79, 0x2b, 0x30, 0x2e, 0x35, 0x2a, 0x61, 0x75, 0x2e, 0x73, 0x68, 
+    0x61, 0x64, 0x6f, 0x77, 0x4d, 0x61, 0x70, 0x54, 0x78, 0x6c, 0x53, 0x7a, 0x3b, 0x76, 0x65, 0x63, 
+    0x32, 0x20, 0x74, 0x6d, 0x61, 0x78, 0x3d, 0x74, 0x69, 0x6c, 0x65, 0x2e, 0x78, 0x79, 0x2b, 0x74, 
+    0x69, 0x6c, 0x65, 0x2e, 0x7a, 0x2d, 0x30, 0x2e, 0x35, 0x2a, 0x61, 0x75, 0x2e, 0x73, 0x68, 0x61, 
+    0x64, 0x6f, 0x77, 0x4d, 0x61, 0x70, 0x54, 0x78, 0x6c, 0x53, 0x7a, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 
+    0x74, 0x20, 0x62, 0x6e, 0x3d, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 0x54, 0x65, 
+    0x78, 0x4e, 0x6f, 0x69, 0x73, 0x65, 0x2c, 0x67, 0x6c, 0x5f, 0x46, 0x72, 0x61, 0x67, 0x43, 0x6f, 
+    0x6f, 0x72, 0x64, 0x2e, 0x78, 0x79, 0x2a, 0x28, 0x31, 0x2e, 0x30, 0x2f, 0x66, 0x6c, 0x6f, 0x61, 
+    0x74, 0x28, 0x54, 0x45, 0x58, 0x5f, 0x4e, 0x4f, 0x49, 0x53, 0x45, 0x5f, 0x53, 0x49, 0x5a, 0x45, 
+    0x29, 0x29, 0x29, 0x2e, 0x72, 0x2a, 0x54, 0x41, 0x55, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
+    0x62, 0x6c, 0x3d, 0x63, 0x6f, 0x73, 0x28, 0x62, 0x6e, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
+    0x20, 0x62, 0x70, 0x3d, 0x73, 0x69, 0x6e, 0x28, 0x62, 0x6e, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 
+    0x74, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x3d, 0x73, 0x74, 0x65, 0x70, 0x28, 0x61, 0x67, 
+    0x2c, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 
+    0x4d, 0x61, 0x70, 0x32, 0x44, 0x5b, 0x61, 0x70, 0x5d, 0x2c, 0x76, 0x65, 0x63, 0x33, 0x28, 0x63, 
+    0x6c, 0x61, 0x6d, 0x70, 0x28, 0x74, 0x69, 0x6c, 0x65, 0x2e, 0x78, 0x79, 0x2b, 0x62, 0x6a, 0x2e, 
+    0x78, 0x79, 0x2a, 0x74, 0x69, 0x6c, 0x65, 0x2e, 0x7a, 0x2c, 0x74, 0x6d, 0x69, 0x6e, 0x2c, 0x74, 
+    0x6d, 0x61, 0x78, 0x29, 0x2c, 0x74, 0x69, 0x6c, 0x65, 0x2e, 0x77, 0x29, 0x29, 0x2e, 0x72, 0x29, 
+    0x3b, 0x66, 0x6f, 0x72, 0x28, 0x69, 0x6e, 0x74, 0x20, 0x61, 0x73, 0x3d, 0x30, 0x3b, 0x61, 0x73, 
+    0x20, 0x3c, 0x20, 0x53, 0x48, 0x41, 0x44, 0x4f, 0x57, 0x5f, 0x53, 0x41, 0x4d, 0x50, 0x4c, 0x45, 
+    0x53, 0x3b, 0x2b, 0x2b, 0x61, 0x73, 0x29, 0x7b, 0x76, 0x65, 0x63, 0x32, 0x20, 0x6f, 0x66, 0x66, 
+    0x73, 0x65, 0x74, 0x3d, 0x52, 0x6f, 0x74, 0x61, 0x74, 0x65, 0x32, 0x44, 0x28, 0x50, 0x4f, 0x49, 
+    0x53, 0x53, 0x4f, 0x4e, 0x5f, 0x44, 0x49, 0x53, 0x4b, 0x5b, 0x61, 0x73, 0x5d, 0x2c, 0x62, 0x6c, 
+    0x2c, 0x62, 0x70, 0x29, 0x2a, 0x74, 0x3b, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x2b, 0x3d, 0x73, 
+    0x74, 0x65, 0x70, 0x28, 0x61, 0x67, 0x2c, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 
+    0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x4d, 0x61, 0x70, 0x32, 0x44, 0x5b, 0x61, 0x70, 0x5d, 0x2c, 
+    0x76, 0x65, 0x63, 0x33, 0x28, 0x63, 0x6c, 0x61, 0x6d, 0x70, 0x28, 0x74, 0x69, 0x6c, 0x65, 0x2e, 
+    0x78, 0x79, 0x2b, 0x28, 0x62, 0x6a, 0x2e, 0x78, 0x79, 0x2b, 0x6f, 0x66, 0x66, 0x73, 0x65, 0x74, 
+    0x29, 0x2a, 0x74, 0x69, 0x6c, 0x65, 0x2e, 0x7a, 0x2c, 0x74, 0x6d, 0x69, 0x6e, 0x2c, 0x74, 0x6d, 
+    0x61, 0x78, 0x29, 0x2c, 0x74, 0x69, 0x6c, 0x65, 0x2e, 0x77, 0x29, 0x29, 0x2e, 0x72, 0x29, 0x3b, 
+    0x7d, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x2f, 0x66, 
+    0x6c, 0x6f, 0x61, 0x74, 0x28, 0x53, 0x48, 0x41, 0x44, 0x4f, 0x57, 0x5f, 0x53, 0x41, 0x4d, 0x50, 
+    0x4c, 0x45, 0x53, 0x2b, 0x31, 0x29, 0x3b, 0x7d, 0x43, 0x6c, 0x75, 0x73, 0x74, 0x65, 0x72, 0x4c, 
+    0x69, 0x67, 0x68, 0x74, 0x20, 0x46, 0x65, 0x74, 0x63, 0x68, 0x43, 0x6c, 0x75, 0x73, 0x74, 0x65, 
+    0x72, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x28, 0x69, 0x6e, 0x74, 0x20, 0x61, 0x29, 0x7b, 0x69, 0x6e, 
+    0x74, 0x20, 0x62, 0x3d, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x53, 0x69, 0x7a, 0x65, 0x28, 
+    0x75, 0x54, 0x65, 0x78, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2c, 0x30, 0x29, 0x2e, 0x78, 0x3b, 
+    0x69, 0x6e, 0x74, 0x20, 0x63, 0x3d, 0x34, 0x2a, 0x61, 0x3b, 0x69, 0x76, 0x65, 0x63, 0x32, 0x20, 
+    0x70, 0x3d, 0x69, 0x76, 0x65, 0x63, 0x32, 0x28, 0x63, 0x25, 0x62, 0x2c, 0x63, 0x2f, 0x62, 0x29, 
+    0x3b, 0x76, 0x65, 0x63, 0x34, 0x20, 0x74, 0x30, 0x3d, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x46, 0x65, 
+    0x74, 0x63, 0x68, 0x28, 0x75, 0x54, 0x65, 0x78, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2c, 0x70, 
+    0x2c, 0x30, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x34, 0x20, 0x74, 0x31, 0x3d, 0x74, 0x65, 0x78, 0x65, 
+    0x6c, 0x46, 0x65, 0x74, 0x63, 0x68, 0x28, 0x75, 0x54, 0x65, 0x78, 0x4c, 0x69, 0x67, 0x68, 0x74, 
+    0x73, 0x2c, 0x70, 0x2b, 0x69, 0x76, 0x65, 0x63, 0x32, 0x28, 0x31, 0x2c, 0x30, 0x29, 0x2c, 0x30, 
+    0x29, 0x3b, 0x76, 0x65, 0x63, 0x34, 0x20, 0x74, 0x32, 0x3d, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x46, 
+    0x65, 0x74, 0x63, 0x68, 0x28, 0x75, 0x54, 0x65, 0x78, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2c, 
+    0x70, 0x2b, 0x69, 0x76, 0x65, 0x63, 0x32, 0x28, 0x32, 0x2c, 0x30, 0x29, 0x2c, 0x30, 0x29, 0x3b, 
+    0x76, 0x65, 0x63, 0x34, 0x20, 0x74, 0x33, 0x3d, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x46, 0x65, 0x74, 
+    0x63, 0x68, 0x28, 0x75, 0x54, 0x65, 0x78, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2c, 0x70, 0x2b, 
+    0x69, 0x76, 0x65, 0x63, 0x32, 0x28, 0x33, 0x2c, 0x30, 0x29, 0x2c, 0x30, 0x29, 0x3b, 0x72, 0x65, 
+    0x74, 0x75, 0x72, 0x6e, 0x20, 0x43, 0x6c, 0x75, 0x73, 0x74, 0x65, 0x72, 0x4c, 0x69, 0x67, 0x68, 
+    0x74, 0x28, 0x74, 0x30, 0x2e, 0x78, 0x79, 0x7a, 0x2c, 0x74, 0x30, 0x2e, 0x77, 0x2c, 0x74, 0x31, 
+    0x2e, 0x78, 0x79, 0x7a, 0x2c, 0x69, 0x6e, 0x74, 0x28, 0x74, 0x31, 0x2e, 0x77, 0x29, 0x2c, 0x74, 
+    0x32, 0x2e, 0x72, 0x67, 0x62, 0x2c, 0x74, 0x32, 0x2e, 0x61, 0x2c, 0x74, 0x33, 0x2e, 0x78, 0x2c, 
+    0x74, 0x33, 0x2e, 0x79, 0x2c, 0x74, 0x33, 0x2e, 0x7a, 0x29, 0x3b, 0x7d, 0x69, 0x6e, 0x74, 0x20, 
+    0x46, 0x65, 0x74, 0x63, 0x68, 0x43, 0x6c, 0x75, 0x73, 0x74, 0x65, 0x72, 0x4c, 0x69, 0x67, 0x68, 
+    0x74, 0x49, 0x6e, 0x64, 0x65, 0x78, 0x28, 0x69, 0x6e, 0x74, 0x20, 0x61, 0x29, 0x7b, 0x69, 0x6e, 
+    0x74, 0x20, 0x62, 0x3d, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x53, 0x69, 0x7a, 0x65, 0x28, 
+    0x75, 0x54, 0x65, 0x78, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x49, 0x6e, 0x64, 0x69, 0x63, 0x65, 0x73, 
+    0x2c, 0x30, 0x29, 0x2e, 0x78, 0x3b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x69, 0x6e, 0x74, 
+    0x28, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x46, 0x65, 0x74, 0x63, 0x68, 0x28, 0x75, 0x54, 0x65, 0x78, 
+    0x4c, 0x69, 0x67, 0x68, 0x74, 0x49, 0x6e, 0x64, 0x69, 0x63, 0x65, 0x73, 0x2c, 0x69, 0x76, 0x65, 
+    0x63, 0x32, 0x28, 0x61, 0x25, 0x62, 0x2c, 0x61, 0x2f, 0x62, 0x29, 0x2c, 0x30, 0x29, 0x2e, 0x72, 
+    0x29, 0x3b, 0x7d, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x53, 0x68, 0x61, 0x64, 0x65, 0x43, 0x6c, 0x75, 
+    0x73, 0x74, 0x65, 0x72, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x28, 0x43, 0x6c, 0x75, 0x73, 0x74, 0x65, 
+    0x72, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x20, 0x63, 0x6c, 0x2c, 0x76, 0x65, 0x63, 0x33, 0x20, 0x70, 
+    0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x76, 0x65, 0x63, 0x33, 0x20, 0x4e, 0x2c, 0x76, 
+    0x65, 0x63, 0x33, 0x20, 0x56, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x4e, 0x64, 0x6f, 
+    0x74, 0x56, 0x2c, 0x76, 0x65, 0x63, 0x33, 0x20, 0x46, 0x30, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
+    0x20, 0x61, 0x76, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x6c, 0x2c, 0x69, 0x6e, 0x6f, 
+    0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x78, 0x2c, 0x69, 0x6e, 0x6f, 0x75, 0x74, 0x20, 
+    0x76, 0x65, 0x63, 0x33, 0x20, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x29, 0x7b, 0x76, 
+    0x65, 0x63, 0x33, 0x20, 0x4c, 0x3d, 0x28, 0x63, 0x6c, 0x2e, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x3d, 
+    0x44, 0x49, 0x52, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x29, 0x3f, 0x2d, 0x63, 0x6c, 0x2e, 0x64, 0x69, 
+    0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3a, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 
+    0x69, 0x7a, 0x65, 0x28, 0x63, 0x6c, 0x2e, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2d, 
+    0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
+    0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 0x3d, 0x63, 0x6c, 0x61, 0x6d, 0x70, 0x28, 0x64, 0x6f, 0x74, 
+    0x28, 0x4e, 0x2c, 0x4c, 0x29, 0x2c, 0x30, 0x2e, 0x30, 0x2c, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x76, 
+    0x65, 0x63, 0x33, 0x20, 0x48, 0x3d, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 
+    0x56, 0x2b, 0x4c, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x4c, 0x64, 0x6f, 0x74, 
+    0x48, 0x3d, 0x6d, 0x69, 0x6e, 0x28, 0x64, 0x6f, 0x74, 0x28, 0x4c, 0x2c, 0x48, 0x29, 0x2c, 0x31, 
+    0x2e, 0x30, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x67, 0x3d, 0x6d, 0x61, 0x78, 0x28, 
+    0x64, 0x6f, 0x74, 0x28, 0x4e, 0x2c, 0x48, 0x29, 0x2c, 0x30, 0x2e, 0x30, 0x29, 0x3b, 0x66, 0x6c, 
+    0x6f, 0x61, 0x74, 0x20, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x48, 0x3d, 0x6d, 0x69, 0x6e, 0x28, 0x67, 
+    0x2c, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x6f, 0x3d, 0x31, 0x2e, 
+    0x30, 0x3b, 0x69, 0x66, 0x28, 0x63, 0x6c, 0x2e, 0x74, 0x79, 0x70, 0x65, 0x20, 0x21, 0x3d, 0x44, 
+    0x49, 0x52, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x29, 0x7b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x7a, 
+    0x3d, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x28, 0x63, 0x6c, 0x2e, 0x70, 0x6f, 0x73, 0x69, 0x74, 
+    0x69, 0x6f, 0x6e, 0x2d, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x3b, 0x6f, 0x3d, 
+    0x28, 0x31, 0x2e, 0x30, 0x2d, 0x63, 0x6c, 0x61, 0x6d, 0x70, 0x28, 0x7a, 0x2f, 0x63, 0x6c, 0x2e, 
+    0x72, 0x61, 0x6e, 0x67, 0x65, 0x2c, 0x30, 0x2e, 0x30, 0x2c, 0x31, 0x2e, 0x30, 0x29, 0x29, 0x2a, 
+    0x63, 0x6c, 0x2e, 0x61, 0x74, 0x74, 0x65, 0x6e, 0x75, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x7d, 
+    0x69, 0x66, 0x28, 0x63, 0x6c, 0x2e, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x3d, 0x53, 0x50, 0x4f, 0x54, 
+    0x4c, 0x49, 0x47, 0x48, 0x54, 0x29, 0x7b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x63, 0x3d, 
+    0x64, 0x6f, 0x74, 0x28, 0x4c, 0x2c, 0x2d, 0x63, 0x6c, 0x2e, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 
+    0x69, 0x6f, 0x6e, 0x29, 0x3b, 0x6f, 0x2a, 0x3d, 0x73, 0x6d, 0x6f, 0x6f, 0x74, 0x68, 0x73, 0x74, 
+    0x65, 0x70, 0x28, 0x30, 0x2e, 0x30, 0x2c, 0x31, 0x2e, 0x30, 0x2c, 0x28, 0x62, 0x63, 0x2d, 0x63, 
+    0x6c, 0x2e, 0x6f, 0x75, 0x74, 0x65, 0x72, 0x43, 0x75, 0x74, 0x4f, 0x66, 0x66, 0x29, 0x2f, 0x28, 
+    0x63, 0x6c, 0x2e, 0x69, 0x6e, 0x6e, 0x65, 0x72, 0x43, 0x75, 0x74, 0x4f, 0x66, 0x66, 0x2d, 0x63, 
+    0x6c, 0x2e, 0x6f, 0x75, 0x74, 0x65, 0x72, 0x43, 0x75, 0x74, 0x4f, 0x66, 0x66, 0x29, 0x29, 0x3b, 
+    0x7d, 0x78, 0x2b, 0x3d, 0x63, 0x6c, 0x2e, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x2a, 0x44, 0x69, 0x66, 
+    0x66, 0x75, 0x73, 0x65, 0x28, 0x63, 0x4c, 0x64, 0x6f, 0x74, 0x48, 0x2c, 0x63, 0x4e, 0x64, 0x6f, 
+    0x74, 0x56, 0x2c, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 0x2c, 0x61, 0x76, 0x29, 0x2a, 0x28, 0x31, 
+    0x2e, 0x30, 0x2d, 0x61, 0x6c, 0x29, 0x2a, 0x6f, 0x3b, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 
+    0x72, 0x2b, 0x3d, 0x53, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x28, 0x46, 0x30, 0x2c, 0x63, 
+    0x4c, 0x64, 0x6f, 0x74, 0x48, 0x2c, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x48, 0x2c, 0x63, 0x4e, 0x64, 
+    0x6f, 0x74, 0x56, 0x2c, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 0x2c, 0x61, 0x76, 0x29, 0x2a, 0x63, 
+    0x6c, 0x2e, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x2a, 0x63, 0x6c, 0x2e, 0x73, 0x70, 0x65, 0x63, 0x75, 
+    0x6c, 0x61, 0x72, 0x2a, 0x6f, 0x3b, 0x7d, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x53, 0x68, 0x61, 0x64, 
+    0x65, 0x53, 0x74, 0x6f, 0x72, 0x65, 0x64, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x28, 0x76, 0x65, 
+    0x63, 0x33, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x76, 0x65, 0x63, 0x33, 
+    0x20, 0x4e, 0x2c, 0x76, 0x65, 0x63, 0x33, 0x20, 0x56, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
+    0x63, 0x4e, 0x64, 0x6f, 0x74, 0x56, 0x2c, 0x76, 0x65, 0x63, 0x33, 0x20, 0x46, 0x30, 0x2c, 0x66, 
+    0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x76, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x6c, 
+    0x2c, 0x69, 0x6e, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x78, 0x2c, 0x69, 0x6e, 
+    0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 
+    0x72, 0x29, 0x7b, 0x66, 0x6f, 0x72, 0x28, 0x69, 0x6e, 0x74, 0x20, 0x61, 0x3d, 0x30, 0x3b, 0x61, 
+    0x20, 0x3c, 0x20, 0x75, 0x44, 0x69, 0x72, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x43, 0x6f, 0x75, 0x6e, 
+    0x74, 0x3b, 0x61, 0x2b, 0x2b, 0x29, 0x7b, 0x53, 0x68, 0x61, 0x64, 0x65, 0x43, 0x6c, 0x75, 0x73, 
+    0x74, 0x65, 0x72, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x28, 0x46, 0x65, 0x74, 0x63, 0x68, 0x43, 0x6c, 
+    0x75, 0x73, 0x74, 0x65, 0x72, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x28, 0x61, 0x29, 0x2c, 0x70, 0x6f, 
+    0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x4e, 0x2c, 0x56, 0x2c, 0x63, 0x4e, 0x64, 0x6f, 0x74, 
+    0x56, 0x2c, 0x46, 0x30, 0x2c, 0x61, 0x76, 0x2c, 0x61, 0x6c, 0x2c, 0x78, 0x2c, 0x73, 0x70, 0x65, 
+    0x63, 0x75, 0x6c, 0x61, 0x72, 0x29, 0x3b, 0x7d, 0x69, 0x76, 0x65, 0x63, 0x32, 0x20, 0x6c, 0x69, 
+    0x73, 0x74, 0x3d, 0x69, 0x76, 0x65, 0x63, 0x32, 0x28, 0x75, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x4c, 
+    0x69, 0x73, 0x74, 0x4f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x2c, 0x75, 0x4c, 0x69, 0x67, 0x68, 0x74, 
+    0x4c, 0x69, 0x73, 0x74, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x29, 0x3b, 0x69, 0x66, 0x28, 0x75, 0x43, 
+    0x6c, 0x75, 0x73, 0x74, 0x65, 0x72, 0x65, 0x64, 0x29, 0x7b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
+    0x64, 0x65, 0x70, 0x74, 0x68, 0x3d, 0x2d, 0x28, 0x75, 0x4d, 0x61, 0x74, 0x56, 0x69, 0x65, 0x77, 
+    0x2a, 0x76, 0x65, 0x63, 0x34, 0x28, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x31, 
+    0x2e, 0x30, 0x29, 0x29, 0x2e, 0x7a, 0x3b, 0x69, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 0x69, 0x6c, 
+    0x65, 0x3d, 0x6d, 0x69, 0x6e, 0x28, 0x69, 0x76, 0x65, 0x63, 0x32, 0x28, 0x67, 0x6c, 0x5f, 0x46, 
+    0x72, 0x61, 0x67, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x2e, 0x78, 0x79, 0x2a, 0x75, 0x43, 0x6c, 0x75, 
+    0x73, 0x74, 0x65, 0x72, 0x53, 0x63, 0x61, 0x6c, 0x65, 0x29, 0x2c, 0x69, 0x76, 0x65, 0x63, 0x32, 
+    0x28, 0x43, 0x4c, 0x55, 0x53, 0x54, 0x45, 0x52, 0x5f, 0x58, 0x2d, 0x31, 0x2c, 0x43, 0x4c, 0x55, 
+    0x53, 0x54, 0x45, 0x52, 0x5f, 0x59, 0x2d, 0x31, 0x29, 0x29, 0x3b, 0x69, 0x6e, 0x74, 0x20, 0x73, 
+    0x6c, 0x69, 0x63, 0x65, 0x3d, 0x63, 0x6c, 0x61, 0x6d, 0x70, 0x28, 0x69, 0x6e, 0x74, 0x28, 0x66, 
+    0x6c, 0x6f, 0x6f, 0x72, 0x28, 0x6c, 0x6f, 0x67, 0x28, 0x6d, 0x61, 0x78, 0x28, 0x64, 0x65, 0x70, 
+    0x74, 0x68, 0x2c, 0x31, 0x65, 0x2d, 0x34, 0x29, 0x29, 0x2a, 0x75, 0x43, 0x6c, 0x75, 0x73, 0x74, 
+    0x65, 0x72, 0x53, 0x6c, 0x69, 0x63, 0x65, 0x2e, 0x78, 0x2b, 0x75, 0x43, 0x6c, 0x75, 0x73, 0x74, 
+    0x65, 0x72, 0x53, 0x6c, 0x69, 0x63, 0x65, 0x2e, 0x79, 0x29, 0x29, 0x2c, 0x30, 0x2c, 0x43, 0x4c, 
+    0x55, 0x53, 0x54, 0x45, 0x52, 0x5f, 0x5a, 0x2d, 0x31, 0x29, 0x3b, 0x6c, 0x69, 0x73, 0x74, 0x3d, 
+    0x69, 0x76, 0x65, 0x63, 0x32, 0x28, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x46, 0x65, 0x74, 0x63, 0x68, 
+    0x28, 0x75, 0x54, 0x65, 0x78, 0x43, 0x6c, 0x75, 0x73, 0x74, 0x65, 0x72, 0x73, 0x2c, 0x69, 0x76, 
+    0x65, 0x63, 0x32, 0x28, 0x74, 0x69, 0x6c, 0x65, 0x2e, 0x78, 0x2b, 0x74, 0x69, 0x6c, 0x65, 0x2e, 
+    0x79, 0x2a, 0x43, 0x4c, 0x55, 0x53, 0x54, 0x45, 0x52, 0x5f, 0x58, 0x2c, 0x73, 0x6c, 0x69, 0x63, 
+    0x65, 0x29, 0x2c, 0x30, 0x29, 0x2e, 0x72, 0x67, 0x29, 0x3b, 0x7d, 0x66, 0x6f, 0x72, 0x28, 0x69, 
+    0x6e, 0x74, 0x20, 0x61, 0x3d, 0x30, 0x3b, 0x61, 0x20, 0x3c, 0x20, 0x6c, 0x69, 0x73, 0x74, 0x2e, 
+    0x79, 0x3b, 0x61, 0x2b, 0x2b, 0x29, 0x7b, 0x53, 0x68, 0x61, 0x64, 0x65, 0x43, 0x6c, 0x75, 0x73, 
+    0x74, 0x65, 0x72, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x28, 0x46, 0x65, 0x74, 0x63, 0x68, 0x43, 0x6c, 
+    0x75, 0x73, 0x74, 0x65, 0x72, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x28, 0x46, 0x65, 0x74, 0x63, 0x68, 
+    0x43, 0x6c, 0x75, 0x73, 0x74, 0x65, 0x72, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x49, 0x6e, 0x64, 0x65, 
+    0x78, 0x28, 0x6c, 0x69, 0x73, 0x74, 0x2e, 0x78, 0x2b, 0x61, 0x29, 0x29, 0x2c, 0x70, 0x6f, 0x73, 
+    0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x4e, 0x2c, 0x56, 0x2c, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x56, 
+    0x2c, 0x46, 0x30, 0x2c, 0x61, 0x76, 0x2c, 0x61, 0x6c, 0x2c, 0x78, 0x2c, 0x73, 0x70, 0x65, 0x63, 
+    0x75, 0x6c, 0x61, 0x72, 0x29, 0x3b, 0x7d, 0x7d, 0x76, 0x65, 0x63, 0x32, 0x20, 0x4f, 0x63, 0x74, 
+    0x61, 0x68, 0x65, 0x64, 0x72, 0x6f, 0x6e, 0x57, 0x72, 0x61, 0x70, 0x28, 0x76, 0x65, 0x63, 0x32, 
+    0x20, 0x63, 0x65, 0x29, 0x7b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x28, 0x31, 0x2e, 0x30, 0x2d, 
+    0x61, 0x62, 0x73, 0x28, 0x63, 0x65, 0x2e, 0x79, 0x78, 0x29, 0x29, 0x2a, 0x6d, 0x69, 0x78, 0x28, 
+    0x76, 0x65, 0x63, 0x32, 0x28, 0x2d, 0x31, 0x2e, 0x30, 0x29, 0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 
+    0x31, 0x2e, 0x30, 0x29, 0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 0x67, 0x72, 0x65, 0x61, 0x74, 0x65, 
+    0x72, 0x54, 0x68, 0x61, 0x6e, 0x45, 0x71, 0x75, 0x61, 0x6c, 0x28, 0x63, 0x65, 0x2e, 0x78, 0x79, 
+    0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 0x30, 0x2e, 0x30, 0x29, 0x29, 0x29, 0x29, 0x3b, 0x7d, 0x76, 
+    0x65, 0x63, 0x32, 0x20, 0x45, 0x6e, 0x63, 0x6f, 0x64, 0x65, 0x4f, 0x63, 0x74, 0x61, 0x68, 0x65, 
+    0x64, 0x72, 0x61, 0x6c, 0x28, 0x76, 0x65, 0x63, 0x33, 0x20, 0x62, 0x64, 0x29, 0x7b, 0x62, 0x64, 
+    0x2f, 0x3d, 0x61, 0x62, 0x73, 0x28, 0x62, 0x64, 0x2e, 0x78, 0x29, 0x2b, 0x61, 0x62, 0x73, 0x28, 
+    0x62, 0x64, 0x2e, 0x79, 0x29, 0x2b, 0x61, 0x62, 0x73, 0x28, 0x62, 0x64, 0x2e, 0x7a, 0x29, 0x3b, 
+    0x62, 0x64, 0x2e, 0x78, 0x79, 0x3d, 0x62, 0x64, 0x2e, 0x7a, 0x20, 0x3e, 0x3d, 0x30, 0x2e, 0x30, 
+    0x20, 0x3f, 0x20, 0x62, 0x64, 0x2e, 0x78, 0x79, 0x20, 0x3a, 0x20, 0x4f, 0x63, 0x74, 0x61, 0x68, 
+    0x65, 0x64, 0x72, 0x6f, 0x6e, 0x57, 0x72, 0x61, 0x70, 0x28, 0x62, 0x64, 0x2e, 0x78, 0x79, 0x29, 
+    0x3b, 0x62, 0x64, 0x2e, 0x78, 0x79, 0x3d, 0x62, 0x64, 0x2e, 0x78, 0x79, 0x2a, 0x30, 0x2e, 0x35, 
+    0x2b, 0x30, 0x2e, 0x35, 0x3b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x62, 0x64, 0x2e, 0x78, 
+    0x79, 0x3b, 0x7d, 0x76, 0x65, 0x63, 0x33, 0x20, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x53, 0x63, 
+    0x61, 0x6c, 0x65, 0x28, 0x76, 0x65, 0x63, 0x33, 0x20, 0x62, 0x64, 0x2c, 0x66, 0x6c, 0x6f, 0x61, 
+    0x74, 0x20, 0x62, 0x74, 0x29, 0x7b, 0x62, 0x64, 0x2e, 0x78, 0x79, 0x2a, 0x3d, 0x62, 0x74, 0x3b, 
+    0x62, 0x64, 0x2e, 0x7a, 0x3d, 0x73, 0x71, 0x72, 0x74, 0x28, 0x31, 0x2e, 0x30, 0x2d, 0x63, 0x6c, 
+    0x61, 0x6d, 0x70, 0x28, 0x64, 0x6f, 0x74, 0x28, 0x62, 0x64, 0x2e, 0x78, 0x79, 0x2c, 0x62, 0x64, 
+    0x2e, 0x78, 0x79, 0x29, 0x2c, 0x30, 0x2e, 0x30, 0x2c, 0x31, 0x2e, 0x30, 0x29, 0x29, 0x3b, 0x72, 
+    0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x62, 0x64, 0x3b, 0x7d, 0x76, 0x65, 0x63, 0x33, 0x20, 0x52, 
+    0x6f, 0x74, 0x61, 0x74, 0x65, 0x57, 0x69, 0x74, 0x68, 0x51, 0x75, 0x61, 0x74, 0x28, 0x76, 0x65, 
+    0x63, 0x33, 0x20, 0x63, 0x64, 0x2c, 0x76, 0x65, 0x63, 0x34, 0x20, 0x62, 0x6b, 0x29, 0x7b, 0x76, 
+    0x65, 0x63, 0x33, 0x20, 0x62, 0x79, 0x3d, 0x32, 0x2e, 0x30, 0x2a, 0x63, 0x72, 0x6f, 0x73, 0x73, 
+    0x28, 0x62, 0x6b, 0x2e, 0x78, 0x79, 0x7a, 0x2c, 0x63, 0x64, 0x29, 0x3b, 0x72, 0x65, 0x74, 0x75, 
+    0x72, 0x6e, 0x20, 0x63, 0x64, 0x2b, 0x62, 0x6b, 0x2e, 0x77, 0x2a, 0x62, 0x79, 0x2b, 0x63, 0x72, 
+    0x6f, 0x73, 0x73, 0x28, 0x62, 0x6b, 0x2e, 0x78, 0x79, 0x7a, 0x2c, 0x62, 0x79, 0x29, 0x3b, 0x7d, 
+    0x76, 0x6f, 0x69, 0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29, 0x7b, 0x76, 0x65, 0x63, 0x34, 
+    0x20, 0x75, 0x3d, 0x76, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x2a, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 
+    0x65, 0x28, 0x75, 0x54, 0x65, 0x78, 0x41, 0x6c, 0x62, 0x65, 0x64, 0x6f, 0x2c, 0x76, 0x54, 0x65, 
+    0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x29, 0x3b, 0x69, 0x66, 0x28, 0x75, 0x2e, 0x61, 0x20, 0x3c, 
+    0x20, 0x75, 0x41, 0x6c, 0x70, 0x68, 0x61, 0x43, 0x75, 0x74, 0x6f, 0x66, 0x66, 0x29, 0x64, 0x69, 
+    0x73, 0x63, 0x61, 0x72, 0x64, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x61, 0x6e, 0x3d, 0x75, 0x45, 
+    0x6d, 0x69, 0x73, 0x73, 0x69, 0x6f, 0x6e, 0x45, 0x6e, 0x65, 0x72, 0x67, 0x79, 0x2a, 0x28, 0x75, 
+    0x45, 0x6d, 0x69, 0x73, 0x73, 0x69, 0x6f, 0x6e, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x2a, 0x74, 0x65, 
+    0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 0x54, 0x65, 0x78, 0x45, 0x6d, 0x69, 0x73, 0x73, 0x69, 
+    0x6f, 0x6e, 0x2c, 0x76, 0x54, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x29, 0x2e, 0x72, 0x67, 
+    0x62, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x62, 0x67, 0x3d, 0x74, 0x65, 0x78, 0x74, 0x75, 
+    0x72, 0x65, 0x28, 0x75, 0x54, 0x65, 0x78, 0x4f, 0x52, 0x4d, 0x2c, 0x76, 0x54, 0x65, 0x78, 0x43, 
+    0x6f, 0x6f, 0x72, 0x64, 0x29, 0x2e, 0x72, 0x67, 0x62, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
+    0x62, 0x66, 0x3d, 0x75, 0x4f, 0x63, 0x63, 0x6c, 0x75, 0x73, 0x69, 0x6f, 0x6e, 0x2a, 0x62, 0x67, 
+    0x2e, 0x78, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x6f, 0x3d, 0x75, 0x52, 0x6f, 0x75, 
+    0x67, 0x68, 0x6e, 0x65, 0x73, 0x73, 0x2a, 0x62, 0x67, 0x2e, 0x79, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 
+    0x74, 0x20, 0x62, 0x61, 0x3d, 0x75, 0x4d, 0x65, 0x74, 0x61, 0x6c, 0x6e, 0x65, 0x73, 0x73, 0x2a, 
+    0x62, 0x67, 0x2e, 0x7a, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x46, 0x30, 0x3d, 0x43, 0x6f, 0x6d, 
+    0x70, 0x75, 0x74, 0x65, 0x46, 0x30, 0x28, 0x62, 0x61, 0x2c, 0x30, 0x2e, 0x35, 0x2c, 0x75, 0x2e, 
+    0x72, 0x67, 0x62, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x4e, 0x3d, 0x6e, 0x6f, 0x72, 0x6d, 
+    0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x76, 0x54, 0x42, 0x4e, 0x2a, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 
+    0x6c, 0x53, 0x63, 0x61, 0x6c, 0x65, 0x28, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x75, 
+    0x54, 0x65, 0x78, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2c, 0x76, 0x54, 0x65, 0x78, 0x43, 0x6f, 
+    0x6f, 0x72, 0x64, 0x29, 0x2e, 0x72, 0x67, 0x62, 0x2a, 0x32, 0x2e, 0x30, 0x2d, 0x31, 0x2e, 0x30, 
+    0x2c, 0x75, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x53, 0x63, 0x61, 0x6c, 0x65, 0x29, 0x29, 0x3b, 
+    0x76, 0x65, 0x63, 0x33, 0x20, 0x56, 0x3d, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 
+    0x28, 0x75, 0x56, 0x69, 0x65, 0x77, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2d, 0x76, 
+    0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 
+    0x70, 0x3d, 0x64, 0x6f, 0x74, 0x28, 0x4e, 0x2c, 0x56, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
+    0x20, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x56, 0x3d, 0x6d, 0x61, 0x78, 0x28, 0x70, 0x2c, 0x31, 0x65, 
+    0x2d, 0x34, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x61, 0x6a, 0x3d, 0x76, 0x65, 0x63, 0x33, 
+    0x28, 0x30, 0x2e, 0x30, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x73, 0x70, 0x65, 0x63, 0x75, 
+    0x6c, 0x61, 0x72, 0x3d, 0x76, 0x65, 0x63, 0x33, 0x28, 0x30, 0x2e, 0x30, 0x29, 0x3b, 0x66, 0x6f, 
+    0x72, 0x28, 0x69, 0x6e, 0x74, 0x20, 0x61, 0x70, 0x3d, 0x30, 0x3b, 0x61, 0x70, 0x20, 0x3c, 0x20, 
+    0x4e, 0x55, 0x4d, 0x5f, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x53, 0x3b, 0x61, 0x70, 0x2b, 0x2b, 0x29, 
+    0x7b, 0x69, 0x66, 0x28, 0x21, 0x75, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x5b, 0x61, 0x70, 0x5d, 
+    0x2e, 0x65, 0x6e, 0x61, 0x62, 0x6c, 0x65, 0x64, 0x29, 0x7b, 0x63, 0x6f, 0x6e, 0x74, 0x69, 0x6e, 
+    0x75, 0x65, 0x3b, 0x7d, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x20, 0x61, 0x75, 0x3d, 0x75, 0x4c, 0x69, 
+    0x67, 0x68, 0x74, 0x73, 0x5b, 0x61, 0x70, 0x5d, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x4c, 0x3d, 
+    0x76, 0x65, 0x63, 0x33, 0x28, 0x30, 0x2e, 0x30, 0x29, 0x3b, 0x69, 0x66, 0x28, 0x61, 0x75, 0x2e, 
+    0x74, 0x79, 0x70, 0x65, 0x3d, 0x3d, 0x44, 0x49, 0x52, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x29, 0x4c, 
+    0x3d, 0x2d, 0x61, 0x75, 0x2e, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x65, 
+    0x6c, 0x73, 0x65, 0x20, 0x4c, 0x3d, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 
+    0x61, 0x75, 0x2e, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2d, 0x76, 0x50, 0x6f, 0x73, 
+    0x69, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x6f, 0x3d, 0x6d, 
+    0x61, 0x78, 0x28, 0x64, 0x6f, 0x74, 0x28, 0x4e, 0x2c, 0x4c, 0x29, 0x2c, 0x30, 0x2e, 0x30, 0x29, 
+    0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 0x3d, 0x6d, 0x69, 
+    0x6e, 0x28, 0x6f, 0x2c, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x48, 0x3d, 
+    0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x56, 0x2b, 0x4c, 0x29, 0x3b, 0x66, 
+    0x6c, 0x6f, 0x61, 0x74, 0x20, 0x6d, 0x3d, 0x6d, 0x61, 0x78, 0x28, 0x64, 0x6f, 0x74, 0x28, 0x4c, 
+    0x2c, 0x48, 0x29, 0x2c, 0x30, 0x2e, 0x30, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 
+    0x4c, 0x64, 0x6f, 0x74, 0x48, 0x3d, 0x6d, 0x69, 0x6e, 0x28, 0x64, 0x6f, 0x74, 0x28, 0x4c, 0x2c, 
+    0x48, 0x29, 0x2c, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x6e, 0x3d, 
+    0x6d, 0x61, 0x78, 0x28, 0x64, 0x6f, 0x74, 0x28, 0x4e, 0x2c, 0x48, 0x29, 0x2c, 0x30, 0x2e, 0x30, 
+    0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x48, 0x3d, 0x6d, 
+    0x69, 0x6e, 0x28, 0x6e, 0x2c, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x61, 
+    0x76, 0x3d, 0x61, 0x75, 0x2e, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x2a, 0x61, 0x75, 0x2e, 0x65, 0x6e, 
+    0x65, 0x72, 0x67, 0x79, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x6b, 0x3d, 0x31, 0x2e, 
+    0x30, 0x2d, 0x62, 0x61, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x61, 0x69, 0x3d, 0x61, 0x76, 0x2a, 
+    0x44, 0x69, 0x66, 0x66, 0x75, 0x73, 0x65, 0x28, 0x63, 0x4c, 0x64, 0x6f, 0x74, 0x48, 0x2c, 0x63, 
+    0x4e, 0x64, 0x6f, 0x74, 0x56, 0x2c, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 0x2c, 0x62, 0x6f, 0x29, 
+    0x2a, 0x61, 0x6b, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x62, 0x77, 0x3d, 0x53, 0x70, 0x65, 0x63, 
+    0x75, 0x6c, 0x61, 0x72, 0x28, 0x46, 0x30, 0x2c, 0x63, 0x4c, 0x64, 0x6f, 0x74, 0x48, 0x2c, 0x63, 
+    0x4e, 0x64, 0x6f, 0x74, 0x48, 0x2c, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x56, 0x2c, 0x63, 0x4e, 0x64, 
+    0x6f, 0x74, 0x4c, 0x2c, 0x62, 0x6f, 0x29, 0x3b, 0x62, 0x77, 0x2a, 0x3d, 0x61, 0x76, 0x2a, 0x61, 
+    0x75, 0x2e, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 
+    0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x3d, 0x31, 0x2e, 0x30, 0x3b, 0x69, 0x66, 0x28, 0x61, 
+    0x75, 0x2e, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x29, 0x7b, 0x69, 0x66, 0x28, 0x61, 0x75, 0x2e, 
+    0x74, 0x79, 0x70, 0x65, 0x3d, 0x3d, 0x4f, 0x4d, 0x4e, 0x49, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x29, 
+    0x7b, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x3d, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x4f, 0x6d, 
+    0x6e, 0x69, 0x28, 0x61, 0x70, 0x2c, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 0x29, 0x3b, 0x7d, 0x65, 
+    0x6c, 0x73, 0x65, 0x7b, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x3d, 0x53, 0x68, 0x61, 0x64, 0x6f, 
+    0x77, 0x28, 0x61, 0x70, 0x2c, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x4c, 0x29, 0x3b, 0x7d, 0x7d, 0x69, 
+    0x66, 0x28, 0x61, 0x75, 0x2e, 0x74, 0x79, 0x70, 0x65, 0x20, 0x21, 0x3d, 0x44, 0x49, 0x52, 0x4c, 
+    0x49, 0x47, 0x48, 0x54, 0x29, 0x7b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x6c, 0x3d, 0x6c, 
+    0x65, 0x6e, 0x67, 0x74, 0x68, 0x28, 0x61, 0x75, 0x2e, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 
+    0x6e, 0x2d, 0x76, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 
+    0x61, 0x74, 0x20, 0x7a, 0x3d, 0x31, 0x2e, 0x30, 0x2d, 0x63, 0x6c, 0x61, 0x6d, 0x70, 0x28, 0x61, 
+    0x6c, 0x2f, 0x61, 0x75, 0x2e, 0x72, 0x61, 0x6e, 0x67, 0x65, 0x2c, 0x30, 0x2e, 0x30, 0x2c, 0x31, 
+    0x2e, 0x30, 0x29, 0x3b, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x2a, 0x3d, 0x7a, 0x2a, 0x61, 0x75, 
+    0x2e, 0x61, 0x74, 0x74, 0x65, 0x6e, 0x75, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x7d, 0x69, 0x66, 
+    0x28, 0x61, 0x75, 0x2e, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x3d, 0x53, 0x50, 0x4f, 0x54, 0x4c, 0x49, 
+    0x47, 0x48, 0x54, 0x29, 0x7b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x61, 0x3d, 0x64, 0x6f, 
+    0x74, 0x28, 0x4c, 0x2c, 0x2d, 0x61, 0x75, 0x2e, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 
+    0x6e, 0x29, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x6f, 0x3d, 0x28, 0x61, 0x75, 0x2e, 
+    0x69, 0x6e, 0x6e, 0x65, 0x72, 0x43, 0x75, 0x74, 0x4f, 0x66, 0x66, 0x2d, 0x61, 0x75, 0x2e, 0x6f, 
+    0x75, 0x74, 0x65, 0x72, 0x43, 0x75, 0x74, 0x4f, 0x66, 0x66, 0x29, 0x3b, 0x73, 0x68, 0x61, 0x64, 
+    0x6f, 0x77, 0x2a, 0x3d, 0x73, 0x6d, 0x6f, 0x6f, 0x74, 0x68, 0x73, 0x74, 0x65, 0x70, 0x28, 0x30, 
+    0x2e, 0x30, 0x2c, 0x31, 0x2e, 0x30, 0x2c, 0x28, 0x63, 0x61, 0x2d, 0x61, 0x75, 0x2e, 0x6f, 0x75, 
+    0x74, 0x65, 0x72, 0x43, 0x75, 0x74, 0x4f, 0x66, 0x66, 0x29, 0x2f, 0x61, 0x6f, 0x29, 0x3b, 0x7d, 
+    0x61, 0x6a, 0x2b, 0x3d, 0x61, 0x69, 0x2a, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x3b, 0x73, 0x70, 
+    0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x2b, 0x3d, 0x62, 0x77, 0x2a, 0x73, 0x68, 0x61, 0x64, 0x6f, 
+    0x77, 0x3b, 0x7d, 0x53, 0x68, 0x61, 0x64, 0x65, 0x53, 0x74, 0x6f, 0x72, 0x65, 0x64, 0x4c, 0x69, 
+    0x67, 0x68, 0x74, 0x73, 0x28, 0x76, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x4e, 
+    0x2c, 0x56, 0x2c, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x56, 0x2c, 0x46, 0x30, 0x2c, 0x62, 0x6f, 0x2c, 
+    0x62, 0x61, 0x2c, 0x61, 0x6a, 0x2c, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x29, 0x3b, 
+    0x76, 0x65, 0x63, 0x33, 0x20, 0x78, 0x3d, 0x75, 0x41, 0x6d, 0x62, 0x69, 0x65, 0x6e, 0x74, 0x43, 
+    0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x69, 0x66, 0x28, 0x75, 0x48, 0x61, 0x73, 0x53, 0x6b, 0x79, 0x62, 
+    0x6f, 0x78, 0x29, 0x7b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6b, 0x53, 0x3d, 0x49, 0x42, 0x4c, 0x5f, 
+    0x46, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x53, 0x63, 0x68, 0x6c, 0x69, 0x63, 0x6b, 0x52, 0x6f, 
+    0x75, 0x67, 0x68, 0x6e, 0x65, 0x73, 0x73, 0x28, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x56, 0x2c, 0x46, 
+    0x30, 0x2c, 0x62, 0x6f, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6b, 0x44, 0x3d, 0x28, 0x31, 
+    0x2e, 0x30, 0x2d, 0x6b, 0x53, 0x29, 0x2a, 0x28, 0x31, 0x2e, 0x30, 0x2d, 0x62, 0x61, 0x29, 0x3b, 
+    0x76, 0x65, 0x63, 0x33, 0x20, 0x72, 0x3d, 0x52, 0x6f, 0x74, 0x61, 0x74, 0x65, 0x57, 0x69, 0x74, 
+    0x68, 0x51, 0x75, 0x61, 0x74, 0x28, 0x4e, 0x2c, 0x75, 0x51, 0x75, 0x61, 0x74, 0x53, 0x6b, 0x79, 
+    0x62, 0x6f, 0x78, 0x29, 0x3b, 0x78, 0x3d, 0x6b, 0x44, 0x2a, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 
+    0x65, 0x28, 0x75, 0x43, 0x75, 0x62, 0x65, 0x49, 0x72, 0x72, 0x61, 0x64, 0x69, 0x61, 0x6e, 0x63, 
+    0x65, 0x2c, 0x72, 0x29, 0x2e, 0x72, 0x67, 0x62, 0x2a, 0x75, 0x53, 0x6b, 0x79, 0x62, 0x6f, 0x78, 
+    0x41, 0x6d, 0x62, 0x69, 0x65, 0x6e, 0x74, 0x49, 0x6e, 0x74, 0x65, 0x6e, 0x73, 0x69, 0x74, 0x79, 
+    0x3b, 0x7d, 0x65, 0x6c, 0x73, 0x65, 0x7b, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 
+    0x61, 0x74, 0x20, 0x71, 0x3d, 0x31, 0x2e, 0x30, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6b, 0x53, 
+    0x3d, 0x46, 0x30, 0x2b, 0x28, 0x31, 0x2e, 0x30, 0x2d, 0x46, 0x30, 0x29, 0x2a, 0x53, 0x63, 0x68, 
+    0x6c, 0x69, 0x63, 0x6b, 0x46, 0x72, 0x65, 0x73, 0x6e, 0x65, 0x6c, 0x28, 0x71, 0x29, 0x3b, 0x76, 
+    0x65, 0x63, 0x33, 0x20, 0x6b, 0x44, 0x3d, 0x28, 0x31, 0x2e, 0x30, 0x2d, 0x6b, 0x53, 0x29, 0x2a, 
+    0x28, 0x31, 0x2e, 0x30, 0x2d, 0x62, 0x61, 0x29, 0x3b, 0x78, 0x2a, 0x3d, 0x28, 0x6b, 0x44, 0x2a, 
+    0x75, 0x2e, 0x72, 0x67, 0x62, 0x2b, 0x6b, 0x53, 0x29, 0x3b, 0x7d, 0x78, 0x2a, 0x3d, 0x62, 0x66, 
+    0x3b, 0x69, 0x66, 0x28, 0x75, 0x48, 0x61, 0x73, 0x53, 0x6b, 0x79, 0x62, 0x6f, 0x78, 0x29, 0x7b, 
+    0x76, 0x65, 0x63, 0x33, 0x20, 0x52, 0x3d, 0x52, 0x6f, 0x74, 0x61, 0x74, 0x65, 0x57, 0x69, 0x74, 
+    0x68, 0x51, 0x75, 0x61, 0x74, 0x28, 0x72, 0x65, 0x66, 0x6c, 0x65, 0x63, 0x74, 0x28, 0x2d, 0x56, 
+    0x2c, 0x4e, 0x29, 0x2c, 0x75, 0x51, 0x75, 0x61, 0x74, 0x53, 0x6b, 0x79, 0x62, 0x6f, 0x78, 0x29, 
+    0x3b, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x4d, 0x41, 0x58, 
+    0x5f, 0x52, 0x45, 0x46, 0x4c, 0x45, 0x43, 0x54, 0x49, 0x4f, 0x4e, 0x5f, 0x4c, 0x4f, 0x44, 0x3d, 
+    0x37, 0x2e, 0x30, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x62, 0x62, 0x3d, 0x49, 0x42, 0x4c, 
+    0x5f, 0x47, 0x65, 0x74, 0x53, 0x70, 0x65, 0x63, 0x75, 0x6c, 0x61, 0x72, 0x4d, 0x69, 0x70, 0x4c, 
+    0x65, 0x76, 0x65, 0x6c, 0x28, 0x62, 0x6f, 0x2c, 0x4d, 0x41, 0x58, 0x5f, 0x52, 0x45, 0x46, 0x4c, 
+    0x45, 0x43, 0x54, 0x49, 0x4f, 0x4e, 0x5f, 0x4c, 0x4f, 0x44, 0x2b, 0x31, 0x2e, 0x30, 0x29, 0x3b, 
+    0x76, 0x65, 0x63, 0x33, 0x20, 0x62, 0x69, 0x3d, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x4c, 
+    0x6f, 0x64, 0x28, 0x75, 0x43, 0x75, 0x62, 0x65, 0x50, 0x72, 0x65, 0x66, 0x69, 0x6c, 0x74, 0x65, 
+    0x72, 0x2c, 0x52, 0x2c, 0x62, 0x62, 0x29, 0x2e, 0x72, 0x67, 0x62, 0x3b, 0x66, 0x6c, 0x6f, 0x61, 
+    0x74, 0x20, 0x62, 0x78, 0x3d, 0x49, 0x42, 0x4c, 0x5f, 0x47, 0x65, 0x74, 0x53, 0x70, 0x65, 0x63, 
+    0x75, 0x6c, 0x61, 0x72, 0x4f, 0x63, 0x63, 0x6c, 0x75, 0x73, 0x69, 0x6f, 0x6e, 0x28, 0x63, 0x4e, 
+    0x64, 0x6f, 0x74, 0x56, 0x2c, 0x62, 0x66, 0x2c, 0x62, 0x6f, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 
+    0x20, 0x62, 0x76, 0x3d, 0x49, 0x42, 0x4c, 0x5f, 0x47, 0x65, 0x74, 0x4d, 0x75, 0x6c, 0x74, 0x69, 
+    0x53, 0x63, 0x61, 0x74, 0x74, 0x65, 0x72, 0x42, 0x52, 0x44, 0x46, 0x28, 0x63, 0x4e, 0x64, 0x6f, 
+    0x74, 0x56, 0x2c, 0x62, 0x6f, 0x2c, 0x46, 0x30, 0x2c, 0x62, 0x61, 0x29, 0x3b, 0x76, 0x65, 0x63, 
+    0x33, 0x20, 0x62, 0x75, 0x3d, 0x62, 0x69, 0x2a, 0x62, 0x76, 0x2a, 0x62, 0x78, 0x3b, 0x66, 0x6c, 
+    0x6f, 0x61, 0x74, 0x20, 0x61, 0x6d, 0x3d, 0x6d, 0x69, 0x78, 0x28, 0x31, 0x2e, 0x30, 0x2c, 0x70, 
+    0x6f, 0x77, 0x28, 0x63, 0x4e, 0x64, 0x6f, 0x74, 0x56, 0x2c, 0x30, 0x2e, 0x35, 0x29, 0x2c, 0x62, 
+    0x6f, 0x29, 0x3b, 0x62, 0x75, 0x2a, 0x3d, 0x61, 0x6d, 0x3b, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 
+    0x61, 0x72, 0x2b, 0x3d, 0x62, 0x75, 0x2a, 0x75, 0x53, 0x6b, 0x79, 0x62, 0x6f, 0x78, 0x52, 0x65, 
+    0x66, 0x6c, 0x65, 0x63, 0x74, 0x49, 0x6e, 0x74, 0x65, 0x6e, 0x73, 0x69, 0x74, 0x79, 0x3b, 0x7d, 
+    0x61, 0x6a, 0x3d, 0x75, 0x2e, 0x72, 0x67, 0x62, 0x2a, 0x28, 0x78, 0x2b, 0x61, 0x6a, 0x29, 0x3b, 
+    0x69, 0x3d, 0x76, 0x65, 0x63, 0x34, 0x28, 0x61, 0x6a, 0x2b, 0x73, 0x70, 0x65, 0x63, 0x75, 0x6c, 
+    0x61, 0x72, 0x2b, 0x61, 0x6e, 0x2c, 0x75, 0x2e, 0x61, 0x29, 0x3b, 0x68, 0x3d, 0x76, 0x65, 0x63, 
+    0x34, 0x28, 0x75, 0x2e, 0x72, 0x67, 0x62, 0x2c, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x6a, 0x3d, 0x76, 
+    0x65, 0x63, 0x34, 0x28, 0x45, 0x6e, 0x63, 0x6f, 0x64, 0x65, 0x4f, 0x63, 0x74, 0x61, 0x68, 0x65, 
+    0x64, 0x72, 0x61, 0x6c, 0x28, 0x4e, 0x29, 0x2c, 0x76, 0x65, 0x63, 0x32, 0x28, 0x31, 0x2e, 0x30, 
+    0x29, 0x29, 0x3b, 0x6b, 0x3d, 0x76, 0x65, 0x63, 0x34, 0x28, 0x62, 0x66, 0x2c, 0x62, 0x6f, 0x2c, 
+    0x62, 0x61, 0x2c, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x7d, 0x00
 };
 
-#define FORWARD_FRAG_SIZE 7751
+#define FORWARD_FRAG_SIZE 10761
 
 #ifdef __cplusplus
 }
@@ -36,77 +36,86 @@ static const char FORWARD_VERT[] = {
     0x43, 0x6f, 0x6f, 0x72, 0x64, 0x4f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x3b, 0x75, 0x6e, 0x69, 0x66, 
     0x6f, 0x72, 0x6d, 0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x75, 0x54, 0x65, 0x78, 0x43, 0x6f, 0x6f, 
     0x72, 0x64, 0x53, 0x63, 0x61, 0x6c, 0x65, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 
-    0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x31, 0x44, 0x20, 0x75, 0x54, 0x65, 0x78, 0x42, 0x6f, 
+    0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x75, 0x54, 0x65, 0x78, 0x42, 0x6f, 
     0x6e, 0x65, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x63, 0x65, 0x73, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 
-    0x72, 0x6d, 0x20, 0x62, 0x6f, 0x6f, 0x6c, 0x20, 0x75, 0x55, 0x73, 0x65, 0x53, 0x6b, 0x69, 0x6e, 
-    0x6e, 0x69, 0x6e, 0x67, 0x3b, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x76, 0x50, 
-    0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x32, 
-    0x20, 0x76, 0x54, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x3b, 0x6f, 0x75, 0x74, 0x20, 0x76, 
-    0x65, 0x63, 0x34, 0x20, 0x76, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x6f, 0x75, 0x74, 0x20, 0x6d, 
-    0x61, 0x74, 0x33, 0x20, 0x76, 0x54, 0x42, 0x4e, 0x3b, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 
-    0x34, 0x20, 0x76, 0x50, 0x6f, 0x73, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x53, 0x70, 0x61, 0x63, 0x65, 
-    0x5b, 0x4e, 0x55, 0x4d, 0x5f, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x53, 0x5d, 0x3b, 0x6d, 0x61, 0x74, 
-    0x34, 0x20, 0x47, 0x65, 0x74, 0x42, 0x6f, 0x6e, 0x65, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x78, 0x28, 
-    0x69, 0x6e, 0x74, 0x20, 0x62, 0x29, 0x7b, 0x69, 0x6e, 0x74, 0x20, 0x61, 0x3d, 0x34, 0x2a, 0x62, 
-    0x3b, 0x76, 0x65, 0x63, 0x34, 0x20, 0x64, 0x3d, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x46, 0x65, 0x74, 
-    0x63, 0x68, 0x28, 0x75, 0x54, 0x65, 0x78, 0x42, 0x6f, 0x6e, 0x65, 0x4d, 0x61, 0x74, 0x72, 0x69, 
-    0x63, 0x65, 0x73, 0x2c, 0x61, 0x2b, 0x30, 0x2c, 0x30, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x34, 0x20, 
-    0x65, 0x3d, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x46, 0x65, 0x74, 0x63, 0x68, 0x28, 0x75, 0x54, 0x65, 
-    0x78, 0x42, 0x6f, 0x6e, 0x65, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x63, 0x65, 0x73, 0x2c, 0x61, 0x2b, 
-    0x31, 0x2c, 0x30, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x34, 0x20, 0x66, 0x3d, 0x74, 0x65, 0x78, 0x65, 
-    0x6c, 0x46, 0x65, 0x74, 0x63, 0x68, 0x28, 0x75, 0x54, 0x65, 0x78, 0x42, 0x6f, 0x6e, 0x65, 0x4d, 
-    0x61, 0x74, 0x72, 0x69, 0x63, 0x65, 0x73, 0x2c, 0x61, 0x2b, 0x32, 0x2c, 0x30, 0x29, 0x3b, 0x76, 
-    0x65, 0x63, 0x34, 0x20, 0x67, 0x3d, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x46, 0x65, 0x74, 0x63, 0x68, 
-    0x28, 0x75, 0x54, 0x65, 0x78, 0x42, 0x6f, 0x6e, 0x65, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x63, 0x65, 
-    0x73, 0x2c, 0x61, 0x2b, 0x33, 0x2c, 0x30, 0x29, 0x3b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 
-    0x74, 0x72, 0x61, 0x6e, 0x73, 0x70, 0x6f, 0x73, 0x65, 0x28, 0x6d, 0x61, 0x74, 0x34, 0x28, 0x64, 
-    0x2c, 0x65, 0x2c, 0x66, 0x2c, 0x67, 0x29, 0x29, 0x3b, 0x7d, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x6d, 
-    0x61, 0x69, 0x6e, 0x28, 0x29, 0x7b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6a, 0x3d, 0x61, 0x50, 0x6f, 
-    0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x69, 0x3d, 0x61, 0x4e, 
-    0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6b, 0x3d, 0x61, 0x54, 0x61, 
-    0x6e, 0x67, 0x65, 0x6e, 0x74, 0x2e, 0x78, 0x79, 0x7a, 0x3b, 0x69, 0x66, 0x28, 0x75, 0x55, 0x73, 
-    0x65, 0x53, 0x6b, 0x69, 0x6e, 0x6e, 0x69, 0x6e, 0x67, 0x29, 0x7b, 0x6d, 0x61, 0x74, 0x34, 0x20, 
-    0x68, 0x3d, 0x61, 0x57, 0x65, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x78, 0x2a, 0x47, 0x65, 0x74, 
-    0x42, 0x6f, 0x6e, 0x65, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x78, 0x28, 0x61, 0x42, 0x6f, 0x6e, 0x65, 
-    0x49, 0x44, 0x73, 0x2e, 0x78, 0x29, 0x2b, 0x61, 0x57, 0x65, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 
-    0x79, 0x2a, 0x47, 0x65, 0x74, 0x42, 0x6f, 0x6e, 0x65, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x78, 0x28, 
-    0x61, 0x42, 0x6f, 0x6e, 0x65, 0x49, 0x44, 0x73, 0x2e, 0x79, 0x29, 0x2b, 0x61, 0x57, 0x65, 0x69, 
-    0x67, 0x68, 0x74, 0x73, 0x2e, 0x7a, 0x2a, 0x47, 0x65, 0x74, 0x42, 0x6f, 0x6e, 0x65, 0x4d, 0x61, 
-    0x74, 0x72, 0x69, 0x78, 0x28, 0x61, 0x42, 0x6f, 0x6e, 0x65, 0x49, 0x44, 0x73, 0x2e, 0x7a, 0x29, 
-    0x2b, 0x61, 0x57, 0x65, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x77, 0x2a, 0x47, 0x65, 0x74, 0x42, 
-    0x6f, 0x6e, 0x65, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x78, 0x28, 0x61, 0x42, 0x6f, 0x6e, 0x65, 0x49, 
-    0x44, 0x73, 0x2e, 0x77, 0x29, 0x3b, 0x6a, 0x3d, 0x76, 0x65, 0x63, 0x33, 0x28, 0x68, 0x2a, 0x76, 
-    0x65, 0x63, 0x34, 0x28, 0x61, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x31, 0x2e, 
-    0x30, 0x29, 0x29, 0x3b, 0x69, 0x3d, 0x6d, 0x61, 0x74, 0x33, 0x28, 0x68, 0x29, 0x2a, 0x61, 0x4e, 
-    0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x6b, 0x3d, 0x6d, 0x61, 0x74, 0x33, 0x28, 0x68, 0x29, 0x2a, 
-    0x61, 0x54, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x2e, 0x78, 0x79, 0x7a, 0x3b, 0x7d, 0x76, 0x65, 
-    0x63, 0x34, 0x20, 0x6c, 0x3d, 0x75, 0x4d, 0x61, 0x74, 0x4d, 0x6f, 0x64, 0x65, 0x6c, 0x2a, 0x76, 
-    0x65, 0x63, 0x34, 0x28, 0x6a, 0x2c, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x76, 0x50, 0x6f, 0x73, 0x69, 
-    0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x6c, 0x2e, 0x78, 0x79, 0x7a, 0x3b, 0x76, 0x54, 0x65, 0x78, 0x43, 
-    0x6f, 0x6f, 0x72, 0x64, 0x3d, 0x75, 0x54, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x4f, 0x66, 
-    0x66, 0x73, 0x65, 0x74, 0x2b, 0x61, 0x54, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x2a, 0x75, 
-    0x54, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x53, 0x63, 0x61, 0x6c, 0x65, 0x3b, 0x76, 0x43, 
-    0x6f, 0x6c, 0x6f, 0x72, 0x3d, 0x61, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x2a, 0x75, 0x41, 0x6c, 0x62, 
-    0x65, 0x64, 0x6f, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x54, 0x3d, 
-    0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x76, 0x65, 0x63, 0x33, 0x28, 0x75, 
-    0x4d, 0x61, 0x74, 0x4d, 0x6f, 0x64, 0x65, 0x6c, 0x2a, 0x76, 0x65, 0x63, 0x34, 0x28, 0x6b, 0x2c, 
-    0x30, 0x2e, 0x30, 0x29, 0x29, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x4e, 0x3d, 0x6e, 0x6f, 
-    0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x76, 0x65, 0x63, 0x33, 0x28, 0x75, 0x4d, 0x61, 
-    0x74, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x2a, 0x76, 0x65, 0x63, 0x34, 0x28, 0x69, 0x2c, 0x31, 
-    0x2e, 0x30, 0x29, 0x29, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x42, 0x3d, 0x6e, 0x6f, 0x72, 
-    0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 0x63, 0x72, 0x6f, 0x73, 0x73, 0x28, 0x4e, 0x2c, 0x54, 
-    0x29, 0x29, 0x2a, 0x61, 0x54, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x2e, 0x77, 0x3b, 0x76, 0x54, 
-    0x42, 0x4e, 0x3d, 0x6d, 0x61, 0x74, 0x33, 0x28, 0x54, 0x2c, 0x42, 0x2c, 0x4e, 0x29, 0x3b, 0x66, 
-    0x6f, 0x72, 0x28, 0x69, 0x6e, 0x74, 0x20, 0x63, 0x3d, 0x30, 0x3b, 0x63, 0x20, 0x3c, 0x20, 0x4e, 
-    0x55, 0x4d, 0x5f, 0x4c, 0x49, 0x47, 0x48, 0x54, 0x53, 0x3b, 0x63, 0x2b, 0x2b, 0x29, 0x7b, 0x76, 
-    0x50, 0x6f, 0x73, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x53, 0x70, 0x61, 0x63, 0x65, 0x5b, 0x63, 0x5d, 
-    0x3d, 0x75, 0x4d, 0x61, 0x74, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x56, 0x50, 0x5b, 0x63, 0x5d, 0x2a, 
-    0x6c, 0x3b, 0x7d, 0x67, 0x6c, 0x5f, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x75, 
-    0x4d, 0x61, 0x74, 0x4d, 0x56, 0x50, 0x2a, 0x76, 0x65, 0x63, 0x34, 0x28, 0x6a, 0x2c, 0x31, 0x2e, 
-    0x30, 0x29, 0x3b, 0x7d, 0x00
+    0x72, 0x6d, 0x20, 0x69, 0x6e, 0x74, 0x20, 0x75, 0x42, 0x6f, 0x6e, 0x65, 0x4f, 0x66, 0x66, 0x73, 
+    0x65, 0x74, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x62, 0x6f, 0x6f, 0x6c, 0x20, 
+    0x75, 0x55, 0x73, 0x65, 0x53, 0x6b, 0x69, 0x6e, 0x6e, 0x69, 0x6e, 0x67, 0x3b, 0x6f, 0x75, 0x74, 
+    0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x76, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 
+    0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x76, 0x54, 0x65, 0x78, 0x43, 0x6f, 0x6f, 
+    0x72, 0x64, 0x3b, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 0x43, 0x6f, 0x6c, 
+    0x6f, 0x72, 0x3b, 0x6f, 0x75, 0x74, 0x20, 0x6d, 0x61, 0x74, 0x33, 0x20, 0x76, 0x54, 0x42, 0x4e, 
+    0x3b, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76, 0x50, 0x6f, 0x73, 0x4c, 0x69, 
+    0x67, 0x68, 0x74, 0x53, 0x70, 0x61, 0x63, 0x65, 0x5b, 0x4e, 0x55, 0x4d, 0x5f, 0x4c, 0x49, 0x47, 
+    0x48, 0x54, 0x53, 0x5d, 0x3b, 0x6d, 0x61, 0x74, 0x34, 0x20, 0x47, 0x65, 0x74, 0x42, 0x6f, 0x6e, 
+    0x65, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x78, 0x28, 0x69, 0x6e, 0x74, 0x20, 0x62, 0x29, 0x7b, 0x69, 
+    0x6e, 0x74, 0x20, 0x61, 0x3d, 0x34, 0x2a, 0x28, 0x75, 0x42, 0x6f, 0x6e, 0x65, 0x4f, 0x66, 0x66, 
+    0x73, 0x65, 0x74, 0x2b, 0x62, 0x29, 0x3b, 0x69, 0x6e, 0x74, 0x20, 0x77, 0x3d, 0x74, 0x65, 0x78, 
+    0x74, 0x75, 0x72, 0x65, 0x53, 0x69, 0x7a, 0x65, 0x28, 0x75, 0x54, 0x65, 0x78, 0x42, 0x6f, 0x6e, 
+    0x65, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x63, 0x65, 0x73, 0x2c, 0x30, 0x29, 0x2e, 0x78, 0x3b, 0x69, 
+    0x76, 0x65, 0x63, 0x32, 0x20, 0x70, 0x3d, 0x69, 0x76, 0x65, 0x63, 0x32, 0x28, 0x61, 0x25, 0x77, 
+    0x2c, 0x61, 0x2f, 0x77, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x34, 0x20, 0x64, 0x3d, 0x74, 0x65, 0x78, 
+    0x65, 0x6c, 0x46, 0x65, 0x74, 0x63, 0x68, 0x28, 0x75, 0x54, 0x65, 0x78, 0x42, 0x6f, 0x6e, 0x65, 
+    0x4d, 0x61, 0x74, 0x72, 0x69, 0x63, 0x65, 0x73, 0x2c, 0x69, 0x76, 0x65, 0x63, 0x32, 0x28, 0x70, 
+    0x2e, 0x78, 0x2b, 0x30, 0x2c, 0x70, 0x2e, 0x79, 0x29, 0x2c, 0x30, 0x29, 0x3b, 0x76, 0x65, 0x63, 
+    0x34, 0x20, 0x65, 0x3d, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x46, 0x65, 0x74, 0x63, 0x68, 0x28, 0x75, 
+    0x54, 0x65, 0x78, 0x42, 0x6f, 0x6e, 0x65, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x63, 0x65, 0x73, 0x2c, 
+    0x69, 0x76, 0x65, 0x63, 0x32, 0x28, 0x70, 0x2e, 0x78, 0x2b, 0x31, 0x2c, 0x70, 0x2e, 0x79, 0x29, 
+    0x2c, 0x30, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x34, 0x20, 0x66, 0x3d, 0x74, 0x65, 0x78, 0x65, 0x6c, 
+    0x46, 0x65, 0x74, 0x63, 0x68, 0x28, 0x75, 0x54, 0x65, 0x78, 0x42, 0x6f, 0x6e, 0x65, 0x4d, 0x61, 
+    0x74, 0x72, 0x69, 0x63, 0x65, 0x73, 0x2c, 0x69, 0x76, 0x65, 0x63, 0x32, 0x28, 0x70, 0x2e, 0x78, 
+    0x2b, 0x32, 0x2c, 0x70, 0x2e, 0x79, 0x29, 0x2c, 0x30, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x34, 0x20, 
+    0x67, 0x3d, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x46, 0x65, 0x74, 0x63, 0x68, 0x28, 0x75, 0x54, 0x65, 
+    0x78, 0x42, 0x6f, 0x6e, 0x65, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x63, 0x65, 0x73, 0x2c, 0x69, 0x76, 
+    0x65, 0x63, 0x32, 0x28, 0x70, 0x2e, 0x78, 0x2b, 0x33, 0x2c, 0x70, 0x2e, 0x79, 0x29, 0x2c, 0x30, 
+    0x29, 0x3b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x70, 0x6f, 
+    0x73, 0x65, 0x28, 0x6d, 0x61, 0x74, 0x34, 0x28, 0x64, 0x2c, 0x65, 0x2c, 0x66, 0x2c, 0x67, 0x29, 
+    0x29, 0x3b, 0x7d, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29, 0x7b, 0x76, 
+    0x65, 0x63, 0x33, 0x20, 0x6a, 0x3d, 0x61, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 
+    0x76, 0x65, 0x63, 0x33, 0x20, 0x69, 0x3d, 0x61, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x76, 
+    0x65, 0x63, 0x33, 0x20, 0x6b, 0x3d, 0x61, 0x54, 0x61, 0x6e, 0x67, 0x65, 0x6e, 0x74, 0x2e, 0x78, 
+    0x79, 0x7a, 0x3b, 0x69, 0x66, 0x28, 0x75, 0x55, 0x73, 0x65, 0x53, 0x6b, 0x69, 0x6e, 0x6e, 0x69, 
+    0x6e, 0x67, 0x29, 0x7b, 0x6d, 0x61, 0x74, 0x34, 0x20, 0x68, 0x3d, 0x61, 0x57, 0x65, 0x69, 0x67, 
+    0x68, 0x74, 0x73, 0x2e, 0x78, 0x2a, 0x47, 0x65, 0x74, 0x42, 0x6f, 0x6e, 0x65, 0x4d, 0x61, 0x74, 
+    0x72, 0x69, 0x78, 0x28, 0x61, 0x42, 0x6f, 0x6e, 0x65, 0x49, 0x44, 0x73, 0x2e, 0x78, 0x29, 0x2b, 
+    0x61, 0x57, 0x65, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x79, 0x2a, 0x47, 0x65, 0x74, 0x42, 0x6f, 
+    0x6e, 0x65, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x78, 0x28, 0x61, 0x42, 0x6f, 0x6e, 0x65, 0x49, 0x44, 
+    0x73, 0x2e, 0x79, 0x29, 0x2b, 0x61, 0x57, 0x65, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x7a, 0x2a, 
+    0x47, 0x65, 0x74, 0x42, 0x6f, 0x6e, 0x65, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x78, 0x28, 0x61, 0x42, 
+    0x6f, 0x6e, 0x65, 0x49, 0x44, 0x73, 0x2e, 0x7a, 0x29, 0x2b, 0x61, 0x57, 0x65, 0x69, 0x67, 0x68, 
+    0x74, 0x73, 0x2e, 0x77, 0x2a, 0x47, 0x65, 0x74, 0x42, 0x6f, 0x6e, 0x65, 0x4d, 0x61, 0x74, 0x72, 
+    0x69, 0x78, 0x28, 0x61, 0x42, 0x6f, 0x6e, 0x65, 0x49, 0x44, 0x73, 0x2e, 0x77, 0x29, 0x3b, 0x6a, 
+    0x3d, 0x76, 0x65, 0x63, 0x33, 0x28, 0x68, 0x2a, 0x76, 0x65, 0x63, 0x34, 0x28, 0x61, 0x50, 0x6f, 
+    0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x31, 0x2e, 0x30, 0x29, 0x29, 0x3b, 0x69, 0x3d, 0x6d, 
+    0x61, 0x74, 0x33, 0x28, 0x68, 0x29, 0x2a, 0x61, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x6b, 
+    0x3d, 0x6d, 0x61, 0x74, 0x33, 0x28, 0x68, 0x29, 0x2a, 0x61, 0x54, 0x61, 0x6e, 0x67, 0x65, 0x6e, 
+    0x74, 0x2e, 0x78, 0x79, 0x7a, 0x3b, 0x7d, 0x76, 0x65, 0x63, 0x34, 0x20, 0x6c, 0x3d, 0x75, 0x4d, 
+    0x61, 0x74, 0x4d, 0x6f, 0x64, 0x65, 0x6c, 0x2a, 0x76, 0x65, 0x63, 0x34, 0x28, 0x6a, 0x2c, 0x31, 
+    0x2e, 0x30, 0x29, 0x3b, 0x76, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x6c, 0x2e, 
+    0x78, 0x79, 0x7a, 0x3b, 0x76, 0x54, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x3d, 0x75, 0x54, 
+    0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x4f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x2b, 0x61, 0x54, 
+    0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x2a, 0x75, 0x54, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 
+    0x64, 0x53, 0x63, 0x61, 0x6c, 0x65, 0x3b, 0x76, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3d, 0x61, 0x43, 
+    0x6f, 0x6c, 0x6f, 0x72, 0x2a, 0x75, 0x41, 0x6c, 0x62, 0x65, 0x64, 0x6f, 0x43, 0x6f, 0x6c, 0x6f, 
+    0x72, 0x3b, 0x76, 0x65, 0x63, 0x33, 0x20, 0x54, 0x3d, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 
+    0x7a, 0x65, 0x28, 0x76, 0x65, 0x63, 0x33, 0x28, 0x75, 0x4d, 0x61, 0x74, 0x4d, 0x6f, 0x64, 0x65, 
+    0x6c, 0x2a, 0x76, 0x65, 0x63, 0x34, 0x28, 0x6b, 0x2c, 0x30, 0x2e, 0x30, 0x29, 0x29, 0x29, 0x3b, 
+    0x76, 0x65, 0x63, 0x33, 0x20, 0x4e, 0x3d, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 
+    0x28, 0x76, 0x65, 0x63, 0x33, 0x28, 0x75, 0x4d, 0x61, 0x74, 0x4e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 
+    0x2a, 0x76, 0x65, 0x63, 0x34, 0x28, 0x69, 0x2c, 0x31, 0x2e, 0x30, 0x29, 0x29, 0x29, 0x3b, 0x76, 
+    0x65, 0x63, 0x33, 0x20, 0x42, 0x3d, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x28, 
+    0x63, 0x72, 0x6f, 0x73, 0x73, 0x28, 0x4e, 0x2c, 0x54, 0x29, 0x29, 0x2a, 0x61, 0x54, 0x61, 0x6e, 
+    0x67, 0x65, 0x6e, 0x74, 0x2e, 0x77, 0x3b, 0x76, 0x54, 0x42, 0x4e, 0x3d, 0x6d, 0x61, 0x74, 0x33, 
+    0x28, 0x54, 0x2c, 0x42, 0x2c, 0x4e, 0x29, 0x3b, 0x66, 0x6f, 0x72, 0x28, 0x69, 0x6e, 0x74, 0x20, 
+    0x63, 0x3d, 0x30, 0x3b, 0x63, 0x20, 0x3c, 0x20, 0x4e, 0x55, 0x4d, 0x5f, 0x4c, 0x49, 0x47, 0x48, 
+    0x54, 0x53, 0x3b, 0x63, 0x2b, 0x2b, 0x29, 0x7b, 0x76, 0x50, 0x6f, 0x73, 0x4c, 0x69, 0x67, 0x68, 
+    0x74, 0x53, 0x70, 0x61, 0x63, 0x65, 0x5b, 0x63, 0x5d, 0x3d, 0x75, 0x4d, 0x61, 0x74, 0x4c, 0x69, 
+    0x67, 0x68, 0x74, 0x56, 0x50, 0x5b, 0x63, 0x5d, 0x2a, 0x6c, 0x3b, 0x7d, 0x67, 0x6c, 0x5f, 0x50, 
+    0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x75, 0x4d, 0x61, 0x74, 0x4d, 0x56, 0x50, 0x2a, 
+    0x76, 0x65, 0x63, 0x34, 0x28, 0x6a, 0x2c, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x7d, 0x00
 };
 
-#define FORWARD_VERT_SIZE 1556
+#define FORWARD_VERT_SIZE 1709
 
 #ifdef __cplusplus
 }
@@ -10,11 +10,21 @@
 
 #include <stdlib.h>
 
+#include "./r3d/details/r3d_anim_blend.c"
+#include "./r3d/details/r3d_anim_clip.c"
 #include "./r3d/details/r3d_billboard.c"
+#include "./r3d/details/r3d_bvh.c"
+#include "./r3d/details/r3d_cluster.c"
 #include "./r3d/details/r3d_drawcall.c"
 #include "./r3d/details/r3d_frustum.c"
+#include "./r3d/details/r3d_jobs.c"
 #include "./r3d/details/r3d_light.c"
+#include "./r3d/details/r3d_material.c"
 #include "./r3d/details/r3d_primitives.c"
+#include "./r3d/details/r3d_shadow_atlas.c"
+#include "./r3d/details/r3d_sort.c"
+#include "./r3d/details/r3d_stream.c"
+#include "./r3d/details/r3d_worker.c"
 #include "./r3d/r3d_core.c"
 #include "./r3d/r3d_culling.c"
 #include "./r3d/r3d_curves.c"
@@ -25,6 +35,7 @@
 #include "./r3d/r3d_skybox.c"
 #include "./r3d/r3d_sprite.c"
 #include "./r3d/r3d_state.c"
+#include "./r3d/r3d_static.c"
 #include "./r3d/r3d_utils.c"
 
 #include "texture_gen.c"
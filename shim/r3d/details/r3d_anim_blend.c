@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "./r3d_anim_blend.h"
+
+#include "./r3d_anim_clip.h"
+#include "./r3d_math.h"
+
+#include <raymath.h>
+#include <string.h>
+#include <math.h>
+
+/* === Internal functions === */
+
+static inline Vector3 r3d_anim_blend_lerp_vec3(Vector3 a, Vector3 b, float t)
+{
+    return (Vector3) {
+        a.x + (b.x - a.x) * t,
+        a.y + (b.y - a.y) * t,
+        a.z + (b.z - a.z) * t
+    };
+}
+
+static const Matrix* r3d_anim_blend_get_global(int bone, const BoneInfo* bones, const Transform* pose,
+                                               Matrix* globals, unsigned char* resolved)
+{
+    if (!resolved[bone]) {
+        const Transform* local = &pose[bone];
+        Matrix matrix = r3d_matrix_scale_rotq_translate(&local->scale, &local->rotation, &local->translation);
+        int parent = bones[bone].parent;
+        globals[bone] = (parent >= 0)
+            ? r3d_matrix_multiply(&matrix, r3d_anim_blend_get_global(parent, bones, pose, globals, resolved))
+            : matrix;
+        resolved[bone] = 1;
+    }
+    return &globals[bone];
+}
+
+static int r3d_anim_blend_get_depth(int bone, const BoneInfo* bones, unsigned char* depths)
+{
+    // NOTE: The depths are stored plus one so zero marks the unresolved bones, they saturate at 255
+    if (!depths[bone]) {
+        int parent = bones[bone].parent;
+        int depth = (parent >= 0) ? r3d_anim_blend_get_depth(parent, bones, depths) + 1 : 1;
+        depths[bone] = (unsigned char)((depth < 255) ? depth : 255);
+    }
+    return depths[bone];
+}
+
+/* === Public functions === */
+
+int r3d_anim_blend_get_scratch_count(int boneCount)
+{
+    size_t size = (size_t)boneCount * (sizeof(Matrix) + 3 * sizeof(Transform) + 2);
+    return (int)((size + sizeof(Matrix) - 1) / sizeof(Matrix));
+}
+
+void r3d_anim_blend_sample(const R3D_ModelAnimation* anim, float frame, Transform* locals)
+{
+    for (int b = 0; b < anim->boneCount; b++) {
+        locals[b] = (Transform) {
+            .translation = { 0.0f, 0.0f, 0.0f },
+            .rotation = { 0.0f, 0.0f, 0.0f, 1.0f },
+            .scale = { 1.0f, 1.0f, 1.0f }
+        };
+    }
+
+    if (anim->frameCount <= 0) {
+        return;
+    }
+
+    float time = fmodf(frame, (float)anim->frameCount);
+    if (time < 0.0f) time += (float)anim->frameCount;
+
+    if (anim->clip != NULL) {
+        r3d_anim_clip_sample_locals(anim->clip, time, locals);
+        return;
+    }
+
+    if (anim->frameLocalPoses == NULL) {
+        return;
+    }
+
+    int f0 = (int)time;
+    int f1 = (f0 + 1 < anim->frameCount) ? f0 + 1 : f0;
+    float t = time - (float)f0;
+
+    const Transform* a = anim->frameLocalPoses[f0];
+    const Transform* b = anim->frameLocalPoses[f1];
+
+    if (f0 == f1 || t <= 0.0f) {
+        memcpy(locals, a, anim->boneCount * sizeof(Transform));
+        return;
+    }
+
+    for (int i = 0; i < anim->boneCount; i++) {
+        locals[i].translation = r3d_anim_blend_lerp_vec3(a[i].translation, b[i].translation, t);
+        locals[i].rotation = r3d_quaternion_nlerp(&a[i].rotation, &b[i].rotation, t);
+        locals[i].scale = r3d_anim_blend_lerp_vec3(a[i].scale, b[i].scale, t);
+    }
+}
+
+void r3d_anim_blend_evaluate(const R3D_AnimationLayer* layers, int layerCount, int maxDepth, const Matrix* boneOffsets,
+                             Matrix* scratch, Matrix* result)
+{
+    const R3D_ModelAnimation* base = layers[0].anim;
+    int boneCount = base->boneCount;
+
+    Matrix* globals = scratch;
+    Transform* pose = (Transform*)(globals + boneCount);
+    Transform* layerPose = pose + boneCount;
+    Transform* reference = layerPose + boneCount;
+    unsigned char* resolved = (unsigned char*)(reference + boneCount);
+    unsigned char* depths = resolved + boneCount;
+
+    /* --- The first layer gives the base pose --- */
+
+    r3d_anim_blend_sample(base, layers[0].frame, pose);
+
+    /* --- Combine the other layers in order --- */
+
+    for (int l = 1; l < layerCount; l++)
+    {
+        const R3D_AnimationLayer* layer = &layers[l];
+
+        if (layer->anim == NULL || layer->anim->boneCount != boneCount || layer->weight <= 0.0f) {
+            continue;
+        }
+
+        bool additive = (layer->mode == R3D_ANIM_LAYER_ADDITIVE);
+
+        r3d_anim_blend_sample(layer->anim, layer->frame, layerPose);
+        if (additive) {
+            // NOTE: The first frame of an additive layer is its reference pose
+            r3d_anim_blend_sample(layer->anim, 0.0f, reference);
+        }
+
+        for (int b = 0; b < boneCount; b++)
+        {
+            float w = layer->weight * ((layer->boneWeights != NULL) ? layer->boneWeights[b] : 1.0f);
+            if (w <= 0.0f) continue;
+            if (w > 1.0f) w = 1.0f;
+
+            Transform* dst = &pose[b];
+            const Transform* src = &layerPose[b];
+
+            if (!additive) {
+                dst->translation = r3d_anim_blend_lerp_vec3(dst->translation, src->translation, w);
+                dst->rotation = r3d_quaternion_nlerp(&dst->rotation, &src->rotation, w);
+                dst->scale = r3d_anim_blend_lerp_vec3(dst->scale, src->scale, w);
+                continue;
+            }
+
+            const Transform* ref = &reference[b];
+            const Quaternion identity = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+            Quaternion delta = QuaternionMultiply(QuaternionInvert(ref->rotation), src->rotation);
+            delta = r3d_quaternion_nlerp(&identity, &delta, w);
+
+            dst->translation.x += (src->translation.x - ref->translation.x) * w;
+            dst->translation.y += (src->translation.y - ref->translation.y) * w;
+            dst->translation.z += (src->translation.z - ref->translation.z) * w;
+
+            dst->rotation = QuaternionMultiply(dst->rotation, delta);
+
+            dst->scale.x *= 1.0f + ((fabsf(ref->scale.x) > 1e-6f) ? src->scale.x / ref->scale.x - 1.0f : 0.0f) * w;
+            dst->scale.y *= 1.0f + ((fabsf(ref->scale.y) > 1e-6f) ? src->scale.y / ref->scale.y - 1.0f : 0.0f) * w;
+            dst->scale.z *= 1.0f + ((fabsf(ref->scale.z) > 1e-6f) ? src->scale.z / ref->scale.z - 1.0f : 0.0f) * w;
+        }
+    }
+
+    /* --- Compose the hierarchy and apply the bone offsets --- */
+
+    memset(resolved, 0, boneCount);
+
+    if (maxDepth < 0 || maxDepth >= 254) {
+        for (int b = 0; b < boneCount; b++) {
+            const Matrix* global = r3d_anim_blend_get_global(b, base->bones, pose, globals, resolved);
+            result[b] = r3d_matrix_multiply(&boneOffsets[b], global);
+        }
+        return;
+    }
+
+    // NOTE: The bones below the depth limit take the skinning matrix of their ancestor at the limit,
+    //       as if they kept their bind pose relative to it, their global transform is never composed
+
+    memset(depths, 0, boneCount);
+
+    for (int b = 0; b < boneCount; b++) {
+        int bone = b;
+        for (int depth = r3d_anim_blend_get_depth(b, base->bones, depths); depth > maxDepth + 1; depth--) {
+            bone = base->bones[bone].parent;
+        }
+        const Matrix* global = r3d_anim_blend_get_global(bone, base->bones, pose, globals, resolved);
+        result[b] = r3d_matrix_multiply(&boneOffsets[bone], global);
+    }
+}
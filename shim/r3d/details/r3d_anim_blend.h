@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef R3D_DETAILS_ANIM_BLEND_H
+#define R3D_DETAILS_ANIM_BLEND_H
+
+#include <r3d.h>
+
+/* === Functions === */
+
+// Returns the number of matrices of scratch memory needed to blend a pose of 'boneCount' bones
+int r3d_anim_blend_get_scratch_count(int boneCount);
+
+// Writes the local transforms of the bones at 'frame', relative to their parent bone
+// The frame wraps around the frame count, 'locals' has 'anim->boneCount' elements
+void r3d_anim_blend_sample(const R3D_ModelAnimation* anim, float frame, Transform* locals);
+
+// Blends the layers and writes the skinning matrices of the bones of the first layer animation
+// The layers whose animation does not have the same bone count as the first one are ignored
+// The bones deeper than 'maxDepth' follow their ancestor rigidly, a negative depth evaluates all the bones
+void r3d_anim_blend_evaluate(const R3D_AnimationLayer* layers, int layerCount, int maxDepth, const Matrix* boneOffsets,
+                             Matrix* scratch, Matrix* result);
+
+#endif // R3D_DETAILS_ANIM_BLEND_H
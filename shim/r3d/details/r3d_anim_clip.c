@@ -0,0 +1,364 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "./r3d_anim_clip.h"
+
+#include "./r3d_math.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+
+/* === Defines === */
+
+#define R3D_ANIM_CLIP_RANGE_EPSILON 1e-5f   //< Below this range a channel component is considered constant
+#define R3D_ANIM_CLIP_ROT_SCALE     32767.0f
+#define R3D_ANIM_CLIP_SQRT1_2       0.70710678f
+
+/* === Internal functions === */
+
+static void r3d_anim_clip_encode_vec3(r3d_anim_track_t* track, const Vector3* values, int count, uint16_t* words, size_t* wordCount)
+{
+    float min[3] = { values[0].x, values[0].y, values[0].z };
+    float max[3] = { values[0].x, values[0].y, values[0].z };
+
+    for (int s = 1; s < count; s++) {
+        const float v[3] = { values[s].x, values[s].y, values[s].z };
+        for (int c = 0; c < 3; c++) {
+            min[c] = fminf(min[c], v[c]);
+            max[c] = fmaxf(max[c], v[c]);
+        }
+    }
+
+    for (int c = 0; c < 3; c++) {
+        float range = max[c] - min[c];
+        if (range < R3D_ANIM_CLIP_RANGE_EPSILON) {
+            track->min[c] = 0.5f * (min[c] + max[c]);
+            track->step[c] = 0.0f;
+        }
+        else {
+            track->min[c] = min[c];
+            track->step[c] = range / 65535.0f;
+        }
+    }
+
+    uint16_t* first = words + *wordCount;
+    bool constant = true;
+
+    for (int s = 0; s < count; s++) {
+        const float v[3] = { values[s].x, values[s].y, values[s].z };
+        uint16_t* w = first + 3 * s;
+        for (int c = 0; c < 3; c++) {
+            float code = (track->step[c] > 0.0f) ? (v[c] - track->min[c]) / track->step[c] : 0.0f;
+            w[c] = (uint16_t)fminf(fmaxf(code + 0.5f, 0.0f), 65535.0f);
+        }
+        if (s > 0 && memcmp(w, first, 3 * sizeof(uint16_t)) != 0) {
+            constant = false;
+        }
+    }
+
+    track->offset = (uint32_t)*wordCount;
+    track->stride = constant ? 0 : 3;
+
+    *wordCount += constant ? 3 : 3 * (size_t)count;
+}
+
+static void r3d_anim_clip_encode_quat(r3d_anim_track_t* track, const Quaternion* values, int count, uint16_t* words, size_t* wordCount)
+{
+    // NOTE: Smallest three encoding, the largest component is dropped and rebuilt from the
+    //       unit length, the sign of the quaternion is chosen so that it is positive.
+    //       The three others are within [-1/sqrt(2), 1/sqrt(2)] and stored on 15 bits,
+    //       the index of the dropped component goes in the high bits of the first two words.
+
+    uint16_t* first = words + *wordCount;
+    bool constant = true;
+
+    for (int s = 0; s < count; s++)
+    {
+        float q[4] = { values[s].x, values[s].y, values[s].z, values[s].w };
+
+        float length = sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+        if (length < 1e-6f) {
+            q[0] = q[1] = q[2] = 0.0f;
+            q[3] = length = 1.0f;
+        }
+
+        int largest = 0;
+        for (int c = 1; c < 4; c++) {
+            if (fabsf(q[c]) > fabsf(q[largest])) largest = c;
+        }
+
+        float scale = (q[largest] < 0.0f ? -1.0f : 1.0f) / length;
+
+        uint16_t* w = first + 3 * s;
+        for (int c = 0, j = 0; c < 4; c++) {
+            if (c == largest) continue;
+            float v = q[c] * scale / R3D_ANIM_CLIP_SQRT1_2;
+            float code = (0.5f * v + 0.5f) * R3D_ANIM_CLIP_ROT_SCALE;
+            w[j++] = (uint16_t)fminf(fmaxf(code + 0.5f, 0.0f), R3D_ANIM_CLIP_ROT_SCALE);
+        }
+
+        w[0] |= (uint16_t)((largest & 1) << 15);
+        w[1] |= (uint16_t)((largest >> 1) << 15);
+
+        if (s > 0 && memcmp(w, first, 3 * sizeof(uint16_t)) != 0) {
+            constant = false;
+        }
+    }
+
+    memset(track->min, 0, sizeof(track->min));
+    memset(track->step, 0, sizeof(track->step));
+
+    track->offset = (uint32_t)*wordCount;
+    track->stride = constant ? 0 : 3;
+
+    *wordCount += constant ? 3 : 3 * (size_t)count;
+}
+
+static inline Vector4 r3d_anim_clip_decode_vec3(const r3d_anim_track_t* track, const uint16_t* w)
+{
+    return (Vector4) {
+        track->min[0] + (float)w[0] * track->step[0],
+        track->min[1] + (float)w[1] * track->step[1],
+        track->min[2] + (float)w[2] * track->step[2],
+        0.0f
+    };
+}
+
+static inline Vector4 r3d_anim_clip_decode_quat(const uint16_t* w)
+{
+    int largest = (w[0] >> 15) | ((w[1] >> 15) << 1);
+
+    float q[4];
+    float sum = 0.0f;
+
+    for (int c = 0, j = 0; c < 4; c++) {
+        if (c == largest) continue;
+        float v = ((float)(w[j++] & 0x7FFF) * (2.0f / R3D_ANIM_CLIP_ROT_SCALE) - 1.0f) * R3D_ANIM_CLIP_SQRT1_2;
+        sum += v * v;
+        q[c] = v;
+    }
+
+    q[largest] = sqrtf(fmaxf(0.0f, 1.0f - sum));
+
+    return (Vector4) { q[0], q[1], q[2], q[3] };
+}
+
+static inline Vector4 r3d_anim_clip_sample_vec3(const r3d_anim_clip_t* clip, const r3d_anim_track_t* track, int s0, int s1, float t)
+{
+    const uint16_t* base = clip->words + track->offset;
+    Vector4 a = r3d_anim_clip_decode_vec3(track, base + s0 * track->stride);
+
+    if (track->stride == 0 || t <= 0.0f) {
+        return a;
+    }
+
+    Vector4 b = r3d_anim_clip_decode_vec3(track, base + s1 * track->stride);
+
+    return r3d_vector4_lerp(&a, &b, t);
+}
+
+static inline Vector4 r3d_anim_clip_sample_quat(const r3d_anim_clip_t* clip, const r3d_anim_track_t* track, int s0, int s1, float t)
+{
+    const uint16_t* base = clip->words + track->offset;
+    Vector4 a = r3d_anim_clip_decode_quat(base + s0 * track->stride);
+
+    if (track->stride == 0 || t <= 0.0f) {
+        return a;
+    }
+
+    Vector4 b = r3d_anim_clip_decode_quat(base + s1 * track->stride);
+
+    // NOTE: The samples are stored with a positive largest component, so two
+    //       consecutive samples can be in opposite hemispheres
+    return r3d_quaternion_nlerp(&a, &b, t);
+}
+
+/* === Public functions === */
+
+r3d_anim_clip_t* r3d_anim_clip_create(const int* parents, const int* bones, int nodeCount, int boneCount,
+                                      const Transform* locals, int sampleCount)
+{
+    if (nodeCount <= 0 || sampleCount <= 0) {
+        return NULL;
+    }
+
+    r3d_anim_clip_t* clip = calloc(1, sizeof(r3d_anim_clip_t));
+    if (clip == NULL) {
+        return NULL;
+    }
+
+    // NOTE: The words are allocated for the worst case where every track is animated,
+    //       the buffer is then shrunk to the size actually used.
+
+    size_t capacity = (size_t)nodeCount * 9 * sampleCount;
+
+    clip->nodes = malloc(nodeCount * sizeof(r3d_anim_node_t));
+    clip->words = malloc(capacity * sizeof(uint16_t));
+
+    Vector3* vectors = malloc(sampleCount * sizeof(Vector3));
+    Quaternion* rotations = malloc(sampleCount * sizeof(Quaternion));
+
+    if (!clip->nodes || !clip->words || !vectors || !rotations) {
+        free(vectors);
+        free(rotations);
+        r3d_anim_clip_destroy(clip);
+        return NULL;
+    }
+
+    clip->nodeCount = nodeCount;
+    clip->boneCount = boneCount;
+    clip->sampleCount = sampleCount;
+
+    for (int n = 0; n < nodeCount; n++)
+    {
+        r3d_anim_node_t* node = &clip->nodes[n];
+
+        node->parent = parents[n];
+        node->bone = bones[n];
+        node->parentBone = -1;
+        node->depth = 0;
+
+        if (node->parent >= 0) {
+            const r3d_anim_node_t* parent = &clip->nodes[node->parent];
+            node->parentBone = (parent->bone >= 0) ? parent->bone : parent->parentBone;
+            node->depth = parent->depth + (parent->bone >= 0);
+        }
+
+        if (node->bone >= 0) {
+            clip->mappedBones++;
+        }
+
+        for (int s = 0; s < sampleCount; s++) {
+            vectors[s] = locals[s * nodeCount + n].translation;
+        }
+        r3d_anim_clip_encode_vec3(&node->translation, vectors, sampleCount, clip->words, &clip->wordCount);
+
+        for (int s = 0; s < sampleCount; s++) {
+            rotations[s] = locals[s * nodeCount + n].rotation;
+        }
+        r3d_anim_clip_encode_quat(&node->rotation, rotations, sampleCount, clip->words, &clip->wordCount);
+
+        for (int s = 0; s < sampleCount; s++) {
+            vectors[s] = locals[s * nodeCount + n].scale;
+        }
+        r3d_anim_clip_encode_vec3(&node->scale, vectors, sampleCount, clip->words, &clip->wordCount);
+    }
+
+    free(vectors);
+    free(rotations);
+
+    uint16_t* words = realloc(clip->words, clip->wordCount * sizeof(uint16_t));
+    if (words != NULL) clip->words = words;
+
+    return clip;
+}
+
+void r3d_anim_clip_destroy(r3d_anim_clip_t* clip)
+{
+    if (clip == NULL) return;
+
+    free(clip->nodes);
+    free(clip->words);
+    free(clip);
+}
+
+size_t r3d_anim_clip_get_size(const r3d_anim_clip_t* clip)
+{
+    return sizeof(r3d_anim_clip_t)
+        + clip->nodeCount * sizeof(r3d_anim_node_t)
+        + clip->wordCount * sizeof(uint16_t);
+}
+
+void r3d_anim_clip_sample_locals(const r3d_anim_clip_t* clip, float time, Transform* locals)
+{
+    int last = clip->sampleCount - 1;
+
+    time = fminf(fmaxf(time, 0.0f), (float)last);
+
+    int s0 = (int)time;
+    int s1 = (s0 < last) ? s0 + 1 : last;
+    float t = time - (float)s0;
+
+    for (int n = 0; n < clip->nodeCount; n++)
+    {
+        const r3d_anim_node_t* node = &clip->nodes[n];
+        if (node->bone < 0) continue;
+
+        Vector4 translation = r3d_anim_clip_sample_vec3(clip, &node->translation, s0, s1, t);
+        Vector4 rotation = r3d_anim_clip_sample_quat(clip, &node->rotation, s0, s1, t);
+        Vector4 scale = r3d_anim_clip_sample_vec3(clip, &node->scale, s0, s1, t);
+
+        locals[node->bone] = (Transform) {
+            .translation = { translation.x, translation.y, translation.z },
+            .rotation = rotation,
+            .scale = { scale.x, scale.y, scale.z }
+        };
+    }
+}
+
+void r3d_anim_clip_evaluate(const r3d_anim_clip_t* clip, float time, int maxDepth, const Matrix* boneOffsets,
+                            Matrix* nodeGlobals, Matrix* result)
+{
+    /* --- Find the two samples surrounding the time --- */
+
+    int last = clip->sampleCount - 1;
+
+    time = fminf(fmaxf(time, 0.0f), (float)last);
+
+    int s0 = (int)time;
+    int s1 = (s0 < last) ? s0 + 1 : last;
+    float t = time - (float)s0;
+
+    /* --- The bones without node keep their bind pose, as with the baked poses --- */
+
+    if (clip->mappedBones < clip->boneCount) {
+        memcpy(result, boneOffsets, clip->boneCount * sizeof(Matrix));
+    }
+
+    /* --- Evaluate the nodes in hierarchy order --- */
+
+    for (int n = 0; n < clip->nodeCount; n++)
+    {
+        const r3d_anim_node_t* node = &clip->nodes[n];
+
+        // NOTE: A bone keeping its bind pose relative to its ancestor has the same skinning matrix,
+        //       the nodes below the depth limit are not sampled. Their descendants are deeper too,
+        //       so their global transform is never needed.
+        if (maxDepth >= 0 && node->depth > maxDepth) {
+            if (node->bone >= 0) result[node->bone] = result[node->parentBone];
+            continue;
+        }
+
+        Vector4 translation = r3d_anim_clip_sample_vec3(clip, &node->translation, s0, s1, t);
+        Vector4 rotation = r3d_anim_clip_sample_quat(clip, &node->rotation, s0, s1, t);
+        Vector4 scale = r3d_anim_clip_sample_vec3(clip, &node->scale, s0, s1, t);
+
+        Matrix local = r3d_matrix_scale_rotq_translate((Vector3*)&scale, &rotation, (Vector3*)&translation);
+
+        nodeGlobals[n] = (node->parent >= 0)
+            ? r3d_matrix_multiply(&local, &nodeGlobals[node->parent])
+            : local;
+
+        if (node->bone >= 0) {
+            result[node->bone] = r3d_matrix_multiply(&boneOffsets[node->bone], &nodeGlobals[n]);
+        }
+    }
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef R3D_DETAILS_ANIM_CLIP_H
+#define R3D_DETAILS_ANIM_CLIP_H
+
+#include <raylib.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* === Types === */
+
+/*
+ * Quantized samples of one TRS channel of a node. A sample is made of three 16-bit words,
+ * translations and scales are stored relative to the range of the track, rotations use the
+ * smallest three encoding. A track whose samples are all identical only stores one sample.
+ */
+typedef struct {
+    float min[3];           //< Value of the code 0, unused by the rotations
+    float step[3];          //< Value of one code unit, unused by the rotations
+    uint32_t offset;        //< Offset of the first sample in the clip words
+    uint32_t stride;        //< Words between two samples, 0 for a constant track
+} r3d_anim_track_t;
+
+typedef struct {
+    int parent;                     //< Index of the parent node, always lower than the node index, -1 for the root
+    int bone;                       //< Index of the bone animated by the node, -1 if the node is only an ancestor of bones
+    int parentBone;                 //< Bone of the nearest ancestor node animating a bone, -1 if there is none
+    int depth;                      //< Number of ancestor nodes animating a bone
+    r3d_anim_track_t translation;
+    r3d_anim_track_t rotation;
+    r3d_anim_track_t scale;
+} r3d_anim_node_t;
+
+/*
+ * Compressed animation clip, replaces the baked poses of an animation.
+ * The nodes are stored in hierarchy order and their local transforms are
+ * sampled at a fixed rate. The poses are evaluated on demand at any time
+ * between two samples.
+ */
+typedef struct r3d_anim_clip {
+    r3d_anim_node_t* nodes;
+    uint16_t* words;                //< Quantized samples of all the tracks
+    size_t wordCount;
+    int nodeCount;
+    int boneCount;
+    int sampleCount;
+    int mappedBones;                //< Number of bones animated by a node, the others keep their bind pose
+} r3d_anim_clip_t;
+
+/* === Functions === */
+
+// Builds a clip from the local transforms of the nodes, 'locals' is a [sample][node] array
+// Each parent must precede its children, returns NULL on failure
+r3d_anim_clip_t* r3d_anim_clip_create(const int* parents, const int* bones, int nodeCount, int boneCount,
+                                      const Transform* locals, int sampleCount);
+
+void r3d_anim_clip_destroy(r3d_anim_clip_t* clip);
+
+// Returns the memory used by the clip in bytes
+size_t r3d_anim_clip_get_size(const r3d_anim_clip_t* clip);
+
+// Writes the local transforms of the animated bones at 'time', relative to their parent bone
+// 'locals' has 'boneCount' elements, the bones without node are left untouched
+void r3d_anim_clip_sample_locals(const r3d_anim_clip_t* clip, float time, Transform* locals);
+
+// Writes the skinning matrices of the pose at 'time' (in samples, clamped to the clip)
+// 'nodeGlobals' is a scratch array of 'nodeCount' matrices, 'result' receives 'boneCount' matrices
+// The bones deeper than 'maxDepth' follow their ancestor rigidly, a negative depth evaluates all the bones
+void r3d_anim_clip_evaluate(const r3d_anim_clip_t* clip, float time, int maxDepth, const Matrix* boneOffsets,
+                            Matrix* nodeGlobals, Matrix* result);
+
+#endif // R3D_DETAILS_ANIM_CLIP_H
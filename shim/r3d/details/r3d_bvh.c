@@ -0,0 +1,490 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "./r3d_bvh.h"
+
+#include <raymath.h>
+
+/* === Internal functions === */
+
+static inline float r3d_bvh_aabb_area(const BoundingBox* aabb)
+{
+    float dx = aabb->max.x - aabb->min.x;
+    float dy = aabb->max.y - aabb->min.y;
+    float dz = aabb->max.z - aabb->min.z;
+
+    // Half of the surface area, only used to compare costs
+    return dx * dy + dy * dz + dz * dx;
+}
+
+static inline BoundingBox r3d_bvh_aabb_union(const BoundingBox* a, const BoundingBox* b)
+{
+    return (BoundingBox) {
+        .min = { fminf(a->min.x, b->min.x), fminf(a->min.y, b->min.y), fminf(a->min.z, b->min.z) },
+        .max = { fmaxf(a->max.x, b->max.x), fmaxf(a->max.y, b->max.y), fmaxf(a->max.z, b->max.z) }
+    };
+}
+
+static inline bool r3d_bvh_aabb_contains(const BoundingBox* outer, const BoundingBox* inner)
+{
+    return
+        outer->min.x <= inner->min.x && outer->min.y <= inner->min.y && outer->min.z <= inner->min.z &&
+        outer->max.x >= inner->max.x && outer->max.y >= inner->max.y && outer->max.z >= inner->max.z;
+}
+
+static inline BoundingBox r3d_bvh_aabb_enlarge(const BoundingBox* aabb)
+{
+    Vector3 margin = { R3D_BVH_AABB_MARGIN, R3D_BVH_AABB_MARGIN, R3D_BVH_AABB_MARGIN };
+    return (BoundingBox) {
+        .min = Vector3Subtract(aabb->min, margin),
+        .max = Vector3Add(aabb->max, margin)
+    };
+}
+
+static bool r3d_bvh_ensure_capacity(r3d_bvh_t* bvh, int nodeCount)
+{
+    // NOTE: Allocating ahead of time guarantees that no reallocation
+    //       happens while pointers to the nodes are held during an insertion.
+    //       The free list is ignored here, which can only over-allocate.
+
+    size_t required = bvh->nodes.count + nodeCount;
+    if (required <= bvh->nodes.capacity) {
+        return true;
+    }
+
+    size_t capacity = (bvh->nodes.capacity > 0) ? bvh->nodes.capacity : 16;
+    while (capacity < required) {
+        capacity *= 2;
+    }
+
+    return r3d_array_reserve(&bvh->nodes, capacity) == R3D_ARRAY_SUCCESS;
+}
+
+static int r3d_bvh_alloc_node(r3d_bvh_t* bvh)
+{
+    int index = bvh->freeList;
+
+    if (index != R3D_BVH_NULL_NODE) {
+        bvh->freeList = ((r3d_bvh_node_t*)bvh->nodes.data)[index].parent;
+    }
+    else {
+        r3d_array_push_back(&bvh->nodes, NULL);
+        index = (int)bvh->nodes.count - 1;
+    }
+
+    r3d_bvh_node_t* node = (r3d_bvh_node_t*)bvh->nodes.data + index;
+
+    node->parent = R3D_BVH_NULL_NODE;
+    node->child1 = R3D_BVH_NULL_NODE;
+    node->child2 = R3D_BVH_NULL_NODE;
+    node->height = 0;
+    node->userID = 0;
+
+    return index;
+}
+
+static void r3d_bvh_free_node(r3d_bvh_t* bvh, int index)
+{
+    r3d_bvh_node_t* node = (r3d_bvh_node_t*)bvh->nodes.data + index;
+
+    node->parent = bvh->freeList;
+    node->height = -1;
+
+    bvh->freeList = index;
+}
+
+static int r3d_bvh_balance(r3d_bvh_t* bvh, int iA)
+{
+    r3d_bvh_node_t* nodes = bvh->nodes.data;
+    r3d_bvh_node_t* A = &nodes[iA];
+
+    if (A->child1 == R3D_BVH_NULL_NODE || A->height < 2) {
+        return iA;
+    }
+
+    int iB = A->child1;
+    int iC = A->child2;
+    r3d_bvh_node_t* B = &nodes[iB];
+    r3d_bvh_node_t* C = &nodes[iC];
+
+    int balance = C->height - B->height;
+
+    /* --- Rotate C up --- */
+
+    if (balance > 1)
+    {
+        int iF = C->child1;
+        int iG = C->child2;
+        r3d_bvh_node_t* F = &nodes[iF];
+        r3d_bvh_node_t* G = &nodes[iG];
+
+        // Swap A and C
+        C->child1 = iA;
+        C->parent = A->parent;
+        A->parent = iC;
+
+        // The old parent of A must now point to C
+        if (C->parent != R3D_BVH_NULL_NODE) {
+            if (nodes[C->parent].child1 == iA) nodes[C->parent].child1 = iC;
+            else nodes[C->parent].child2 = iC;
+        }
+        else {
+            bvh->root = iC;
+        }
+
+        // Keep the highest grandchild under C
+        if (F->height > G->height) {
+            C->child2 = iF;
+            A->child2 = iG;
+            G->parent = iA;
+            A->aabb = r3d_bvh_aabb_union(&B->aabb, &G->aabb);
+            C->aabb = r3d_bvh_aabb_union(&A->aabb, &F->aabb);
+            A->height = 1 + ((B->height > G->height) ? B->height : G->height);
+            C->height = 1 + ((A->height > F->height) ? A->height : F->height);
+        }
+        else {
+            C->child2 = iG;
+            A->child2 = iF;
+            F->parent = iA;
+            A->aabb = r3d_bvh_aabb_union(&B->aabb, &F->aabb);
+            C->aabb = r3d_bvh_aabb_union(&A->aabb, &G->aabb);
+            A->height = 1 + ((B->height > F->height) ? B->height : F->height);
+            C->height = 1 + ((A->height > G->height) ? A->height : G->height);
+        }
+
+        return iC;
+    }
+
+    /* --- Rotate B up --- */
+
+    if (balance < -1)
+    {
+        int iD = B->child1;
+        int iE = B->child2;
+        r3d_bvh_node_t* D = &nodes[iD];
+        r3d_bvh_node_t* E = &nodes[iE];
+
+        // Swap A and B
+        B->child1 = iA;
+        B->parent = A->parent;
+        A->parent = iB;
+
+        // The old parent of A must now point to B
+        if (B->parent != R3D_BVH_NULL_NODE) {
+            if (nodes[B->parent].child1 == iA) nodes[B->parent].child1 = iB;
+            else nodes[B->parent].child2 = iB;
+        }
+        else {
+            bvh->root = iB;
+        }
+
+        // Keep the highest grandchild under B
+        if (D->height > E->height) {
+            B->child2 = iD;
+            A->child1 = iE;
+            E->parent = iA;
+            A->aabb = r3d_bvh_aabb_union(&C->aabb, &E->aabb);
+            B->aabb = r3d_bvh_aabb_union(&A->aabb, &D->aabb);
+            A->height = 1 + ((C->height > E->height) ? C->height : E->height);
+            B->height = 1 + ((A->height > D->height) ? A->height : D->height);
+        }
+        else {
+            B->child2 = iE;
+            A->child1 = iD;
+            D->parent = iA;
+            A->aabb = r3d_bvh_aabb_union(&C->aabb, &D->aabb);
+            B->aabb = r3d_bvh_aabb_union(&A->aabb, &E->aabb);
+            A->height = 1 + ((C->height > D->height) ? C->height : D->height);
+            B->height = 1 + ((A->height > E->height) ? A->height : E->height);
+        }
+
+        return iB;
+    }
+
+    return iA;
+}
+
+static void r3d_bvh_refit(r3d_bvh_t* bvh, int index)
+{
+    // Walks back up to the root, fixing the heights and boxes and balancing on the way
+    while (index != R3D_BVH_NULL_NODE)
+    {
+        index = r3d_bvh_balance(bvh, index);
+
+        r3d_bvh_node_t* nodes = bvh->nodes.data;
+        r3d_bvh_node_t* node = &nodes[index];
+        const r3d_bvh_node_t* child1 = &nodes[node->child1];
+        const r3d_bvh_node_t* child2 = &nodes[node->child2];
+
+        node->height = 1 + ((child1->height > child2->height) ? child1->height : child2->height);
+        node->aabb = r3d_bvh_aabb_union(&child1->aabb, &child2->aabb);
+
+        index = node->parent;
+    }
+}
+
+static void r3d_bvh_insert_leaf(r3d_bvh_t* bvh, int leaf)
+{
+    if (bvh->root == R3D_BVH_NULL_NODE) {
+        ((r3d_bvh_node_t*)bvh->nodes.data)[leaf].parent = R3D_BVH_NULL_NODE;
+        bvh->root = leaf;
+        return;
+    }
+
+    /* --- Find the best sibling using the surface area heuristic --- */
+
+    r3d_bvh_node_t* nodes = bvh->nodes.data;
+    BoundingBox leafAabb = nodes[leaf].aabb;
+
+    int index = bvh->root;
+
+    while (nodes[index].child1 != R3D_BVH_NULL_NODE)
+    {
+        const r3d_bvh_node_t* node = &nodes[index];
+
+        float area = r3d_bvh_aabb_area(&node->aabb);
+        BoundingBox combined = r3d_bvh_aabb_union(&node->aabb, &leafAabb);
+        float combinedArea = r3d_bvh_aabb_area(&combined);
+
+        // Cost of creating a new parent for this node and the new leaf
+        float cost = 2.0f * combinedArea;
+
+        // Minimum cost of pushing the leaf further down the tree
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        float childCosts[2];
+        int children[2] = { node->child1, node->child2 };
+
+        for (int i = 0; i < 2; i++) {
+            const r3d_bvh_node_t* child = &nodes[children[i]];
+            BoundingBox childCombined = r3d_bvh_aabb_union(&child->aabb, &leafAabb);
+            childCosts[i] = r3d_bvh_aabb_area(&childCombined) + inheritanceCost;
+            if (child->child1 != R3D_BVH_NULL_NODE) {
+                childCosts[i] -= r3d_bvh_aabb_area(&child->aabb);
+            }
+        }
+
+        // Descend according to the minimum cost
+        if (cost < childCosts[0] && cost < childCosts[1]) {
+            break;
+        }
+
+        index = (childCosts[0] < childCosts[1]) ? children[0] : children[1];
+    }
+
+    int sibling = index;
+
+    /* --- Create a new parent for the sibling and the leaf --- */
+
+    int newParent = r3d_bvh_alloc_node(bvh);
+    nodes = bvh->nodes.data;
+
+    int oldParent = nodes[sibling].parent;
+
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].aabb = r3d_bvh_aabb_union(&leafAabb, &nodes[sibling].aabb);
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].child1 = sibling;
+    nodes[newParent].child2 = leaf;
+
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    if (oldParent != R3D_BVH_NULL_NODE) {
+        if (nodes[oldParent].child1 == sibling) nodes[oldParent].child1 = newParent;
+        else nodes[oldParent].child2 = newParent;
+    }
+    else {
+        bvh->root = newParent;
+    }
+
+    /* --- Update the ancestors --- */
+
+    r3d_bvh_refit(bvh, nodes[leaf].parent);
+}
+
+static void r3d_bvh_remove_leaf(r3d_bvh_t* bvh, int leaf)
+{
+    if (leaf == bvh->root) {
+        bvh->root = R3D_BVH_NULL_NODE;
+        return;
+    }
+
+    r3d_bvh_node_t* nodes = bvh->nodes.data;
+
+    int parent = nodes[leaf].parent;
+    int grandParent = nodes[parent].parent;
+    int sibling = (nodes[parent].child1 == leaf) ? nodes[parent].child2 : nodes[parent].child1;
+
+    // The sibling takes the place of the parent
+    if (grandParent != R3D_BVH_NULL_NODE) {
+        if (nodes[grandParent].child1 == parent) nodes[grandParent].child1 = sibling;
+        else nodes[grandParent].child2 = sibling;
+        nodes[sibling].parent = grandParent;
+        r3d_bvh_free_node(bvh, parent);
+        r3d_bvh_refit(bvh, grandParent);
+    }
+    else {
+        bvh->root = sibling;
+        nodes[sibling].parent = R3D_BVH_NULL_NODE;
+        r3d_bvh_free_node(bvh, parent);
+    }
+}
+
+/* === Public functions === */
+
+r3d_bvh_t r3d_bvh_create(int capacity)
+{
+    r3d_bvh_t bvh = { 0 };
+
+    // NOTE: An array created with a null capacity doesn't keep its element size
+    if (capacity < 1) capacity = 1;
+
+    bvh.nodes = r3d_array_create(capacity, sizeof(r3d_bvh_node_t));
+    bvh.root = R3D_BVH_NULL_NODE;
+    bvh.freeList = R3D_BVH_NULL_NODE;
+    bvh.leafCount = 0;
+
+    return bvh;
+}
+
+void r3d_bvh_destroy(r3d_bvh_t* bvh)
+{
+    r3d_array_destroy(&bvh->nodes);
+
+    bvh->root = R3D_BVH_NULL_NODE;
+    bvh->freeList = R3D_BVH_NULL_NODE;
+    bvh->leafCount = 0;
+}
+
+void r3d_bvh_clear(r3d_bvh_t* bvh)
+{
+    r3d_array_clear(&bvh->nodes);
+
+    bvh->root = R3D_BVH_NULL_NODE;
+    bvh->freeList = R3D_BVH_NULL_NODE;
+    bvh->leafCount = 0;
+}
+
+int r3d_bvh_insert(r3d_bvh_t* bvh, const BoundingBox* aabb, unsigned int userID)
+{
+    // One node for the leaf and one for its new parent
+    if (!r3d_bvh_ensure_capacity(bvh, 2)) {
+        return R3D_BVH_NULL_NODE;
+    }
+
+    int proxy = r3d_bvh_alloc_node(bvh);
+
+    r3d_bvh_node_t* node = (r3d_bvh_node_t*)bvh->nodes.data + proxy;
+    node->aabb = r3d_bvh_aabb_enlarge(aabb);
+    node->userID = userID;
+    node->height = 0;
+
+    r3d_bvh_insert_leaf(bvh, proxy);
+    bvh->leafCount++;
+
+    return proxy;
+}
+
+void r3d_bvh_remove(r3d_bvh_t* bvh, int proxy)
+{
+    if (proxy < 0 || proxy >= (int)bvh->nodes.count || ((r3d_bvh_node_t*)bvh->nodes.data)[proxy].height != 0) {
+        return;
+    }
+
+    r3d_bvh_remove_leaf(bvh, proxy);
+    r3d_bvh_free_node(bvh, proxy);
+
+    bvh->leafCount--;
+}
+
+bool r3d_bvh_move(r3d_bvh_t* bvh, int proxy, const BoundingBox* aabb)
+{
+    if (proxy < 0 || proxy >= (int)bvh->nodes.count || ((r3d_bvh_node_t*)bvh->nodes.data)[proxy].height != 0) {
+        return false;
+    }
+
+    r3d_bvh_node_t* node = (r3d_bvh_node_t*)bvh->nodes.data + proxy;
+
+    if (r3d_bvh_aabb_contains(&node->aabb, aabb)) {
+        return false;
+    }
+
+    // NOTE: The removal frees the old parent of the leaf, which is
+    //       reused by the insertion, so the pool never grows here.
+
+    r3d_bvh_remove_leaf(bvh, proxy);
+
+    node = (r3d_bvh_node_t*)bvh->nodes.data + proxy;
+    node->aabb = r3d_bvh_aabb_enlarge(aabb);
+
+    r3d_bvh_insert_leaf(bvh, proxy);
+
+    return true;
+}
+
+void r3d_bvh_query_frustum(const r3d_bvh_t* bvh, const r3d_frustum_t* frustum, r3d_array_t* results)
+{
+    if (bvh->root == R3D_BVH_NULL_NODE) {
+        return;
+    }
+
+    const r3d_bvh_node_t* nodes = bvh->nodes.data;
+
+    // Nodes entirely inside the frustum are flagged, their subtree is collected without further tests
+    struct { int index; bool inside; } stack[R3D_BVH_STACK_SIZE];
+    int top = 0;
+
+    stack[top].index = bvh->root;
+    stack[top].inside = (frustum == NULL);
+    top++;
+
+    while (top > 0)
+    {
+        top--;
+        int index = stack[top].index;
+        bool inside = stack[top].inside;
+
+        const r3d_bvh_node_t* node = &nodes[index];
+
+        if (!inside) {
+            r3d_frustum_test_e test = r3d_frustum_classify_aabb(frustum, &node->aabb);
+            if (test == R3D_FRUSTUM_OUTSIDE) continue;
+            inside = (test == R3D_FRUSTUM_INSIDE);
+        }
+
+        if (node->child1 == R3D_BVH_NULL_NODE) {
+            r3d_array_push_back(results, &node->userID);
+            continue;
+        }
+
+        if (top + 2 > R3D_BVH_STACK_SIZE) {
+            TraceLog(LOG_WARNING, "R3D: BVH traversal stack overflow, some objects will be skipped");
+            continue;
+        }
+
+        stack[top].index = node->child1;
+        stack[top].inside = inside;
+        top++;
+
+        stack[top].index = node->child2;
+        stack[top].inside = inside;
+        top++;
+    }
+}
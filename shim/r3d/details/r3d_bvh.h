@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef R3D_DETAILS_BVH_H
+#define R3D_DETAILS_BVH_H
+
+#include "./r3d_frustum.h"
+#include "./containers/r3d_array.h"
+
+#include <raylib.h>
+
+/* === Defines === */
+
+#define R3D_BVH_NULL_NODE       (-1)
+#define R3D_BVH_AABB_MARGIN     0.1f    //< Enlargement of the leaves, small moves don't need to update the tree
+#define R3D_BVH_STACK_SIZE      256     //< Traversal stack, far above the height of a balanced tree
+
+/* === Types === */
+
+typedef struct {
+    BoundingBox aabb;           //< Enlarged box for the leaves, union of the children for the others
+    int parent;                 //< Parent node, or next free node when the node is unused
+    int child1;                 //< R3D_BVH_NULL_NODE for the leaves
+    int child2;                 //< R3D_BVH_NULL_NODE for the leaves
+    int height;                 //< 0 for the leaves, -1 for the unused nodes
+    unsigned int userID;        //< Object stored in the leaf
+} r3d_bvh_node_t;
+
+/*
+ * Dynamic AABB tree, the leaves are inserted and removed incrementally
+ * and the tree is kept balanced with rotations, so the cost of a query
+ * depends on the number of visible leaves rather than on the total count.
+ */
+typedef struct {
+    r3d_array_t nodes;          //< Pool of r3d_bvh_node_t, nodes are referenced by index
+    int root;
+    int freeList;
+    int leafCount;
+} r3d_bvh_t;
+
+/* === Functions === */
+
+r3d_bvh_t r3d_bvh_create(int capacity);
+void r3d_bvh_destroy(r3d_bvh_t* bvh);
+void r3d_bvh_clear(r3d_bvh_t* bvh);
+
+// Returns the leaf (proxy) of the inserted object, or R3D_BVH_NULL_NODE if the node pool could not grow
+int r3d_bvh_insert(r3d_bvh_t* bvh, const BoundingBox* aabb, unsigned int userID);
+void r3d_bvh_remove(r3d_bvh_t* bvh, int proxy);
+
+// Reinserts the leaf only if the new box leaves its enlarged box, returns true in that case
+bool r3d_bvh_move(r3d_bvh_t* bvh, int proxy, const BoundingBox* aabb);
+
+// Appends to 'results' (array of unsigned int) the userID of the leaves intersecting the frustum
+// A NULL frustum returns all the leaves of the tree
+void r3d_bvh_query_frustum(const r3d_bvh_t* bvh, const r3d_frustum_t* frustum, r3d_array_t* results);
+
+#endif // R3D_DETAILS_BVH_H
@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "./r3d_cluster.h"
+#include "./r3d_simd.h"
+
+#include <raymath.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+
+/* === Defines === */
+
+#define R3D_CLUSTER_BOX_PADDING 8   //< The SIMD loads of the last row can read up to 7 boxes past the end
+
+/* === Internal functions === */
+
+static inline int r3d_cluster_get_slice(const r3d_cluster_grid_t* grid, float depth)
+{
+    int slice = (int)floorf(logf(depth) * grid->sliceScale + grid->sliceBias);
+    return (slice < 0) ? 0 : (slice >= R3D_CLUSTER_COUNT_Z) ? R3D_CLUSTER_COUNT_Z - 1 : slice;
+}
+
+static inline int r3d_cluster_get_tile(float ndc, int count)
+{
+    int tile = (int)floorf((ndc * 0.5f + 0.5f) * count);
+    return (tile < 0) ? 0 : (tile >= count) ? count - 1 : tile;
+}
+
+static inline Vector3 r3d_cluster_unproject(const Matrix* invProj, float x, float y, float z)
+{
+    float w = invProj->m3 * x + invProj->m7 * y + invProj->m11 * z + invProj->m15;
+
+    return (Vector3) {
+        (invProj->m0 * x + invProj->m4 * y + invProj->m8 * z + invProj->m12) / w,
+        (invProj->m1 * x + invProj->m5 * y + invProj->m9 * z + invProj->m13) / w,
+        (invProj->m2 * x + invProj->m6 * y + invProj->m10 * z + invProj->m14) / w
+    };
+}
+
+static inline Vector3 r3d_cluster_point_at_depth(Vector3 nearPoint, Vector3 farPoint, float depth)
+{
+    float t = (depth + nearPoint.z) / (nearPoint.z - farPoint.z);
+    return Vector3Lerp(nearPoint, farPoint, t);
+}
+
+// Tests the 'count' boxes starting at 'first' against the sphere, bit i is set when the box 'first + i' is touched
+// NOTE: 'count' must not exceed 16, the arrays are read up to 7 boxes past the last one
+static uint32_t r3d_cluster_test_sphere(const r3d_aabb_soa_t* boxes, int first, int count, Vector3 center, float radius)
+{
+    uint32_t bits = 0;
+
+#if defined(R3D_HAS_AVX)
+
+    __m256 sx = _mm256_set1_ps(center.x);
+    __m256 sy = _mm256_set1_ps(center.y);
+    __m256 sz = _mm256_set1_ps(center.z);
+    __m256 radiusSq = _mm256_set1_ps(radius * radius);
+    __m256 signMask = _mm256_set1_ps(-0.0f);
+    __m256 zero = _mm256_setzero_ps();
+
+    for (int j = 0; j < count; j += 8)
+    {
+        int i = first + j;
+
+        // Distance from the sphere center to the box along each axis, zero inside the box
+        __m256 dx = _mm256_max_ps(_mm256_sub_ps(_mm256_andnot_ps(signMask, _mm256_sub_ps(sx, _mm256_loadu_ps(&boxes->centerX[i]))), _mm256_loadu_ps(&boxes->extentX[i])), zero);
+        __m256 dy = _mm256_max_ps(_mm256_sub_ps(_mm256_andnot_ps(signMask, _mm256_sub_ps(sy, _mm256_loadu_ps(&boxes->centerY[i]))), _mm256_loadu_ps(&boxes->extentY[i])), zero);
+        __m256 dz = _mm256_max_ps(_mm256_sub_ps(_mm256_andnot_ps(signMask, _mm256_sub_ps(sz, _mm256_loadu_ps(&boxes->centerZ[i]))), _mm256_loadu_ps(&boxes->extentZ[i])), zero);
+
+        __m256 distanceSq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+        bits |= (uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(distanceSq, radiusSq, _CMP_LE_OQ)) << j;
+    }
+
+#elif defined(R3D_HAS_SSE)
+
+    __m128 sx = _mm_set1_ps(center.x);
+    __m128 sy = _mm_set1_ps(center.y);
+    __m128 sz = _mm_set1_ps(center.z);
+    __m128 radiusSq = _mm_set1_ps(radius * radius);
+    __m128 signMask = _mm_set1_ps(-0.0f);
+    __m128 zero = _mm_setzero_ps();
+
+    for (int j = 0; j < count; j += 4)
+    {
+        int i = first + j;
+
+        // Distance from the sphere center to the box along each axis, zero inside the box
+        __m128 dx = _mm_max_ps(_mm_sub_ps(_mm_andnot_ps(signMask, _mm_sub_ps(sx, _mm_loadu_ps(&boxes->centerX[i]))), _mm_loadu_ps(&boxes->extentX[i])), zero);
+        __m128 dy = _mm_max_ps(_mm_sub_ps(_mm_andnot_ps(signMask, _mm_sub_ps(sy, _mm_loadu_ps(&boxes->centerY[i]))), _mm_loadu_ps(&boxes->extentY[i])), zero);
+        __m128 dz = _mm_max_ps(_mm_sub_ps(_mm_andnot_ps(signMask, _mm_sub_ps(sz, _mm_loadu_ps(&boxes->centerZ[i]))), _mm_loadu_ps(&boxes->extentZ[i])), zero);
+
+        __m128 distanceSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+        bits |= (uint32_t)_mm_movemask_ps(_mm_cmple_ps(distanceSq, radiusSq)) << j;
+    }
+
+#elif defined(R3D_HAS_NEON) || defined(R3D_HAS_NEON_FMA)
+
+    static const uint32_t laneBitsData[4] = { 1, 2, 4, 8 };
+    uint32x4_t laneBits = vld1q_u32(laneBitsData);
+
+    float32x4_t sx = vdupq_n_f32(center.x);
+    float32x4_t sy = vdupq_n_f32(center.y);
+    float32x4_t sz = vdupq_n_f32(center.z);
+    float32x4_t radiusSq = vdupq_n_f32(radius * radius);
+    float32x4_t zero = vdupq_n_f32(0.0f);
+
+    for (int j = 0; j < count; j += 4)
+    {
+        int i = first + j;
+
+        // Distance from the sphere center to the box along each axis, zero inside the box
+        float32x4_t dx = vmaxq_f32(vsubq_f32(vabdq_f32(sx, vld1q_f32(&boxes->centerX[i])), vld1q_f32(&boxes->extentX[i])), zero);
+        float32x4_t dy = vmaxq_f32(vsubq_f32(vabdq_f32(sy, vld1q_f32(&boxes->centerY[i])), vld1q_f32(&boxes->extentY[i])), zero);
+        float32x4_t dz = vmaxq_f32(vsubq_f32(vabdq_f32(sz, vld1q_f32(&boxes->centerZ[i])), vld1q_f32(&boxes->extentZ[i])), zero);
+
+        float32x4_t distanceSq = vaddq_f32(vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy)), vmulq_f32(dz, dz));
+
+        // No movemask on NEON, the lanes are reduced to a 4-bit mask with a horizontal add
+        uint32x4_t laneMask = vandq_u32(vcleq_f32(distanceSq, radiusSq), laneBits);
+        uint32x2_t sum = vadd_u32(vget_low_u32(laneMask), vget_high_u32(laneMask));
+        sum = vpadd_u32(sum, sum);
+
+        bits |= vget_lane_u32(sum, 0) << j;
+    }
+
+#else
+
+    float radiusSq = radius * radius;
+
+    for (int j = 0; j < count; j++)
+    {
+        int i = first + j;
+
+        float dx = fmaxf(fabsf(center.x - boxes->centerX[i]) - boxes->extentX[i], 0.0f);
+        float dy = fmaxf(fabsf(center.y - boxes->centerY[i]) - boxes->extentY[i], 0.0f);
+        float dz = fmaxf(fabsf(center.z - boxes->centerZ[i]) - boxes->extentZ[i], 0.0f);
+
+        if (dx * dx + dy * dy + dz * dz <= radiusSq) bits |= 1u << j;
+    }
+
+#endif
+
+    return bits & ((1u << count) - 1);
+}
+
+/* === Public functions === */
+
+bool r3d_cluster_grid_create(r3d_cluster_grid_t* grid)
+{
+    memset(grid, 0, sizeof(*grid));
+
+    int stride = R3D_CLUSTER_COUNT + R3D_CLUSTER_BOX_PADDING;
+
+    grid->memory = calloc(6 * stride, sizeof(float));
+    if (grid->memory == NULL) return false;
+
+    grid->boxes.centerX = grid->memory + 0 * stride;
+    grid->boxes.centerY = grid->memory + 1 * stride;
+    grid->boxes.centerZ = grid->memory + 2 * stride;
+    grid->boxes.extentX = grid->memory + 3 * stride;
+    grid->boxes.extentY = grid->memory + 4 * stride;
+    grid->boxes.extentZ = grid->memory + 5 * stride;
+
+    return true;
+}
+
+void r3d_cluster_grid_destroy(r3d_cluster_grid_t* grid)
+{
+    free(grid->memory);
+    memset(grid, 0, sizeof(*grid));
+}
+
+void r3d_cluster_grid_update(r3d_cluster_grid_t* grid, const Matrix* proj, float near, float far)
+{
+    if (grid->near == near && grid->far == far && memcmp(&grid->proj, proj, sizeof(Matrix)) == 0) {
+        return;
+    }
+
+    grid->proj = *proj;
+    grid->near = near;
+    grid->far = far;
+
+    float logRatio = logf(far / near);
+    grid->sliceScale = R3D_CLUSTER_COUNT_Z / logRatio;
+    grid->sliceBias = -R3D_CLUSTER_COUNT_Z * logf(near) / logRatio;
+
+    Matrix invProj = MatrixInvert(*proj);
+
+    for (int y = 0; y < R3D_CLUSTER_COUNT_Y; y++)
+    {
+        for (int x = 0; x < R3D_CLUSTER_COUNT_X; x++)
+        {
+            /* --- Rays through the corners of the tile --- */
+
+            Vector3 nearPoints[4], farPoints[4];
+
+            for (int c = 0; c < 4; c++) {
+                float ndcX = 2.0f * (x + (c & 1)) / R3D_CLUSTER_COUNT_X - 1.0f;
+                float ndcY = 2.0f * (y + (c >> 1)) / R3D_CLUSTER_COUNT_Y - 1.0f;
+                nearPoints[c] = r3d_cluster_unproject(&invProj, ndcX, ndcY, -1.0f);
+                farPoints[c] = r3d_cluster_unproject(&invProj, ndcX, ndcY, 1.0f);
+            }
+
+            /* --- Box of the part of the tile between each pair of slice depths --- */
+
+            for (int z = 0; z < R3D_CLUSTER_COUNT_Z; z++)
+            {
+                float depthNear = near * powf(far / near, (float)z / R3D_CLUSTER_COUNT_Z);
+                float depthFar = near * powf(far / near, (float)(z + 1) / R3D_CLUSTER_COUNT_Z);
+
+                Vector3 min = { FLT_MAX, FLT_MAX, FLT_MAX };
+                Vector3 max = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+                for (int c = 0; c < 4; c++) {
+                    Vector3 p0 = r3d_cluster_point_at_depth(nearPoints[c], farPoints[c], depthNear);
+                    Vector3 p1 = r3d_cluster_point_at_depth(nearPoints[c], farPoints[c], depthFar);
+                    min = Vector3Min(min, Vector3Min(p0, p1));
+                    max = Vector3Max(max, Vector3Max(p0, p1));
+                }
+
+                int i = x + y * R3D_CLUSTER_COUNT_X + z * R3D_CLUSTER_COUNT_X * R3D_CLUSTER_COUNT_Y;
+
+                grid->boxes.centerX[i] = 0.5f * (min.x + max.x);
+                grid->boxes.centerY[i] = 0.5f * (min.y + max.y);
+                grid->boxes.centerZ[i] = 0.5f * (min.z + max.z);
+                grid->boxes.extentX[i] = 0.5f * (max.x - min.x);
+                grid->boxes.extentY[i] = 0.5f * (max.y - min.y);
+                grid->boxes.extentZ[i] = 0.5f * (max.z - min.z);
+            }
+        }
+    }
+}
+
+void r3d_cluster_grid_bin_sphere(const r3d_cluster_grid_t* grid, Vector3 center, float radius, int light, r3d_array_t* pairs)
+{
+    /* --- Range of slices covered by the sphere --- */
+
+    float depthMin = -center.z - radius;
+    float depthMax = -center.z + radius;
+
+    if (depthMax < grid->near || depthMin > grid->far) {
+        return;
+    }
+
+    int z0 = r3d_cluster_get_slice(grid, fmaxf(depthMin, grid->near));
+    int z1 = r3d_cluster_get_slice(grid, fminf(depthMax, grid->far));
+
+    /* --- Range of tiles covered by the sphere --- */
+
+    int x0 = 0, x1 = R3D_CLUSTER_COUNT_X - 1;
+    int y0 = 0, y1 = R3D_CLUSTER_COUNT_Y - 1;
+
+    // NOTE: The rectangle comes from the projection of the box enclosing the sphere,
+    //       when the box crosses the near plane every tile is kept and the sphere tests do the work
+    if (depthMin > grid->near)
+    {
+        const Matrix* m = &grid->proj;
+
+        float minX = FLT_MAX, minY = FLT_MAX;
+        float maxX = -FLT_MAX, maxY = -FLT_MAX;
+
+        for (int c = 0; c < 8; c++) {
+            float px = center.x + ((c & 1) ? radius : -radius);
+            float py = center.y + ((c & 2) ? radius : -radius);
+            float pz = center.z + ((c & 4) ? radius : -radius);
+            float w = m->m3 * px + m->m7 * py + m->m11 * pz + m->m15;
+            float ndcX = (m->m0 * px + m->m4 * py + m->m8 * pz + m->m12) / w;
+            float ndcY = (m->m1 * px + m->m5 * py + m->m9 * pz + m->m13) / w;
+            minX = fminf(minX, ndcX); maxX = fmaxf(maxX, ndcX);
+            minY = fminf(minY, ndcY); maxY = fmaxf(maxY, ndcY);
+        }
+
+        if (maxX < -1.0f || minX > 1.0f || maxY < -1.0f || minY > 1.0f) {
+            return;
+        }
+
+        x0 = r3d_cluster_get_tile(minX, R3D_CLUSTER_COUNT_X);
+        x1 = r3d_cluster_get_tile(maxX, R3D_CLUSTER_COUNT_X);
+        y0 = r3d_cluster_get_tile(minY, R3D_CLUSTER_COUNT_Y);
+        y1 = r3d_cluster_get_tile(maxY, R3D_CLUSTER_COUNT_Y);
+    }
+
+    /* --- Sphere tests, one row of tiles at a time --- */
+
+    for (int z = z0; z <= z1; z++)
+    {
+        for (int y = y0; y <= y1; y++)
+        {
+            int first = x0 + y * R3D_CLUSTER_COUNT_X + z * R3D_CLUSTER_COUNT_X * R3D_CLUSTER_COUNT_Y;
+            int count = x1 - x0 + 1;
+
+            uint32_t mask = r3d_cluster_test_sphere(&grid->boxes, first, count, center, radius);
+
+            for (int i = 0; mask != 0; i++, mask >>= 1) {
+                if (mask & 1u) {
+                    uint32_t pair = ((uint32_t)(first + i) << 16) | (uint32_t)light;
+                    r3d_array_push_back(pairs, &pair);
+                }
+            }
+        }
+    }
+}
+
+void r3d_cluster_build_lists(const uint32_t* pairs, int pairCount, uint32_t* ranges, uint16_t* indices)
+{
+    /* --- Count the lights of each cluster --- */
+
+    for (int i = 0; i < R3D_CLUSTER_COUNT; i++) {
+        ranges[2 * i + 1] = 0;
+    }
+
+    for (int i = 0; i < pairCount; i++) {
+        ranges[2 * (pairs[i] >> 16) + 1]++;
+    }
+
+    /* --- Offsets of the lists, then scatter the indices --- */
+
+    uint32_t offset = 0;
+
+    for (int i = 0; i < R3D_CLUSTER_COUNT; i++) {
+        ranges[2 * i] = offset;
+        offset += ranges[2 * i + 1];
+        ranges[2 * i + 1] = 0;
+    }
+
+    // NOTE: The pairs are visited in order, so each list keeps the lights in their storage order
+    for (int i = 0; i < pairCount; i++) {
+        uint32_t cluster = pairs[i] >> 16;
+        indices[ranges[2 * cluster] + ranges[2 * cluster + 1]++] = (uint16_t)(pairs[i] & 0xFFFF);
+    }
+}
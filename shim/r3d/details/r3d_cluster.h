@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef R3D_DETAILS_CLUSTER_H
+#define R3D_DETAILS_CLUSTER_H
+
+#include "./r3d_frustum.h"
+#include "./containers/r3d_array.h"
+
+#include <raylib.h>
+#include <stdint.h>
+
+/* === Defines === */
+
+// NOTE: Must match the CLUSTER_X/Y/Z defines of the clustered lighting shaders
+#define R3D_CLUSTER_COUNT_X     16
+#define R3D_CLUSTER_COUNT_Y     9
+#define R3D_CLUSTER_COUNT_Z     24
+#define R3D_CLUSTER_COUNT       (R3D_CLUSTER_COUNT_X * R3D_CLUSTER_COUNT_Y * R3D_CLUSTER_COUNT_Z)
+
+#define R3D_CLUSTER_MAX_LIGHTS  65536   //< Light indices are stored on 16 bits
+
+/* === Types === */
+
+/*
+ * Froxel grid of the view frustum, the screen is divided into tiles and the
+ * depth range into slices of exponentially increasing thickness. The view
+ * space boxes of the clusters only depend on the projection, they are rebuilt
+ * when it changes. Clusters are indexed by x + y * X + z * X * Y.
+ */
+typedef struct {
+    r3d_aabb_soa_t boxes;       //< View space box of each cluster, padded for the SIMD loads
+    float* memory;              //< Single allocation backing the box arrays
+    Matrix proj;                //< Projection the boxes were built for
+    float near, far;
+    float sliceScale;           //< slice = log(depth) * sliceScale + sliceBias
+    float sliceBias;
+} r3d_cluster_grid_t;
+
+/* === Functions === */
+
+bool r3d_cluster_grid_create(r3d_cluster_grid_t* grid);
+void r3d_cluster_grid_destroy(r3d_cluster_grid_t* grid);
+
+// Rebuilds the cluster boxes if the projection or the depth range changed
+void r3d_cluster_grid_update(r3d_cluster_grid_t* grid, const Matrix* proj, float near, float far);
+
+// Appends to 'pairs' a (cluster << 16 | light) uint32_t for each cluster touched by the view space sphere
+void r3d_cluster_grid_bin_sphere(const r3d_cluster_grid_t* grid, Vector3 center, float radius, int light, r3d_array_t* pairs);
+
+// Sorts the pairs into per-cluster lists, 'ranges' receives (offset, count) for each cluster
+// and 'indices' the light indices of all the lists, it must have room for 'pairCount' elements
+void r3d_cluster_build_lists(const uint32_t* pairs, int pairCount, uint32_t* ranges, uint16_t* indices);
+
+#endif // R3D_DETAILS_CLUSTER_H
@@ -21,6 +21,7 @@
 
 #include "./r3d_primitives.h"
 #include "./r3d_frustum.h"
+#include "./r3d_sort.h"
 #include "../r3d_state.h"
 #include "./r3d_math.h"
 
@@ -30,9 +31,21 @@
 #include "../glad.h"
 
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 #include <float.h>
 
+/* === Internal macros === */
+
+// Same as 'r3d_shader_bind_sampler2D_opt' but goes through the bound state cache
+#define r3d_drawcall_bind_sampler2D_opt(shader_name, uniform, texId, altTex)                    \
+do {                                                                                            \
+    r3d_drawcall_bind_texture2D(                                                                \
+        R3D.shader.shader_name.uniform.slot2D,                                                  \
+        ((texId) != 0) ? (texId) : R3D.texture.altTex                                           \
+    );                                                                                          \
+} while(0)
+
 /* === Internal functions === */
 
 // Functions applying OpenGL states defined by the material but unrelated to shaders
@@ -42,32 +55,205 @@ static void r3d_drawcall_apply_shadow_cast_mode(R3D_ShadowCastMode castMode, R3D
 
 // This function supports instanced rendering when necessary
 static void r3d_drawcall(const r3d_drawcall_t* call);
-static void r3d_drawcall_instanced(const r3d_drawcall_t* call, int locInstanceModel, int locInstanceColor);
+static void r3d_drawcall_instanced(const r3d_drawcall_t* call, const Matrix* matVP, int locInstanceModel, int locInstanceColor);
+static int r3d_drawcall_cull_instances(const r3d_drawcall_t* call, const Matrix* matVP, const void** transforms, size_t* transStride, const void** colors, size_t* colStride);
+
+// Packs the elements in the streaming buffer, returns false if the buffer is full
+static bool r3d_drawcall_stream_array(const void* data, size_t stride, size_t elemSize, int count, size_t* offset);
 
-// Comparison functions for sorting draw calls in the arrays
-static int r3d_drawcall_compare_front_to_back(const void* a, const void* b);
-static int r3d_drawcall_compare_back_to_front(const void* a, const void* b);
-static int r3d_drawcall_compare_mixed_forward(const void* a, const void* b);
+// Binds a texture unless the bound state cache knows it is already bound
+static void r3d_drawcall_bind_texture2D(int slot, GLuint texId);
 
-// Upload matrices function
-static void r3d_drawcall_upload_matrices(const r3d_drawcall_t* call);
+// Vertex array of the meshes
+static void r3d_drawcall_bind_geometry_mesh(const R3D_Mesh* mesh);
+static void r3d_drawcall_unbind_geometry_mesh(void);
+
+// Distances used to build the sort keys of the draw calls
+static float r3d_drawcall_calculate_center_distance_to_camera(const r3d_drawcall_t* drawCall);
+static float r3d_drawcall_calculate_max_distance_to_camera(const r3d_drawcall_t* drawCall);
+
+// Binds the bone matrix atlas, the calls reference their bones with 'uBoneOffset'
+static void r3d_drawcall_bind_matrices(void);
 
 /* === Function definitions === */
 
-void r3d_drawcall_sort_front_to_back(r3d_drawcall_t* calls, size_t count)
+void r3d_drawcall_set_material(r3d_drawcall_t* call, const R3D_Material* material)
+{
+    R3D_Material defaultMaterial;
+
+    if (material == NULL) {
+        defaultMaterial = R3D_GetDefaultMaterial();
+        material = &defaultMaterial;
+    }
+
+    call->material = r3d_material_cache_intern(
+        &R3D.container.materials, material,
+        R3D.state.frameIndex, &call->materialVersion
+    );
+}
+
+const R3D_Material* r3d_drawcall_get_material(const r3d_drawcall_t* call)
 {
-    qsort(calls, count, sizeof(r3d_drawcall_t), r3d_drawcall_compare_front_to_back);
+    const R3D_Material* material = r3d_material_cache_get(&R3D.container.materials, call->material);
+
+    // NOTE: Only happens if the cache failed to add the material
+    if (material == NULL) {
+        material = &R3D.container.defaultMaterial;
+    }
+
+    return material;
+}
+
+void r3d_drawcall_sort_front_to_back(const r3d_drawcall_t* calls, size_t count, uint64_t* keys, uint32_t* order)
+{
+    // Front-to-back: smaller center distance first
+    for (size_t i = 0; i < count; i++) {
+        float dist = r3d_drawcall_calculate_center_distance_to_camera(&calls[i]);
+        keys[i] = (uint64_t)r3d_sort_float_key(dist) << 32;
+        order[i] = (uint32_t)i;
+    }
+
+    r3d_sort_radix_u64(keys, order, keys + count, order + count, count);
 }
 
-void r3d_drawcall_sort_back_to_front(r3d_drawcall_t* calls, size_t count)
+void r3d_drawcall_sort_back_to_front(const r3d_drawcall_t* calls, size_t count, uint64_t* keys, uint32_t* order)
 {
-    qsort(calls, count, sizeof(r3d_drawcall_t), r3d_drawcall_compare_back_to_front);
+    // Back-to-front: larger max distance first, then larger center distance
+    for (size_t i = 0; i < count; i++) {
+        float maxDist = r3d_drawcall_calculate_max_distance_to_camera(&calls[i]);
+        float centerDist = r3d_drawcall_calculate_center_distance_to_camera(&calls[i]);
+        keys[i] = ((uint64_t)~r3d_sort_float_key(maxDist) << 32) | ~r3d_sort_float_key(centerDist);
+        order[i] = (uint32_t)i;
+    }
+
+    r3d_sort_radix_u64(keys, order, keys + count, order + count, count);
 }
 
-void r3d_drawcall_sort_mixed_forward(r3d_drawcall_t* calls, size_t count)
+void r3d_drawcall_sort_mixed_forward(const r3d_drawcall_t* calls, size_t count, uint64_t* keys, uint32_t* order)
 {
     // Sort objects forward in case the array can contain both opaque and transparent objects
-    qsort(calls, count, sizeof(r3d_drawcall_t), r3d_drawcall_compare_mixed_forward);
+    // Opaque objects come first and are sorted front-to-back, then transparent objects back-to-front
+
+    // NOTE: The distances are squared lengths, so the sign bit of their keys
+    //       is always the same and the top bit can hold the transparency
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const r3d_drawcall_t* call = &calls[i];
+        float centerDist = r3d_drawcall_calculate_center_distance_to_camera(call);
+
+        if (r3d_drawcall_get_material(call)->blendMode == R3D_BLEND_OPAQUE) {
+            keys[i] = (R3D.state.flags & R3D_FLAG_STATE_SORTING)
+                ? r3d_drawcall_get_state_key(call)
+                : (uint64_t)(r3d_sort_float_key(centerDist) & 0x7FFFFFFF) << 32;
+        }
+        else {
+            float maxDist = r3d_drawcall_calculate_max_distance_to_camera(call);
+            keys[i] = (1ULL << 63) | ((uint64_t)(~r3d_sort_float_key(maxDist) & 0x7FFFFFFF) << 32) | ~r3d_sort_float_key(centerDist);
+        }
+
+        order[i] = (uint32_t)i;
+    }
+
+    r3d_sort_radix_u64(keys, order, keys + count, order + count, count);
+}
+
+void r3d_drawcall_sort_by_state(const r3d_drawcall_t* calls, size_t count, uint64_t* keys, uint32_t* order)
+{
+    for (size_t i = 0; i < count; i++) {
+        keys[i] = r3d_drawcall_get_state_key(&calls[i]);
+        order[i] = (uint32_t)i;
+    }
+
+    r3d_sort_radix_u64(keys, order, keys + count, order + count, count);
+}
+
+uint64_t r3d_drawcall_get_state_key(const r3d_drawcall_t* call)
+{
+    // Key layout, from the most significant bit (the top bit is left free):
+    //   [62..59] shader variant (geometry type, skinning, cull mode)
+    //   [58..27] hash of the four material textures
+    //   [26..11] hash of the mesh
+    //   [10..0]  coarse view distance, so that each group is still drawn front-to-back
+
+    const R3D_Material* material = r3d_drawcall_get_material(call);
+
+    uint64_t variant = (uint64_t)(call->geometryType & 1) << 3;
+    uint64_t meshHash = 0;
+
+    if (call->geometryType == R3D_DRAWCALL_GEOMETRY_MODEL) {
+        if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL) {
+            variant |= 1 << 2;
+        }
+        meshHash = ((uint64_t)(uintptr_t)call->geometry.model.mesh * 0x9E3779B97F4A7C15ULL) >> 48;
+    }
+    variant |= (uint64_t)(material->cullMode & 3);
+
+    uint32_t texHash = 2166136261u;
+    texHash = (texHash ^ material->albedo.texture.id) * 16777619u;
+    texHash = (texHash ^ material->normal.texture.id) * 16777619u;
+    texHash = (texHash ^ material->emission.texture.id) * 16777619u;
+    texHash = (texHash ^ material->orm.texture.id) * 16777619u;
+
+    // NOTE: The distance is a squared length, the sign bit of its key is always set,
+    //       the eleven next bits are the exponent and the top of the mantissa
+    uint32_t depth = (r3d_sort_float_key(r3d_drawcall_calculate_center_distance_to_camera(call)) >> 20) & 0x7FF;
+
+    return (variant << 59) | ((uint64_t)texHash << 27) | (meshHash << 11) | depth;
+}
+
+void r3d_drawcall_bind_cache_begin(void)
+{
+    R3D.state.bound.enabled = (R3D.state.flags & R3D_FLAG_STATE_SORTING) != 0;
+    R3D.state.bound.mesh = NULL;
+
+    for (int i = 0; i < R3D_BIND_CACHE_TEXTURE_UNITS; i++) {
+        R3D.state.bound.texture2D[i] = 0;
+    }
+}
+
+void r3d_drawcall_bind_cache_end(void)
+{
+    if (!R3D.state.bound.enabled) {
+        return;
+    }
+
+    // Release what the calls left bound, as the uncached path does after each call
+    for (int i = 0; i < R3D_BIND_CACHE_TEXTURE_UNITS; i++) {
+        if (R3D.state.bound.texture2D[i] != 0) {
+            glActiveTexture(GL_TEXTURE0 + i);
+            glBindTexture(GL_TEXTURE_2D, 0);
+        }
+    }
+
+    if (R3D.state.bound.mesh != NULL) {
+        r3d_drawcall_unbind_geometry_mesh();
+    }
+
+    R3D.state.bound.enabled = false;
+}
+
+void r3d_drawcall_stream_instances(r3d_drawcall_t* call)
+{
+    if (call->instanced.streamed || call->instanced.transforms == NULL || call->instanced.count == 0) {
+        return;
+    }
+
+    size_t transStride = (call->instanced.transStride == 0) ? sizeof(Matrix) : call->instanced.transStride;
+    size_t colStride = (call->instanced.colStride == 0) ? sizeof(Color) : call->instanced.colStride;
+    int count = (int)call->instanced.count;
+
+    if (!r3d_drawcall_stream_array(call->instanced.transforms, transStride, sizeof(Matrix), count, &call->instanced.streamTransforms)) {
+        return;
+    }
+
+    if (call->instanced.colors != NULL) {
+        if (!r3d_drawcall_stream_array(call->instanced.colors, colStride, sizeof(Color), count, &call->instanced.streamColors)) {
+            return;
+        }
+    }
+
+    call->instanced.streamed = true;
 }
 
 bool r3d_drawcall_geometry_is_visible(const r3d_drawcall_t* call)
@@ -99,39 +285,34 @@ bool r3d_drawcall_instanced_geometry_is_visible(const r3d_drawcall_t* call)
     return r3d_frustum_is_obb_in(&R3D.state.frustum.shape, &call->instanced.allAabb, &call->transform);
 }
 
-void r3d_drawcall_update_model_animation(const r3d_drawcall_t* call)
+bool r3d_drawcall_is_skinned(const r3d_drawcall_t* call)
 {
-    int frame = call->geometry.model.frame;
-    if (frame >= call->geometry.model.anim->frameCount) {
-        frame = frame % call->geometry.model.anim->frameCount;
-    }
-
-    r3d_matrix_multiply_batch(
-        call->geometry.model.mesh->boneMatrices,
-        call->geometry.model.boneOffsets,
-        call->geometry.model.anim->frameGlobalPoses[frame],
-        call->geometry.model.anim->boneCount
-    );
+    return call->geometryType == R3D_DRAWCALL_GEOMETRY_MODEL
+        && call->geometry.model.anim != NULL
+        && call->geometry.model.boneOffsets != NULL;
 }
 
 void r3d_drawcall_raster_depth(const r3d_drawcall_t* call, bool forward, bool shadow, const Matrix* matVP)
 {
+    const R3D_Material* material = r3d_drawcall_get_material(call);
+
     // Calculate and send MVP
     Matrix matMVP = r3d_matrix_multiply(&call->transform, matVP);
     r3d_shader_set_mat4(raster.depth, uMatMVP, matMVP);
 
     // Set texcoord offset/scale
-    r3d_shader_set_vec2(raster.depth, uTexCoordOffset, call->material.uvOffset);
-    r3d_shader_set_vec2(raster.depth, uTexCoordScale, call->material.uvScale);
+    r3d_shader_set_vec2(raster.depth, uTexCoordOffset, material->uvOffset);
+    r3d_shader_set_vec2(raster.depth, uTexCoordScale, material->uvScale);
 
     // Setup geometry type related uniforms
     switch (call->geometryType) {
     case R3D_DRAWCALL_GEOMETRY_MODEL:
         {
             // Send bone matrices and animation related data
-            if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL) {
+            if (r3d_drawcall_is_skinned(call) && call->geometry.model.boneStorage >= 0) {
                 r3d_shader_set_int(raster.depth, uUseSkinning, true);
-                r3d_drawcall_upload_matrices(call);
+                r3d_shader_set_int(raster.depth, uBoneOffset, call->geometry.model.boneStorage);
+                r3d_drawcall_bind_matrices();
             }
             else {
                 r3d_shader_set_int(raster.depth, uUseSkinning, false);
@@ -148,9 +329,9 @@ void r3d_drawcall_raster_depth(const r3d_drawcall_t* call, bool forward, bool sh
 
     // Set forward material data
     if (forward) {
-        r3d_shader_set_float(raster.depth, uAlphaCutoff, call->material.alphaCutoff);
-        r3d_shader_set_float(raster.depth, uAlpha, ((float)call->material.albedo.color.a / 255));
-        r3d_shader_bind_sampler2D_opt(raster.depth, uTexAlbedo, call->material.albedo.texture.id, white);
+        r3d_shader_set_float(raster.depth, uAlphaCutoff, material->alphaCutoff);
+        r3d_shader_set_float(raster.depth, uAlpha, ((float)material->albedo.color.a / 255));
+        r3d_shader_bind_sampler2D_opt(raster.depth, uTexAlbedo, material->albedo.texture.id, white);
     }
     else {
         r3d_shader_set_float(raster.depth, uAlpha, 1.0f);
@@ -160,10 +341,10 @@ void r3d_drawcall_raster_depth(const r3d_drawcall_t* call, bool forward, bool sh
 
     // Applying material parameters that are independent of shaders
     if (shadow) {
-        r3d_drawcall_apply_shadow_cast_mode(call->shadowCastMode, call->material.cullMode);
+        r3d_drawcall_apply_shadow_cast_mode(call->shadowCastMode, material->cullMode);
     }
     else {
-        r3d_drawcall_apply_cull_mode(call->material.cullMode);
+        r3d_drawcall_apply_cull_mode(material->cullMode);
     }
 
     // Rendering the object corresponding to the draw call
@@ -180,28 +361,31 @@ void r3d_drawcall_raster_depth(const r3d_drawcall_t* call, bool forward, bool sh
 
 void r3d_drawcall_raster_depth_inst(const r3d_drawcall_t* call, bool forward, bool shadow, const Matrix* matVP)
 {
+    const R3D_Material* material = r3d_drawcall_get_material(call);
+
     // Send matrices
     r3d_shader_set_mat4(raster.depthInst, uMatModel, call->transform);
     r3d_shader_set_mat4(raster.depthInst, uMatVP, *matVP);
 
     // Send billboard related data
-    r3d_shader_set_int(raster.depthInst, uBillboardMode, call->material.billboardMode);
-    if (call->material.billboardMode != R3D_BILLBOARD_DISABLED) {
+    r3d_shader_set_int(raster.depthInst, uBillboardMode, material->billboardMode);
+    if (material->billboardMode != R3D_BILLBOARD_DISABLED) {
         r3d_shader_set_mat4(raster.depthInst, uMatInvView, R3D.state.transform.invView);
     }
 
     // Set texcoord offset/scale
-    r3d_shader_set_vec2(raster.depthInst, uTexCoordOffset, call->material.uvOffset);
-    r3d_shader_set_vec2(raster.depthInst, uTexCoordScale, call->material.uvScale);
+    r3d_shader_set_vec2(raster.depthInst, uTexCoordOffset, material->uvOffset);
+    r3d_shader_set_vec2(raster.depthInst, uTexCoordScale, material->uvScale);
 
     // Setup geometry type related uniforms
     switch (call->geometryType) {
     case R3D_DRAWCALL_GEOMETRY_MODEL:
         {
             // Send bone matrices and animation related data
-            if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL) {
+            if (r3d_drawcall_is_skinned(call) && call->geometry.model.boneStorage >= 0) {
                 r3d_shader_set_int(raster.depthInst, uUseSkinning, true);
-                r3d_drawcall_upload_matrices(call);
+                r3d_shader_set_int(raster.depthInst, uBoneOffset, call->geometry.model.boneStorage);
+                r3d_drawcall_bind_matrices();
             }
             else {
                 r3d_shader_set_int(raster.depthInst, uUseSkinning, false);
@@ -218,9 +402,9 @@ void r3d_drawcall_raster_depth_inst(const r3d_drawcall_t* call, bool forward, bo
 
     // Set forward material data
     if (forward) {
-        r3d_shader_set_float(raster.depthInst, uAlphaCutoff, call->material.alphaCutoff);
-        r3d_shader_set_float(raster.depthInst, uAlpha, ((float)call->material.albedo.color.a / 255));
-        r3d_shader_bind_sampler2D_opt(raster.depthInst, uTexAlbedo, call->material.albedo.texture.id, white);
+        r3d_shader_set_float(raster.depthInst, uAlphaCutoff, material->alphaCutoff);
+        r3d_shader_set_float(raster.depthInst, uAlpha, ((float)material->albedo.color.a / 255));
+        r3d_shader_bind_sampler2D_opt(raster.depthInst, uTexAlbedo, material->albedo.texture.id, white);
     }
     else {
         r3d_shader_set_float(raster.depthInst, uAlpha, 1.0f);
@@ -230,14 +414,14 @@ void r3d_drawcall_raster_depth_inst(const r3d_drawcall_t* call, bool forward, bo
 
     // Applying material parameters that are independent of shaders
     if (shadow) {
-        r3d_drawcall_apply_shadow_cast_mode(call->shadowCastMode, call->material.cullMode);
+        r3d_drawcall_apply_shadow_cast_mode(call->shadowCastMode, material->cullMode);
     }
     else {
-        r3d_drawcall_apply_cull_mode(call->material.cullMode);
+        r3d_drawcall_apply_cull_mode(material->cullMode);
     }
 
     // Rendering the objects corresponding to the draw call
-    r3d_drawcall_instanced(call, 10, -1);
+    r3d_drawcall_instanced(call, matVP, 10, -1);
 
     // Unbind vertex buffers
     rlDisableVertexArray();
@@ -250,6 +434,8 @@ void r3d_drawcall_raster_depth_inst(const r3d_drawcall_t* call, bool forward, bo
 
 void r3d_drawcall_raster_depth_cube(const r3d_drawcall_t* call, bool forward, bool shadow, const Matrix* matVP)
 {
+    const R3D_Material* material = r3d_drawcall_get_material(call);
+
     // Calculate MVP
     Matrix matMVP = r3d_matrix_multiply(&call->transform, matVP);
 
@@ -258,17 +444,18 @@ void r3d_drawcall_raster_depth_cube(const r3d_drawcall_t* call, bool forward, bo
     r3d_shader_set_mat4(raster.depthCube, uMatMVP, matMVP);
 
     // Set texcoord offset/scale
-    r3d_shader_set_vec2(raster.depthCube, uTexCoordOffset, call->material.uvOffset);
-    r3d_shader_set_vec2(raster.depthCube, uTexCoordScale, call->material.uvScale);
+    r3d_shader_set_vec2(raster.depthCube, uTexCoordOffset, material->uvOffset);
+    r3d_shader_set_vec2(raster.depthCube, uTexCoordScale, material->uvScale);
 
     // Setup geometry type related uniforms
     switch (call->geometryType) {
     case R3D_DRAWCALL_GEOMETRY_MODEL:
         {
             // Send bone matrices and animation related data
-            if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL) {
+            if (r3d_drawcall_is_skinned(call) && call->geometry.model.boneStorage >= 0) {
                 r3d_shader_set_int(raster.depthCube, uUseSkinning, true);
-                r3d_drawcall_upload_matrices(call);
+                r3d_shader_set_int(raster.depthCube, uBoneOffset, call->geometry.model.boneStorage);
+                r3d_drawcall_bind_matrices();
             }
             else {
                 r3d_shader_set_int(raster.depthCube, uUseSkinning, false);
@@ -285,9 +472,9 @@ void r3d_drawcall_raster_depth_cube(const r3d_drawcall_t* call, bool forward, bo
 
     // Set forward material data
     if (forward) {
-        r3d_shader_set_float(raster.depthCube, uAlphaCutoff, call->material.alphaCutoff);
-        r3d_shader_set_float(raster.depthCube, uAlpha, ((float)call->material.albedo.color.a / 255));
-        r3d_shader_bind_sampler2D_opt(raster.depthCube, uTexAlbedo, call->material.albedo.texture.id, white);
+        r3d_shader_set_float(raster.depthCube, uAlphaCutoff, material->alphaCutoff);
+        r3d_shader_set_float(raster.depthCube, uAlpha, ((float)material->albedo.color.a / 255));
+        r3d_shader_bind_sampler2D_opt(raster.depthCube, uTexAlbedo, material->albedo.texture.id, white);
     }
     else {
         r3d_shader_set_float(raster.depthCube, uAlpha, 1.0f);
@@ -297,10 +484,10 @@ void r3d_drawcall_raster_depth_cube(const r3d_drawcall_t* call, bool forward, bo
 
     // Applying material parameters that are independent of shaders
     if (shadow) {
-        r3d_drawcall_apply_shadow_cast_mode(call->shadowCastMode, call->material.cullMode);
+        r3d_drawcall_apply_shadow_cast_mode(call->shadowCastMode, material->cullMode);
     }
     else {
-        r3d_drawcall_apply_cull_mode(call->material.cullMode);
+        r3d_drawcall_apply_cull_mode(material->cullMode);
     }
 
     // Rendering the object corresponding to the draw call
@@ -317,28 +504,31 @@ void r3d_drawcall_raster_depth_cube(const r3d_drawcall_t* call, bool forward, bo
 
 void r3d_drawcall_raster_depth_cube_inst(const r3d_drawcall_t* call, bool forward, bool shadow, const Matrix* matVP)
 {
+    const R3D_Material* material = r3d_drawcall_get_material(call);
+
     // Send matrices
     r3d_shader_set_mat4(raster.depthCubeInst, uMatModel, call->transform);
     r3d_shader_set_mat4(raster.depthCubeInst, uMatVP, *matVP);
 
     // Send billboard related data
-    r3d_shader_set_int(raster.depthCubeInst, uBillboardMode, call->material.billboardMode);
-    if (call->material.billboardMode != R3D_BILLBOARD_DISABLED) {
+    r3d_shader_set_int(raster.depthCubeInst, uBillboardMode, material->billboardMode);
+    if (material->billboardMode != R3D_BILLBOARD_DISABLED) {
         r3d_shader_set_mat4(raster.depthCubeInst, uMatInvView, R3D.state.transform.invView);
     }
 
     // Set texcoord offset/scale
-    r3d_shader_set_vec2(raster.depthCubeInst, uTexCoordOffset, call->material.uvOffset);
-    r3d_shader_set_vec2(raster.depthCubeInst, uTexCoordScale, call->material.uvScale);
+    r3d_shader_set_vec2(raster.depthCubeInst, uTexCoordOffset, material->uvOffset);
+    r3d_shader_set_vec2(raster.depthCubeInst, uTexCoordScale, material->uvScale);
 
     // Setup geometry type related uniforms
     switch (call->geometryType) {
     case R3D_DRAWCALL_GEOMETRY_MODEL:
         {
             // Send bone matrices and animation related data
-            if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL) {
+            if (r3d_drawcall_is_skinned(call) && call->geometry.model.boneStorage >= 0) {
                 r3d_shader_set_int(raster.depthCubeInst, uUseSkinning, true);
-                r3d_drawcall_upload_matrices(call);
+                r3d_shader_set_int(raster.depthCubeInst, uBoneOffset, call->geometry.model.boneStorage);
+                r3d_drawcall_bind_matrices();
             }
             else {
                 r3d_shader_set_int(raster.depthCubeInst, uUseSkinning, false);
@@ -355,9 +545,9 @@ void r3d_drawcall_raster_depth_cube_inst(const r3d_drawcall_t* call, bool forwar
 
     // Set forward material data
     if (forward) {
-        r3d_shader_set_float(raster.depthCubeInst, uAlphaCutoff, call->material.alphaCutoff);
-        r3d_shader_set_float(raster.depthCubeInst, uAlpha, ((float)call->material.albedo.color.a / 255));
-        r3d_shader_bind_sampler2D_opt(raster.depthCubeInst, uTexAlbedo, call->material.albedo.texture.id, white);
+        r3d_shader_set_float(raster.depthCubeInst, uAlphaCutoff, material->alphaCutoff);
+        r3d_shader_set_float(raster.depthCubeInst, uAlpha, ((float)material->albedo.color.a / 255));
+        r3d_shader_bind_sampler2D_opt(raster.depthCubeInst, uTexAlbedo, material->albedo.texture.id, white);
     }
     else {
         r3d_shader_set_float(raster.depthCubeInst, uAlpha, 1.0f);
@@ -367,14 +557,14 @@ void r3d_drawcall_raster_depth_cube_inst(const r3d_drawcall_t* call, bool forwar
 
     // Applying material parameters that are independent of shaders
     if (shadow) {
-        r3d_drawcall_apply_shadow_cast_mode(call->shadowCastMode, call->material.cullMode);
+        r3d_drawcall_apply_shadow_cast_mode(call->shadowCastMode, material->cullMode);
     }
     else {
-        r3d_drawcall_apply_cull_mode(call->material.cullMode);
+        r3d_drawcall_apply_cull_mode(material->cullMode);
     }
 
     // Rendering the objects corresponding to the draw call
-    r3d_drawcall_instanced(call, 10, -1);
+    r3d_drawcall_instanced(call, matVP, 10, -1);
 
     // Unbind vertex buffers
     rlDisableVertexArray();
@@ -387,6 +577,8 @@ void r3d_drawcall_raster_depth_cube_inst(const r3d_drawcall_t* call, bool forwar
 
 void r3d_drawcall_raster_geometry(const r3d_drawcall_t* call, const Matrix* matVP)
 {
+    const R3D_Material* material = r3d_drawcall_get_material(call);
+
     // Calculate normal and MVP matrices
     Matrix matNormal = r3d_matrix_normal(&call->transform);
     Matrix matMVP = r3d_matrix_multiply(&call->transform, matVP);
@@ -397,34 +589,35 @@ void r3d_drawcall_raster_geometry(const r3d_drawcall_t* call, const Matrix* matV
     r3d_shader_set_mat4(raster.geometry, uMatMVP, matMVP);
 
     // Set factor material maps
-    r3d_shader_set_float(raster.geometry, uEmissionEnergy, call->material.emission.energy);
-    r3d_shader_set_float(raster.geometry, uNormalScale, call->material.normal.scale);
-    r3d_shader_set_float(raster.geometry, uOcclusion, call->material.orm.occlusion);
-    r3d_shader_set_float(raster.geometry, uRoughness, call->material.orm.roughness);
-    r3d_shader_set_float(raster.geometry, uMetalness, call->material.orm.metalness);
+    r3d_shader_set_float(raster.geometry, uEmissionEnergy, material->emission.energy);
+    r3d_shader_set_float(raster.geometry, uNormalScale, material->normal.scale);
+    r3d_shader_set_float(raster.geometry, uOcclusion, material->orm.occlusion);
+    r3d_shader_set_float(raster.geometry, uRoughness, material->orm.roughness);
+    r3d_shader_set_float(raster.geometry, uMetalness, material->orm.metalness);
 
     // Set texcoord offset/scale
-    r3d_shader_set_vec2(raster.geometry, uTexCoordOffset, call->material.uvOffset);
-    r3d_shader_set_vec2(raster.geometry, uTexCoordScale, call->material.uvScale);
+    r3d_shader_set_vec2(raster.geometry, uTexCoordOffset, material->uvOffset);
+    r3d_shader_set_vec2(raster.geometry, uTexCoordScale, material->uvScale);
 
     // Set color material maps
-    r3d_shader_set_col3(raster.geometry, uAlbedoColor, call->material.albedo.color);
-    r3d_shader_set_col3(raster.geometry, uEmissionColor, call->material.emission.color);
+    r3d_shader_set_col3(raster.geometry, uAlbedoColor, material->albedo.color);
+    r3d_shader_set_col3(raster.geometry, uEmissionColor, material->emission.color);
 
     // Bind active texture maps
-    r3d_shader_bind_sampler2D_opt(raster.geometry, uTexAlbedo, call->material.albedo.texture.id, white);
-    r3d_shader_bind_sampler2D_opt(raster.geometry, uTexNormal, call->material.normal.texture.id, normal);
-    r3d_shader_bind_sampler2D_opt(raster.geometry, uTexEmission, call->material.emission.texture.id, black);
-    r3d_shader_bind_sampler2D_opt(raster.geometry, uTexORM, call->material.orm.texture.id, white);
+    r3d_drawcall_bind_sampler2D_opt(raster.geometry, uTexAlbedo, material->albedo.texture.id, white);
+    r3d_drawcall_bind_sampler2D_opt(raster.geometry, uTexNormal, material->normal.texture.id, normal);
+    r3d_drawcall_bind_sampler2D_opt(raster.geometry, uTexEmission, material->emission.texture.id, black);
+    r3d_drawcall_bind_sampler2D_opt(raster.geometry, uTexORM, material->orm.texture.id, white);
 
     // Setup geometry type related uniforms
     switch (call->geometryType) {
     case R3D_DRAWCALL_GEOMETRY_MODEL:
         {
             // Send bone matrices and animation related data
-            if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL) {
+            if (r3d_drawcall_is_skinned(call) && call->geometry.model.boneStorage >= 0) {
                 r3d_shader_set_int(raster.geometry, uUseSkinning, true);
-                r3d_drawcall_upload_matrices(call);
+                r3d_shader_set_int(raster.geometry, uBoneOffset, call->geometry.model.boneStorage);
+                r3d_drawcall_bind_matrices();
             }
             else {
                 r3d_shader_set_int(raster.geometry, uUseSkinning, false);
@@ -440,20 +633,24 @@ void r3d_drawcall_raster_geometry(const r3d_drawcall_t* call, const Matrix* matV
     }
 
     // Applying material parameters that are independent of shaders
-    r3d_drawcall_apply_cull_mode(call->material.cullMode);
+    r3d_drawcall_apply_cull_mode(material->cullMode);
 
     // Rendering the object corresponding to the draw call
     r3d_drawcall(call);
 
-    // Unbind all bound texture maps
-    r3d_shader_unbind_sampler2D(raster.geometry, uTexAlbedo);
-    r3d_shader_unbind_sampler2D(raster.geometry, uTexNormal);
-    r3d_shader_unbind_sampler2D(raster.geometry, uTexEmission);
-    r3d_shader_unbind_sampler2D(raster.geometry, uTexORM);
+    // Unbind all bound texture maps, unless the cache keeps them for the next call
+    if (!R3D.state.bound.enabled) {
+        r3d_shader_unbind_sampler2D(raster.geometry, uTexAlbedo);
+        r3d_shader_unbind_sampler2D(raster.geometry, uTexNormal);
+        r3d_shader_unbind_sampler2D(raster.geometry, uTexEmission);
+        r3d_shader_unbind_sampler2D(raster.geometry, uTexORM);
+    }
 }
 
 void r3d_drawcall_raster_geometry_inst(const r3d_drawcall_t* call, const Matrix* matVP)
 {
+    const R3D_Material* material = r3d_drawcall_get_material(call);
+
     if (call->instanced.count == 0 || call->instanced.transforms == NULL) {
         return;
     }
@@ -463,23 +660,23 @@ void r3d_drawcall_raster_geometry_inst(const r3d_drawcall_t* call, const Matrix*
     r3d_shader_set_mat4(raster.geometryInst, uMatVP, *matVP);
 
     // Set factor material maps
-    r3d_shader_set_float(raster.geometryInst, uEmissionEnergy, call->material.emission.energy);
-    r3d_shader_set_float(raster.geometryInst, uNormalScale, call->material.normal.scale);
-    r3d_shader_set_float(raster.geometryInst, uOcclusion, call->material.orm.occlusion);
-    r3d_shader_set_float(raster.geometryInst, uRoughness, call->material.orm.roughness);
-    r3d_shader_set_float(raster.geometryInst, uMetalness, call->material.orm.metalness);
+    r3d_shader_set_float(raster.geometryInst, uEmissionEnergy, material->emission.energy);
+    r3d_shader_set_float(raster.geometryInst, uNormalScale, material->normal.scale);
+    r3d_shader_set_float(raster.geometryInst, uOcclusion, material->orm.occlusion);
+    r3d_shader_set_float(raster.geometryInst, uRoughness, material->orm.roughness);
+    r3d_shader_set_float(raster.geometryInst, uMetalness, material->orm.metalness);
 
     // Set texcoord offset/scale
-    r3d_shader_set_vec2(raster.geometryInst, uTexCoordOffset, call->material.uvOffset);
-    r3d_shader_set_vec2(raster.geometryInst, uTexCoordScale, call->material.uvScale);
+    r3d_shader_set_vec2(raster.geometryInst, uTexCoordOffset, material->uvOffset);
+    r3d_shader_set_vec2(raster.geometryInst, uTexCoordScale, material->uvScale);
 
     // Set color material maps
-    r3d_shader_set_col3(raster.geometryInst, uAlbedoColor, call->material.albedo.color);
-    r3d_shader_set_col3(raster.geometryInst, uEmissionColor, call->material.emission.color);
+    r3d_shader_set_col3(raster.geometryInst, uAlbedoColor, material->albedo.color);
+    r3d_shader_set_col3(raster.geometryInst, uEmissionColor, material->emission.color);
 
     // Setup billboard mode
-    r3d_shader_set_int(raster.geometryInst, uBillboardMode, call->material.billboardMode);
-    if (call->material.billboardMode != R3D_BILLBOARD_DISABLED) {
+    r3d_shader_set_int(raster.geometryInst, uBillboardMode, material->billboardMode);
+    if (material->billboardMode != R3D_BILLBOARD_DISABLED) {
         r3d_shader_set_mat4(raster.geometryInst, uMatInvView, R3D.state.transform.invView);
     }
 
@@ -488,9 +685,10 @@ void r3d_drawcall_raster_geometry_inst(const r3d_drawcall_t* call, const Matrix*
     case R3D_DRAWCALL_GEOMETRY_MODEL:
         {
             // Send bone matrices and animation related data
-            if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL) {
+            if (r3d_drawcall_is_skinned(call) && call->geometry.model.boneStorage >= 0) {
                 r3d_shader_set_int(raster.geometryInst, uUseSkinning, true);
-                r3d_drawcall_upload_matrices(call);
+                r3d_shader_set_int(raster.geometryInst, uBoneOffset, call->geometry.model.boneStorage);
+                r3d_drawcall_bind_matrices();
             }
             else {
                 r3d_shader_set_int(raster.geometryInst, uUseSkinning, false);
@@ -506,16 +704,16 @@ void r3d_drawcall_raster_geometry_inst(const r3d_drawcall_t* call, const Matrix*
     }
 
     // Bind active texture maps
-    r3d_shader_bind_sampler2D_opt(raster.geometryInst, uTexAlbedo, call->material.albedo.texture.id, white);
-    r3d_shader_bind_sampler2D_opt(raster.geometryInst, uTexNormal, call->material.normal.texture.id, normal);
-    r3d_shader_bind_sampler2D_opt(raster.geometryInst, uTexEmission, call->material.emission.texture.id, black);
-    r3d_shader_bind_sampler2D_opt(raster.geometryInst, uTexORM, call->material.orm.texture.id, white);
+    r3d_shader_bind_sampler2D_opt(raster.geometryInst, uTexAlbedo, material->albedo.texture.id, white);
+    r3d_shader_bind_sampler2D_opt(raster.geometryInst, uTexNormal, material->normal.texture.id, normal);
+    r3d_shader_bind_sampler2D_opt(raster.geometryInst, uTexEmission, material->emission.texture.id, black);
+    r3d_shader_bind_sampler2D_opt(raster.geometryInst, uTexORM, material->orm.texture.id, white);
 
     // Applying material parameters that are independent of shaders
-    r3d_drawcall_apply_cull_mode(call->material.cullMode);
+    r3d_drawcall_apply_cull_mode(material->cullMode);
 
     // Rendering the objects corresponding to the draw call
-    r3d_drawcall_instanced(call, 10, 14);
+    r3d_drawcall_instanced(call, matVP, 10, 14);
 
     // Unbind all bound texture maps
     r3d_shader_unbind_sampler2D(raster.geometryInst, uTexAlbedo);
@@ -526,6 +724,8 @@ void r3d_drawcall_raster_geometry_inst(const r3d_drawcall_t* call, const Matrix*
 
 void r3d_drawcall_raster_forward(const r3d_drawcall_t* call, const Matrix* matVP)
 {
+    const R3D_Material* material = r3d_drawcall_get_material(call);
+
     // Calculate normal and MVP matrices
     Matrix matNormal = r3d_matrix_normal(&call->transform);
     Matrix matMVP = r3d_matrix_multiply(&call->transform, matVP);
@@ -536,37 +736,38 @@ void r3d_drawcall_raster_forward(const r3d_drawcall_t* call, const Matrix* matVP
     r3d_shader_set_mat4(raster.forward, uMatMVP, matMVP);
 
     // Set factor material maps
-    r3d_shader_set_float(raster.forward, uEmissionEnergy, call->material.emission.energy);
-    r3d_shader_set_float(raster.forward, uNormalScale, call->material.normal.scale);
-    r3d_shader_set_float(raster.forward, uOcclusion, call->material.orm.occlusion);
-    r3d_shader_set_float(raster.forward, uRoughness, call->material.orm.roughness);
-    r3d_shader_set_float(raster.forward, uMetalness, call->material.orm.metalness);
+    r3d_shader_set_float(raster.forward, uEmissionEnergy, material->emission.energy);
+    r3d_shader_set_float(raster.forward, uNormalScale, material->normal.scale);
+    r3d_shader_set_float(raster.forward, uOcclusion, material->orm.occlusion);
+    r3d_shader_set_float(raster.forward, uRoughness, material->orm.roughness);
+    r3d_shader_set_float(raster.forward, uMetalness, material->orm.metalness);
 
     // Set misc material values
-    r3d_shader_set_float(raster.forward, uAlphaCutoff, call->material.alphaCutoff);
+    r3d_shader_set_float(raster.forward, uAlphaCutoff, material->alphaCutoff);
 
     // Set texcoord offset/scale
-    r3d_shader_set_vec2(raster.forward, uTexCoordOffset, call->material.uvOffset);
-    r3d_shader_set_vec2(raster.forward, uTexCoordScale, call->material.uvScale);
+    r3d_shader_set_vec2(raster.forward, uTexCoordOffset, material->uvOffset);
+    r3d_shader_set_vec2(raster.forward, uTexCoordScale, material->uvScale);
 
     // Set color material maps
-    r3d_shader_set_col4(raster.forward, uAlbedoColor, call->material.albedo.color);
-    r3d_shader_set_col3(raster.forward, uEmissionColor, call->material.emission.color);
+    r3d_shader_set_col4(raster.forward, uAlbedoColor, material->albedo.color);
+    r3d_shader_set_col3(raster.forward, uEmissionColor, material->emission.color);
 
     // Bind active texture maps
-    r3d_shader_bind_sampler2D_opt(raster.forward, uTexAlbedo, call->material.albedo.texture.id, white);
-    r3d_shader_bind_sampler2D_opt(raster.forward, uTexNormal, call->material.normal.texture.id, normal);
-    r3d_shader_bind_sampler2D_opt(raster.forward, uTexEmission, call->material.emission.texture.id, black);
-    r3d_shader_bind_sampler2D_opt(raster.forward, uTexORM, call->material.orm.texture.id, white);
+    r3d_drawcall_bind_sampler2D_opt(raster.forward, uTexAlbedo, material->albedo.texture.id, white);
+    r3d_drawcall_bind_sampler2D_opt(raster.forward, uTexNormal, material->normal.texture.id, normal);
+    r3d_drawcall_bind_sampler2D_opt(raster.forward, uTexEmission, material->emission.texture.id, black);
+    r3d_drawcall_bind_sampler2D_opt(raster.forward, uTexORM, material->orm.texture.id, white);
 
     // Setup geometry type related uniforms
     switch (call->geometryType) {
     case R3D_DRAWCALL_GEOMETRY_MODEL:
         {
             // Send bone matrices and animation related data
-            if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL) {
+            if (r3d_drawcall_is_skinned(call) && call->geometry.model.boneStorage >= 0) {
                 r3d_shader_set_int(raster.forward, uUseSkinning, true);
-                r3d_drawcall_upload_matrices(call);
+                r3d_shader_set_int(raster.forward, uBoneOffset, call->geometry.model.boneStorage);
+                r3d_drawcall_bind_matrices();
             }
             else {
                 r3d_shader_set_int(raster.forward, uUseSkinning, false);
@@ -582,21 +783,25 @@ void r3d_drawcall_raster_forward(const r3d_drawcall_t* call, const Matrix* matVP
     }
 
     // Applying material parameters that are independent of shaders
-    r3d_drawcall_apply_cull_mode(call->material.cullMode);
-    r3d_drawcall_apply_blend_mode(call->material.blendMode);
+    r3d_drawcall_apply_cull_mode(material->cullMode);
+    r3d_drawcall_apply_blend_mode(material->blendMode);
 
     // Rendering the object corresponding to the draw call
     r3d_drawcall(call);
 
-    // Unbind all bound texture maps
-    r3d_shader_unbind_sampler2D(raster.forward, uTexAlbedo);
-    r3d_shader_unbind_sampler2D(raster.forward, uTexNormal);
-    r3d_shader_unbind_sampler2D(raster.forward, uTexEmission);
-    r3d_shader_unbind_sampler2D(raster.forward, uTexORM);
+    // Unbind all bound texture maps, unless the cache keeps them for the next call
+    if (!R3D.state.bound.enabled) {
+        r3d_shader_unbind_sampler2D(raster.forward, uTexAlbedo);
+        r3d_shader_unbind_sampler2D(raster.forward, uTexNormal);
+        r3d_shader_unbind_sampler2D(raster.forward, uTexEmission);
+        r3d_shader_unbind_sampler2D(raster.forward, uTexORM);
+    }
 }
 
 void r3d_drawcall_raster_forward_inst(const r3d_drawcall_t* call, const Matrix* matVP)
 {
+    const R3D_Material* material = r3d_drawcall_get_material(call);
+
     if (call->instanced.count == 0 || call->instanced.transforms == NULL) {
         return;
     }
@@ -606,26 +811,26 @@ void r3d_drawcall_raster_forward_inst(const r3d_drawcall_t* call, const Matrix*
     r3d_shader_set_mat4(raster.forwardInst, uMatVP, *matVP);
 
     // Set factor material maps
-    r3d_shader_set_float(raster.forwardInst, uEmissionEnergy, call->material.emission.energy);
-    r3d_shader_set_float(raster.forwardInst, uNormalScale, call->material.normal.scale);
-    r3d_shader_set_float(raster.forwardInst, uOcclusion, call->material.orm.occlusion);
-    r3d_shader_set_float(raster.forwardInst, uRoughness, call->material.orm.roughness);
-    r3d_shader_set_float(raster.forwardInst, uMetalness, call->material.orm.metalness);
+    r3d_shader_set_float(raster.forwardInst, uEmissionEnergy, material->emission.energy);
+    r3d_shader_set_float(raster.forwardInst, uNormalScale, material->normal.scale);
+    r3d_shader_set_float(raster.forwardInst, uOcclusion, material->orm.occlusion);
+    r3d_shader_set_float(raster.forwardInst, uRoughness, material->orm.roughness);
+    r3d_shader_set_float(raster.forwardInst, uMetalness, material->orm.metalness);
 
     // Set misc material values
-    r3d_shader_set_float(raster.forwardInst, uAlphaCutoff, call->material.alphaCutoff);
+    r3d_shader_set_float(raster.forwardInst, uAlphaCutoff, material->alphaCutoff);
 
     // Set texcoord offset/scale
-    r3d_shader_set_vec2(raster.forwardInst, uTexCoordOffset, call->material.uvOffset);
-    r3d_shader_set_vec2(raster.forwardInst, uTexCoordScale, call->material.uvScale);
+    r3d_shader_set_vec2(raster.forwardInst, uTexCoordOffset, material->uvOffset);
+    r3d_shader_set_vec2(raster.forwardInst, uTexCoordScale, material->uvScale);
 
     // Set color material maps
-    r3d_shader_set_col4(raster.forwardInst, uAlbedoColor, call->material.albedo.color);
-    r3d_shader_set_col3(raster.forwardInst, uEmissionColor, call->material.emission.color);
+    r3d_shader_set_col4(raster.forwardInst, uAlbedoColor, material->albedo.color);
+    r3d_shader_set_col3(raster.forwardInst, uEmissionColor, material->emission.color);
 
     // Setup billboard mode
-    r3d_shader_set_int(raster.forwardInst, uBillboardMode, call->material.billboardMode);
-    if (call->material.billboardMode != R3D_BILLBOARD_DISABLED) {
+    r3d_shader_set_int(raster.forwardInst, uBillboardMode, material->billboardMode);
+    if (material->billboardMode != R3D_BILLBOARD_DISABLED) {
         r3d_shader_set_mat4(raster.forwardInst, uMatInvView, R3D.state.transform.invView);
     }
 
@@ -634,9 +839,10 @@ void r3d_drawcall_raster_forward_inst(const r3d_drawcall_t* call, const Matrix*
     case R3D_DRAWCALL_GEOMETRY_MODEL:
         {
             // Send bone matrices and animation related data
-            if (call->geometry.model.anim != NULL && call->geometry.model.boneOffsets != NULL) {
+            if (r3d_drawcall_is_skinned(call) && call->geometry.model.boneStorage >= 0) {
                 r3d_shader_set_int(raster.forwardInst, uUseSkinning, true);
-                r3d_drawcall_upload_matrices(call);
+                r3d_shader_set_int(raster.forwardInst, uBoneOffset, call->geometry.model.boneStorage);
+                r3d_drawcall_bind_matrices();
             }
             else {
                 r3d_shader_set_int(raster.forwardInst, uUseSkinning, false);
@@ -652,17 +858,17 @@ void r3d_drawcall_raster_forward_inst(const r3d_drawcall_t* call, const Matrix*
     }
 
     // Bind active texture maps
-    r3d_shader_bind_sampler2D_opt(raster.forwardInst, uTexAlbedo, call->material.albedo.texture.id, white);
-    r3d_shader_bind_sampler2D_opt(raster.forwardInst, uTexNormal, call->material.normal.texture.id, normal);
-    r3d_shader_bind_sampler2D_opt(raster.forwardInst, uTexEmission, call->material.emission.texture.id, black);
-    r3d_shader_bind_sampler2D_opt(raster.forwardInst, uTexORM, call->material.orm.texture.id, white);
+    r3d_shader_bind_sampler2D_opt(raster.forwardInst, uTexAlbedo, material->albedo.texture.id, white);
+    r3d_shader_bind_sampler2D_opt(raster.forwardInst, uTexNormal, material->normal.texture.id, normal);
+    r3d_shader_bind_sampler2D_opt(raster.forwardInst, uTexEmission, material->emission.texture.id, black);
+    r3d_shader_bind_sampler2D_opt(raster.forwardInst, uTexORM, material->orm.texture.id, white);
 
     // Applying material parameters that are independent of shaders
-    r3d_drawcall_apply_cull_mode(call->material.cullMode);
-    r3d_drawcall_apply_blend_mode(call->material.blendMode);
+    r3d_drawcall_apply_cull_mode(material->cullMode);
+    r3d_drawcall_apply_blend_mode(material->blendMode);
 
     // Rendering the objects corresponding to the draw call
-    r3d_drawcall_instanced(call, 10, 14);
+    r3d_drawcall_instanced(call, matVP, 10, 14);
 
     // Unbind all bound texture maps
     r3d_shader_unbind_sampler2D(raster.forwardInst, uTexAlbedo);
@@ -799,28 +1005,79 @@ static void r3d_drawcall_unbind_geometry_mesh(void)
 void r3d_drawcall(const r3d_drawcall_t* call)
 {
     if (call->geometryType == R3D_DRAWCALL_GEOMETRY_MODEL) {
-        r3d_drawcall_bind_geometry_mesh(call->geometry.model.mesh);
-        if (call->geometry.model.mesh->indices == NULL) {
-            glDrawArrays(GL_TRIANGLES, 0, call->geometry.model.mesh->vertexCount);
+        const R3D_Mesh* mesh = call->geometry.model.mesh;
+        bool cached = R3D.state.bound.enabled;
+        if (call->geometry.model.skinnedVao != 0) {
+            // NOTE: The skinned vertices are specific to the call, the next mesh must be bound again
+            glBindVertexArray(call->geometry.model.skinnedVao);
+            R3D.state.bound.mesh = NULL;
+        }
+        else if (!cached || R3D.state.bound.mesh != mesh) {
+            r3d_drawcall_bind_geometry_mesh(mesh);
+            if (cached) {
+                R3D.state.bound.mesh = mesh;
+                R3D.state.bound.stats.meshBinds++;
+            }
         }
         else {
-            glDrawElements(GL_TRIANGLES, call->geometry.model.mesh->indexCount, GL_UNSIGNED_INT, NULL);
+            R3D.state.bound.stats.meshBindsSkipped++;
+        }
+        if (mesh->indices == NULL) {
+            glDrawArrays(GL_TRIANGLES, 0, mesh->vertexCount);
+        }
+        else {
+            glDrawElements(GL_TRIANGLES, mesh->indexCount, GL_UNSIGNED_INT, NULL);
+        }
+        if (!cached) {
+            r3d_drawcall_unbind_geometry_mesh();
         }
-        r3d_drawcall_unbind_geometry_mesh();
     }
 
     // Sprite mode only requires to render a generic quad
     else if (call->geometryType == R3D_DRAWCALL_GEOMETRY_SPRITE) {
         r3d_primitive_bind_and_draw_quad();
+        R3D.state.bound.mesh = NULL;
     }
 }
 
-void r3d_drawcall_instanced(const r3d_drawcall_t* call, int locInstanceModel, int locInstanceColor)
+void r3d_drawcall_bind_texture2D(int slot, GLuint texId)
+{
+    if (R3D.state.bound.enabled && slot < R3D_BIND_CACHE_TEXTURE_UNITS) {
+        if (R3D.state.bound.texture2D[slot] == texId) {
+            R3D.state.bound.stats.textureBindsSkipped++;
+            return;
+        }
+        R3D.state.bound.texture2D[slot] = texId;
+        R3D.state.bound.stats.textureBinds++;
+    }
+
+    glActiveTexture(GL_TEXTURE0 + slot);
+    glBindTexture(GL_TEXTURE_2D, texId);
+}
+
+void r3d_drawcall_instanced(const r3d_drawcall_t* call, const Matrix* matVP, int locInstanceModel, int locInstanceColor)
 {
+    // Get the instance data, possibly reduced to the visible instances
+    const void* transforms = call->instanced.transforms;
+    const void* colors = (locInstanceColor >= 0) ? call->instanced.colors : NULL;
+    size_t transStride = (call->instanced.transStride == 0) ? sizeof(Matrix) : call->instanced.transStride;
+    size_t colStride = (call->instanced.colStride == 0) ? sizeof(Color) : call->instanced.colStride;
+
+    int count = r3d_drawcall_cull_instances(call, matVP, &transforms, &transStride, &colors, &colStride);
+    if (count <= 0) return;
+
+    // The data streamed for the whole frame can be used as is, unless the culling has compacted it
+    bool useStreamed = call->instanced.streamed && (transforms == call->instanced.transforms);
+
     // Bind the geometry
     switch (call->geometryType) {
     case R3D_DRAWCALL_GEOMETRY_MODEL:
-        r3d_drawcall_bind_geometry_mesh(call->geometry.model.mesh);
+        if (call->geometry.model.skinnedVao != 0) {
+            glBindVertexArray(call->geometry.model.skinnedVao);
+        }
+        else {
+            r3d_drawcall_bind_geometry_mesh(call->geometry.model.mesh);
+        }
         break;
     case R3D_DRAWCALL_GEOMETRY_SPRITE:
         r3d_primitive_bind(&R3D.primitive.quad);
@@ -837,16 +1094,28 @@ void r3d_drawcall_instanced(const r3d_drawcall_t* call, int locInstanceModel, in
     unsigned int vboTransforms = 0;
     unsigned int vboColors = 0;
 
+    bool hasTransforms = false;
+    bool hasColors = false;
+
     // Enable the attribute for the transformation matrix (decomposed into 4 vec4 vectors)
-    if (locInstanceModel >= 0 && call->instanced.transforms) {
-        size_t stride = (call->instanced.transStride == 0) ? sizeof(Matrix) : call->instanced.transStride;
-        vboTransforms = rlLoadVertexBuffer(call->instanced.transforms, (int)(call->instanced.count * stride), true);
-        rlEnableVertexBuffer(vboTransforms);
+    if (locInstanceModel >= 0 && transforms) {
+        size_t offset = call->instanced.streamTransforms;
+        if (useStreamed || r3d_drawcall_stream_array(transforms, transStride, sizeof(Matrix), count, &offset)) {
+            rlEnableVertexBuffer(R3D.storage.stream.buffer);
+            transStride = sizeof(Matrix);
+        }
+        else {
+            // NOTE: The streaming buffer is full for this frame, it will be grown at the next one
+            vboTransforms = rlLoadVertexBuffer(transforms, (int)(count * transStride), true);
+            rlEnableVertexBuffer(vboTransforms);
+            offset = 0;
+        }
         for (int i = 0; i < 4; i++) {
-            rlSetVertexAttribute(locInstanceModel + i, 4, RL_FLOAT, false, (int)stride, i * sizeof(Vector4));
+            rlSetVertexAttribute(locInstanceModel + i, 4, RL_FLOAT, false, (int)transStride, (int)(offset + i * sizeof(Vector4)));
             rlSetVertexAttributeDivisor(locInstanceModel + i, 1);
             rlEnableVertexAttribute(locInstanceModel + i);
         }
+        hasTransforms = true;
     }
     else if (locInstanceModel >= 0) {
         const float defaultTransform[4 * 4] = {
@@ -862,13 +1131,21 @@ void r3d_drawcall_instanced(const r3d_drawcall_t* call, int locInstanceModel, in
     }
 
     // Handle per-instance colors if available
-    if (locInstanceColor >= 0 && call->instanced.colors) {
-        size_t stride = (call->instanced.colStride == 0) ? sizeof(Color) : call->instanced.colStride;
-        vboColors = rlLoadVertexBuffer(call->instanced.colors, (int)(call->instanced.count * stride), true);
-        rlEnableVertexBuffer(vboColors);
-        rlSetVertexAttribute(locInstanceColor, 4, RL_UNSIGNED_BYTE, true, (int)call->instanced.colStride, 0);
+    if (locInstanceColor >= 0 && colors) {
+        size_t offset = call->instanced.streamColors;
+        if (useStreamed || r3d_drawcall_stream_array(colors, colStride, sizeof(Color), count, &offset)) {
+            rlEnableVertexBuffer(R3D.storage.stream.buffer);
+            colStride = sizeof(Color);
+        }
+        else {
+            vboColors = rlLoadVertexBuffer(colors, (int)(count * colStride), true);
+            rlEnableVertexBuffer(vboColors);
+            offset = 0;
+        }
+        rlSetVertexAttribute(locInstanceColor, 4, RL_UNSIGNED_BYTE, true, (int)colStride, (int)offset);
         rlSetVertexAttributeDivisor(locInstanceColor, 1);
         rlEnableVertexAttribute(locInstanceColor);
+        hasColors = true;
     }
     else if (locInstanceColor >= 0) {
         const float defaultColor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
@@ -880,29 +1157,33 @@ void r3d_drawcall_instanced(const r3d_drawcall_t* call, int locInstanceModel, in
     switch (call->geometryType) {
     case R3D_DRAWCALL_GEOMETRY_MODEL:
         if (call->geometry.model.mesh->indices == NULL) {
-            glDrawArraysInstanced(GL_TRIANGLES, 0, call->geometry.model.mesh->vertexCount, (int)call->instanced.count);
+            glDrawArraysInstanced(GL_TRIANGLES, 0, call->geometry.model.mesh->vertexCount, count);
         }
         else {
-            glDrawElementsInstanced(GL_TRIANGLES, call->geometry.model.mesh->indexCount, GL_UNSIGNED_INT, NULL, (int)call->instanced.count);
+            glDrawElementsInstanced(GL_TRIANGLES, call->geometry.model.mesh->indexCount, GL_UNSIGNED_INT, NULL, count);
         }
         break;
     case R3D_DRAWCALL_GEOMETRY_SPRITE:
-        r3d_primitive_draw_instanced(&R3D.primitive.quad, (int)call->instanced.count);
+        r3d_primitive_draw_instanced(&R3D.primitive.quad, count);
         break;
     }
 
     // Clean up instanced data
-    if (vboTransforms > 0) {
+    if (hasTransforms) {
         for (int i = 0; i < 4; i++) {
             rlDisableVertexAttribute(locInstanceModel + i);
             rlSetVertexAttributeDivisor(locInstanceModel + i, 0);
         }
-        rlUnloadVertexBuffer(vboTransforms);
+        if (vboTransforms > 0) {
+            rlUnloadVertexBuffer(vboTransforms);
+        }
     }
-    if (vboColors > 0) {
+    if (hasColors) {
         rlDisableVertexAttribute(locInstanceColor);
         rlSetVertexAttributeDivisor(locInstanceColor, 0);
-        rlUnloadVertexBuffer(vboColors);
+        if (vboColors > 0) {
+            rlUnloadVertexBuffer(vboColors);
+        }
     }
 
     // Unbind the geometry
@@ -916,6 +1197,115 @@ void r3d_drawcall_instanced(const r3d_drawcall_t* call, int locInstanceModel, in
     }
 }
 
+int r3d_drawcall_cull_instances(const r3d_drawcall_t* call, const Matrix* matVP,
+                                const void** transforms, size_t* transStride,
+                                const void** colors, size_t* colStride)
+{
+    int count = (int)call->instanced.count;
+
+    // NOTE: Billboard instances are oriented in the vertex shader, their boxes
+    //       cannot be known here, and sprites have no mesh box to test against
+    if (!(R3D.state.flags & R3D_FLAG_INSTANCE_CULLING) || *transforms == NULL || count <= 0 ||
+        call->geometryType != R3D_DRAWCALL_GEOMETRY_MODEL ||
+        r3d_drawcall_get_material(call)->billboardMode != R3D_BILLBOARD_DISABLED) {
+        return count;
+    }
+
+    /* --- Reserve the scratch buffers, the culling kernel works on words of 32 boxes --- */
+
+    int paddedCount = (count + 31) & ~31;
+
+    if (r3d_array_reserve(&R3D.container.aInstBoxes, 6 * (size_t)paddedCount) < 0 ||
+        r3d_array_reserve(&R3D.container.aInstMask, paddedCount / 32) < 0 ||
+        r3d_array_reserve(&R3D.container.aInstTransforms, count) < 0 ||
+        (*colors != NULL && r3d_array_reserve(&R3D.container.aInstColors, count) < 0)) {
+        TraceLog(LOG_ERROR, "R3D: Failed to reserve the instance culling buffers, all instances will be drawn");
+        return count;
+    }
+
+    float* boxes = R3D.container.aInstBoxes.data;
+    uint32_t* mask = R3D.container.aInstMask.data;
+
+    r3d_aabb_soa_t soa = {
+        .centerX = boxes + 0 * paddedCount,
+        .centerY = boxes + 1 * paddedCount,
+        .centerZ = boxes + 2 * paddedCount,
+        .extentX = boxes + 3 * paddedCount,
+        .extentY = boxes + 4 * paddedCount,
+        .extentZ = boxes + 5 * paddedCount
+    };
+
+    for (int i = 0; i < 6; i++) {
+        memset(boxes + i * paddedCount + count, 0, (paddedCount - count) * sizeof(float));
+    }
+
+    /* --- Test the instance boxes against the frustum --- */
+
+    // NOTE: The frustum is extracted from the MVP matrix, so its planes are expressed
+    //       in the space of the draw call and only the instance transforms are applied
+
+    Matrix matMVP = r3d_matrix_multiply(&call->transform, matVP);
+    r3d_frustum_t frustum = r3d_frustum_create(matMVP);
+
+    const BoundingBox* aabb = &call->geometry.model.mesh->aabb;
+    const unsigned char* srcTransforms = *transforms;
+
+    for (int i = 0; i < count; i++) {
+        Matrix transform;
+        memcpy(&transform, srcTransforms + i * (*transStride), sizeof(Matrix));
+        r3d_aabb_soa_set(&soa, i, aabb, &transform);
+    }
+
+    r3d_frustum_cull_aabb_soa(&frustum, &soa, 0, count, mask);
+
+    /* --- Compact the visible instances, in their original order --- */
+
+    const unsigned char* srcColors = *colors;
+    Matrix* dstTransforms = R3D.container.aInstTransforms.data;
+    Color* dstColors = R3D.container.aInstColors.data;
+
+    int visible = 0;
+
+    for (int i = 0; i < count; i++) {
+        if ((mask[i >> 5] & (1u << (i & 31))) == 0) continue;
+        memcpy(&dstTransforms[visible], srcTransforms + i * (*transStride), sizeof(Matrix));
+        if (srcColors != NULL) {
+            memcpy(&dstColors[visible], srcColors + i * (*colStride), sizeof(Color));
+        }
+        visible++;
+    }
+
+    *transforms = dstTransforms;
+    *transStride = sizeof(Matrix);
+
+    if (srcColors != NULL) {
+        *colors = dstColors;
+        *colStride = sizeof(Color);
+    }
+
+    return visible;
+}
+
+bool r3d_drawcall_stream_array(const void* data, size_t stride, size_t elemSize, int count, size_t* offset)
+{
+    unsigned char* dst = r3d_stream_map(&R3D.storage.stream, count * elemSize, offset);
+    if (dst == NULL) return false;
+
+    if (stride == elemSize) {
+        memcpy(dst, data, count * elemSize);
+    }
+    else {
+        const unsigned char* src = data;
+        for (int i = 0; i < count; i++) {
+            memcpy(dst + i * elemSize, src + i * stride, elemSize);
+        }
+    }
+
+    r3d_stream_unmap(&R3D.storage.stream);
+
+    return true;
+}
+
 // Helper function to calculate AABB center distance in view space
 static float r3d_drawcall_calculate_center_distance_to_camera(const r3d_drawcall_t* drawCall)
 {
@@ -969,77 +1359,8 @@ static float r3d_drawcall_calculate_max_distance_to_camera(const r3d_drawcall_t*
     return maxDistSq;
 }
 
-// Comparison function for opaque objects (front-to-back, using center distance)
-int r3d_drawcall_compare_front_to_back(const void* a, const void* b)
-{
-    const r3d_drawcall_t* drawCallA = a;
-    const r3d_drawcall_t* drawCallB = b;
-
-    float distA = r3d_drawcall_calculate_center_distance_to_camera(drawCallA);
-    float distB = r3d_drawcall_calculate_center_distance_to_camera(drawCallB);
-
-    // Front-to-back: smaller distance first
-    return (distA > distB) - (distA < distB);
-}
-
-// Comparison function for transparent objects (back-to-front, using max distance with fallback)
-int r3d_drawcall_compare_back_to_front(const void* a, const void* b)
-{
-    const r3d_drawcall_t* drawCallA = a;
-    const r3d_drawcall_t* drawCallB = b;
-    
-    const float EPSILON_SQ = 0.001f * 0.001f;
-
-    // Sort by max distance
-    float maxDistA = r3d_drawcall_calculate_max_distance_to_camera(drawCallA);
-    float maxDistB = r3d_drawcall_calculate_max_distance_to_camera(drawCallB);
-    
-    float distDiff = maxDistA - maxDistB;
-    if (fabsf(distDiff) >= EPSILON_SQ) {
-        // Back-to-front: larger distance first
-        return (maxDistA < maxDistB) - (maxDistA > maxDistB);
-    }
-
-    // Secondary: sort by center distance
-    float centerDistA = r3d_drawcall_calculate_center_distance_to_camera(drawCallA);
-    float centerDistB = r3d_drawcall_calculate_center_distance_to_camera(drawCallB);
-    
-    float centerDiff = centerDistA - centerDistB;
-    if (fabsf(centerDiff) >= EPSILON_SQ) {
-        // Back-to-front: larger distance first
-        return (centerDistA < centerDistB) - (centerDistA > centerDistB);
-    }
-
-    // Tertiary: deterministic fallback using pointer comparison
-    return (drawCallA < drawCallB) - (drawCallA > drawCallB);
-}
-
-// Comparison function for forward objects (opaque/transparent mixed, front-to-back or back-to-front)
-int r3d_drawcall_compare_mixed_forward(const void* a, const void* b)
-{
-    const r3d_drawcall_t* drawCallA = a;
-    const r3d_drawcall_t* drawCallB = b;
-
-    // Assume there's a way to check if a drawcall is opaque
-    // You'll need to implement this based on your blend mode system
-    bool isOpaqueA = (drawCallA->material.blendMode == R3D_BLEND_OPAQUE);
-    bool isOpaqueB = (drawCallB->material.blendMode == R3D_BLEND_OPAQUE);
-
-    // If one is opaque and the other is not, opaque comes first
-    if (isOpaqueA && !isOpaqueB) return -1;
-    if (!isOpaqueA && isOpaqueB) return +1;
-
-    // If both are opaque, sort front-to-back
-    if (isOpaqueA && isOpaqueB) {
-        return r3d_drawcall_compare_front_to_back(a, b);
-    }
-
-    // If both are transparent, sort back-to-front
-    return r3d_drawcall_compare_back_to_front(a, b);
-}
-
-// Upload matrices function
-static void r3d_drawcall_upload_matrices(const r3d_drawcall_t* call)
+// Bind matrices function
+static void r3d_drawcall_bind_matrices(void)
 {
     // WARNING: Pay attention to any changes in the binding slot for uTexBoneMatrices.
     //          In theory, being the only texture sampled in the vertex shader,
@@ -1047,18 +1368,5 @@ static void r3d_drawcall_upload_matrices(const r3d_drawcall_t* call)
 
     const int bindingSlot = 0;
 
-    if (call->geometry.model.boneOverride == NULL) {
-        r3d_storage_bind_and_upload_matrices(
-            call->geometry.model.mesh->boneMatrices,
-            call->geometry.model.mesh->boneCount,
-            bindingSlot
-        );
-    }
-    else {
-        r3d_storage_bind_and_upload_matrices(
-            call->geometry.model.boneOverride,
-            call->geometry.model.anim->boneCount,
-            bindingSlot
-        );
-    }
+    r3d_drawcall_bind_texture2D(bindingSlot, R3D.storage.texMatrices);
 }
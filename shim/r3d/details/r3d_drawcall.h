@@ -21,6 +21,7 @@
 #define R3D_DETAILS_DRAWCALL_H
 
 #include <stddef.h>
+#include <stdint.h>
 #include <raylib.h>
 #include <r3d.h>
 
@@ -39,7 +40,8 @@ typedef enum {
 typedef struct {
 
     Matrix transform;
-    R3D_Material material;
+    unsigned int material;              //< ID of the interned material (see 'r3d_drawcall_set_material')
+    uint32_t materialVersion;           //< Version of the interned material, to detect when the ID has been reused
     R3D_ShadowCastMode shadowCastMode;
 
     r3d_drawcall_geometry_e geometryType;
@@ -52,7 +54,15 @@ typedef struct {
             const R3D_ModelAnimation* anim;     //< Animation to apply to the mesh (can be NULL)
             const Matrix* boneOffsets;          //< Bone offset matrices from the R3D_Model
             const Matrix* boneOverride;         //< Bone override matrices for user supplied animation logic  
+            const Matrix* boneMatrices;         //< Bone matrices computed for this frame, shared by the calls with the same pose
             int frame;                          //< Animation frame to apply to the mesh
+            float frameFraction;                //< Position between 'frame' and the next frame, only used by compressed animations
+            const R3D_AnimationLayer* layers;   //< Layers blended instead of 'anim', which is then the first layer animation
+            int layerCount;
+            int boneDepth;                      //< Depth limit of the evaluated bones given by the animation LOD, -1 to evaluate all the bones
+            bool heldPose;                      //< The animation LOD holds the pose for several frames, it can be reused from the previous frame
+            int boneStorage;                    //< Offset of the bone matrices in the storage atlas, -1 if they could not be uploaded
+            unsigned int skinnedVao;            //< Vertex array of the vertices skinned by the prepass, 0 if each pass skins the mesh
         } model;
 
         struct {
@@ -68,20 +78,51 @@ typedef struct {
         size_t transStride;
         size_t colStride;
         size_t count;
+        bool streamed;              //< True once the instance data has been written in the streaming buffer
+        size_t streamTransforms;    //< Offset of the packed transforms in the streaming buffer
+        size_t streamColors;        //< Offset of the packed colors in the streaming buffer, if 'colors' is not NULL
     } instanced;
 
+    // Lights of the forward calls, filled each frame before rendering
+    struct {
+        int offset;                 //< Offset of the list of lights without shadows in the light indices storage
+        int count;                  //< Number of lights without shadows touching the call, 0 when shaded from the clusters
+        int shadowOffset;           //< Offset of the shadow casting lights of the call in 'aShadowLightLists'
+        int shadowCount;
+    } lights;
+
 } r3d_drawcall_t;
 
 /* === Functions === */
 
-void r3d_drawcall_sort_front_to_back(r3d_drawcall_t* calls, size_t count);
-void r3d_drawcall_sort_back_to_front(r3d_drawcall_t* calls, size_t count);
-void r3d_drawcall_sort_mixed_forward(r3d_drawcall_t* calls, size_t count);
+// Interns the material and stores its handle in the call, NULL uses the default material
+void r3d_drawcall_set_material(r3d_drawcall_t* call, const R3D_Material* material);
+const R3D_Material* r3d_drawcall_get_material(const r3d_drawcall_t* call);
+
+// Fill 'order' with the indices of the calls in drawing order, the calls themselves are not moved
+// NOTE: 'keys' and 'order' must have room for '2 * count' elements, the second half is used as scratch
+void r3d_drawcall_sort_front_to_back(const r3d_drawcall_t* calls, size_t count, uint64_t* keys, uint32_t* order);
+void r3d_drawcall_sort_back_to_front(const r3d_drawcall_t* calls, size_t count, uint64_t* keys, uint32_t* order);
+void r3d_drawcall_sort_mixed_forward(const r3d_drawcall_t* calls, size_t count, uint64_t* keys, uint32_t* order);
+void r3d_drawcall_sort_by_state(const r3d_drawcall_t* calls, size_t count, uint64_t* keys, uint32_t* order);
+
+// Key grouping the calls by shader variant, then textures, then mesh (the top bit is always zero)
+uint64_t r3d_drawcall_get_state_key(const r3d_drawcall_t* call);
+
+// Enables the bound state cache if 'R3D_FLAG_STATE_SORTING' is set, textures and meshes then stay
+// bound between the calls until 'r3d_drawcall_bind_cache_end' (the shader must not change meanwhile)
+void r3d_drawcall_bind_cache_begin(void);
+void r3d_drawcall_bind_cache_end(void);
+
+// Writes the instance data in the streaming buffer, all the passes of the frame then reference it by offset
+// Does nothing if the data is already streamed, on failure the data will be uploaded by each draw instead
+void r3d_drawcall_stream_instances(r3d_drawcall_t* call);
 
 bool r3d_drawcall_geometry_is_visible(const r3d_drawcall_t* call);
 bool r3d_drawcall_instanced_geometry_is_visible(const r3d_drawcall_t* call);
 
-void r3d_drawcall_update_model_animation(const r3d_drawcall_t* call);
+// True if the call is drawn with GPU skinning, its bone matrices must then be uploaded before the passes
+bool r3d_drawcall_is_skinned(const r3d_drawcall_t* call);
 
 void r3d_drawcall_raster_depth(const r3d_drawcall_t* call, bool forward, bool shadow, const Matrix* matVP);
 void r3d_drawcall_raster_depth_inst(const r3d_drawcall_t* call, bool forward, bool shadow, const Matrix* matVP);
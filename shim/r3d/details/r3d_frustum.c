@@ -18,6 +18,7 @@
  */
 
 #include "./r3d_frustum.h"
+#include "./r3d_simd.h"
 #include "raylib.h"
 
 #include <raymath.h>
@@ -232,3 +233,244 @@ bool r3d_frustum_is_obb_in(const r3d_frustum_t* frustum, const BoundingBox* aabb
     // OBB is at least partially inside all planes
     return true;
 }
+
+r3d_frustum_test_e r3d_frustum_classify_aabb(const r3d_frustum_t* frustum, const BoundingBox* aabb)
+{
+    float xMin = aabb->min.x, yMin = aabb->min.y, zMin = aabb->min.z;
+    float xMax = aabb->max.x, yMax = aabb->max.y, zMax = aabb->max.z;
+
+    r3d_frustum_test_e result = R3D_FRUSTUM_INSIDE;
+
+    for (int i = 0; i < R3D_PLANE_COUNT; i++)
+    {
+        const Vector4* plane = &frustum->planes[i];
+
+        // Corner furthest along the normal, if it's behind the plane the whole box is
+        float distanceMax = r3d_frustum_distance_to_plane(plane, &(Vector3)
+            {
+                .x = (plane->x >= 0.0f) ? xMax : xMin,
+                .y = (plane->y >= 0.0f) ? yMax : yMin,
+                .z = (plane->z >= 0.0f) ? zMax : zMin
+            }
+        );
+
+        if (distanceMax < -EPSILON) {
+            return R3D_FRUSTUM_OUTSIDE;
+        }
+
+        // Opposite corner, if it's behind the plane the box crosses it
+        float distanceMin = r3d_frustum_distance_to_plane(plane, &(Vector3)
+            {
+                .x = (plane->x >= 0.0f) ? xMin : xMax,
+                .y = (plane->y >= 0.0f) ? yMin : yMax,
+                .z = (plane->z >= 0.0f) ? zMin : zMax
+            }
+        );
+
+        if (distanceMin < 0.0f) {
+            result = R3D_FRUSTUM_INTERSECT;
+        }
+    }
+
+    return result;
+}
+
+void r3d_aabb_soa_set(r3d_aabb_soa_t* boxes, int index, const BoundingBox* aabb, const Matrix* transform)
+{
+    float xCenter = (aabb->min.x + aabb->max.x) * 0.5f;
+    float yCenter = (aabb->min.y + aabb->max.y) * 0.5f;
+    float zCenter = (aabb->min.z + aabb->max.z) * 0.5f;
+    float xExtent = (aabb->max.x - aabb->min.x) * 0.5f;
+    float yExtent = (aabb->max.y - aabb->min.y) * 0.5f;
+    float zExtent = (aabb->max.z - aabb->min.z) * 0.5f;
+
+    // Transform the center, and project the extents on the world axes
+    boxes->centerX[index] = transform->m0 * xCenter + transform->m4 * yCenter + transform->m8 * zCenter + transform->m12;
+    boxes->centerY[index] = transform->m1 * xCenter + transform->m5 * yCenter + transform->m9 * zCenter + transform->m13;
+    boxes->centerZ[index] = transform->m2 * xCenter + transform->m6 * yCenter + transform->m10 * zCenter + transform->m14;
+
+    boxes->extentX[index] = fabsf(transform->m0) * xExtent + fabsf(transform->m4) * yExtent + fabsf(transform->m8) * zExtent;
+    boxes->extentY[index] = fabsf(transform->m1) * xExtent + fabsf(transform->m5) * yExtent + fabsf(transform->m9) * zExtent;
+    boxes->extentZ[index] = fabsf(transform->m2) * xExtent + fabsf(transform->m6) * yExtent + fabsf(transform->m10) * zExtent;
+}
+
+void r3d_frustum_cull_aabb_soa(const r3d_frustum_t* frustum, const r3d_aabb_soa_t* boxes, int begin, int end, uint32_t* mask)
+{
+    // NOTE: A box is outside when, for one of the planes, the distance of its center
+    //       plus its extents projected on the plane normal is below zero. Each word
+    //       of the mask is computed with 4 or 8 boxes per iteration depending on the ISA.
+
+    const Vector4* planes = frustum->planes;
+
+#if defined(R3D_HAS_AVX)
+
+    __m256 px[R3D_PLANE_COUNT], py[R3D_PLANE_COUNT], pz[R3D_PLANE_COUNT], pw[R3D_PLANE_COUNT];
+    __m256 ax[R3D_PLANE_COUNT], ay[R3D_PLANE_COUNT], az[R3D_PLANE_COUNT];
+
+    for (int p = 0; p < R3D_PLANE_COUNT; p++) {
+        px[p] = _mm256_set1_ps(planes[p].x); ax[p] = _mm256_set1_ps(fabsf(planes[p].x));
+        py[p] = _mm256_set1_ps(planes[p].y); ay[p] = _mm256_set1_ps(fabsf(planes[p].y));
+        pz[p] = _mm256_set1_ps(planes[p].z); az[p] = _mm256_set1_ps(fabsf(planes[p].z));
+        pw[p] = _mm256_set1_ps(planes[p].w);
+    }
+
+    __m256 threshold = _mm256_set1_ps(-EPSILON);
+
+#elif defined(R3D_HAS_SSE)
+
+    __m128 px[R3D_PLANE_COUNT], py[R3D_PLANE_COUNT], pz[R3D_PLANE_COUNT], pw[R3D_PLANE_COUNT];
+    __m128 ax[R3D_PLANE_COUNT], ay[R3D_PLANE_COUNT], az[R3D_PLANE_COUNT];
+
+    for (int p = 0; p < R3D_PLANE_COUNT; p++) {
+        px[p] = _mm_set1_ps(planes[p].x); ax[p] = _mm_set1_ps(fabsf(planes[p].x));
+        py[p] = _mm_set1_ps(planes[p].y); ay[p] = _mm_set1_ps(fabsf(planes[p].y));
+        pz[p] = _mm_set1_ps(planes[p].z); az[p] = _mm_set1_ps(fabsf(planes[p].z));
+        pw[p] = _mm_set1_ps(planes[p].w);
+    }
+
+    __m128 threshold = _mm_set1_ps(-EPSILON);
+
+#elif defined(R3D_HAS_NEON) || defined(R3D_HAS_NEON_FMA)
+
+    float32x4_t px[R3D_PLANE_COUNT], py[R3D_PLANE_COUNT], pz[R3D_PLANE_COUNT], pw[R3D_PLANE_COUNT];
+    float32x4_t ax[R3D_PLANE_COUNT], ay[R3D_PLANE_COUNT], az[R3D_PLANE_COUNT];
+
+    for (int p = 0; p < R3D_PLANE_COUNT; p++) {
+        px[p] = vdupq_n_f32(planes[p].x); ax[p] = vdupq_n_f32(fabsf(planes[p].x));
+        py[p] = vdupq_n_f32(planes[p].y); ay[p] = vdupq_n_f32(fabsf(planes[p].y));
+        pz[p] = vdupq_n_f32(planes[p].z); az[p] = vdupq_n_f32(fabsf(planes[p].z));
+        pw[p] = vdupq_n_f32(planes[p].w);
+    }
+
+    float32x4_t threshold = vdupq_n_f32(-EPSILON);
+    const uint32_t laneBitsData[4] = { 1, 2, 4, 8 };
+    uint32x4_t laneBits = vld1q_u32(laneBitsData);
+
+#endif
+
+    for (int base = begin; base < end; base += 32)
+    {
+        uint32_t bits = 0;
+
+#if defined(R3D_HAS_AVX)
+
+        for (int j = 0; j < 32; j += 8)
+        {
+            int i = base + j;
+
+            __m256 cx = _mm256_loadu_ps(&boxes->centerX[i]);
+            __m256 cy = _mm256_loadu_ps(&boxes->centerY[i]);
+            __m256 cz = _mm256_loadu_ps(&boxes->centerZ[i]);
+            __m256 ex = _mm256_loadu_ps(&boxes->extentX[i]);
+            __m256 ey = _mm256_loadu_ps(&boxes->extentY[i]);
+            __m256 ez = _mm256_loadu_ps(&boxes->extentZ[i]);
+
+            __m256 outside = _mm256_setzero_ps();
+
+            for (int p = 0; p < R3D_PLANE_COUNT; p++) {
+                __m256 distance = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(px[p], cx), _mm256_mul_ps(py[p], cy)),
+                    _mm256_add_ps(_mm256_mul_ps(pz[p], cz), pw[p])
+                );
+                __m256 radius = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(ax[p], ex), _mm256_mul_ps(ay[p], ey)),
+                    _mm256_mul_ps(az[p], ez)
+                );
+                outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), threshold, _CMP_LT_OQ));
+            }
+
+            bits |= (uint32_t)(~_mm256_movemask_ps(outside) & 0xFF) << j;
+        }
+
+#elif defined(R3D_HAS_SSE)
+
+        for (int j = 0; j < 32; j += 4)
+        {
+            int i = base + j;
+
+            __m128 cx = _mm_loadu_ps(&boxes->centerX[i]);
+            __m128 cy = _mm_loadu_ps(&boxes->centerY[i]);
+            __m128 cz = _mm_loadu_ps(&boxes->centerZ[i]);
+            __m128 ex = _mm_loadu_ps(&boxes->extentX[i]);
+            __m128 ey = _mm_loadu_ps(&boxes->extentY[i]);
+            __m128 ez = _mm_loadu_ps(&boxes->extentZ[i]);
+
+            __m128 outside = _mm_setzero_ps();
+
+            for (int p = 0; p < R3D_PLANE_COUNT; p++) {
+                __m128 distance = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(px[p], cx), _mm_mul_ps(py[p], cy)),
+                    _mm_add_ps(_mm_mul_ps(pz[p], cz), pw[p])
+                );
+                __m128 radius = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(ax[p], ex), _mm_mul_ps(ay[p], ey)),
+                    _mm_mul_ps(az[p], ez)
+                );
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), threshold));
+            }
+
+            bits |= (uint32_t)(~_mm_movemask_ps(outside) & 0xF) << j;
+        }
+
+#elif defined(R3D_HAS_NEON) || defined(R3D_HAS_NEON_FMA)
+
+        for (int j = 0; j < 32; j += 4)
+        {
+            int i = base + j;
+
+            float32x4_t cx = vld1q_f32(&boxes->centerX[i]);
+            float32x4_t cy = vld1q_f32(&boxes->centerY[i]);
+            float32x4_t cz = vld1q_f32(&boxes->centerZ[i]);
+            float32x4_t ex = vld1q_f32(&boxes->extentX[i]);
+            float32x4_t ey = vld1q_f32(&boxes->extentY[i]);
+            float32x4_t ez = vld1q_f32(&boxes->extentZ[i]);
+
+            uint32x4_t outside = vdupq_n_u32(0);
+
+            for (int p = 0; p < R3D_PLANE_COUNT; p++) {
+                float32x4_t distance = vaddq_f32(
+                    vaddq_f32(vmulq_f32(px[p], cx), vmulq_f32(py[p], cy)),
+                    vaddq_f32(vmulq_f32(pz[p], cz), pw[p])
+                );
+                float32x4_t radius = vaddq_f32(
+                    vaddq_f32(vmulq_f32(ax[p], ex), vmulq_f32(ay[p], ey)),
+                    vmulq_f32(az[p], ez)
+                );
+                outside = vorrq_u32(outside, vcltq_f32(vaddq_f32(distance, radius), threshold));
+            }
+
+            // No movemask on NEON, the lanes are reduced to a 4-bit mask with a horizontal add
+            uint32x4_t laneMask = vandq_u32(outside, laneBits);
+            uint32x2_t sum = vadd_u32(vget_low_u32(laneMask), vget_high_u32(laneMask));
+            sum = vpadd_u32(sum, sum);
+
+            bits |= (~vget_lane_u32(sum, 0) & 0xF) << j;
+        }
+
+#else
+
+        int count = (end - base < 32) ? end - base : 32;
+
+        for (int j = 0; j < count; j++)
+        {
+            int i = base + j;
+            bool outside = false;
+
+            for (int p = 0; p < R3D_PLANE_COUNT && !outside; p++) {
+                float distance = planes[p].x * boxes->centerX[i] + planes[p].y * boxes->centerY[i] + planes[p].z * boxes->centerZ[i] + planes[p].w;
+                float radius = fabsf(planes[p].x) * boxes->extentX[i] + fabsf(planes[p].y) * boxes->extentY[i] + fabsf(planes[p].z) * boxes->extentZ[i];
+                outside = (distance + radius < -EPSILON);
+            }
+
+            if (!outside) bits |= 1u << j;
+        }
+
+#endif
+
+        if (end - base < 32) {
+            bits &= (1u << (end - base)) - 1;
+        }
+
+        mask[base / 32] = bits;
+    }
+}
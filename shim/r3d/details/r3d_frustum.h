@@ -21,6 +21,7 @@
 #define R3D_DETAILS_FRUSTUM_H
 
 #include <raylib.h>
+#include <stdint.h>
 
 /* === Types ===  */
 
@@ -34,10 +35,26 @@ typedef enum {
     R3D_PLANE_COUNT
 } r3d_plane_e;
 
+typedef enum {
+    R3D_FRUSTUM_OUTSIDE,
+    R3D_FRUSTUM_INTERSECT,
+    R3D_FRUSTUM_INSIDE
+} r3d_frustum_test_e;
+
 typedef struct {
     Vector4 planes[R3D_PLANE_COUNT];
 } r3d_frustum_t;
 
+// World space boxes stored as a structure of arrays, in center/extents form
+typedef struct {
+    float* centerX;
+    float* centerY;
+    float* centerZ;
+    float* extentX;
+    float* extentY;
+    float* extentZ;
+} r3d_aabb_soa_t;
+
 /* === Functions === */
 
 r3d_frustum_t r3d_frustum_create(Matrix matrixViewProjection);
@@ -48,4 +65,15 @@ bool r3d_frustum_is_sphere_in(const r3d_frustum_t* frustum, const Vector3* posit
 bool r3d_frustum_is_aabb_in(const r3d_frustum_t* frustum, const BoundingBox* aabb);
 bool r3d_frustum_is_obb_in(const r3d_frustum_t* frustum, const BoundingBox* aabb, const Matrix* transform);
 
+// Same test as 'r3d_frustum_is_aabb_in' but also tells if the box is entirely contained in the frustum
+r3d_frustum_test_e r3d_frustum_classify_aabb(const r3d_frustum_t* frustum, const BoundingBox* aabb);
+
+// Stores at 'index' the world space box enclosing the local box transformed by 'transform'
+void r3d_aabb_soa_set(r3d_aabb_soa_t* boxes, int index, const BoundingBox* aabb, const Matrix* transform);
+
+// Tests the boxes [begin, end), bit (i % 32) of 'mask[i / 32]' is set when the box 'i' is at least partially visible
+// NOTE: 'begin' must be a multiple of 32, the mask words are overwritten entirely (bits past 'end' are cleared)
+//       and the arrays of boxes are read up to the next multiple of 32 after 'end', so they must be padded
+void r3d_frustum_cull_aabb_soa(const r3d_frustum_t* frustum, const r3d_aabb_soa_t* boxes, int begin, int end, uint32_t* mask);
+
 #endif // R3D_DETAILS_FRUSTUM_H
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "./r3d_jobs.h"
+
+#include <raylib.h>
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <unistd.h>
+
+/* === Internal types === */
+
+// Chunks owned by one thread, the other threads can steal from it once they are done with their own
+typedef struct {
+    _Alignas(64) atomic_int next;   //< Next chunk to process (may go past 'end')
+    int end;                        //< One past the last chunk of the range
+} r3d_job_range_t;
+
+typedef struct {
+    r3d_job_pool_t* pool;
+    int index;                      //< Index of the range owned by the worker (0 is the calling thread)
+} r3d_job_worker_t;
+
+struct r3d_job_pool {
+
+    pthread_t threads[R3D_JOB_POOL_MAX_THREADS];
+    r3d_job_worker_t workers[R3D_JOB_POOL_MAX_THREADS];
+    int workerCount;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t wakeCond;
+    pthread_cond_t doneCond;
+    unsigned int generation;        //< Incremented for each dispatched loop
+    int pendingWorkers;             //< Workers that haven't finished the current loop
+    bool shutdown;
+
+    // Current loop, written before waking the workers
+    r3d_job_func_t func;
+    void* userData;
+    int count;
+    int grain;
+
+    r3d_job_range_t ranges[R3D_JOB_POOL_MAX_THREADS + 1];
+};
+
+/* === Internal functions === */
+
+static void r3d_job_pool_execute(r3d_job_pool_t* pool, int self)
+{
+    int participants = pool->workerCount + 1;
+
+    // Starts with its own range, then steals from the others
+    for (int i = 0; i < participants; i++) {
+        r3d_job_range_t* range = &pool->ranges[(self + i) % participants];
+        int chunk;
+        while ((chunk = atomic_fetch_add_explicit(&range->next, 1, memory_order_relaxed)) < range->end) {
+            int begin = chunk * pool->grain;
+            int end = begin + pool->grain;
+            if (end > pool->count) end = pool->count;
+            pool->func(pool->userData, begin, end);
+        }
+    }
+}
+
+static void* r3d_job_pool_worker_main(void* arg)
+{
+    r3d_job_worker_t* worker = arg;
+    r3d_job_pool_t* pool = worker->pool;
+
+    unsigned int generation = 0;
+
+    pthread_mutex_lock(&pool->mutex);
+
+    for (;;) {
+        while (!pool->shutdown && pool->generation == generation) {
+            pthread_cond_wait(&pool->wakeCond, &pool->mutex);
+        }
+        if (pool->shutdown) {
+            break;
+        }
+        generation = pool->generation;
+        pthread_mutex_unlock(&pool->mutex);
+
+        r3d_job_pool_execute(pool, worker->index);
+
+        pthread_mutex_lock(&pool->mutex);
+        if (--pool->pendingWorkers == 0) {
+            pthread_cond_signal(&pool->doneCond);
+        }
+    }
+
+    pthread_mutex_unlock(&pool->mutex);
+
+    return NULL;
+}
+
+/* === Public functions === */
+
+r3d_job_pool_t* r3d_job_pool_create(int workerCount)
+{
+    if (workerCount <= 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        workerCount = (cores > 1) ? (int)cores - 1 : 0;
+    }
+
+    if (workerCount > R3D_JOB_POOL_MAX_THREADS) {
+        workerCount = R3D_JOB_POOL_MAX_THREADS;
+    }
+
+    if (workerCount == 0) {
+        TraceLog(LOG_INFO, "R3D: No worker thread available, jobs will run on the calling thread");
+        return NULL;
+    }
+
+    r3d_job_pool_t* pool = RL_CALLOC(1, sizeof(r3d_job_pool_t));
+    if (pool == NULL) {
+        TraceLog(LOG_ERROR, "R3D: Failed to allocate the job pool");
+        return NULL;
+    }
+
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->wakeCond, NULL);
+    pthread_cond_init(&pool->doneCond, NULL);
+
+    for (int i = 0; i < workerCount; i++) {
+        pool->workers[i].pool = pool;
+        pool->workers[i].index = i + 1;
+        if (pthread_create(&pool->threads[i], NULL, r3d_job_pool_worker_main, &pool->workers[i]) != 0) {
+            TraceLog(LOG_WARNING, "R3D: Failed to create worker thread (%i / %i)", i + 1, workerCount);
+            break;
+        }
+        pool->workerCount++;
+    }
+
+    if (pool->workerCount == 0) {
+        r3d_job_pool_destroy(pool);
+        return NULL;
+    }
+
+    TraceLog(LOG_INFO, "R3D: Job pool created with %i worker threads", pool->workerCount);
+
+    return pool;
+}
+
+void r3d_job_pool_destroy(r3d_job_pool_t* pool)
+{
+    if (pool == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->mutex);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->wakeCond);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (int i = 0; i < pool->workerCount; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    pthread_cond_destroy(&pool->doneCond);
+    pthread_cond_destroy(&pool->wakeCond);
+    pthread_mutex_destroy(&pool->mutex);
+
+    RL_FREE(pool);
+}
+
+int r3d_job_pool_get_thread_count(const r3d_job_pool_t* pool)
+{
+    return (pool != NULL) ? pool->workerCount + 1 : 1;
+}
+
+void r3d_job_pool_parallel_for(r3d_job_pool_t* pool, int count, int grain, r3d_job_func_t func, void* userData)
+{
+    if (count <= 0) {
+        return;
+    }
+
+    if (grain < 1) {
+        grain = 1;
+    }
+
+    /* --- Run directly when there is nothing to split --- */
+
+    int chunkCount = (count + grain - 1) / grain;
+
+    if (pool == NULL || chunkCount == 1) {
+        func(userData, 0, count);
+        return;
+    }
+
+    /* --- Distribute the chunks evenly between the threads --- */
+
+    int participants = pool->workerCount + 1;
+
+    pthread_mutex_lock(&pool->mutex);
+
+    pool->func = func;
+    pool->userData = userData;
+    pool->count = count;
+    pool->grain = grain;
+
+    for (int i = 0; i < participants; i++) {
+        atomic_store_explicit(&pool->ranges[i].next, (int)((long)chunkCount * i / participants), memory_order_relaxed);
+        pool->ranges[i].end = (int)((long)chunkCount * (i + 1) / participants);
+    }
+
+    pool->pendingWorkers = pool->workerCount;
+    pool->generation++;
+
+    pthread_cond_broadcast(&pool->wakeCond);
+    pthread_mutex_unlock(&pool->mutex);
+
+    /* --- The calling thread takes part in the loop --- */
+
+    r3d_job_pool_execute(pool, 0);
+
+    /* --- Wait for the workers, their writes are visible once the mutex is acquired --- */
+
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->pendingWorkers > 0) {
+        pthread_cond_wait(&pool->doneCond, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef R3D_DETAILS_JOBS_H
+#define R3D_DETAILS_JOBS_H
+
+/* === Defines === */
+
+#define R3D_JOB_POOL_MAX_THREADS 32
+
+/* === Types === */
+
+/*
+ * Job function called on the range [begin, end) of a parallel loop.
+ * A job must only write to the elements of its own range, the ranges
+ * are distributed to the threads in a non-deterministic way.
+ */
+typedef void (*r3d_job_func_t)(void* userData, int begin, int end);
+
+typedef struct r3d_job_pool r3d_job_pool_t;
+
+/* === Functions === */
+
+// Creates a pool with 'workerCount' threads, if <= 0 one thread per available core minus the caller is created
+// Returns NULL on failure or if no worker thread is needed, in which case all jobs run on the calling thread
+r3d_job_pool_t* r3d_job_pool_create(int workerCount);
+void r3d_job_pool_destroy(r3d_job_pool_t* pool);
+
+// Returns the number of threads that take part in a parallel loop, including the calling thread
+int r3d_job_pool_get_thread_count(const r3d_job_pool_t* pool);
+
+// Splits [0, count) in chunks of 'grain' elements and blocks until they have all been processed
+// The calling thread also executes chunks, and idle threads steal the chunks of the busy ones
+// NOTE: Must not be called from inside a job, and a NULL pool runs 'func(userData, 0, count)' directly
+void r3d_job_pool_parallel_for(r3d_job_pool_t* pool, int count, int grain, r3d_job_func_t func, void* userData);
+
+#endif // R3D_DETAILS_JOBS_H
@@ -10,70 +10,6 @@
 
 /* === Internal functions === */
 
-static r3d_shadow_map_t r3d_light_create_shadow_map_dir(int resolution)
-{
-    r3d_shadow_map_t shadowMap = { 0 };
-
-    glGenFramebuffers(1, &shadowMap.id);
-    glBindFramebuffer(GL_FRAMEBUFFER, shadowMap.id);
-
-    glGenTextures(1, &shadowMap.depth);
-    glBindTexture(GL_TEXTURE_2D, shadowMap.depth);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT16, resolution, resolution, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_SHORT, NULL);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, shadowMap.depth, 0);
-
-    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-        TraceLog(LOG_ERROR, "Framebuffer creation error for the directional shadow map");
-    }
-
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    shadowMap.texelSize = 1.0f / resolution;
-    shadowMap.resolution = resolution;
-
-    return shadowMap;
-}
-
-static r3d_shadow_map_t r3d_light_create_shadow_map_spot(int resolution)
-{
-    r3d_shadow_map_t shadowMap = { 0 };
-
-    shadowMap.resolution = resolution;
-
-    glGenFramebuffers(1, &shadowMap.id);
-    glBindFramebuffer(GL_FRAMEBUFFER, shadowMap.id);
-
-    glGenTextures(1, &shadowMap.depth);
-    glBindTexture(GL_TEXTURE_2D, shadowMap.depth);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT16, resolution, resolution, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_SHORT, NULL);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, shadowMap.depth, 0);
-
-    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-        TraceLog(LOG_ERROR, "Framebuffer creation error for the Shadow Map Spot");
-    }
-
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    shadowMap.texelSize = 1.0f / resolution;
-    shadowMap.resolution = resolution;
-
-    return shadowMap;
-}
-
 static r3d_shadow_map_t r3d_light_create_shadow_map_omni(int resolution)
 {
     r3d_shadow_map_t shadowMap = { 0 };
@@ -110,10 +46,21 @@ static r3d_shadow_map_t r3d_light_create_shadow_map_omni(int resolution)
 
     shadowMap.texelSize = 1.0f / resolution;
     shadowMap.resolution = resolution;
+    shadowMap.layers = 1;
 
     return shadowMap;
 }
 
+static Vector3 r3d_light_unproject(Vector3 ndc, const Matrix* invProj)
+{
+    const Matrix* m = invProj;
+    float x = m->m0 * ndc.x + m->m4 * ndc.y + m->m8 * ndc.z + m->m12;
+    float y = m->m1 * ndc.x + m->m5 * ndc.y + m->m9 * ndc.z + m->m13;
+    float z = m->m2 * ndc.x + m->m6 * ndc.y + m->m10 * ndc.z + m->m14;
+    float w = m->m3 * ndc.x + m->m7 * ndc.y + m->m11 * ndc.z + m->m15;
+    return (Vector3) { x / w, y / w, z / w };
+}
+
 /* === Public functions === */
 
 void r3d_light_init(r3d_light_t* light, R3D_LightType type)
@@ -144,6 +91,9 @@ void r3d_light_init(r3d_light_t* light, R3D_LightType type)
     light->shadow.updateConf.timerSec = 0.0f;
     light->shadow.updateConf.shouldUpdate = true;
 
+    light->shadow.cascadeCount = 1;
+    light->shadow.cascadeDistance = 100.0f;
+
     /* --- Set specific shadow config --- */
 
     switch (type) {
@@ -167,18 +117,25 @@ void r3d_light_init(r3d_light_t* light, R3D_LightType type)
 
 void r3d_light_create_shadow_map(r3d_light_t* light, int resolution)
 {
+    // NOTE: The directional and spot lights get their tiles in the shadow atlas when they are rendered,
+    //       the generation 0 is never the one of the atlas so the tiles are requested again
     switch (light->type) {
     case R3D_LIGHT_DIR:
-        light->shadow.map = r3d_light_create_shadow_map_dir(resolution);
+        light->shadow.map = (r3d_shadow_map_t) { .resolution = resolution, .layers = light->shadow.cascadeCount };
         break;
     case R3D_LIGHT_SPOT:
-        light->shadow.map = r3d_light_create_shadow_map_spot(resolution);
+        light->shadow.map = (r3d_shadow_map_t) { .resolution = resolution, .layers = 1 };
         break;
     case R3D_LIGHT_OMNI:
         light->shadow.map = r3d_light_create_shadow_map_omni(resolution);
         break;
     }
 
+    memset(light->shadow.tiles, 0, sizeof(light->shadow.tiles));
+    memset(light->shadow.staticCache, 0, sizeof(light->shadow.staticCache));
+    memset(light->shadow.faceSignatures, 0, sizeof(light->shadow.faceSignatures));
+    light->shadow.atlasGeneration = 0;
+
     light->shadow.updateConf.shouldUpdate = true;
 }
 
@@ -445,6 +402,144 @@ void r3d_light_get_matrix_vp_dir(r3d_light_t* light, BoundingBox sceneBounds, Ma
     *proj = MatrixOrtho(minX, maxX, minY, maxY, light->near, light->far);
 }
 
+void r3d_light_update_cascades_dir(r3d_light_t* light, BoundingBox sceneBounds, const Matrix* invView,
+                                   const Matrix* invProj, float near, float far)
+{
+    r3d_shadow_t* shadow = &light->shadow;
+    int count = shadow->map.layers;
+
+    /* --- A single layer is fitted to the scene bounds --- */
+
+    if (count <= 1) {
+        Matrix view = { 0 };
+        Matrix proj = { 0 };
+        r3d_light_get_matrix_vp_dir(light, sceneBounds, &view, &proj);
+        shadow->cascadeVP[0] = MatrixMultiply(view, proj);
+        shadow->cascades[0] = (Vector4) { 1.0f, 1.0f, 0.0f, 0.0f };
+        shadow->matVP = shadow->cascadeVP[0];
+        return;
+    }
+
+    /* --- Split the view distance, blend of the logarithmic and uniform splits --- */
+
+    // NOTE: The logarithmic split keeps the texel density constant along the view,
+    //       the uniform part avoids spending most of the texels right in front of the camera
+    const float SPLIT_LAMBDA = 0.75f;
+
+    near = fmaxf(near, 1e-3f);
+    float distance = fminf(far, fmaxf(shadow->cascadeDistance, 2.0f * near));
+
+    float splits[R3D_LIGHT_MAX_CASCADES + 1];
+    splits[0] = near;
+
+    for (int i = 1; i <= count; i++) {
+        float t = (float)i / count;
+        float logSplit = near * powf(distance / near, t);
+        float uniformSplit = near + (distance - near) * t;
+        splits[i] = SPLIT_LAMBDA * logSplit + (1.0f - SPLIT_LAMBDA) * uniformSplit;
+    }
+
+    /* --- Corners of the view frustum in view space --- */
+
+    // NOTE: The points at a given depth are interpolated between the near and far corners,
+    //       which works for both perspective and orthographic projections
+    Vector3 cornersNear[4], cornersFar[4];
+
+    for (int i = 0; i < 4; i++) {
+        float x = (i & 1) ? 1.0f : -1.0f;
+        float y = (i & 2) ? 1.0f : -1.0f;
+        cornersNear[i] = r3d_light_unproject((Vector3) { x, y, -1.0f }, invProj);
+        cornersFar[i] = r3d_light_unproject((Vector3) { x, y, 1.0f }, invProj);
+    }
+
+    float depthNear = -cornersNear[0].z;
+    float depthRange = fmaxf(-cornersFar[0].z - depthNear, 1e-6f);
+
+    /* --- Light view, only depends on the light direction so the cascades can be snapped --- */
+
+    Vector3 lightDir = Vector3Normalize(light->direction);
+    Vector3 up = (fabsf(lightDir.y) > 0.99f) ? (Vector3) { 0.0f, 0.0f, 1.0f } : (Vector3) { 0.0f, 1.0f, 0.0f };
+    Matrix lightView = MatrixLookAt(Vector3Zero(), lightDir, up);
+
+    /* --- Bounding sphere of each slice of the frustum in light space --- */
+
+    Vector3 centers[R3D_LIGHT_MAX_CASCADES];
+    float radii[R3D_LIGHT_MAX_CASCADES];
+
+    float minZ = INFINITY, maxZ = -INFINITY;
+
+    for (int c = 0; c < count; c++)
+    {
+        Vector3 corners[8];
+        Vector3 center = { 0 };
+
+        for (int i = 0; i < 8; i++) {
+            float t = Clamp((splits[c + (i >> 2)] - depthNear) / depthRange, 0.0f, 1.0f);
+            corners[i] = Vector3Transform(Vector3Lerp(cornersNear[i & 3], cornersFar[i & 3], t), *invView);
+            center = Vector3Add(center, corners[i]);
+        }
+
+        center = Vector3Scale(center, 1.0f / 8.0f);
+
+        float radius = 0.0f;
+        for (int i = 0; i < 8; i++) {
+            radius = fmaxf(radius, Vector3Distance(center, corners[i]));
+        }
+
+        // NOTE: The sphere only depends on the shape of the slice, so its size doesn't change when the camera
+        //       rotates, and its center moves by whole texels, which keeps the shadow edges from shimmering
+        radius = ceilf(radius * 16.0f) / 16.0f;
+
+        float texel = 2.0f * radius / shadow->tiles[0].size;
+        center = Vector3Transform(center, lightView);
+        center.x = floorf(center.x / texel) * texel;
+        center.y = floorf(center.y / texel) * texel;
+
+        centers[c] = center;
+        radii[c] = radius;
+
+        minZ = fminf(minZ, center.z - radius);
+        maxZ = fmaxf(maxZ, center.z + radius);
+    }
+
+    /* --- Shared depth range, includes the casters of the scene bounds outside of the view --- */
+
+    for (int i = 0; i < 8; i++) {
+        Vector3 corner = {
+            (i & 1) ? sceneBounds.max.x : sceneBounds.min.x,
+            (i & 2) ? sceneBounds.max.y : sceneBounds.min.y,
+            (i & 4) ? sceneBounds.max.z : sceneBounds.min.z
+        };
+        float z = Vector3Transform(corner, lightView).z;
+        minZ = fminf(minZ, z);
+        maxZ = fmaxf(maxZ, z);
+    }
+
+    light->near = -maxZ;
+    light->far = -minZ;
+
+    /* --- Projection of each cascade, and its mapping from the clip space of the first one --- */
+
+    for (int c = 0; c < count; c++)
+    {
+        float r = radii[c];
+        Matrix proj = MatrixOrtho(
+            centers[c].x - r, centers[c].x + r,
+            centers[c].y - r, centers[c].y + r,
+            light->near, light->far
+        );
+
+        shadow->cascadeVP[c] = MatrixMultiply(lightView, proj);
+        shadow->cascades[c] = (Vector4) {
+            radii[0] / r, radii[0] / r,
+            (centers[0].x - centers[c].x) / r,
+            (centers[0].y - centers[c].y) / r
+        };
+    }
+
+    shadow->matVP = shadow->cascadeVP[0];
+}
+
 Matrix r3d_light_get_matrix_view_spot(r3d_light_t* light)
 {
     return MatrixLookAt(light->position,
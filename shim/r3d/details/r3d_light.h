@@ -20,9 +20,16 @@
 #ifndef R3D_LIGHT_H
 #define R3D_LIGHT_H
 
+#include "./r3d_shadow_atlas.h"
+
 #include <raylib.h>
+#include <stdint.h>
 #include <r3d.h>
 
+/* === Defines === */
+
+#define R3D_LIGHT_MAX_CASCADES 4
+
 /* === Types === */
 
 typedef struct {
@@ -34,15 +41,31 @@ typedef struct {
 
 typedef struct {
     unsigned int id;
-    unsigned int depth;
+    unsigned int depth;         //< Cubemap of the omni lights, the other lights are drawn in the shadow atlas
     float texelSize;
-    int resolution;
+    int resolution;             //< Largest tile of the directional and spot lights in the shadow atlas
+    int layers;                 //< Tiles of the directional and spot lights, one per cascade
 } r3d_shadow_map_t;
 
+typedef struct {
+    Matrix matVP;               //< View/projection the static casters were drawn with
+    R3D_Layer layers;           //< Active layers when they were drawn
+    unsigned int version;       //< Version of the static scene when they were drawn
+    bool valid;
+} r3d_shadow_cache_t;
+
 typedef struct {
     r3d_shadow_update_conf_t updateConf;
     r3d_shadow_map_t map;
-    Matrix matVP;
+    Matrix matVP;                                       //< View/projection of the first cascade
+    Matrix cascadeVP[R3D_LIGHT_MAX_CASCADES];           //< View/projection of each layer of the map
+    Vector4 cascades[R3D_LIGHT_MAX_CASCADES];           //< Scale (xy) and offset (zw) from the clip space of the first cascade to each cascade
+    int cascadeCount;                                   //< Cascades of a directional light, 1 fits a single map to the scene bounds
+    float cascadeDistance;                              //< View distance covered by the cascades
+    r3d_shadow_tile_t tiles[R3D_LIGHT_MAX_CASCADES];    //< Tiles of the layers in the shadow atlas
+    r3d_shadow_cache_t staticCache[R3D_LIGHT_MAX_CASCADES]; //< Static depth of each tile in the shadow atlas
+    unsigned int atlasGeneration;                       //< Packing of the shadow atlas the tiles come from
+    uint64_t faceSignatures[6];                         //< Casters of each cubemap face when it was drawn, 0 to draw it again
     float softness;
     float depthBias;
     float slopeBias;
@@ -85,6 +108,11 @@ BoundingBox r3d_light_get_bounding_box(const r3d_light_t* light);
 
 void r3d_light_get_matrix_vp_dir(r3d_light_t* light, BoundingBox sceneBounds, Matrix* view, Matrix* proj);
 
+// Fits the cascades of a directional light to the view frustum, the cascades are snapped to the texels
+// of their tiles in the atlas so they don't shimmer when the camera moves, their depth covers the scene bounds
+void r3d_light_update_cascades_dir(r3d_light_t* light, BoundingBox sceneBounds, const Matrix* invView,
+                                   const Matrix* invProj, float near, float far);
+
 Matrix r3d_light_get_matrix_view_spot(r3d_light_t* light);
 Matrix r3d_light_get_matrix_proj_spot(r3d_light_t* light);
 
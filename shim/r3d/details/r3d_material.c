@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "./r3d_material.h"
+
+#include <raylib.h>
+#include <string.h>
+
+/* === Internal functions === */
+
+static uint32_t r3d_material_hash(const R3D_Material* material)
+{
+    // NOTE: R3D_Material only contains 32-bit members, so it has no padding
+    //       and it can be hashed and compared as an array of words
+
+    const uint32_t* words = (const uint32_t*)material;
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < sizeof(R3D_Material) / sizeof(uint32_t); i++) {
+        hash = (hash ^ words[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
+static bool r3d_material_cache_rehash(r3d_material_cache_t* cache, size_t bucketCount)
+{
+    if (r3d_array_reserve(&cache->buckets, bucketCount) < 0) {
+        return false;
+    }
+
+    unsigned int* buckets = cache->buckets.data;
+    memset(buckets, 0, bucketCount * sizeof(unsigned int));
+    cache->buckets.count = bucketCount;
+
+    unsigned int maxID = r3d_registry_get_allocated_count(&cache->entries);
+
+    for (unsigned int id = 1; id <= maxID; id++) {
+        r3d_material_entry_t* entry = r3d_registry_get(&cache->entries, id);
+        if (entry == NULL) continue;
+        size_t bucket = entry->hash & (bucketCount - 1);
+        entry->next = buckets[bucket];
+        buckets[bucket] = id;
+    }
+
+    return true;
+}
+
+/* === Public functions === */
+
+r3d_material_cache_t r3d_material_cache_create(int capacity)
+{
+    r3d_material_cache_t cache = { 0 };
+
+    size_t bucketCount = 16;
+    while (bucketCount < (size_t)capacity) {
+        bucketCount *= 2;
+    }
+
+    cache.entries = r3d_registry_create(bucketCount, sizeof(r3d_material_entry_t));
+    cache.buckets = r3d_array_create(bucketCount, sizeof(unsigned int));
+    cache.nextVersion = 1;
+
+    r3d_material_cache_rehash(&cache, bucketCount);
+
+    return cache;
+}
+
+void r3d_material_cache_destroy(r3d_material_cache_t* cache)
+{
+    r3d_registry_destroy(&cache->entries);
+    r3d_array_destroy(&cache->buckets);
+    cache->count = 0;
+}
+
+unsigned int r3d_material_cache_intern(r3d_material_cache_t* cache, const R3D_Material* material, unsigned int frame, uint32_t* version)
+{
+    uint32_t hash = r3d_material_hash(material);
+
+    /* --- Search for an identical material --- */
+
+    unsigned int* buckets = cache->buckets.data;
+    size_t bucketMask = cache->buckets.count - 1;
+
+    for (unsigned int id = buckets[hash & bucketMask]; id != 0; )
+    {
+        r3d_material_entry_t* entry = r3d_registry_get(&cache->entries, id);
+
+        if (entry->hash == hash && memcmp(&entry->material, material, sizeof(R3D_Material)) == 0) {
+            entry->lastFrame = frame;
+            if (version) *version = entry->version;
+            return id;
+        }
+
+        id = entry->next;
+    }
+
+    /* --- Add the material, the buckets are doubled when they all contain an entry on average --- */
+
+    if ((size_t)cache->count >= cache->buckets.count) {
+        if (!r3d_material_cache_rehash(cache, 2 * cache->buckets.count)) {
+            TraceLog(LOG_WARNING, "R3D: Failed to grow the material cache buckets");
+        }
+        buckets = cache->buckets.data;
+        bucketMask = cache->buckets.count - 1;
+    }
+
+    unsigned int id = r3d_registry_add(&cache->entries, NULL);
+    r3d_material_entry_t* entry = r3d_registry_get(&cache->entries, id);
+
+    if (entry == NULL) {
+        TraceLog(LOG_ERROR, "R3D: Failed to add a material to the cache");
+        return 0;
+    }
+
+    entry->material = *material;
+    entry->hash = hash;
+    entry->version = cache->nextVersion++;
+    entry->lastFrame = frame;
+    entry->next = buckets[hash & bucketMask];
+    buckets[hash & bucketMask] = id;
+
+    cache->count++;
+
+    if (version) *version = entry->version;
+
+    return id;
+}
+
+bool r3d_material_cache_touch(r3d_material_cache_t* cache, unsigned int id, uint32_t version, unsigned int frame)
+{
+    r3d_material_entry_t* entry = r3d_registry_get(&cache->entries, id);
+    if (entry == NULL || entry->version != version) {
+        return false;
+    }
+
+    entry->lastFrame = frame;
+
+    return true;
+}
+
+const R3D_Material* r3d_material_cache_get(r3d_material_cache_t* cache, unsigned int id)
+{
+    r3d_material_entry_t* entry = r3d_registry_get(&cache->entries, id);
+    return entry ? &entry->material : NULL;
+}
+
+void r3d_material_cache_collect(r3d_material_cache_t* cache, unsigned int frame)
+{
+    unsigned int* buckets = cache->buckets.data;
+
+    for (size_t b = 0; b < cache->buckets.count; b++)
+    {
+        unsigned int* link = &buckets[b];
+
+        while (*link != 0)
+        {
+            unsigned int id = *link;
+            r3d_material_entry_t* entry = r3d_registry_get(&cache->entries, id);
+
+            if (frame - entry->lastFrame > R3D_MATERIAL_CACHE_LIFETIME) {
+                *link = entry->next;
+                r3d_registry_remove(&cache->entries, id);
+                cache->count--;
+            }
+            else {
+                link = &entry->next;
+            }
+        }
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef R3D_DETAILS_MATERIAL_H
+#define R3D_DETAILS_MATERIAL_H
+
+#include "./containers/r3d_registry.h"
+#include "./containers/r3d_array.h"
+
+#include <r3d.h>
+#include <stdint.h>
+
+/* === Defines === */
+
+#define R3D_MATERIAL_CACHE_LIFETIME 4   //< Number of frames an unused material is kept in the cache
+
+/* === Types === */
+
+typedef struct {
+    R3D_Material material;      //< Interned copy of the material
+    uint32_t hash;              //< Hash of the whole material
+    uint32_t version;           //< Unique for each interned material, even if its ID is reused later
+    unsigned int next;          //< Next entry of the same bucket, 0 at the end of the list
+    unsigned int lastFrame;     //< Last frame during which the material has been used
+} r3d_material_entry_t;
+
+/*
+ * Interned materials, identical materials share the same ID so that the draw
+ * calls only carry a handle and comparing two materials is an integer compare.
+ * The materials unused for a few frames are released by 'r3d_material_cache_collect'.
+ */
+typedef struct {
+    r3d_registry_t entries;     //< Registry of r3d_material_entry_t, IDs start at 1
+    r3d_array_t buckets;        //< First entry ID of each bucket (unsigned int), the count is a power of two
+    uint32_t nextVersion;
+    int count;
+} r3d_material_cache_t;
+
+/* === Functions === */
+
+r3d_material_cache_t r3d_material_cache_create(int capacity);
+void r3d_material_cache_destroy(r3d_material_cache_t* cache);
+
+// Returns the ID of the material identical to 'material', which is added if needed, or 0 on failure
+// The version of the entry is written to 'version' if it is not NULL
+unsigned int r3d_material_cache_intern(r3d_material_cache_t* cache, const R3D_Material* material, unsigned int frame, uint32_t* version);
+
+// Marks the material as used during 'frame', returns false if it has been released since the
+// version was obtained, in which case the material must be interned again
+bool r3d_material_cache_touch(r3d_material_cache_t* cache, unsigned int id, uint32_t version, unsigned int frame);
+
+// Returns NULL if the ID is not valid
+const R3D_Material* r3d_material_cache_get(r3d_material_cache_t* cache, unsigned int id);
+
+// Releases the materials that have not been used during the last R3D_MATERIAL_CACHE_LIFETIME frames
+void r3d_material_cache_collect(r3d_material_cache_t* cache, unsigned int frame);
+
+#endif // R3D_DETAILS_MATERIAL_H
@@ -549,4 +549,73 @@ static inline Matrix r3d_matrix_normal(const Matrix* transform)
     return result;
 }
 
+static inline Vector4 r3d_vector4_lerp(const Vector4* a, const Vector4* b, float t)
+{
+    Vector4 result;
+
+#if defined(R3D_HAS_SSE)
+
+    __m128 va = _mm_loadu_ps((const float*)a);
+    __m128 vb = _mm_loadu_ps((const float*)b);
+    __m128 vt = _mm_set1_ps(t);
+
+    _mm_storeu_ps((float*)&result, _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), vt)));
+
+#elif defined(R3D_HAS_NEON) || defined(R3D_HAS_NEON_FMA)
+
+    float32x4_t va = vld1q_f32((const float*)a);
+    float32x4_t vb = vld1q_f32((const float*)b);
+
+    vst1q_f32((float*)&result, vmlaq_n_f32(va, vsubq_f32(vb, va), t));
+
+#else
+
+    result.x = a->x + (b->x - a->x) * t;
+    result.y = a->y + (b->y - a->y) * t;
+    result.z = a->z + (b->z - a->z) * t;
+    result.w = a->w + (b->w - a->w) * t;
+
+#endif
+
+    return result;
+}
+
+// Normalized lerp along the shortest path, the result is normalized
+static inline Quaternion r3d_quaternion_nlerp(const Quaternion* a, const Quaternion* b, float t)
+{
+    Quaternion target = *b;
+
+    if (a->x * b->x + a->y * b->y + a->z * b->z + a->w * b->w < 0.0f) {
+        target = (Quaternion) { -b->x, -b->y, -b->z, -b->w };
+    }
+
+    Quaternion q = r3d_vector4_lerp(a, &target, t);
+
+    float length = sqrtf(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    if (length < 1e-6f) return *a;
+
+    float invLength = 1.0f / length;
+
+    return (Quaternion) { q.x * invLength, q.y * invLength, q.z * invLength, q.w * invLength };
+}
+
+static inline BoundingBox r3d_aabb_transform(const BoundingBox* aabb, const Matrix* transform)
+{
+    Vector3 center = Vector3Scale(Vector3Add(aabb->min, aabb->max), 0.5f);
+    Vector3 extent = Vector3Scale(Vector3Subtract(aabb->max, aabb->min), 0.5f);
+
+    // The center is transformed and the extents are projected on the world axes
+    Vector3 worldCenter = Vector3Transform(center, *transform);
+    Vector3 worldExtent = {
+        fabsf(transform->m0) * extent.x + fabsf(transform->m4) * extent.y + fabsf(transform->m8) * extent.z,
+        fabsf(transform->m1) * extent.x + fabsf(transform->m5) * extent.y + fabsf(transform->m9) * extent.z,
+        fabsf(transform->m2) * extent.x + fabsf(transform->m6) * extent.y + fabsf(transform->m10) * extent.z
+    };
+
+    return (BoundingBox) {
+        .min = Vector3Subtract(worldCenter, worldExtent),
+        .max = Vector3Add(worldCenter, worldExtent)
+    };
+}
+
 #endif // R3D_MATH_H
@@ -24,12 +24,14 @@
 
 /* === Shader defines === */
 
-#define R3D_SHADER_FORWARD_NUM_LIGHTS 8
+#define R3D_SHADER_FORWARD_NUM_SHADOWS 8   //< Shadow casting lights per forward draw, the other lights are read from the light storage
+#define R3D_SHADER_NUM_CASCADES 4           //< Layers of the 2D shadow maps, must match 'R3D_LIGHT_MAX_CASCADES'
 
 /* === Uniform types === */
 
 typedef struct { int slot1D; int loc; } r3d_shader_uniform_sampler1D_t;
 typedef struct { int slot2D; int loc; } r3d_shader_uniform_sampler2D_t;
+typedef struct { int slot2DArray; int loc; } r3d_shader_uniform_sampler2DArray_t;
 typedef struct { int slotCube; int loc; } r3d_shader_uniform_samplerCube_t;
 
 typedef struct { int val; int loc; } r3d_shader_uniform_int_t;
@@ -86,8 +88,15 @@ typedef struct {
 
 typedef struct {
     unsigned int id;
-    r3d_shader_uniform_sampler1D_t uTexBoneMatrices;
+    r3d_shader_uniform_sampler2D_t uTexBoneMatrices;
+    r3d_shader_uniform_int_t uBoneOffset;
+} r3d_shader_generate_skinning_t;
+
+typedef struct {
+    unsigned int id;
+    r3d_shader_uniform_sampler2D_t uTexBoneMatrices;
     r3d_shader_uniform_int_t uUseSkinning;
+    r3d_shader_uniform_int_t uBoneOffset;
     r3d_shader_uniform_mat4_t uMatNormal;
     r3d_shader_uniform_mat4_t uMatModel;
     r3d_shader_uniform_mat4_t uMatMVP;
@@ -108,8 +117,9 @@ typedef struct {
 
 typedef struct {
     unsigned int id;
-    r3d_shader_uniform_sampler1D_t uTexBoneMatrices;
+    r3d_shader_uniform_sampler2D_t uTexBoneMatrices;
     r3d_shader_uniform_int_t uUseSkinning;
+    r3d_shader_uniform_int_t uBoneOffset;
     r3d_shader_uniform_mat4_t uMatInvView;
     r3d_shader_uniform_mat4_t uMatModel;
     r3d_shader_uniform_mat4_t uMatVP;
@@ -145,8 +155,9 @@ typedef struct {
 
 typedef struct {
     unsigned int id;
-    r3d_shader_uniform_sampler1D_t uTexBoneMatrices;
+    r3d_shader_uniform_sampler2D_t uTexBoneMatrices;
     r3d_shader_uniform_int_t uUseSkinning;
+    r3d_shader_uniform_int_t uBoneOffset;
     r3d_shader_uniform_mat4_t uMatMVP;
     r3d_shader_uniform_vec2_t uTexCoordOffset;
     r3d_shader_uniform_vec2_t uTexCoordScale;
@@ -157,8 +168,9 @@ typedef struct {
 
 typedef struct {
     unsigned int id;
-    r3d_shader_uniform_sampler1D_t uTexBoneMatrices;
+    r3d_shader_uniform_sampler2D_t uTexBoneMatrices;
     r3d_shader_uniform_int_t uUseSkinning;
+    r3d_shader_uniform_int_t uBoneOffset;
     r3d_shader_uniform_mat4_t uMatInvView;
     r3d_shader_uniform_mat4_t uMatModel;
     r3d_shader_uniform_mat4_t uMatVP;
@@ -172,8 +184,9 @@ typedef struct {
 
 typedef struct {
     unsigned int id;
-    r3d_shader_uniform_sampler1D_t uTexBoneMatrices;
+    r3d_shader_uniform_sampler2D_t uTexBoneMatrices;
     r3d_shader_uniform_int_t uUseSkinning;
+    r3d_shader_uniform_int_t uBoneOffset;
     r3d_shader_uniform_vec3_t uViewPosition;
     r3d_shader_uniform_mat4_t uMatModel;
     r3d_shader_uniform_mat4_t uMatMVP;
@@ -187,8 +200,9 @@ typedef struct {
 
 typedef struct {
     unsigned int id;
-    r3d_shader_uniform_sampler1D_t uTexBoneMatrices;
+    r3d_shader_uniform_sampler2D_t uTexBoneMatrices;
     r3d_shader_uniform_int_t uUseSkinning;
+    r3d_shader_uniform_int_t uBoneOffset;
     r3d_shader_uniform_vec3_t uViewPosition;
     r3d_shader_uniform_mat4_t uMatInvView;
     r3d_shader_uniform_mat4_t uMatModel;
@@ -220,13 +234,17 @@ typedef struct {
         r3d_shader_uniform_float_t shadowMapTxlSz;
         r3d_shader_uniform_float_t shadowDepthBias;
         r3d_shader_uniform_float_t shadowSlopeBias;
+        r3d_shader_uniform_vec4_t cascades[R3D_SHADER_NUM_CASCADES];
+        r3d_shader_uniform_vec4_t tiles[R3D_SHADER_NUM_CASCADES];
+        r3d_shader_uniform_int_t cascadeCount;
         r3d_shader_uniform_int_t type;
         r3d_shader_uniform_int_t enabled;
         r3d_shader_uniform_int_t shadow;
-    } uLights[R3D_SHADER_FORWARD_NUM_LIGHTS];
-    r3d_shader_uniform_sampler1D_t uTexBoneMatrices;
+    } uLights[R3D_SHADER_FORWARD_NUM_SHADOWS];
+    r3d_shader_uniform_sampler2D_t uTexBoneMatrices;
     r3d_shader_uniform_int_t uUseSkinning;
-    r3d_shader_uniform_mat4_t uMatLightVP[R3D_SHADER_FORWARD_NUM_LIGHTS];
+    r3d_shader_uniform_int_t uBoneOffset;
+    r3d_shader_uniform_mat4_t uMatLightVP[R3D_SHADER_FORWARD_NUM_SHADOWS];
     r3d_shader_uniform_mat4_t uMatNormal;
     r3d_shader_uniform_mat4_t uMatModel;
     r3d_shader_uniform_mat4_t uMatMVP;
@@ -236,8 +254,8 @@ typedef struct {
     r3d_shader_uniform_sampler2D_t uTexEmission;
     r3d_shader_uniform_sampler2D_t uTexNormal;
     r3d_shader_uniform_sampler2D_t uTexORM;
-    r3d_shader_uniform_samplerCube_t uShadowMapCube[R3D_SHADER_FORWARD_NUM_LIGHTS];
-    r3d_shader_uniform_sampler2D_t uShadowMap2D[R3D_SHADER_FORWARD_NUM_LIGHTS];
+    r3d_shader_uniform_samplerCube_t uShadowMapCube[R3D_SHADER_FORWARD_NUM_SHADOWS];
+    r3d_shader_uniform_sampler2DArray_t uShadowMap2D[R3D_SHADER_FORWARD_NUM_SHADOWS];
     r3d_shader_uniform_sampler2D_t uTexNoise;
     r3d_shader_uniform_float_t uEmissionEnergy;
     r3d_shader_uniform_float_t uNormalScale;
@@ -256,6 +274,16 @@ typedef struct {
     r3d_shader_uniform_float_t uSkyboxReflectIntensity;
     r3d_shader_uniform_float_t uAlphaCutoff;
     r3d_shader_uniform_vec3_t uViewPosition;
+    r3d_shader_uniform_int_t uClustered;
+    r3d_shader_uniform_sampler2D_t uTexLights;
+    r3d_shader_uniform_sampler2D_t uTexClusters;
+    r3d_shader_uniform_sampler2D_t uTexLightIndices;
+    r3d_shader_uniform_int_t uDirLightCount;
+    r3d_shader_uniform_int_t uLightListOffset;
+    r3d_shader_uniform_int_t uLightListCount;
+    r3d_shader_uniform_vec2_t uClusterScale;
+    r3d_shader_uniform_vec2_t uClusterSlice;
+    r3d_shader_uniform_mat4_t uMatView;
 } r3d_shader_raster_forward_t;
 
 typedef struct {
@@ -276,13 +304,17 @@ typedef struct {
         r3d_shader_uniform_float_t shadowMapTxlSz;
         r3d_shader_uniform_float_t shadowDepthBias;
         r3d_shader_uniform_float_t shadowSlopeBias;
+        r3d_shader_uniform_vec4_t cascades[R3D_SHADER_NUM_CASCADES];
+        r3d_shader_uniform_vec4_t tiles[R3D_SHADER_NUM_CASCADES];
+        r3d_shader_uniform_int_t cascadeCount;
         r3d_shader_uniform_int_t type;
         r3d_shader_uniform_int_t enabled;
         r3d_shader_uniform_int_t shadow;
-    } uLights[R3D_SHADER_FORWARD_NUM_LIGHTS];
-    r3d_shader_uniform_sampler1D_t uTexBoneMatrices;
+    } uLights[R3D_SHADER_FORWARD_NUM_SHADOWS];
+    r3d_shader_uniform_sampler2D_t uTexBoneMatrices;
     r3d_shader_uniform_int_t uUseSkinning;
-    r3d_shader_uniform_mat4_t uMatLightVP[R3D_SHADER_FORWARD_NUM_LIGHTS];
+    r3d_shader_uniform_int_t uBoneOffset;
+    r3d_shader_uniform_mat4_t uMatLightVP[R3D_SHADER_FORWARD_NUM_SHADOWS];
     r3d_shader_uniform_mat4_t uMatInvView;
     r3d_shader_uniform_mat4_t uMatModel;
     r3d_shader_uniform_mat4_t uMatVP;
@@ -293,8 +325,8 @@ typedef struct {
     r3d_shader_uniform_sampler2D_t uTexEmission;
     r3d_shader_uniform_sampler2D_t uTexNormal;
     r3d_shader_uniform_sampler2D_t uTexORM;
-    r3d_shader_uniform_samplerCube_t uShadowMapCube[R3D_SHADER_FORWARD_NUM_LIGHTS];
-    r3d_shader_uniform_sampler2D_t uShadowMap2D[R3D_SHADER_FORWARD_NUM_LIGHTS];
+    r3d_shader_uniform_samplerCube_t uShadowMapCube[R3D_SHADER_FORWARD_NUM_SHADOWS];
+    r3d_shader_uniform_sampler2DArray_t uShadowMap2D[R3D_SHADER_FORWARD_NUM_SHADOWS];
     r3d_shader_uniform_sampler2D_t uTexNoise;
     r3d_shader_uniform_float_t uEmissionEnergy;
     r3d_shader_uniform_float_t uNormalScale;
@@ -313,6 +345,16 @@ typedef struct {
     r3d_shader_uniform_float_t uSkyboxReflectIntensity;
     r3d_shader_uniform_float_t uAlphaCutoff;
     r3d_shader_uniform_vec3_t uViewPosition;
+    r3d_shader_uniform_int_t uClustered;
+    r3d_shader_uniform_sampler2D_t uTexLights;
+    r3d_shader_uniform_sampler2D_t uTexClusters;
+    r3d_shader_uniform_sampler2D_t uTexLightIndices;
+    r3d_shader_uniform_int_t uDirLightCount;
+    r3d_shader_uniform_int_t uLightListOffset;
+    r3d_shader_uniform_int_t uLightListCount;
+    r3d_shader_uniform_vec2_t uClusterScale;
+    r3d_shader_uniform_vec2_t uClusterSlice;
+    r3d_shader_uniform_mat4_t uMatView;
 } r3d_shader_raster_forward_inst_t;
 
 typedef struct {
@@ -365,7 +407,7 @@ typedef struct {
     unsigned int id;
     struct {
         r3d_shader_uniform_mat4_t matVP;
-        r3d_shader_uniform_sampler2D_t shadowMap;
+        r3d_shader_uniform_sampler2DArray_t shadowMap;
         r3d_shader_uniform_samplerCube_t shadowCubemap;
         r3d_shader_uniform_vec3_t color;
         r3d_shader_uniform_vec3_t position;
@@ -382,6 +424,9 @@ typedef struct {
         r3d_shader_uniform_float_t shadowMapTxlSz;
         r3d_shader_uniform_float_t shadowDepthBias;
         r3d_shader_uniform_float_t shadowSlopeBias;
+        r3d_shader_uniform_vec4_t cascades[R3D_SHADER_NUM_CASCADES];
+        r3d_shader_uniform_vec4_t tiles[R3D_SHADER_NUM_CASCADES];
+        r3d_shader_uniform_int_t cascadeCount;
         r3d_shader_uniform_int_t type;
         r3d_shader_uniform_int_t shadow;
     } uLight;
@@ -395,6 +440,23 @@ typedef struct {
     r3d_shader_uniform_mat4_t uMatInvView;
 } r3d_shader_screen_lighting_t;
 
+typedef struct {
+    unsigned int id;
+    r3d_shader_uniform_sampler2D_t uTexAlbedo;
+    r3d_shader_uniform_sampler2D_t uTexNormal;
+    r3d_shader_uniform_sampler2D_t uTexDepth;
+    r3d_shader_uniform_sampler2D_t uTexORM;
+    r3d_shader_uniform_sampler2D_t uTexLights;
+    r3d_shader_uniform_sampler2D_t uTexClusters;
+    r3d_shader_uniform_sampler2D_t uTexLightIndices;
+    r3d_shader_uniform_int_t uDirLightCount;
+    r3d_shader_uniform_vec2_t uClusterScale;
+    r3d_shader_uniform_vec2_t uClusterSlice;
+    r3d_shader_uniform_vec3_t uViewPosition;
+    r3d_shader_uniform_mat4_t uMatInvProj;
+    r3d_shader_uniform_mat4_t uMatInvView;
+} r3d_shader_screen_lighting_clustered_t;
+
 typedef struct {
     unsigned int id;
     r3d_shader_uniform_sampler2D_t uTexAlbedo;
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "./r3d_shadow_atlas.h"
+
+#include <raylib.h>
+#include "../glad.h"
+
+#include <stdlib.h>
+#include <stdint.h>
+
+/* === Internal functions === */
+
+static bool r3d_shadow_atlas_create_target(int size, int pages, unsigned int* framebuffer, unsigned int* depth)
+{
+    glGenFramebuffers(1, framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, *framebuffer);
+
+    glGenTextures(1, depth);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, *depth);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT16, size, size, pages, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_SHORT, NULL);
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, *depth, 0, 0);
+
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+
+    bool complete = (glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    return complete;
+}
+
+// Gathers the even bits of a Morton code
+static int r3d_shadow_atlas_compact_bits(uint32_t v)
+{
+    v &= 0x55555555;
+    v = (v | (v >> 1)) & 0x33333333;
+    v = (v | (v >> 2)) & 0x0F0F0F0F;
+    v = (v | (v >> 4)) & 0x00FF00FF;
+    v = (v | (v >> 8)) & 0x0000FFFF;
+    return (int)v;
+}
+
+static int r3d_shadow_atlas_compare_requests(const void* a, const void* b)
+{
+    const r3d_shadow_request_t* ra = a;
+    const r3d_shadow_request_t* rb = b;
+
+    if (ra->size != rb->size) {
+        return (ra->size < rb->size) ? 1 : -1;
+    }
+
+    // NOTE: The tiles are ordered so that the same requests always get the same tiles
+    return (ra->tiles > rb->tiles) - (ra->tiles < rb->tiles);
+}
+
+/* === Public functions === */
+
+bool r3d_shadow_atlas_load(r3d_shadow_atlas_t* atlas)
+{
+    bool complete = r3d_shadow_atlas_create_target(atlas->size, atlas->pages, &atlas->framebuffer, &atlas->depth);
+    complete &= r3d_shadow_atlas_create_target(atlas->size, atlas->pages, &atlas->staticFramebuffer, &atlas->staticDepth);
+
+    if (!complete) {
+        TraceLog(LOG_ERROR, "R3D: Failed to create the shadow atlas (%ix%i, %i pages)", atlas->size, atlas->size, atlas->pages);
+        r3d_shadow_atlas_unload(atlas);
+        return false;
+    }
+
+    // The tiles of the previous textures are lost
+    atlas->generation++;
+
+    return true;
+}
+
+void r3d_shadow_atlas_unload(r3d_shadow_atlas_t* atlas)
+{
+    if (atlas->framebuffer != 0) {
+        glDeleteFramebuffers(1, &atlas->framebuffer);
+        glDeleteTextures(1, &atlas->depth);
+    }
+    if (atlas->staticFramebuffer != 0) {
+        glDeleteFramebuffers(1, &atlas->staticFramebuffer);
+        glDeleteTextures(1, &atlas->staticDepth);
+    }
+
+    atlas->framebuffer = atlas->depth = 0;
+    atlas->staticFramebuffer = atlas->staticDepth = 0;
+    atlas->generation++;
+}
+
+void r3d_shadow_atlas_fit(const r3d_shadow_atlas_t* atlas, r3d_shadow_request_t* requests, int count)
+{
+    const long long capacity = (long long)atlas->size * atlas->size * atlas->pages;
+
+    long long total = 0;
+    for (int i = 0; i < count; i++) {
+        total += (long long)requests[i].layers * requests[i].size * requests[i].size;
+    }
+
+    while (total > capacity)
+    {
+        /* --- Find the least important request, the ones that can still be halved first --- */
+
+        int shrink = -1;
+        int drop = -1;
+
+        for (int i = 0; i < count; i++) {
+            const r3d_shadow_request_t* r = &requests[i];
+            if (r->size == 0) continue;
+            if (r->size > R3D_SHADOW_ATLAS_MIN_TILE) {
+                if (shrink < 0 || r->importance < requests[shrink].importance) shrink = i;
+            }
+            if (drop < 0 || r->importance < requests[drop].importance) drop = i;
+        }
+
+        /* --- Halve it, or drop it once everything is at the minimum size --- */
+
+        r3d_shadow_request_t* r = &requests[shrink >= 0 ? shrink : drop];
+        long long area = (long long)r->layers * r->size * r->size;
+
+        r->size = (shrink >= 0) ? r->size / 2 : 0;
+        total -= area - (long long)r->layers * r->size * r->size;
+    }
+}
+
+void r3d_shadow_atlas_pack(r3d_shadow_atlas_t* atlas, r3d_shadow_request_t* requests, int count)
+{
+    // NOTE: The tiles are placed along a Morton curve on a grid of the minimum tile size.
+    //       Since the sizes are powers of two placed from the largest, each tile starts
+    //       at a multiple of its own cell count, which is always an aligned square.
+
+    qsort(requests, count, sizeof(r3d_shadow_request_t), r3d_shadow_atlas_compare_requests);
+
+    const int pageCells = (atlas->size / R3D_SHADOW_ATLAS_MIN_TILE) * (atlas->size / R3D_SHADOW_ATLAS_MIN_TILE);
+    int cursor = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        r3d_shadow_request_t* r = &requests[i];
+        int cells = (r->size / R3D_SHADOW_ATLAS_MIN_TILE) * (r->size / R3D_SHADOW_ATLAS_MIN_TILE);
+
+        for (int j = 0; j < r->layers; j++)
+        {
+            if (r->size == 0) {
+                r->tiles[j] = (r3d_shadow_tile_t) { 0 };
+                continue;
+            }
+
+            int cell = cursor % pageCells;
+
+            r->tiles[j] = (r3d_shadow_tile_t) {
+                .x = r3d_shadow_atlas_compact_bits((uint32_t)cell) * R3D_SHADOW_ATLAS_MIN_TILE,
+                .y = r3d_shadow_atlas_compact_bits((uint32_t)cell >> 1) * R3D_SHADOW_ATLAS_MIN_TILE,
+                .size = r->size,
+                .page = cursor / pageCells
+            };
+
+            cursor += cells;
+        }
+    }
+
+    atlas->generation++;
+}
+
+void r3d_shadow_atlas_bind_tile(const r3d_shadow_atlas_t* atlas, const r3d_shadow_tile_t* tile, bool staticDepth)
+{
+    unsigned int framebuffer = staticDepth ? atlas->staticFramebuffer : atlas->framebuffer;
+    unsigned int depth = staticDepth ? atlas->staticDepth : atlas->depth;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depth, 0, tile->page);
+
+    glViewport(tile->x, tile->y, tile->size, tile->size);
+    glScissor(tile->x, tile->y, tile->size, tile->size);
+}
+
+void r3d_shadow_atlas_restore_tile(const r3d_shadow_atlas_t* atlas, const r3d_shadow_tile_t* tile)
+{
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, atlas->staticFramebuffer);
+    glFramebufferTextureLayer(GL_READ_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, atlas->staticDepth, 0, tile->page);
+
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, atlas->framebuffer);
+    glFramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, atlas->depth, 0, tile->page);
+
+    // NOTE: The blit is restricted by the scissor, which is set to the tile
+    glScissor(tile->x, tile->y, tile->size, tile->size);
+
+    int x0 = tile->x, y0 = tile->y;
+    int x1 = tile->x + tile->size, y1 = tile->y + tile->size;
+    glBlitFramebuffer(x0, y0, x1, y1, x0, y0, x1, y1, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, atlas->framebuffer);
+    glViewport(tile->x, tile->y, tile->size, tile->size);
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef R3D_DETAILS_SHADOW_ATLAS_H
+#define R3D_DETAILS_SHADOW_ATLAS_H
+
+#include <stdbool.h>
+
+/* === Defines === */
+
+#define R3D_SHADOW_ATLAS_MIN_TILE 128   //< Smallest tile, the tiles are packed on a grid of this size
+
+/* === Types === */
+
+typedef struct {
+    int x, y;               //< Corner of the tile in its page, in texels
+    int size;               //< Resolution of the tile, 0 if the tile isn't allocated
+    int page;               //< Layer of the atlas containing the tile
+} r3d_shadow_tile_t;
+
+typedef struct {
+    void* owner;                //< Object requesting the tiles, unused by the atlas
+    r3d_shadow_tile_t* tiles;   //< Receives the tiles of the request, one per layer
+    int layers;                 //< Number of tiles, all of the same size
+    int size;                   //< Resolution of the tiles, a power of two, 0 once the request is dropped
+    float importance;           //< The least important requests are shrunk first when the atlas is full
+} r3d_shadow_request_t;
+
+/*
+ * Shadow maps of the directional and spot lights, shared as square tiles of a depth texture array.
+ * The depth of the static casters is kept in a second array with the same layout, so a tile
+ * only draws its dynamic casters over a copy of its static depth when the static scene didn't change.
+ */
+typedef struct {
+    unsigned int framebuffer;
+    unsigned int depth;             //< Depth of all the casters, sampled when shading (one layer per page)
+    unsigned int staticFramebuffer;
+    unsigned int staticDepth;       //< Depth of the static casters only
+    int size;                       //< Resolution of the pages, a power of two
+    int pages;
+    unsigned int generation;        //< Incremented each time the tiles are packed, older tiles are invalid
+} r3d_shadow_atlas_t;
+
+/* === Functions === */
+
+// Creates the textures with the size and the pages of the atlas, returns false on failure
+bool r3d_shadow_atlas_load(r3d_shadow_atlas_t* atlas);
+void r3d_shadow_atlas_unload(r3d_shadow_atlas_t* atlas);
+
+// Halves the least important requests until they all fit in the atlas
+// The requests still too large once all of them are at the minimum size are dropped
+void r3d_shadow_atlas_fit(const r3d_shadow_atlas_t* atlas, r3d_shadow_request_t* requests, int count);
+
+// Gives their tiles to requests that fit in the atlas, the requests are reordered
+void r3d_shadow_atlas_pack(r3d_shadow_atlas_t* atlas, r3d_shadow_request_t* requests, int count);
+
+// Binds a tile of the atlas, or of the static depth, as the depth target
+// The viewport and the scissor are set to the tile, the scissor test must be enabled
+void r3d_shadow_atlas_bind_tile(const r3d_shadow_atlas_t* atlas, const r3d_shadow_tile_t* tile, bool staticDepth);
+
+// Copies the static depth of a tile in the atlas, then binds the atlas tile
+void r3d_shadow_atlas_restore_tile(const r3d_shadow_atlas_t* atlas, const r3d_shadow_tile_t* tile);
+
+#endif // R3D_DETAILS_SHADOW_ATLAS_H
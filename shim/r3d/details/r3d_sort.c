@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "./r3d_sort.h"
+
+#include <string.h>
+
+/* === Public functions === */
+
+void r3d_sort_radix_u64(uint64_t* keys, uint32_t* indices, uint64_t* tmpKeys, uint32_t* tmpIndices, size_t count)
+{
+    if (count < 2) return;
+
+    /* --- Build the histograms of the eight bytes in a single read of the keys --- */
+
+    size_t histograms[8][256];
+    memset(histograms, 0, sizeof(histograms));
+
+    for (size_t i = 0; i < count; i++) {
+        uint64_t key = keys[i];
+        for (int pass = 0; pass < 8; pass++) {
+            histograms[pass][(key >> (pass * 8)) & 0xFF]++;
+        }
+    }
+
+    /* --- Scatter the keys, from the least to the most significant byte --- */
+
+    uint64_t* srcKeys = keys;
+    uint32_t* srcIndices = indices;
+    uint64_t* dstKeys = tmpKeys;
+    uint32_t* dstIndices = tmpIndices;
+
+    for (int pass = 0; pass < 8; pass++)
+    {
+        size_t* histogram = histograms[pass];
+        int shift = pass * 8;
+
+        // All keys share this byte, the pass would not change the order
+        if (histogram[(srcKeys[0] >> shift) & 0xFF] == count) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (int b = 0; b < 256; b++) {
+            size_t n = histogram[b];
+            histogram[b] = offset;
+            offset += n;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            size_t dst = histogram[(srcKeys[i] >> shift) & 0xFF]++;
+            dstKeys[dst] = srcKeys[i];
+            dstIndices[dst] = srcIndices[i];
+        }
+
+        uint64_t* swapKeys = srcKeys;
+        srcKeys = dstKeys;
+        dstKeys = swapKeys;
+
+        uint32_t* swapIndices = srcIndices;
+        srcIndices = dstIndices;
+        dstIndices = swapIndices;
+    }
+
+    /* --- Bring the result back to the caller's buffers after an odd number of passes --- */
+
+    if (srcKeys != keys) {
+        memcpy(keys, srcKeys, count * sizeof(uint64_t));
+        memcpy(indices, srcIndices, count * sizeof(uint32_t));
+    }
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef R3D_DETAILS_SORT_H
+#define R3D_DETAILS_SORT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* === Functions === */
+
+// Converts a float to an unsigned integer with the same ordering, usable in sort keys
+static inline uint32_t r3d_sort_float_key(float value)
+{
+    union { float f; uint32_t u; } bits = { value };
+    return (bits.u & 0x80000000u) ? ~bits.u : (bits.u | 0x80000000u);
+}
+
+// Stable sort of 'indices' by ascending 'keys' (LSD radix sort, one byte per pass)
+// The bytes shared by all keys are skipped, so keys that only use a few bits sort faster
+// NOTE: 'tmpKeys' and 'tmpIndices' are scratch buffers of 'count' elements, the result is in 'keys' and 'indices'
+void r3d_sort_radix_u64(uint64_t* keys, uint32_t* indices, uint64_t* tmpKeys, uint32_t* tmpIndices, size_t count);
+
+#endif // R3D_DETAILS_SORT_H
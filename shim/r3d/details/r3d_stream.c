@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "./r3d_stream.h"
+
+#include <raylib.h>
+#include "../glad.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* === Internal functions === */
+
+static void r3d_stream_allocate(r3d_stream_t* stream, size_t frameSize)
+{
+    GLsizeiptr size = (GLsizeiptr)(R3D_STREAM_FRAME_COUNT * frameSize);
+
+    stream->frameSize = frameSize;
+    stream->mapped = NULL;
+
+    glGenBuffers(1, &stream->buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, stream->buffer);
+
+    // Try to obtain a persistent mapping, coherent so that nothing has to be flushed before the draws
+    if (GLAD_GL_ARB_buffer_storage && glBufferStorage != NULL) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, size, NULL, flags);
+        stream->mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags);
+        if (stream->mapped == NULL) {
+            // NOTE: The storage is immutable, the buffer must be created again for the fallback
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glDeleteBuffers(1, &stream->buffer);
+            glGenBuffers(1, &stream->buffer);
+            glBindBuffer(GL_ARRAY_BUFFER, stream->buffer);
+        }
+    }
+
+    if (stream->mapped == NULL) {
+        glBufferData(GL_ARRAY_BUFFER, size, NULL, GL_STREAM_DRAW);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+static void r3d_stream_release(r3d_stream_t* stream)
+{
+    for (int i = 0; i < R3D_STREAM_FRAME_COUNT; i++) {
+        if (stream->fences[i] != NULL) {
+            glDeleteSync(stream->fences[i]);
+            stream->fences[i] = NULL;
+        }
+    }
+
+    if (stream->buffer != 0) {
+        if (stream->mapped != NULL) {
+            glBindBuffer(GL_ARRAY_BUFFER, stream->buffer);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+        glDeleteBuffers(1, &stream->buffer);
+    }
+
+    stream->buffer = 0;
+    stream->mapped = NULL;
+}
+
+/* === Public functions === */
+
+r3d_stream_t r3d_stream_create(size_t frameSize)
+{
+    r3d_stream_t stream = { 0 };
+
+    r3d_stream_allocate(&stream, frameSize);
+
+    if (stream.buffer == 0) {
+        TraceLog(LOG_ERROR, "R3D: Failed to create the streaming buffer");
+    }
+    else {
+        TraceLog(LOG_INFO, "R3D: Streaming buffer created (%i x %zu bytes, %s)", R3D_STREAM_FRAME_COUNT, frameSize,
+                 stream.mapped ? "persistent mapping" : "buffer sub data");
+    }
+
+    return stream;
+}
+
+void r3d_stream_destroy(r3d_stream_t* stream)
+{
+    r3d_stream_release(stream);
+
+    free(stream->staging);
+    stream->staging = NULL;
+    stream->stagingSize = 0;
+}
+
+void r3d_stream_begin_frame(r3d_stream_t* stream)
+{
+    /* --- Grow the buffer if the previous frame did not fit --- */
+
+    if (stream->overflow > 0 && stream->buffer != 0) {
+        size_t required = stream->frameSize + stream->overflow;
+        size_t frameSize = (stream->frameSize > 0) ? stream->frameSize : 4096;
+        while (frameSize < required) {
+            frameSize *= 2;
+        }
+        // NOTE: Deleting a buffer still used by the GPU is deferred by the driver
+        r3d_stream_release(stream);
+        r3d_stream_allocate(stream, frameSize);
+        stream->overflow = 0;
+        stream->frame = 0;
+    }
+
+    /* --- Wait for the GPU to release the region of this frame --- */
+
+    stream->frame = (stream->frame + 1) % R3D_STREAM_FRAME_COUNT;
+    stream->offset = 0;
+
+    GLsync fence = stream->fences[stream->frame];
+    if (fence == NULL) return;
+
+    GLenum result = glClientWaitSync(fence, 0, 0);
+    if (result == GL_TIMEOUT_EXPIRED) {
+        result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX);
+    }
+    if (result == GL_WAIT_FAILED) {
+        TraceLog(LOG_WARNING, "R3D: Failed to wait for a streaming buffer fence");
+    }
+
+    glDeleteSync(fence);
+    stream->fences[stream->frame] = NULL;
+}
+
+void r3d_stream_end_frame(r3d_stream_t* stream)
+{
+    if (stream->buffer == 0) return;
+
+    if (stream->fences[stream->frame] != NULL) {
+        glDeleteSync(stream->fences[stream->frame]);
+    }
+
+    stream->fences[stream->frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void* r3d_stream_map(r3d_stream_t* stream, size_t size, size_t* offset)
+{
+    size_t aligned = (stream->offset + R3D_STREAM_ALIGNMENT - 1) & ~(size_t)(R3D_STREAM_ALIGNMENT - 1);
+
+    if (stream->buffer == 0) {
+        return NULL;
+    }
+
+    if (aligned + size > stream->frameSize) {
+        stream->overflow += size + R3D_STREAM_ALIGNMENT;
+        return NULL;
+    }
+
+    size_t base = (size_t)stream->frame * stream->frameSize + aligned;
+
+    if (stream->mapped == NULL && stream->stagingSize < size) {
+        void* staging = realloc(stream->staging, size);
+        if (staging == NULL) {
+            TraceLog(LOG_ERROR, "R3D: Failed to allocate the staging memory of the streaming buffer");
+            return NULL;
+        }
+        stream->staging = staging;
+        stream->stagingSize = size;
+    }
+
+    // NOTE: The fallback path uploads the pending range in 'r3d_stream_unmap'
+    stream->pendingOffset = base;
+    stream->pendingSize = size;
+
+    stream->offset = aligned + size;
+    *offset = base;
+
+    return (stream->mapped != NULL) ? stream->mapped + base : stream->staging;
+}
+
+void r3d_stream_unmap(r3d_stream_t* stream)
+{
+    if (stream->mapped != NULL) return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, stream->buffer);
+    glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)stream->pendingOffset, (GLsizeiptr)stream->pendingSize, stream->staging);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+bool r3d_stream_write(r3d_stream_t* stream, const void* data, size_t size, size_t* offset)
+{
+    void* dst = r3d_stream_map(stream, size, offset);
+    if (dst == NULL) return false;
+
+    memcpy(dst, data, size);
+    r3d_stream_unmap(stream);
+
+    return true;
+}
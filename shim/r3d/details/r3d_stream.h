@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef R3D_DETAILS_STREAM_H
+#define R3D_DETAILS_STREAM_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/* === Defines === */
+
+#define R3D_STREAM_FRAME_COUNT  3       //< Number of frames the GPU can lag behind before the CPU waits
+#define R3D_STREAM_ALIGNMENT    16      //< Alignment of each write, enough for vertex attributes and pixel unpacking
+
+/* === Types === */
+
+/*
+ * Streaming buffer split into R3D_STREAM_FRAME_COUNT regions, one per frame in flight.
+ * Each region is protected by a fence, so the region of a frame is only written again
+ * once the GPU has finished with it. The buffer is persistently mapped when buffer
+ * storage is supported, otherwise the writes go through a staging copy and glBufferSubData.
+ * When a frame does not fit in its region, the writes fail and the buffer grows at the next frame.
+ */
+typedef struct {
+    unsigned int buffer;                                //< GL buffer object, 0 if it could not be created
+    unsigned char* mapped;                              //< Persistent mapping of the whole buffer, NULL for the fallback
+    unsigned char* staging;                             //< Staging memory of the fallback path
+    size_t stagingSize;
+    size_t pendingOffset;                               //< Range of the last map, uploaded by the fallback on unmap
+    size_t pendingSize;
+    struct __GLsync* fences[R3D_STREAM_FRAME_COUNT];    //< Fence of the last frame that used each region
+    size_t frameSize;                                   //< Size of one region in bytes
+    size_t offset;                                      //< Write head in the current region
+    size_t overflow;                                    //< Bytes that did not fit during the current frame
+    int frame;                                          //< Current region
+} r3d_stream_t;
+
+/* === Functions === */
+
+r3d_stream_t r3d_stream_create(size_t frameSize);
+void r3d_stream_destroy(r3d_stream_t* stream);
+
+// Waits until the GPU has released the next region, the buffer is also grown here if the previous frame overflowed
+void r3d_stream_begin_frame(r3d_stream_t* stream);
+
+// Places the fence protecting the region of the current frame
+void r3d_stream_end_frame(r3d_stream_t* stream);
+
+// Returns a pointer where 'size' bytes can be written, and the offset of this data in the buffer
+// Returns NULL if the region of the frame is full, each successful call must be followed by 'r3d_stream_unmap'
+void* r3d_stream_map(r3d_stream_t* stream, size_t size, size_t* offset);
+void r3d_stream_unmap(r3d_stream_t* stream);
+
+// Same as map/copy/unmap, returns false if the region of the frame is full
+bool r3d_stream_write(r3d_stream_t* stream, const void* data, size_t size, size_t* offset);
+
+#endif // R3D_DETAILS_STREAM_H
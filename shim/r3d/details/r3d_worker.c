@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "./r3d_worker.h"
+
+#include <raylib.h>
+
+#include <pthread.h>
+#include <stdlib.h>
+
+/* === Defines === */
+
+#define R3D_WORKER_MAX_THREADS 8
+
+/* === Internal types === */
+
+typedef struct r3d_worker_task {
+    struct r3d_worker_task* next;
+    r3d_worker_func_t func;
+    void* userData;
+} r3d_worker_task_t;
+
+struct r3d_worker {
+
+    pthread_t threads[R3D_WORKER_MAX_THREADS];
+    int threadCount;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t wakeCond;
+    r3d_worker_task_t* head;        //< Tasks waiting for a thread, in submission order
+    r3d_worker_task_t* tail;
+    bool shutdown;
+};
+
+/* === Internal functions === */
+
+static void* r3d_worker_thread(void* arg)
+{
+    r3d_worker_t* worker = arg;
+
+    pthread_mutex_lock(&worker->mutex);
+
+    for (;;)
+    {
+        // NOTE: The queue is drained before stopping, the tasks own resources released by their function
+        while (worker->head == NULL && !worker->shutdown) {
+            pthread_cond_wait(&worker->wakeCond, &worker->mutex);
+        }
+
+        r3d_worker_task_t* task = worker->head;
+        if (task == NULL) {
+            break;
+        }
+
+        worker->head = task->next;
+        if (worker->head == NULL) {
+            worker->tail = NULL;
+        }
+
+        pthread_mutex_unlock(&worker->mutex);
+        task->func(task->userData);
+        free(task);
+        pthread_mutex_lock(&worker->mutex);
+    }
+
+    pthread_mutex_unlock(&worker->mutex);
+
+    return NULL;
+}
+
+/* === Public functions === */
+
+r3d_worker_t* r3d_worker_create(int threadCount)
+{
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > R3D_WORKER_MAX_THREADS) {
+        threadCount = R3D_WORKER_MAX_THREADS;
+    }
+
+    r3d_worker_t* worker = calloc(1, sizeof(r3d_worker_t));
+    if (worker == NULL) {
+        return NULL;
+    }
+
+    pthread_mutex_init(&worker->mutex, NULL);
+    pthread_cond_init(&worker->wakeCond, NULL);
+
+    for (int i = 0; i < threadCount; i++) {
+        if (pthread_create(&worker->threads[i], NULL, r3d_worker_thread, worker) != 0) {
+            TraceLog(LOG_WARNING, "R3D: Failed to create loading thread %d, %d thread(s) will be used", i, worker->threadCount);
+            break;
+        }
+        worker->threadCount++;
+    }
+
+    if (worker->threadCount == 0) {
+        r3d_worker_destroy(worker);
+        return NULL;
+    }
+
+    return worker;
+}
+
+void r3d_worker_destroy(r3d_worker_t* worker)
+{
+    if (worker == NULL) return;
+
+    pthread_mutex_lock(&worker->mutex);
+    worker->shutdown = true;
+    pthread_cond_broadcast(&worker->wakeCond);
+    pthread_mutex_unlock(&worker->mutex);
+
+    for (int i = 0; i < worker->threadCount; i++) {
+        pthread_join(worker->threads[i], NULL);
+    }
+
+    pthread_cond_destroy(&worker->wakeCond);
+    pthread_mutex_destroy(&worker->mutex);
+
+    free(worker);
+}
+
+bool r3d_worker_submit(r3d_worker_t* worker, r3d_worker_func_t func, void* userData)
+{
+    r3d_worker_task_t* task = malloc(sizeof(r3d_worker_task_t));
+    if (task == NULL) {
+        return false;
+    }
+
+    task->next = NULL;
+    task->func = func;
+    task->userData = userData;
+
+    pthread_mutex_lock(&worker->mutex);
+
+    if (worker->tail != NULL) worker->tail->next = task;
+    else worker->head = task;
+    worker->tail = task;
+
+    pthread_cond_signal(&worker->wakeCond);
+    pthread_mutex_unlock(&worker->mutex);
+
+    return true;
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef R3D_DETAILS_WORKER_H
+#define R3D_DETAILS_WORKER_H
+
+#include <stdbool.h>
+
+/* === Types === */
+
+/*
+ * Task run on a background thread of a worker. Unlike the jobs of the pool,
+ * the caller does not wait for the tasks, they are run in submission order
+ * by the first idle thread and must synchronize their results themselves.
+ */
+typedef void (*r3d_worker_func_t)(void* userData);
+
+typedef struct r3d_worker r3d_worker_t;
+
+/* === Functions === */
+
+// Creates a worker with 'threadCount' background threads, returns NULL on failure
+r3d_worker_t* r3d_worker_create(int threadCount);
+
+// Waits until all the submitted tasks are done, then stops the threads
+void r3d_worker_destroy(r3d_worker_t* worker);
+
+// Queues a task, returns false if it could not be queued
+bool r3d_worker_submit(r3d_worker_t* worker, r3d_worker_func_t func, void* userData);
+
+#endif // R3D_DETAILS_WORKER_H
@@ -34,6 +34,10 @@
 #include "./details/r3d_drawcall.h"
 #include "./details/r3d_billboard.h"
 #include "./details/r3d_primitives.h"
+#include "./details/r3d_jobs.h"
+#include "./details/r3d_bvh.h"
+#include "./details/r3d_anim_clip.h"
+#include "./details/r3d_anim_blend.h"
 #include "./details/containers/r3d_array.h"
 #include "./details/containers/r3d_registry.h"
 
@@ -52,12 +56,51 @@
 #define R3D_IS_SHADOW_CAST_ONLY(mode) \
     ((R3D_SHADOW_CAST_ONLY_MASK & (1 << (mode))) != 0)
 
+/* === Internal Types === */
+
+typedef struct {
+    r3d_array_t* arrays[4];     //< Draw call arrays, in the order of the visibility mask
+    r3d_aabb_soa_t boxes;       //< World space boxes of the draw calls
+    uint32_t* mask;             //< Visibility bits of the draw calls
+} r3d_cull_job_t;
+
+typedef struct {
+    int first;                  //< Index of the first call of the group, used as reference for the comparisons
+    int count;                  //< Number of calls sharing the same mesh and material
+    int instIndex;              //< Index of the instanced call replacing the group, -1 if the group is too small
+    int offset;                 //< Offset of the group in the transforms buffer
+    int filled;                 //< Number of transforms already written
+} r3d_batch_group_t;
+
+typedef struct {
+    const Matrix* boneOffsets;  //< The pose is identified by the bone offsets, the animation and the frame
+    const R3D_ModelAnimation* anim;
+    int frame;
+    float fraction;             //< Position between two frames, always zero for the baked animations
+    const R3D_AnimationLayer* layers;   //< Layers of the blended poses, identified by the layers instead of the frame
+    int layerCount;
+    int boneDepth;              //< Depth limit of the evaluated bones, -1 for all the bones
+    Matrix* matrices;           //< Bone matrices of the pose in 'aPoseMatrices'
+    const Matrix* held;         //< Matrices of the same pose in the previous frame, copied instead of evaluated, NULL otherwise
+    Matrix* scratch;            //< Scratch memory of the compressed and blended poses, NULL otherwise
+} r3d_pose_entry_t;
+
+typedef struct {
+    const Matrix* matrices;     //< Bone matrices of the calls, shared by all the calls with the same pose
+    int count;
+    int offset;                 //< Offset of the matrices in the storage atlas, relative to the upload
+} r3d_skin_entry_t;
+
 /* === Internal Functions Declarations === */
 
 static bool r3d_has_deferred_calls(void);
 static bool r3d_has_forward_calls(void);
+static r3d_drawcall_t* r3d_get_drawcall_in_order(const r3d_array_t* calls, const r3d_array_t* order, size_t index);
 
 static void r3d_sprite_get_uv_scale_offset(Vector2* uvScale, Vector2* uvOffset, const R3D_Sprite* sprite, float sgnX, float sgnY);
+static void r3d_model_set_drawcall_layers(r3d_drawcall_t* call, const R3D_Model* model);
+static const R3D_AnimationLOD* r3d_model_get_anim_lod(const R3D_Model* model, const Matrix* transform);
+static void r3d_model_set_drawcall_lod(r3d_drawcall_t* call, const R3D_Model* model, const R3D_AnimationLOD* lod);
 
 static void r3d_stencil_enable_geometry_write(void);
 static void r3d_stencil_enable_geometry_test(GLenum condition);
@@ -68,17 +111,40 @@ static void r3d_stencil_disable(void);
 
 static void r3d_prepare_process_lights_and_batch(void);
 static void r3d_prepare_cull_drawcalls(void);
+static void r3d_prepare_static_drawcalls(void);
+static void r3d_prepare_batch_drawcalls(void);
+static void r3d_prepare_light_storage(void);
+static void r3d_prepare_batch_drawcall_array(r3d_array_t* calls, r3d_array_t* instCalls);
+static bool r3d_prepare_batch_is_eligible(const r3d_drawcall_t* call);
+static bool r3d_prepare_batch_is_compatible(const r3d_drawcall_t* a, const r3d_drawcall_t* b);
+static void r3d_prepare_stream_instances(void);
+static void r3d_prepare_upload_bone_matrices(void);
+static void r3d_prepare_skin_drawcalls(void);
+static void r3d_prepare_skin_mesh(r3d_skinned_mesh_t* skinned, const R3D_Mesh* mesh, int boneStorage);
 static void r3d_prepare_sort_drawcalls(void);
+static void r3d_prepare_sort_drawcall_array(const r3d_array_t* calls, r3d_array_t* order, r3d_array_t* keys,
+                                            void (*sortFunc)(const r3d_drawcall_t*, size_t, uint64_t*, uint32_t*));
 static void r3d_prepare_anim_drawcalls(void);
 
+static void r3d_prepare_job_process_lights(void* userData, int begin, int end);
+static void r3d_prepare_job_cull_drawcalls(void* userData, int begin, int end);
+static void r3d_prepare_job_sort_drawcalls(void* userData, int begin, int end);
+static void r3d_prepare_job_anim_drawcalls(void* userData, int begin, int end);
+static bool r3d_pose_entry_equals(const r3d_pose_entry_t* a, const r3d_pose_entry_t* b);
+
 static void r3d_clear_gbuffer(bool bindFramebuffer, bool clearColor, bool clearDepth, bool clearStencil);
 
+static void r3d_static_mesh_update_drawcall(r3d_static_mesh_t* staticMesh);
+
 static void r3d_pass_shadow_maps(void);
+static void r3d_pass_shadow_maps_allocate_tiles(void);
+static void r3d_pass_shadow_maps_static(const Matrix* matVP, bool omni);
 static void r3d_pass_gbuffer(void);
 static void r3d_pass_ssao(void);
 
 static void r3d_pass_deferred_ambient(void);
 static void r3d_pass_deferred_lights(void);
+static void r3d_pass_deferred_lights_clustered(void);
 
 static void r3d_pass_scene_background(void);
 static void r3d_pass_scene_deferred(void);
@@ -113,9 +179,67 @@ void R3D_Init(int resWidth, int resHeight, unsigned int flags)
     R3D.container.aDrawForwardInst = r3d_array_create(8, sizeof(r3d_drawcall_t));
     R3D.container.aDrawDeferredInst = r3d_array_create(8, sizeof(r3d_drawcall_t));
 
+    // Load draw call sort buffers
+    R3D.container.aDrawDeferredOrder = r3d_array_create(256, sizeof(uint32_t));
+    R3D.container.aDrawDeferredKeys = r3d_array_create(256, sizeof(uint64_t));
+    R3D.container.aDrawForwardOrder = r3d_array_create(256, sizeof(uint32_t));
+    R3D.container.aDrawForwardKeys = r3d_array_create(256, sizeof(uint64_t));
+
+    // Load material cache
+    R3D.container.materials = r3d_material_cache_create(64);
+
     // Load lights registry
     R3D.container.rLights = r3d_registry_create(8, sizeof(r3d_light_t));
     R3D.container.aLightBatch = r3d_array_create(8, sizeof(r3d_light_batched_t));
+    R3D.container.aShadowRequests = r3d_array_create(8, sizeof(r3d_shadow_request_t));
+
+    // Load light clusters
+    r3d_cluster_grid_create(&R3D.container.clusterGrid);
+    R3D.container.aLightData = r3d_array_create(4 * 8, sizeof(Vector4));
+    R3D.container.aLightSpheres = r3d_array_create(8, sizeof(Vector4));
+    R3D.container.aShadowLightLists = r3d_array_create(256, sizeof(int));
+    R3D.container.aClusterPairs = r3d_array_create(256, sizeof(uint32_t));
+    R3D.container.aClusterRanges = r3d_array_create(2 * R3D_CLUSTER_COUNT, sizeof(uint32_t));
+    R3D.container.aLightIndices = r3d_array_create(256, sizeof(uint16_t));
+
+    // Load prepare phase scratch arrays
+    R3D.container.aCullBoxes = r3d_array_create(6 * 256, sizeof(float));
+    R3D.container.aCullMask = r3d_array_create(8, sizeof(uint32_t));
+    R3D.container.aAnimCalls = r3d_array_create(8, sizeof(r3d_drawcall_t*));
+    R3D.container.aPoses = r3d_array_create(8, sizeof(r3d_pose_entry_t));
+    R3D.container.aPoseTable = r3d_array_create(16, sizeof(int));
+    R3D.container.aPoseMatrices = r3d_array_create(256, sizeof(Matrix));
+    R3D.container.aPrevPoses = r3d_array_create(8, sizeof(r3d_pose_entry_t));
+    R3D.container.aPrevPoseTable = r3d_array_create(16, sizeof(int));
+    R3D.container.aPrevPoseMatrices = r3d_array_create(256, sizeof(Matrix));
+    R3D.container.aInstBoxes = r3d_array_create(6 * 256, sizeof(float));
+    R3D.container.aInstMask = r3d_array_create(8, sizeof(uint32_t));
+    R3D.container.aInstTransforms = r3d_array_create(256, sizeof(Matrix));
+    R3D.container.aInstColors = r3d_array_create(256, sizeof(Color));
+    R3D.container.aBatchTransforms = r3d_array_create(256, sizeof(Matrix));
+    R3D.container.aBatchGroups = r3d_array_create(64, sizeof(r3d_batch_group_t));
+    R3D.container.aBatchCallGroups = r3d_array_create(256, sizeof(int));
+    R3D.container.aBatchTable = r3d_array_create(512, sizeof(int));
+    R3D.container.aSkinCalls = r3d_array_create(8, sizeof(r3d_drawcall_t*));
+    R3D.container.aSkinTable = r3d_array_create(16, sizeof(r3d_skin_entry_t));
+    R3D.container.aSkinnedMeshes = r3d_array_create(8, sizeof(r3d_skinned_mesh_t));
+    R3D.container.aSkinnedTable = r3d_array_create(16, sizeof(int));
+
+    // Load static scene
+    R3D.container.rStaticMeshes = r3d_registry_create(32, sizeof(r3d_static_mesh_t));
+    R3D.container.staticTree = r3d_bvh_create(64);
+    R3D.container.aStaticVisible = r3d_array_create(64, sizeof(unsigned int));
+
+    // Load asynchronous loading registry
+    R3D.container.rAsyncModels = r3d_registry_create(8, sizeof(void*));
+
+    // Create worker threads
+    R3D.jobs.pool = NULL;
+    if (flags & (R3D_FLAG_PARALLEL_PREPARE | R3D_FLAG_PARALLEL_LOADING)) {
+        R3D.jobs.pool = r3d_job_pool_create(0);
+    }
+    R3D.jobs.prepare = (flags & R3D_FLAG_PARALLEL_PREPARE) ? R3D.jobs.pool : NULL;
+    R3D.jobs.loading = (flags & R3D_FLAG_PARALLEL_LOADING) ? R3D.jobs.pool : NULL;
 
     // Environment data
     R3D.env.backgroundColor = (Vector3) { 0.2f, 0.2f, 0.2f };
@@ -177,9 +301,15 @@ void R3D_Init(int resWidth, int resHeight, unsigned int flags)
         (Vector3) {  100,  100,  100 }
     };
 
+    // Init shadow atlas, its textures are created with the first light drawn in it
+    R3D.framebuffer.shadowAtlas.size = 4096;
+    R3D.framebuffer.shadowAtlas.pages = 1;
+
     // Init default loading parameters
     R3D.state.loading.aiProps = aiCreatePropertyStore();
     R3D.state.loading.textureFilter = TEXTURE_FILTER_TRILINEAR;
+    R3D.state.loading.compressAnimations = false;
+    R3D.state.loading.uploadBudget = 2.0f;
 
     // Init default rendering layers
     R3D.state.layers = 0;
@@ -205,15 +335,24 @@ void R3D_Init(int resWidth, int resHeight, unsigned int flags)
     r3d_storages_load();
     r3d_shaders_load();
 
+    // Fallback material of the draw calls, built here because the sort jobs read it
+    // NOTE: It references the default textures, which must be loaded first
+    R3D.container.defaultMaterial = R3D_GetDefaultMaterial();
+
     // Defines suitable clipping plane distances for r3d
     rlSetClipPlanes(0.05f, 4000.0f);
 }
 
 void R3D_Close(void)
 {
+    // NOTE: The loading threads use the import properties, they are stopped first
+    r3d_async_models_release();
+    r3d_registry_destroy(&R3D.container.rAsyncModels);
+
     aiReleasePropertyStore(R3D.state.loading.aiProps);
 
     r3d_framebuffers_unload();
+    r3d_shadow_atlas_unload(&R3D.framebuffer.shadowAtlas);
     r3d_textures_unload();
     r3d_storages_unload();
     r3d_shaders_unload();
@@ -223,8 +362,62 @@ void R3D_Close(void)
     r3d_array_destroy(&R3D.container.aDrawForwardInst);
     r3d_array_destroy(&R3D.container.aDrawDeferredInst);
 
+    r3d_array_destroy(&R3D.container.aDrawDeferredOrder);
+    r3d_array_destroy(&R3D.container.aDrawDeferredKeys);
+    r3d_array_destroy(&R3D.container.aDrawForwardOrder);
+    r3d_array_destroy(&R3D.container.aDrawForwardKeys);
+
+    r3d_material_cache_destroy(&R3D.container.materials);
+
     r3d_registry_destroy(&R3D.container.rLights);
     r3d_array_destroy(&R3D.container.aLightBatch);
+    r3d_array_destroy(&R3D.container.aShadowRequests);
+
+    r3d_cluster_grid_destroy(&R3D.container.clusterGrid);
+    r3d_array_destroy(&R3D.container.aLightData);
+    r3d_array_destroy(&R3D.container.aLightSpheres);
+    r3d_array_destroy(&R3D.container.aShadowLightLists);
+    r3d_array_destroy(&R3D.container.aClusterPairs);
+    r3d_array_destroy(&R3D.container.aClusterRanges);
+    r3d_array_destroy(&R3D.container.aLightIndices);
+
+    r3d_array_destroy(&R3D.container.aCullBoxes);
+    r3d_array_destroy(&R3D.container.aCullMask);
+    r3d_array_destroy(&R3D.container.aAnimCalls);
+    r3d_array_destroy(&R3D.container.aPoses);
+    r3d_array_destroy(&R3D.container.aPoseTable);
+    r3d_array_destroy(&R3D.container.aPoseMatrices);
+    r3d_array_destroy(&R3D.container.aPrevPoses);
+    r3d_array_destroy(&R3D.container.aPrevPoseTable);
+    r3d_array_destroy(&R3D.container.aPrevPoseMatrices);
+    r3d_array_destroy(&R3D.container.aInstBoxes);
+    r3d_array_destroy(&R3D.container.aInstMask);
+    r3d_array_destroy(&R3D.container.aInstTransforms);
+    r3d_array_destroy(&R3D.container.aInstColors);
+    r3d_array_destroy(&R3D.container.aBatchTransforms);
+    r3d_array_destroy(&R3D.container.aBatchGroups);
+    r3d_array_destroy(&R3D.container.aBatchCallGroups);
+    r3d_array_destroy(&R3D.container.aBatchTable);
+    r3d_array_destroy(&R3D.container.aSkinCalls);
+    r3d_array_destroy(&R3D.container.aSkinTable);
+
+    r3d_skinned_mesh_t* skinnedMeshes = R3D.container.aSkinnedMeshes.data;
+    for (size_t i = 0; i < R3D.container.aSkinnedMeshes.count; i++) {
+        glDeleteVertexArrays(1, &skinnedMeshes[i].vao);
+        glDeleteBuffers(1, &skinnedMeshes[i].vbo);
+    }
+
+    r3d_array_destroy(&R3D.container.aSkinnedMeshes);
+    r3d_array_destroy(&R3D.container.aSkinnedTable);
+
+    r3d_registry_destroy(&R3D.container.rStaticMeshes);
+    r3d_bvh_destroy(&R3D.container.staticTree);
+    r3d_array_destroy(&R3D.container.aStaticVisible);
+
+    r3d_job_pool_destroy(R3D.jobs.pool);
+    R3D.jobs.pool = NULL;
+    R3D.jobs.prepare = NULL;
+    R3D.jobs.loading = NULL;
 
     glDeleteVertexArrays(1, &R3D.primitive.dummyVAO);
     r3d_primitive_unload(&R3D.primitive.quad);
@@ -248,6 +441,16 @@ void R3D_SetState(unsigned int flags)
         flags &= ~R3D_FLAG_LOW_PRECISION_BUFFERS;
     }
 
+    if (flags & R3D_FLAG_PARALLEL_PREPARE) {
+        TraceLog(LOG_WARNING, "R3D: Cannot set 'R3D_FLAG_PARALLEL_PREPARE'; this flag must be set during R3D initialization");
+        flags &= ~R3D_FLAG_PARALLEL_PREPARE;
+    }
+
+    if (flags & R3D_FLAG_PARALLEL_LOADING) {
+        TraceLog(LOG_WARNING, "R3D: Cannot set 'R3D_FLAG_PARALLEL_LOADING'; this flag must be set during R3D initialization");
+        flags &= ~R3D_FLAG_PARALLEL_LOADING;
+    }
+
     R3D.state.flags |= flags;
 
     if (flags & R3D_FLAG_FXAA) {
@@ -255,6 +458,18 @@ void R3D_SetState(unsigned int flags)
             r3d_shader_load_screen_fxaa();
         }
     }
+
+    if (flags & R3D_FLAG_SKINNING_PREPASS) {
+        if (R3D.shader.generate.skinning.id == 0) {
+            r3d_shader_load_generate_skinning();
+        }
+    }
+
+    if (flags & R3D_FLAG_CLUSTERED_LIGHTING) {
+        if (R3D.shader.screen.lightingClustered.id == 0) {
+            r3d_shader_load_screen_lighting_clustered();
+        }
+    }
 }
 
 void R3D_ClearState(unsigned int flags)
@@ -269,6 +484,16 @@ void R3D_ClearState(unsigned int flags)
         flags &= ~R3D_FLAG_LOW_PRECISION_BUFFERS;
     }
 
+    if (flags & R3D_FLAG_PARALLEL_PREPARE) {
+        TraceLog(LOG_WARNING, "R3D: Cannot clear 'R3D_FLAG_PARALLEL_PREPARE'; this flag must be set during R3D initialization");
+        flags &= ~R3D_FLAG_PARALLEL_PREPARE;
+    }
+
+    if (flags & R3D_FLAG_PARALLEL_LOADING) {
+        TraceLog(LOG_WARNING, "R3D: Cannot clear 'R3D_FLAG_PARALLEL_LOADING'; this flag must be set during R3D initialization");
+        flags &= ~R3D_FLAG_PARALLEL_LOADING;
+    }
+
     R3D.state.flags &= ~flags;
 }
 
@@ -278,6 +503,11 @@ void R3D_GetResolution(int* width, int* height)
     if (height) *height = R3D.state.resolution.height;
 }
 
+R3D_BindStats R3D_GetBindStats(void)
+{
+    return R3D.state.bound.stats;
+}
+
 void R3D_UpdateResolution(int width, int height)
 {
     if (width <= 0 || height <= 0) {
@@ -304,6 +534,25 @@ void R3D_SetSceneBounds(BoundingBox sceneBounds)
     R3D.state.scene.bounds = sceneBounds;
 }
 
+void R3D_SetShadowAtlasSize(int size, int pages)
+{
+    r3d_shadow_atlas_t* atlas = &R3D.framebuffer.shadowAtlas;
+
+    // The pages have a power of two size so that the tiles are packed without gaps
+    int pow2 = R3D_SHADOW_ATLAS_MIN_TILE;
+    while (pow2 < size && pow2 < 16384) pow2 *= 2;
+    if (pages < 1) pages = 1;
+
+    if (atlas->size == pow2 && atlas->pages == pages) {
+        return;
+    }
+
+    // NOTE: The textures are created again with the next light drawn in the atlas
+    r3d_shadow_atlas_unload(atlas);
+    atlas->size = pow2;
+    atlas->pages = pages;
+}
+
 void R3D_SetTextureFilter(TextureFilter filter)
 {
     R3D.state.loading.textureFilter = filter;
@@ -347,6 +596,11 @@ void R3D_BeginEx(Camera3D camera, const RenderTexture* target)
     r3d_array_clear(&R3D.container.aDrawForwardInst);
     r3d_array_clear(&R3D.container.aDrawDeferredInst);
 
+    /* --- Release the materials that are no longer used --- */
+
+    R3D.state.frameIndex++;
+    r3d_material_cache_collect(&R3D.container.materials, R3D.state.frameIndex);
+
     /* --- Store camera position --- */
 
     R3D.state.transform.viewPos = camera.position;
@@ -408,16 +662,27 @@ void R3D_BeginEx(Camera3D camera, const RenderTexture* target)
 
 void R3D_End(void)
 {
+    R3D.state.bound.stats = (R3D_BindStats) { 0 };
+
+    r3d_storage_begin_frame();
+
     /* --- Rendering in shadow maps --- */
 
     r3d_prepare_process_lights_and_batch();
+    r3d_prepare_stream_instances();
+    r3d_prepare_anim_drawcalls();
+    r3d_prepare_upload_bone_matrices();
+    r3d_prepare_skin_drawcalls();
     r3d_pass_shadow_maps();
 
     /* --- Prcoess all draw calls before rendering --- */
 
     r3d_prepare_cull_drawcalls();
+    r3d_prepare_static_drawcalls();
+    r3d_prepare_batch_drawcalls();
+    r3d_prepare_light_storage();
+    r3d_prepare_stream_instances();
     r3d_prepare_sort_drawcalls();
-    r3d_prepare_anim_drawcalls();
 
     /* --- Rasterizing Geometries in G-Buffer --- */
 
@@ -438,6 +703,9 @@ void R3D_End(void)
 
     if (r3d_has_deferred_calls()) {
         r3d_pass_deferred_ambient();
+        if (R3D.state.lightStorage.clustered) {
+            r3d_pass_deferred_lights_clustered();
+        }
         r3d_pass_deferred_lights();
     }
 
@@ -484,9 +752,15 @@ void R3D_End(void)
 
     r3d_pass_final_blit();
 
+    /* --- Upload the asynchronous loads within the frame budget --- */
+
+    r3d_async_models_update();
+
     /* --- Reset states changed by R3D --- */
 
     r3d_reset_raylib_state();
+
+    r3d_storage_end_frame();
 }
 
 void R3D_DrawMesh(const R3D_Mesh* mesh, const R3D_Material* material, Matrix transform)
@@ -509,7 +783,7 @@ void R3D_DrawMesh(const R3D_Mesh* mesh, const R3D_Material* material, Matrix tra
     }
 
     drawCall.transform = transform;
-    drawCall.material = material ? *material : R3D_GetDefaultMaterial();
+    r3d_drawcall_set_material(&drawCall, material);
     drawCall.shadowCastMode = mesh->shadowCastMode;
     drawCall.geometry.model.mesh = mesh;
     drawCall.geometryType = R3D_DRAWCALL_GEOMETRY_MODEL;
@@ -548,7 +822,7 @@ void R3D_DrawMeshInstancedPro(const R3D_Mesh* mesh, const R3D_Material* material
     r3d_drawcall_t drawCall = { 0 };
 
     drawCall.transform = globalTransform;
-    drawCall.material = material ? *material : R3D_GetDefaultMaterial();
+    r3d_drawcall_set_material(&drawCall, material);
     drawCall.shadowCastMode = mesh->shadowCastMode;
     drawCall.geometry.model.mesh = mesh;
     drawCall.geometryType = R3D_DRAWCALL_GEOMETRY_MODEL;
@@ -602,6 +876,8 @@ void R3D_DrawModelPro(const R3D_Model* model, Matrix transform)
 {
     if (model == NULL) return;
 
+    const R3D_AnimationLOD* animLod = r3d_model_get_anim_lod(model, &transform);
+
     for (int i = 0; i < model->meshCount; i++)
     {
         const R3D_Mesh* mesh = &model->meshes[i];
@@ -625,7 +901,7 @@ void R3D_DrawModelPro(const R3D_Model* model, Matrix transform)
         }
 
         drawCall.transform = transform;
-        drawCall.material = material ? *material : R3D_GetDefaultMaterial();
+        r3d_drawcall_set_material(&drawCall, material);
         drawCall.shadowCastMode = mesh->shadowCastMode;
         drawCall.geometry.model.mesh = mesh;
         drawCall.geometryType = R3D_DRAWCALL_GEOMETRY_MODEL;
@@ -633,11 +909,14 @@ void R3D_DrawModelPro(const R3D_Model* model, Matrix transform)
 
         drawCall.geometry.model.anim = model->anim;
         drawCall.geometry.model.frame = model->animFrame;
+        drawCall.geometry.model.frameFraction = model->animFrameFraction;
         drawCall.geometry.model.boneOffsets = model->boneOffsets;
         if (model->animationMode == R3D_ANIM_CUSTOM)
             drawCall.geometry.model.boneOverride = model->boneOverride;
         else
             drawCall.geometry.model.boneOverride = NULL;
+        r3d_model_set_drawcall_layers(&drawCall, model);
+        r3d_model_set_drawcall_lod(&drawCall, model, animLod);
 
         r3d_array_t* arr = &R3D.container.aDrawDeferred;
         if (material->blendMode != R3D_BLEND_OPAQUE || R3D.state.flags & R3D_FLAG_FORCE_FORWARD) {
@@ -697,7 +976,7 @@ void R3D_DrawModelInstancedPro(const R3D_Model* model,
         const R3D_Material* material = &model->materials[model->meshMaterials[i]];
 
         drawCall.transform = globalTransform;
-        drawCall.material = *material;
+        r3d_drawcall_set_material(&drawCall, material);
         drawCall.geometry.model.mesh = mesh;
         drawCall.geometryType = R3D_DRAWCALL_GEOMETRY_MODEL;
         
@@ -710,7 +989,11 @@ void R3D_DrawModelInstancedPro(const R3D_Model* model,
 
         drawCall.geometry.model.anim = model->anim;
         drawCall.geometry.model.frame = model->animFrame;
+        drawCall.geometry.model.frameFraction = model->animFrameFraction;
         drawCall.geometry.model.boneOffsets = model->boneOffsets;
+        r3d_model_set_drawcall_layers(&drawCall, model);
+        // NOTE: The instances are spread over the whole box, they are always animated at full rate
+        r3d_model_set_drawcall_lod(&drawCall, model, NULL);
 
         if (material->blendMode != R3D_BLEND_OPAQUE || forceForward) {
             drawCall.renderMode = R3D_DRAWCALL_RENDER_FORWARD;
@@ -783,16 +1066,19 @@ void R3D_DrawSpritePro(const R3D_Sprite* sprite, Vector3 position, Vector2 size,
 
     /* --- Finalizing the draw call data --- */
 
-    drawCall.transform = matTransform;
-    drawCall.material = sprite->material;
-    drawCall.geometryType = R3D_DRAWCALL_GEOMETRY_SPRITE;
-    drawCall.renderMode = R3D_DRAWCALL_RENDER_DEFERRED;
+    R3D_Material material = sprite->material;
 
     r3d_sprite_get_uv_scale_offset(
-        &drawCall.material.uvScale, &drawCall.material.uvOffset, sprite,
+        &material.uvScale, &material.uvOffset, sprite,
         (size.x > 0) ? 1.0f : -1.0f, (size.y > 0) ? 1.0f : -1.0f
     );
 
+    drawCall.transform = matTransform;
+    drawCall.geometryType = R3D_DRAWCALL_GEOMETRY_SPRITE;
+    drawCall.renderMode = R3D_DRAWCALL_RENDER_DEFERRED;
+
+    r3d_drawcall_set_material(&drawCall, &material);
+
     /* --- Added draw call to the right cache depending on render mode --- */
 
     r3d_array_t* arr = &R3D.container.aDrawDeferred;
@@ -826,17 +1112,20 @@ void R3D_DrawSpriteInstancedPro(const R3D_Sprite* sprite, const BoundingBox* glo
 
     r3d_drawcall_t drawCall = { 0 };
 
+    R3D_Material material = sprite->material;
+
+    r3d_sprite_get_uv_scale_offset(
+        &material.uvScale,
+        &material.uvOffset,
+        sprite, 1.0f, -1.0f
+    );
+
     drawCall.transform = globalTransform;
-    drawCall.material = sprite->material;
     drawCall.shadowCastMode = sprite->shadowCastMode;
     drawCall.geometryType = R3D_DRAWCALL_GEOMETRY_SPRITE;
     drawCall.renderMode = R3D_DRAWCALL_RENDER_DEFERRED;
 
-    r3d_sprite_get_uv_scale_offset(
-        &drawCall.material.uvScale,
-        &drawCall.material.uvOffset,
-        sprite, 1.0f, -1.0f
-    );
+    r3d_drawcall_set_material(&drawCall, &material);
 
     drawCall.instanced.allAabb = globalAabb ? *globalAabb
         : (BoundingBox) {
@@ -892,6 +1181,100 @@ static bool r3d_has_forward_calls(void)
     return (R3D.container.aDrawForward.count > 0 || R3D.container.aDrawForwardInst.count > 0);
 }
 
+r3d_drawcall_t* r3d_get_drawcall_in_order(const r3d_array_t* calls, const r3d_array_t* order, size_t index)
+{
+    // The order is only filled when the array has been sorted, otherwise the insertion order is kept
+    if (order->count == calls->count) {
+        index = ((const uint32_t*)order->data)[index];
+    }
+
+    return (r3d_drawcall_t*)calls->data + index;
+}
+
+void r3d_model_set_drawcall_layers(r3d_drawcall_t* call, const R3D_Model* model)
+{
+    if (model->animationMode != R3D_ANIM_LAYERS || model->animLayers == NULL || model->animLayerCount <= 0) {
+        return;
+    }
+
+    // NOTE: The first layer animation stands for the whole blend, it gives the bone count
+    //       and makes the call skinned, a model without base animation is not animated
+    call->geometry.model.anim = model->animLayers[0].anim;
+    call->geometry.model.layers = model->animLayers;
+    call->geometry.model.layerCount = model->animLayerCount;
+}
+
+const R3D_AnimationLOD* r3d_model_get_anim_lod(const R3D_Model* model, const Matrix* transform)
+{
+    if (model->animLods == NULL || model->animLodCount <= 0) {
+        return NULL;
+    }
+
+    // NOTE: The screen size is the projected height of the bounding sphere of the model relative
+    //       to the screen height, the sphere is scaled by the largest axis of the transform
+
+    Vector3 center = Vector3Scale(Vector3Add(model->aabb.min, model->aabb.max), 0.5f);
+    float radius = 0.5f * Vector3Distance(model->aabb.min, model->aabb.max);
+
+    float sx = Vector3Length((Vector3) { transform->m0, transform->m1, transform->m2 });
+    float sy = Vector3Length((Vector3) { transform->m4, transform->m5, transform->m6 });
+    float sz = Vector3Length((Vector3) { transform->m8, transform->m9, transform->m10 });
+
+    center = Vector3Transform(center, *transform);
+    radius *= fmaxf(sx, fmaxf(sy, sz));
+
+    const Matrix* proj = &R3D.state.transform.proj;
+    float screenSize = radius * proj->m5;
+
+    if (proj->m15 == 0.0f) {
+        float distance = Vector3Distance(center, R3D.state.transform.viewPos);
+        if (distance <= radius) return NULL;
+        screenSize /= distance;
+    }
+
+    const R3D_AnimationLOD* lod = NULL;
+    for (int i = 0; i < model->animLodCount && screenSize < model->animLods[i].screenSize; i++) {
+        lod = &model->animLods[i];
+    }
+
+    return lod;
+}
+
+void r3d_model_set_drawcall_lod(r3d_drawcall_t* call, const R3D_Model* model, const R3D_AnimationLOD* lod)
+{
+    call->geometry.model.boneDepth = -1;
+    call->geometry.model.heldPose = false;
+
+    if (lod == NULL || call->geometry.model.anim == NULL) {
+        return;
+    }
+
+    call->geometry.model.boneDepth = (lod->boneDepth >= 0) ? lod->boneDepth : -1;
+
+    int frameCount = call->geometry.model.anim->frameCount;
+    int interval = lod->updateInterval;
+
+    if (interval <= 1 || frameCount <= 0 || call->geometry.model.layers != NULL) {
+        return;
+    }
+
+    // NOTE: The frame is rounded down to the last update of the model, the phase given by the
+    //       model address spreads the updates of the different models over the frames.
+    //       The pose stays the same until the next update and is reused from the previous frame.
+
+    int phase = (int)((((uint32_t)((uintptr_t)model >> 4) * 2654435761u) >> 16) % (uint32_t)interval);
+
+    int frame = model->animFrame % frameCount;
+    if (frame < 0) frame += frameCount;
+
+    frame -= (frame + phase) % interval;
+    if (frame < 0) frame = 0;
+
+    call->geometry.model.frame = frame;
+    call->geometry.model.frameFraction = 0.0f;
+    call->geometry.model.heldPose = true;
+}
+
 void r3d_sprite_get_uv_scale_offset(Vector2* uvScale, Vector2* uvOffset, const R3D_Sprite* sprite, float sgnX, float sgnY)
 {
     uvScale->x = sgnX / sprite->xFrameCount;
@@ -961,350 +1344,1766 @@ void r3d_stencil_disable(void)
 
 void r3d_prepare_process_lights_and_batch(void)
 {
+    int lightCount = (int)r3d_registry_get_allocated_count(&R3D.container.rLights);
+
     // Clear the previous light batch
     r3d_array_clear(&R3D.container.aLightBatch);
 
-    for (int id = 1; id <= (int)r3d_registry_get_allocated_count(&R3D.container.rLights); id++)
-    {
-        /* --- Check if the light in the registry is still valid --- */
+    // Reserve one slot per allocated light, each job writes in the slot of its light
+    if (r3d_array_reserve(&R3D.container.aLightBatch, lightCount) < 0) {
+        TraceLog(LOG_ERROR, "R3D: Failed to reserve the light batch, lights will be skipped for this frame");
+        return;
+    }
 
-        if (!r3d_registry_is_valid(&R3D.container.rLights, id)) {
-            continue;
-        }
+    /* --- Process and cull the lights, rejected slots are set to NULL --- */
 
-        /* --- Get the valid light and check if it is active --- */
+    r3d_light_batched_t* batch = R3D.container.aLightBatch.data;
 
-        r3d_light_t* light = r3d_registry_get(&R3D.container.rLights, id);
-        if (!light->enabled) continue;
+    r3d_job_pool_parallel_for(R3D.jobs.prepare, lightCount, 16, r3d_prepare_job_process_lights, batch);
 
-        /* --- Process shadow update mode --- */
+    /* --- Compact the visible lights while keeping the registry order --- */
 
-        if (light->shadow.enabled) {
-            r3d_light_process_shadow_update(light);
+    int count = 0;
+    for (int i = 0; i < lightCount; i++) {
+        if (batch[i].data != NULL) {
+            batch[count++] = batch[i];
         }
+    }
 
-        /* --- Frustum culling of lights areas --- */
-
-        BoundingBox aabb = r3d_light_get_bounding_box(light);
+    R3D.container.aLightBatch.count = count;
+}
 
-        if (light->type != R3D_LIGHT_DIR) {
-            if (!r3d_frustum_is_aabb_in(&R3D.state.frustum.shape, &aabb)) {
-                continue;
-            }
+static bool r3d_prepare_get_drawcall_world_aabb(const r3d_drawcall_t* call, bool instanced, BoundingBox* aabb)
+{
+    if (instanced) {
+        if (call->instanced.allAabb.min.x == -FLT_MAX) {
+            return false; //< The instances are not bounded
         }
+        *aabb = r3d_aabb_transform(&call->instanced.allAabb, &call->transform);
+        return true;
+    }
 
-        /* --- Here the light is supposed to be visible --- */
-
-        r3d_light_batched_t batched = { .data = light, .aabb = aabb };
-        r3d_array_push_back(&R3D.container.aLightBatch, &batched);
+    if (call->geometryType == R3D_DRAWCALL_GEOMETRY_SPRITE) {
+        const Vector3* quad = call->geometry.sprite.quad;
+        aabb->min = aabb->max = quad[0];
+        for (int i = 1; i < 4; i++) {
+            aabb->min = Vector3Min(aabb->min, quad[i]);
+            aabb->max = Vector3Max(aabb->max, quad[i]);
+        }
+        return true;
     }
+
+    *aabb = r3d_aabb_transform(&call->geometry.model.mesh->aabb, &call->transform);
+    return true;
 }
 
-void r3d_prepare_cull_drawcalls(void)
+static void r3d_prepare_list_drawcall_lights(r3d_array_t* calls, bool instanced)
 {
-    r3d_drawcall_t* calls = NULL;
-    int count = 0;
+    r3d_array_t* indices = &R3D.container.aLightIndices;
+    r3d_array_t* shadowLists = &R3D.container.aShadowLightLists;
 
-    /* --- Frustum culling of deferred objects --- */
+    const r3d_light_batched_t* batch = R3D.container.aLightBatch.data;
+    const Vector4* spheres = R3D.container.aLightSpheres.data;
 
-    calls = (r3d_drawcall_t*)R3D.container.aDrawDeferred.data;
-    count = (int)R3D.container.aDrawDeferred.count;
+    int batchCount = (int)R3D.container.aLightBatch.count;
+    int sphereCount = (int)R3D.container.aLightSpheres.count;
+    int dirLightCount = R3D.state.lightStorage.dirLightCount;
+    bool clustered = R3D.state.lightStorage.clustered;
 
-    for (int i = count - 1; i >= 0; i--) {
-        if (R3D_IS_SHADOW_CAST_ONLY(calls->shadowCastMode)) {
-            calls[i] = calls[--count];
-            continue;
-        }
-        if (!(R3D.state.flags & R3D_FLAG_NO_FRUSTUM_CULLING)) {
-            if (!r3d_drawcall_geometry_is_visible(&calls[i])) {
-                calls[i] = calls[--count];
+    for (int i = 0; i < calls->count; i++)
+    {
+        r3d_drawcall_t* call = r3d_array_at(calls, i);
+
+        BoundingBox aabb = { 0 };
+        bool bounded = r3d_prepare_get_drawcall_world_aabb(call, instanced, &aabb);
+
+        /* --- List the lights without shadows, the clusters already list them otherwise --- */
+
+        call->lights.offset = (int)indices->count;
+
+        for (int j = 0; !clustered && j < sphereCount; j++) {
+            const Vector4* s = &spheres[j];
+            if (bounded && !CheckCollisionBoxSphere(aabb, (Vector3) { s->x, s->y, s->z }, s->w)) {
                 continue;
             }
+            uint16_t index = (uint16_t)(dirLightCount + j);
+            if (r3d_array_push_back(indices, &index) < 0) {
+                break;
+            }
         }
-    }
 
-    R3D.container.aDrawDeferred.count = count;
+        call->lights.count = (int)indices->count - call->lights.offset;
 
-    /* --- Frustum culling of forward objects --- */
+        /* --- List the lights casting shadows, they keep their own uniforms --- */
 
-    calls = (r3d_drawcall_t*)R3D.container.aDrawForward.data;
-    count = (int)R3D.container.aDrawForward.count;
+        call->lights.shadowOffset = (int)shadowLists->count;
 
-    for (int i = count - 1; i >= 0; i--) {
-        if (R3D_IS_SHADOW_CAST_ONLY(calls->shadowCastMode)) {
-            calls[i] = calls[--count];
-            continue;
-        }
-        if (!(R3D.state.flags & R3D_FLAG_NO_FRUSTUM_CULLING)) {
-            if (!r3d_drawcall_geometry_is_visible(&calls[i])) {
-                calls[i] = calls[--count];
+        for (int j = 0; j < batchCount; j++) {
+            const r3d_light_t* light = batch[j].data;
+            if (!light->shadow.enabled) {
+                continue;
+            }
+            if (bounded && light->type != R3D_LIGHT_DIR && !CheckCollisionBoxes(batch[j].aabb, aabb)) {
                 continue;
             }
+            if (r3d_array_push_back(shadowLists, &j) < 0) {
+                break;
+            }
         }
+
+        call->lights.shadowCount = (int)shadowLists->count - call->lights.shadowOffset;
     }
+}
 
-    R3D.container.aDrawForward.count = count;
+void r3d_prepare_light_storage(void)
+{
+    r3d_array_t* lights = &R3D.container.aLightData;
+    r3d_array_t* spheres = &R3D.container.aLightSpheres;
+    r3d_array_t* indices = &R3D.container.aLightIndices;
 
-    /* --- Frustum culling of deferred instanced objects --- */
+    r3d_array_clear(lights);
+    r3d_array_clear(spheres);
+    r3d_array_clear(indices);
+    r3d_array_clear(&R3D.container.aShadowLightLists);
 
-    calls = (r3d_drawcall_t*)R3D.container.aDrawDeferredInst.data;
-    count = (int)R3D.container.aDrawDeferredInst.count;
+    R3D.state.lightStorage.dirLightCount = 0;
+    R3D.state.lightStorage.clustered = false;
 
-    for (int i = count - 1; i >= 0; i--) {
-        if (R3D_IS_SHADOW_CAST_ONLY(calls->shadowCastMode)) {
-            calls[i] = calls[--count];
-            continue;
-        }
-        if (!(R3D.state.flags & R3D_FLAG_NO_FRUSTUM_CULLING)) {
-            if (!r3d_drawcall_instanced_geometry_is_visible(&calls[i])) {
-                calls[i] = calls[--count];
+    int batchCount = (int)R3D.container.aLightBatch.count;
+    const r3d_light_batched_t* batch = R3D.container.aLightBatch.data;
+
+    if (r3d_array_reserve(lights, 4 * batchCount) < 0 || r3d_array_reserve(spheres, batchCount) < 0) {
+        TraceLog(LOG_ERROR, "R3D: Failed to reserve the light storage, lights without shadows will be skipped for this frame");
+        batchCount = 0;
+    }
+
+    /* --- Write the lights without shadows, directional lights first since they affect everything --- */
+
+    // NOTE: The lights casting shadows are not stored, their shadow maps can't be
+    //       indexed dynamically in the shaders, so they keep their own uniforms
+
+    int dirLightCount = 0;
+
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (int i = 0; i < batchCount; i++)
+        {
+            const r3d_light_t* light = batch[i].data;
+
+            if (light->shadow.enabled || (light->type == R3D_LIGHT_DIR) != (pass == 0)) {
+                continue;
+            }
+
+            if (lights->count / 4 >= R3D_CLUSTER_MAX_LIGHTS) {
+                break;
+            }
+
+            Vector4* texels = (Vector4*)lights->data + lights->count;
+            lights->count += 4;
+
+            Vector3 color = Vector3Scale(light->color, light->energy);
+
+            texels[0] = (Vector4) { light->position.x, light->position.y, light->position.z, light->range };
+            texels[1] = (Vector4) { light->direction.x, light->direction.y, light->direction.z, (float)light->type };
+            texels[2] = (Vector4) { color.x, color.y, color.z, light->specular };
+            texels[3] = (Vector4) { light->attenuation, light->innerCutOff, light->outerCutOff, 0.0f };
+
+            if (light->type == R3D_LIGHT_DIR) {
+                dirLightCount++;
                 continue;
             }
+
+            /* --- Bounding sphere of the light volume --- */
+
+            Vector3 center = light->position;
+            float radius = light->range;
+
+            // NOTE: Cones narrower than a hemisphere get a tighter sphere, the one through the apex
+            //       and the cap circle for narrow cones, the one around the cap circle for wide cones
+            float cosAngle = light->outerCutOff;
+            if (light->type == R3D_LIGHT_SPOT && cosAngle > 0.0f) {
+                if (cosAngle < 0.70710678f) {
+                    center = Vector3Add(light->position, Vector3Scale(light->direction, light->range * cosAngle));
+                    radius = light->range * sqrtf(1.0f - cosAngle * cosAngle);
+                }
+                else {
+                    radius = light->range / (2.0f * cosAngle);
+                    center = Vector3Add(light->position, Vector3Scale(light->direction, radius));
+                }
+            }
+
+            ((Vector4*)spheres->data)[spheres->count++] = (Vector4) { center.x, center.y, center.z, radius };
         }
     }
 
-    R3D.container.aDrawDeferredInst.count = count;
+    R3D.state.lightStorage.dirLightCount = dirLightCount;
 
-    /* --- Frustum culling of forward instanced objects --- */
+    /* --- Sort the lights into the per-cluster lists when clustered lighting is enabled --- */
 
-    calls = (r3d_drawcall_t*)R3D.container.aDrawForwardInst.data;
-    count = (int)R3D.container.aDrawForwardInst.count;
+    if (R3D.state.flags & R3D_FLAG_CLUSTERED_LIGHTING)
+    {
+        r3d_cluster_grid_t* grid = &R3D.container.clusterGrid;
+        r3d_array_t* pairs = &R3D.container.aClusterPairs;
 
-    for (int i = count - 1; i >= 0; i--) {
-        if (R3D_IS_SHADOW_CAST_ONLY(calls->shadowCastMode)) {
-            calls[i] = calls[--count];
-            continue;
+        r3d_array_clear(pairs);
+
+        r3d_cluster_grid_update(
+            grid, &R3D.state.transform.proj,
+            (float)rlGetCullDistanceNear(),
+            (float)rlGetCullDistanceFar()
+        );
+
+        for (int i = 0; i < spheres->count; i++) {
+            const Vector4* s = (const Vector4*)spheres->data + i;
+            Vector3 center = Vector3Transform((Vector3) { s->x, s->y, s->z }, R3D.state.transform.view);
+            r3d_cluster_grid_bin_sphere(grid, center, s->w, dirLightCount + i, pairs);
         }
-        if (!(R3D.state.flags & R3D_FLAG_NO_FRUSTUM_CULLING)) {
-            if (!r3d_drawcall_instanced_geometry_is_visible(&calls[i])) {
-                calls[i] = calls[--count];
-                continue;
-            }
+
+        if (r3d_array_reserve(&R3D.container.aClusterRanges, 2 * R3D_CLUSTER_COUNT) < 0 ||
+            r3d_array_reserve(indices, pairs->count) < 0) {
+            TraceLog(LOG_ERROR, "R3D: Failed to reserve the cluster light lists, lights will be listed per draw call for this frame");
+        }
+        else {
+            r3d_cluster_build_lists(pairs->data, (int)pairs->count, R3D.container.aClusterRanges.data, indices->data);
+            indices->count = pairs->count;
+
+            R3D.state.lightStorage.clustered = true;
+            R3D.state.lightStorage.clusterSlice = (Vector2) { grid->sliceScale, grid->sliceBias };
         }
     }
 
-    R3D.container.aDrawForwardInst.count = count;
+    /* --- List the lights of each forward draw call --- */
+
+    r3d_prepare_list_drawcall_lights(&R3D.container.aDrawForward, false);
+    r3d_prepare_list_drawcall_lights(&R3D.container.aDrawForwardInst, true);
+
+    /* --- Upload the lights and the lists --- */
+
+    r3d_storage_upload_lights(lights->data, (int)lights->count / 4);
+    r3d_storage_upload_light_indices(indices->data, (int)indices->count);
+
+    if (R3D.state.lightStorage.clustered) {
+        r3d_storage_upload_clusters(R3D.container.aClusterRanges.data);
+    }
 }
 
-void r3d_prepare_sort_drawcalls(void)
+void r3d_prepare_cull_drawcalls(void)
 {
-    if (R3D.state.flags & R3D_FLAG_FORCE_FORWARD) {
-        // Here all transparent or opaque objects are contained in the forward array
-        if (R3D.state.flags & R3D_FLAG_TRANSPARENT_SORTING) {
-            r3d_drawcall_sort_mixed_forward(
-                (r3d_drawcall_t*)R3D.container.aDrawForward.data,
-                R3D.container.aDrawForward.count
-            );
+    r3d_cull_job_t job = {
+        .arrays = {
+            &R3D.container.aDrawDeferred,
+            &R3D.container.aDrawForward,
+            &R3D.container.aDrawDeferredInst,
+            &R3D.container.aDrawForwardInst,
         }
-        return;
+    };
+
+    int totalCount = 0;
+    for (int i = 0; i < 4; i++) {
+        totalCount += (int)job.arrays[i]->count;
     }
 
-    // Sort front-to-back for deferred rendering
-    if (R3D.state.flags & R3D_FLAG_OPAQUE_SORTING) {
-        r3d_drawcall_sort_front_to_back(
-            (r3d_drawcall_t*)R3D.container.aDrawDeferred.data,
-            R3D.container.aDrawDeferred.count
-        );
+    // The culling kernel works on words of 32 boxes, the arrays are padded accordingly
+    int paddedCount = (totalCount + 31) & ~31;
+
+    if (r3d_array_reserve(&R3D.container.aCullBoxes, 6 * (size_t)paddedCount) < 0 ||
+        r3d_array_reserve(&R3D.container.aCullMask, paddedCount / 32) < 0) {
+        TraceLog(LOG_ERROR, "R3D: Failed to reserve the culling buffers, frustum culling will be skipped for this frame");
+        return;
     }
 
-    // Sort back-to-front for forward rendering
-    if (R3D.state.flags & R3D_FLAG_TRANSPARENT_SORTING) {
-        r3d_drawcall_sort_back_to_front(
-            (r3d_drawcall_t*)R3D.container.aDrawForward.data,
-            R3D.container.aDrawForward.count
-        );
+    float* boxes = R3D.container.aCullBoxes.data;
+
+    job.boxes.centerX = boxes + 0 * paddedCount;
+    job.boxes.centerY = boxes + 1 * paddedCount;
+    job.boxes.centerZ = boxes + 2 * paddedCount;
+    job.boxes.extentX = boxes + 3 * paddedCount;
+    job.boxes.extentY = boxes + 4 * paddedCount;
+    job.boxes.extentZ = boxes + 5 * paddedCount;
+    job.mask = R3D.container.aCullMask.data;
+
+    for (int i = 0; i < 6; i++) {
+        memset(boxes + i * paddedCount + totalCount, 0, (paddedCount - totalCount) * sizeof(float));
     }
-}
 
-void r3d_prepare_anim_drawcalls(void)
-{
-    // TODO: Measures should be implemented to avoid updating the matrices multiple times for the same mesh,
-    //       because currently the same mesh could appear multiple times in the same array,
-    //       or in different arrays. As a result, the set would be updated multiple times.
+    /* --- Frustum culling of all objects, visibility bits are stored in the order of the arrays --- */
 
-    const r3d_array_t* arrays[4] = {
-        &R3D.container.aDrawDeferredInst,
-        &R3D.container.aDrawForwardInst,
-        &R3D.container.aDrawDeferred,
-        &R3D.container.aDrawForward,
-    };
+    // NOTE: The grain must stay a multiple of 32 so that each word of the mask is written by a single job
 
-    for (int i = 0; i < sizeof(arrays) / sizeof(uintptr_t); i++)
-    {
-        const r3d_drawcall_t* calls = arrays[i]->data;
-        int count = (int)arrays[i]->count;
+    r3d_job_pool_parallel_for(R3D.jobs.prepare, totalCount, 256, r3d_prepare_job_cull_drawcalls, &job);
 
-        for (int j = 0; j < count; j++)
-        {
-            const r3d_drawcall_t* call = &calls[j];
+    /* --- Removal of the culled objects --- */
 
-            if (call->geometryType != R3D_DRAWCALL_GEOMETRY_MODEL || call->geometry.model.anim == NULL) {
-                continue;
-            }
+    // NOTE: The removal is done sequentially, in the same order as the tests
+    //       were done before, so the order of the remaining calls never depends
+    //       on how the tests were distributed among the threads.
+
+    int offset = 0;
 
-            if (call->geometry.model.mesh->boneMatrices == NULL) {
-                // Only meshes belonging to a model with bones have a boneMatrices cache
-                TraceLog(LOG_WARNING, "Attempting to play animation on mesh without bone matrix cache");
+    for (int i = 0; i < 4; i++)
+    {
+        r3d_drawcall_t* calls = (r3d_drawcall_t*)job.arrays[i]->data;
+        int count = (int)job.arrays[i]->count;
+
+        for (int j = count - 1; j >= 0; j--) {
+            int bit = offset + j;
+            if (!(job.mask[bit >> 5] & (1u << (bit & 31)))) {
+                calls[j] = calls[--count];
             }
-            if (call->geometry.model.boneOverride==NULL)// skip animation update if custom is being used
-                r3d_drawcall_update_model_animation(call);
         }
+
+        offset += (int)job.arrays[i]->count;
+        job.arrays[i]->count = count;
     }
 }
 
-void r3d_pass_shadow_maps(void)
+void r3d_prepare_static_drawcalls(void)
 {
-    // Config context state
-    glEnable(GL_DEPTH_TEST);
-    glDisable(GL_BLEND);
+    // NOTE: Static meshes are culled by the tree query, so they are appended
+    //       after the culling of the other draw calls and are never tested twice.
 
-    // Iterate through all lights to render all geometries
-    for (int i = 0; i < R3D.container.aLightBatch.count; i++)
-    {
-        r3d_light_batched_t* light = r3d_array_at(&R3D.container.aLightBatch, i);
+    const r3d_frustum_t* frustum = &R3D.state.frustum.shape;
+    if (R3D.state.flags & R3D_FLAG_NO_FRUSTUM_CULLING) {
+        frustum = NULL; //< Returns all the static meshes
+    }
 
-        // Skip light if it doesn't produce shadows
-        if (!light->data->shadow.enabled) continue;
+    r3d_array_clear(&R3D.container.aStaticVisible);
+    r3d_bvh_query_frustum(&R3D.container.staticTree, frustum, &R3D.container.aStaticVisible);
 
-        // Skip if it's not time to update shadows
-        if (!light->data->shadow.updateConf.shouldUpdate) continue;
-        else r3d_light_indicate_shadow_update(light->data);
+    const unsigned int* ids = R3D.container.aStaticVisible.data;
+    int count = (int)R3D.container.aStaticVisible.count;
 
-        // TODO: The lights could be sorted to avoid too frequent
-        //       state changes, just like with shaders.
+    for (int i = 0; i < count; i++)
+    {
+        r3d_static_mesh_t* staticMesh = r3d_registry_get(&R3D.container.rStaticMeshes, ids[i]);
+        const R3D_Mesh* mesh = staticMesh->call.geometry.model.mesh;
 
-        // TODO: The draw calls could also be sorted
-        //       according to the shadow cast mode.
+        if (!R3D_IS_ACTIVE_LAYERS(mesh->layers) || R3D_IS_SHADOW_CAST_ONLY(mesh->shadowCastMode)) {
+            continue;
+        }
 
-        // Start rendering to shadow map
-        glBindFramebuffer(GL_FRAMEBUFFER, light->data->shadow.map.id);
+        r3d_static_mesh_update_drawcall(staticMesh);
+
+        r3d_array_t* arr = &R3D.container.aDrawDeferred;
+        if (staticMesh->call.renderMode == R3D_DRAWCALL_RENDER_FORWARD) {
+            arr = &R3D.container.aDrawForward;
+        }
+
+        r3d_array_push_back(arr, &staticMesh->call);
+    }
+}
+
+void r3d_prepare_batch_drawcalls(void)
+{
+    if (!(R3D.state.flags & R3D_FLAG_AUTO_INSTANCING)) {
+        return;
+    }
+
+    // NOTE: The instanced calls point into the transforms buffer, so it is reserved
+    //       once for both arrays and must not be reallocated until the end of the frame
+
+    size_t maxCount = R3D.container.aDrawDeferred.count + R3D.container.aDrawForward.count;
+
+    r3d_array_clear(&R3D.container.aBatchTransforms);
+    if (r3d_array_reserve(&R3D.container.aBatchTransforms, maxCount) < 0) {
+        TraceLog(LOG_ERROR, "R3D: Failed to reserve the automatic instancing buffer, draw calls will not be batched this frame");
+        return;
+    }
+
+    r3d_prepare_batch_drawcall_array(&R3D.container.aDrawDeferred, &R3D.container.aDrawDeferredInst);
+    r3d_prepare_batch_drawcall_array(&R3D.container.aDrawForward, &R3D.container.aDrawForwardInst);
+}
+
+void r3d_prepare_batch_drawcall_array(r3d_array_t* calls, r3d_array_t* instCalls)
+{
+    int count = (int)calls->count;
+    if (count < R3D_AUTO_INSTANCING_MIN_CALLS) {
+        return;
+    }
+
+    size_t tableCapacity = 16;
+    while (tableCapacity < 2 * (size_t)count) {
+        tableCapacity *= 2;
+    }
+
+    if (r3d_array_reserve(&R3D.container.aBatchGroups, count) < 0 ||
+        r3d_array_reserve(&R3D.container.aBatchCallGroups, count) < 0 ||
+        r3d_array_reserve(&R3D.container.aBatchTable, tableCapacity) < 0) {
+        TraceLog(LOG_ERROR, "R3D: Failed to reserve the automatic instancing buffers, draw calls will not be batched this frame");
+        return;
+    }
+
+    r3d_drawcall_t* data = calls->data;
+    r3d_batch_group_t* groups = R3D.container.aBatchGroups.data;
+    int* callGroups = R3D.container.aBatchCallGroups.data;
+    int* table = R3D.container.aBatchTable.data;
+    int groupCount = 0;
+
+    memset(table, 0, tableCapacity * sizeof(*table));
+
+    /* --- Group the calls by mesh and material, the table stores group indices + 1 --- */
+
+    for (int i = 0; i < count; i++)
+    {
+        const r3d_drawcall_t* call = &data[i];
+        callGroups[i] = -1;
+
+        if (!r3d_prepare_batch_is_eligible(call)) {
+            continue;
+        }
+
+        uint32_t hash = (uint32_t)(((uintptr_t)call->geometry.model.mesh >> 4) * 2654435761u);
+        hash ^= call->material * 0x85EBCA77u;
+
+        size_t slot = hash & (tableCapacity - 1);
+        int group = -1;
+
+        while (table[slot] != 0) {
+            int candidate = table[slot] - 1;
+            if (r3d_prepare_batch_is_compatible(&data[groups[candidate].first], call)) {
+                group = candidate;
+                break;
+            }
+            slot = (slot + 1) & (tableCapacity - 1);
+        }
+
+        if (group < 0) {
+            group = groupCount++;
+            groups[group] = (r3d_batch_group_t) { .first = i, .instIndex = -1 };
+            table[slot] = group + 1;
+        }
+
+        groups[group].count++;
+        callGroups[i] = group;
+    }
+
+    /* --- Create an instanced call for each group large enough --- */
+
+    Matrix* transforms = R3D.container.aBatchTransforms.data;
+
+    for (int g = 0; g < groupCount; g++)
+    {
+        r3d_batch_group_t* group = &groups[g];
+        if (group->count < R3D_AUTO_INSTANCING_MIN_CALLS) {
+            continue;
+        }
+
+        group->offset = (int)R3D.container.aBatchTransforms.count;
+        R3D.container.aBatchTransforms.count += group->count;
+
+        r3d_drawcall_t instCall = data[group->first];
+
+        instCall.transform = R3D_MATRIX_IDENTITY;
+        instCall.instanced.transforms = transforms + group->offset;
+        instCall.instanced.colors = NULL;
+        instCall.instanced.allAabb = (BoundingBox) { { FLT_MAX, FLT_MAX, FLT_MAX }, { -FLT_MAX, -FLT_MAX, -FLT_MAX } };
+        instCall.instanced.transStride = sizeof(Matrix);
+        instCall.instanced.colStride = 0;
+        instCall.instanced.count = group->count;
+
+        group->instIndex = (int)instCalls->count;
+        if (r3d_array_push_back(instCalls, &instCall) < 0) {
+            TraceLog(LOG_ERROR, "R3D: Failed to push an automatically instanced draw call");
+            R3D.container.aBatchTransforms.count -= group->count;
+            group->instIndex = -1;
+        }
+    }
+
+    /* --- Gather the transforms and remove the batched calls, keeping the order of the others --- */
+
+    int kept = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        int g = callGroups[i];
+
+        if (g < 0 || groups[g].instIndex < 0) {
+            if (kept != i) data[kept] = data[i];
+            kept++;
+            continue;
+        }
+
+        r3d_batch_group_t* group = &groups[g];
+        r3d_drawcall_t* instCall = r3d_array_at(instCalls, group->instIndex);
+
+        BoundingBox aabb = r3d_aabb_transform(&data[i].geometry.model.mesh->aabb, &data[i].transform);
+        instCall->instanced.allAabb.min = Vector3Min(instCall->instanced.allAabb.min, aabb.min);
+        instCall->instanced.allAabb.max = Vector3Max(instCall->instanced.allAabb.max, aabb.max);
+
+        transforms[group->offset + group->filled++] = data[i].transform;
+    }
+
+    calls->count = kept;
+}
+
+bool r3d_prepare_batch_is_eligible(const r3d_drawcall_t* call)
+{
+    // NOTE: Skinned calls have their own bone matrices, billboards are oriented from their
+    //       own transform, and transparent calls must keep their back-to-front order
+
+    if (call->geometryType != R3D_DRAWCALL_GEOMETRY_MODEL
+        || call->geometry.model.anim != NULL
+        || call->geometry.model.boneOverride != NULL) {
+        return false;
+    }
+
+    const R3D_Material* material = r3d_drawcall_get_material(call);
+
+    return material->billboardMode == R3D_BILLBOARD_DISABLED
+        && material->blendMode == R3D_BLEND_OPAQUE;
+}
+
+bool r3d_prepare_batch_is_compatible(const r3d_drawcall_t* a, const r3d_drawcall_t* b)
+{
+    // Identical materials are interned with the same ID
+    return a->geometry.model.mesh == b->geometry.model.mesh
+        && a->material == b->material
+        && a->shadowCastMode == b->shadowCastMode;
+}
+
+void r3d_prepare_stream_instances(void)
+{
+    // NOTE: Called before the shadow passes, then after the batching for the instanced
+    //       calls it created, the calls already streamed are skipped
+
+    r3d_array_t* arrays[2] = {
+        &R3D.container.aDrawDeferredInst,
+        &R3D.container.aDrawForwardInst
+    };
+
+    for (int i = 0; i < 2; i++) {
+        r3d_drawcall_t* calls = arrays[i]->data;
+        for (size_t j = 0; j < arrays[i]->count; j++) {
+            r3d_drawcall_stream_instances(&calls[j]);
+        }
+    }
+}
+
+void r3d_prepare_sort_drawcalls(void)
+{
+    // NOTE: The calls are not moved, the sorts only fill the order arrays
+    //       and the passes that depend on it draw through these indices
+
+    r3d_array_clear(&R3D.container.aDrawDeferredOrder);
+    r3d_array_clear(&R3D.container.aDrawForwardOrder);
+
+    if (R3D.state.flags & R3D_FLAG_FORCE_FORWARD) {
+        // Here all transparent or opaque objects are contained in the forward array
+        if (R3D.state.flags & (R3D_FLAG_TRANSPARENT_SORTING | R3D_FLAG_STATE_SORTING)) {
+            r3d_prepare_sort_drawcall_array(
+                &R3D.container.aDrawForward,
+                &R3D.container.aDrawForwardOrder,
+                &R3D.container.aDrawForwardKeys,
+                r3d_drawcall_sort_mixed_forward
+            );
+        }
+        return;
+    }
+
+    // Deferred and forward arrays are independent, both can be sorted at the same time
+    r3d_job_pool_parallel_for(R3D.jobs.prepare, 2, 1, r3d_prepare_job_sort_drawcalls, NULL);
+}
+
+void r3d_prepare_sort_drawcall_array(const r3d_array_t* calls, r3d_array_t* order, r3d_array_t* keys,
+                                     void (*sortFunc)(const r3d_drawcall_t*, size_t, uint64_t*, uint32_t*))
+{
+    size_t count = calls->count;
+    if (count < 2) return;
+
+    // The second half of the buffers is used as scratch by the radix sort
+    if (r3d_array_reserve(order, 2 * count) < 0 || r3d_array_reserve(keys, 2 * count) < 0) {
+        TraceLog(LOG_ERROR, "R3D: Failed to reserve the sort buffers, draw calls will not be sorted for this frame");
+        return;
+    }
+
+    sortFunc((const r3d_drawcall_t*)calls->data, count, (uint64_t*)keys->data, (uint32_t*)order->data);
+
+    order->count = count;
+}
+
+void r3d_prepare_anim_drawcalls(void)
+{
+    // NOTE: The bone matrices only depend on the bone offsets, the animation and the frame (or the layers),
+    //       so each distinct pose is computed once and shared by all the calls using it,
+    //       whatever their mesh. The matrices are then uploaded once for all the passes.
+
+    r3d_array_t* arrays[4] = {
+        &R3D.container.aDrawDeferredInst,
+        &R3D.container.aDrawForwardInst,
+        &R3D.container.aDrawDeferred,
+        &R3D.container.aDrawForward,
+    };
+
+    // NOTE: The poses of the previous frame are kept, the poses held by the animation LOD
+    //       are copied from them instead of being evaluated again. Only the held poses are
+    //       looked up, the other poses are always evaluated as they were before.
+
+    r3d_array_t oldPoses = R3D.container.aPrevPoses;
+    r3d_array_t oldPoseTable = R3D.container.aPrevPoseTable;
+    r3d_array_t oldPoseMatrices = R3D.container.aPrevPoseMatrices;
+
+    R3D.container.aPrevPoses = R3D.container.aPoses;
+    R3D.container.aPrevPoseTable = R3D.container.aPoseTable;
+    R3D.container.aPrevPoseMatrices = R3D.container.aPoseMatrices;
+
+    R3D.container.aPoses = oldPoses;
+    R3D.container.aPoseTable = oldPoseTable;
+    R3D.container.aPoseMatrices = oldPoseMatrices;
+
+    r3d_array_clear(&R3D.container.aAnimCalls);
+    r3d_array_clear(&R3D.container.aPoses);
+    r3d_array_clear(&R3D.container.aPoseTable);
+
+    /* --- Collect the draw calls that need a bone matrices update --- */
+
+    size_t maxMatrices = 0;
+
+    for (int i = 0; i < 4; i++)
+    {
+        r3d_drawcall_t* calls = arrays[i]->data;
+        int count = (int)arrays[i]->count;
+
+        for (int j = 0; j < count; j++)
+        {
+            r3d_drawcall_t* call = &calls[j];
+
+            if (call->geometryType != R3D_DRAWCALL_GEOMETRY_MODEL || call->geometry.model.anim == NULL) {
+                continue;
+            }
+
+            call->geometry.model.boneMatrices = NULL;
+
+            if (call->geometry.model.boneOverride != NULL) {
+                continue; // skip animation update if custom is being used
+            }
+
+            if (call->geometry.model.mesh->boneCount <= 0) {
+                // Only meshes belonging to a model with bones are skinned
+                TraceLog(LOG_WARNING, "Attempting to play animation on mesh without bones");
+                continue;
+            }
+
+            if (call->geometry.model.boneOffsets == NULL || call->geometry.model.anim->frameCount <= 0) {
+                continue;
+            }
+
+            const R3D_ModelAnimation* anim = call->geometry.model.anim;
+            const r3d_anim_clip_t* clip = anim->clip;
+
+            r3d_array_push_back(&R3D.container.aAnimCalls, &call);
+            maxMatrices += anim->boneCount;
+
+            if (call->geometry.model.layers != NULL) {
+                maxMatrices += r3d_anim_blend_get_scratch_count(anim->boneCount);
+            }
+            else if (clip != NULL) {
+                maxMatrices += clip->nodeCount;
+            }
+        }
+    }
+
+    int callCount = (int)R3D.container.aAnimCalls.count;
+    if (callCount == 0) {
+        return;
+    }
+
+    /* --- Find the distinct poses, the matrices are reserved for the worst case so the pointers stay valid --- */
+
+    size_t tableCapacity = 16;
+    while (tableCapacity < 2 * (size_t)callCount) {
+        tableCapacity *= 2;
+    }
+
+    if (r3d_array_reserve(&R3D.container.aPoseTable, tableCapacity) < 0 ||
+        r3d_array_reserve(&R3D.container.aPoses, callCount) < 0 ||
+        r3d_array_reserve(&R3D.container.aPoseMatrices, maxMatrices) < 0) {
+        TraceLog(LOG_ERROR, "R3D: Failed to reserve the pose cache, animations will not be updated this frame");
+        return;
+    }
+
+    int* table = R3D.container.aPoseTable.data;
+    r3d_pose_entry_t* poses = R3D.container.aPoses.data;
+    Matrix* poseMatrices = R3D.container.aPoseMatrices.data;
+    r3d_drawcall_t** animCalls = R3D.container.aAnimCalls.data;
+
+    const int* prevTable = R3D.container.aPrevPoseTable.data;
+    const r3d_pose_entry_t* prevPoses = R3D.container.aPrevPoses.data;
+    size_t prevTableCapacity = R3D.container.aPrevPoseTable.count;
+
+    memset(table, 0xFF, tableCapacity * sizeof(int));
+    R3D.container.aPoseTable.count = tableCapacity;
+
+    int poseCount = 0;
+    size_t matrixCount = 0;
+
+    for (int i = 0; i < callCount; i++)
+    {
+        r3d_drawcall_t* call = animCalls[i];
+
+        const R3D_ModelAnimation* anim = call->geometry.model.anim;
+        const R3D_AnimationLayer* layers = call->geometry.model.layers;
+        const Matrix* boneOffsets = call->geometry.model.boneOffsets;
+        int layerCount = call->geometry.model.layerCount;
+        int boneDepth = call->geometry.model.boneDepth;
+        int frame = call->geometry.model.frame;
+
+        if (frame >= anim->frameCount) {
+            frame = frame % anim->frameCount;
+        }
+
+        // NOTE: Only the compressed animations can be sampled between two frames,
+        //       the fraction is ignored for the others so they still share the pose.
+        //       The frames of the blended poses are given by their layers.
+
+        const r3d_anim_clip_t* clip = anim->clip;
+        float fraction = 0.0f;
+        int scratchCount = 0;
+
+        if (layers != NULL) {
+            frame = 0;
+            scratchCount = r3d_anim_blend_get_scratch_count(anim->boneCount);
+        }
+        else if (clip != NULL) {
+            fraction = Clamp(call->geometry.model.frameFraction, 0.0f, 1.0f);
+            scratchCount = clip->nodeCount;
+        }
+        else {
+            // Baked poses ignore the depth limit, so every depth shares them
+            boneDepth = -1;
+        }
+
+        uint32_t fractionBits;
+        memcpy(&fractionBits, &fraction, sizeof(uint32_t));
+
+        uint32_t hash = (uint32_t)((uintptr_t)boneOffsets >> 4) * 2654435761u;
+        hash ^= (uint32_t)((uintptr_t)anim >> 4) * 0x85EBCA77u;
+        hash ^= (uint32_t)frame * 0xC2B2AE3Du;
+        hash ^= fractionBits * 0x27D4EB2Fu;
+        hash ^= (uint32_t)((uintptr_t)layers >> 4) * 0x165667B1u;
+        hash ^= (uint32_t)boneDepth * 0x9E3779B1u;
+
+        r3d_pose_entry_t key = {
+            .boneOffsets = boneOffsets,
+            .anim = anim,
+            .frame = frame,
+            .fraction = fraction,
+            .layers = layers,
+            .layerCount = layerCount,
+            .boneDepth = boneDepth
+        };
+
+        size_t slot = hash & (tableCapacity - 1);
+        while (table[slot] >= 0) {
+            if (r3d_pose_entry_equals(&poses[table[slot]], &key)) break;
+            slot = (slot + 1) & (tableCapacity - 1);
+        }
+
+        if (table[slot] < 0) {
+            key.matrices = poseMatrices + matrixCount;
+            key.scratch = (scratchCount > 0) ? poseMatrices + matrixCount + anim->boneCount : NULL;
+
+            if (call->geometry.model.heldPose && prevTableCapacity > 0) {
+                size_t prevSlot = hash & (prevTableCapacity - 1);
+                while (prevTable[prevSlot] >= 0) {
+                    const r3d_pose_entry_t* prev = &prevPoses[prevTable[prevSlot]];
+                    if (r3d_pose_entry_equals(prev, &key)) {
+                        key.held = prev->matrices;
+                        break;
+                    }
+                    prevSlot = (prevSlot + 1) & (prevTableCapacity - 1);
+                }
+            }
+
+            poses[poseCount] = key;
+            matrixCount += anim->boneCount + scratchCount;
+            table[slot] = poseCount++;
+        }
+
+        call->geometry.model.boneMatrices = poses[table[slot]].matrices;
+    }
+
+    R3D.container.aPoses.count = poseCount;
+    R3D.container.aPoseMatrices.count = matrixCount;
+
+    /* --- Compute each distinct pose --- */
+
+    r3d_job_pool_parallel_for(R3D.jobs.prepare, poseCount, 4, r3d_prepare_job_anim_drawcalls, poses);
+}
+
+void r3d_prepare_upload_bone_matrices(void)
+{
+    // NOTE: Called once the animations are updated, before the shadow passes.
+    //       The matrices of all the skinned calls are packed in a single upload,
+    //       the calls sharing the same pose reference the same range.
+
+    r3d_array_t* arrays[4] = {
+        &R3D.container.aDrawDeferredInst,
+        &R3D.container.aDrawForwardInst,
+        &R3D.container.aDrawDeferred,
+        &R3D.container.aDrawForward,
+    };
+
+    r3d_array_clear(&R3D.container.aSkinCalls);
+
+    /* --- Collect the skinned draw calls --- */
+
+    for (int i = 0; i < 4; i++)
+    {
+        r3d_drawcall_t* calls = arrays[i]->data;
+        int count = (int)arrays[i]->count;
+
+        for (int j = 0; j < count; j++)
+        {
+            r3d_drawcall_t* call = &calls[j];
+            if (r3d_drawcall_is_skinned(call)) {
+                call->geometry.model.boneStorage = -1;
+                call->geometry.model.skinnedVao = 0;
+                r3d_array_push_back(&R3D.container.aSkinCalls, &call);
+            }
+        }
+    }
+
+    int callCount = (int)R3D.container.aSkinCalls.count;
+    if (callCount == 0) {
+        return;
+    }
+
+    /* --- Give a range to each distinct set of matrices --- */
+
+    size_t tableCapacity = 16;
+    while (tableCapacity < 2 * (size_t)callCount) {
+        tableCapacity *= 2;
+    }
+
+    if (r3d_array_reserve(&R3D.container.aSkinTable, tableCapacity) < 0) {
+        TraceLog(LOG_ERROR, "R3D: Failed to reserve the skinning table, skinned meshes will not be animated this frame");
+        return;
+    }
+
+    r3d_skin_entry_t* table = R3D.container.aSkinTable.data;
+    r3d_drawcall_t** skinCalls = R3D.container.aSkinCalls.data;
+
+    memset(table, 0, tableCapacity * sizeof(*table));
+
+    int totalCount = 0;
+
+    for (int i = 0; i < callCount; i++)
+    {
+        const r3d_drawcall_t* call = skinCalls[i];
+
+        const Matrix* matrices = call->geometry.model.boneMatrices;
+        int count = call->geometry.model.anim->boneCount;
+
+        if (call->geometry.model.boneOverride != NULL) {
+            matrices = call->geometry.model.boneOverride;
+        }
+
+        if (matrices == NULL || count <= 0) {
+            continue;
+        }
+
+        size_t slot = (((uintptr_t)matrices >> 4) * 2654435761u) & (tableCapacity - 1);
+        while (table[slot].matrices != NULL && table[slot].matrices != matrices) {
+            slot = (slot + 1) & (tableCapacity - 1);
+        }
+
+        if (table[slot].matrices == NULL) {
+            table[slot] = (r3d_skin_entry_t) { matrices, count, totalCount };
+            totalCount += count;
+        }
+
+        // NOTE: The relative offset is stored for now, the base is only known after the mapping
+        skinCalls[i]->geometry.model.boneStorage = table[slot].offset;
+    }
+
+    if (totalCount == 0) {
+        return;
+    }
+
+    /* --- Write all the matrices and upload them at once --- */
+
+    int baseOffset = 0;
+    Matrix* dst = r3d_storage_map_matrices(totalCount, &baseOffset);
+
+    if (dst == NULL) {
+        for (int i = 0; i < callCount; i++) {
+            skinCalls[i]->geometry.model.boneStorage = -1;
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < tableCapacity; i++) {
+        if (table[i].matrices != NULL) {
+            memcpy(dst + table[i].offset, table[i].matrices, table[i].count * sizeof(Matrix));
+        }
+    }
+
+    r3d_storage_unmap_matrices();
+
+    for (int i = 0; i < callCount; i++) {
+        if (skinCalls[i]->geometry.model.boneStorage >= 0) {
+            skinCalls[i]->geometry.model.boneStorage += baseOffset;
+        }
+    }
+}
+
+void r3d_prepare_skin_drawcalls(void)
+{
+    // NOTE: Called once the bone matrices are uploaded, before the shadow passes.
+    //       Each distinct mesh and pose is skinned once with transform feedback,
+    //       then all the passes draw the skinned vertices without skinning them again.
+
+    if (!(R3D.state.flags & R3D_FLAG_SKINNING_PREPASS) || R3D.shader.generate.skinning.id == 0) {
+        return;
+    }
+
+    int callCount = (int)R3D.container.aSkinCalls.count;
+    if (callCount == 0) {
+        return;
+    }
+
+    size_t tableCapacity = 16;
+    while (tableCapacity < 2 * (size_t)callCount) {
+        tableCapacity *= 2;
+    }
+
+    if (r3d_array_reserve(&R3D.container.aSkinnedTable, tableCapacity) < 0) {
+        TraceLog(LOG_WARNING, "R3D: Failed to reserve the skinning prepass table, meshes will be skinned by each pass this frame");
+        return;
+    }
+
+    int* table = R3D.container.aSkinnedTable.data;
+    r3d_drawcall_t** skinCalls = R3D.container.aSkinCalls.data;
+
+    memset(table, 0xFF, tableCapacity * sizeof(int));
+
+    /* --- Setup the transform feedback state --- */
+
+    r3d_shader_enable(generate.skinning);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, R3D.storage.texMatrices);
+
+    glEnable(GL_RASTERIZER_DISCARD);
+
+    /* --- Skin each distinct mesh and pose into a buffer of the pool --- */
+
+    // NOTE: The buffers are reused from frame to frame in the same order,
+    //       they only grow when a mesh has more vertices than the previous one.
+
+    int usedCount = 0;
+
+    for (int i = 0; i < callCount; i++)
+    {
+        r3d_drawcall_t* call = skinCalls[i];
+
+        const R3D_Mesh* mesh = call->geometry.model.mesh;
+        int boneStorage = call->geometry.model.boneStorage;
+
+        if (boneStorage < 0 || mesh->vao == 0 || mesh->vertexCount <= 0) {
+            continue;
+        }
+
+        uint32_t hash = (uint32_t)((uintptr_t)mesh >> 4) * 2654435761u;
+        hash ^= (uint32_t)boneStorage * 0x85EBCA77u;
+
+        size_t slot = hash & (tableCapacity - 1);
+        while (table[slot] >= 0) {
+            const r3d_skinned_mesh_t* skinned = r3d_array_at(&R3D.container.aSkinnedMeshes, table[slot]);
+            if (skinned->mesh == mesh && skinned->boneStorage == boneStorage) break;
+            slot = (slot + 1) & (tableCapacity - 1);
+        }
+
+        if (table[slot] < 0) {
+            if (usedCount == (int)R3D.container.aSkinnedMeshes.count) {
+                r3d_skinned_mesh_t empty = { 0 };
+                if (r3d_array_push_back(&R3D.container.aSkinnedMeshes, &empty) < 0) {
+                    continue;
+                }
+            }
+            r3d_prepare_skin_mesh(r3d_array_at(&R3D.container.aSkinnedMeshes, usedCount), mesh, boneStorage);
+            table[slot] = usedCount++;
+        }
+
+        const r3d_skinned_mesh_t* skinned = r3d_array_at(&R3D.container.aSkinnedMeshes, table[slot]);
+
+        call->geometry.model.skinnedVao = skinned->vao;
+        call->geometry.model.boneStorage = -1;
+    }
+
+    /* --- Restore the state --- */
+
+    glDisable(GL_RASTERIZER_DISCARD);
+
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    r3d_shader_disable();
+}
+
+void r3d_prepare_skin_mesh(r3d_skinned_mesh_t* skinned, const R3D_Mesh* mesh, int boneStorage)
+{
+    /* --- Create or grow the buffer --- */
+
+    if (skinned->vao == 0) {
+        glGenVertexArrays(1, &skinned->vao);
+        glGenBuffers(1, &skinned->vbo);
+        skinned->capacity = 0;
+    }
+
+    if (skinned->capacity < mesh->vertexCount) {
+        int capacity = (skinned->capacity > 0) ? skinned->capacity : 256;
+        while (capacity < mesh->vertexCount) {
+            capacity *= 2;
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, skinned->vbo);
+        glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(r3d_skinned_vertex_t), NULL, GL_DYNAMIC_COPY);
+        skinned->capacity = capacity;
+    }
+
+    skinned->mesh = mesh;
+    skinned->boneStorage = boneStorage;
+
+    /* --- Skin the vertices of the mesh into the buffer --- */
+
+    r3d_shader_set_int(generate.skinning, uBoneOffset, boneStorage);
+
+    glBindVertexArray(mesh->vao);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, skinned->vbo);
+
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, mesh->vertexCount);
+    glEndTransformFeedback();
+
+    /* --- Read the skinned attributes from the buffer and the others from the mesh --- */
+
+    // NOTE: Done each time the buffer is used, another mesh may have used it in the previous frame
+
+    glBindVertexArray(skinned->vao);
+
+    glBindBuffer(GL_ARRAY_BUFFER, skinned->vbo);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(r3d_skinned_vertex_t), (void*)offsetof(r3d_skinned_vertex_t, position));
+
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(r3d_skinned_vertex_t), (void*)offsetof(r3d_skinned_vertex_t, normal));
+
+    glEnableVertexAttribArray(4);
+    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(r3d_skinned_vertex_t), (void*)offsetof(r3d_skinned_vertex_t, tangent));
+
+    glBindBuffer(GL_ARRAY_BUFFER, mesh->vbo);
+
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(R3D_Vertex), (void*)offsetof(R3D_Vertex, texcoord));
+
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(R3D_Vertex), (void*)offsetof(R3D_Vertex, color));
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->ebo);
+}
+
+void r3d_prepare_job_process_lights(void* userData, int begin, int end)
+{
+    r3d_light_batched_t* batch = userData;
+
+    for (int i = begin; i < end; i++)
+    {
+        int id = i + 1;
+
+        batch[i].data = NULL;
+
+        /* --- Check if the light in the registry is still valid --- */
+
+        if (!r3d_registry_is_valid(&R3D.container.rLights, id)) {
+            continue;
+        }
+
+        /* --- Get the valid light and check if it is active --- */
+
+        r3d_light_t* light = r3d_registry_get(&R3D.container.rLights, id);
+        if (!light->enabled) continue;
+
+        /* --- Process shadow update mode --- */
+
+        if (light->shadow.enabled) {
+            r3d_light_process_shadow_update(light);
+        }
+
+        /* --- Frustum culling of lights areas --- */
+
+        BoundingBox aabb = r3d_light_get_bounding_box(light);
+
+        if (light->type != R3D_LIGHT_DIR) {
+            if (!r3d_frustum_is_aabb_in(&R3D.state.frustum.shape, &aabb)) {
+                continue;
+            }
+        }
+
+        /* --- Here the light is supposed to be visible --- */
+
+        batch[i] = (r3d_light_batched_t) { .data = light, .aabb = aabb };
+    }
+}
+
+void r3d_prepare_job_cull_drawcalls(void* userData, int begin, int end)
+{
+    r3d_cull_job_t* job = userData;
+
+    bool noCulling = (R3D.state.flags & R3D_FLAG_NO_FRUSTUM_CULLING);
+
+    /* --- Compute the world space boxes of the range --- */
+
+    // Arrays are ordered as: deferred, forward, deferred instanced, forward instanced
+    int offset = 0;
+
+    for (int i = 0; i < 4 && offset < end && !noCulling; i++)
+    {
+        const r3d_drawcall_t* calls = job->arrays[i]->data;
+        int count = (int)job->arrays[i]->count;
+        bool instanced = (i >= 2);
+
+        int first = (begin > offset) ? begin - offset : 0;
+        int last = (end - offset < count) ? end - offset : count;
+
+        for (int j = first; j < last; j++)
+        {
+            const r3d_drawcall_t* call = &calls[j];
+
+            if (instanced) {
+                r3d_aabb_soa_set(&job->boxes, offset + j, &call->instanced.allAabb, &call->transform);
+            }
+            else if (call->geometryType == R3D_DRAWCALL_GEOMETRY_MODEL) {
+                r3d_aabb_soa_set(&job->boxes, offset + j, &call->geometry.model.mesh->aabb, &call->transform);
+            }
+            else {
+                const Vector3* quad = call->geometry.sprite.quad;
+                BoundingBox aabb = { quad[0], quad[0] };
+                for (int k = 1; k < 4; k++) {
+                    aabb.min = Vector3Min(aabb.min, quad[k]);
+                    aabb.max = Vector3Max(aabb.max, quad[k]);
+                }
+                r3d_aabb_soa_set(&job->boxes, offset + j, &aabb, &R3D_MATRIX_IDENTITY);
+            }
+        }
+
+        offset += count;
+    }
+
+    /* --- Test all the boxes of the range at once --- */
+
+    if (noCulling) {
+        for (int i = begin; i < end; i += 32) {
+            job->mask[i >> 5] = (end - i < 32) ? (1u << (end - i)) - 1 : 0xFFFFFFFF;
+        }
+    }
+    else {
+        r3d_frustum_cull_aabb_soa(&R3D.state.frustum.shape, &job->boxes, begin, end, job->mask);
+    }
+
+    /* --- Apply the cases not covered by the boxes --- */
+
+    offset = 0;
+
+    for (int i = 0; i < 4 && offset < end; i++)
+    {
+        const r3d_drawcall_t* calls = job->arrays[i]->data;
+        int count = (int)job->arrays[i]->count;
+        bool instanced = (i >= 2);
+
+        int first = (begin > offset) ? begin - offset : 0;
+        int last = (end - offset < count) ? end - offset : count;
+
+        for (int j = first; j < last; j++)
+        {
+            const r3d_drawcall_t* call = &calls[j];
+            int bit = offset + j;
+
+            // Instanced calls without global bounding box are never culled
+            if (instanced && call->instanced.allAabb.min.x == -FLT_MAX) {
+                job->mask[bit >> 5] |= 1u << (bit & 31);
+            }
+
+            if (R3D_IS_SHADOW_CAST_ONLY(call->shadowCastMode)) {
+                job->mask[bit >> 5] &= ~(1u << (bit & 31));
+            }
+        }
+
+        offset += count;
+    }
+}
+
+void r3d_prepare_job_sort_drawcalls(void* userData, int begin, int end)
+{
+    (void)userData;
+
+    for (int i = begin; i < end; i++)
+    {
+        // Sort by state for deferred rendering, this takes precedence over the depth order
+        if (i == 0 && (R3D.state.flags & R3D_FLAG_STATE_SORTING)) {
+            r3d_prepare_sort_drawcall_array(
+                &R3D.container.aDrawDeferred,
+                &R3D.container.aDrawDeferredOrder,
+                &R3D.container.aDrawDeferredKeys,
+                r3d_drawcall_sort_by_state
+            );
+        }
+
+        // Sort front-to-back for deferred rendering
+        else if (i == 0 && (R3D.state.flags & R3D_FLAG_OPAQUE_SORTING)) {
+            r3d_prepare_sort_drawcall_array(
+                &R3D.container.aDrawDeferred,
+                &R3D.container.aDrawDeferredOrder,
+                &R3D.container.aDrawDeferredKeys,
+                r3d_drawcall_sort_front_to_back
+            );
+        }
+
+        // Sort back-to-front for forward rendering
+        if (i == 1 && (R3D.state.flags & R3D_FLAG_TRANSPARENT_SORTING)) {
+            r3d_prepare_sort_drawcall_array(
+                &R3D.container.aDrawForward,
+                &R3D.container.aDrawForwardOrder,
+                &R3D.container.aDrawForwardKeys,
+                r3d_drawcall_sort_back_to_front
+            );
+        }
+    }
+}
+
+void r3d_prepare_job_anim_drawcalls(void* userData, int begin, int end)
+{
+    const r3d_pose_entry_t* poses = userData;
+
+    for (int i = begin; i < end; i++)
+    {
+        const r3d_pose_entry_t* pose = &poses[i];
+
+        if (pose->held != NULL) {
+            memcpy(pose->matrices, pose->held, pose->anim->boneCount * sizeof(Matrix));
+            continue;
+        }
+
+        if (pose->layers != NULL) {
+            r3d_anim_blend_evaluate(
+                pose->layers, pose->layerCount, pose->boneDepth,
+                pose->boneOffsets, pose->scratch, pose->matrices
+            );
+            continue;
+        }
+
+        if (pose->anim->clip != NULL) {
+            r3d_anim_clip_evaluate(
+                pose->anim->clip, (float)pose->frame + pose->fraction, pose->boneDepth,
+                pose->boneOffsets, pose->scratch, pose->matrices
+            );
+            continue;
+        }
+
+        r3d_matrix_multiply_batch(
+            pose->matrices, pose->boneOffsets,
+            pose->anim->frameGlobalPoses[pose->frame],
+            pose->anim->boneCount
+        );
+    }
+}
+
+bool r3d_pose_entry_equals(const r3d_pose_entry_t* a, const r3d_pose_entry_t* b)
+{
+    return a->boneOffsets == b->boneOffsets && a->anim == b->anim && a->frame == b->frame && a->fraction == b->fraction &&
+           a->layers == b->layers && a->layerCount == b->layerCount && a->boneDepth == b->boneDepth;
+}
+
+void r3d_static_mesh_update_drawcall(r3d_static_mesh_t* staticMesh)
+{
+    // The mesh state can change after registration, like for regular draw calls it is read when rendering
+    r3d_drawcall_t* call = &staticMesh->call;
+
+    call->shadowCastMode = call->geometry.model.mesh->shadowCastMode;
+    call->renderMode = R3D_DRAWCALL_RENDER_DEFERRED;
+
+    // The material is interned again only if the cache released it since the last use
+    if (!r3d_material_cache_touch(&R3D.container.materials, call->material, call->materialVersion, R3D.state.frameIndex)) {
+        r3d_drawcall_set_material(call, &staticMesh->material);
+    }
+
+    if (staticMesh->material.blendMode != R3D_BLEND_OPAQUE || R3D.state.flags & R3D_FLAG_FORCE_FORWARD) {
+        call->renderMode = R3D_DRAWCALL_RENDER_FORWARD;
+    }
+}
+
+static bool r3d_pass_shadow_maps_is_caster(const r3d_drawcall_t* call, bool instanced, const r3d_frustum_t* frustum)
+{
+    if (call->shadowCastMode == R3D_SHADOW_CAST_DISABLED) {
+        return false;
+    }
+
+    BoundingBox aabb = { 0 };
+    if (!r3d_prepare_get_drawcall_world_aabb(call, instanced, &aabb)) {
+        return true;
+    }
+
+    return r3d_frustum_is_aabb_in(frustum, &aabb);
+}
+
+static float r3d_pass_shadow_maps_screen_size(const BoundingBox* aabb)
+{
+    // NOTE: Fraction of the screen height covered by the bounding sphere of the light,
+    //       which is all of it when the camera is inside the sphere
+
+    Vector3 center = Vector3Scale(Vector3Add(aabb->min, aabb->max), 0.5f);
+    float radius = 0.5f * Vector3Distance(aabb->min, aabb->max);
+    float size = radius * R3D.state.transform.proj.m5;
+
+    if (R3D.state.transform.proj.m15 == 0.0f) {
+        float distance = Vector3Distance(center, R3D.state.transform.viewPos);
+        size = (distance > radius) ? size / distance : 1.0f;
+    }
+
+    return Clamp(size, 0.0f, 1.0f);
+}
+
+static bool r3d_pass_shadow_maps_has_tiles(const r3d_shadow_t* shadow)
+{
+    return shadow->atlasGeneration == R3D.framebuffer.shadowAtlas.generation && shadow->tiles[0].size > 0;
+}
+
+static Vector4 r3d_pass_shadow_maps_get_tile_rect(const r3d_shadow_tile_t* tile)
+{
+    // NOTE: Offset and size of the tile in the texture coordinates of the atlas, and its page
+    float texel = 1.0f / R3D.framebuffer.shadowAtlas.size;
+    return (Vector4) { tile->x * texel, tile->y * texel, tile->size * texel, (float)tile->page };
+}
+
+static bool r3d_pass_shadow_maps_is_cache_valid(const r3d_shadow_cache_t* cache, const Matrix* matVP)
+{
+    return cache->valid && cache->version == R3D.state.scene.staticVersion
+        && cache->layers == R3D.state.layers && memcmp(&cache->matVP, matVP, sizeof(Matrix)) == 0;
+}
+
+static void r3d_pass_shadow_maps_check_static_meshes(void)
+{
+    // NOTE: The static meshes point to user meshes, whose shadow mode and layers can be edited
+    //       at any time. The changes seen here outdate the cached static shadows like an edit
+    //       of the static scene. The geometry updates are handled by R3D_UpdateMesh().
+
+    r3d_registry_t* registry = &R3D.container.rStaticMeshes;
+    unsigned int count = r3d_registry_get_allocated_count(registry);
+
+    for (unsigned int id = 1; id <= count; id++)
+    {
+        r3d_static_mesh_t* staticMesh = r3d_registry_get(registry, id);
+        if (staticMesh == NULL) continue;
+
+        const R3D_Mesh* mesh = staticMesh->call.geometry.model.mesh;
+        if (mesh->shadowCastMode != staticMesh->shadowCastMode || mesh->layers != staticMesh->layers) {
+            staticMesh->shadowCastMode = mesh->shadowCastMode;
+            staticMesh->layers = mesh->layers;
+            R3D.state.scene.staticVersion++;
+        }
+    }
+}
+
+static uint64_t r3d_pass_shadow_maps_hash(uint64_t hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = data;
+
+    for (size_t i = 0; i < size; i += 8) {
+        uint64_t word = 0;
+        memcpy(&word, bytes + i, (size - i < 8) ? size - i : 8);
+        hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 32;
+    }
+
+    return hash;
+}
+
+static uint64_t r3d_pass_shadow_maps_hash_call(uint64_t hash, const r3d_drawcall_t* call, bool instanced)
+{
+    hash = r3d_pass_shadow_maps_hash(hash, &call->transform, sizeof(Matrix));
+    hash = r3d_pass_shadow_maps_hash(hash, &call->shadowCastMode, sizeof(call->shadowCastMode));
+    hash = r3d_pass_shadow_maps_hash(hash, &call->material, sizeof(call->material));
+    hash = r3d_pass_shadow_maps_hash(hash, &call->materialVersion, sizeof(call->materialVersion));
+
+    if (call->geometryType == R3D_DRAWCALL_GEOMETRY_SPRITE) {
+        hash = r3d_pass_shadow_maps_hash(hash, call->geometry.sprite.quad, sizeof(call->geometry.sprite.quad));
+    }
+    else {
+        hash = r3d_pass_shadow_maps_hash(hash, &call->geometry.model.mesh, sizeof(const R3D_Mesh*));
+        hash = r3d_pass_shadow_maps_hash(hash, &call->geometry.model.mesh->version, sizeof(unsigned int));
+        hash = r3d_pass_shadow_maps_hash(hash, &call->geometry.model.anim, sizeof(const R3D_ModelAnimation*));
+        hash = r3d_pass_shadow_maps_hash(hash, &call->geometry.model.frame, sizeof(int));
+        hash = r3d_pass_shadow_maps_hash(hash, &call->geometry.model.frameFraction, sizeof(float));
+        hash = r3d_pass_shadow_maps_hash(hash, &call->geometry.model.boneDepth, sizeof(int));
+
+        for (int i = 0; i < call->geometry.model.layerCount; i++) {
+            const R3D_AnimationLayer* layer = &call->geometry.model.layers[i];
+            hash = r3d_pass_shadow_maps_hash(hash, &layer->anim, sizeof(const R3D_ModelAnimation*));
+            hash = r3d_pass_shadow_maps_hash(hash, &layer->frame, sizeof(float));
+            hash = r3d_pass_shadow_maps_hash(hash, &layer->weight, sizeof(float));
+            hash = r3d_pass_shadow_maps_hash(hash, &layer->mode, sizeof(R3D_AnimLayerMode));
+        }
+
+        // NOTE: The bones given by the user can change in place, the call is never considered unchanged
+        if (call->geometry.model.boneOverride != NULL) {
+            hash = r3d_pass_shadow_maps_hash(hash, &R3D.state.frameIndex, sizeof(unsigned int));
+        }
+    }
+
+    if (instanced) {
+        size_t stride = (call->instanced.transStride == 0) ? sizeof(Matrix) : call->instanced.transStride;
+        const unsigned char* transforms = (const unsigned char*)call->instanced.transforms;
+        hash = r3d_pass_shadow_maps_hash(hash, &call->instanced.count, sizeof(size_t));
+        for (size_t i = 0; i < call->instanced.count; i++) {
+            hash = r3d_pass_shadow_maps_hash(hash, transforms + i * stride, sizeof(Matrix));
+        }
+    }
+
+    return hash;
+}
+
+static uint64_t r3d_pass_shadow_maps_face_signature(const Matrix* matVP, const r3d_frustum_t* frustum)
+{
+    // NOTE: Hash of everything drawn in a face of a cubemap, the face is only drawn again when it changes.
+    //       The view/projection covers the position and the range of the light.
+
+    uint64_t hash = 0xCBF29CE484222325ull;
+
+    hash = r3d_pass_shadow_maps_hash(hash, matVP, sizeof(Matrix));
+    hash = r3d_pass_shadow_maps_hash(hash, &R3D.state.layers, sizeof(R3D_Layer));
+
+    /* --- Draw calls of the frame overlapping the face --- */
+
+    const r3d_array_t* arrays[4] = {
+        &R3D.container.aDrawDeferredInst, &R3D.container.aDrawForwardInst,
+        &R3D.container.aDrawDeferred, &R3D.container.aDrawForward
+    };
+
+    for (int a = 0; a < 4; a++) {
+        bool instanced = (a < 2);
+        for (size_t k = 0; k < arrays[a]->count; k++) {
+            const r3d_drawcall_t* call = (const r3d_drawcall_t*)arrays[a]->data + k;
+            if (r3d_pass_shadow_maps_is_caster(call, instanced, frustum)) {
+                hash = r3d_pass_shadow_maps_hash_call(hash, call, instanced);
+            }
+        }
+    }
+
+    /* --- Static meshes overlapping the face --- */
+
+    r3d_array_clear(&R3D.container.aStaticVisible);
+    r3d_bvh_query_frustum(&R3D.container.staticTree, frustum, &R3D.container.aStaticVisible);
+
+    const unsigned int* ids = R3D.container.aStaticVisible.data;
+    int count = (int)R3D.container.aStaticVisible.count;
+
+    for (int i = 0; i < count; i++) {
+        const r3d_static_mesh_t* staticMesh = r3d_registry_get(&R3D.container.rStaticMeshes, ids[i]);
+        const R3D_Mesh* mesh = staticMesh->call.geometry.model.mesh;
+        bool active = R3D_IS_ACTIVE_LAYERS(mesh->layers);
+        hash = r3d_pass_shadow_maps_hash(hash, &ids[i], sizeof(unsigned int));
+        hash = r3d_pass_shadow_maps_hash(hash, &mesh, sizeof(const R3D_Mesh*));
+        hash = r3d_pass_shadow_maps_hash(hash, &mesh->version, sizeof(unsigned int));
+        hash = r3d_pass_shadow_maps_hash(hash, &mesh->shadowCastMode, sizeof(R3D_ShadowCastMode));
+        hash = r3d_pass_shadow_maps_hash(hash, &active, sizeof(bool));
+        hash = r3d_pass_shadow_maps_hash(hash, &staticMesh->call.transform, sizeof(Matrix));
+    }
+
+    // The value 0 is kept for the faces that must be drawn
+    return (hash != 0) ? hash : 1;
+}
+
+void r3d_pass_shadow_maps_allocate_tiles(void)
+{
+    r3d_shadow_atlas_t* atlas = &R3D.framebuffer.shadowAtlas;
+    r3d_array_t* requests = &R3D.container.aShadowRequests;
+
+    r3d_array_clear(requests);
+
+    /* --- Request a tile size for each visible light drawn in the atlas --- */
+
+    for (int i = 0; i < R3D.container.aLightBatch.count; i++)
+    {
+        r3d_light_batched_t* light = r3d_array_at(&R3D.container.aLightBatch, i);
+        r3d_shadow_t* shadow = &light->data->shadow;
+
+        if (!shadow->enabled || light->data->type == R3D_LIGHT_OMNI) {
+            continue;
+        }
+
+        // The textures are only created once a light needs them
+        if (atlas->framebuffer == 0 && !r3d_shadow_atlas_load(atlas)) {
+            return;
+        }
+
+        int maxSize = R3D_SHADOW_ATLAS_MIN_TILE;
+        while (maxSize < shadow->map.resolution && maxSize < atlas->size) maxSize *= 2;
+
+        // NOTE: The directional lights cover the whole view, the tiles of the
+        //       other lights follow the part of the screen they can light
+        float importance = 1.0f;
+        if (light->data->type != R3D_LIGHT_DIR) {
+            importance = r3d_pass_shadow_maps_screen_size(&light->aabb);
+        }
+
+        int size = R3D_SHADOW_ATLAS_MIN_TILE;
+        while (size < maxSize && size < importance * maxSize) size *= 2;
+
+        // NOTE: A tile only shrinks when it gets at least twice too large,
+        //       so a light moving around a size threshold doesn't repack the atlas
+        int current = (shadow->atlasGeneration == atlas->generation) ? shadow->tiles[0].size : 0;
+        if (current > size && current <= 2 * size && current <= maxSize) {
+            size = current;
+        }
+
+        r3d_shadow_request_t request = {
+            .owner = shadow,
+            .tiles = shadow->tiles,
+            .layers = shadow->map.layers,
+            .size = size,
+            .importance = importance
+        };
+
+        if (r3d_array_push_back(requests, &request) < 0) {
+            TraceLog(LOG_ERROR, "R3D: Failed to request a shadow atlas tile, shadows of some lights will be skipped");
+            break;
+        }
+    }
+
+    r3d_shadow_request_t* data = requests->data;
+    int count = (int)requests->count;
+
+    r3d_shadow_atlas_fit(atlas, data, count);
+
+    /* --- Pack the atlas again only when a light doesn't keep its tiles --- */
+
+    bool repack = false;
+
+    for (int i = 0; i < count; i++) {
+        const r3d_shadow_t* shadow = data[i].owner;
+        int current = (shadow->atlasGeneration == atlas->generation) ? shadow->tiles[0].size : -1;
+        if (current != data[i].size) {
+            repack = true;
+            break;
+        }
+    }
+
+    if (!repack) {
+        return;
+    }
+
+    r3d_shadow_atlas_pack(atlas, data, count);
+
+    // NOTE: The lights not visible this frame lose their tiles, the others are drawn again in their new tiles
+    for (int i = 0; i < count; i++) {
+        r3d_shadow_t* shadow = data[i].owner;
+        memset(shadow->staticCache, 0, sizeof(shadow->staticCache));
+        shadow->atlasGeneration = atlas->generation;
+        shadow->updateConf.shouldUpdate = true;
+    }
+}
+
+void r3d_pass_shadow_maps(void)
+{
+    // Config context state
+    glEnable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+
+    // Outdate the cached static shadows if a static mesh changed since the last frame
+    r3d_pass_shadow_maps_check_static_meshes();
+
+    // Give their tiles in the atlas to the directional and spot lights
+    r3d_shadow_atlas_t* atlas = &R3D.framebuffer.shadowAtlas;
+    r3d_pass_shadow_maps_allocate_tiles();
+
+    // Iterate through all lights to render all geometries
+    for (int i = 0; i < R3D.container.aLightBatch.count; i++)
+    {
+        r3d_light_batched_t* light = r3d_array_at(&R3D.container.aLightBatch, i);
+
+        // Skip light if it doesn't produce shadows
+        if (!light->data->shadow.enabled) continue;
+
+        // Skip the lights that didn't get tiles in the atlas, their shadows are disabled this frame
+        if (light->data->type != R3D_LIGHT_OMNI && !r3d_pass_shadow_maps_has_tiles(&light->data->shadow)) continue;
+
+        // Skip if it's not time to update shadows
+        if (!light->data->shadow.updateConf.shouldUpdate) continue;
+        else r3d_light_indicate_shadow_update(light->data);
+
+        // TODO: The lights could be sorted to avoid too frequent
+        //       state changes, just like with shaders.
+
+        // TODO: The draw calls could also be sorted
+        //       according to the shadow cast mode.
+
+        if (light->data->type == R3D_LIGHT_OMNI)
         {
+            // Start rendering to the cubemap of the light
+            glBindFramebuffer(GL_FRAMEBUFFER, light->data->shadow.map.id);
             glViewport(0, 0, light->data->shadow.map.resolution, light->data->shadow.map.resolution);
 
-            if (light->data->type == R3D_LIGHT_OMNI)
+            // Calculate projection matrix for omni-directional light
+            Matrix matProj = r3d_light_get_matrix_proj_omni(light->data);
+
+            // Render geometries for each face of the cubemap
+            for (int j = 0; j < 6; j++)
             {
-                // Calculate projection matrix for omni-directional light
-                Matrix matProj = r3d_light_get_matrix_proj_omni(light->data);
+                // Calculate view and view/projection matrices for the current cubemap face
+                Matrix matView = r3d_light_get_matrix_view_omni(light->data, j);
+                Matrix matVP = r3d_matrix_multiply(&matView, &matProj);
+                r3d_frustum_t frustum = r3d_frustum_create(matVP);
+
+                // Skip the faces whose casters didn't change since they were drawn
+                uint64_t signature = r3d_pass_shadow_maps_face_signature(&matVP, &frustum);
+                if (signature == light->data->shadow.faceSignatures[j]) continue;
+                light->data->shadow.faceSignatures[j] = signature;
 
-                // Render geometries for each face of the cubemap
-                for (int j = 0; j < 6; j++)
+                glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_CUBE_MAP_POSITIVE_X + j, light->data->shadow.map.depth, 0);
+                glClear(GL_DEPTH_BUFFER_BIT);
+
+                // Rasterize geometries for depth rendering
+                r3d_shader_enable(raster.depthCubeInst);
                 {
-                    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_CUBE_MAP_POSITIVE_X + j, light->data->shadow.map.depth, 0);
-                    glClear(GL_DEPTH_BUFFER_BIT);
+                    r3d_shader_set_vec3(raster.depthCubeInst, uViewPosition, light->data->position);
+                    r3d_shader_set_float(raster.depthCubeInst, uFar, light->data->far);
 
-                    // Calculate view and view/projection matrices for the current cubemap face
-                    Matrix matView = r3d_light_get_matrix_view_omni(light->data, j);
-                    Matrix matVP = r3d_matrix_multiply(&matView, &matProj);
-
-                    // Rasterize geometries for depth rendering
-                    r3d_shader_enable(raster.depthCubeInst);
-                    {
-                        r3d_shader_set_vec3(raster.depthCubeInst, uViewPosition, light->data->position);
-                        r3d_shader_set_float(raster.depthCubeInst, uFar, light->data->far);
-
-                        for (size_t k = 0; k < R3D.container.aDrawDeferredInst.count; k++) {
-                            r3d_drawcall_t* call = (r3d_drawcall_t*)R3D.container.aDrawDeferredInst.data + k;
-                            if (call->shadowCastMode != R3D_SHADOW_CAST_DISABLED) {
-                                r3d_drawcall_raster_depth_cube_inst(call, false, true, &matVP);
-                            }
+                    for (size_t k = 0; k < R3D.container.aDrawDeferredInst.count; k++) {
+                        r3d_drawcall_t* call = (r3d_drawcall_t*)R3D.container.aDrawDeferredInst.data + k;
+                        if (r3d_pass_shadow_maps_is_caster(call, true, &frustum)) {
+                            r3d_drawcall_raster_depth_cube_inst(call, false, true, &matVP);
                         }
+                    }
 
-                        for (size_t k = 0; k < R3D.container.aDrawForwardInst.count; k++) {
-                            r3d_drawcall_t* call = (r3d_drawcall_t*)R3D.container.aDrawForwardInst.data + k;
-                            if (call->shadowCastMode != R3D_SHADOW_CAST_DISABLED) {
-                                r3d_drawcall_raster_depth_cube_inst(call, true, true, &matVP);
-                            }
+                    for (size_t k = 0; k < R3D.container.aDrawForwardInst.count; k++) {
+                        r3d_drawcall_t* call = (r3d_drawcall_t*)R3D.container.aDrawForwardInst.data + k;
+                        if (r3d_pass_shadow_maps_is_caster(call, true, &frustum)) {
+                            r3d_drawcall_raster_depth_cube_inst(call, true, true, &matVP);
                         }
-
-                        // NOTE: The storage texture of the matrices may have been bind during drawcalls
-                        r3d_shader_unbind_sampler1D(raster.depthCubeInst, uTexBoneMatrices);
                     }
-                    r3d_shader_enable(raster.depthCube);
-                    {
-                        r3d_shader_set_vec3(raster.depthCube, uViewPosition, light->data->position);
-                        r3d_shader_set_float(raster.depthCube, uFar, light->data->far);
-
-                        for (size_t k = 0; k < R3D.container.aDrawDeferred.count; k++) {
-                            r3d_drawcall_t* call = (r3d_drawcall_t*)R3D.container.aDrawDeferred.data + k;
-                            if (call->shadowCastMode != R3D_SHADOW_CAST_DISABLED) {
-                                r3d_drawcall_raster_depth_cube(call, false, true, &matVP);
-                            }
-                        }
 
-                        for (size_t k = 0; k < R3D.container.aDrawForward.count; k++) {
-                            r3d_drawcall_t* call = (r3d_drawcall_t*)R3D.container.aDrawForward.data + k;
-                            if (call->shadowCastMode != R3D_SHADOW_CAST_DISABLED) {
-                                r3d_drawcall_raster_depth_cube(call, true, true, &matVP);
-                            }
+                    // NOTE: The storage texture of the matrices may have been bind during drawcalls
+                    r3d_shader_unbind_sampler2D(raster.depthCubeInst, uTexBoneMatrices);
+                }
+                r3d_shader_enable(raster.depthCube);
+                {
+                    r3d_shader_set_vec3(raster.depthCube, uViewPosition, light->data->position);
+                    r3d_shader_set_float(raster.depthCube, uFar, light->data->far);
+
+                    for (size_t k = 0; k < R3D.container.aDrawDeferred.count; k++) {
+                        r3d_drawcall_t* call = (r3d_drawcall_t*)R3D.container.aDrawDeferred.data + k;
+                        if (r3d_pass_shadow_maps_is_caster(call, false, &frustum)) {
+                            r3d_drawcall_raster_depth_cube(call, false, true, &matVP);
                         }
+                    }
 
-                        // NOTE: The storage texture of the matrices may have been bind during drawcalls
-                        r3d_shader_unbind_sampler1D(raster.depthCube, uTexBoneMatrices);
+                    for (size_t k = 0; k < R3D.container.aDrawForward.count; k++) {
+                        r3d_drawcall_t* call = (r3d_drawcall_t*)R3D.container.aDrawForward.data + k;
+                        if (r3d_pass_shadow_maps_is_caster(call, false, &frustum)) {
+                            r3d_drawcall_raster_depth_cube(call, true, true, &matVP);
+                        }
                     }
+
+                    r3d_pass_shadow_maps_static(&matVP, true);
+
+                    // NOTE: The storage texture of the matrices may have been bind during drawcalls
+                    r3d_shader_unbind_sampler2D(raster.depthCube, uTexBoneMatrices);
                 }
             }
-            else
-            {
-                // Clear depth buffer for other light types
-                glClear(GL_DEPTH_BUFFER_BIT);
+        }
+        else
+        {
+            r3d_shadow_t* shadow = &light->data->shadow;
+
+            if (light->data->type == R3D_LIGHT_DIR) {
+                r3d_light_update_cascades_dir(
+                    light->data, R3D.state.scene.bounds,
+                    &R3D.state.transform.invView, &R3D.state.transform.invProj,
+                    (float)rlGetCullDistanceNear(), (float)rlGetCullDistanceFar()
+                );
+            }
+            else if (light->data->type == R3D_LIGHT_SPOT) {
+                Matrix matView = r3d_light_get_matrix_view_spot(light->data);
+                Matrix matProj = r3d_light_get_matrix_proj_spot(light->data);
+                shadow->matVP = r3d_matrix_multiply(&matView, &matProj);
+                shadow->cascadeVP[0] = shadow->matVP;
+                shadow->cascades[0] = (Vector4) { 1.0f, 1.0f, 0.0f, 0.0f };
+            }
 
-                Matrix matView = { 0 };
-                Matrix matProj = { 0 };
+            // NOTE: The drawing is restricted to the tile by the scissor, which also restricts the clears
+            glEnable(GL_SCISSOR_TEST);
 
-                if (light->data->type == R3D_LIGHT_DIR) {
-                    r3d_light_get_matrix_vp_dir(light->data, R3D.state.scene.bounds, &matView, &matProj);
-                }
-                else if (light->data->type == R3D_LIGHT_SPOT) {
-                    matView = r3d_light_get_matrix_view_spot(light->data);
-                    matProj = r3d_light_get_matrix_proj_spot(light->data);
+            // Render each layer in its tile, the casters are culled per cascade
+            for (int j = 0; j < shadow->map.layers; j++)
+            {
+                const r3d_shadow_tile_t* tile = &shadow->tiles[j];
+                const Matrix* matVP = &shadow->cascadeVP[j];
+                r3d_frustum_t frustum = r3d_frustum_create(*matVP);
+
+                // The static casters are only drawn again when their cached depth is outdated
+                r3d_shadow_cache_t* cache = &shadow->staticCache[j];
+                if (!r3d_pass_shadow_maps_is_cache_valid(cache, matVP)) {
+                    r3d_shadow_atlas_bind_tile(atlas, tile, true);
+                    glClear(GL_DEPTH_BUFFER_BIT);
+                    r3d_shader_enable(raster.depth);
+                    r3d_pass_shadow_maps_static(matVP, false);
+                    r3d_shader_unbind_sampler2D(raster.depth, uTexBoneMatrices);
+                    *cache = (r3d_shadow_cache_t) {
+                        .matVP = *matVP,
+                        .layers = R3D.state.layers,
+                        .version = R3D.state.scene.staticVersion,
+                        .valid = true
+                    };
                 }
 
-                // Calculate view/projection matrix
-                Matrix matVP = r3d_matrix_multiply(&matView, &matProj);
-
-                // Store view/projection matrix for the shadow map
-                light->data->shadow.matVP = matVP;
+                // The other casters are drawn over a copy of the static depth
+                r3d_shadow_atlas_restore_tile(atlas, tile);
 
                 // Rasterize geometry for depth rendering
                 r3d_shader_enable(raster.depthInst);
                 {
-                    for (size_t j = 0; j < R3D.container.aDrawDeferredInst.count; j++) {
-                        r3d_drawcall_t* call = (r3d_drawcall_t*)R3D.container.aDrawDeferredInst.data + j;
-                        if (call->shadowCastMode != R3D_SHADOW_CAST_DISABLED) {
-                            r3d_drawcall_raster_depth_inst(call, false, true, &matVP);
+                    for (size_t k = 0; k < R3D.container.aDrawDeferredInst.count; k++) {
+                        r3d_drawcall_t* call = (r3d_drawcall_t*)R3D.container.aDrawDeferredInst.data + k;
+                        if (r3d_pass_shadow_maps_is_caster(call, true, &frustum)) {
+                            r3d_drawcall_raster_depth_inst(call, false, true, matVP);
                         }
                     }
-                    for (size_t j = 0; j < R3D.container.aDrawForwardInst.count; j++) {
-                        r3d_drawcall_t* call = (r3d_drawcall_t*)R3D.container.aDrawForwardInst.data + j;
-                        if (call->shadowCastMode != R3D_SHADOW_CAST_DISABLED) {
-                            r3d_drawcall_raster_depth_inst(call, true, true, &matVP);
+                    for (size_t k = 0; k < R3D.container.aDrawForwardInst.count; k++) {
+                        r3d_drawcall_t* call = (r3d_drawcall_t*)R3D.container.aDrawForwardInst.data + k;
+                        if (r3d_pass_shadow_maps_is_caster(call, true, &frustum)) {
+                            r3d_drawcall_raster_depth_inst(call, true, true, matVP);
                         }
                     }
 
                     // NOTE: The storage texture of the matrices may have been bind during drawcalls
-                    r3d_shader_unbind_sampler1D(raster.depthInst, uTexBoneMatrices);
+                    r3d_shader_unbind_sampler2D(raster.depthInst, uTexBoneMatrices);
                 }
                 r3d_shader_enable(raster.depth);
                 {
-                    for (size_t j = 0; j < R3D.container.aDrawDeferred.count; j++) {
-                        r3d_drawcall_t* call = (r3d_drawcall_t*)R3D.container.aDrawDeferred.data + j;
-                        if (call->shadowCastMode != R3D_SHADOW_CAST_DISABLED) {
-                            r3d_drawcall_raster_depth(call, false, true, &matVP);
+                    for (size_t k = 0; k < R3D.container.aDrawDeferred.count; k++) {
+                        r3d_drawcall_t* call = (r3d_drawcall_t*)R3D.container.aDrawDeferred.data + k;
+                        if (r3d_pass_shadow_maps_is_caster(call, false, &frustum)) {
+                            r3d_drawcall_raster_depth(call, false, true, matVP);
                         }
                     }
-                    for (size_t j = 0; j < R3D.container.aDrawForward.count; j++) {
-                        r3d_drawcall_t* call = (r3d_drawcall_t*)R3D.container.aDrawForward.data + j;
-                        if (call->shadowCastMode != R3D_SHADOW_CAST_DISABLED) {
-                            r3d_drawcall_raster_depth(call, true, true, &matVP);
+                    for (size_t k = 0; k < R3D.container.aDrawForward.count; k++) {
+                        r3d_drawcall_t* call = (r3d_drawcall_t*)R3D.container.aDrawForward.data + k;
+                        if (r3d_pass_shadow_maps_is_caster(call, false, &frustum)) {
+                            r3d_drawcall_raster_depth(call, true, true, matVP);
                         }
                     }
 
                     // NOTE: The storage texture of the matrices may have been bind during drawcalls
-                    r3d_shader_unbind_sampler1D(raster.depth, uTexBoneMatrices);
+                    r3d_shader_unbind_sampler2D(raster.depth, uTexBoneMatrices);
                 }
             }
-            r3d_shader_disable();
+
+            glDisable(GL_SCISSOR_TEST);
         }
+        r3d_shader_disable();
     }
     rlDisableFramebuffer();
 
@@ -1312,6 +3111,37 @@ void r3d_pass_shadow_maps(void)
     rlSetCullFace(RL_CULL_FACE_BACK);
 }
 
+void r3d_pass_shadow_maps_static(const Matrix* matVP, bool omni)
+{
+    // NOTE: The static meshes are queried with the frustum of the shadow map,
+    //       so the meshes outside of the camera frustum still cast their shadows.
+
+    r3d_frustum_t frustum = r3d_frustum_create(*matVP);
+
+    r3d_array_clear(&R3D.container.aStaticVisible);
+    r3d_bvh_query_frustum(&R3D.container.staticTree, &frustum, &R3D.container.aStaticVisible);
+
+    const unsigned int* ids = R3D.container.aStaticVisible.data;
+    int count = (int)R3D.container.aStaticVisible.count;
+
+    for (int i = 0; i < count; i++)
+    {
+        r3d_static_mesh_t* staticMesh = r3d_registry_get(&R3D.container.rStaticMeshes, ids[i]);
+        const R3D_Mesh* mesh = staticMesh->call.geometry.model.mesh;
+
+        if (!R3D_IS_ACTIVE_LAYERS(mesh->layers) || mesh->shadowCastMode == R3D_SHADOW_CAST_DISABLED) {
+            continue;
+        }
+
+        r3d_static_mesh_update_drawcall(staticMesh);
+
+        bool forward = (staticMesh->call.renderMode == R3D_DRAWCALL_RENDER_FORWARD);
+
+        if (omni) r3d_drawcall_raster_depth_cube(&staticMesh->call, forward, true, matVP);
+        else r3d_drawcall_raster_depth(&staticMesh->call, forward, true, matVP);
+    }
+}
+
 void r3d_clear_gbuffer(bool bindFramebuffer, bool clearColor, bool clearDepth, bool clearStencil)
 {
     if (bindFramebuffer) {
@@ -1368,16 +3198,21 @@ void r3d_pass_gbuffer(void)
             }
 
             // NOTE: The storage texture of the matrices may have been bind during drawcalls
-            r3d_shader_unbind_sampler1D(raster.geometryInst, uTexBoneMatrices);
+            r3d_shader_unbind_sampler2D(raster.geometryInst, uTexBoneMatrices);
         }
         r3d_shader_enable(raster.geometry);
         {
+            r3d_drawcall_bind_cache_begin();
+
             for (size_t i = 0; i < R3D.container.aDrawDeferred.count; i++) {
-                r3d_drawcall_raster_geometry((r3d_drawcall_t*)R3D.container.aDrawDeferred.data + i, &R3D.state.transform.viewProj);
+                r3d_drawcall_t* call = r3d_get_drawcall_in_order(&R3D.container.aDrawDeferred, &R3D.container.aDrawDeferredOrder, i);
+                r3d_drawcall_raster_geometry(call, &R3D.state.transform.viewProj);
             }
 
+            r3d_drawcall_bind_cache_end();
+
             // NOTE: The storage texture of the matrices may have been bind during drawcalls
-            r3d_shader_unbind_sampler1D(raster.geometry, uTexBoneMatrices);
+            r3d_shader_unbind_sampler2D(raster.geometry, uTexBoneMatrices);
         }
         r3d_shader_disable();
 
@@ -1622,6 +3457,11 @@ void r3d_pass_deferred_lights(void)
         {
             r3d_light_batched_t* light = r3d_array_at(&R3D.container.aLightBatch, i);
 
+            // The lights without shadows were shaded from the clusters
+            if (R3D.state.lightStorage.clustered && !light->data->shadow.enabled) {
+                continue;
+            }
+
             // Use an effect ID that avoids 0 (already used by no-effect areas)
             uint8_t lightEffectID = (i + 1) % 127; // Start at 1, wrap to 127
             if (lightEffectID == 0) lightEffectID = 1; // Avoid 0
@@ -1687,15 +3527,23 @@ void r3d_pass_deferred_lights(void)
                     r3d_shader_set_float(screen.lighting, uLight.attenuation, light->data->attenuation);
                 }
 
-                // Sending shadow map data
-                if (light->data->shadow.enabled) {
+                // Sending shadow map data, the lights without tiles in the atlas are lit without shadows
+                bool hasShadow = light->data->shadow.enabled && (light->data->type == R3D_LIGHT_OMNI
+                    || r3d_pass_shadow_maps_has_tiles(&light->data->shadow));
+
+                if (hasShadow) {
                     if (light->data->type == R3D_LIGHT_OMNI) {
                         r3d_shader_bind_samplerCube(screen.lighting, uLight.shadowCubemap, light->data->shadow.map.depth);
                     }
                     else {
-                        r3d_shader_set_float(screen.lighting, uLight.shadowMapTxlSz, light->data->shadow.map.texelSize);
-                        r3d_shader_bind_sampler2D(screen.lighting, uLight.shadowMap, light->data->shadow.map.depth);
+                        r3d_shader_set_float(screen.lighting, uLight.shadowMapTxlSz, 1.0f / R3D.framebuffer.shadowAtlas.size);
+                        r3d_shader_bind_sampler2DArray(screen.lighting, uLight.shadowMap, R3D.framebuffer.shadowAtlas.depth);
                         r3d_shader_set_mat4(screen.lighting, uLight.matVP, light->data->shadow.matVP);
+                        r3d_shader_set_int(screen.lighting, uLight.cascadeCount, light->data->shadow.map.layers);
+                        for (int j = 0; j < light->data->shadow.map.layers; j++) {
+                            r3d_shader_set_vec4(screen.lighting, uLight.cascades[j], light->data->shadow.cascades[j]);
+                            r3d_shader_set_vec4(screen.lighting, uLight.tiles[j], r3d_pass_shadow_maps_get_tile_rect(&light->data->shadow.tiles[j]));
+                        }
                         if (light->data->type == R3D_LIGHT_DIR) {
                             r3d_shader_set_vec3(screen.lighting, uLight.position, light->data->position);
                         }
@@ -1729,7 +3577,72 @@ void r3d_pass_deferred_lights(void)
         r3d_shader_unbind_sampler2D(screen.lighting, uTexNoise);
 
         r3d_shader_unbind_samplerCube(screen.lighting, uLight.shadowCubemap);
-        r3d_shader_unbind_sampler2D(screen.lighting, uLight.shadowMap);
+        r3d_shader_unbind_sampler2DArray(screen.lighting, uLight.shadowMap);
+    }
+}
+
+void r3d_pass_deferred_lights_clustered(void)
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, R3D.framebuffer.deferred);
+    {
+        glViewport(0, 0, R3D.state.resolution.width, R3D.state.resolution.height);
+
+        /* --- Setup OpenGL pipeline --- */
+
+        glDisable(GL_DEPTH_TEST);
+        glDisable(GL_CULL_FACE);
+        glDepthMask(GL_FALSE);
+
+        // Setup additive blending to accumulate light contributions
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_ONE, GL_ONE);
+        glBlendEquation(GL_FUNC_ADD);
+
+        // Only shade the pixels covered by geometry
+        if (R3D.state.flags & R3D_FLAG_STENCIL_TEST) {
+            r3d_stencil_enable_geometry_test(GL_EQUAL);
+        }
+
+        /* --- Bind all textures --- */
+
+        r3d_shader_bind_sampler2D(screen.lightingClustered, uTexAlbedo, R3D.target.albedo);
+        r3d_shader_bind_sampler2D(screen.lightingClustered, uTexNormal, R3D.target.normal);
+        r3d_shader_bind_sampler2D(screen.lightingClustered, uTexDepth, R3D.target.depthStencil);
+        r3d_shader_bind_sampler2D(screen.lightingClustered, uTexORM, R3D.target.orm);
+        r3d_shader_bind_sampler2D(screen.lightingClustered, uTexLights, R3D.storage.texLights);
+        r3d_shader_bind_sampler2D(screen.lightingClustered, uTexClusters, R3D.storage.texClusters);
+        r3d_shader_bind_sampler2D(screen.lightingClustered, uTexLightIndices, R3D.storage.texLightIndices);
+
+        /* --- Shade all the clustered lights in a single pass --- */
+
+        r3d_shader_enable(screen.lightingClustered);
+        {
+            Vector2 clusterScale = {
+                (float)R3D_CLUSTER_COUNT_X / R3D.state.resolution.width,
+                (float)R3D_CLUSTER_COUNT_Y / R3D.state.resolution.height
+            };
+
+            r3d_shader_set_mat4(screen.lightingClustered, uMatInvProj, R3D.state.transform.invProj);
+            r3d_shader_set_mat4(screen.lightingClustered, uMatInvView, R3D.state.transform.invView);
+            r3d_shader_set_vec3(screen.lightingClustered, uViewPosition, R3D.state.transform.viewPos);
+            r3d_shader_set_int(screen.lightingClustered, uDirLightCount, R3D.state.lightStorage.dirLightCount);
+            r3d_shader_set_vec2(screen.lightingClustered, uClusterScale, clusterScale);
+            r3d_shader_set_vec2(screen.lightingClustered, uClusterSlice, R3D.state.lightStorage.clusterSlice);
+
+            r3d_primitive_bind_and_draw_screen();
+        }
+
+        r3d_stencil_disable();
+
+        /* --- Unbind all textures --- */
+
+        r3d_shader_unbind_sampler2D(screen.lightingClustered, uTexAlbedo);
+        r3d_shader_unbind_sampler2D(screen.lightingClustered, uTexNormal);
+        r3d_shader_unbind_sampler2D(screen.lightingClustered, uTexDepth);
+        r3d_shader_unbind_sampler2D(screen.lightingClustered, uTexORM);
+        r3d_shader_unbind_sampler2D(screen.lightingClustered, uTexLights);
+        r3d_shader_unbind_sampler2D(screen.lightingClustered, uTexClusters);
+        r3d_shader_unbind_sampler2D(screen.lightingClustered, uTexLightIndices);
     }
 }
 
@@ -1820,161 +3733,150 @@ void r3d_pass_scene_deferred(void)
     }
 }
 
-static void r3d_pass_scene_forward_filter_and_send_lights(const r3d_drawcall_t* call)
+static void r3d_pass_scene_forward_send_lights(const r3d_drawcall_t* call)
 {
+    r3d_shader_set_int(raster.forward, uLightListOffset, call->lights.offset);
+    r3d_shader_set_int(raster.forward, uLightListCount, call->lights.count);
+
+    // NOTE: The lights without shadows are read from the light storage, only the
+    //       lights casting shadows touching the call take the uniform slots
+
+    const int* shadowLights = (const int*)R3D.container.aShadowLightLists.data + call->lights.shadowOffset;
     int lightCount = 0;
 
-    for (int i = 0; lightCount < R3D_SHADER_FORWARD_NUM_LIGHTS && i < R3D.container.aLightBatch.count; i++)
+    for (int i = 0; lightCount < R3D_SHADER_FORWARD_NUM_SHADOWS && i < call->lights.shadowCount; i++)
     {
-        r3d_light_batched_t* light = r3d_array_at(&R3D.container.aLightBatch, i);
-
-        // Check if the geometry "touches" the light area
-        // It's not the most accurate possible but sufficient (?)
-        if (light->data->type != R3D_LIGHT_DIR) {
-            if (call->geometryType == R3D_DRAWCALL_GEOMETRY_MODEL) {
-                if (!CheckCollisionBoxes(light->aabb, call->geometry.model.mesh->aabb)) {
-                    continue;
-                }
-            }
-            else if (call->geometryType == R3D_DRAWCALL_GEOMETRY_SPRITE) {
-                const Vector3* quad = call->geometry.sprite.quad;
-                const BoundingBox* aabb = &light->aabb;
-                bool inside = false;
-                for (int j = 0; j < 4; ++j) {
-                    if (quad[j].x >= aabb->min.x && quad[j].x <= aabb->max.x &&
-                        quad[j].y >= aabb->min.y && quad[j].y <= aabb->max.y &&
-                        quad[j].z >= aabb->min.z && quad[j].z <= aabb->max.z) {
-                        inside = true;
-                        break;
-                    }
-                }
-                if (inside) {
-                    continue;
-                }
-            }
-        }
+        r3d_light_batched_t* light = r3d_array_at(&R3D.container.aLightBatch, shadowLights[i]);
 
-        // Use this light, so increment the counter
-        lightCount++;
+        // Use this light in the next uniform slot
+        int slot = lightCount++;
 
         // Send common data
-        r3d_shader_set_int(raster.forward, uLights[i].enabled, true);
-        r3d_shader_set_int(raster.forward, uLights[i].type, light->data->type);
-        r3d_shader_set_vec3(raster.forward, uLights[i].color, light->data->color);
-        r3d_shader_set_float(raster.forward, uLights[i].specular, light->data->specular);
-        r3d_shader_set_float(raster.forward, uLights[i].energy, light->data->energy);
+        r3d_shader_set_int(raster.forward, uLights[slot].enabled, true);
+        r3d_shader_set_int(raster.forward, uLights[slot].type, light->data->type);
+        r3d_shader_set_vec3(raster.forward, uLights[slot].color, light->data->color);
+        r3d_shader_set_float(raster.forward, uLights[slot].specular, light->data->specular);
+        r3d_shader_set_float(raster.forward, uLights[slot].energy, light->data->energy);
 
         // Send specific data
         if (light->data->type == R3D_LIGHT_DIR) {
-            r3d_shader_set_vec3(raster.forward, uLights[i].direction, light->data->direction);
+            r3d_shader_set_vec3(raster.forward, uLights[slot].direction, light->data->direction);
         }
         else if (light->data->type == R3D_LIGHT_SPOT) {
-            r3d_shader_set_vec3(raster.forward, uLights[i].position, light->data->position);
-            r3d_shader_set_vec3(raster.forward, uLights[i].direction, light->data->direction);
-            r3d_shader_set_float(raster.forward, uLights[i].range, light->data->range);
-            r3d_shader_set_float(raster.forward, uLights[i].attenuation, light->data->attenuation);
-            r3d_shader_set_float(raster.forward, uLights[i].innerCutOff, light->data->innerCutOff);
-            r3d_shader_set_float(raster.forward, uLights[i].outerCutOff, light->data->outerCutOff);
+            r3d_shader_set_vec3(raster.forward, uLights[slot].position, light->data->position);
+            r3d_shader_set_vec3(raster.forward, uLights[slot].direction, light->data->direction);
+            r3d_shader_set_float(raster.forward, uLights[slot].range, light->data->range);
+            r3d_shader_set_float(raster.forward, uLights[slot].attenuation, light->data->attenuation);
+            r3d_shader_set_float(raster.forward, uLights[slot].innerCutOff, light->data->innerCutOff);
+            r3d_shader_set_float(raster.forward, uLights[slot].outerCutOff, light->data->outerCutOff);
         }
         else if (light->data->type == R3D_LIGHT_OMNI) {
-            r3d_shader_set_vec3(raster.forward, uLights[i].position, light->data->position);
-            r3d_shader_set_float(raster.forward, uLights[i].range, light->data->range);
-            r3d_shader_set_float(raster.forward, uLights[i].attenuation, light->data->attenuation);
+            r3d_shader_set_vec3(raster.forward, uLights[slot].position, light->data->position);
+            r3d_shader_set_float(raster.forward, uLights[slot].range, light->data->range);
+            r3d_shader_set_float(raster.forward, uLights[slot].attenuation, light->data->attenuation);
         }
 
-        // Send shadow map data
-        if (light->data->shadow.enabled) {
-            if (light->data->type == R3D_LIGHT_OMNI) {
-                r3d_shader_bind_samplerCube(raster.forward, uShadowMapCube[i], light->data->shadow.map.depth);
-            }
-            else {
-                r3d_shader_set_float(raster.forward, uLights[i].shadowMapTxlSz, light->data->shadow.map.texelSize);
-                r3d_shader_bind_sampler2D(raster.forward, uShadowMap2D[i], light->data->shadow.map.depth);
-                r3d_shader_set_mat4(raster.forward, uMatLightVP[i], light->data->shadow.matVP);
+        // Send shadow map data, the lights without tiles in the atlas are lit without shadows
+        bool hasShadow = true;
+        if (light->data->type == R3D_LIGHT_OMNI) {
+            r3d_shader_bind_samplerCube(raster.forward, uShadowMapCube[slot], light->data->shadow.map.depth);
+        }
+        else if (r3d_pass_shadow_maps_has_tiles(&light->data->shadow)) {
+            r3d_shader_set_float(raster.forward, uLights[slot].shadowMapTxlSz, 1.0f / R3D.framebuffer.shadowAtlas.size);
+            r3d_shader_bind_sampler2DArray(raster.forward, uShadowMap2D[slot], R3D.framebuffer.shadowAtlas.depth);
+            r3d_shader_set_mat4(raster.forward, uMatLightVP[slot], light->data->shadow.matVP);
+            r3d_shader_set_int(raster.forward, uLights[slot].cascadeCount, light->data->shadow.map.layers);
+            for (int j = 0; j < light->data->shadow.map.layers; j++) {
+                r3d_shader_set_vec4(raster.forward, uLights[slot].cascades[j], light->data->shadow.cascades[j]);
+                r3d_shader_set_vec4(raster.forward, uLights[slot].tiles[j], r3d_pass_shadow_maps_get_tile_rect(&light->data->shadow.tiles[j]));
             }
-            r3d_shader_set_float(raster.forward, uLights[i].shadowSoftness, light->data->shadow.softness);
-            r3d_shader_set_float(raster.forward, uLights[i].shadowDepthBias, light->data->shadow.depthBias);
-            r3d_shader_set_float(raster.forward, uLights[i].shadowSlopeBias, light->data->shadow.slopeBias);
-            r3d_shader_set_float(raster.forward, uLights[i].near, light->data->near);
-            r3d_shader_set_float(raster.forward, uLights[i].far, light->data->far);
-            r3d_shader_set_int(raster.forward, uLights[i].shadow, true);
         }
         else {
-            r3d_shader_set_int(raster.forward, uLights[i].shadow, false);
+            hasShadow = false;
         }
+        r3d_shader_set_float(raster.forward, uLights[slot].shadowSoftness, light->data->shadow.softness);
+        r3d_shader_set_float(raster.forward, uLights[slot].shadowDepthBias, light->data->shadow.depthBias);
+        r3d_shader_set_float(raster.forward, uLights[slot].shadowSlopeBias, light->data->shadow.slopeBias);
+        r3d_shader_set_float(raster.forward, uLights[slot].near, light->data->near);
+        r3d_shader_set_float(raster.forward, uLights[slot].far, light->data->far);
+        r3d_shader_set_int(raster.forward, uLights[slot].shadow, hasShadow);
     }
 
-    for (int i = lightCount; i < R3D_SHADER_FORWARD_NUM_LIGHTS; i++) {
+    for (int i = lightCount; i < R3D_SHADER_FORWARD_NUM_SHADOWS; i++) {
         r3d_shader_set_int(raster.forward, uLights[i].enabled, false);
     }
 }
 
-static void r3d_pass_scene_forward_instanced_filter_and_send_lights(const r3d_drawcall_t* call)
+static void r3d_pass_scene_forward_instanced_send_lights(const r3d_drawcall_t* call)
 {
+    r3d_shader_set_int(raster.forwardInst, uLightListOffset, call->lights.offset);
+    r3d_shader_set_int(raster.forwardInst, uLightListCount, call->lights.count);
+
+    // NOTE: The lights without shadows are read from the light storage, only the
+    //       lights casting shadows touching the call take the uniform slots
+
+    const int* shadowLights = (const int*)R3D.container.aShadowLightLists.data + call->lights.shadowOffset;
     int lightCount = 0;
 
-    for (int i = 0; lightCount < R3D_SHADER_FORWARD_NUM_LIGHTS && i < R3D.container.aLightBatch.count; i++)
+    for (int i = 0; lightCount < R3D_SHADER_FORWARD_NUM_SHADOWS && i < call->lights.shadowCount; i++)
     {
-        r3d_light_batched_t* light = r3d_array_at(&R3D.container.aLightBatch, i);
-
-        // Check if the global instance AABB "touches" the light area
-        if (light->data->type != R3D_LIGHT_DIR) {
-            if (!CheckCollisionBoxes(light->aabb, call->instanced.allAabb)) {
-                continue;
-            }
-        }
+        r3d_light_batched_t* light = r3d_array_at(&R3D.container.aLightBatch, shadowLights[i]);
 
-        // Use this light, so increment the counter
-        lightCount++;
+        // Use this light in the next uniform slot
+        int slot = lightCount++;
 
         // Send common data
-        r3d_shader_set_int(raster.forwardInst, uLights[i].enabled, true);
-        r3d_shader_set_int(raster.forwardInst, uLights[i].type, light->data->type);
-        r3d_shader_set_vec3(raster.forwardInst, uLights[i].color, light->data->color);
-        r3d_shader_set_float(raster.forwardInst, uLights[i].specular, light->data->specular);
-        r3d_shader_set_float(raster.forwardInst, uLights[i].energy, light->data->energy);
+        r3d_shader_set_int(raster.forwardInst, uLights[slot].enabled, true);
+        r3d_shader_set_int(raster.forwardInst, uLights[slot].type, light->data->type);
+        r3d_shader_set_vec3(raster.forwardInst, uLights[slot].color, light->data->color);
+        r3d_shader_set_float(raster.forwardInst, uLights[slot].specular, light->data->specular);
+        r3d_shader_set_float(raster.forwardInst, uLights[slot].energy, light->data->energy);
 
         // Send specific data
         if (light->data->type == R3D_LIGHT_DIR) {
-            r3d_shader_set_vec3(raster.forwardInst, uLights[i].direction, light->data->direction);
+            r3d_shader_set_vec3(raster.forwardInst, uLights[slot].direction, light->data->direction);
         }
         else if (light->data->type == R3D_LIGHT_SPOT) {
-            r3d_shader_set_vec3(raster.forwardInst, uLights[i].position, light->data->position);
-            r3d_shader_set_vec3(raster.forwardInst, uLights[i].direction, light->data->direction);
-            r3d_shader_set_float(raster.forwardInst, uLights[i].range, light->data->range);
-            r3d_shader_set_float(raster.forwardInst, uLights[i].attenuation, light->data->attenuation);
-            r3d_shader_set_float(raster.forwardInst, uLights[i].innerCutOff, light->data->innerCutOff);
-            r3d_shader_set_float(raster.forwardInst, uLights[i].outerCutOff, light->data->outerCutOff);
+            r3d_shader_set_vec3(raster.forwardInst, uLights[slot].position, light->data->position);
+            r3d_shader_set_vec3(raster.forwardInst, uLights[slot].direction, light->data->direction);
+            r3d_shader_set_float(raster.forwardInst, uLights[slot].range, light->data->range);
+            r3d_shader_set_float(raster.forwardInst, uLights[slot].attenuation, light->data->attenuation);
+            r3d_shader_set_float(raster.forwardInst, uLights[slot].innerCutOff, light->data->innerCutOff);
+            r3d_shader_set_float(raster.forwardInst, uLights[slot].outerCutOff, light->data->outerCutOff);
         }
         else if (light->data->type == R3D_LIGHT_OMNI) {
-            r3d_shader_set_vec3(raster.forwardInst, uLights[i].position, light->data->position);
-            r3d_shader_set_float(raster.forwardInst, uLights[i].range, light->data->range);
-            r3d_shader_set_float(raster.forwardInst, uLights[i].attenuation, light->data->attenuation);
+            r3d_shader_set_vec3(raster.forwardInst, uLights[slot].position, light->data->position);
+            r3d_shader_set_float(raster.forwardInst, uLights[slot].range, light->data->range);
+            r3d_shader_set_float(raster.forwardInst, uLights[slot].attenuation, light->data->attenuation);
         }
 
-        // Send shadow map data
-        if (light->data->shadow.enabled) {
-            if (light->data->type == R3D_LIGHT_OMNI) {
-                r3d_shader_bind_samplerCube(raster.forwardInst, uShadowMapCube[i], light->data->shadow.map.depth);
-            }
-            else {
-                r3d_shader_set_float(raster.forwardInst, uLights[i].shadowMapTxlSz, light->data->shadow.map.texelSize);
-                r3d_shader_bind_sampler2D(raster.forwardInst, uShadowMap2D[i], light->data->shadow.map.depth);
-                r3d_shader_set_mat4(raster.forwardInst, uMatLightVP[i], light->data->shadow.matVP);
+        // Send shadow map data, the lights without tiles in the atlas are lit without shadows
+        bool hasShadow = true;
+        if (light->data->type == R3D_LIGHT_OMNI) {
+            r3d_shader_bind_samplerCube(raster.forwardInst, uShadowMapCube[slot], light->data->shadow.map.depth);
+        }
+        else if (r3d_pass_shadow_maps_has_tiles(&light->data->shadow)) {
+            r3d_shader_set_float(raster.forwardInst, uLights[slot].shadowMapTxlSz, 1.0f / R3D.framebuffer.shadowAtlas.size);
+            r3d_shader_bind_sampler2DArray(raster.forwardInst, uShadowMap2D[slot], R3D.framebuffer.shadowAtlas.depth);
+            r3d_shader_set_mat4(raster.forwardInst, uMatLightVP[slot], light->data->shadow.matVP);
+            r3d_shader_set_int(raster.forwardInst, uLights[slot].cascadeCount, light->data->shadow.map.layers);
+            for (int j = 0; j < light->data->shadow.map.layers; j++) {
+                r3d_shader_set_vec4(raster.forwardInst, uLights[slot].cascades[j], light->data->shadow.cascades[j]);
+                r3d_shader_set_vec4(raster.forwardInst, uLights[slot].tiles[j], r3d_pass_shadow_maps_get_tile_rect(&light->data->shadow.tiles[j]));
             }
-            r3d_shader_set_float(raster.forwardInst, uLights[i].shadowSoftness, light->data->shadow.softness);
-            r3d_shader_set_float(raster.forwardInst, uLights[i].shadowDepthBias, light->data->shadow.depthBias);
-            r3d_shader_set_float(raster.forwardInst, uLights[i].shadowSlopeBias, light->data->shadow.slopeBias);
-            r3d_shader_set_float(raster.forwardInst, uLights[i].near, light->data->near);
-            r3d_shader_set_float(raster.forwardInst, uLights[i].far, light->data->far);
-            r3d_shader_set_int(raster.forwardInst, uLights[i].shadow, true);
         }
         else {
-            r3d_shader_set_int(raster.forwardInst, uLights[i].shadow, false);
+            hasShadow = false;
         }
+        r3d_shader_set_float(raster.forwardInst, uLights[slot].shadowSoftness, light->data->shadow.softness);
+        r3d_shader_set_float(raster.forwardInst, uLights[slot].shadowDepthBias, light->data->shadow.depthBias);
+        r3d_shader_set_float(raster.forwardInst, uLights[slot].shadowSlopeBias, light->data->shadow.slopeBias);
+        r3d_shader_set_float(raster.forwardInst, uLights[slot].near, light->data->near);
+        r3d_shader_set_float(raster.forwardInst, uLights[slot].far, light->data->far);
+        r3d_shader_set_int(raster.forwardInst, uLights[slot].shadow, hasShadow);
     }
 
-    for (int i = lightCount; i < R3D_SHADER_FORWARD_NUM_LIGHTS; i++) {
+    for (int i = lightCount; i < R3D_SHADER_FORWARD_NUM_SHADOWS; i++) {
         r3d_shader_set_int(raster.forwardInst, uLights[i].enabled, false);
     }
 }
@@ -2006,7 +3908,7 @@ void r3d_pass_scene_forward_depth_prepass(void)
                 }
 
                 // NOTE: The storage texture of the matrices may have been bind during drawcalls
-                r3d_shader_unbind_sampler1D(raster.depthInst, uTexBoneMatrices);
+                r3d_shader_unbind_sampler2D(raster.depthInst, uTexBoneMatrices);
             }
             r3d_shader_disable();
         }
@@ -2019,12 +3921,12 @@ void r3d_pass_scene_forward_depth_prepass(void)
                 // We render in reverse order to prioritize drawing the nearest
                 // objects first, in order to optimize early depth testing.
                 for (int i = (int)R3D.container.aDrawForward.count - 1; i >= 0; i--) {
-                    r3d_drawcall_t* call = r3d_array_at(&R3D.container.aDrawForward, i);
+                    r3d_drawcall_t* call = r3d_get_drawcall_in_order(&R3D.container.aDrawForward, &R3D.container.aDrawForwardOrder, i);
                     r3d_drawcall_raster_depth(call, true, false, &R3D.state.transform.viewProj);
                 }
 
                 // NOTE: The storage texture of the matrices may have been bind during drawcalls
-                r3d_shader_unbind_sampler1D(raster.depth, uTexBoneMatrices);
+                r3d_shader_unbind_sampler2D(raster.depth, uTexBoneMatrices);
             }
             r3d_shader_disable();
         }
@@ -2085,9 +3987,25 @@ void r3d_pass_scene_forward(void)
 
                 r3d_shader_set_vec3(raster.forwardInst, uViewPosition, R3D.state.transform.viewPos);
 
+                r3d_shader_bind_sampler2D(raster.forwardInst, uTexLights, R3D.storage.texLights);
+                r3d_shader_bind_sampler2D(raster.forwardInst, uTexLightIndices, R3D.storage.texLightIndices);
+                r3d_shader_set_int(raster.forwardInst, uDirLightCount, R3D.state.lightStorage.dirLightCount);
+                r3d_shader_set_int(raster.forwardInst, uClustered, R3D.state.lightStorage.clustered);
+
+                if (R3D.state.lightStorage.clustered) {
+                    Vector2 clusterScale = {
+                        (float)R3D_CLUSTER_COUNT_X / R3D.state.resolution.width,
+                        (float)R3D_CLUSTER_COUNT_Y / R3D.state.resolution.height
+                    };
+                    r3d_shader_bind_sampler2D(raster.forwardInst, uTexClusters, R3D.storage.texClusters);
+                    r3d_shader_set_vec2(raster.forwardInst, uClusterScale, clusterScale);
+                    r3d_shader_set_vec2(raster.forwardInst, uClusterSlice, R3D.state.lightStorage.clusterSlice);
+                    r3d_shader_set_mat4(raster.forwardInst, uMatView, R3D.state.transform.view);
+                }
+
                 for (int i = 0; i < R3D.container.aDrawForwardInst.count; i++) {
                     r3d_drawcall_t* call = r3d_array_at(&R3D.container.aDrawForwardInst, i);
-                    r3d_pass_scene_forward_instanced_filter_and_send_lights(call);
+                    r3d_pass_scene_forward_instanced_send_lights(call);
                     r3d_drawcall_raster_forward_inst(call, &R3D.state.transform.viewProj);
                 }
 
@@ -2099,13 +4017,20 @@ void r3d_pass_scene_forward(void)
                     r3d_shader_unbind_sampler2D(raster.forwardInst, uTexBrdfLut);
                 }
 
-                for (int i = 0; i < R3D_SHADER_FORWARD_NUM_LIGHTS; i++) {
+                for (int i = 0; i < R3D_SHADER_FORWARD_NUM_SHADOWS; i++) {
                     r3d_shader_unbind_samplerCube(raster.forwardInst, uShadowMapCube[i]);
-                    r3d_shader_unbind_sampler2D(raster.forwardInst, uShadowMap2D[i]);
+                    r3d_shader_unbind_sampler2DArray(raster.forwardInst, uShadowMap2D[i]);
+                }
+
+                r3d_shader_unbind_sampler2D(raster.forwardInst, uTexLights);
+                r3d_shader_unbind_sampler2D(raster.forwardInst, uTexLightIndices);
+
+                if (R3D.state.lightStorage.clustered) {
+                    r3d_shader_unbind_sampler2D(raster.forwardInst, uTexClusters);
                 }
 
                 // NOTE: The storage texture of the matrices may have been bind during drawcalls
-                r3d_shader_unbind_sampler1D(raster.forwardInst, uTexBoneMatrices);
+                r3d_shader_unbind_sampler2D(raster.forwardInst, uTexBoneMatrices);
                 r3d_shader_unbind_sampler2D(raster.forwardInst, uTexNoise);
             }
             r3d_shader_disable();
@@ -2134,12 +4059,32 @@ void r3d_pass_scene_forward(void)
 
                 r3d_shader_set_vec3(raster.forward, uViewPosition, R3D.state.transform.viewPos);
 
+                r3d_shader_bind_sampler2D(raster.forward, uTexLights, R3D.storage.texLights);
+                r3d_shader_bind_sampler2D(raster.forward, uTexLightIndices, R3D.storage.texLightIndices);
+                r3d_shader_set_int(raster.forward, uDirLightCount, R3D.state.lightStorage.dirLightCount);
+                r3d_shader_set_int(raster.forward, uClustered, R3D.state.lightStorage.clustered);
+
+                if (R3D.state.lightStorage.clustered) {
+                    Vector2 clusterScale = {
+                        (float)R3D_CLUSTER_COUNT_X / R3D.state.resolution.width,
+                        (float)R3D_CLUSTER_COUNT_Y / R3D.state.resolution.height
+                    };
+                    r3d_shader_bind_sampler2D(raster.forward, uTexClusters, R3D.storage.texClusters);
+                    r3d_shader_set_vec2(raster.forward, uClusterScale, clusterScale);
+                    r3d_shader_set_vec2(raster.forward, uClusterSlice, R3D.state.lightStorage.clusterSlice);
+                    r3d_shader_set_mat4(raster.forward, uMatView, R3D.state.transform.view);
+                }
+
+                r3d_drawcall_bind_cache_begin();
+
                 for (int i = 0; i < R3D.container.aDrawForward.count; i++) {
-                    r3d_drawcall_t* call = r3d_array_at(&R3D.container.aDrawForward, i);
-                    r3d_pass_scene_forward_filter_and_send_lights(call);
+                    r3d_drawcall_t* call = r3d_get_drawcall_in_order(&R3D.container.aDrawForward, &R3D.container.aDrawForwardOrder, i);
+                    r3d_pass_scene_forward_send_lights(call);
                     r3d_drawcall_raster_forward(call, &R3D.state.transform.viewProj);
                 }
 
+                r3d_drawcall_bind_cache_end();
+
                 r3d_shader_unbind_sampler2D(raster.forward, uTexNoise);
 
                 if (R3D.env.useSky) {
@@ -2148,13 +4093,20 @@ void r3d_pass_scene_forward(void)
                     r3d_shader_unbind_sampler2D(raster.forward, uTexBrdfLut);
                 }
 
-                for (int i = 0; i < R3D_SHADER_FORWARD_NUM_LIGHTS; i++) {
+                for (int i = 0; i < R3D_SHADER_FORWARD_NUM_SHADOWS; i++) {
                     r3d_shader_unbind_samplerCube(raster.forward, uShadowMapCube[i]);
-                    r3d_shader_unbind_sampler2D(raster.forward, uShadowMap2D[i]);
+                    r3d_shader_unbind_sampler2DArray(raster.forward, uShadowMap2D[i]);
+                }
+
+                r3d_shader_unbind_sampler2D(raster.forward, uTexLights);
+                r3d_shader_unbind_sampler2D(raster.forward, uTexLightIndices);
+
+                if (R3D.state.lightStorage.clustered) {
+                    r3d_shader_unbind_sampler2D(raster.forward, uTexClusters);
                 }
 
                 // NOTE: The storage texture of the matrices may have been bind during drawcalls
-                r3d_shader_unbind_sampler1D(raster.forward, uTexBoneMatrices);
+                r3d_shader_unbind_sampler2D(raster.forward, uTexBoneMatrices);
                 r3d_shader_unbind_sampler2D(raster.forward, uTexNoise);
             }
             r3d_shader_disable();
@@ -255,7 +255,7 @@ void R3D_EnableShadow(R3D_Light id, int resolution)
 {
     r3d_get_and_check_light(light, id);
 
-    if (light->shadow.map.id != 0) {
+    if (light->shadow.map.resolution != 0) {
         if (resolution > 0 && light->shadow.map.resolution != resolution) {
             r3d_light_destroy_shadow_map(light);
             r3d_light_create_shadow_map(light, resolution);
@@ -290,7 +290,7 @@ bool R3D_IsShadowEnabled(R3D_Light id)
 bool R3D_HasShadowMap(R3D_Light id)
 {
     r3d_get_and_check_light(light, id, false);
-    return light->shadow.map.id != 0;
+    return light->shadow.map.resolution != 0;
 }
 
 R3D_ShadowUpdateMode R3D_GetShadowUpdateMode(R3D_Light id)
@@ -321,6 +321,10 @@ void R3D_SetShadowUpdateFrequency(R3D_Light id, int msec)
 void R3D_UpdateShadowMap(R3D_Light id)
 {
     r3d_get_and_check_light(light, id);
+
+    // NOTE: The static casters and the unchanged faces are drawn again too, in case something changed without moving
+    memset(light->shadow.staticCache, 0, sizeof(light->shadow.staticCache));
+    memset(light->shadow.faceSignatures, 0, sizeof(light->shadow.faceSignatures));
     light->shadow.updateConf.shouldUpdate = true;
 }
 
@@ -360,6 +364,50 @@ void R3D_SetShadowSlopeBias(R3D_Light id, float value)
     light->shadow.slopeBias = value;
 }
 
+int R3D_GetShadowCascadeCount(R3D_Light id)
+{
+    r3d_get_and_check_light(light, id, 0);
+    return light->shadow.cascadeCount;
+}
+
+void R3D_SetShadowCascadeCount(R3D_Light id, int count)
+{
+    r3d_get_and_check_light(light, id);
+
+    if (light->type != R3D_LIGHT_DIR) {
+        TraceLog(LOG_WARNING, "R3D: Can't set shadow cascades for light [ID %i]; only directional lights have cascades", id);
+        return;
+    }
+
+    if (count < 1) count = 1;
+    if (count > R3D_LIGHT_MAX_CASCADES) count = R3D_LIGHT_MAX_CASCADES;
+
+    if (light->shadow.cascadeCount == count) {
+        return;
+    }
+
+    light->shadow.cascadeCount = count;
+
+    // The cascades are the layers of the shadow map
+    if (light->shadow.map.resolution != 0) {
+        int resolution = light->shadow.map.resolution;
+        r3d_light_destroy_shadow_map(light);
+        r3d_light_create_shadow_map(light, resolution);
+    }
+}
+
+float R3D_GetShadowCascadeDistance(R3D_Light id)
+{
+    r3d_get_and_check_light(light, id, 0);
+    return light->shadow.cascadeDistance;
+}
+
+void R3D_SetShadowCascadeDistance(R3D_Light id, float distance)
+{
+    r3d_get_and_check_light(light, id);
+    light->shadow.cascadeDistance = distance;
+}
+
 BoundingBox R3D_GetLightBoundingBox(R3D_Light id)
 {
     r3d_get_and_check_light(light, id, (BoundingBox) { 0 });
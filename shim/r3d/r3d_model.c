@@ -1,6 +1,7 @@
 #include "r3d.h"
 
 #include "./details/r3d_primitives.h"
+#include "./details/r3d_anim_clip.h"
 #include "./details/r3d_math.h"
 #include "./r3d_state.h"
 
@@ -13,11 +14,17 @@
 #include <assimp/cimport.h>
 #include <assimp/scene.h>
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <stdatomic.h>
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <unistd.h>
+#include <fcntl.h>
 #include <float.h>
+#include <stdio.h>
 #include <time.h>
 
 /* === Public Mesh Functions === */
@@ -1741,7 +1748,6 @@ void R3D_UnloadMesh(const R3D_Mesh* mesh)
 
     RL_FREE(mesh->indices);
     RL_FREE(mesh->vertices);
-    RL_FREE(mesh->boneMatrices);
 }
 
 bool R3D_UploadMesh(R3D_Mesh* mesh, bool dynamic)
@@ -1812,6 +1818,9 @@ bool R3D_UploadMesh(R3D_Mesh* mesh, bool dynamic)
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     }
 
+    // NOTE: The omni shadow faces are only redrawn when what they contain changes
+    mesh->version++;
+
     return true;
 }
 
@@ -1850,6 +1859,11 @@ R3DAPI bool R3D_UpdateMesh(R3D_Mesh* mesh)
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     }
 
+    // NOTE: The mesh can be part of the static scene, its cached shadows are outdated.
+    //       The omni shadow faces are only redrawn when what they contain changes.
+    R3D.state.scene.staticVersion++;
+    mesh->version++;
+
     return true;
 }
 
@@ -2242,7 +2256,7 @@ static bool r3d_process_assimp_mesh(R3D_Model* model, Matrix modelMatrix, int me
 #undef CLEANUP
 }
 
-static bool r3d_process_assimp_meshes(const struct aiScene *scene, R3D_Model *model, struct aiNode *node, Matrix parentFinalTransform)
+static bool r3d_process_assimp_meshes(const struct aiScene *scene, R3D_Model *model, struct aiNode *node, Matrix parentFinalTransform, bool upload)
 {
     Matrix relativeTransform = r3d_matrix_from_ai_matrix(&node->mTransformation);
     Matrix finalTransform = r3d_matrix_multiply(&relativeTransform, &parentFinalTransform);
@@ -2257,14 +2271,14 @@ static bool r3d_process_assimp_meshes(const struct aiScene *scene, R3D_Model *mo
         if (scene->mMeshes[node->mMeshes[i]]->mNumBones != 0) {
             meshTransform = R3D_MATRIX_IDENTITY;
         }
-        if (!r3d_process_assimp_mesh(model, meshTransform, node->mMeshes[i], scene->mMeshes[node->mMeshes[i]], scene, true)) {
+        if (!r3d_process_assimp_mesh(model, meshTransform, node->mMeshes[i], scene->mMeshes[node->mMeshes[i]], scene, upload)) {
             TraceLog(LOG_ERROR, "R3D: Unable to load mesh [%d]; The model will be invalid", node->mMeshes[i]);
             return false;
         }
     }
 
     for (unsigned int i = 0; i < node->mNumChildren; i++) {
-        if(!r3d_process_assimp_meshes(scene, model, node->mChildren[i], finalTransform)) {
+        if(!r3d_process_assimp_meshes(scene, model, node->mChildren[i], finalTransform, upload)) {
             return false;
         }
     }
@@ -2272,31 +2286,148 @@ static bool r3d_process_assimp_meshes(const struct aiScene *scene, R3D_Model *mo
     return true;
 }
 
+/* === Assimp Name Lookup === */
+
+// Open addressing table mapping the names to their index, the names are not copied.
+typedef struct {
+    const char** names;         //< Name of each index
+    int* slots;                 //< Index stored in each slot, -1 if the slot is empty
+    unsigned int mask;          //< Slot count minus one, the slot count is a power of two
+    int count;
+} r3d_name_map_t;
+
+static uint32_t r3d_name_map_hash(const char* name)
+{
+    uint32_t hash = 2166136261u;
+    while (*name != '\0') {
+        hash ^= (uint8_t)*name++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static bool r3d_name_map_create(r3d_name_map_t* map, int capacity)
+{
+    unsigned int slotCount = 16;
+    while (slotCount < 2 * (unsigned int)capacity) {
+        slotCount *= 2;
+    }
+
+    map->names = RL_MALLOC((capacity > 0 ? capacity : 1) * sizeof(const char*));
+    map->slots = RL_MALLOC(slotCount * sizeof(int));
+    map->mask = slotCount - 1;
+    map->count = 0;
+
+    if (!map->names || !map->slots) {
+        RL_FREE(map->names);
+        RL_FREE(map->slots);
+        map->names = NULL;
+        map->slots = NULL;
+        return false;
+    }
+
+    memset(map->slots, 0xFF, slotCount * sizeof(int));
+
+    return true;
+}
+
+static void r3d_name_map_destroy(r3d_name_map_t* map)
+{
+    RL_FREE(map->names);
+    RL_FREE(map->slots);
+}
+
+// Returns the slot of the name, or the empty slot where it would be inserted
+static unsigned int r3d_name_map_probe(const r3d_name_map_t* map, const char* name)
+{
+    unsigned int slot = r3d_name_map_hash(name) & map->mask;
+    while (map->slots[slot] >= 0 && strcmp(map->names[map->slots[slot]], name) != 0) {
+        slot = (slot + 1) & map->mask;
+    }
+    return slot;
+}
+
+// Returns the index of the name, or -1 if it is not in the map
+static int r3d_name_map_find(const r3d_name_map_t* map, const char* name)
+{
+    return map->slots[r3d_name_map_probe(map, name)];
+}
+
+// Adds the name with the next index if it is not in the map yet, returns its index
+// NOTE: The map must have been created with enough capacity for all the names
+static int r3d_name_map_insert(r3d_name_map_t* map, const char* name)
+{
+    unsigned int slot = r3d_name_map_probe(map, name);
+    if (map->slots[slot] < 0) {
+        map->names[map->count] = name;
+        map->slots[slot] = map->count++;
+    }
+    return map->slots[slot];
+}
+
 /* === Assimp Material Processing === */
 
-static Image r3d_load_assimp_image(
-    const struct aiScene* scene, const struct aiMaterial* aiMat,
-    enum aiTextureType textureType, unsigned int index,
-    const char* basePath, bool* isAllocated)
+// Image decoded for a material map, uploaded later by the asynchronous loading
+typedef struct {
+    Image image;
+    Texture2D* target;          //< Map texture of the material receiving the upload
+} r3d_pending_texture_t;
+
+/* --- Scene images --- */
+
+// Texture types read from the materials, indexed by the image slots of a material
+enum {
+    R3D_MATERIAL_IMAGE_DIFFUSE,
+    R3D_MATERIAL_IMAGE_BASE_COLOR,
+    R3D_MATERIAL_IMAGE_NORMAL,
+    R3D_MATERIAL_IMAGE_EMISSIVE,
+    R3D_MATERIAL_IMAGE_OCCLUSION,
+    R3D_MATERIAL_IMAGE_ROUGHNESS,
+    R3D_MATERIAL_IMAGE_SHININESS,
+    R3D_MATERIAL_IMAGE_METALNESS,
+    R3D_MATERIAL_IMAGE_COUNT
+};
+
+static const enum aiTextureType R3D_MATERIAL_IMAGE_TYPES[R3D_MATERIAL_IMAGE_COUNT] = {
+    aiTextureType_DIFFUSE,
+    aiTextureType_BASE_COLOR,
+    aiTextureType_NORMALS,
+    aiTextureType_EMISSIVE,
+    aiTextureType_AMBIENT_OCCLUSION,
+    aiTextureType_DIFFUSE_ROUGHNESS,
+    aiTextureType_SHININESS,
+    aiTextureType_METALNESS
+};
+
+/*
+ * Images referenced by the materials of a scene. Each path is decoded once, whatever
+ * the number of materials using it, and all the images are decoded before the materials
+ * are built so the decoding can be spread over the job pool.
+ */
+typedef struct {
+    const struct aiScene* scene;
+    const char* basePath;
+    struct aiString* paths;         //< Path of each image, the embedded textures start with '*'
+    Image* images;                  //< Decoded images, without data if the decoding failed
+    bool* allocated;                //< False for the images pointing into the scene
+    int* materialImages;            //< [material][R3D_MATERIAL_IMAGE_COUNT] image indices, -1 without texture
+    int count;
+} r3d_scene_images_t;
+
+static Image r3d_load_assimp_image(const struct aiScene* scene, const struct aiString* texPath,
+                                   const char* basePath, bool* isAllocated)
 {
     assert(isAllocated != NULL);
 
     Image image = { 0 };
-    struct aiString texPath;
 
     *isAllocated = false;
 
-    /* --- Try to retrieve the texture path --- */
-
-    if (aiGetMaterialTexture(aiMat, textureType, index, &texPath, NULL, NULL, NULL, NULL, NULL, NULL) != AI_SUCCESS) {
-        return image; // No texture of this type
-    }
-
     /* --- Handle embedded texture (starts with '*') --- */
 
-    if (texPath.data[0] == '*')
+    if (texPath->data[0] == '*')
     {
-        int textureIndex = atoi(&texPath.data[1]);
+        int textureIndex = atoi(&texPath->data[1]);
 
         /* --- Validate embedded texture index --- */
 
@@ -2309,9 +2440,9 @@ static Image r3d_load_assimp_image(
         /* --- Handle compressed embedded texture --- */
 
         if (aiTex->mHeight == 0) {
-            image = LoadImageFromMemory(
-                TextFormat(".%s", aiTex->achFormatHint), (const unsigned char*)aiTex->pcData, aiTex->mWidth
-            );
+            char fileType[sizeof(aiTex->achFormatHint) + 1];
+            snprintf(fileType, sizeof(fileType), ".%s", aiTex->achFormatHint);
+            image = LoadImageFromMemory(fileType, (const unsigned char*)aiTex->pcData, aiTex->mWidth);
             *isAllocated = true;
         }
 
@@ -2321,8 +2452,9 @@ static Image r3d_load_assimp_image(
             image.width = aiTex->mWidth;
             image.height = aiTex->mHeight;
             image.format = RL_PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
-            // NOTE: No need to copy the data here, the image will be immediately
-            //       uploaded to the GPU without being retained afterward
+            image.mipmaps = 1;
+            // NOTE: No need to copy the data here, the scene outlives the images
+            //       and the images are copied before being kept for an upload
             image.data = (unsigned char*)aiTex->pcData;
         }
     }
@@ -2337,29 +2469,140 @@ static Image r3d_load_assimp_image(
             );
             return image;
         }
-        image = LoadImage(TextFormat("%s/%s", basePath, texPath.data));
+        // NOTE: TextFormat() is avoided here, its buffers are shared with the other threads
+        char filePath[4096];
+        snprintf(filePath, sizeof(filePath), "%s/%s", basePath, texPath->data);
+        image = LoadImage(filePath);
         *isAllocated = true;
     }
 
     return image;
 }
 
-static Texture2D r3d_load_assimp_texture(
-    const struct aiScene* scene, const struct aiMaterial* aiMat,
-    enum aiTextureType textureType, unsigned int index,
-    const char* basePath)
+static void r3d_scene_images_destroy(r3d_scene_images_t* images)
+{
+    for (int i = 0; i < images->count; i++) {
+        if (images->allocated[i] && images->images[i].data != NULL) {
+            UnloadImage(images->images[i]);
+        }
+    }
+
+    RL_FREE(images->paths);
+    RL_FREE(images->images);
+    RL_FREE(images->allocated);
+    RL_FREE(images->materialImages);
+}
+
+// Returns whether the texture of a material slot is used, the fallback slots only without their primary texture
+static bool r3d_scene_images_is_used(const struct aiMaterial* aiMat, int slot)
 {
-    Texture2D texture = { 0 };
+    switch (slot) {
+    case R3D_MATERIAL_IMAGE_BASE_COLOR:
+        return aiGetMaterialTextureCount(aiMat, aiTextureType_DIFFUSE) == 0;
+    case R3D_MATERIAL_IMAGE_SHININESS:
+        return aiGetMaterialTextureCount(aiMat, aiTextureType_DIFFUSE_ROUGHNESS) == 0;
+    default:
+        break;
+    }
+    return true;
+}
 
-    bool imgIsAllocted = false;
-    Image image = r3d_load_assimp_image(scene, aiMat, textureType, index, basePath, &imgIsAllocted);
+static bool r3d_scene_images_create(r3d_scene_images_t* images, const struct aiScene* scene, const char* basePath)
+{
+    memset(images, 0, sizeof(*images));
 
-    if (image.data == NULL) {
-        return texture;
+    images->scene = scene;
+    images->basePath = basePath;
+
+    /* --- Count the texture references to size the arrays --- */
+
+    int refCount = 0;
+    for (unsigned int i = 0; i < scene->mNumMaterials; i++) {
+        for (int j = 0; j < R3D_MATERIAL_IMAGE_COUNT; j++) {
+            if (aiGetMaterialTextureCount(scene->mMaterials[i], R3D_MATERIAL_IMAGE_TYPES[j]) > 0 &&
+                r3d_scene_images_is_used(scene->mMaterials[i], j)) {
+                refCount++;
+            }
+        }
+    }
+
+    int slotCount = (int)scene->mNumMaterials * R3D_MATERIAL_IMAGE_COUNT;
+
+    images->paths = RL_MALLOC((refCount > 0 ? refCount : 1) * sizeof(struct aiString));
+    images->materialImages = RL_MALLOC((slotCount > 0 ? slotCount : 1) * sizeof(int));
+
+    r3d_name_map_t pathMap = { 0 };
+
+    if (!images->paths || !images->materialImages || !r3d_name_map_create(&pathMap, refCount)) {
+        r3d_scene_images_destroy(images);
+        return false;
+    }
+
+    /* --- Map the references to unique paths --- */
+
+    // NOTE: The path is read into the next free entry, which is only kept if the path is new
+
+    for (unsigned int i = 0; i < scene->mNumMaterials; i++) {
+        int* materialImages = &images->materialImages[i * R3D_MATERIAL_IMAGE_COUNT];
+        for (int j = 0; j < R3D_MATERIAL_IMAGE_COUNT; j++) {
+            materialImages[j] = -1;
+            struct aiString* path = &images->paths[pathMap.count];
+            if (pathMap.count < refCount && r3d_scene_images_is_used(scene->mMaterials[i], j) &&
+                aiGetMaterialTexture(scene->mMaterials[i], R3D_MATERIAL_IMAGE_TYPES[j],
+                                     0, path, NULL, NULL, NULL, NULL, NULL, NULL) == AI_SUCCESS) {
+                materialImages[j] = r3d_name_map_insert(&pathMap, path->data);
+            }
+        }
     }
 
-    texture = LoadTextureFromImage(image);
-    if (imgIsAllocted) UnloadImage(image);
+    images->count = pathMap.count;
+    r3d_name_map_destroy(&pathMap);
+
+    /* --- Allocate the decoded images --- */
+
+    images->images = RL_CALLOC(images->count > 0 ? images->count : 1, sizeof(Image));
+    images->allocated = RL_CALLOC(images->count > 0 ? images->count : 1, sizeof(bool));
+
+    if (!images->images || !images->allocated) {
+        images->count = 0;
+        r3d_scene_images_destroy(images);
+        return false;
+    }
+
+    return true;
+}
+
+static void r3d_scene_images_job_decode(void* userData, int begin, int end)
+{
+    r3d_scene_images_t* images = userData;
+
+    for (int i = begin; i < end; i++) {
+        images->images[i] = r3d_load_assimp_image(images->scene, &images->paths[i], images->basePath, &images->allocated[i]);
+    }
+}
+
+// Returns the image index of a material slot, -1 if the material has no texture there
+static int r3d_scene_images_find(const r3d_scene_images_t* images, int material, int slot)
+{
+    return images->materialImages[material * R3D_MATERIAL_IMAGE_COUNT + slot];
+}
+
+// Returns the decoded image of a material slot, NULL if there is none or if its decoding failed
+static const Image* r3d_scene_images_get(const r3d_scene_images_t* images, int material, int slot)
+{
+    int index = r3d_scene_images_find(images, material, slot);
+    if (index < 0 || images->images[index].data == NULL) return NULL;
+    return &images->images[index];
+}
+
+/* --- Texture uploads --- */
+
+static bool r3d_upload_model_texture(Texture2D* target, Image image)
+{
+    Texture2D texture = LoadTextureFromImage(image);
+    if (texture.id == 0) {
+        return false;
+    }
 
     if (R3D.state.loading.textureFilter > TEXTURE_FILTER_BILINEAR) {
         GenTextureMipmaps(&texture);
@@ -2367,180 +2610,136 @@ static Texture2D r3d_load_assimp_texture(
 
     SetTextureFilter(texture, R3D.state.loading.textureFilter);
 
-    return texture;
-}
+    *target = texture;
 
-/* --- Main ORM texture loading function --- */
+    return true;
+}
 
-static Texture2D r3d_load_assimp_orm_texture(
-    const struct aiScene* scene, const struct aiMaterial* aiMat, const char* basePath,
-    bool* hasOcclusion, bool* hasRoughness, bool* hasMetalness)
+static bool r3d_set_model_texture(Texture2D* target, Image image, bool isAllocated, r3d_array_t* pendingTextures)
 {
-#define PATHS_EQUAL(a, b) (strcmp((a).data, (b).data) == 0)
-#define HAS_TEXTURE_DATA(comp) ((comp).image.data != NULL)
-#define IS_SHININESS_TYPE(comp) ((comp).type == aiTextureType_SHININESS)
-
-    Texture2D ormTexture = { 0 };
+    // NOTE: Without pending array the texture is uploaded immediately, otherwise the image is kept
+    //       until the upload and the target keeps its default texture until then. The images which
+    //       point into the scene are copied, the scene is released before the upload.
 
-    /* --- Init output values --- */
+    if (image.data == NULL) {
+        return false;
+    }
 
-    *hasOcclusion = false;
-    *hasRoughness = false;
-    *hasMetalness = false;
+    if (pendingTextures == NULL) {
+        bool success = r3d_upload_model_texture(target, image);
+        if (isAllocated) UnloadImage(image);
+        return success;
+    }
 
-    /* --- Texture component structure --- */
-    
-    typedef struct {
-        Image image;
-        bool isAllocated;
-        enum aiTextureType type;
-        struct aiString texPath;
-        bool hasTexture;
-    } TextureComponent;
-
-    TextureComponent components[3] = {
-        { {0}, false, aiTextureType_AMBIENT_OCCLUSION, {0}, false },
-        { {0}, false, aiTextureType_DIFFUSE_ROUGHNESS, {0}, false },
-        { {0}, false, aiTextureType_METALNESS, {0}, false }
+    r3d_pending_texture_t pending = {
+        .image = isAllocated ? image : ImageCopy(image),
+        .target = target
     };
 
-    /* --- Initialize texture availability --- */
-    
-    *hasOcclusion = components[0].hasTexture = (aiGetMaterialTexture(aiMat, components[0].type, 0, &components[0].texPath, NULL, NULL, NULL, NULL, NULL, NULL) == AI_SUCCESS);
-    *hasRoughness = components[1].hasTexture = (aiGetMaterialTexture(aiMat, components[1].type, 0, &components[1].texPath, NULL, NULL, NULL, NULL, NULL, NULL) == AI_SUCCESS);
-    
-    // Fallback to shininess for roughness if not available
-    if (!components[1].hasTexture) {
-        *hasRoughness = components[1].hasTexture = (aiGetMaterialTexture(aiMat, aiTextureType_SHININESS, 0, &components[1].texPath, NULL, NULL, NULL, NULL, NULL, NULL) == AI_SUCCESS);
-        if (components[1].hasTexture) components[1].type = aiTextureType_SHININESS;
+    if (pending.image.data == NULL || !r3d_array_push_back(pendingTextures, &pending)) {
+        TraceLog(LOG_ERROR, "R3D: Unable to queue a model texture for upload");
+        UnloadImage(pending.image);
+        return false;
     }
-    
-    *hasMetalness = components[2].hasTexture = (aiGetMaterialTexture(aiMat, components[2].type, 0, &components[2].texPath, NULL, NULL, NULL, NULL, NULL, NULL) == AI_SUCCESS);
 
-    /* --- Analyze texture sharing patterns --- */
-    
-    bool allTexturesSame = false, twoTexturesSame = false;
-    int sharedTextureIndex = -1;
+    return true;
+}
 
-    if (components[0].hasTexture && components[1].hasTexture && components[2].hasTexture) {
-        if (PATHS_EQUAL(components[0].texPath, components[1].texPath) && 
-            PATHS_EQUAL(components[1].texPath, components[2].texPath)) {
-            allTexturesSame = true;
-            sharedTextureIndex = 0;
-        }
-        else if (PATHS_EQUAL(components[0].texPath, components[1].texPath) || 
-                 PATHS_EQUAL(components[0].texPath, components[2].texPath)) {
-            twoTexturesSame = true;
-            sharedTextureIndex = 0;
-        }
-        else if (PATHS_EQUAL(components[1].texPath, components[2].texPath)) {
-            twoTexturesSame = true;
-            sharedTextureIndex = 1;
-        }
+static bool r3d_load_assimp_texture(const r3d_scene_images_t* images, int material, int slot,
+                                    Texture2D* target, r3d_array_t* pendingTextures)
+{
+    const Image* image = r3d_scene_images_get(images, material, slot);
+    if (image == NULL) {
+        return false;
     }
 
-    /* --- Handle case where all textures are identical --- */
-    
-    if (allTexturesSame)
-    {
-        components[0].image = r3d_load_assimp_image(scene, aiMat, components[0].type, 0, basePath, &components[0].isAllocated);
+    // NOTE: The scene images are shared by the materials, they are released with the scene images
+    return r3d_set_model_texture(target, *image, false, pendingTextures);
+}
 
-        if (HAS_TEXTURE_DATA(components[0]))
-        {
-            // Convert to RGB format if necessary
-            if (components[0].image.format != RL_PIXELFORMAT_UNCOMPRESSED_R8G8B8) {
-                ImageFormat(&components[0].image, RL_PIXELFORMAT_UNCOMPRESSED_R8G8B8);
-            }
+/* --- Main ORM texture loading function --- */
 
-            // In such cases, there should be no shininess as roughness.
-            //if (IS_SHININESS_TYPE(components[1])) {
-            //    ImageColorInvertGreen(&components[0].image);
-            //}
+static bool r3d_load_assimp_orm_texture(
+    const r3d_scene_images_t* images, int material,
+    Texture2D* target, r3d_array_t* pendingTextures,
+    bool* hasOcclusion, bool* hasRoughness, bool* hasMetalness)
+{
+    bool success = false;
 
-            ormTexture = LoadTextureFromImage(components[0].image);
+    /* --- Find the component images --- */
 
-            // Apply texture filtering
-            if (R3D.state.loading.textureFilter > TEXTURE_FILTER_BILINEAR) {
-                GenTextureMipmaps(&ormTexture);
-            }
-            SetTextureFilter(ormTexture, R3D.state.loading.textureFilter);
+    int indices[3] = {
+        r3d_scene_images_find(images, material, R3D_MATERIAL_IMAGE_OCCLUSION),
+        r3d_scene_images_find(images, material, R3D_MATERIAL_IMAGE_ROUGHNESS),
+        r3d_scene_images_find(images, material, R3D_MATERIAL_IMAGE_METALNESS)
+    };
 
-            // Cleanup and return
-            if (components[0].isAllocated) {
-                UnloadImage(components[0].image);
-            }
-            return ormTexture;
-        }
+    // Fallback to shininess for roughness if not available
+    bool invertRoughness = false;
+    if (indices[1] < 0) {
+        indices[1] = r3d_scene_images_find(images, material, R3D_MATERIAL_IMAGE_SHININESS);
+        invertRoughness = (indices[1] >= 0);
     }
 
-    /* --- Load individual texture components --- */
-    
-    // Load occlusion texture
-    if (components[0].hasTexture) {
-        components[0].image = r3d_load_assimp_image(scene, aiMat, components[0].type, 0, basePath, &components[0].isAllocated);
-    }
-    
-    // Load roughness texture with sharing
-    if (components[1].hasTexture) {
-        if (twoTexturesSame && sharedTextureIndex == 0 && PATHS_EQUAL(components[0].texPath, components[1].texPath)) {
-            components[1].image = components[0].image;
-            components[1].isAllocated = false;
-        } else {
-            components[1].image = r3d_load_assimp_image(scene, aiMat, components[1].type, 0, basePath, &components[1].isAllocated);
-            if (HAS_TEXTURE_DATA(components[1]) && IS_SHININESS_TYPE(components[1])) {
-                ImageColorInvert(&components[1].image);
-            }
-        }
-    }
-    
-    // Load metalness texture with sharing
-    if (components[2].hasTexture) {
-        bool shouldLoadNew = true;
-        
-        if (twoTexturesSame) {
-            if (sharedTextureIndex == 0 && PATHS_EQUAL(components[0].texPath, components[2].texPath)) {
-                components[2].image = components[0].image;
-                components[2].isAllocated = false;
-                shouldLoadNew = false;
-            } else if (sharedTextureIndex == 1 && PATHS_EQUAL(components[1].texPath, components[2].texPath)) {
-                components[2].image = components[1].image;
-                components[2].isAllocated = false;
-                shouldLoadNew = false;
-            }
+    *hasOcclusion = (indices[0] >= 0);
+    *hasRoughness = (indices[1] >= 0);
+    *hasMetalness = (indices[2] >= 0);
+
+    /* --- Handle case where all textures are identical --- */
+
+    // NOTE: The texture is already packed, in such cases there should be no shininess as roughness
+    if (indices[0] >= 0 && indices[0] == indices[1] && indices[1] == indices[2])
+    {
+        Image image = images->images[indices[0]];
+        if (image.data == NULL) {
+            return false;
         }
-        
-        if (shouldLoadNew) {
-            components[2].image = r3d_load_assimp_image(scene, aiMat, components[2].type, 0, basePath, &components[2].isAllocated);
+
+        if (image.format == RL_PIXELFORMAT_UNCOMPRESSED_R8G8B8) {
+            return r3d_set_model_texture(target, image, false, pendingTextures);
         }
+
+        // Convert to RGB format, on a copy as the scene image can be used by other materials
+        image = ImageCopy(image);
+        ImageFormat(&image, RL_PIXELFORMAT_UNCOMPRESSED_R8G8B8);
+
+        return r3d_set_model_texture(target, image, true, pendingTextures);
     }
 
-    /* --- Validate at least one component is available --- */
-    
-    bool hasAnyTexture = HAS_TEXTURE_DATA(components[0]) || HAS_TEXTURE_DATA(components[1]) || HAS_TEXTURE_DATA(components[2]);
-    if (!hasAnyTexture) goto cleanup;
+    /* --- Gather the decoded components --- */
+
+    Image components[3] = { 0 };
+    bool isCopy[3] = { false };
 
-    /* --- Determine reference dimensions --- */
-    
     int refWidth = 0, refHeight = 0;
     for (int i = 0; i < 3; i++) {
-        if (HAS_TEXTURE_DATA(components[i])) {
-            refWidth = components[i].image.width;
-            refHeight = components[i].image.height;
-            break;
+        if (indices[i] >= 0 && images->images[indices[i]].data != NULL) {
+            components[i] = images->images[indices[i]];
+            if (refWidth == 0) {
+                refWidth = components[i].width;
+                refHeight = components[i].height;
+            }
         }
     }
 
+    /* --- Validate at least one component is available --- */
+
+    if (refWidth == 0 || refHeight == 0) {
+        return false;
+    }
+
     /* --- Resize components to match reference dimensions --- */
-    
+
     for (int i = 0; i < 3; i++) {
-        if (HAS_TEXTURE_DATA(components[i]) && components[i].isAllocated &&
-            (components[i].image.width != refWidth || components[i].image.height != refHeight)) {
-            ImageResize(&components[i].image, refWidth, refHeight);
+        if (components[i].data != NULL && (components[i].width != refWidth || components[i].height != refHeight)) {
+            components[i] = ImageCopy(components[i]);
+            ImageResize(&components[i], refWidth, refHeight);
+            isCopy[i] = true;
         }
     }
 
     /* --- Create combined ORM texture --- */
-    
+
     Image ormImage = {
         .data = RL_MALLOC(refWidth * refHeight * 3 * sizeof(uint8_t)),
         .format = RL_PIXELFORMAT_UNCOMPRESSED_R8G8B8,
@@ -2552,19 +2751,20 @@ static Texture2D r3d_load_assimp_orm_texture(
     if (!ormImage.data) goto cleanup;
 
     /* --- Pack ORM channels into final image --- */
-    
+
     uint8_t* ormData = (uint8_t*)ormImage.data;
     const size_t pixelCount = refWidth * refHeight;
-    
+
     for (size_t i = 0; i < pixelCount; i++)
     {
         const int x = i % refWidth;
         const int y = i / refWidth;
 
-        // Extract channels with default values
-        const uint8_t O = HAS_TEXTURE_DATA(components[0]) ? GetImageColor(components[0].image, x, y).r : 255;
-        const uint8_t R = HAS_TEXTURE_DATA(components[1]) ? GetImageColor(components[1].image, x, y).g : 255;
-        const uint8_t M = HAS_TEXTURE_DATA(components[2]) ? GetImageColor(components[2].image, x, y).b : 255;
+        // Extract channels with default values, the shininess is inverted into a roughness
+        const uint8_t O = components[0].data ? GetImageColor(components[0], x, y).r : 255;
+        const uint8_t G = components[1].data ? GetImageColor(components[1], x, y).g : 255;
+        const uint8_t R = (components[1].data && invertRoughness) ? 255 - G : G;
+        const uint8_t M = components[2].data ? GetImageColor(components[2], x, y).b : 255;
 
         // Pack into RGB: Red=Occlusion, Green=Roughness, Blue=Metalness
         ormData[i * 3 + 0] = O;
@@ -2572,33 +2772,22 @@ static Texture2D r3d_load_assimp_orm_texture(
         ormData[i * 3 + 2] = M;
     }
 
-    /* --- Generate final texture with filtering --- */
-    
-    ormTexture = LoadTextureFromImage(ormImage);
-    UnloadImage(ormImage);
+    /* --- Upload or queue the final texture --- */
 
-    if (R3D.state.loading.textureFilter > TEXTURE_FILTER_BILINEAR) {
-        GenTextureMipmaps(&ormTexture);
-    }
-    SetTextureFilter(ormTexture, R3D.state.loading.textureFilter);
+    success = r3d_set_model_texture(target, ormImage, true, pendingTextures);
 
 cleanup:
-    /* --- Cleanup allocated texture components --- */
+    /* --- Cleanup the resized components --- */
 
     for (int i = 0; i < 3; i++) {
-        if (components[i].isAllocated && HAS_TEXTURE_DATA(components[i])) {
-            UnloadImage(components[i].image);
-        }
+        if (isCopy[i]) UnloadImage(components[i]);
     }
 
-    return ormTexture;
-
-#undef PATHS_EQUAL
-#undef HAS_TEXTURE_DATA
-#undef IS_SHININESS_TYPE
+    return success;
 }
 
-bool process_assimp_materials(const struct aiScene* scene, R3D_Material** materials, int* materialCount, const char* modelPath)
+bool process_assimp_materials(const struct aiScene* scene, R3D_Material** materials, int* materialCount,
+                              const char* modelPath, r3d_array_t* pendingTextures)
 {
     /* --- Allocate material array --- */
 
@@ -2609,12 +2798,36 @@ bool process_assimp_materials(const struct aiScene* scene, R3D_Material** materi
         return false;
     }
 
+    // NOTE: GetDirectoryPath() is avoided, its buffer is shared with the other threads
+
+    char basePathBuffer[4096];
     const char* basePath = NULL;
 
     if (modelPath != NULL) {
-        basePath = GetDirectoryPath(modelPath);
+        snprintf(basePathBuffer, sizeof(basePathBuffer), "%s", modelPath);
+        char* separator = strrchr(basePathBuffer, '/');
+        char* backslash = strrchr(basePathBuffer, '\\');
+        if (backslash > separator) separator = backslash;
+        if (separator == NULL) snprintf(basePathBuffer, sizeof(basePathBuffer), ".");
+        else if (separator == basePathBuffer) separator[1] = '\0';
+        else separator[0] = '\0';
+        basePath = basePathBuffer;
+    }
+
+    /* --- Decode the images of the scene --- */
+
+    r3d_scene_images_t images = { 0 };
+    if (!r3d_scene_images_create(&images, scene, basePath)) {
+        TraceLog(LOG_ERROR, "R3D: Unable to allocate memory for the material images");
+        RL_FREE(*materials);
+        *materials = NULL;
+        return false;
     }
 
+    // NOTE: The asynchronous loads already run on a loading thread, the job pool is only used from the main thread
+    r3d_job_pool_parallel_for((pendingTextures == NULL) ? R3D.jobs.loading : NULL,
+                              images.count, 1, r3d_scene_images_job_decode, &images);
+
     /* --- Process each material --- */
 
     for (size_t i = 0; i < *materialCount; i++) {
@@ -2648,22 +2861,15 @@ bool process_assimp_materials(const struct aiScene* scene, R3D_Material** materi
 
         /* --- Load albedo texture --- */
 
-        mat->albedo.texture = r3d_load_assimp_texture(scene, aiMat, aiTextureType_DIFFUSE, 0, basePath);
+        // NOTE: The maps keep the default textures of the material when they have no texture
 
-        if (mat->albedo.texture.id == 0) {
-            mat->albedo.texture = r3d_load_assimp_texture(scene, aiMat, aiTextureType_BASE_COLOR, 0, basePath);
-        }
-
-        if (mat->albedo.texture.id == 0) {
-            mat->albedo.texture = R3D_GetWhiteTexture();
+        if (!r3d_load_assimp_texture(&images, i, R3D_MATERIAL_IMAGE_DIFFUSE, &mat->albedo.texture, pendingTextures)) {
+            (void)r3d_load_assimp_texture(&images, i, R3D_MATERIAL_IMAGE_BASE_COLOR, &mat->albedo.texture, pendingTextures);
         }
 
         /* --- Load normal map --- */
 
-        mat->normal.texture = r3d_load_assimp_texture(scene, aiMat, aiTextureType_NORMALS, 0, basePath);
-        if (mat->normal.texture.id == 0) {
-            mat->normal.texture = R3D_GetNormalTexture();
-        }
+        (void)r3d_load_assimp_texture(&images, i, R3D_MATERIAL_IMAGE_NORMAL, &mat->normal.texture, pendingTextures);
 
         /* --- Load emission map --- */
 
@@ -2673,9 +2879,9 @@ bool process_assimp_materials(const struct aiScene* scene, R3D_Material** materi
             mat->emission.energy = 1.0f;
         }
 
-        mat->emission.texture = r3d_load_assimp_texture(scene, aiMat, aiTextureType_EMISSIVE, 0, basePath);
-        if (mat->emission.texture.id == 0) mat->emission.texture = R3D_GetWhiteTexture();
-        else mat->emission.energy = 1.0f; //< Success
+        if (r3d_load_assimp_texture(&images, i, R3D_MATERIAL_IMAGE_EMISSIVE, &mat->emission.texture, pendingTextures)) {
+            mat->emission.energy = 1.0f; //< Success
+        }
 
         /* --- Load ORM map --- */
 
@@ -2683,17 +2889,14 @@ bool process_assimp_materials(const struct aiScene* scene, R3D_Material** materi
         bool hasRoughness = false;
         bool hasMetalness = false;
 
-        mat->orm.texture = r3d_load_assimp_orm_texture(
-            scene, aiMat, basePath,
+        (void)r3d_load_assimp_orm_texture(
+            &images, i,
+            &mat->orm.texture, pendingTextures,
             &hasOcclusion,
             &hasRoughness,
             &hasMetalness
         );
 
-        if (mat->orm.texture.id == 0) {
-            mat->orm.texture = R3D_GetWhiteTexture();
-        }
-
         if (aiGetMaterialFloat(aiMat, AI_MATKEY_ROUGHNESS_FACTOR, &mat->orm.roughness) != AI_SUCCESS) {
             mat->orm.roughness = 1.0f;
         }
@@ -2755,24 +2958,40 @@ bool process_assimp_materials(const struct aiScene* scene, R3D_Material** materi
         }
     }
 
+    r3d_scene_images_destroy(&images);
+
     return true;
 }
 
 /* === Assimp Bones / Bind Poses Processing === */
 
-// Finds a bone's index by name. Returns -1 if not found.
-static int find_bone_index(const char* name, BoneInfo* bones, int count)
+// Collects the unique bones of all the meshes, in order of appearance.
+// The index of each bone in the map is its index in the model and in its animations.
+static bool r3d_collect_unique_bones(const struct aiScene* scene, r3d_name_map_t* boneMap)
 {
-    for (int i = 0; i < count; i++) {
-        if (strcmp(name, bones[i].name) == 0) return i;
+    int maxPossibleBones = 0;
+    for (unsigned int i = 0; i < scene->mNumMeshes; i++) {
+        maxPossibleBones += scene->mMeshes[i]->mNumBones;
+    }
+
+    if (!r3d_name_map_create(boneMap, maxPossibleBones)) {
+        return false;
     }
-    return -1;
+
+    for (unsigned int m = 0; m < scene->mNumMeshes; m++) {
+        const struct aiMesh* mesh = scene->mMeshes[m];
+        for (unsigned int b = 0; b < mesh->mNumBones; b++) {
+            r3d_name_map_insert(boneMap, mesh->mBones[b]->mName.data);
+        }
+    }
+
+    return true;
 }
 
 // Recursively builds the bone hierarchy using the final bone array.
-static void build_hierarchy_recursive(const struct aiNode* node, BoneInfo* bones, int boneCount, int parentIndex)
+static void build_hierarchy_recursive(const struct aiNode* node, BoneInfo* bones, const r3d_name_map_t* boneMap, int parentIndex)
 {
-    int currentIndex = find_bone_index(node->mName.data, bones, boneCount);
+    int currentIndex = r3d_name_map_find(boneMap, node->mName.data);
 
     if (currentIndex != -1) {
         bones[currentIndex].parent = parentIndex;
@@ -2780,7 +2999,7 @@ static void build_hierarchy_recursive(const struct aiNode* node, BoneInfo* bones
     }
 
     for (unsigned int i = 0; i < node->mNumChildren; i++) {
-        build_hierarchy_recursive(node->mChildren[i], bones, boneCount, parentIndex);
+        build_hierarchy_recursive(node->mChildren[i], bones, boneMap, parentIndex);
     }
 }
 
@@ -2791,17 +3010,12 @@ bool r3d_process_bones_and_offsets(R3D_Model* model, const struct aiScene* scene
         return false;
     }
 
-    /* --- Pre-allocates bone matrices cache for each mesh and computes the model's maximum possible bones --- */
+    /* --- Counts the bones of each mesh and computes the model's maximum possible bones --- */
 
     int maxPossibleBones = 0;
     for (unsigned int i = 0; i < scene->mNumMeshes; i++) {
         int meshNumBones = scene->mMeshes[i]->mNumBones;
         if (meshNumBones > 0) {
-            if (meshNumBones > R3D_STORAGE_MATRIX_CAPACITY) {
-                TraceLog(LOG_WARNING, "R3D: Bone count (%i / %i) exceeded for mesh (IDX %i), animations may be incorrect", meshNumBones, R3D_STORAGE_MATRIX_CAPACITY, i);
-                meshNumBones = R3D_STORAGE_MATRIX_CAPACITY; //< Clamp also for 'maxPossibleBones' is incorrect, yes, but at this point, it will be anyway...
-            }
-            model->meshes[i].boneMatrices = RL_MALLOC(meshNumBones * sizeof(Matrix));
             model->meshes[i].boneCount = meshNumBones;
             maxPossibleBones += meshNumBones;
         }
@@ -2816,10 +3030,21 @@ bool r3d_process_bones_and_offsets(R3D_Model* model, const struct aiScene* scene
         return true;
     }
 
-    /* --- Pre-allocation of the maximum possible number of bones and offsets before processing --- */
+    /* --- Find the unique bones --- */
+
+    r3d_name_map_t boneMap;
+    if (!r3d_collect_unique_bones(scene, &boneMap)) {
+        TraceLog(LOG_ERROR, "R3D: Failed to allocate memory for model bones and offsets");
+        model->boneCount = 0;
+        return false;
+    }
+
+    int uniqueBoneCount = boneMap.count;
+
+    /* --- Allocation of the bones and offsets --- */
 
-    model->boneOffsets = (Matrix*)RL_MALLOC(maxPossibleBones * sizeof(Matrix));
-    model->bones = (BoneInfo*)RL_MALLOC(maxPossibleBones * sizeof(BoneInfo));
+    model->boneOffsets = (Matrix*)RL_MALLOC(uniqueBoneCount * sizeof(Matrix));
+    model->bones = (BoneInfo*)RL_MALLOC(uniqueBoneCount * sizeof(BoneInfo));
 
     if (!model->boneOffsets || !model->bones) {
         TraceLog(LOG_ERROR, "R3D: Failed to allocate memory for model bones and offsets");
@@ -2828,86 +3053,108 @@ bool r3d_process_bones_and_offsets(R3D_Model* model, const struct aiScene* scene
         model->boneOffsets = NULL;
         model->bones = NULL;
         model->boneCount = 0;
+        r3d_name_map_destroy(&boneMap);
         return false;
     }
 
-    /* --- Collect unique bones and their offset matrices directly into the model's arrays. --- */
+    /* --- Fill the bones and their offset matrices, the first occurrence of each bone is used --- */
 
-    int uniqueBoneCount = 0;
     for (unsigned int m = 0; m < scene->mNumMeshes; m++) {
         const struct aiMesh* mesh = scene->mMeshes[m];
         for (unsigned int b = 0; b < mesh->mNumBones; b++) {
-            const struct aiBone* bone = mesh->mBones[b]; // Add bone if it's unique.
-            if (find_bone_index(bone->mName.data, model->bones, uniqueBoneCount) == -1) {
-                model->boneOffsets[uniqueBoneCount] = r3d_matrix_from_ai_matrix(&bone->mOffsetMatrix);
-                strncpy(model->bones[uniqueBoneCount].name, bone->mName.data, 31);
-                model->bones[uniqueBoneCount].name[31] = '\0';
-                model->bones[uniqueBoneCount].parent = -1;
-                uniqueBoneCount++;
+            const struct aiBone* bone = mesh->mBones[b];
+            int index = r3d_name_map_find(&boneMap, bone->mName.data);
+            if (boneMap.names[index] == bone->mName.data) {
+                model->boneOffsets[index] = r3d_matrix_from_ai_matrix(&bone->mOffsetMatrix);
+                strncpy(model->bones[index].name, bone->mName.data, 31);
+                model->bones[index].name[31] = '\0';
+                model->bones[index].parent = -1;
             }
         }
     }
 
-    model->boneCount = uniqueBoneCount; //< Update the actual number of unique bones.
-
-    /* --- Attempts to reduce the size of the bone and offset buffers to the size actually occupied --- */
-
-    if (uniqueBoneCount < maxPossibleBones) {
-        void* boneOffsets = RL_REALLOC(model->boneOffsets, uniqueBoneCount * sizeof(Matrix));
-        void* bones = RL_REALLOC(model->bones, uniqueBoneCount * sizeof(BoneInfo));
-        if (boneOffsets) model->boneOffsets = boneOffsets;
-        if (bones) model->bones = bones;
-    }
+    model->boneCount = uniqueBoneCount;
 
     /* --- Build the bone hierarchy by traversing the Assimp scene graph --- */
 
-    build_hierarchy_recursive(scene->mRootNode, model->bones, model->boneCount, -1);
+    build_hierarchy_recursive(scene->mRootNode, model->bones, &boneMap, -1);
+
+    r3d_name_map_destroy(&boneMap);
 
     return true;
 }
 
 /* === Assimp Animation Processing === */
 
-Vector3 r3d_interpolate_animation_keys_vec3(const struct aiVectorKey* keys, unsigned int numKeys, float time)
+// Returns the index of the key starting the segment that contains 'time', in [0, numKeys - 2].
+// The cursor holds the result of the previous search on the same keys, the frames being sampled
+// in order it is usually already the right key or the one before, otherwise a binary search is done.
+static unsigned int r3d_find_animation_key(const void* keys, size_t stride, unsigned int numKeys, double time, unsigned int* cursor)
+{
+    #define R3D_KEY_TIME(i) (*(const double*)((const char*)keys + (size_t)(i) * stride))
+
+    unsigned int last = numKeys - 2;
+    unsigned int index = (cursor != NULL && *cursor <= last) ? *cursor : 0;
+
+    if (cursor != NULL && R3D_KEY_TIME(index) <= time) {
+        if (index < last && R3D_KEY_TIME(index + 1) <= time) index++;
+        if (index < last && R3D_KEY_TIME(index + 1) <= time) index = last + 1;
+    }
+    else {
+        index = last + 1;
+    }
+
+    if (index > last) {
+        unsigned int lo = 0, hi = last;
+        while (lo < hi) {
+            unsigned int mid = (lo + hi + 1) / 2;
+            if (R3D_KEY_TIME(mid) <= time) lo = mid;
+            else hi = mid - 1;
+        }
+        index = lo;
+    }
+
+    if (cursor != NULL) {
+        *cursor = index;
+    }
+
+    return index;
+
+    #undef R3D_KEY_TIME
+}
+
+Vector3 r3d_interpolate_animation_keys_vec3(const struct aiVectorKey* keys, unsigned int numKeys, float time, unsigned int* cursor)
 {
-    /* --- Case where there is only one key --- */
+    /* --- Clamp to the first and last keys --- */
 
-    if (numKeys == 1) {
+    if (numKeys == 1 || time <= keys[0].mTime) {
         return (Vector3){
             keys[0].mValue.x,
             keys[0].mValue.y,
             keys[0].mValue.z
         };
     }
-    
-    /* --- Find surrounding keys --- */
-
-    unsigned int index = 0;
-    for (unsigned int i = 0; i < numKeys - 1; i++) {
-        if (time < keys[i + 1].mTime) {
-            index = i;
-            break;
-        }
-    }
-    
-    /* --- Clamp to last key --- */
 
-    if (index >= numKeys - 1) {
+    if (time >= keys[numKeys - 1].mTime) {
         return (Vector3){
             keys[numKeys - 1].mValue.x,
             keys[numKeys - 1].mValue.y,
             keys[numKeys - 1].mValue.z
         };
     }
-    
+
+    /* --- Find surrounding keys --- */
+
+    unsigned int index = r3d_find_animation_key(keys, sizeof(*keys), numKeys, time, cursor);
+
     /* --- Linear interpolation between the two surrounding keyframes --- */
 
     float deltaTime = keys[index + 1].mTime - keys[index].mTime;
-    float factor = (time - keys[index].mTime) / deltaTime;
-    
+    float factor = (deltaTime > 0.0f) ? (time - keys[index].mTime) / deltaTime : 0.0f;
+
     Vector3 pos1 = {keys[index].mValue.x, keys[index].mValue.y, keys[index].mValue.z};
     Vector3 pos2 = {keys[index + 1].mValue.x, keys[index + 1].mValue.y, keys[index + 1].mValue.z};
-    
+
     return (Vector3){
         pos1.x + factor * (pos2.x - pos1.x),
         pos1.y + factor * (pos2.y - pos1.y),
@@ -2915,296 +3162,625 @@ Vector3 r3d_interpolate_animation_keys_vec3(const struct aiVectorKey* keys, unsi
     };
 }
 
-Quaternion r3d_interpolate_animation_keys_quat(const struct aiQuatKey* keys, unsigned int numKeys, float time)
+Quaternion r3d_interpolate_animation_keys_quat(const struct aiQuatKey* keys, unsigned int numKeys, float time, unsigned int* cursor)
 {
-    /* --- Case where there is only one key --- */
+    /* --- Clamp to the first and last keys --- */
 
-    if (numKeys == 1) {
+    if (numKeys == 1 || time <= keys[0].mTime) {
         return (Quaternion){
             keys[0].mValue.x, keys[0].mValue.y,
             keys[0].mValue.z, keys[0].mValue.w
         };
     }
-    
-    /* --- Find surrounding keys --- */
-
-    unsigned int index = 0;
-    for (unsigned int i = 0; i < numKeys - 1; i++) {
-        if (time < keys[i + 1].mTime) {
-            index = i;
-            break;
-        }
-    }
-    
-    /* --- Clamp to last key --- */
 
-    if (index >= numKeys - 1) {
+    if (time >= keys[numKeys - 1].mTime) {
         return (Quaternion){
-            keys[numKeys - 1].mValue.x, keys[numKeys - 1].mValue.y, 
+            keys[numKeys - 1].mValue.x, keys[numKeys - 1].mValue.y,
             keys[numKeys - 1].mValue.z, keys[numKeys - 1].mValue.w
         };
     }
-    
+
+    /* --- Find surrounding keys --- */
+
+    unsigned int index = r3d_find_animation_key(keys, sizeof(*keys), numKeys, time, cursor);
+
     /* --- Spherical interpolation (SLERP) between the two surrounding keyframes --- */
 
     float deltaTime = keys[index + 1].mTime - keys[index].mTime;
-    float factor = (time - keys[index].mTime) / deltaTime;
-    
+    float factor = (deltaTime > 0.0f) ? (time - keys[index].mTime) / deltaTime : 0.0f;
+
     Quaternion q1 = {
         keys[index].mValue.x,
         keys[index].mValue.y,
         keys[index].mValue.z,
         keys[index].mValue.w
     };
-    
+
     Quaternion q2 = {
         keys[index + 1].mValue.x,
         keys[index + 1].mValue.y,
         keys[index + 1].mValue.z,
         keys[index + 1].mValue.w
     };
-    
+
     return QuaternionSlerp(q1, q2, factor);
 }
 
-bool r3d_get_node_transform_at_time(Matrix* outMatrix, const struct aiAnimation* aiAnim, const char* nodeName, float time)
+/*
+ * Nodes leading to a bone, flattened in hierarchy order (parents first) with their
+ * bone index and animation channel, so that each frame is computed with a single loop
+ * over the nodes instead of name lookups.
+ */
+typedef struct {
+    const struct aiNode** nodes;
+    const struct aiNodeAnim** channels;     //< Channel animating each node, NULL if the node keeps its own transform
+    int* parents;                           //< Index of the parent node, -1 for the root
+    int* bones;                             //< Bone index of each node, -1 if the node is only an ancestor of bones
+    int count;
+} r3d_anim_hierarchy_t;
+
+// Counts the nodes of the subtree, used to size the hierarchy.
+static int r3d_count_animation_nodes(const struct aiNode* node)
 {
-    assert(outMatrix && aiAnim && nodeName);
+    int count = 1;
+    for (unsigned int i = 0; i < node->mNumChildren; i++) {
+        count += r3d_count_animation_nodes(node->mChildren[i]);
+    }
+    return count;
+}
 
-    /* --- Search for the animation channel corresponding to the given node --- */
+// Appends the nodes of the subtree that lead to a bone, parents first.
+static void r3d_collect_animation_nodes(r3d_anim_hierarchy_t* hierarchy, const struct aiNode* node,
+                                        int parent, const r3d_name_map_t* boneMap)
+{
+    int index = hierarchy->count++;
+
+    hierarchy->nodes[index] = node;
+    hierarchy->parents[index] = parent;
+    hierarchy->bones[index] = r3d_name_map_find(boneMap, node->mName.data);
+
+    for (unsigned int i = 0; i < node->mNumChildren; i++) {
+        r3d_collect_animation_nodes(hierarchy, node->mChildren[i], index, boneMap);
+    }
+
+    // Nodes that are neither a bone nor an ancestor of a bone have no effect on the poses
+    if (hierarchy->bones[index] < 0 && hierarchy->count == index + 1) {
+        hierarchy->count = index;
+    }
+}
+
+static void r3d_anim_hierarchy_destroy(r3d_anim_hierarchy_t* hierarchy)
+{
+    RL_FREE(hierarchy->nodes);
+    RL_FREE(hierarchy->channels);
+    RL_FREE(hierarchy->parents);
+    RL_FREE(hierarchy->bones);
+
+    hierarchy->nodes = NULL;
+    hierarchy->channels = NULL;
+    hierarchy->parents = NULL;
+    hierarchy->bones = NULL;
+}
+
+static bool r3d_anim_hierarchy_create(r3d_anim_hierarchy_t* hierarchy, const struct aiScene* scene,
+                                      const struct aiAnimation* aiAnim, const r3d_name_map_t* boneMap)
+{
+    int maxNodes = r3d_count_animation_nodes(scene->mRootNode);
+
+    hierarchy->nodes = RL_MALLOC(maxNodes * sizeof(struct aiNode*));
+    hierarchy->channels = RL_MALLOC(maxNodes * sizeof(struct aiNodeAnim*));
+    hierarchy->parents = RL_MALLOC(maxNodes * sizeof(int));
+    hierarchy->bones = RL_MALLOC(maxNodes * sizeof(int));
+    hierarchy->count = 0;
+
+    r3d_name_map_t channelMap = { 0 };
+
+    if (!hierarchy->nodes || !hierarchy->channels || !hierarchy->parents || !hierarchy->bones ||
+        !r3d_name_map_create(&channelMap, aiAnim->mNumChannels)) {
+        r3d_anim_hierarchy_destroy(hierarchy);
+        return false;
+    }
+
+    /* --- Flatten the nodes leading to a bone --- */
+
+    r3d_collect_animation_nodes(hierarchy, scene->mRootNode, -1, boneMap);
+
+    /* --- Find the channel of each node, the first channel of a node is used --- */
 
     for (unsigned int i = 0; i < aiAnim->mNumChannels; i++) {
-        const struct aiNodeAnim* nodeAnim = aiAnim->mChannels[i];
-        if (strcmp(nodeAnim->mNodeName.data, nodeName) == 0) {
+        r3d_name_map_insert(&channelMap, aiAnim->mChannels[i]->mNodeName.data);
+    }
 
-            /* --- Interpolate position, rotation, and scale at the specified time --- */
+    for (int n = 0; n < hierarchy->count; n++) {
+        int channel = r3d_name_map_find(&channelMap, hierarchy->nodes[n]->mName.data);
+        hierarchy->channels[n] = (channel >= 0) ? aiAnim->mChannels[channel] : NULL;
+    }
 
-            Vector3 position = r3d_interpolate_animation_keys_vec3(
-                nodeAnim->mPositionKeys,
-                nodeAnim->mNumPositionKeys,
-                time
-            );
+    r3d_name_map_destroy(&channelMap);
 
-            Quaternion rotation = r3d_interpolate_animation_keys_quat(
-                nodeAnim->mRotationKeys,
-                nodeAnim->mNumRotationKeys,
-                time
-            );
+    return true;
+}
 
-            Vector3 scale = r3d_interpolate_animation_keys_vec3(
-                nodeAnim->mScalingKeys,
-                nodeAnim->mNumScalingKeys,
-                time
-            );
+// Returns the local transform of a node at the specified time
+// 'cursors' holds the position, rotation and scale key cursors of the node
+static Matrix r3d_anim_hierarchy_get_local(const r3d_anim_hierarchy_t* hierarchy, int node, float time, unsigned int* cursors)
+{
+    const struct aiNodeAnim* channel = hierarchy->channels[node];
+
+    if (channel == NULL) {
+        return r3d_matrix_from_ai_matrix(&hierarchy->nodes[node]->mTransformation);
+    }
+
+    Vector3 position = r3d_interpolate_animation_keys_vec3(channel->mPositionKeys, channel->mNumPositionKeys, time, &cursors[0]);
+    Quaternion rotation = r3d_interpolate_animation_keys_quat(channel->mRotationKeys, channel->mNumRotationKeys, time, &cursors[1]);
+    Vector3 scale = r3d_interpolate_animation_keys_vec3(channel->mScalingKeys, channel->mNumScalingKeys, time, &cursors[2]);
 
-            /* --- Combine transformations: Scale * Rotation * Translation --- */
+    /* --- Combine transformations: Scale * Rotation * Translation --- */
 
-            *outMatrix = r3d_matrix_scale_rotq_translate(&scale, &rotation, &position);
+    return r3d_matrix_scale_rotq_translate(&scale, &rotation, &position);
+}
+
+/* === Assimp Animation Baking === */
+
+// Number of samples baked by each task, the tasks are distributed across the loading threads
+#define R3D_ANIM_BAKE_TASK_SAMPLES 16
+
+/*
+ * Baking state of one animation. The baking is split in three steps so that the
+ * samples of all the animations of a scene can be computed in a single parallel loop:
+ *   - init: sequential, allocates the outputs and flattens the hierarchy
+ *   - samples: any range of samples, from any thread
+ *   - finish: compresses the clip and releases the temporary data
+ */
+typedef struct {
+    R3D_ModelAnimation* animation;
+    const struct aiAnimation* aiAnim;
+    r3d_anim_hierarchy_t hierarchy;
+    float ticksPerSecond;
+    int targetFrameRate;
+    int sampleCount;            //< Frame count, plus one sample at the end for the compressed clips
+    bool compress;              //< Samples are written to 'locals' and compressed instead of baked
+    int clipCount;              //< Number of bones kept in the compressed clip
+    int* clipParents;
+    int* clipBones;
+    int* clipIndices;           //< Index in the clip of each hierarchy node
+    Transform* locals;          //< Sampled transforms of the clip bones, [sample][clip bone]
+    bool valid;
+} r3d_anim_bake_t;
+
+typedef struct {
+    int bake;
+    int firstSample;
+    int sampleCount;
+    bool failed;
+} r3d_anim_bake_task_t;
+
+typedef struct {
+    r3d_anim_bake_t* bakes;
+    r3d_anim_bake_task_t* tasks;
+} r3d_anim_bake_job_t;
+
+static void r3d_anim_bake_release(r3d_anim_bake_t* bake)
+{
+    r3d_anim_hierarchy_destroy(&bake->hierarchy);
+
+    RL_FREE(bake->clipParents);
+    RL_FREE(bake->clipBones);
+    RL_FREE(bake->clipIndices);
+    RL_FREE(bake->locals);
+
+    bake->clipParents = NULL;
+    bake->clipBones = NULL;
+    bake->clipIndices = NULL;
+    bake->locals = NULL;
+}
+
+// Frees the outputs of a bake that failed, the animation is left empty
+static void r3d_anim_bake_discard(r3d_anim_bake_t* bake)
+{
+    R3D_ModelAnimation* animation = bake->animation;
 
-            return true;
+    if (animation->frameGlobalPoses) {
+        for (int f = 0; f < animation->frameCount; f++) {
+            RL_FREE(animation->frameGlobalPoses[f]);
+        }
+    }
+    if (animation->frameLocalPoses) {
+        for (int f = 0; f < animation->frameCount; f++) {
+            RL_FREE(animation->frameLocalPoses[f]);
         }
     }
 
-    /* --- No animation channel found for the node: return identity matrix --- */
+    RL_FREE(animation->frameGlobalPoses);
+    RL_FREE(animation->frameLocalPoses);
+    RL_FREE(animation->bones);
 
-    return false;
+    animation->frameGlobalPoses = NULL;
+    animation->frameLocalPoses = NULL;
+    animation->bones = NULL;
 }
 
-void r3d_calculate_animation_transforms(
-    const struct aiNode* node, const struct aiAnimation* aiAnim, float time,
-    Matrix parentGlobalTransform, Matrix* globalTransforms,
-    Transform* localTransforms, const BoneInfo* bones,
-    int totalBones)
+static bool r3d_anim_bake_init_clip(r3d_anim_bake_t* bake)
 {
-    /* --- Get the node's local transform at the specified time --- */
+    const r3d_anim_hierarchy_t* hierarchy = &bake->hierarchy;
+    int nodeCount = (hierarchy->count > 0) ? hierarchy->count : 1;
+
+    bake->clipParents = RL_MALLOC(nodeCount * sizeof(int));
+    bake->clipBones = RL_MALLOC(nodeCount * sizeof(int));
+    bake->clipIndices = RL_MALLOC(nodeCount * sizeof(int));
 
-    Matrix localTransform;
-    if (!r3d_get_node_transform_at_time(&localTransform, aiAnim, node->mName.data, time)) {
-        // Use default transformation if no animation is found for this node
-        localTransform = r3d_matrix_from_ai_matrix(&node->mTransformation);
+    if (!bake->clipParents || !bake->clipBones || !bake->clipIndices) {
+        return false;
     }
 
-    /* --- Compute the global transformation --- */
-    
-    Matrix globalTransform = r3d_matrix_multiply(&localTransform, &parentGlobalTransform);
+    /* --- Only the bones are kept in the clip, each one relative to its parent bone --- */
 
-    /* --- Store both transforms if this node corresponds to a bone --- */
+    bake->clipCount = 0;
 
-    for (int i = 0; i < totalBones; i++) {
-        if (strcmp(node->mName.data, bones[i].name) == 0) {
-            // Store global transform (matrix)
-            globalTransforms[i] = globalTransform;
-            
-            // Decompose and store local transform (TRS)
-            MatrixDecompose(
-                localTransform,
-                &localTransforms[i].translation,
-                &localTransforms[i].rotation,
-                &localTransforms[i].scale
-            );
-            break;
+    for (int n = 0; n < hierarchy->count; n++) {
+        if (hierarchy->bones[n] < 0) continue;
+        int parent = hierarchy->parents[n];
+        while (parent >= 0 && hierarchy->bones[parent] < 0) {
+            parent = hierarchy->parents[parent];
         }
+        bake->clipParents[bake->clipCount] = (parent >= 0) ? bake->clipIndices[parent] : -1;
+        bake->clipBones[bake->clipCount] = hierarchy->bones[n];
+        bake->clipIndices[n] = bake->clipCount++;
     }
 
-    /* --- Recursively process all child nodes --- */
-
-    for (unsigned int i = 0; i < node->mNumChildren; i++) {
-        r3d_calculate_animation_transforms(
-            node->mChildren[i], aiAnim, time,
-            globalTransform,
-            globalTransforms, localTransforms,
-            bones, totalBones
-        );
+    if (bake->clipCount == 0) {
+        return false;
     }
+
+    bake->locals = RL_MALLOC((size_t)bake->sampleCount * bake->clipCount * sizeof(Transform));
+
+    return (bake->locals != NULL);
 }
 
-bool r3d_process_animation(R3D_ModelAnimation* animation,
-                           const struct aiScene* scene,
-                           const struct aiAnimation* aiAnim,
-                           int targetFrameRate)
+static bool r3d_anim_bake_init_frames(r3d_anim_bake_t* bake)
 {
-    /* --- Validate input --- */
-    
-    if (!animation || !scene || !aiAnim) {
+    R3D_ModelAnimation* animation = bake->animation;
+
+    animation->frameGlobalPoses = RL_CALLOC(animation->frameCount, sizeof(Matrix*));
+    animation->frameLocalPoses = RL_CALLOC(animation->frameCount, sizeof(Transform*));
+
+    if (!animation->frameGlobalPoses || !animation->frameLocalPoses) {
         return false;
     }
 
+    for (int f = 0; f < animation->frameCount; f++) {
+        animation->frameGlobalPoses[f] = RL_MALLOC(animation->boneCount * sizeof(Matrix));
+        animation->frameLocalPoses[f] = RL_MALLOC(animation->boneCount * sizeof(Transform));
+        if (!animation->frameGlobalPoses[f] || !animation->frameLocalPoses[f]) {
+            TraceLog(LOG_ERROR, "R3D: Failed to allocate frame %d", f);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Fills the animation infos and allocates everything needed to bake its samples
+// NOTE: On failure the partial allocations are released by 'r3d_anim_bake_finish'
+static bool r3d_anim_bake_init(r3d_anim_bake_t* bake, R3D_ModelAnimation* animation,
+                               const struct aiScene* scene, const struct aiAnimation* aiAnim,
+                               int targetFrameRate)
+{
+    memset(bake, 0, sizeof(*bake));
+
+    bake->animation = animation;
+    bake->aiAnim = aiAnim;
+    bake->targetFrameRate = targetFrameRate;
+    bake->compress = R3D.state.loading.compressAnimations;
+
     /* --- Initialize animation name --- */
-    
+
     strncpy(animation->name, aiAnim->mName.data, 31);
     animation->name[31] = '\0';
 
     /* --- Compute frame count --- */
-    
-    float ticksPerSecond = aiAnim->mTicksPerSecond ? aiAnim->mTicksPerSecond : 25.0f;
-    float durationInSeconds = (float)aiAnim->mDuration / ticksPerSecond;
+
+    bake->ticksPerSecond = aiAnim->mTicksPerSecond ? aiAnim->mTicksPerSecond : 25.0f;
+    float durationInSeconds = (float)aiAnim->mDuration / bake->ticksPerSecond;
     animation->frameCount = (int)(durationInSeconds * targetFrameRate + 0.5f);
 
+    // NOTE: The clip stores one more sample than the frame count, at the end of
+    //       the animation, so that the last frame can be interpolated as well.
+    bake->sampleCount = animation->frameCount + (bake->compress ? 1 : 0);
+
     TraceLog(LOG_INFO, "R3D: Animation '%s' - Duration: %.2fs, Frames: %d",
              animation->name, durationInSeconds, animation->frameCount);
 
-    /* --- Count unique bones --- */
-    
-    int boneCounter = 0;
-    for (unsigned int meshIndex = 0; meshIndex < scene->mNumMeshes; meshIndex++) {
-        const struct aiMesh* mesh = scene->mMeshes[meshIndex];
-        for (unsigned int boneIndex = 0; boneIndex < mesh->mNumBones; boneIndex++) {
-            const struct aiBone* bone = mesh->mBones[boneIndex];
-            bool exists = false;
-            
-            // Check in previous meshes
-            for (unsigned int pm = 0; pm < meshIndex && !exists; pm++) {
-                const struct aiMesh* prevMesh = scene->mMeshes[pm];
-                for (unsigned int pb = 0; pb < prevMesh->mNumBones && !exists; pb++) {
-                    exists = (strcmp(bone->mName.data, prevMesh->mBones[pb]->mName.data) == 0);
-                }
-            }
-            
-            // Check in current mesh (previous bones)
-            if (!exists) {
-                for (unsigned int pb = 0; pb < boneIndex && !exists; pb++) {
-                    exists = (strcmp(bone->mName.data, mesh->mBones[pb]->mName.data) == 0);
-                }
-            }
-            
-            if (!exists) boneCounter++;
-        }
+    /* --- Find unique bones --- */
+
+    r3d_name_map_t boneMap;
+    if (!r3d_collect_unique_bones(scene, &boneMap)) {
+        TraceLog(LOG_ERROR, "R3D: Allocation failed");
+        return false;
     }
 
-    if (boneCounter == 0) {
+    if (boneMap.count == 0) {
         TraceLog(LOG_WARNING, "R3D: No bones found for animation '%s'", animation->name);
+        r3d_name_map_destroy(&boneMap);
         return false;
     }
 
-    animation->boneCount = boneCounter;
-
-    /* --- Allocate storage --- */
-    
+    animation->boneCount = boneMap.count;
     animation->bones = RL_CALLOC(animation->boneCount, sizeof(BoneInfo));
-    animation->frameGlobalPoses = RL_CALLOC(animation->frameCount, sizeof(Matrix*));
-    animation->frameLocalPoses = RL_CALLOC(animation->frameCount, sizeof(Transform*));
 
-    if (!animation->bones || !animation->frameGlobalPoses || !animation->frameLocalPoses) {
+    if (!animation->bones) {
         TraceLog(LOG_ERROR, "R3D: Allocation failed");
-        RL_FREE(animation->bones);
-        RL_FREE(animation->frameGlobalPoses);
-        RL_FREE(animation->frameLocalPoses);
+        r3d_name_map_destroy(&boneMap);
         return false;
     }
 
-    /* --- Collect unique bone names --- */
-    
-    boneCounter = 0;
-    for (unsigned int meshIndex = 0; meshIndex < scene->mNumMeshes; meshIndex++) {
-        const struct aiMesh* mesh = scene->mMeshes[meshIndex];
-        for (unsigned int boneIndex = 0; boneIndex < mesh->mNumBones; boneIndex++) {
-            const struct aiBone* bone = mesh->mBones[boneIndex];
-            bool exists = false;
-            
-            for (int i = 0; i < boneCounter && !exists; i++) {
-                exists = (strcmp(bone->mName.data, animation->bones[i].name) == 0);
+    for (int i = 0; i < animation->boneCount; i++) {
+        strncpy(animation->bones[i].name, boneMap.names[i], 31);
+        animation->bones[i].name[31] = '\0';
+        animation->bones[i].parent = -1;
+    }
+
+    build_hierarchy_recursive(scene->mRootNode, animation->bones, &boneMap, -1);
+
+    /* --- Flatten the nodes leading to the bones --- */
+
+    bool hierarchyValid = r3d_anim_hierarchy_create(&bake->hierarchy, scene, aiAnim, &boneMap);
+
+    r3d_name_map_destroy(&boneMap);
+
+    if (!hierarchyValid) {
+        TraceLog(LOG_ERROR, "R3D: Allocation failed");
+        return false;
+    }
+
+    /* --- Allocate the outputs, compressed animations are evaluated when rendering --- */
+
+    bool allocated = bake->compress
+        ? r3d_anim_bake_init_clip(bake)
+        : r3d_anim_bake_init_frames(bake);
+
+    if (!allocated) {
+        TraceLog(LOG_ERROR, "R3D: Allocation failed");
+        return false;
+    }
+
+    return true;
+}
+
+// Computes the samples [firstSample, firstSample + sampleCount) of the animation
+// NOTE: Each sample only writes its own outputs, can be called concurrently on distinct ranges
+static bool r3d_anim_bake_samples(const r3d_anim_bake_t* bake, int firstSample, int sampleCount)
+{
+    const r3d_anim_hierarchy_t* hierarchy = &bake->hierarchy;
+    R3D_ModelAnimation* animation = bake->animation;
+    int nodeCount = hierarchy->count;
+
+    /* --- Allocate the scratch of the range --- */
+
+    // Global transforms of the nodes, followed by their transforms relative to their parent bone
+    Matrix* transforms = RL_MALLOC(2 * (nodeCount > 0 ? nodeCount : 1) * sizeof(Matrix));
+    unsigned int* cursors = RL_CALLOC(3 * (nodeCount > 0 ? nodeCount : 1), sizeof(unsigned int));
+
+    if (!transforms || !cursors) {
+        RL_FREE(transforms);
+        RL_FREE(cursors);
+        return false;
+    }
+
+    Matrix* globals = transforms;
+    Matrix* relatives = transforms + nodeCount;
+
+    /* --- Compute the transforms of the samples, the nodes being in hierarchy order --- */
+
+    for (int s = firstSample; s < firstSample + sampleCount; s++)
+    {
+        float timeInTicks = fminf(((float)s / bake->targetFrameRate) * bake->ticksPerSecond,
+                                  (float)bake->aiAnim->mDuration);
+
+        Matrix* globalPoses = NULL;
+        Transform* localPoses = NULL;
+
+        // Initialize transforms, the bones without node keep them
+        if (!bake->compress) {
+            globalPoses = animation->frameGlobalPoses[s];
+            localPoses = animation->frameLocalPoses[s];
+            for (int b = 0; b < animation->boneCount; b++) {
+                globalPoses[b] = R3D_MATRIX_IDENTITY;
+                localPoses[b] = (Transform){
+                    .translation = Vector3Zero(),
+                    .rotation = QuaternionIdentity(),
+                    .scale = Vector3One()
+                };
             }
-            
-            if (!exists) {
-                strncpy(animation->bones[boneCounter].name, bone->mName.data, 31);
-                animation->bones[boneCounter].name[31] = '\0';
-                animation->bones[boneCounter].parent = -1;
-                boneCounter++;
+        }
+
+        for (int n = 0; n < nodeCount; n++)
+        {
+            Matrix localTransform = r3d_anim_hierarchy_get_local(hierarchy, n, timeInTicks, &cursors[3 * n]);
+            int parent = hierarchy->parents[n];
+
+            // NOTE: The local transform of a bone is relative to its parent bone, so the
+            //       transforms of the intermediate nodes that are not bones are folded in
+            relatives[n] = (parent >= 0 && hierarchy->bones[parent] < 0)
+                ? r3d_matrix_multiply(&localTransform, &relatives[parent])
+                : localTransform;
+
+            int bone = hierarchy->bones[n];
+
+            if (bake->compress) {
+                if (bone < 0) continue;
+                Transform* local = &bake->locals[s * bake->clipCount + bake->clipIndices[n]];
+                MatrixDecompose(relatives[n], &local->translation, &local->rotation, &local->scale);
+                continue;
             }
+
+            globals[n] = (parent >= 0)
+                ? r3d_matrix_multiply(&localTransform, &globals[parent])
+                : localTransform;
+
+            if (bone < 0) continue;
+
+            globalPoses[bone] = globals[n];
+
+            MatrixDecompose(
+                relatives[n],
+                &localPoses[bone].translation,
+                &localPoses[bone].rotation,
+                &localPoses[bone].scale
+            );
         }
     }
 
-    /* --- Allocate per-frame storage --- */
-    
-    for (int f = 0; f < animation->frameCount; f++) {
-        animation->frameGlobalPoses[f] = RL_CALLOC(animation->boneCount, sizeof(Matrix));
-        animation->frameLocalPoses[f] = RL_CALLOC(animation->boneCount, sizeof(Transform));
-        
-        if (!animation->frameGlobalPoses[f] || !animation->frameLocalPoses[f]) {
-            TraceLog(LOG_ERROR, "R3D: Failed to allocate frame %d", f);
-            
-            // Cleanup on failure
-            for (int i = 0; i <= f; i++) {
-                RL_FREE(animation->frameGlobalPoses[i]);
-                RL_FREE(animation->frameLocalPoses[i]);
-            }
-            RL_FREE(animation->frameGlobalPoses);
-            RL_FREE(animation->frameLocalPoses);
-            RL_FREE(animation->bones);
-            return false;
+    RL_FREE(transforms);
+    RL_FREE(cursors);
+
+    return true;
+}
+
+// Compresses the clip once all the samples are computed and releases the baking data
+// NOTE: Only touches the animation of the bake, can be called concurrently on distinct bakes
+static bool r3d_anim_bake_finish(r3d_anim_bake_t* bake)
+{
+    R3D_ModelAnimation* animation = bake->animation;
+
+    if (!bake->valid) {
+        r3d_anim_bake_release(bake);
+        r3d_anim_bake_discard(bake);
+        return false;
+    }
+
+    if (!bake->compress) {
+        r3d_anim_bake_release(bake);
+        TraceLog(LOG_INFO, "R3D: Processed animation '%s' with %d bones and %d frames",
+                 animation->name, animation->boneCount, animation->frameCount);
+        return true;
+    }
+
+    /* --- Compress the samples --- */
+
+    r3d_anim_clip_t* clip = r3d_anim_clip_create(
+        bake->clipParents, bake->clipBones, bake->clipCount,
+        animation->boneCount, bake->locals, bake->sampleCount
+    );
+
+    r3d_anim_bake_release(bake);
+
+    if (clip == NULL) {
+        TraceLog(LOG_ERROR, "R3D: Failed to compress animation '%s'", animation->name);
+        r3d_anim_bake_discard(bake);
+        return false;
+    }
+
+    animation->clip = clip;
+
+    size_t bakedSize = (size_t)animation->frameCount * animation->boneCount * (sizeof(Matrix) + sizeof(Transform));
+
+    TraceLog(LOG_INFO, "R3D: Compressed animation '%s' with %d bones and %d frames (%zu bytes instead of %zu)",
+             animation->name, animation->boneCount, animation->frameCount, r3d_anim_clip_get_size(clip), bakedSize);
+
+    return true;
+}
+
+static void r3d_anim_bake_job_samples(void* userData, int begin, int end)
+{
+    r3d_anim_bake_job_t* job = userData;
+
+    for (int i = begin; i < end; i++) {
+        r3d_anim_bake_task_t* task = &job->tasks[i];
+        task->failed = !r3d_anim_bake_samples(&job->bakes[task->bake], task->firstSample, task->sampleCount);
+    }
+}
+
+static void r3d_anim_bake_job_finish(void* userData, int begin, int end)
+{
+    r3d_anim_bake_job_t* job = userData;
+
+    for (int i = begin; i < end; i++) {
+        job->bakes[i].valid = r3d_anim_bake_finish(&job->bakes[i]);
+    }
+}
+
+// Bakes the animations of the scene into 'animations', returns the number of valid animations
+// The valid animations are packed at the start of the array, the samples of all the animations
+// are spread over the loading threads
+static int r3d_bake_animations(R3D_ModelAnimation* animations, const struct aiScene* scene, int targetFrameRate)
+{
+    int animCount = scene->mNumAnimations;
+
+    r3d_anim_bake_t* bakes = RL_CALLOC(animCount, sizeof(r3d_anim_bake_t));
+    if (!bakes) {
+        TraceLog(LOG_ERROR, "R3D: Unable to allocate memory for animations");
+        return 0;
+    }
+
+    /* --- Initialize the animations and count the tasks --- */
+
+    int taskCount = 0;
+
+    for (int i = 0; i < animCount; i++) {
+        bakes[i].valid = r3d_anim_bake_init(&bakes[i], &animations[i], scene, scene->mAnimations[i], targetFrameRate);
+        if (bakes[i].valid) {
+            taskCount += (bakes[i].sampleCount + R3D_ANIM_BAKE_TASK_SAMPLES - 1) / R3D_ANIM_BAKE_TASK_SAMPLES;
         }
     }
 
-    /* --- Compute transforms for all frames in a single pass --- */
-    
-    for (int f = 0; f < animation->frameCount; f++) {
-        float timeInTicks = fminf(((float)f / targetFrameRate) * ticksPerSecond,
-                                  (float)aiAnim->mDuration);
-
-        // Initialize transforms
-        for (int b = 0; b < animation->boneCount; b++) {
-            animation->frameGlobalPoses[f][b] = R3D_MATRIX_IDENTITY;
-            animation->frameLocalPoses[f][b] = (Transform){
-                .translation = Vector3Zero(),
-                .rotation = QuaternionIdentity(),
-                .scale = Vector3One()
-            };
+    r3d_anim_bake_task_t* tasks = RL_MALLOC((taskCount > 0 ? taskCount : 1) * sizeof(r3d_anim_bake_task_t));
+    if (!tasks) {
+        TraceLog(LOG_ERROR, "R3D: Unable to allocate memory for animations");
+        for (int i = 0; i < animCount; i++) {
+            bakes[i].valid = false;
         }
+        taskCount = 0;
+    }
 
-        // Single pass: compute both local and global transforms
-        r3d_calculate_animation_transforms(
-            scene->mRootNode, aiAnim, timeInTicks,
-            R3D_MATRIX_IDENTITY,
-            animation->frameGlobalPoses[f],
-            animation->frameLocalPoses[f],
-            animation->bones, animation->boneCount
-        );
+    /* --- Split the samples of each animation in tasks --- */
+
+    for (int i = 0, t = 0; i < animCount && tasks != NULL; i++) {
+        if (!bakes[i].valid) continue;
+        for (int s = 0; s < bakes[i].sampleCount; s += R3D_ANIM_BAKE_TASK_SAMPLES) {
+            tasks[t].bake = i;
+            tasks[t].firstSample = s;
+            tasks[t].sampleCount = (bakes[i].sampleCount - s < R3D_ANIM_BAKE_TASK_SAMPLES)
+                ? bakes[i].sampleCount - s : R3D_ANIM_BAKE_TASK_SAMPLES;
+            tasks[t].failed = false;
+            t++;
+        }
     }
 
-    TraceLog(LOG_INFO, "R3D: Processed animation '%s' with %d bones and %d frames",
-             animation->name, animation->boneCount, animation->frameCount);
+    /* --- Bake the samples, then compress and release each animation --- */
 
-    return true;
+    r3d_anim_bake_job_t job = { .bakes = bakes, .tasks = tasks };
+
+    r3d_job_pool_parallel_for(R3D.jobs.loading, taskCount, 1, r3d_anim_bake_job_samples, &job);
+
+    for (int t = 0; t < taskCount; t++) {
+        if (tasks[t].failed) {
+            TraceLog(LOG_ERROR, "R3D: Failed to bake animation '%s'", bakes[tasks[t].bake].animation->name);
+            bakes[tasks[t].bake].valid = false;
+        }
+    }
+
+    r3d_job_pool_parallel_for(R3D.jobs.loading, animCount, 1, r3d_anim_bake_job_finish, &job);
+
+    /* --- Pack the valid animations --- */
+
+    int validCount = 0;
+    for (int i = 0; i < animCount; i++) {
+        if (!bakes[i].valid) {
+            TraceLog(LOG_ERROR, "R3D: Failed to process animation %d", i);
+            continue;
+        }
+        if (validCount != i) {
+            animations[validCount] = animations[i];
+            memset(&animations[i], 0, sizeof(R3D_ModelAnimation));
+        }
+        validCount++;
+    }
+
+    RL_FREE(tasks);
+    RL_FREE(bakes);
+
+    return validCount;
 }
 
 /* === Assimp Scene Processing === */
@@ -3219,138 +3795,993 @@ bool r3d_process_animation(R3D_ModelAnimation* animation,
     aiProcess_GlobalScale
 
 
-static const struct aiScene* r3d_load_scene_from_file(const char* filePath)
-{
-    const struct aiScene* scene = aiImportFileExWithProperties(filePath, R3D_ASSIMP_FLAGS, NULL, R3D.state.loading.aiProps);
-    if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
-        TraceLog(LOG_ERROR, "R3D: Assimp error; %s", aiGetErrorString());
-        return NULL;
-    }
-    return scene;
-}
+static const struct aiScene* r3d_load_scene_from_file(const char* filePath)
+{
+    const struct aiScene* scene = aiImportFileExWithProperties(filePath, R3D_ASSIMP_FLAGS, NULL, R3D.state.loading.aiProps);
+    if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
+        TraceLog(LOG_ERROR, "R3D: Assimp error; %s", aiGetErrorString());
+        return NULL;
+    }
+    return scene;
+}
+
+static const struct aiScene* r3d_load_scene_from_memory(const char* fileType, const void* data, unsigned int size)
+{
+    if (fileType != NULL && fileType[0] == '.') {
+        // pHint takes the format without the point, unlike raylib
+        fileType++;
+    }
+
+    const struct aiScene* scene = aiImportFileFromMemoryWithProperties(
+        data, size, R3D_ASSIMP_FLAGS, fileType, R3D.state.loading.aiProps);
+
+    if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
+        TraceLog(LOG_ERROR, "R3D: Assimp error; %s", aiGetErrorString());
+        return NULL;
+    }
+    return scene;
+}
+
+static bool r3d_process_model_from_scene(R3D_Model* model, const struct aiScene* scene, const char* filePath, r3d_array_t* pendingTextures)
+{
+    // NOTE: When 'pendingTextures' is given nothing is uploaded, the decoded images are added to it
+    //       and the meshes keep their vertices, so the scene can be processed outside the GL thread.
+
+    bool upload = (pendingTextures == NULL);
+
+    /* --- Process materials --- */
+
+    if (!process_assimp_materials(scene, &model->materials, &model->materialCount, filePath, pendingTextures)) {
+        TraceLog(LOG_ERROR, "R3D: Unable to load materials; The model will be invalid");
+        return false;
+    }
+
+    /* --- Initialize model and allocate meshes --- */
+
+    model->meshCount = scene->mNumMeshes;
+
+    model->meshes = RL_CALLOC(model->meshCount, sizeof(R3D_Mesh));
+    if (model->meshes == NULL) {
+        TraceLog(LOG_ERROR, "R3D: Unable to allocate memory for meshes; The model will be invalid");
+        return false;
+    }
+
+    model->meshMaterials = RL_CALLOC(model->meshCount, sizeof(int));
+    if (model->meshMaterials == NULL) {
+        TraceLog(LOG_ERROR, "R3D: Unable to allocate memory for mesh materials array; The model will be invalid");
+        RL_FREE(model->meshes);
+        return false;
+    }
+
+    /* --- Process all meshes --- */
+
+    if (!r3d_process_assimp_meshes(scene, model, scene->mRootNode, R3D_MATRIX_IDENTITY, upload)) {
+        return false;
+    }
+
+    for (int i = 0; i < model->meshCount; i++) {
+        if (model->meshes[i].vertexCount == 0 && model->meshes[i].indexCount == 0) {
+            if (!r3d_process_assimp_mesh(model, R3D_MATRIX_IDENTITY, i, scene->mMeshes[i], scene, upload)) {
+                TraceLog(LOG_ERROR, "R3D: Unable to load mesh [%d]; The model will be invalid", i);
+                return false;
+            }
+        }
+    }
+
+    /* --- Process bones and bind poses --- */
+
+    if (!r3d_process_bones_and_offsets(model, scene)) {
+        TraceLog(LOG_WARNING, "R3D: Failed to process bones, model will not be animated");
+    }
+
+    /* --- Calculate model bounding box --- */
+
+    R3D_UpdateModelBoundingBox(model, false);
+
+    return true;
+}
+
+static R3D_ModelAnimation* r3d_process_animations_from_scene(const struct aiScene* scene, int* animCount, int targetFrameRate, const char* sourceName)
+{
+    *animCount = 0;
+
+    /* --- Check if there are animations --- */
+
+    if (scene->mNumAnimations == 0) {
+        TraceLog(LOG_INFO, "R3D: No animations found in '%s'", sourceName ? sourceName : "memory");
+        return NULL;
+    }
+
+    TraceLog(LOG_INFO, "R3D: Found %d animations in '%s'", scene->mNumAnimations, sourceName ? sourceName : "memory");
+
+    /* --- Allocate animations array --- */
+
+    R3D_ModelAnimation* animations = RL_CALLOC(scene->mNumAnimations, sizeof(R3D_ModelAnimation));
+    if (!animations) {
+        TraceLog(LOG_ERROR, "R3D: Unable to allocate memory for animations");
+        return NULL;
+    }
+
+    /* --- Process all the animations --- */
+
+    int successCount = r3d_bake_animations(animations, scene, targetFrameRate);
+
+    /* --- Handle results --- */
+
+    if (successCount == 0) {
+        TraceLog(LOG_ERROR, "R3D: No animations were successfully loaded");
+        RL_FREE(animations);
+        return NULL;
+    }
+
+    if (successCount < (int)scene->mNumAnimations) {
+        TraceLog(LOG_WARNING, "R3D: Only %d out of %d animations were successfully loaded", successCount, scene->mNumAnimations);
+        R3D_ModelAnimation* resizedAnims = RL_REALLOC(animations, successCount * sizeof(R3D_ModelAnimation));
+        if (resizedAnims) animations = resizedAnims;
+    }
+
+    *animCount = successCount;
+    TraceLog(LOG_INFO, "R3D: Successfully loaded %d animations", successCount);
+
+    return animations;
+}
+
+/* === Cooked Model Format === */
+
+/*
+ * The cooked files are a snapshot of a loaded model and its animations. The structures are
+ * stored with the layout of the build that cooked them and every section is aligned, so
+ * once the file is mapped the data is copied or uploaded directly, without any parsing.
+ * The header records the structure sizes, a file cooked by a different build is rejected
+ * and must be cooked again from its source.
+ */
+
+#define R3D_COOKED_MAGIC            0x43443352u     //< "R3DC" read as a little endian word
+#define R3D_COOKED_VERSION          1
+#define R3D_COOKED_ALIGNMENT        16
+
+#define R3D_COOKED_TEXTURE_NONE     -1              //< Texture references of the materials, the others index the texture table
+#define R3D_COOKED_TEXTURE_WHITE    -2
+#define R3D_COOKED_TEXTURE_BLACK    -3
+#define R3D_COOKED_TEXTURE_NORMAL   -4
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vertexSize;        //< Structure sizes of the build that cooked the file
+    uint32_t materialSize;
+    uint32_t nodeSize;
+    int32_t meshCount;
+    int32_t materialCount;
+    int32_t textureCount;
+    int32_t boneCount;
+    int32_t animCount;
+    uint64_t meshes;            //< Offsets of the tables in the file
+    uint64_t materials;
+    uint64_t textures;
+    uint64_t bones;
+    uint64_t boneOffsets;
+    uint64_t anims;
+    BoundingBox aabb;
+} r3d_cooked_header_t;
+
+typedef struct {
+    int32_t vertexCount;
+    int32_t indexCount;
+    int32_t boneCount;          //< Size of the bone matrices cache of the mesh
+    int32_t material;
+    int32_t shadowCastMode;
+    uint32_t layers;
+    BoundingBox aabb;
+    uint64_t vertices;
+    uint64_t indices;           //< 0 if the mesh is not indexed
+} r3d_cooked_mesh_t;
+
+typedef struct {
+    R3D_Material material;      //< The texture ids are replaced by the references below when loading
+    int32_t textures[4];        //< Albedo, emission, normal and ORM references
+} r3d_cooked_material_t;
+
+typedef struct {
+    int32_t width;
+    int32_t height;
+    int32_t format;             //< Pixel format of the base level, the mipmaps are generated when loading
+    int32_t padding;
+    uint64_t data;
+    uint64_t size;
+} r3d_cooked_texture_t;
+
+typedef struct {
+    char name[32];
+    int32_t boneCount;
+    int32_t frameCount;
+    uint64_t bones;
+    uint64_t globalPoses;       //< [frame][bone] matrices, 0 for the compressed animations
+    uint64_t localPoses;        //< [frame][bone] transforms, 0 for the compressed animations
+    int32_t nodeCount;          //< Compressed clip, the counts are zero for the baked animations
+    int32_t sampleCount;
+    int32_t clipBoneCount;
+    int32_t mappedBones;
+    uint64_t nodes;
+    uint64_t words;
+    uint64_t wordCount;
+} r3d_cooked_anim_t;
+
+typedef struct {
+    const unsigned char* data;
+    size_t size;
+} r3d_cooked_blob_t;
+
+typedef struct {
+    FILE* file;
+    uint64_t offset;
+    bool failed;
+} r3d_cooked_writer_t;
+
+/* --- Writing --- */
+
+static uint64_t r3d_cooked_align(r3d_cooked_writer_t* writer)
+{
+    static const unsigned char padding[R3D_COOKED_ALIGNMENT] = { 0 };
+
+    size_t size = (size_t)(-writer->offset & (R3D_COOKED_ALIGNMENT - 1));
+    if (size > 0 && fwrite(padding, 1, size, writer->file) != size) {
+        writer->failed = true;
+    }
+    writer->offset += size;
+
+    return writer->offset;
+}
+
+static uint64_t r3d_cooked_write(r3d_cooked_writer_t* writer, const void* data, size_t size)
+{
+    // NOTE: Returns the offset of the data, the callers align the start of each section
+    uint64_t offset = writer->offset;
+    if (size > 0 && fwrite(data, 1, size, writer->file) != size) {
+        writer->failed = true;
+    }
+    writer->offset += size;
+    return offset;
+}
+
+static uint64_t r3d_cooked_write_section(r3d_cooked_writer_t* writer, const void* data, size_t size)
+{
+    if (data == NULL || size == 0) return 0;
+    r3d_cooked_align(writer);
+    return r3d_cooked_write(writer, data, size);
+}
+
+static int r3d_cooked_texture_ref(Texture2D texture, Texture2D* textures, int* textureCount)
+{
+    if (texture.id == 0) return R3D_COOKED_TEXTURE_NONE;
+    if (texture.id == R3D.texture.white) return R3D_COOKED_TEXTURE_WHITE;
+    if (texture.id == R3D.texture.black) return R3D_COOKED_TEXTURE_BLACK;
+    if (texture.id == R3D.texture.normal) return R3D_COOKED_TEXTURE_NORMAL;
+
+    for (int i = 0; i < *textureCount; i++) {
+        if (textures[i].id == texture.id) return i;
+    }
+
+    textures[*textureCount] = texture;
+    return (*textureCount)++;
+}
+
+static bool r3d_cooked_write_model(r3d_cooked_writer_t* writer, r3d_cooked_header_t* header, const R3D_Model* model)
+{
+    /* --- Meshes --- */
+
+    r3d_cooked_mesh_t* meshes = RL_CALLOC(model->meshCount + 1, sizeof(r3d_cooked_mesh_t));
+    if (meshes == NULL) return false;
+
+    for (int i = 0; i < model->meshCount; i++)
+    {
+        const R3D_Mesh* mesh = &model->meshes[i];
+
+        if (mesh->vertices == NULL || mesh->vertexCount <= 0) {
+            TraceLog(LOG_ERROR, "R3D: Unable to cook mesh [%d], its vertices are not kept in memory", i);
+            RL_FREE(meshes);
+            return false;
+        }
+
+        meshes[i] = (r3d_cooked_mesh_t) {
+            .vertexCount = mesh->vertexCount,
+            .indexCount = (mesh->indices != NULL) ? mesh->indexCount : 0,
+            .boneCount = mesh->boneCount,
+            .material = model->meshMaterials[i],
+            .shadowCastMode = mesh->shadowCastMode,
+            .layers = mesh->layers,
+            .aabb = mesh->aabb,
+            .vertices = r3d_cooked_write_section(writer, mesh->vertices, mesh->vertexCount * sizeof(R3D_Vertex))
+        };
+
+        if (meshes[i].indexCount > 0) {
+            meshes[i].indices = r3d_cooked_write_section(writer, mesh->indices, mesh->indexCount * sizeof(unsigned int));
+        }
+    }
+
+    header->meshCount = model->meshCount;
+    header->meshes = r3d_cooked_write_section(writer, meshes, model->meshCount * sizeof(r3d_cooked_mesh_t));
+
+    RL_FREE(meshes);
+
+    /* --- Materials, each distinct texture is read back once --- */
+
+    r3d_cooked_material_t* materials = RL_CALLOC(model->materialCount + 1, sizeof(r3d_cooked_material_t));
+    Texture2D* sources = RL_CALLOC(4 * model->materialCount + 1, sizeof(Texture2D));
+    r3d_cooked_texture_t* textures = RL_CALLOC(4 * model->materialCount + 1, sizeof(r3d_cooked_texture_t));
+
+    if (materials == NULL || sources == NULL || textures == NULL) {
+        RL_FREE(materials);
+        RL_FREE(sources);
+        RL_FREE(textures);
+        return false;
+    }
+
+    int textureCount = 0;
+
+    for (int i = 0; i < model->materialCount; i++)
+    {
+        const R3D_Material* material = &model->materials[i];
+
+        materials[i].material = *material;
+        materials[i].textures[0] = r3d_cooked_texture_ref(material->albedo.texture, sources, &textureCount);
+        materials[i].textures[1] = r3d_cooked_texture_ref(material->emission.texture, sources, &textureCount);
+        materials[i].textures[2] = r3d_cooked_texture_ref(material->normal.texture, sources, &textureCount);
+        materials[i].textures[3] = r3d_cooked_texture_ref(material->orm.texture, sources, &textureCount);
+    }
+
+    bool success = true;
+
+    for (int i = 0; i < textureCount; i++)
+    {
+        Image image = LoadImageFromTexture(sources[i]);
+        if (image.data == NULL) {
+            TraceLog(LOG_ERROR, "R3D: Unable to read back the texture %u to cook it", sources[i].id);
+            success = false;
+            break;
+        }
+
+        size_t size = (size_t)GetPixelDataSize(image.width, image.height, image.format);
+
+        textures[i] = (r3d_cooked_texture_t) {
+            .width = image.width,
+            .height = image.height,
+            .format = image.format,
+            .data = r3d_cooked_write_section(writer, image.data, size),
+            .size = size
+        };
+
+        UnloadImage(image);
+    }
+
+    if (success) {
+        header->materialCount = model->materialCount;
+        header->textureCount = textureCount;
+        header->materials = r3d_cooked_write_section(writer, materials, model->materialCount * sizeof(r3d_cooked_material_t));
+        header->textures = r3d_cooked_write_section(writer, textures, textureCount * sizeof(r3d_cooked_texture_t));
+    }
+
+    RL_FREE(materials);
+    RL_FREE(sources);
+    RL_FREE(textures);
+
+    if (!success) {
+        return false;
+    }
+
+    /* --- Skeleton --- */
+
+    if (model->boneCount > 0 && model->bones != NULL && model->boneOffsets != NULL) {
+        header->boneCount = model->boneCount;
+        header->bones = r3d_cooked_write_section(writer, model->bones, model->boneCount * sizeof(BoneInfo));
+        header->boneOffsets = r3d_cooked_write_section(writer, model->boneOffsets, model->boneCount * sizeof(Matrix));
+    }
+
+    header->aabb = model->aabb;
+
+    return true;
+}
+
+static bool r3d_cooked_write_animations(r3d_cooked_writer_t* writer, r3d_cooked_header_t* header,
+                                        const R3D_ModelAnimation* animations, int animCount)
+{
+    r3d_cooked_anim_t* anims = RL_CALLOC(animCount, sizeof(r3d_cooked_anim_t));
+    if (anims == NULL) return false;
+
+    for (int i = 0; i < animCount; i++)
+    {
+        const R3D_ModelAnimation* anim = &animations[i];
+        const r3d_anim_clip_t* clip = anim->clip;
+        r3d_cooked_anim_t* cooked = &anims[i];
+
+        memcpy(cooked->name, anim->name, sizeof(cooked->name));
+        cooked->boneCount = anim->boneCount;
+        cooked->frameCount = anim->frameCount;
+        cooked->bones = r3d_cooked_write_section(writer, anim->bones, anim->boneCount * sizeof(BoneInfo));
+
+        if (clip != NULL) {
+            cooked->nodeCount = clip->nodeCount;
+            cooked->sampleCount = clip->sampleCount;
+            cooked->clipBoneCount = clip->boneCount;
+            cooked->mappedBones = clip->mappedBones;
+            cooked->nodes = r3d_cooked_write_section(writer, clip->nodes, clip->nodeCount * sizeof(r3d_anim_node_t));
+            cooked->words = r3d_cooked_write_section(writer, clip->words, clip->wordCount * sizeof(uint16_t));
+            cooked->wordCount = clip->wordCount;
+            continue;
+        }
+
+        // NOTE: The frames are written back to back, the poses of the file are [frame][bone] arrays
+
+        if (anim->frameGlobalPoses != NULL && anim->frameCount > 0) {
+            cooked->globalPoses = r3d_cooked_align(writer);
+            for (int f = 0; f < anim->frameCount; f++) {
+                r3d_cooked_write(writer, anim->frameGlobalPoses[f], anim->boneCount * sizeof(Matrix));
+            }
+        }
+
+        if (anim->frameLocalPoses != NULL && anim->frameCount > 0) {
+            cooked->localPoses = r3d_cooked_align(writer);
+            for (int f = 0; f < anim->frameCount; f++) {
+                r3d_cooked_write(writer, anim->frameLocalPoses[f], anim->boneCount * sizeof(Transform));
+            }
+        }
+    }
+
+    header->animCount = animCount;
+    header->anims = r3d_cooked_write_section(writer, anims, animCount * sizeof(r3d_cooked_anim_t));
+
+    RL_FREE(anims);
+
+    return true;
+}
+
+/* --- Reading --- */
+
+static bool r3d_cooked_map(r3d_cooked_blob_t* blob, const char* filePath)
+{
+    int fd = open(filePath, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(r3d_cooked_header_t)) {
+        close(fd);
+        return false;
+    }
+
+    void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED) {
+        return false;
+    }
+
+    blob->data = data;
+    blob->size = (size_t)st.st_size;
+
+    return true;
+}
+
+static void r3d_cooked_unmap(r3d_cooked_blob_t* blob)
+{
+    munmap((void*)blob->data, blob->size);
+}
+
+static const void* r3d_cooked_get(const r3d_cooked_blob_t* blob, uint64_t offset, size_t count, size_t size)
+{
+    // NOTE: Every range read from the file is checked, a truncated file only fails to load.
+    //       The empty sections are written without data at the offset 0.
+    //       The indices read from the sections are checked by the functions below.
+    if (offset == 0 && count == 0) return blob->data;
+    if (offset == 0 || offset > blob->size || offset % R3D_COOKED_ALIGNMENT != 0) return NULL;
+    if (size > 0 && count > (blob->size - offset) / size) return NULL;
+    return blob->data + offset;
+}
+
+static const r3d_cooked_header_t* r3d_cooked_get_header(const r3d_cooked_blob_t* blob, const char* filePath)
+{
+    const r3d_cooked_header_t* header = (const r3d_cooked_header_t*)blob->data;
+
+    if (header->magic != R3D_COOKED_MAGIC) {
+        TraceLog(LOG_ERROR, "R3D: '%s' is not a cooked model", filePath);
+        return NULL;
+    }
+
+    if (header->version != R3D_COOKED_VERSION || header->vertexSize != sizeof(R3D_Vertex) ||
+        header->materialSize != sizeof(R3D_Material) || header->nodeSize != sizeof(r3d_anim_node_t)) {
+        TraceLog(LOG_ERROR, "R3D: '%s' was cooked by another version, it must be cooked again", filePath);
+        return NULL;
+    }
+
+    if (header->meshCount < 0 || header->materialCount < 0 || header->textureCount < 0 ||
+        header->boneCount < 0 || header->animCount < 0) {
+        TraceLog(LOG_ERROR, "R3D: '%s' is corrupted", filePath);
+        return NULL;
+    }
+
+    return header;
+}
+
+static bool r3d_cooked_check_bones(const BoneInfo* bones, int boneCount)
+{
+    // NOTE: The poses resolve the parents recursively, a cycle must never reach them
+    for (int i = 0; i < boneCount; i++) {
+        int parent = bones[i].parent;
+        for (int steps = 0; parent >= 0; steps++) {
+            if (parent >= boneCount || steps >= boneCount) return false;
+            parent = bones[parent].parent;
+        }
+        if (parent < -1) return false;
+    }
+    return true;
+}
+
+static bool r3d_cooked_check_track(const r3d_anim_track_t* track, int sampleCount, size_t wordCount)
+{
+    uint64_t last = (uint64_t)track->offset + (uint64_t)track->stride * (uint64_t)(sampleCount - 1);
+    return last + 3 <= wordCount;
+}
+
+static bool r3d_cooked_check_clip(const r3d_anim_node_t* nodes, int nodeCount, int boneCount,
+                                  int sampleCount, size_t wordCount, int mappedBones)
+{
+    // NOTE: Each bone is animated by one node at most, like in r3d_anim_clip_create()
+    unsigned char* mapped = RL_CALLOC(boneCount, 1);
+    if (mapped == NULL) return false;
+
+    int mappedCount = 0;
+    bool valid = true;
+
+    for (int i = 0; valid && i < nodeCount; i++)
+    {
+        const r3d_anim_node_t* node = &nodes[i];
+
+        valid = (node->parent >= -1 && node->parent < i && node->bone >= -1 && node->bone < boneCount) &&
+                r3d_cooked_check_track(&node->translation, sampleCount, wordCount) &&
+                r3d_cooked_check_track(&node->rotation, sampleCount, wordCount) &&
+                r3d_cooked_check_track(&node->scale, sampleCount, wordCount);
+
+        if (!valid) break;
+
+        if (node->parent < 0) {
+            valid = (node->parentBone == -1 && node->depth == 0);
+        }
+        else {
+            const r3d_anim_node_t* parent = &nodes[node->parent];
+            valid = (node->parentBone == ((parent->bone >= 0) ? parent->bone : parent->parentBone)) &&
+                    (node->depth == parent->depth + (parent->bone >= 0));
+        }
+
+        if (valid && node->bone >= 0) {
+            valid = !mapped[node->bone];
+            mapped[node->bone] = 1;
+            mappedCount++;
+        }
+    }
+
+    RL_FREE(mapped);
+
+    return valid && mappedCount == mappedBones;
+}
+
+static bool r3d_cooked_load_texture(Texture2D* texture, int ref, const r3d_cooked_blob_t* blob,
+                                    const r3d_cooked_texture_t* textures, int textureCount)
+{
+    switch (ref) {
+    case R3D_COOKED_TEXTURE_NONE:
+        *texture = (Texture2D) { 0 };
+        return true;
+    case R3D_COOKED_TEXTURE_WHITE:
+        *texture = R3D_GetWhiteTexture();
+        return true;
+    case R3D_COOKED_TEXTURE_BLACK:
+        *texture = R3D_GetBlackTexture();
+        return true;
+    case R3D_COOKED_TEXTURE_NORMAL:
+        *texture = R3D_GetNormalTexture();
+        return true;
+    default:
+        break;
+    }
+
+    if (ref < 0 || ref >= textureCount) {
+        return false;
+    }
+
+    const r3d_cooked_texture_t* cooked = &textures[ref];
+    const void* data = r3d_cooked_get(blob, cooked->data, cooked->size, 1);
+
+    if (data == NULL || cooked->width <= 0 || cooked->height <= 0 ||
+        cooked->size != (uint64_t)GetPixelDataSize(cooked->width, cooked->height, cooked->format)) {
+        return false;
+    }
+
+    // NOTE: The pixels are uploaded from the mapping, the image is never freed
+    Image image = {
+        .data = (void*)data,
+        .width = cooked->width,
+        .height = cooked->height,
+        .mipmaps = 1,
+        .format = cooked->format
+    };
+
+    *texture = LoadTextureFromImage(image);
+    if (texture->id == 0) {
+        return false;
+    }
+
+    if (R3D.state.loading.textureFilter > TEXTURE_FILTER_BILINEAR) {
+        GenTextureMipmaps(texture);
+    }
+
+    SetTextureFilter(*texture, R3D.state.loading.textureFilter);
+
+    return true;
+}
+
+static bool r3d_cooked_load_model(R3D_Model* model, const r3d_cooked_blob_t* blob, const r3d_cooked_header_t* header)
+{
+    /* --- Materials and their textures --- */
+
+    const r3d_cooked_material_t* materials = r3d_cooked_get(blob, header->materials, header->materialCount, sizeof(r3d_cooked_material_t));
+    const r3d_cooked_texture_t* textures = r3d_cooked_get(blob, header->textures, header->textureCount, sizeof(r3d_cooked_texture_t));
+
+    if (materials == NULL || textures == NULL || header->materialCount == 0) {
+        return false;
+    }
+
+    model->materials = RL_CALLOC(header->materialCount, sizeof(R3D_Material));
+    if (model->materials == NULL) {
+        return false;
+    }
+
+    // NOTE: The materials are counted first, on failure the model is unloaded with the textures loaded so far
+    model->materialCount = header->materialCount;
+
+    for (int i = 0; i < header->materialCount; i++)
+    {
+        R3D_Material* material = &model->materials[i];
+        const int* refs = materials[i].textures;
+
+        *material = materials[i].material;
+        material->albedo.texture = material->emission.texture = (Texture2D) { 0 };
+        material->normal.texture = material->orm.texture = (Texture2D) { 0 };
+
+        // NOTE: A texture shared by several maps is stored once in the file, but each map gets
+        //       its own upload, as R3D_UnloadMaterial() releases the textures of every map
+        if (!r3d_cooked_load_texture(&material->albedo.texture, refs[0], blob, textures, header->textureCount) ||
+            !r3d_cooked_load_texture(&material->emission.texture, refs[1], blob, textures, header->textureCount) ||
+            !r3d_cooked_load_texture(&material->normal.texture, refs[2], blob, textures, header->textureCount) ||
+            !r3d_cooked_load_texture(&material->orm.texture, refs[3], blob, textures, header->textureCount)) {
+            return false;
+        }
+    }
+
+    /* --- Meshes --- */
+
+    const r3d_cooked_mesh_t* meshes = r3d_cooked_get(blob, header->meshes, header->meshCount, sizeof(r3d_cooked_mesh_t));
+    if (meshes == NULL || header->meshCount == 0) {
+        return false;
+    }
+
+    model->meshes = RL_CALLOC(header->meshCount, sizeof(R3D_Mesh));
+    model->meshMaterials = RL_CALLOC(header->meshCount, sizeof(int));
+
+    if (model->meshes == NULL || model->meshMaterials == NULL) {
+        return false;
+    }
+
+    model->meshCount = header->meshCount;
+
+    for (int i = 0; i < header->meshCount; i++)
+    {
+        const r3d_cooked_mesh_t* cooked = &meshes[i];
+        R3D_Mesh* mesh = &model->meshes[i];
+
+        const void* vertices = r3d_cooked_get(blob, cooked->vertices, cooked->vertexCount, sizeof(R3D_Vertex));
+        const void* indices = r3d_cooked_get(blob, cooked->indices, cooked->indexCount, sizeof(unsigned int));
+
+        if (vertices == NULL || cooked->vertexCount <= 0 || cooked->indexCount < 0 ||
+            cooked->boneCount < 0 || cooked->boneCount > header->boneCount ||
+            (cooked->indexCount > 0 && indices == NULL) || cooked->material < 0 || cooked->material >= model->materialCount) {
+            return false;
+        }
+
+        for (int j = 0; j < cooked->indexCount; j++) {
+            if (((const unsigned int*)indices)[j] >= (unsigned int)cooked->vertexCount) return false;
+        }
+
+        mesh->vertexCount = cooked->vertexCount;
+        mesh->indexCount = cooked->indexCount;
+        mesh->shadowCastMode = (R3D_ShadowCastMode)cooked->shadowCastMode;
+        mesh->layers = (R3D_Layer)cooked->layers;
+        mesh->aabb = cooked->aabb;
+
+        mesh->vertices = RL_MALLOC(cooked->vertexCount * sizeof(R3D_Vertex));
+        if (mesh->vertices == NULL) return false;
+        memcpy(mesh->vertices, vertices, cooked->vertexCount * sizeof(R3D_Vertex));
+
+        if (cooked->indexCount > 0) {
+            mesh->indices = RL_MALLOC(cooked->indexCount * sizeof(unsigned int));
+            if (mesh->indices == NULL) return false;
+            memcpy(mesh->indices, indices, cooked->indexCount * sizeof(unsigned int));
+        }
+
+        mesh->boneCount = cooked->boneCount;
+
+        model->meshMaterials[i] = cooked->material;
+
+        if (!R3D_UploadMesh(mesh, false)) {
+            return false;
+        }
+    }
+
+    /* --- Skeleton --- */
+
+    if (header->boneCount > 0)
+    {
+        const BoneInfo* bones = r3d_cooked_get(blob, header->bones, header->boneCount, sizeof(BoneInfo));
+        const Matrix* boneOffsets = r3d_cooked_get(blob, header->boneOffsets, header->boneCount, sizeof(Matrix));
+        if (bones == NULL || boneOffsets == NULL || !r3d_cooked_check_bones(bones, header->boneCount)) {
+            return false;
+        }
+
+        model->bones = RL_MALLOC(header->boneCount * sizeof(BoneInfo));
+        model->boneOffsets = RL_MALLOC(header->boneCount * sizeof(Matrix));
+        if (model->bones == NULL || model->boneOffsets == NULL) {
+            return false;
+        }
+
+        memcpy(model->bones, bones, header->boneCount * sizeof(BoneInfo));
+        memcpy(model->boneOffsets, boneOffsets, header->boneCount * sizeof(Matrix));
+        model->boneCount = header->boneCount;
+    }
+
+    model->aabb = header->aabb;
+
+    return true;
+}
+
+static bool r3d_cooked_load_animation(R3D_ModelAnimation* anim, const r3d_cooked_blob_t* blob,
+                                      const r3d_cooked_header_t* header, const r3d_cooked_anim_t* cooked)
+{
+    if (cooked->boneCount <= 0 || cooked->boneCount != header->boneCount || cooked->frameCount < 0) {
+        return false;
+    }
+
+    const BoneInfo* bones = r3d_cooked_get(blob, cooked->bones, cooked->boneCount, sizeof(BoneInfo));
+    if (bones == NULL || !r3d_cooked_check_bones(bones, cooked->boneCount)) return false;
+
+    memcpy(anim->name, cooked->name, sizeof(anim->name));
+    anim->name[sizeof(anim->name) - 1] = '\0';
+
+    anim->bones = RL_MALLOC(cooked->boneCount * sizeof(BoneInfo));
+    if (anim->bones == NULL) return false;
+    memcpy(anim->bones, bones, cooked->boneCount * sizeof(BoneInfo));
+
+    anim->boneCount = cooked->boneCount;
+    anim->frameCount = cooked->frameCount;
+
+    /* --- Compressed clip --- */
+
+    if (cooked->nodeCount > 0)
+    {
+        const r3d_anim_node_t* nodes = r3d_cooked_get(blob, cooked->nodes, cooked->nodeCount, sizeof(r3d_anim_node_t));
+        const uint16_t* words = r3d_cooked_get(blob, cooked->words, cooked->wordCount, sizeof(uint16_t));
+
+        if (nodes == NULL || words == NULL || cooked->sampleCount <= 0 || cooked->clipBoneCount != cooked->boneCount ||
+            !r3d_cooked_check_clip(nodes, cooked->nodeCount, cooked->clipBoneCount, cooked->sampleCount,
+                                   cooked->wordCount, cooked->mappedBones)) {
+            return false;
+        }
+
+        // NOTE: The clips are released with free() like the ones built by r3d_anim_clip_create()
+        r3d_anim_clip_t* clip = calloc(1, sizeof(r3d_anim_clip_t));
+        if (clip == NULL) return false;
+
+        clip->nodes = malloc(cooked->nodeCount * sizeof(r3d_anim_node_t));
+        clip->words = malloc(cooked->wordCount * sizeof(uint16_t));
+        anim->clip = clip;
+
+        if (clip->nodes == NULL || clip->words == NULL) {
+            return false;
+        }
+
+        memcpy(clip->nodes, nodes, cooked->nodeCount * sizeof(r3d_anim_node_t));
+        memcpy(clip->words, words, cooked->wordCount * sizeof(uint16_t));
+
+        clip->wordCount = cooked->wordCount;
+        clip->nodeCount = cooked->nodeCount;
+        clip->boneCount = cooked->clipBoneCount;
+        clip->sampleCount = cooked->sampleCount;
+        clip->mappedBones = cooked->mappedBones;
+
+        return true;
+    }
+
+    /* --- Baked poses --- */
+
+    size_t poseCount = (size_t)cooked->frameCount * cooked->boneCount;
 
-static const struct aiScene* r3d_load_scene_from_memory(const char* fileType, const void* data, unsigned int size)
-{
-    if (fileType != NULL && fileType[0] == '.') {
-        // pHint takes the format without the point, unlike raylib
-        fileType++;
+    const Matrix* globalPoses = r3d_cooked_get(blob, cooked->globalPoses, poseCount, sizeof(Matrix));
+    const Transform* localPoses = r3d_cooked_get(blob, cooked->localPoses, poseCount, sizeof(Transform));
+
+    if (cooked->frameCount == 0 || globalPoses == NULL) {
+        return cooked->frameCount == 0;
     }
 
-    const struct aiScene* scene = aiImportFileFromMemoryWithProperties(
-        data, size, R3D_ASSIMP_FLAGS, fileType, R3D.state.loading.aiProps);
+    anim->frameGlobalPoses = RL_CALLOC(cooked->frameCount, sizeof(Matrix*));
+    if (anim->frameGlobalPoses == NULL) return false;
 
-    if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
-        TraceLog(LOG_ERROR, "R3D: Assimp error; %s", aiGetErrorString());
-        return NULL;
+    if (localPoses != NULL) {
+        anim->frameLocalPoses = RL_CALLOC(cooked->frameCount, sizeof(Transform*));
+        if (anim->frameLocalPoses == NULL) return false;
     }
-    return scene;
+
+    for (int f = 0; f < cooked->frameCount; f++)
+    {
+        anim->frameGlobalPoses[f] = RL_MALLOC(cooked->boneCount * sizeof(Matrix));
+        if (anim->frameGlobalPoses[f] == NULL) return false;
+        memcpy(anim->frameGlobalPoses[f], globalPoses + f * cooked->boneCount, cooked->boneCount * sizeof(Matrix));
+
+        if (localPoses != NULL) {
+            anim->frameLocalPoses[f] = RL_MALLOC(cooked->boneCount * sizeof(Transform));
+            if (anim->frameLocalPoses[f] == NULL) return false;
+            memcpy(anim->frameLocalPoses[f], localPoses + f * cooked->boneCount, cooked->boneCount * sizeof(Transform));
+        }
+    }
+
+    return true;
 }
 
-static bool r3d_process_model_from_scene(R3D_Model* model, const struct aiScene* scene, const char* filePath)
+/* === Asynchronous Model Loading === */
+
+/*
+ * The asynchronous loads import the scene, decode the images and process the vertices
+ * on the loading threads, without any GL call. Once imported, the textures and then the
+ * meshes are uploaded one at a time at the end of R3D_End(), until the frame budget is spent.
+ * The handles only live on the main thread, the loading threads only see their own load.
+ */
+
+#define R3D_ASYNC_LOADER_THREADS 2
+
+typedef enum {
+    R3D_ASYNC_STAGE_IMPORT,         //< Processed by a loading thread
+    R3D_ASYNC_STAGE_UPLOAD,         //< Imported, uploaded by the main thread
+    R3D_ASYNC_STAGE_READY,
+    R3D_ASYNC_STAGE_FAILED
+} r3d_async_stage_t;
+
+typedef struct {
+    char* filePath;
+    R3D_Model model;
+    r3d_array_t textures;           //< Decoded images of the material maps (r3d_pending_texture_t)
+    int uploadedTextures;
+    int uploadedMeshes;
+    atomic_int stage;               //< Published by the loading thread once the import is done
+    bool cancelled;                 //< The handle was released during the import, only used on the main thread
+} r3d_async_model_t;
+
+static void r3d_async_model_import(void* userData)
 {
-    /* --- Process materials --- */
+    r3d_async_model_t* async = userData;
+    int stage = R3D_ASYNC_STAGE_FAILED;
 
-    if (!process_assimp_materials(scene, &model->materials, &model->materialCount, filePath)) {
-        TraceLog(LOG_ERROR, "R3D: Unable to load materials; The model will be invalid");
-        return false;
+    const struct aiScene* scene = r3d_load_scene_from_file(async->filePath);
+    if (scene != NULL) {
+        if (r3d_process_model_from_scene(&async->model, scene, async->filePath, &async->textures)) {
+            stage = R3D_ASYNC_STAGE_UPLOAD;
+        }
+        aiReleaseImport(scene);
     }
 
-    /* --- Initialize model and allocate meshes --- */
-
-    model->meshCount = scene->mNumMeshes;
+    // NOTE: The release store publishes the model and the images to the main thread
+    atomic_store_explicit(&async->stage, stage, memory_order_release);
+}
 
-    model->meshes = RL_CALLOC(model->meshCount, sizeof(R3D_Mesh));
-    if (model->meshes == NULL) {
-        TraceLog(LOG_ERROR, "R3D: Unable to allocate memory for meshes; The model will be invalid");
-        return false;
+static void r3d_async_model_destroy(r3d_async_model_t* async, bool unloadModel)
+{
+    for (size_t i = async->uploadedTextures; i < async->textures.count; i++) {
+        UnloadImage(((r3d_pending_texture_t*)async->textures.data)[i].image);
     }
 
-    model->meshMaterials = RL_CALLOC(model->meshCount, sizeof(int));
-    if (model->meshMaterials == NULL) {
-        TraceLog(LOG_ERROR, "R3D: Unable to allocate memory for mesh materials array; The model will be invalid");
-        RL_FREE(model->meshes);
-        return false;
+    if (unloadModel) {
+        R3D_UnloadModel(&async->model, true);
     }
 
-    /* --- Process all meshes --- */
+    r3d_array_destroy(&async->textures);
+    RL_FREE(async->filePath);
+    RL_FREE(async);
+}
 
-    if (!r3d_process_assimp_meshes(scene, model, scene->mRootNode, R3D_MATRIX_IDENTITY)) {
-        return false;
-    }
+static bool r3d_async_model_upload_next(r3d_async_model_t* async)
+{
+    // NOTE: Returns false once the load is ready or failed, the textures are uploaded first
 
-    for (int i = 0; i < model->meshCount; i++) {
-        if (model->meshes[i].vertexCount == 0 && model->meshes[i].indexCount == 0) {
-            if (!r3d_process_assimp_mesh(model, R3D_MATRIX_IDENTITY, i, scene->mMeshes[i], scene, true)) {
-                TraceLog(LOG_ERROR, "R3D: Unable to load mesh [%d]; The model will be invalid", i);
-                return false;
-            }
+    if (async->uploadedTextures < (int)async->textures.count) {
+        r3d_pending_texture_t* pending = r3d_array_at(&async->textures, async->uploadedTextures++);
+        if (!r3d_upload_model_texture(pending->target, pending->image)) {
+            TraceLog(LOG_WARNING, "R3D: Unable to upload a texture of '%s', the default texture is kept", async->filePath);
         }
+        UnloadImage(pending->image);
+        return true;
     }
 
-    /* --- Process bones and bind poses --- */
+    // NOTE: Like in R3D_LoadModel(), where r3d_process_assimp_mesh() fails on an upload error,
+    //       a mesh that can not be uploaded fails the whole load instead of being left invalid
 
-    if (!r3d_process_bones_and_offsets(model, scene)) {
-        TraceLog(LOG_WARNING, "R3D: Failed to process bones, model will not be animated");
+    if (async->uploadedMeshes < async->model.meshCount) {
+        if (!R3D_UploadMesh(&async->model.meshes[async->uploadedMeshes++], false)) {
+            TraceLog(LOG_ERROR, "R3D: Unable to upload mesh [%d] of '%s'; The model will be invalid", async->uploadedMeshes - 1, async->filePath);
+            atomic_store_explicit(&async->stage, R3D_ASYNC_STAGE_FAILED, memory_order_relaxed);
+            return false;
+        }
+        return true;
     }
 
-    /* --- Calculate model bounding box --- */
+    atomic_store_explicit(&async->stage, R3D_ASYNC_STAGE_READY, memory_order_relaxed);
 
-    R3D_UpdateModelBoundingBox(model, false);
+    return false;
+}
 
-    return true;
+static r3d_async_model_t* r3d_async_model_get(R3D_AsyncModel handle)
+{
+    r3d_async_model_t** entry = r3d_registry_get(&R3D.container.rAsyncModels, handle);
+    if (entry == NULL || (*entry)->cancelled) return NULL;
+    return *entry;
 }
 
-static R3D_ModelAnimation* r3d_process_animations_from_scene(const struct aiScene* scene, int* animCount, int targetFrameRate, const char* sourceName)
+void r3d_async_models_update(void)
 {
-    *animCount = 0;
+    r3d_registry_t* registry = &R3D.container.rAsyncModels;
 
-    /* --- Check if there are animations --- */
+    unsigned int count = r3d_registry_get_allocated_count(registry);
+    if (count == 0) return;
 
-    if (scene->mNumAnimations == 0) {
-        TraceLog(LOG_INFO, "R3D: No animations found in '%s'", sourceName ? sourceName : "memory");
-        return NULL;
-    }
+    double budget = R3D.state.loading.uploadBudget / 1000.0;
+    double start = GetTime();
 
-    TraceLog(LOG_INFO, "R3D: Found %d animations in '%s'", scene->mNumAnimations, sourceName ? sourceName : "memory");
+    for (unsigned int id = 1; id <= count; id++)
+    {
+        r3d_async_model_t** entry = r3d_registry_get(registry, id);
+        if (entry == NULL) continue;
 
-    /* --- Allocate animations array --- */
+        r3d_async_model_t* async = *entry;
+        int stage = atomic_load_explicit(&async->stage, memory_order_acquire);
 
-    R3D_ModelAnimation* animations = RL_CALLOC(scene->mNumAnimations, sizeof(R3D_ModelAnimation));
-    if (!animations) {
-        TraceLog(LOG_ERROR, "R3D: Unable to allocate memory for animations");
-        return NULL;
-    }
+        // The cancelled loads are released once the loading thread is done with them
+        if (async->cancelled) {
+            if (stage != R3D_ASYNC_STAGE_IMPORT) {
+                r3d_async_model_destroy(async, true);
+                r3d_registry_remove(registry, id);
+            }
+            continue;
+        }
 
-    /* --- Process each animation --- */
+        if (stage != R3D_ASYNC_STAGE_UPLOAD) {
+            continue;
+        }
 
-    int successCount = 0;
-    for (unsigned int i = 0; i < scene->mNumAnimations; i++) {
-        const struct aiAnimation* aiAnim = scene->mAnimations[i];
-        if (r3d_process_animation(&animations[successCount], scene, aiAnim, targetFrameRate)) {
-            successCount++;
-        } else {
-            TraceLog(LOG_ERROR, "R3D: Failed to process animation %d", i);
+        // NOTE: The budget is checked after each upload, so the loads progress even with a zero budget
+        while (r3d_async_model_upload_next(async)) {
+            if (GetTime() - start >= budget) return;
         }
     }
+}
 
-    /* --- Handle results --- */
+void r3d_async_models_release(void)
+{
+    r3d_worker_destroy(R3D.jobs.loader);
+    R3D.jobs.loader = NULL;
 
-    if (successCount == 0) {
-        TraceLog(LOG_ERROR, "R3D: No animations were successfully loaded");
-        RL_FREE(animations);
-        return NULL;
-    }
+    r3d_registry_t* registry = &R3D.container.rAsyncModels;
+    unsigned int count = r3d_registry_get_allocated_count(registry);
 
-    if (successCount < (int)scene->mNumAnimations) {
-        TraceLog(LOG_WARNING, "R3D: Only %d out of %d animations were successfully loaded", successCount, scene->mNumAnimations);
-        R3D_ModelAnimation* resizedAnims = RL_REALLOC(animations, successCount * sizeof(R3D_ModelAnimation));
-        if (resizedAnims) animations = resizedAnims;
+    for (unsigned int id = 1; id <= count; id++) {
+        r3d_async_model_t** entry = r3d_registry_get(registry, id);
+        if (entry == NULL) continue;
+        r3d_async_model_destroy(*entry, true);
+        r3d_registry_remove(registry, id);
     }
-
-    *animCount = successCount;
-    TraceLog(LOG_INFO, "R3D: Successfully loaded %d animations", successCount);
-
-    return animations;
 }
 
 /* === Public Model Functions === */
@@ -3368,7 +4799,7 @@ R3D_Model R3D_LoadModel(const char* filePath)
 
     /* --- Process model from scene --- */
 
-    if (!r3d_process_model_from_scene(&model, scene, filePath)) {
+    if (!r3d_process_model_from_scene(&model, scene, filePath, NULL)) {
         R3D_UnloadModel(&model, true);
         aiReleaseImport(scene);
         return (R3D_Model){ 0 };
@@ -3394,7 +4825,7 @@ R3D_Model R3D_LoadModelFromMemory(const char* fileType, const void* data, unsign
 
     /* --- Process model from scene --- */
 
-    if (!r3d_process_model_from_scene(&model, scene, NULL)) {
+    if (!r3d_process_model_from_scene(&model, scene, NULL, NULL)) {
         R3D_UnloadModel(&model, true);
         aiReleaseImport(scene);
         return (R3D_Model){ 0 };
@@ -3407,6 +4838,145 @@ R3D_Model R3D_LoadModelFromMemory(const char* fileType, const void* data, unsign
     return model;
 }
 
+R3D_Model R3D_LoadModelCooked(const char* filePath)
+{
+    R3D_Model model = { 0 };
+
+    /* --- Map the cooked file --- */
+
+    r3d_cooked_blob_t blob;
+    if (!r3d_cooked_map(&blob, filePath)) {
+        TraceLog(LOG_ERROR, "R3D: Unable to open the cooked model '%s'", filePath);
+        return model;
+    }
+
+    const r3d_cooked_header_t* header = r3d_cooked_get_header(&blob, filePath);
+    if (!header) {
+        r3d_cooked_unmap(&blob);
+        return model;
+    }
+
+    /* --- Load the model from the mapping --- */
+
+    if (!r3d_cooked_load_model(&model, &blob, header)) {
+        TraceLog(LOG_ERROR, "R3D: Unable to load the cooked model '%s'; The file is corrupted", filePath);
+        R3D_UnloadModel(&model, true);
+        model = (R3D_Model) { 0 };
+    }
+
+    r3d_cooked_unmap(&blob);
+
+    return model;
+}
+
+R3D_AsyncModel R3D_LoadModelAsync(const char* filePath)
+{
+    if (filePath == NULL) {
+        return 0;
+    }
+
+    /* --- Start the loading threads on the first request --- */
+
+    if (R3D.jobs.loader == NULL) {
+        R3D.jobs.loader = r3d_worker_create(R3D_ASYNC_LOADER_THREADS);
+        if (R3D.jobs.loader == NULL) {
+            TraceLog(LOG_ERROR, "R3D: Unable to create the loading threads");
+            return 0;
+        }
+    }
+
+    /* --- Create the load and queue its import --- */
+
+    r3d_async_model_t* async = RL_CALLOC(1, sizeof(r3d_async_model_t));
+    if (async == NULL) {
+        TraceLog(LOG_ERROR, "R3D: Unable to allocate memory for the asynchronous load of '%s'", filePath);
+        return 0;
+    }
+
+    size_t length = strlen(filePath);
+    async->filePath = RL_MALLOC(length + 1);
+    async->textures = r3d_array_create(8, sizeof(r3d_pending_texture_t));
+    atomic_init(&async->stage, R3D_ASYNC_STAGE_IMPORT);
+
+    if (async->filePath == NULL) {
+        r3d_async_model_destroy(async, false);
+        return 0;
+    }
+
+    memcpy(async->filePath, filePath, length + 1);
+
+    R3D_AsyncModel handle = r3d_registry_add(&R3D.container.rAsyncModels, &async);
+
+    if (!r3d_worker_submit(R3D.jobs.loader, r3d_async_model_import, async)) {
+        TraceLog(LOG_ERROR, "R3D: Unable to queue the asynchronous load of '%s'", filePath);
+        r3d_registry_remove(&R3D.container.rAsyncModels, handle);
+        r3d_async_model_destroy(async, false);
+        return 0;
+    }
+
+    return handle;
+}
+
+R3D_AsyncState R3D_GetAsyncModelState(R3D_AsyncModel handle)
+{
+    r3d_async_model_t* async = r3d_async_model_get(handle);
+    if (async == NULL) {
+        return R3D_ASYNC_INVALID;
+    }
+
+    switch (atomic_load_explicit(&async->stage, memory_order_acquire)) {
+    case R3D_ASYNC_STAGE_READY:
+        return R3D_ASYNC_READY;
+    case R3D_ASYNC_STAGE_FAILED:
+        return R3D_ASYNC_FAILED;
+    default:
+        break;
+    }
+
+    return R3D_ASYNC_PENDING;
+}
+
+bool R3D_TakeAsyncModel(R3D_AsyncModel handle, R3D_Model* model)
+{
+    r3d_async_model_t* async = r3d_async_model_get(handle);
+    if (async == NULL || model == NULL) {
+        return false;
+    }
+
+    int stage = atomic_load_explicit(&async->stage, memory_order_acquire);
+    if (stage == R3D_ASYNC_STAGE_IMPORT || stage == R3D_ASYNC_STAGE_UPLOAD) {
+        return false;
+    }
+
+    // NOTE: The handle is released in both cases, a failed load only gives its state
+    bool success = (stage == R3D_ASYNC_STAGE_READY);
+    if (success) {
+        *model = async->model;
+    }
+
+    r3d_registry_remove(&R3D.container.rAsyncModels, handle);
+    r3d_async_model_destroy(async, !success);
+
+    return success;
+}
+
+void R3D_CancelAsyncModel(R3D_AsyncModel handle)
+{
+    r3d_async_model_t* async = r3d_async_model_get(handle);
+    if (async == NULL) {
+        return;
+    }
+
+    // NOTE: A load being imported still belongs to its loading thread, it is released by the update
+    if (atomic_load_explicit(&async->stage, memory_order_acquire) == R3D_ASYNC_STAGE_IMPORT) {
+        async->cancelled = true;
+        return;
+    }
+
+    r3d_registry_remove(&R3D.container.rAsyncModels, handle);
+    r3d_async_model_destroy(async, true);
+}
+
 R3D_Model R3D_LoadModelFromMesh(const R3D_Mesh* mesh)
 {
     R3D_Model model = { 0 };
@@ -3514,6 +5084,54 @@ R3D_ModelAnimation* R3D_LoadModelAnimationsFromMemory(const char* fileType, cons
     return animations;
 }
 
+R3D_ModelAnimation* R3D_LoadModelAnimationsCooked(const char* fileName, int* animCount)
+{
+    *animCount = 0;
+
+    /* --- Map the cooked file --- */
+
+    r3d_cooked_blob_t blob;
+    if (!r3d_cooked_map(&blob, fileName)) {
+        TraceLog(LOG_ERROR, "R3D: Unable to open the cooked model '%s'", fileName);
+        return NULL;
+    }
+
+    const r3d_cooked_header_t* header = r3d_cooked_get_header(&blob, fileName);
+    if (!header) {
+        r3d_cooked_unmap(&blob);
+        return NULL;
+    }
+
+    if (header->animCount == 0) {
+        TraceLog(LOG_INFO, "R3D: No animations found in '%s'", fileName);
+        r3d_cooked_unmap(&blob);
+        return NULL;
+    }
+
+    /* --- Load the animations from the mapping --- */
+
+    const r3d_cooked_anim_t* anims = r3d_cooked_get(&blob, header->anims, header->animCount, sizeof(r3d_cooked_anim_t));
+    R3D_ModelAnimation* animations = (anims != NULL) ? RL_CALLOC(header->animCount, sizeof(R3D_ModelAnimation)) : NULL;
+
+    for (int i = 0; animations != NULL && i < header->animCount; i++) {
+        if (!r3d_cooked_load_animation(&animations[i], &blob, header, &anims[i])) {
+            R3D_UnloadModelAnimations(animations, header->animCount);
+            animations = NULL;
+        }
+    }
+
+    if (animations == NULL) {
+        TraceLog(LOG_ERROR, "R3D: Unable to load the animations of the cooked model '%s'; The file is corrupted", fileName);
+    }
+    else {
+        *animCount = header->animCount;
+    }
+
+    r3d_cooked_unmap(&blob);
+
+    return animations;
+}
+
 void R3D_UnloadModelAnimations(R3D_ModelAnimation* animations, int animCount)
 {
     if (!animations) return;
@@ -3528,6 +5146,15 @@ void R3D_UnloadModelAnimations(R3D_ModelAnimation* animations, int animCount)
             }
             RL_FREE(anim->frameGlobalPoses);
         }
+        if (anim->frameLocalPoses) {
+            for (int frame = 0; frame < anim->frameCount; frame++) {
+                RL_FREE(anim->frameLocalPoses[frame]);
+            }
+            RL_FREE(anim->frameLocalPoses);
+        }
+
+        // Free compressed keys
+        r3d_anim_clip_destroy(anim->clip);
         
         // Free bones
         RL_FREE(anim->bones);
@@ -3563,7 +5190,105 @@ void R3D_ListModelAnimations(R3D_ModelAnimation* animations, int animCount)
     }
 }
 
+bool R3D_ExportModelCooked(const char* fileName, const R3D_Model* model, const R3D_ModelAnimation* animations, int animCount)
+{
+    if (model == NULL || model->meshCount <= 0 || model->materialCount <= 0) {
+        TraceLog(LOG_WARNING, "R3D: Invalid model passed to R3D_ExportModelCooked");
+        return false;
+    }
+
+    FILE* file = fopen(fileName, "wb");
+    if (file == NULL) {
+        TraceLog(LOG_ERROR, "R3D: Unable to create the cooked model '%s'", fileName);
+        return false;
+    }
+
+    /* --- Write the sections, the header is written last once the offsets are known --- */
+
+    r3d_cooked_writer_t writer = { .file = file };
+
+    r3d_cooked_header_t header = {
+        .magic = R3D_COOKED_MAGIC,
+        .version = R3D_COOKED_VERSION,
+        .vertexSize = sizeof(R3D_Vertex),
+        .materialSize = sizeof(R3D_Material),
+        .nodeSize = sizeof(r3d_anim_node_t)
+    };
+
+    r3d_cooked_write(&writer, &header, sizeof(header));
+
+    bool success = r3d_cooked_write_model(&writer, &header, model);
+
+    if (success && animations != NULL && animCount > 0) {
+        success = r3d_cooked_write_animations(&writer, &header, animations, animCount);
+    }
+
+    if (success && !writer.failed) {
+        success = (fseek(file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, file) == 1);
+    }
+
+    success = (fclose(file) == 0) && success && !writer.failed;
+
+    if (!success) {
+        TraceLog(LOG_ERROR, "R3D: Failed to write the cooked model '%s'", fileName);
+        remove(fileName);
+    }
+
+    return success;
+}
+
+bool R3D_CookModel(const char* fileName, const char* cookedFileName, int targetFrameRate)
+{
+    /* --- Import scene using Assimp --- */
+
+    const struct aiScene* scene = r3d_load_scene_from_file(fileName);
+    if (!scene) {
+        return false;
+    }
+
+    /* --- Process the model and its animations --- */
+
+    R3D_Model model = { 0 };
+
+    if (!r3d_process_model_from_scene(&model, scene, fileName, NULL)) {
+        R3D_UnloadModel(&model, true);
+        aiReleaseImport(scene);
+        return false;
+    }
+
+    int animCount = 0;
+    R3D_ModelAnimation* animations = NULL;
+
+    if (scene->mNumAnimations > 0) {
+        animations = r3d_process_animations_from_scene(scene, &animCount, targetFrameRate, fileName);
+    }
+
+    aiReleaseImport(scene);
+
+    /* --- Write the cooked file --- */
+
+    bool success = R3D_ExportModelCooked(cookedFileName, &model, animations, animCount);
+    if (success) {
+        TraceLog(LOG_INFO, "R3D: Cooked '%s' into '%s'", fileName, cookedFileName);
+    }
+
+    R3D_UnloadModelAnimations(animations, animCount);
+    R3D_UnloadModel(&model, true);
+
+    return success;
+}
+
 void R3D_SetModelImportScale(float value)
 {
     aiSetImportPropertyFloat(R3D.state.loading.aiProps, AI_CONFIG_GLOBAL_SCALE_FACTOR_KEY, value);
 }
+
+void R3D_SetModelAnimationCompression(bool enabled)
+{
+    R3D.state.loading.compressAnimations = enabled;
+}
+
+void R3D_SetAsyncUploadBudget(float milliseconds)
+{
+    R3D.state.loading.uploadBudget = (milliseconds > 0.0f) ? milliseconds : 0.0f;
+}
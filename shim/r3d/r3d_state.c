@@ -100,6 +100,63 @@ r3d_test_internal_format(GLuint fbo, GLuint tex, GLenum internalFormat, GLenum f
     return result;
 }
 
+// Uploads 'count' texels row by row, the texture grows when it has less than the rows needed
+static void r3d_storage_upload_rows(GLuint texture, int* rows, GLenum internalFormat, int width,
+                                    GLenum format, GLenum type, size_t texelSize, const void* data, int count)
+{
+    int rowCount = (count + width - 1) / width;
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    if (rowCount > *rows)
+    {
+        GLint maxSize = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+
+        if (rowCount > maxSize) {
+            TraceLog(LOG_ERROR, "R3D: Too many texels to upload to a storage (%i / %i)", count, maxSize * width);
+            rowCount = maxSize;
+            count = maxSize * width;
+        }
+
+        int newRows = *rows;
+        while (newRows < rowCount) newRows *= 2;
+        if (newRows > maxSize) newRows = maxSize;
+
+        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, newRows, 0, format, type, NULL);
+        *rows = newRows;
+    }
+
+    int fullRows = count / width;
+    int lastRow = count - fullRows * width;
+
+    if (fullRows > 0) {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, fullRows, format, type, data);
+    }
+    if (lastRow > 0) {
+        const char* lastData = (const char*)data + (size_t)fullRows * width * texelSize;
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, fullRows, lastRow, 1, format, type, lastData);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+static GLuint r3d_storage_create_texture(GLenum internalFormat, int width, int height, GLenum format, GLenum type)
+{
+    GLuint texture = 0;
+
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, type, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    return texture;
+}
+
 /* === Helper functions === */
 
 bool r3d_texture_is_default(GLuint id)
@@ -343,18 +400,128 @@ GLenum r3d_support_get_internal_format(GLenum internalFormat, bool asAttachment)
 
 /* === Storage functions === */
 
-void r3d_storage_bind_and_upload_matrices(const Matrix* matrices, int count, int slot)
+Matrix* r3d_storage_map_matrices(int count, int* offset)
 {
-    assert(count <= R3D_STORAGE_MATRIX_CAPACITY);
+    int rowCount = (count + R3D_STORAGE_MATRIX_ROW_SIZE - 1) / R3D_STORAGE_MATRIX_ROW_SIZE;
+    int firstRow = R3D.storage.texMatricesUsed;
+
+    /* --- Grow the atlas if the rows don't fit --- */
+
+    // NOTE: Reallocating the texture loses the rows uploaded earlier in the frame,
+    //       but the draws already submitted keep reading the previous storage
+
+    if (firstRow + rowCount > R3D.storage.texMatricesRows)
+    {
+        GLint maxSize = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+
+        if (rowCount > maxSize) {
+            TraceLog(LOG_ERROR, "R3D: Too many bone matrices to upload (%i / %i)", count, maxSize * R3D_STORAGE_MATRIX_ROW_SIZE);
+            return NULL;
+        }
+
+        if (firstRow + rowCount > maxSize) {
+            firstRow = 0;
+        }
+
+        int rows = R3D.storage.texMatricesRows;
+        while (rows < firstRow + rowCount) rows *= 2;
+        if (rows > maxSize) rows = maxSize;
+
+        glBindTexture(GL_TEXTURE_2D, R3D.storage.texMatrices);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, 4 * R3D_STORAGE_MATRIX_ROW_SIZE, rows, 0, GL_RGBA, GL_FLOAT, NULL);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        R3D.storage.texMatricesRows = rows;
+    }
+
+    /* --- Get the memory where the matrices will be written --- */
+
+    size_t size = (size_t)rowCount * R3D_STORAGE_MATRIX_ROW_SIZE * sizeof(Matrix);
+    Matrix* data = r3d_stream_map(&R3D.storage.stream, size, &R3D.storage.mapStreamOffset);
+
+    R3D.storage.mapStreamed = (data != NULL);
+
+    if (data == NULL) {
+        // NOTE: The streaming buffer is full, the rows are uploaded from client memory
+        size_t matrixCount = (size_t)rowCount * R3D_STORAGE_MATRIX_ROW_SIZE;
+        if (r3d_array_reserve(&R3D.storage.staging, matrixCount) < 0) {
+            TraceLog(LOG_ERROR, "R3D: Failed to reserve the staging memory of the bone matrices");
+            return NULL;
+        }
+        data = R3D.storage.staging.data;
+    }
+
+    R3D.storage.mapRow = firstRow;
+    R3D.storage.mapRowCount = rowCount;
+    R3D.storage.texMatricesUsed = firstRow + rowCount;
+
+    *offset = firstRow * R3D_STORAGE_MATRIX_ROW_SIZE;
+
+    return data;
+}
+
+void r3d_storage_unmap_matrices(void)
+{
+    const void* pixels = R3D.storage.staging.data;
+
+    if (R3D.storage.mapStreamed) {
+        r3d_stream_unmap(&R3D.storage.stream);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, R3D.storage.stream.buffer);
+        pixels = (const void*)(uintptr_t)R3D.storage.mapStreamOffset;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, R3D.storage.texMatrices);
+    glTexSubImage2D(
+        GL_TEXTURE_2D, 0, 0, R3D.storage.mapRow,
+        4 * R3D_STORAGE_MATRIX_ROW_SIZE, R3D.storage.mapRowCount,
+        GL_RGBA, GL_FLOAT, pixels
+    );
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    if (R3D.storage.mapStreamed) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+}
+
+void r3d_storage_begin_frame(void)
+{
+    r3d_stream_begin_frame(&R3D.storage.stream);
+    R3D.storage.texMatricesUsed = 0;
+}
+
+void r3d_storage_end_frame(void)
+{
+    r3d_stream_end_frame(&R3D.storage.stream);
+}
 
-    static const int texCount = sizeof(R3D.storage.texMatrices) / sizeof(*R3D.storage.texMatrices);
-    static int texIndex = 0;
+void r3d_storage_upload_lights(const Vector4* lights, int lightCount)
+{
+    r3d_storage_upload_rows(
+        R3D.storage.texLights, &R3D.storage.texLightsRows, GL_RGBA32F,
+        4 * R3D_STORAGE_LIGHT_ROW_SIZE, GL_RGBA, GL_FLOAT, sizeof(Vector4),
+        lights, 4 * lightCount
+    );
+}
 
-    glActiveTexture(GL_TEXTURE0 + slot);
-    glBindTexture(GL_TEXTURE_1D, R3D.storage.texMatrices[texIndex]);
-    glTexSubImage1D(GL_TEXTURE_1D, 0, 0, 4 * count, GL_RGBA, GL_FLOAT, matrices);
+void r3d_storage_upload_clusters(const uint32_t* ranges)
+{
+    glBindTexture(GL_TEXTURE_2D, R3D.storage.texClusters);
+    glTexSubImage2D(
+        GL_TEXTURE_2D, 0, 0, 0,
+        R3D_CLUSTER_COUNT_X * R3D_CLUSTER_COUNT_Y, R3D_CLUSTER_COUNT_Z,
+        GL_RG_INTEGER, GL_UNSIGNED_INT, ranges
+    );
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
 
-    texIndex = (texIndex + 1) % texCount;
+void r3d_storage_upload_light_indices(const uint16_t* indices, int indexCount)
+{
+    r3d_storage_upload_rows(
+        R3D.storage.texLightIndices, &R3D.storage.texLightIndicesRows, GL_R16UI,
+        R3D_STORAGE_INDEX_ROW_SIZE, GL_RED_INTEGER, GL_UNSIGNED_SHORT, sizeof(uint16_t),
+        indices, indexCount
+    );
 }
 
 /* === Main loading functions === */
@@ -536,15 +703,27 @@ void r3d_textures_unload(void)
 
 void r3d_storages_load(void)
 {
+    r3d_storage_load_stream();
     r3d_storage_load_tex_matrices();
+    r3d_storage_load_tex_lights();
+
+    R3D.storage.staging = r3d_array_create(R3D_STORAGE_MATRIX_ROW_SIZE, sizeof(Matrix));
 }
 
 void r3d_storages_unload(void)
 {
-    if (R3D.storage.texMatrices[0] != 0) {
-        static const int count = sizeof(R3D.storage.texMatrices) / sizeof(*R3D.storage.texMatrices);
-        glDeleteTextures(count, R3D.storage.texMatrices);
+    r3d_stream_destroy(&R3D.storage.stream);
+
+    if (R3D.storage.texMatrices != 0) {
+        glDeleteTextures(1, &R3D.storage.texMatrices);
     }
+    if (R3D.storage.texLights != 0) {
+        glDeleteTextures(1, &R3D.storage.texLights);
+        glDeleteTextures(1, &R3D.storage.texClusters);
+        glDeleteTextures(1, &R3D.storage.texLightIndices);
+    }
+
+    r3d_array_destroy(&R3D.storage.staging);
 }
 
 void r3d_shaders_load(void)
@@ -607,6 +786,12 @@ void r3d_shaders_load(void)
     if (R3D.state.flags & R3D_FLAG_FXAA) {
         r3d_shader_load_screen_fxaa();
     }
+    if (R3D.state.flags & R3D_FLAG_SKINNING_PREPASS) {
+        r3d_shader_load_generate_skinning();
+    }
+    if (R3D.state.flags & R3D_FLAG_CLUSTERED_LIGHTING) {
+        r3d_shader_load_screen_lighting_clustered();
+    }
 }
 
 void r3d_shaders_unload(void)
@@ -659,6 +844,12 @@ void r3d_shaders_unload(void)
     if (R3D.shader.screen.fxaa.id != 0) {
         rlUnloadShaderProgram(R3D.shader.screen.fxaa.id);
     }
+    if (R3D.shader.generate.skinning.id != 0) {
+        rlUnloadShaderProgram(R3D.shader.generate.skinning.id);
+    }
+    if (R3D.shader.screen.lightingClustered.id != 0) {
+        rlUnloadShaderProgram(R3D.shader.screen.lightingClustered.id);
+    }
 }
 
 void r3d_shader_load_screen_dof(void)
@@ -1174,6 +1365,46 @@ void r3d_shader_load_generate_prefilter(void)
     r3d_shader_disable();
 }
 
+void r3d_shader_load_generate_skinning(void)
+{
+    // NOTE: The varyings must be declared before linking,
+    //       so the program cannot be loaded with 'rlLoadShaderCode'
+
+    static const char* varyings[] = { "vPosition", "vNormal", "vTangent" };
+
+    GLuint vs = rlCompileShader(SKINNING_VERT, GL_VERTEX_SHADER);
+    if (vs == 0) {
+        R3D.shader.generate.skinning.id = 0;
+        return;
+    }
+
+    GLuint id = glCreateProgram();
+    glAttachShader(id, vs);
+    glTransformFeedbackVaryings(id, 3, varyings, GL_INTERLEAVED_ATTRIBS);
+    glLinkProgram(id);
+    glDetachShader(id, vs);
+    glDeleteShader(vs);
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(id, GL_LINK_STATUS, &linked);
+
+    if (linked != GL_TRUE) {
+        TraceLog(LOG_WARNING, "R3D: Failed to link the skinning prepass shader");
+        glDeleteProgram(id);
+        R3D.shader.generate.skinning.id = 0;
+        return;
+    }
+
+    R3D.shader.generate.skinning.id = id;
+
+    r3d_shader_get_location(generate.skinning, uTexBoneMatrices);
+    r3d_shader_get_location(generate.skinning, uBoneOffset);
+
+    r3d_shader_enable(generate.skinning);
+    r3d_shader_set_sampler2D_slot(generate.skinning, uTexBoneMatrices, 0);
+    r3d_shader_disable();
+}
+
 void r3d_shader_load_raster_geometry(void)
 {
     R3D.shader.raster.geometry.id = rlLoadShaderCode(
@@ -1181,6 +1412,7 @@ void r3d_shader_load_raster_geometry(void)
     );
 
     r3d_shader_get_location(raster.geometry, uTexBoneMatrices);
+    r3d_shader_get_location(raster.geometry, uBoneOffset);
     r3d_shader_get_location(raster.geometry, uUseSkinning);
     r3d_shader_get_location(raster.geometry, uMatNormal);
     r3d_shader_get_location(raster.geometry, uMatModel);
@@ -1200,7 +1432,7 @@ void r3d_shader_load_raster_geometry(void)
     r3d_shader_get_location(raster.geometry, uEmissionColor);
 
     r3d_shader_enable(raster.geometry);
-    r3d_shader_set_sampler1D_slot(raster.geometry, uTexBoneMatrices, 0);
+    r3d_shader_set_sampler2D_slot(raster.geometry, uTexBoneMatrices, 0);
     r3d_shader_set_sampler2D_slot(raster.geometry, uTexAlbedo, 1);
     r3d_shader_set_sampler2D_slot(raster.geometry, uTexNormal, 2);
     r3d_shader_set_sampler2D_slot(raster.geometry, uTexEmission, 3);
@@ -1215,6 +1447,7 @@ void r3d_shader_load_raster_geometry_inst(void)
     );
 
     r3d_shader_get_location(raster.geometryInst, uTexBoneMatrices);
+    r3d_shader_get_location(raster.geometryInst, uBoneOffset);
     r3d_shader_get_location(raster.geometryInst, uUseSkinning);
     r3d_shader_get_location(raster.geometryInst, uMatInvView);
     r3d_shader_get_location(raster.geometryInst, uMatModel);
@@ -1235,7 +1468,7 @@ void r3d_shader_load_raster_geometry_inst(void)
     r3d_shader_get_location(raster.geometryInst, uEmissionColor);
 
     r3d_shader_enable(raster.geometryInst);
-    r3d_shader_set_sampler1D_slot(raster.geometryInst, uTexBoneMatrices, 0);
+    r3d_shader_set_sampler2D_slot(raster.geometryInst, uTexBoneMatrices, 0);
     r3d_shader_set_sampler2D_slot(raster.geometryInst, uTexAlbedo, 1);
     r3d_shader_set_sampler2D_slot(raster.geometryInst, uTexNormal, 2);
     r3d_shader_set_sampler2D_slot(raster.geometryInst, uTexEmission, 3);
@@ -1252,6 +1485,7 @@ void r3d_shader_load_raster_forward(void)
     r3d_shader_raster_forward_t* shader = &R3D.shader.raster.forward;
 
     r3d_shader_get_location(raster.forward, uTexBoneMatrices);
+    r3d_shader_get_location(raster.forward, uBoneOffset);
     r3d_shader_get_location(raster.forward, uUseSkinning);
     r3d_shader_get_location(raster.forward, uMatNormal);
     r3d_shader_get_location(raster.forward, uMatModel);
@@ -1280,10 +1514,20 @@ void r3d_shader_load_raster_forward(void)
     r3d_shader_get_location(raster.forward, uSkyboxReflectIntensity);
     r3d_shader_get_location(raster.forward, uAlphaCutoff);
     r3d_shader_get_location(raster.forward, uViewPosition);
+    r3d_shader_get_location(raster.forward, uClustered);
+    r3d_shader_get_location(raster.forward, uTexLights);
+    r3d_shader_get_location(raster.forward, uTexClusters);
+    r3d_shader_get_location(raster.forward, uTexLightIndices);
+    r3d_shader_get_location(raster.forward, uDirLightCount);
+    r3d_shader_get_location(raster.forward, uLightListOffset);
+    r3d_shader_get_location(raster.forward, uLightListCount);
+    r3d_shader_get_location(raster.forward, uClusterScale);
+    r3d_shader_get_location(raster.forward, uClusterSlice);
+    r3d_shader_get_location(raster.forward, uMatView);
 
     r3d_shader_enable(raster.forward);
 
-    r3d_shader_set_sampler1D_slot(raster.forward, uTexBoneMatrices, 0);
+    r3d_shader_set_sampler2D_slot(raster.forward, uTexBoneMatrices, 0);
     r3d_shader_set_sampler2D_slot(raster.forward, uTexAlbedo, 1);
     r3d_shader_set_sampler2D_slot(raster.forward, uTexEmission, 2);
     r3d_shader_set_sampler2D_slot(raster.forward, uTexNormal, 3);
@@ -1292,9 +1536,10 @@ void r3d_shader_load_raster_forward(void)
     r3d_shader_set_samplerCube_slot(raster.forward, uCubeIrradiance, 6);
     r3d_shader_set_samplerCube_slot(raster.forward, uCubePrefilter, 7);
     r3d_shader_set_sampler2D_slot(raster.forward, uTexBrdfLut, 8);
+    r3d_shader_set_sampler2D_slot(raster.forward, uTexLights, 9);
 
     int shadowMapSlot = 10;
-    for (int i = 0; i < R3D_SHADER_FORWARD_NUM_LIGHTS; i++) {
+    for (int i = 0; i < R3D_SHADER_FORWARD_NUM_SHADOWS; i++) {
         shader->uMatLightVP[i].loc = rlGetLocationUniform(shader->id, TextFormat("uMatLightVP[%i]", i));
         shader->uShadowMapCube[i].loc = rlGetLocationUniform(shader->id, TextFormat("uShadowMapCube[%i]", i));
         shader->uShadowMap2D[i].loc = rlGetLocationUniform(shader->id, TextFormat("uShadowMap2D[%i]", i));
@@ -1313,14 +1558,24 @@ void r3d_shader_load_raster_forward(void)
         shader->uLights[i].shadowMapTxlSz.loc = rlGetLocationUniform(shader->id, TextFormat("uLights[%i].shadowMapTxlSz", i));
         shader->uLights[i].shadowDepthBias.loc = rlGetLocationUniform(shader->id, TextFormat("uLights[%i].shadowDepthBias", i));
         shader->uLights[i].shadowSlopeBias.loc = rlGetLocationUniform(shader->id, TextFormat("uLights[%i].shadowSlopeBias", i));
+        shader->uLights[i].cascadeCount.loc = rlGetLocationUniform(shader->id, TextFormat("uLights[%i].cascadeCount", i));
         shader->uLights[i].type.loc = rlGetLocationUniform(shader->id, TextFormat("uLights[%i].type", i));
         shader->uLights[i].enabled.loc = rlGetLocationUniform(shader->id, TextFormat("uLights[%i].enabled", i));
         shader->uLights[i].shadow.loc = rlGetLocationUniform(shader->id, TextFormat("uLights[%i].shadow", i));
 
+        for (int j = 0; j < R3D_SHADER_NUM_CASCADES; j++) {
+            shader->uLights[i].cascades[j].loc = rlGetLocationUniform(shader->id, TextFormat("uLights[%i].cascades[%i]", i, j));
+            shader->uLights[i].tiles[j].loc = rlGetLocationUniform(shader->id, TextFormat("uLights[%i].tiles[%i]", i, j));
+        }
+
         r3d_shader_set_samplerCube_slot(raster.forward, uShadowMapCube[i], shadowMapSlot++);
-        r3d_shader_set_sampler2D_slot(raster.forward, uShadowMap2D[i], shadowMapSlot++);
+        r3d_shader_set_sampler2DArray_slot(raster.forward, uShadowMap2D[i], shadowMapSlot++);
     }
 
+    // NOTE: The light storages take the units following the shadow maps
+    r3d_shader_set_sampler2D_slot(raster.forward, uTexClusters, shadowMapSlot++);
+    r3d_shader_set_sampler2D_slot(raster.forward, uTexLightIndices, shadowMapSlot++);
+
     r3d_shader_disable();
 }
 
@@ -1333,6 +1588,7 @@ void r3d_shader_load_raster_forward_inst(void)
     r3d_shader_raster_forward_inst_t* shader = &R3D.shader.raster.forwardInst;
 
     r3d_shader_get_location(raster.forwardInst, uTexBoneMatrices);
+    r3d_shader_get_location(raster.forwardInst, uBoneOffset);
     r3d_shader_get_location(raster.forwardInst, uUseSkinning);
     r3d_shader_get_location(raster.forwardInst, uMatInvView);
     r3d_shader_get_location(raster.forwardInst, uMatModel);
@@ -1362,10 +1618,20 @@ void r3d_shader_load_raster_forward_inst(void)
     r3d_shader_get_location(raster.forwardInst, uSkyboxReflectIntensity);
     r3d_shader_get_location(raster.forwardInst, uAlphaCutoff);
     r3d_shader_get_location(raster.forwardInst, uViewPosition);
+    r3d_shader_get_location(raster.forwardInst, uClustered);
+    r3d_shader_get_location(raster.forwardInst, uTexLights);
+    r3d_shader_get_location(raster.forwardInst, uTexClusters);
+    r3d_shader_get_location(raster.forwardInst, uTexLightIndices);
+    r3d_shader_get_location(raster.forwardInst, uDirLightCount);
+    r3d_shader_get_location(raster.forwardInst, uLightListOffset);
+    r3d_shader_get_location(raster.forwardInst, uLightListCount);
+    r3d_shader_get_location(raster.forwardInst, uClusterScale);
+    r3d_shader_get_location(raster.forwardInst, uClusterSlice);
+    r3d_shader_get_location(raster.forwardInst, uMatView);
 
     r3d_shader_enable(raster.forwardInst);
 
-    r3d_shader_set_sampler1D_slot(raster.forwardInst, uTexBoneMatrices, 0);
+    r3d_shader_set_sampler2D_slot(raster.forwardInst, uTexBoneMatrices, 0);
     r3d_shader_set_sampler2D_slot(raster.forwardInst, uTexAlbedo, 1);
     r3d_shader_set_sampler2D_slot(raster.forwardInst, uTexEmission, 2);
     r3d_shader_set_sampler2D_slot(raster.forwardInst, uTexNormal, 3);
@@ -1374,9 +1640,10 @@ void r3d_shader_load_raster_forward_inst(void)
     r3d_shader_set_samplerCube_slot(raster.forwardInst, uCubeIrradiance, 6);
     r3d_shader_set_samplerCube_slot(raster.forwardInst, uCubePrefilter, 7);
     r3d_shader_set_sampler2D_slot(raster.forwardInst, uTexBrdfLut, 8);
+    r3d_shader_set_sampler2D_slot(raster.forwardInst, uTexLights, 9);
 
     int shadowMapSlot = 10;
-    for (int i = 0; i < R3D_SHADER_FORWARD_NUM_LIGHTS; i++) {
+    for (int i = 0; i < R3D_SHADER_FORWARD_NUM_SHADOWS; i++) {
         shader->uMatLightVP[i].loc = rlGetLocationUniform(shader->id, TextFormat("uMatLightVP[%i]", i));
         shader->uShadowMapCube[i].loc = rlGetLocationUniform(shader->id, TextFormat("uShadowMapCube[%i]", i));
         shader->uShadowMap2D[i].loc = rlGetLocationUniform(shader->id, TextFormat("uShadowMap2D[%i]", i));
@@ -1395,14 +1662,24 @@ void r3d_shader_load_raster_forward_inst(void)
         shader->uLights[i].shadowMapTxlSz.loc = rlGetLocationUniform(shader->id, TextFormat("uLights[%i].shadowMapTxlSz", i));
         shader->uLights[i].shadowDepthBias.loc = rlGetLocationUniform(shader->id, TextFormat("uLights[%i].shadowDepthBias", i));
         shader->uLights[i].shadowSlopeBias.loc = rlGetLocationUniform(shader->id, TextFormat("uLights[%i].shadowSlopeBias", i));
+        shader->uLights[i].cascadeCount.loc = rlGetLocationUniform(shader->id, TextFormat("uLights[%i].cascadeCount", i));
         shader->uLights[i].type.loc = rlGetLocationUniform(shader->id, TextFormat("uLights[%i].type", i));
         shader->uLights[i].enabled.loc = rlGetLocationUniform(shader->id, TextFormat("uLights[%i].enabled", i));
         shader->uLights[i].shadow.loc = rlGetLocationUniform(shader->id, TextFormat("uLights[%i].shadow", i));
 
+        for (int j = 0; j < R3D_SHADER_NUM_CASCADES; j++) {
+            shader->uLights[i].cascades[j].loc = rlGetLocationUniform(shader->id, TextFormat("uLights[%i].cascades[%i]", i, j));
+            shader->uLights[i].tiles[j].loc = rlGetLocationUniform(shader->id, TextFormat("uLights[%i].tiles[%i]", i, j));
+        }
+
         r3d_shader_set_samplerCube_slot(raster.forwardInst, uShadowMapCube[i], shadowMapSlot++);
-        r3d_shader_set_sampler2D_slot(raster.forwardInst, uShadowMap2D[i], shadowMapSlot++);
+        r3d_shader_set_sampler2DArray_slot(raster.forwardInst, uShadowMap2D[i], shadowMapSlot++);
     }
 
+    // NOTE: The light storages take the units following the shadow maps
+    r3d_shader_set_sampler2D_slot(raster.forwardInst, uTexClusters, shadowMapSlot++);
+    r3d_shader_set_sampler2D_slot(raster.forwardInst, uTexLightIndices, shadowMapSlot++);
+
     r3d_shader_disable();
 }
 
@@ -1439,6 +1716,7 @@ void r3d_shader_load_raster_depth(void)
     );
 
     r3d_shader_get_location(raster.depth, uTexBoneMatrices);
+    r3d_shader_get_location(raster.depth, uBoneOffset);
     r3d_shader_get_location(raster.depth, uUseSkinning);
     r3d_shader_get_location(raster.depth, uMatMVP);
     r3d_shader_get_location(raster.depth, uTexCoordOffset);
@@ -1448,7 +1726,7 @@ void r3d_shader_load_raster_depth(void)
     r3d_shader_get_location(raster.depth, uAlphaCutoff);
 
     r3d_shader_enable(raster.depth);
-    r3d_shader_set_sampler1D_slot(raster.depth, uTexBoneMatrices, 0);
+    r3d_shader_set_sampler2D_slot(raster.depth, uTexBoneMatrices, 0);
     r3d_shader_set_sampler2D_slot(raster.depth, uTexAlbedo, 1);
     r3d_shader_disable();
 }
@@ -1460,6 +1738,7 @@ void r3d_shader_load_raster_depth_inst(void)
     );
 
     r3d_shader_get_location(raster.depthInst, uTexBoneMatrices);
+    r3d_shader_get_location(raster.depthInst, uBoneOffset);
     r3d_shader_get_location(raster.depthInst, uUseSkinning);
     r3d_shader_get_location(raster.depthInst, uMatInvView);
     r3d_shader_get_location(raster.depthInst, uMatModel);
@@ -1472,7 +1751,7 @@ void r3d_shader_load_raster_depth_inst(void)
     r3d_shader_get_location(raster.depthInst, uAlphaCutoff);
 
     r3d_shader_enable(raster.depthInst);
-    r3d_shader_set_sampler1D_slot(raster.depthInst, uTexBoneMatrices, 0);
+    r3d_shader_set_sampler2D_slot(raster.depthInst, uTexBoneMatrices, 0);
     r3d_shader_set_sampler2D_slot(raster.depthInst, uTexAlbedo, 1);
     r3d_shader_disable();
 }
@@ -1484,6 +1763,7 @@ void r3d_shader_load_raster_depth_cube(void)
     );
 
     r3d_shader_get_location(raster.depthCube, uTexBoneMatrices);
+    r3d_shader_get_location(raster.depthCube, uBoneOffset);
     r3d_shader_get_location(raster.depthCube, uUseSkinning);
     r3d_shader_get_location(raster.depthCube, uViewPosition);
     r3d_shader_get_location(raster.depthCube, uMatModel);
@@ -1496,7 +1776,7 @@ void r3d_shader_load_raster_depth_cube(void)
     r3d_shader_get_location(raster.depthCube, uAlphaCutoff);
 
     r3d_shader_enable(raster.depthCube);
-    r3d_shader_set_sampler1D_slot(raster.depthCube, uTexBoneMatrices, 0);
+    r3d_shader_set_sampler2D_slot(raster.depthCube, uTexBoneMatrices, 0);
     r3d_shader_set_sampler2D_slot(raster.depthCube, uTexAlbedo, 1);
     r3d_shader_disable();
 }
@@ -1508,6 +1788,7 @@ void r3d_shader_load_raster_depth_cube_inst(void)
     );
 
     r3d_shader_get_location(raster.depthCubeInst, uTexBoneMatrices);
+    r3d_shader_get_location(raster.depthCubeInst, uBoneOffset);
     r3d_shader_get_location(raster.depthCubeInst, uUseSkinning);
     r3d_shader_get_location(raster.depthCubeInst, uViewPosition);
     r3d_shader_get_location(raster.depthCubeInst, uMatInvView);
@@ -1522,7 +1803,7 @@ void r3d_shader_load_raster_depth_cube_inst(void)
     r3d_shader_get_location(raster.depthCubeInst, uAlphaCutoff);
 
     r3d_shader_enable(raster.depthCubeInst);
-    r3d_shader_set_sampler1D_slot(raster.depthCubeInst, uTexBoneMatrices, 0);
+    r3d_shader_set_sampler2D_slot(raster.depthCubeInst, uTexBoneMatrices, 0);
     r3d_shader_set_sampler2D_slot(raster.depthCubeInst, uTexAlbedo, 1);
     r3d_shader_disable();
 }
@@ -1648,9 +1929,15 @@ void r3d_shader_load_screen_lighting(void)
     r3d_shader_get_location(screen.lighting, uLight.shadowMapTxlSz);
     r3d_shader_get_location(screen.lighting, uLight.shadowDepthBias);
     r3d_shader_get_location(screen.lighting, uLight.shadowSlopeBias);
+    r3d_shader_get_location(screen.lighting, uLight.cascadeCount);
     r3d_shader_get_location(screen.lighting, uLight.type);
     r3d_shader_get_location(screen.lighting, uLight.shadow);
 
+    for (int i = 0; i < R3D_SHADER_NUM_CASCADES; i++) {
+        shader->uLight.cascades[i].loc = rlGetLocationUniform(shader->id, TextFormat("uLight.cascades[%i]", i));
+        shader->uLight.tiles[i].loc = rlGetLocationUniform(shader->id, TextFormat("uLight.tiles[%i]", i));
+    }
+
     r3d_shader_enable(screen.lighting);
 
     r3d_shader_set_sampler2D_slot(screen.lighting, uTexAlbedo, 0);
@@ -1659,12 +1946,43 @@ void r3d_shader_load_screen_lighting(void)
     r3d_shader_set_sampler2D_slot(screen.lighting, uTexORM, 3);
     r3d_shader_set_sampler2D_slot(screen.lighting, uTexNoise, 4);
 
-    r3d_shader_set_sampler2D_slot(screen.lighting, uLight.shadowMap, 5);
+    r3d_shader_set_sampler2DArray_slot(screen.lighting, uLight.shadowMap, 5);
     r3d_shader_set_samplerCube_slot(screen.lighting, uLight.shadowCubemap, 6);
 
     r3d_shader_disable();
 }
 
+void r3d_shader_load_screen_lighting_clustered(void)
+{
+    R3D.shader.screen.lightingClustered.id = rlLoadShaderCode(SCREEN_VERT, LIGHTING_CLUSTERED_FRAG);
+
+    r3d_shader_get_location(screen.lightingClustered, uTexAlbedo);
+    r3d_shader_get_location(screen.lightingClustered, uTexNormal);
+    r3d_shader_get_location(screen.lightingClustered, uTexDepth);
+    r3d_shader_get_location(screen.lightingClustered, uTexORM);
+    r3d_shader_get_location(screen.lightingClustered, uTexLights);
+    r3d_shader_get_location(screen.lightingClustered, uTexClusters);
+    r3d_shader_get_location(screen.lightingClustered, uTexLightIndices);
+    r3d_shader_get_location(screen.lightingClustered, uDirLightCount);
+    r3d_shader_get_location(screen.lightingClustered, uClusterScale);
+    r3d_shader_get_location(screen.lightingClustered, uClusterSlice);
+    r3d_shader_get_location(screen.lightingClustered, uViewPosition);
+    r3d_shader_get_location(screen.lightingClustered, uMatInvProj);
+    r3d_shader_get_location(screen.lightingClustered, uMatInvView);
+
+    r3d_shader_enable(screen.lightingClustered);
+
+    r3d_shader_set_sampler2D_slot(screen.lightingClustered, uTexAlbedo, 0);
+    r3d_shader_set_sampler2D_slot(screen.lightingClustered, uTexNormal, 1);
+    r3d_shader_set_sampler2D_slot(screen.lightingClustered, uTexDepth, 2);
+    r3d_shader_set_sampler2D_slot(screen.lightingClustered, uTexORM, 3);
+    r3d_shader_set_sampler2D_slot(screen.lightingClustered, uTexLights, 4);
+    r3d_shader_set_sampler2D_slot(screen.lightingClustered, uTexClusters, 5);
+    r3d_shader_set_sampler2D_slot(screen.lightingClustered, uTexLightIndices, 6);
+
+    r3d_shader_disable();
+}
+
 void r3d_shader_load_screen_scene(void)
 {
     R3D.shader.screen.scene.id = rlLoadShaderCode(SCREEN_VERT, SCENE_FRAG);
@@ -1906,21 +2224,42 @@ void r3d_texture_load_ibl_brdf_lut(void)
 
 /* === Storage loading functions === */
 
+void r3d_storage_load_stream(void)
+{
+    assert(R3D.storage.stream.buffer == 0);
+
+    R3D.storage.stream = r3d_stream_create(R3D_STORAGE_STREAM_SIZE);
+}
+
 void r3d_storage_load_tex_matrices(void)
 {
-    assert(R3D.storage.texMatrices[0] == 0);
+    assert(R3D.storage.texMatrices == 0);
+
+    glGenTextures(1, &R3D.storage.texMatrices);
+    glBindTexture(GL_TEXTURE_2D, R3D.storage.texMatrices);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, 4 * R3D_STORAGE_MATRIX_ROW_SIZE, R3D_STORAGE_MATRIX_ROWS, 0, GL_RGBA, GL_FLOAT, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    R3D.storage.texMatricesRows = R3D_STORAGE_MATRIX_ROWS;
+    R3D.storage.texMatricesUsed = 0;
+}
 
-    static const int count = sizeof(R3D.storage.texMatrices) / sizeof(*R3D.storage.texMatrices);
+void r3d_storage_load_tex_lights(void)
+{
+    assert(R3D.storage.texLights == 0);
 
-    glGenTextures(count, R3D.storage.texMatrices);
+    R3D.storage.texLights = r3d_storage_create_texture(GL_RGBA32F, 4 * R3D_STORAGE_LIGHT_ROW_SIZE, 1, GL_RGBA, GL_FLOAT);
+    R3D.storage.texLightIndices = r3d_storage_create_texture(GL_R16UI, R3D_STORAGE_INDEX_ROW_SIZE, 1, GL_RED_INTEGER, GL_UNSIGNED_SHORT);
 
-    for (int i = 0; i < count; i++) {
-        glBindTexture(GL_TEXTURE_1D, R3D.storage.texMatrices[i]);
-        glTexImage1D(GL_TEXTURE_1D, 0, GL_RGBA32F, 4 * R3D_STORAGE_MATRIX_CAPACITY, 0, GL_RGBA, GL_FLOAT, NULL);
-        glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    }
+    R3D.storage.texClusters = r3d_storage_create_texture(
+        GL_RG32UI, R3D_CLUSTER_COUNT_X * R3D_CLUSTER_COUNT_Y, R3D_CLUSTER_COUNT_Z,
+        GL_RG_INTEGER, GL_UNSIGNED_INT
+    );
 
-    glBindTexture(GL_TEXTURE_1D, 0);
+    R3D.storage.texLightsRows = 1;
+    R3D.storage.texLightIndicesRows = 1;
 }
@@ -26,24 +26,64 @@
 #include "./details/r3d_shaders.h"
 #include "./details/r3d_frustum.h"
 #include "./details/r3d_primitives.h"
+#include "./details/r3d_jobs.h"
+#include "./details/r3d_worker.h"
+#include "./details/r3d_bvh.h"
+#include "./details/r3d_cluster.h"
+#include "./details/r3d_drawcall.h"
+#include "./details/r3d_material.h"
+#include "./details/r3d_stream.h"
+#include "./details/r3d_shadow_atlas.h"
 #include "./details/containers/r3d_array.h"
 #include "./details/containers/r3d_registry.h"
 
 /* === Defines === */
 
-#define R3D_STORAGE_MATRIX_CAPACITY  256
+#define R3D_STORAGE_MATRIX_ROW_SIZE  256                                // Matrices per row of the bone matrix atlas (4 texels each)
+#define R3D_STORAGE_MATRIX_ROWS      16                                 // Initial number of rows of the bone matrix atlas
+#define R3D_STORAGE_STREAM_SIZE      (1 << 20)                          // Initial size of each frame region of the streaming buffer
+#define R3D_STORAGE_LIGHT_ROW_SIZE   256                                // Lights per row of the light storage (4 texels each)
+#define R3D_STORAGE_INDEX_ROW_SIZE   1024                               // Indices per row of the cluster light indices
 
 #define R3D_STENCIL_GEOMETRY_BIT     0x80                               // Bit 7 (MSB) for geometry
 #define R3D_STENCIL_GEOMETRY_MASK    0x80                               // Mask for geometry bit only
 #define R3D_STENCIL_EFFECT_MASK      0x7F                               // Mask for effect bits (bits 0-6)
 #define R3D_STENCIL_EFFECT_ID(n)     ((n) & R3D_STENCIL_EFFECT_MASK)    // Extract effect ID (7 bits - 127 effects)
 
+#define R3D_BIND_CACHE_TEXTURE_UNITS 16                                 // Texture units tracked by the bound state cache
+
+#define R3D_AUTO_INSTANCING_MIN_CALLS 4                                 // Minimum number of identical calls merged into an instanced call
+
 /* === Internal Strucs === */
 
 struct r3d_support_internal_format {
     bool internal, attachment;
 };
 
+// Vertex written by the skinning prepass, in the order of the transform feedback varyings
+typedef struct {
+    Vector3 position;
+    Vector3 normal;
+    Vector4 tangent;
+} r3d_skinned_vertex_t;
+
+typedef struct {
+    const R3D_Mesh* mesh;   //< Mesh skinned in the buffer during the current frame
+    int boneStorage;        //< Offset of the pose in the bone matrix atlas
+    GLuint vbo;             //< Skinned positions, normals and tangents (r3d_skinned_vertex_t)
+    GLuint vao;             //< Skinned attributes, the others are read from the mesh buffers
+    int capacity;           //< Number of vertices allocated in 'vbo'
+} r3d_skinned_mesh_t;
+
+typedef struct {
+    r3d_drawcall_t call;    //< Persistent draw call, copied into the draw call arrays when visible
+    R3D_Material material;  //< Material of the mesh, interned again if the cache released it
+    BoundingBox aabb;       //< World space bounding box of the mesh
+    int proxy;              //< Leaf of the mesh in the static scene tree
+    R3D_ShadowCastMode shadowCastMode;  //< Shadow mode of the mesh seen by the cached static shadows
+    R3D_Layer layers;                   //< Layers of the mesh seen by the cached static shadows
+} r3d_static_mesh_t;
+
 /* === Global R3D State === */
 
 extern struct R3D_State {
@@ -143,6 +183,9 @@ extern struct R3D_State {
                               *  [_] = depthStencil
                               */
 
+        // Shadow maps of the directional and spot lights, created with the first of them
+        r3d_shadow_atlas_t shadowAtlas;
+
         // Custom target (optional)
         RenderTexture customTarget;
 
@@ -157,11 +200,65 @@ extern struct R3D_State {
         r3d_array_t aDrawForward;           //< Contains all forward draw calls
         r3d_array_t aDrawForwardInst;       //< Contains all forward instanced draw calls
 
+        r3d_array_t aDrawDeferredOrder;     //< Sorted indices of the deferred draw calls (empty if not sorted)
+        r3d_array_t aDrawDeferredKeys;      //< Sort keys of the deferred draw calls
+        r3d_array_t aDrawForwardOrder;      //< Sorted indices of the forward draw calls (empty if not sorted)
+        r3d_array_t aDrawForwardKeys;       //< Sort keys of the forward draw calls
+
+        r3d_material_cache_t materials;     //< Interned materials referenced by the draw calls
+        R3D_Material defaultMaterial;       //< Used by the draw calls whose material could not be interned
+
         r3d_registry_t rLights;             //< Contains all created lights
         r3d_array_t aLightBatch;            //< Contains all lights visible on screen
 
+        r3d_array_t aLightData;             //< Lights without shadows of the frame, as 4 Vector4 each, directional lights first
+        r3d_array_t aLightSpheres;          //< World space bounding spheres of the lights of 'aLightData' following the directional lights
+        r3d_array_t aLightIndices;          //< Light lists of the clusters then of the forward draw calls (uint16_t)
+        r3d_array_t aShadowLightLists;      //< Shadow casting lights of each forward draw call, as indices in 'aLightBatch'
+        r3d_array_t aShadowRequests;        //< Tiles requested in the shadow atlas by the lights of the frame
+
+        r3d_cluster_grid_t clusterGrid;     //< View space boxes of the clusters (see 'R3D_FLAG_CLUSTERED_LIGHTING')
+        r3d_array_t aClusterPairs;          //< Clusters touched by each light, as (cluster << 16 | light)
+        r3d_array_t aClusterRanges;         //< Offset and count of the light indices of each cluster
+
+        r3d_array_t aCullBoxes;             //< World space boxes of all draw calls, as six float arrays (see 'r3d_aabb_soa_t')
+        r3d_array_t aCullMask;              //< Visibility bitmask of all draw calls, computed before culling them
+        r3d_array_t aAnimCalls;             //< Draw calls whose bone matrices must be updated this frame
+        r3d_array_t aPoses;                 //< Distinct poses of 'aAnimCalls', each one is computed once
+        r3d_array_t aPoseTable;             //< Open addressing table of the poses
+        r3d_array_t aPoseMatrices;          //< Bone matrices of the poses computed this frame, followed by the node scratch of compressed poses
+        r3d_array_t aPrevPoses;             //< Poses of the previous frame, the held poses are copied from them
+        r3d_array_t aPrevPoseTable;         //< Open addressing table of the previous poses, its count is the table capacity
+        r3d_array_t aPrevPoseMatrices;      //< Bone matrices of the previous poses
+        r3d_array_t aInstBoxes;             //< Local space boxes of the instances of the call being drawn (see 'R3D_FLAG_INSTANCE_CULLING')
+        r3d_array_t aInstMask;              //< Visibility bitmask of the instances of the call being drawn
+        r3d_array_t aInstTransforms;        //< Compacted transforms of the visible instances
+        r3d_array_t aInstColors;            //< Compacted colors of the visible instances
+        r3d_array_t aBatchTransforms;       //< Transforms of the calls merged by automatic instancing (see 'R3D_FLAG_AUTO_INSTANCING')
+        r3d_array_t aBatchGroups;           //< Groups of calls sharing the same mesh and material
+        r3d_array_t aBatchCallGroups;       //< Group of each call, -1 if the call cannot be batched
+        r3d_array_t aBatchTable;            //< Open addressing table of the groups
+        r3d_array_t aSkinCalls;             //< Skinned draw calls whose bone matrices are uploaded (r3d_drawcall_t*)
+        r3d_array_t aSkinTable;             //< Open addressing table of the distinct bone matrices of 'aSkinCalls'
+        r3d_array_t aSkinnedMeshes;         //< Buffers of the skinning prepass (r3d_skinned_mesh_t), kept between frames (see 'R3D_FLAG_SKINNING_PREPASS')
+        r3d_array_t aSkinnedTable;          //< Open addressing table of the meshes skinned during the current frame
+
+        r3d_registry_t rStaticMeshes;       //< Contains all registered static meshes
+        r3d_bvh_t staticTree;               //< Bounding volume hierarchy of the static meshes
+        r3d_array_t aStaticVisible;         //< IDs of the static meshes returned by the last tree query
+
+        r3d_registry_t rAsyncModels;        //< Models loaded asynchronously, pointers shared with the loading threads
+
     } container;
 
+    // Job system
+    struct {
+        r3d_job_pool_t* pool;               //< Worker threads shared by the parallel flags (NULL if none is set)
+        r3d_job_pool_t* prepare;            //< Pool of the prepare phase (NULL if 'R3D_FLAG_PARALLEL_PREPARE' is not set)
+        r3d_job_pool_t* loading;            //< Pool of the model loading (NULL if 'R3D_FLAG_PARALLEL_LOADING' is not set)
+        r3d_worker_t* loader;               //< Threads of the asynchronous loading, created by the first request
+    } jobs;
+
     // Internal shaders
     struct {
 
@@ -173,6 +270,7 @@ extern struct R3D_State {
             r3d_shader_generate_cubemap_from_equirectangular_t cubemapFromEquirectangular;
             r3d_shader_generate_irradiance_convolution_t irradianceConvolution;
             r3d_shader_generate_prefilter_t prefilter;
+            r3d_shader_generate_skinning_t skinning;
         } generate;
 
         // Raster shaders
@@ -195,6 +293,7 @@ extern struct R3D_State {
             r3d_shader_screen_ambient_ibl_t ambientIbl;
             r3d_shader_screen_ambient_t ambient;
             r3d_shader_screen_lighting_t lighting;
+            r3d_shader_screen_lighting_clustered_t lightingClustered;
             r3d_shader_screen_scene_t scene;
             r3d_shader_screen_bloom_t bloom;
             r3d_shader_screen_ssr_t ssr;
@@ -287,7 +386,19 @@ extern struct R3D_State {
 
     // Storages
     struct {
-        GLuint texMatrices[3];  // Stores 4x4 matrices for GPU skinning (triple-buffered to avoid GPU stalls)
+        r3d_stream_t stream;        // Per-frame streaming buffer, instance data and bone matrices are written there once per frame
+        GLuint texMatrices;         // Atlas of 4x4 matrices for GPU skinning, the draws reference their bones by offset
+        int texMatricesRows;        // Number of rows allocated in the atlas, it grows when a frame needs more
+        int texMatricesUsed;        // Number of rows used during the current frame
+        r3d_array_t staging;        // Client memory of the matrices (Matrix), only used when the streaming buffer is full
+        size_t mapStreamOffset;     // State of the last 'r3d_storage_map_matrices'
+        bool mapStreamed;
+        int mapRow, mapRowCount;
+        GLuint texLights;           // Lights without shadows of the frame, 4 texels per light
+        GLuint texClusters;         // Offset and count of the light indices of each cluster, one row per depth slice
+        GLuint texLightIndices;     // Light lists of the clusters and of the forward draw calls
+        int texLightsRows;          // Number of rows allocated in the light storage
+        int texLightIndicesRows;    // Number of rows allocated in the light indices
     } storage;
 
     // State data
@@ -310,6 +421,7 @@ extern struct R3D_State {
         // Scene data
         struct {
             BoundingBox bounds;
+            unsigned int staticVersion;     //< Incremented when the static meshes change, outdates the cached static shadows
         } scene;
 
         // Resolution
@@ -324,11 +436,31 @@ extern struct R3D_State {
         struct {
             struct aiPropertyStore* aiProps;   //< Assimp import properties (scale, etc.)
             TextureFilter textureFilter;       //< Texture filter used by R3D during model loading
+            bool compressAnimations;           //< Animations are stored as compressed clips instead of baked poses
+            float uploadBudget;                //< Time given each frame to the uploads of the asynchronous loads, in milliseconds
         } loading;
 
+        // Lights without shadows, shaded from the light storage
+        struct {
+            int dirLightCount;      //< Number of directional lights at the beginning of the light storage
+            bool clustered;         //< The lights are shaded from the clusters (see 'R3D_FLAG_CLUSTERED_LIGHTING')
+            Vector2 clusterSlice;   //< Scale and bias giving the depth slice from the log of the view depth
+        } lightStorage;
+
+        // Bound state cache (see 'R3D_FLAG_STATE_SORTING')
+        struct {
+            bool enabled;                                   //< Only enabled during the passes submitting calls in state order
+            const R3D_Mesh* mesh;                           //< Mesh whose vertex array is bound, NULL if unknown
+            GLuint texture2D[R3D_BIND_CACHE_TEXTURE_UNITS]; //< Textures bound to the first units, 0 if unknown
+            R3D_BindStats stats;                            //< Binds issued and skipped since the beginning of the frame
+        } bound;
+
         // Active layers
         R3D_Layer layers;
 
+        // Incremented by each call to R3D_Begin
+        unsigned int frameIndex;
+
         // Miscellaneous flags
         R3D_Flags flags;
 
@@ -352,7 +484,28 @@ GLenum r3d_support_get_internal_format(GLenum internalFormat, bool asAttachment)
 
 /* === Storage functions === */
 
-void r3d_storage_bind_and_upload_matrices(const Matrix* matrices, int count, int slot);
+// Reserves 'count' matrices in the atlas for the current frame, the offset of the first one is written to 'offset'
+// The matrices must be written to the returned pointer before 'r3d_storage_unmap_matrices', returns NULL on failure
+Matrix* r3d_storage_map_matrices(int count, int* offset);
+void r3d_storage_unmap_matrices(void);
+
+// Called at the beginning and the end of R3D_End, every pass of the frame can reference the streamed data
+void r3d_storage_begin_frame(void);
+void r3d_storage_end_frame(void);
+
+// Uploads the lights without shadows of the frame (4 Vector4 per light), the (offset, count) of
+// the light list of each cluster, and the light indices of the lists of the clusters and draw calls
+void r3d_storage_upload_lights(const Vector4* lights, int lightCount);
+void r3d_storage_upload_clusters(const uint32_t* ranges);
+void r3d_storage_upload_light_indices(const uint16_t* indices, int indexCount);
+
+/* === Asynchronous loading functions === */
+
+// Uploads the asynchronous loads whose import is done, within the upload budget, called at the end of R3D_End
+void r3d_async_models_update(void);
+
+// Waits for the loading threads and releases the loads that were not taken
+void r3d_async_models_release(void);
 
 /* === Main loading functions === */
 
@@ -391,6 +544,7 @@ void r3d_shader_load_generate_upsampling(void);
 void r3d_shader_load_generate_cubemap_from_equirectangular(void);
 void r3d_shader_load_generate_irradiance_convolution(void);
 void r3d_shader_load_generate_prefilter(void);
+void r3d_shader_load_generate_skinning(void);
 void r3d_shader_load_raster_geometry(void);
 void r3d_shader_load_raster_geometry_inst(void);
 void r3d_shader_load_raster_forward(void);
@@ -405,6 +559,7 @@ void r3d_shader_load_screen_ssao(void);
 void r3d_shader_load_screen_ambient_ibl(void);
 void r3d_shader_load_screen_ambient(void);
 void r3d_shader_load_screen_lighting(void);
+void r3d_shader_load_screen_lighting_clustered(void);
 void r3d_shader_load_screen_scene(void);
 void r3d_shader_load_screen_bloom(void);
 void r3d_shader_load_screen_ssr(void);
@@ -425,7 +580,9 @@ void r3d_texture_load_ibl_brdf_lut(void);
 
 /* === Storage loading functions === */
 
+void r3d_storage_load_stream(void);
 void r3d_storage_load_tex_matrices(void);
+void r3d_storage_load_tex_lights(void);
 
 /* === Framebuffer helper macros === */
 
@@ -481,6 +638,17 @@ do {
     }                                                                                           \
 } while(0)
 
+#define r3d_shader_set_sampler2DArray_slot(shader_name, uniform, value)                         \
+do {                                                                                            \
+    if (R3D.shader.shader_name.uniform.slot2DArray != (value)) {                                \
+        R3D.shader.shader_name.uniform.slot2DArray = (value);                                   \
+        glUniform1i(                                                                            \
+            R3D.shader.shader_name.uniform.loc,                                                 \
+            R3D.shader.shader_name.uniform.slot2DArray                                          \
+        );                                                                                      \
+    }                                                                                           \
+} while(0)
+
 #define r3d_shader_set_samplerCube_slot(shader_name, uniform, value)                            \
 do {                                                                                            \
     if (R3D.shader.shader_name.uniform.slotCube != (value)) {                                   \
@@ -511,6 +679,12 @@ do {
     else glBindTexture(GL_TEXTURE_2D, R3D.texture.altTex);                                      \
 } while(0)
 
+#define r3d_shader_bind_sampler2DArray(shader_name, uniform, texId)                             \
+do {                                                                                            \
+    glActiveTexture(GL_TEXTURE0 + R3D.shader.shader_name.uniform.slot2DArray);                  \
+    glBindTexture(GL_TEXTURE_2D_ARRAY, (texId));                                                \
+} while(0)
+
 #define r3d_shader_bind_samplerCube(shader_name, uniform, texId)                                \
 do {                                                                                            \
     glActiveTexture(GL_TEXTURE0 + R3D.shader.shader_name.uniform.slotCube);                     \
@@ -529,6 +703,12 @@ do {
     glBindTexture(GL_TEXTURE_2D, 0);                                                            \
 } while(0)
 
+#define r3d_shader_unbind_sampler2DArray(shader_name, uniform)                                  \
+do {                                                                                            \
+    glActiveTexture(GL_TEXTURE0 + R3D.shader.shader_name.uniform.slot2DArray);                  \
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);                                                      \
+} while(0)
+
 #define r3d_shader_unbind_samplerCube(shader_name, uniform)                                     \
 do {                                                                                            \
     glActiveTexture(GL_TEXTURE0 + R3D.shader.shader_name.uniform.slotCube);                     \
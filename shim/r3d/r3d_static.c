@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "r3d.h"
+
+#include "./details/r3d_drawcall.h"
+#include "./details/r3d_bvh.h"
+#include "./details/r3d_math.h"
+#include "./r3d_state.h"
+
+#include <raylib.h>
+#include <raymath.h>
+
+
+/* === Helper macros === */
+
+#define r3d_get_and_check_static_mesh(var_name, id, ...)                    \
+    r3d_static_mesh_t* var_name;                                            \
+{                                                                           \
+    var_name = r3d_registry_get(&R3D.container.rStaticMeshes, id);          \
+    if (var_name == NULL) {                                                 \
+        TraceLog(LOG_ERROR, "Static mesh [ID %i] is not valid", id);        \
+        return __VA_ARGS__;                                                 \
+    }                                                                       \
+}
+
+
+/* === Public functions === */
+
+R3D_StaticMesh R3D_AddStaticMesh(const R3D_Mesh* mesh, const R3D_Material* material, Matrix transform)
+{
+    if (mesh == NULL) {
+        TraceLog(LOG_ERROR, "R3D: Cannot add a NULL mesh to the static scene");
+        return 0;
+    }
+
+    R3D_StaticMesh id = r3d_registry_add(&R3D.container.rStaticMeshes, NULL);
+    r3d_static_mesh_t* staticMesh = r3d_registry_get(&R3D.container.rStaticMeshes, id);
+
+    r3d_drawcall_t* call = &staticMesh->call;
+
+    staticMesh->material = material ? *material : R3D_GetDefaultMaterial();
+
+    call->transform = transform;
+    call->shadowCastMode = mesh->shadowCastMode;
+    call->geometry.model.mesh = mesh;
+    call->geometryType = R3D_DRAWCALL_GEOMETRY_MODEL;
+    call->renderMode = R3D_DRAWCALL_RENDER_DEFERRED;
+
+    staticMesh->shadowCastMode = mesh->shadowCastMode;
+    staticMesh->layers = mesh->layers;
+
+    if (staticMesh->material.billboardMode != R3D_BILLBOARD_DISABLED) {
+        TraceLog(LOG_WARNING, "R3D: Billboard mode is not supported for static meshes, it will be ignored [ID %i]", id);
+        staticMesh->material.billboardMode = R3D_BILLBOARD_DISABLED;
+    }
+
+    r3d_drawcall_set_material(call, &staticMesh->material);
+
+    staticMesh->aabb = r3d_aabb_transform(&mesh->aabb, &transform);
+    staticMesh->proxy = r3d_bvh_insert(&R3D.container.staticTree, &staticMesh->aabb, id);
+
+    if (staticMesh->proxy == R3D_BVH_NULL_NODE) {
+        TraceLog(LOG_ERROR, "R3D: Failed to insert the mesh in the static scene");
+        r3d_registry_remove(&R3D.container.rStaticMeshes, id);
+        return 0;
+    }
+
+    R3D.state.scene.staticVersion++;
+
+    return id;
+}
+
+int R3D_AddStaticModel(const R3D_Model* model, Matrix transform, R3D_StaticMesh* ids)
+{
+    if (model == NULL) return 0;
+
+    int count = 0;
+
+    for (int i = 0; i < model->meshCount; i++)
+    {
+        const R3D_Material* material = &model->materials[model->meshMaterials[i]];
+        R3D_StaticMesh id = R3D_AddStaticMesh(&model->meshes[i], material, transform);
+
+        if (ids != NULL) ids[i] = id;
+        if (id != 0) count++;
+    }
+
+    return count;
+}
+
+void R3D_RemoveStaticMesh(R3D_StaticMesh id)
+{
+    r3d_get_and_check_static_mesh(staticMesh, id);
+
+    r3d_bvh_remove(&R3D.container.staticTree, staticMesh->proxy);
+    r3d_registry_remove(&R3D.container.rStaticMeshes, id);
+
+    R3D.state.scene.staticVersion++;
+}
+
+bool R3D_IsStaticMeshExist(R3D_StaticMesh id)
+{
+    return r3d_registry_is_valid(&R3D.container.rStaticMeshes, id);
+}
+
+Matrix R3D_GetStaticMeshTransform(R3D_StaticMesh id)
+{
+    r3d_get_and_check_static_mesh(staticMesh, id, MatrixIdentity());
+    return staticMesh->call.transform;
+}
+
+void R3D_SetStaticMeshTransform(R3D_StaticMesh id, Matrix transform)
+{
+    r3d_get_and_check_static_mesh(staticMesh, id);
+
+    staticMesh->call.transform = transform;
+    staticMesh->aabb = r3d_aabb_transform(&staticMesh->call.geometry.model.mesh->aabb, &transform);
+
+    // The tree is only updated when the mesh leaves its enlarged box
+    r3d_bvh_move(&R3D.container.staticTree, staticMesh->proxy, &staticMesh->aabb);
+
+    R3D.state.scene.staticVersion++;
+}
+
+void R3D_ClearStaticMeshes(void)
+{
+    unsigned int count = r3d_registry_get_allocated_count(&R3D.container.rStaticMeshes);
+
+    for (unsigned int id = 1; id <= count; id++) {
+        r3d_registry_remove(&R3D.container.rStaticMeshes, id);
+    }
+
+    r3d_bvh_clear(&R3D.container.staticTree);
+
+    R3D.state.scene.staticVersion++;
+}
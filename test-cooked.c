@@ -0,0 +1,199 @@
+#include "./shim/r3d/details/r3d_anim_blend.c"
+#include "./shim/r3d/details/r3d_anim_clip.c"
+#include "./shim/r3d/details/r3d_billboard.c"
+#include "./shim/r3d/details/r3d_bvh.c"
+#include "./shim/r3d/details/r3d_cluster.c"
+#include "./shim/r3d/details/r3d_drawcall.c"
+#include "./shim/r3d/details/r3d_frustum.c"
+#include "./shim/r3d/details/r3d_jobs.c"
+#include "./shim/r3d/details/r3d_light.c"
+#include "./shim/r3d/details/r3d_material.c"
+#include "./shim/r3d/details/r3d_primitives.c"
+#include "./shim/r3d/details/r3d_shadow_atlas.c"
+#include "./shim/r3d/details/r3d_sort.c"
+#include "./shim/r3d/details/r3d_stream.c"
+#include "./shim/r3d/details/r3d_worker.c"
+#include "./shim/r3d/r3d_core.c"
+#include "./shim/r3d/r3d_culling.c"
+#include "./shim/r3d/r3d_curves.c"
+#include "./shim/r3d/r3d_environment.c"
+#include "./shim/r3d/r3d_lighting.c"
+#include "./shim/r3d/r3d_model.c"
+#include "./shim/r3d/r3d_particles.c"
+#include "./shim/r3d/r3d_skybox.c"
+#include "./shim/r3d/r3d_sprite.c"
+#include "./shim/r3d/r3d_state.c"
+#include "./shim/r3d/r3d_static.c"
+#include "./shim/r3d/r3d_utils.c"
+
+// Cooks a textured and skinned model with a baked and a compressed animation, then reloads it
+// NOTE: The albedo and emission maps share a texture, the file stores it once but the
+//       reloaded maps must not share it, each map texture is released by R3D_UnloadMaterial()
+
+#define TEST_BONES 2
+#define TEST_FRAMES 4
+
+static Transform test_local_pose(int frame, int bone)
+{
+    return (Transform) {
+        .translation = { 0.0f, (float)bone, 0.0f },
+        .rotation = QuaternionFromEuler(0.0f, 0.25f * frame, 0.0f),
+        .scale = { 1.0f, 1.0f, 1.0f }
+    };
+}
+
+static void test_make_skeleton(BoneInfo* bones)
+{
+    for (int i = 0; i < TEST_BONES; i++) {
+        snprintf(bones[i].name, sizeof(bones[i].name), "bone%d", i);
+        bones[i].parent = i - 1;
+    }
+}
+
+static bool test_make_animations(R3D_ModelAnimation* anims)
+{
+    Transform locals[TEST_FRAMES * TEST_BONES];
+    int parents[TEST_BONES], nodeBones[TEST_BONES];
+
+    for (int i = 0; i < 2; i++) {
+        anims[i].boneCount = TEST_BONES;
+        anims[i].frameCount = TEST_FRAMES;
+        anims[i].bones = RL_MALLOC(TEST_BONES * sizeof(BoneInfo));
+        if (anims[i].bones == NULL) return false;
+        test_make_skeleton(anims[i].bones);
+    }
+
+    /* --- Baked animation --- */
+
+    snprintf(anims[0].name, sizeof(anims[0].name), "baked");
+    anims[0].frameGlobalPoses = RL_CALLOC(TEST_FRAMES, sizeof(Matrix*));
+    anims[0].frameLocalPoses = RL_CALLOC(TEST_FRAMES, sizeof(Transform*));
+    if (anims[0].frameGlobalPoses == NULL || anims[0].frameLocalPoses == NULL) return false;
+
+    for (int f = 0; f < TEST_FRAMES; f++) {
+        anims[0].frameGlobalPoses[f] = RL_MALLOC(TEST_BONES * sizeof(Matrix));
+        anims[0].frameLocalPoses[f] = RL_MALLOC(TEST_BONES * sizeof(Transform));
+        if (anims[0].frameGlobalPoses[f] == NULL || anims[0].frameLocalPoses[f] == NULL) return false;
+        for (int b = 0; b < TEST_BONES; b++) {
+            Transform local = test_local_pose(f, b);
+            anims[0].frameLocalPoses[f][b] = local;
+            anims[0].frameGlobalPoses[f][b] = MatrixMultiply(QuaternionToMatrix(local.rotation),
+                                                             MatrixTranslate(0.0f, (float)b, 0.0f));
+        }
+    }
+
+    /* --- Compressed animation --- */
+
+    snprintf(anims[1].name, sizeof(anims[1].name), "compressed");
+
+    for (int b = 0; b < TEST_BONES; b++) {
+        parents[b] = b - 1;
+        nodeBones[b] = b;
+    }
+    for (int f = 0; f < TEST_FRAMES; f++) {
+        for (int b = 0; b < TEST_BONES; b++) {
+            locals[f * TEST_BONES + b] = test_local_pose(f, b);
+        }
+    }
+
+    anims[1].clip = r3d_anim_clip_create(parents, nodeBones, TEST_BONES, TEST_BONES, locals, TEST_FRAMES);
+
+    return anims[1].clip != NULL;
+}
+
+static bool test_make_model(R3D_Model* model, Texture2D texture)
+{
+    R3D_Mesh mesh = R3D_GenMeshCube(1, 1, 1, true);
+    *model = R3D_LoadModelFromMesh(&mesh);
+    if (model->meshCount != 1) return false;
+
+    model->materials[0].albedo.texture = texture;
+    model->materials[0].emission.texture = texture;
+
+    model->boneCount = TEST_BONES;
+    model->bones = RL_MALLOC(TEST_BONES * sizeof(BoneInfo));
+    model->boneOffsets = RL_MALLOC(TEST_BONES * sizeof(Matrix));
+    if (model->bones == NULL || model->boneOffsets == NULL) return false;
+
+    test_make_skeleton(model->bones);
+    for (int i = 0; i < TEST_BONES; i++) {
+        model->boneOffsets[i] = MatrixTranslate(0.0f, -(float)i, 0.0f);
+    }
+
+    model->meshes[0].boneCount = TEST_BONES;
+
+    return true;
+}
+
+int main(void)
+{
+    InitWindow(800, 600, "R3D Cooked Round-Trip");
+    R3D_Init(800, 600, 0);
+
+    Image image = GenImageChecked(16, 16, 4, 4, WHITE, BLACK);
+    Texture2D texture = LoadTextureFromImage(image);
+    UnloadImage(image);
+
+    R3D_Model model = { 0 };
+    R3D_ModelAnimation* anims = RL_CALLOC(2, sizeof(R3D_ModelAnimation));
+
+    bool ok = (anims != NULL) && test_make_model(&model, texture) && test_make_animations(anims);
+
+    const char* filePath = "test-cooked.r3dc";
+    ok = ok && R3D_ExportModelCooked(filePath, &model, anims, 2);
+
+    R3D_Model cooked = { 0 };
+    R3D_ModelAnimation* cookedAnims = NULL;
+    int cookedAnimCount = 0;
+
+    if (ok) {
+        cooked = R3D_LoadModelCooked(filePath);
+        cookedAnims = R3D_LoadModelAnimationsCooked(filePath, &cookedAnimCount);
+
+        ok = (cooked.meshCount == model.meshCount)
+          && (cooked.materialCount == model.materialCount)
+          && (cooked.meshes != NULL)
+          && (cooked.meshes[0].vertexCount == model.meshes[0].vertexCount)
+          && (cooked.meshes[0].indexCount == model.meshes[0].indexCount)
+          && (cooked.meshes[0].boneCount == TEST_BONES)
+          && (cooked.boneCount == TEST_BONES)
+          && (cooked.bones != NULL && cooked.bones[1].parent == 0)
+          && (cooked.materials[0].albedo.texture.id != 0)
+          && (cooked.materials[0].albedo.texture.id != cooked.materials[0].emission.texture.id)
+          && (cooked.materials[0].albedo.texture.width == texture.width);
+
+        ok = ok && (cookedAnims != NULL) && (cookedAnimCount == 2);
+
+        for (int i = 0; ok && i < 2; i++) {
+            ok = (cookedAnims[i].boneCount == anims[i].boneCount)
+              && (cookedAnims[i].frameCount == anims[i].frameCount)
+              && ((cookedAnims[i].clip != NULL) == (anims[i].clip != NULL))
+              && (strcmp(cookedAnims[i].name, anims[i].name) == 0);
+        }
+
+        if (ok) {
+            const r3d_anim_clip_t* clip = anims[1].clip;
+            const r3d_anim_clip_t* cookedClip = cookedAnims[1].clip;
+            ok = (cookedClip->nodeCount == clip->nodeCount)
+              && (cookedClip->sampleCount == clip->sampleCount)
+              && (cookedClip->wordCount == clip->wordCount)
+              && (memcmp(cookedAnims[0].frameGlobalPoses[TEST_FRAMES - 1], anims[0].frameGlobalPoses[TEST_FRAMES - 1],
+                         TEST_BONES * sizeof(Matrix)) == 0);
+        }
+    }
+
+    TraceLog(ok ? LOG_INFO : LOG_ERROR, "R3D: Cooked round-trip %s", ok ? "passed" : "failed");
+
+    if (cooked.meshes != NULL) R3D_UnloadModel(&cooked, true);
+    R3D_UnloadModelAnimations(cookedAnims, cookedAnimCount);
+
+    // The source maps share the texture, it is released once
+    if (model.materials != NULL) model.materials[0].emission.texture = (Texture2D) { 0 };
+    R3D_UnloadModel(&model, true);
+    R3D_UnloadModelAnimations(anims, 2);
+    remove(filePath);
+
+    R3D_Close();
+    CloseWindow();
+    return ok ? 0 : 1;
+}
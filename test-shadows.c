@@ -1,8 +1,18 @@
+#include "./shim/r3d/details/r3d_anim_blend.c"
+#include "./shim/r3d/details/r3d_anim_clip.c"
 #include "./shim/r3d/details/r3d_billboard.c"
+#include "./shim/r3d/details/r3d_bvh.c"
+#include "./shim/r3d/details/r3d_cluster.c"
 #include "./shim/r3d/details/r3d_drawcall.c"
 #include "./shim/r3d/details/r3d_frustum.c"
+#include "./shim/r3d/details/r3d_jobs.c"
 #include "./shim/r3d/details/r3d_light.c"
+#include "./shim/r3d/details/r3d_material.c"
 #include "./shim/r3d/details/r3d_primitives.c"
+#include "./shim/r3d/details/r3d_shadow_atlas.c"
+#include "./shim/r3d/details/r3d_sort.c"
+#include "./shim/r3d/details/r3d_stream.c"
+#include "./shim/r3d/details/r3d_worker.c"
 #include "./shim/r3d/r3d_core.c"
 #include "./shim/r3d/r3d_culling.c"
 #include "./shim/r3d/r3d_curves.c"
@@ -13,6 +23,7 @@
 #include "./shim/r3d/r3d_skybox.c"
 #include "./shim/r3d/r3d_sprite.c"
 #include "./shim/r3d/r3d_state.c"
+#include "./shim/r3d/r3d_static.c"
 #include "./shim/r3d/r3d_utils.c"
 
 int main(void)